@@ -0,0 +1,107 @@
+/*
+ * bench_harness.cpp — Timing loop and result reporting for axiom_bench
+ *
+ * See bench_harness.h.
+ */
+
+#include "bench_harness.h"
+
+#include "ax_abi.h"
+
+#include <algorithm>
+#include <chrono>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static const uint32_t MIN_SAMPLES = 5;
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+bool bench_run(const bench_config& config, const bench_fn& prepare, const bench_fn& body,
+               bench_result* out) {
+    for (uint32_t i = 0; i < config.warmup; ++i) {
+        if (!prepare() || !body()) return false;
+    }
+
+    std::vector<double> samples;
+    samples.reserve(config.iterations);
+    const bench_clock::time_point start = bench_clock::now();
+
+    while (samples.size() < config.iterations) {
+        if (!prepare()) return false;
+
+        bench_clock::time_point t0 = bench_clock::now();
+        bool ok = body();
+        bench_clock::time_point t1 = bench_clock::now();
+        if (!ok) return false;
+        samples.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+
+        double elapsed = std::chrono::duration<double>(t1 - start).count();
+        if (config.max_seconds > 0.0 && elapsed > config.max_seconds && samples.size() >= MIN_SAMPLES) {
+            break;
+        }
+    }
+
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    std::sort(samples.begin(), samples.end());
+
+    out->samples   = (uint32_t)samples.size();
+    out->median_ns = percentile(samples, 0.50);
+    out->p99_ns    = percentile(samples, 0.99);
+    out->mean_ns   = samples.empty() ? 0.0 : sum / (double)samples.size();
+    out->min_ns    = samples.empty() ? 0.0 : samples.front();
+    out->max_ns    = samples.empty() ? 0.0 : samples.back();
+    return true;
+}
+
+/* ── Output ───────────────────────────────────────────────────────── */
+
+static void write_table(FILE* f, const std::vector<bench_result>& results) {
+    fprintf(f, "%-10s %9s %8s %7s %13s %13s %13s %11s\n",
+            "bench", "entities", "act/tick", "samples", "median (us)", "p99 (us)", "mean (us)", "bytes");
+    for (const bench_result& r : results) {
+        fprintf(f, "%-10s %9u %8u %7u %13.2f %13.2f %13.2f %11llu\n",
+                r.name.c_str(), r.entities, r.actions_per_tick, r.samples,
+                r.median_ns / 1000.0, r.p99_ns / 1000.0, r.mean_ns / 1000.0,
+                (unsigned long long)r.bytes);
+    }
+}
+
+static void write_csv(FILE* f, const std::vector<bench_result>& results) {
+    fprintf(f, "bench,entities,actions_per_tick,samples,median_ns,p99_ns,mean_ns,min_ns,max_ns,bytes\n");
+    for (const bench_result& r : results) {
+        fprintf(f, "%s,%u,%u,%u,%.0f,%.0f,%.0f,%.0f,%.0f,%llu\n",
+                r.name.c_str(), r.entities, r.actions_per_tick, r.samples,
+                r.median_ns, r.p99_ns, r.mean_ns, r.min_ns, r.max_ns,
+                (unsigned long long)r.bytes);
+    }
+}
+
+static void write_json(FILE* f, const std::vector<bench_result>& results, const char* build_hash) {
+    fprintf(f, "{\n  \"abi\": \"%d.%d\",\n  \"build_hash\": \"%s\",\n  \"results\": [\n",
+            AX_ABI_MAJOR, AX_ABI_MINOR, build_hash);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const bench_result& r = results[i];
+        fprintf(f, "    { \"bench\": \"%s\", \"entities\": %u, \"actions_per_tick\": %u, "
+                   "\"samples\": %u, \"median_ns\": %.0f, \"p99_ns\": %.0f, \"mean_ns\": %.0f, "
+                   "\"min_ns\": %.0f, \"max_ns\": %.0f, \"bytes\": %llu }%s\n",
+                r.name.c_str(), r.entities, r.actions_per_tick, r.samples,
+                r.median_ns, r.p99_ns, r.mean_ns, r.min_ns, r.max_ns,
+                (unsigned long long)r.bytes, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+void bench_write(FILE* f, bench_format format, const std::vector<bench_result>& results,
+                 const char* build_hash) {
+    switch (format) {
+        case BENCH_FORMAT_CSV:  write_csv(f, results);               break;
+        case BENCH_FORMAT_JSON: write_json(f, results, build_hash);  break;
+        default:                write_table(f, results);             break;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * bench_harness.h — Timing loop and result reporting for axiom_bench
+ *
+ * Each case runs `warmup` untimed iterations, then timed iterations
+ * until either `iterations` samples are taken or the case has used
+ * `max_seconds` of wall time (never fewer than MIN_SAMPLES). The
+ * per-case setup/teardown that must not be measured (queueing actions
+ * before a step, resetting state after a load) goes in `prepare`,
+ * which runs before every iteration outside the timed region.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct bench_config {
+    uint32_t warmup;
+    uint32_t iterations;
+    double   max_seconds;       /* per case; 0 = no limit */
+};
+
+struct bench_result {
+    std::string name;           /* entry point, e.g. "step"  */
+    uint32_t    entities;
+    uint32_t    actions_per_tick;
+    uint32_t    samples;
+    double      median_ns;
+    double      p99_ns;
+    double      mean_ns;
+    double      min_ns;
+    double      max_ns;
+    uint64_t    bytes;          /* payload per op (snapshot/save), 0 if N/A */
+};
+
+/* Returns false if prepare or body reported failure. */
+typedef std::function<bool()> bench_fn;
+
+bool bench_run(const bench_config& config, const bench_fn& prepare, const bench_fn& body,
+               bench_result* out);
+
+enum bench_format {
+    BENCH_FORMAT_TABLE,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+};
+
+void bench_write(FILE* f, bench_format format, const std::vector<bench_result>& results,
+                 const char* build_hash);
@@ -0,0 +1,69 @@
+/*
+ * bench_world.cpp — Synthetic worlds and action streams for axiom_bench
+ *
+ * See bench_world.h.
+ */
+
+#include "bench_world.h"
+#include "shell_common.h"
+
+#include <cstdio>
+
+ax_core* bench_make_world(uint32_t entities, uint32_t seed) {
+    ax_core* core = create_and_load("content/");
+    if (!core) return nullptr;
+
+    /* spread targets over a 512 m square, in front of the player */
+    uint32_t rng = seed ? seed : 1u;
+    ax_debug_spawn_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.archetype_id = 2000;
+    p.hp           = 100;
+
+    for (uint32_t i = BENCH_CONTENT_ENTITIES; i < entities; ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        p.px = (float)(rng >> 8) / (float)(1u << 24) * 512.0f - 256.0f;
+        rng = rng * 1664525u + 1013904223u;
+        p.pz = -(float)(rng >> 8) / (float)(1u << 24) * 512.0f - 4.0f;
+        p.py = 0.0f;
+
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &p, &id) != AX_OK) {
+            printf("  bench_make_world: spawn %u failed: %s\n", i, ax_get_last_error());
+            ax_destroy(core);
+            return nullptr;
+        }
+    }
+    return core;
+}
+
+void bench_make_actions(uint64_t tick, uint32_t count, std::vector<ax_action_v1>* out) {
+    out->resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ax_action_v1& a = (*out)[i];
+        a = {};
+        a.tick     = tick;
+        a.actor_id = 1;
+        switch (i % 8) {
+            case 0: case 2: case 4:
+                a.type         = AX_ACT_LOOK_INTENT;
+                a.u.look.yaw   = 0.001f;
+                a.u.look.pitch = 0.0f;
+                break;
+            case 1: case 5:
+                a.type     = AX_ACT_MOVE_INTENT;
+                a.u.move.x = (i & 16) ? 0.5f : -0.5f;
+                a.u.move.y = 0.25f;
+                break;
+            case 3: case 6:
+                a.type = AX_ACT_FIRE_ONCE;
+                a.u.fire_once.weapon_slot = 0;
+                break;
+            default:
+                a.type = (i % 64 == 7) ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+                a.u.reload.weapon_slot = 0;
+                break;
+        }
+    }
+}
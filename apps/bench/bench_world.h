@@ -0,0 +1,27 @@
+/*
+ * bench_world.h — Synthetic worlds and action streams for axiom_bench
+ *
+ * A bench world is the A1 content (player + 3 targets) topped up with
+ * debug-spawned targets to the requested entity count, scattered over
+ * a square around the range from a seeded LCG. Same count + seed gives
+ * the same world, so timings compare like with like across builds.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+#include <vector>
+
+/* Entity count of the A1 content alone (the smallest bench world). */
+#define BENCH_CONTENT_ENTITIES 4u
+
+/* NULL on failure (message printed). */
+ax_core* bench_make_world(uint32_t entities, uint32_t seed);
+
+/*
+ * Fills *out with `count` actions for the player stamped `tick`: a
+ * repeating mix of LOOK, MOVE, FIRE_ONCE and (rarely) RELOAD.
+ */
+void bench_make_actions(uint64_t tick, uint32_t count, std::vector<ax_action_v1>* out);
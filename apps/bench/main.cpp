@@ -0,0 +1,266 @@
+/*
+ * main.cpp — Axiom Bench (core microbenchmarks)
+ *
+ * Times the hot ABI entry points over a matrix of synthetic world sizes
+ * and per-tick action densities:
+ *
+ *   submit    ax_submit_actions   (one batch of D actions)
+ *   step      ax_step_ticks(1)    (D actions queued for the tick)
+ *   snapshot  ax_get_snapshot_bytes
+ *   save      ax_save_bytes
+ *   load      ax_load_save_bytes
+ *   rng       ax_rng_generate     (one draw per entity id)
+ *
+ * snapshot/save/load/rng do not depend on the action density and run once
+ * per world size. Worlds keep stepping between cases, so targets take
+ * damage and the player drifts exactly as a live session would.
+ *
+ * Usage: axiom_bench [--entities LIST] [--actions LIST] [--bench LIST]
+ *                    [--warmup N] [--iterations N] [--max-seconds S]
+ *                    [--seed S] [--format table|csv|json] [--out FILE]
+ *
+ * LIST is comma separated. Run from the repository root (content/).
+ */
+
+#include "ax_abi.h"
+#include "bench_harness.h"
+#include "bench_world.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::vector<uint32_t> parse_list(const char* s) {
+    std::vector<uint32_t> out;
+    while (*s) {
+        char* end = nullptr;
+        out.push_back((uint32_t)std::strtoul(s, &end, 10));
+        if (end == s) break;
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return out;
+}
+
+static bool bench_selected(const std::string& list, const char* name) {
+    if (list.empty()) return true;
+    size_t len = std::strlen(name);
+    for (size_t pos = 0; pos <= list.size();) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) comma = list.size();
+        if (comma - pos == len && list.compare(pos, len, name) == 0) return true;
+        pos = comma + 1;
+    }
+    return false;
+}
+
+static void usage() {
+    printf("usage: axiom_bench [--entities LIST] [--actions LIST] [--bench LIST]\n"
+           "                   [--warmup N] [--iterations N] [--max-seconds S]\n"
+           "                   [--seed S] [--format table|csv|json] [--out FILE]\n"
+           "  benches: submit, step, snapshot, save, load, rng\n");
+}
+
+/* Runs every selected case against one world; appends to *results. */
+static bool bench_world_cases(ax_core* core, uint32_t entities,
+                              const std::vector<uint32_t>& densities,
+                              const std::string& benches, const bench_config& config,
+                              std::vector<bench_result>* results) {
+    ax_diagnostics_v1 diag = {};
+    if (ax_get_diagnostics(core, &diag) != AX_OK) return false;
+    uint64_t tick = diag.current_tick;
+
+    std::vector<ax_action_v1> actions;
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+
+    auto submit_next = [&]() {
+        bench_make_actions(tick + 1, (uint32_t)actions.size(), &actions);
+        batch.count   = (uint32_t)actions.size();
+        batch.actions = actions.data();
+        return ax_submit_actions(core, &batch) == AX_OK;
+    };
+    auto step_one = [&]() {
+        if (ax_step_ticks(core, 1) != AX_OK) return false;
+        tick++;
+        return true;
+    };
+
+    for (uint32_t d : densities) {
+        actions.resize(d);
+
+        if (bench_selected(benches, "submit")) {
+            bench_result r = { "submit", entities, d, 0, 0, 0, 0, 0, 0, 0 };
+            bool pending = false;
+            /* drain the previous iteration's batch outside the timed region */
+            auto prepare = [&]() {
+                bool ok = !pending || step_one();
+                bench_make_actions(tick + 1, d, &actions);
+                batch.count   = d;
+                batch.actions = actions.data();
+                pending = true;
+                return ok;
+            };
+            auto body = [&]() { return ax_submit_actions(core, &batch) == AX_OK; };
+            if (!bench_run(config, prepare, body, &r) || (pending && !step_one())) return false;
+            results->push_back(r);
+        }
+
+        if (bench_selected(benches, "step")) {
+            bench_result r = { "step", entities, d, 0, 0, 0, 0, 0, 0, 0 };
+            auto prepare = [&]() { return submit_next(); };
+            auto body    = [&]() { return step_one(); };
+            if (!bench_run(config, prepare, body, &r)) return false;
+            results->push_back(r);
+        }
+    }
+
+    /* an idle tick, so snapshots carry the world rather than the last burst of events */
+    if (!step_one()) return false;
+
+    std::vector<uint8_t> buf;
+    uint32_t size = 0;
+    auto nothing = []() { return true; };
+
+    if (bench_selected(benches, "snapshot")) {
+        if (ax_get_snapshot_bytes(core, nullptr, 0, &size) != AX_OK) return false;
+        buf.resize(size);
+        bench_result r = { "snapshot", entities, 0, 0, 0, 0, 0, 0, 0, size };
+        auto body = [&]() {
+            return ax_get_snapshot_bytes(core, buf.data(), (uint32_t)buf.size(), &size) == AX_OK;
+        };
+        if (!bench_run(config, nothing, body, &r)) return false;
+        results->push_back(r);
+    }
+
+    if (bench_selected(benches, "rng")) {
+        std::vector<uint32_t> ids(entities), words(entities);
+        for (uint32_t i = 0; i < entities; ++i) ids[i] = i + 1;
+        ax_rng_request_v1 req = {};
+        req.version          = 1;
+        req.size_bytes       = sizeof(req);
+        req.system_id        = AX_RNG_SYSTEM_USER;
+        req.tick             = tick;
+        req.draws_per_entity = 1;
+        req.entity_count     = entities;
+        req.entity_ids       = ids.data();
+        bench_result r = { "rng", entities, 0, 0, 0, 0, 0, 0, 0, (uint64_t)entities * 4 };
+        auto body = [&]() { return ax_rng_generate(core, &req, words.data()) == AX_OK; };
+        if (!bench_run(config, nothing, body, &r)) return false;
+        results->push_back(r);
+    }
+
+    if (bench_selected(benches, "save") || bench_selected(benches, "load")) {
+        if (ax_save_bytes(core, nullptr, 0, &size) != AX_OK) return false;
+        buf.resize(size);
+        if (ax_save_bytes(core, buf.data(), size, &size) != AX_OK) return false;
+
+        if (bench_selected(benches, "save")) {
+            std::vector<uint8_t> out(size);
+            bench_result r = { "save", entities, 0, 0, 0, 0, 0, 0, 0, size };
+            auto body = [&]() {
+                return ax_save_bytes(core, out.data(), (uint32_t)out.size(), &size) == AX_OK;
+            };
+            if (!bench_run(config, nothing, body, &r)) return false;
+            results->push_back(r);
+        }
+        if (bench_selected(benches, "load")) {
+            bench_result r = { "load", entities, 0, 0, 0, 0, 0, 0, 0, (uint64_t)buf.size() };
+            auto body = [&]() {
+                return ax_load_save_bytes(core, buf.data(), (uint32_t)buf.size()) == AX_OK;
+            };
+            if (!bench_run(config, nothing, body, &r)) return false;
+            results->push_back(r);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<uint32_t> entity_counts = { 4, 1000, 10000, 100000, 1000000 };
+    std::vector<uint32_t> densities     = { 0, 10, 1000, 10000 };
+    std::string           benches;
+    bench_config          config        = { 3, 50, 2.0 };
+    uint32_t              seed          = 1;
+    bench_format          format        = BENCH_FORMAT_TABLE;
+    const char*           out_path      = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg  = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!next) {
+            usage();
+            return 2;
+        }
+        if (std::strcmp(arg, "--entities") == 0) {
+            entity_counts = parse_list(next);
+        } else if (std::strcmp(arg, "--actions") == 0) {
+            densities = parse_list(next);
+        } else if (std::strcmp(arg, "--bench") == 0) {
+            benches = next;
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            config.warmup = (uint32_t)std::strtoul(next, nullptr, 10);
+        } else if (std::strcmp(arg, "--iterations") == 0) {
+            config.iterations = (uint32_t)std::strtoul(next, nullptr, 10);
+        } else if (std::strcmp(arg, "--max-seconds") == 0) {
+            config.max_seconds = std::strtod(next, nullptr);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seed = (uint32_t)std::strtoul(next, nullptr, 10);
+        } else if (std::strcmp(arg, "--format") == 0) {
+            if      (std::strcmp(next, "table") == 0) format = BENCH_FORMAT_TABLE;
+            else if (std::strcmp(next, "csv") == 0)   format = BENCH_FORMAT_CSV;
+            else if (std::strcmp(next, "json") == 0)  format = BENCH_FORMAT_JSON;
+            else { usage(); return 2; }
+        } else if (std::strcmp(arg, "--out") == 0) {
+            out_path = next;
+        } else {
+            usage();
+            return 2;
+        }
+        ++i;
+    }
+    if (config.iterations == 0) {
+        config.iterations = 1;
+    }
+
+    std::vector<bench_result> results;
+    std::string build_hash = "unknown";
+
+    for (uint32_t n : entity_counts) {
+        if (n < BENCH_CONTENT_ENTITIES) {
+            fprintf(stderr, "axiom_bench: skipping %u entities (content alone has %u)\n",
+                    n, BENCH_CONTENT_ENTITIES);
+            continue;
+        }
+        fprintf(stderr, "axiom_bench: %u entities...\n", n);
+
+        ax_core* core = bench_make_world(n, seed);
+        if (!core) return 1;
+
+        ax_diagnostics_v1 diag = {};
+        if (ax_get_diagnostics(core, &diag) == AX_OK) {
+            build_hash = diag.build_hash;
+        }
+
+        bool ok = bench_world_cases(core, n, densities, benches, config, &results);
+        if (!ok) {
+            fprintf(stderr, "axiom_bench: %u entities failed: %s\n", n, ax_get_last_error());
+        }
+        ax_destroy(core);
+        if (!ok) return 1;
+    }
+
+    FILE* f = stdout;
+    if (out_path) {
+        f = fopen(out_path, "w");
+        if (!f) {
+            fprintf(stderr, "axiom_bench: cannot open %s\n", out_path);
+            return 1;
+        }
+    }
+    bench_write(f, format, results, build_hash.c_str());
+    if (f != stdout) fclose(f);
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * alloc_hook.cpp — Heap allocation counter (headless test hook)
+ *
+ * Replaces every replaceable global allocation function that does not
+ * forward to another one by default (plain, array and aligned forms);
+ * the nothrow forms forward to these.
+ */
+
+#include "alloc_hook.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> g_alloc_count(0);
+
+uint64_t alloc_hook_count(void) {
+    return g_alloc_count.load(std::memory_order_relaxed);
+}
+
+static void* counted_alloc(std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void* counted_alloc_aligned(std::size_t size, std::align_val_t align) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    std::size_t a = (std::size_t)align;
+    std::size_t rounded = (size + a - 1) / a * a;
+#ifdef _WIN32
+    void* p = _aligned_malloc(rounded ? rounded : a, a);
+#else
+    void* p = std::aligned_alloc(a, rounded ? rounded : a);
+#endif
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void aligned_free(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size)   { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+
+void* operator new(std::size_t size, std::align_val_t align)   { return counted_alloc_aligned(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return counted_alloc_aligned(size, align); }
+
+void operator delete(void* p) noexcept                { std::free(p); }
+void operator delete[](void* p) noexcept              { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept   { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept                { aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept              { aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept   { aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
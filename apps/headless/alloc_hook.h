@@ -0,0 +1,15 @@
+/*
+ * alloc_hook.h — Heap allocation counter (headless test hook)
+ *
+ * alloc_hook.cpp replaces the global operator new/delete for the whole
+ * headless binary, including the statically linked core, and counts
+ * every allocation. Tests read the counter around a region to prove it
+ * does not touch the heap.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/* Allocations (all threads) since process start. */
+uint64_t alloc_hook_count(void);
@@ -0,0 +1,397 @@
+/*
+ * batch.cpp — Headless batch simulation runner
+ *
+ * See batch.h for the scenario file format.
+ */
+
+#include "batch.h"
+#include "shell_common.h"
+#include "work_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/* ── Metrics ──────────────────────────────────────────────────────── */
+
+void batch_metric::add(int32_t v) {
+    if (samples == 0 || v < min) min = v;
+    if (samples == 0 || v > max) max = v;
+    sum += v;
+    samples++;
+}
+
+void batch_metric::merge(const batch_metric& other) {
+    if (other.samples == 0) return;
+    if (samples == 0 || other.min < min) min = other.min;
+    if (samples == 0 || other.max > max) max = other.max;
+    sum     += other.sum;
+    samples += other.samples;
+}
+
+void batch_stats::merge(const batch_stats& other) {
+    runs_completed  += other.runs_completed;
+    runs_failed     += other.runs_failed;
+    ticks_simulated += other.ticks_simulated;
+    damage.merge(other.damage);
+    destroys.merge(other.destroys);
+    fire_blocked.merge(other.fire_blocked);
+    reloads_done.merge(other.reloads_done);
+    ammo_in_mag.merge(other.ammo_in_mag);
+    ammo_reserve.merge(other.ammo_reserve);
+}
+
+/* ── Scenario parsing ─────────────────────────────────────────────── */
+
+static batch_scenario default_scenario(const char* name) {
+    batch_scenario sc;
+    sc.name          = name;
+    sc.content_path  = "content/";
+    sc.runs          = 1;
+    sc.ticks         = 60;
+    sc.seed          = 1;
+    sc.action_chance = 1.0;
+    return sc;
+}
+
+static bool parse_action(const char* kind, const char* a1, const char* a2,
+                         ax_action_v1* out) {
+    std::memset(out, 0, sizeof(*out));
+    out->actor_id = 1;   /* player (A1) */
+
+    if (std::strcmp(kind, "move") == 0 && a1 && a2) {
+        out->type     = AX_ACT_MOVE_INTENT;
+        out->u.move.x = (float)std::atof(a1);
+        out->u.move.y = (float)std::atof(a2);
+    } else if (std::strcmp(kind, "look") == 0 && a1 && a2) {
+        out->type         = AX_ACT_LOOK_INTENT;
+        out->u.look.yaw   = (float)std::atof(a1);
+        out->u.look.pitch = (float)std::atof(a2);
+    } else if (std::strcmp(kind, "fire") == 0) {
+        out->type = AX_ACT_FIRE_ONCE;
+        out->u.fire_once.weapon_slot = a1 ? (uint32_t)std::atoi(a1) : 0;
+    } else if (std::strcmp(kind, "reload") == 0) {
+        out->type = AX_ACT_RELOAD;
+        out->u.reload.weapon_slot = a1 ? (uint32_t)std::atoi(a1) : 0;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool batch_parse_file(const char* path, std::vector<batch_scenario>* out) {
+    FILE* f = std::fopen(path, "r");
+    if (!f) {
+        printf("batch: cannot open scenario file '%s'\n", path);
+        return false;
+    }
+
+    out->clear();
+    char line[512];
+    uint32_t line_no = 0;
+    bool ok = true;
+
+    while (ok && std::fgets(line, sizeof(line), f)) {
+        line_no++;
+
+        char* hash = std::strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char* tok[6] = {};
+        int n = 0;
+        for (char* t = std::strtok(line, " \t\r\n"); t && n < 6; t = std::strtok(nullptr, " \t\r\n")) {
+            tok[n++] = t;
+        }
+        if (n == 0) continue;
+
+        if (std::strcmp(tok[0], "scenario") == 0 && n >= 2) {
+            out->push_back(default_scenario(tok[1]));
+            continue;
+        }
+
+        /* every other key needs an open scenario */
+        if (out->empty()) {
+            out->push_back(default_scenario("default"));
+        }
+        batch_scenario& sc = out->back();
+
+        if (std::strcmp(tok[0], "content") == 0 && n >= 2) {
+            sc.content_path = tok[1];
+        } else if (std::strcmp(tok[0], "runs") == 0 && n >= 2) {
+            sc.runs = (uint32_t)std::strtoul(tok[1], nullptr, 10);
+        } else if (std::strcmp(tok[0], "ticks") == 0 && n >= 2) {
+            sc.ticks = (uint32_t)std::strtoul(tok[1], nullptr, 10);
+        } else if (std::strcmp(tok[0], "seed") == 0 && n >= 2) {
+            sc.seed = std::strtoull(tok[1], nullptr, 10);
+        } else if (std::strcmp(tok[0], "action_chance") == 0 && n >= 2) {
+            sc.action_chance = std::atof(tok[1]);
+        } else if (std::strcmp(tok[0], "action") == 0 && n >= 3) {
+            char* dash = std::strchr(tok[1], '-');
+            uint64_t first = std::strtoull(tok[1], nullptr, 10);
+            uint64_t last  = dash ? std::strtoull(dash + 1, nullptr, 10) : first;
+
+            ax_action_v1 act;
+            if (first == 0 || last < first ||
+                !parse_action(tok[2], n > 3 ? tok[3] : nullptr, n > 4 ? tok[4] : nullptr, &act)) {
+                ok = false;
+            } else {
+                for (uint64_t t = first; t <= last; ++t) {
+                    batch_action ba;
+                    ba.tick   = t;
+                    ba.action = act;
+                    sc.script.push_back(ba);
+                }
+            }
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            printf("batch: %s:%u: cannot parse '%s'\n", path, line_no, tok[0]);
+        }
+    }
+
+    std::fclose(f);
+
+    /* stable: keep file order within a tick (submission order matters) */
+    for (auto& sc : *out) {
+        std::stable_sort(sc.script.begin(), sc.script.end(),
+                         [](const batch_action& a, const batch_action& b) {
+                             return a.tick < b.tick;
+                         });
+    }
+
+    if (ok && out->empty()) {
+        printf("batch: %s: no scenarios defined\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+/* ── Per-run variation ────────────────────────────────────────────── */
+
+/* splitmix64: stateless hash → uniform [0,1) for (seed, run, action) */
+static double run_uniform(uint64_t seed, uint64_t run, uint64_t index) {
+    uint64_t z = seed ^ (run * 0x9E3779B97F4A7C15ull) ^ (index * 0xD1B54A32D192ED03ull);
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z =  z ^ (z >> 31);
+    return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* ── Running ──────────────────────────────────────────────────────── */
+
+/* a task is a contiguous chunk of runs from one scenario */
+struct batch_task {
+    uint32_t scenario;
+    uint32_t run_begin;
+    uint32_t run_end;
+};
+
+/* per-worker state: one reusable core + snapshot buffer */
+struct batch_worker {
+    ax_core*                 core;
+    std::vector<uint8_t>     snap_buf;
+    std::vector<batch_stats> stats;     /* one per scenario */
+};
+
+static bool batch_simulate(batch_worker& w, const batch_scenario& sc,
+                           uint32_t run, batch_stats& st) {
+    /* fresh world for every run (core instance is reused) */
+    ax_unload_content(w.core);
+
+    ax_content_load_params_v1 content = {};
+    content.version    = 1;
+    content.size_bytes = sizeof(content);
+    content.root_path  = sc.content_path.c_str();
+    if (ax_load_content(w.core, &content) != AX_OK) {
+        return false;
+    }
+
+    int32_t damage = 0, destroys = 0, blocked = 0, reloads = 0;
+    size_t next = 0;
+
+    for (uint64_t t = 1; t <= sc.ticks; ++t) {
+        for (; next < sc.script.size() && sc.script[next].tick == t; ++next) {
+            if (sc.action_chance < 1.0 &&
+                run_uniform(sc.seed, run, next) >= sc.action_chance) {
+                continue;
+            }
+            ax_action_v1 act = sc.script[next].action;
+            act.tick = t;
+
+            ax_action_batch_v1 batch = {};
+            batch.version    = 1;
+            batch.size_bytes = sizeof(batch);
+            batch.count      = 1;
+            batch.actions    = &act;
+            if (ax_submit_actions(w.core, &batch) != AX_OK) {
+                return false;
+            }
+        }
+
+        if (ax_step_ticks(w.core, 1) != AX_OK) {
+            return false;
+        }
+
+        uint32_t size = 0;
+        ax_get_snapshot_bytes(w.core, nullptr, 0, &size);
+        if (w.snap_buf.size() < size) {
+            w.snap_buf.resize(size);
+        }
+        if (ax_get_snapshot_bytes(w.core, w.snap_buf.data(), size, &size) != AX_OK) {
+            return false;
+        }
+
+        parsed_snapshot snap = parse_snapshot(w.snap_buf.data(), size);
+        for (uint32_t i = 0; i < snap.header->event_count; ++i) {
+            switch (snap.events[i].type) {
+                case AX_EVT_DAMAGE_DEALT:   damage += snap.events[i].value; break;
+                case AX_EVT_TARGET_DESTROY: destroys++;                     break;
+                case AX_EVT_FIRE_BLOCKED:   blocked++;                      break;
+                case AX_EVT_RELOAD_DONE:    reloads++;                      break;
+                default:                                                    break;
+            }
+        }
+
+        /* final weapon state from the last tick's snapshot */
+        if (t == sc.ticks && snap.weapon) {
+            st.ammo_in_mag.add(snap.weapon->ammo_in_mag);
+            st.ammo_reserve.add(snap.weapon->ammo_reserve);
+        }
+    }
+
+    st.damage.add(damage);
+    st.destroys.add(destroys);
+    st.fire_blocked.add(blocked);
+    st.reloads_done.add(reloads);
+    st.ticks_simulated += sc.ticks;
+    return true;
+}
+
+double batch_run(const std::vector<batch_scenario>& scenarios,
+                 uint32_t n_threads,
+                 std::vector<batch_stats>* out_stats) {
+    const uint32_t RUNS_PER_TASK = 16;
+
+    std::vector<batch_task> tasks;
+    for (uint32_t s = 0; s < (uint32_t)scenarios.size(); ++s) {
+        for (uint32_t r = 0; r < scenarios[s].runs; r += RUNS_PER_TASK) {
+            batch_task t;
+            t.scenario  = s;
+            t.run_begin = r;
+            t.run_end   = std::min(r + RUNS_PER_TASK, scenarios[s].runs);
+            tasks.push_back(t);
+        }
+    }
+
+    work_pool pool(n_threads);
+
+    std::vector<batch_worker> workers(pool.worker_count());
+    for (auto& w : workers) {
+        ax_create_params_v1 params = {};
+        params.version    = 1;
+        params.size_bytes = sizeof(params);
+        params.abi_major  = AX_ABI_MAJOR;
+        params.abi_minor  = AX_ABI_MINOR;
+
+        w.core = nullptr;
+        if (ax_create(&params, &w.core) != AX_OK) {
+            printf("batch: ax_create failed: %s\n", ax_get_last_error());
+        }
+        w.stats.assign(scenarios.size(), batch_stats{});
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    pool.run((uint32_t)tasks.size(), [&](uint32_t task_index, uint32_t worker_index) {
+        const batch_task& t = tasks[task_index];
+        batch_worker& w     = workers[worker_index];
+        batch_stats& st     = w.stats[t.scenario];
+
+        for (uint32_t run = t.run_begin; run < t.run_end; ++run) {
+            if (w.core && batch_simulate(w, scenarios[t.scenario], run, st)) {
+                st.runs_completed++;
+            } else {
+                st.runs_failed++;
+            }
+        }
+    });
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    out_stats->assign(scenarios.size(), batch_stats{});
+    for (auto& w : workers) {
+        for (size_t s = 0; s < scenarios.size(); ++s) {
+            (*out_stats)[s].merge(w.stats[s]);
+        }
+        ax_destroy(w.core);
+    }
+
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static void print_metric(const char* label, const batch_metric& m) {
+    printf("    %-14s mean %10.2f   min %8d   max %8d\n",
+           label, m.mean(), m.min, m.max);
+}
+
+int batch_main(int argc, char** argv) {
+    const char* path = nullptr;
+    uint32_t n_threads = 0;
+
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            n_threads = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            printf("batch: unexpected argument '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (!path) {
+        printf("usage: axiom_headless batch <scenario-file> [--threads N]\n");
+        return 2;
+    }
+
+    std::vector<batch_scenario> scenarios;
+    if (!batch_parse_file(path, &scenarios)) {
+        return 2;
+    }
+
+    printf("=== Axiom Headless Batch: %s ===\n\n", path);
+
+    std::vector<batch_stats> stats;
+    double seconds = batch_run(scenarios, n_threads, &stats);
+
+    uint64_t total_runs = 0, total_ticks = 0, total_failed = 0;
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+        const batch_stats& st = stats[s];
+        printf("  scenario %s: %u runs x %u ticks (%u failed)\n",
+               scenarios[s].name.c_str(), st.runs_completed,
+               scenarios[s].ticks, st.runs_failed);
+        print_metric("damage",       st.damage);
+        print_metric("destroys",     st.destroys);
+        print_metric("fire_blocked", st.fire_blocked);
+        print_metric("reloads_done", st.reloads_done);
+        print_metric("ammo_in_mag",  st.ammo_in_mag);
+        print_metric("ammo_reserve", st.ammo_reserve);
+
+        total_runs   += st.runs_completed;
+        total_ticks  += st.ticks_simulated;
+        total_failed += st.runs_failed;
+    }
+
+    printf("\n=== %llu sims, %llu ticks in %.3f s: %.0f sims/s, %.0f ticks/s ===\n",
+           (unsigned long long)total_runs, (unsigned long long)total_ticks, seconds,
+           seconds > 0.0 ? (double)total_runs / seconds : 0.0,
+           seconds > 0.0 ? (double)total_ticks / seconds : 0.0);
+
+    return total_failed > 0 ? 1 : 0;
+}
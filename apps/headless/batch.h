@@ -0,0 +1,86 @@
+/*
+ * batch.h — Headless batch simulation runner
+ *
+ * `axiom_headless batch <scenario-file> [--threads N]` runs thousands of
+ * independent simulations across all cores (work_pool) and aggregates
+ * outcome statistics, for balance sweeps and Monte Carlo runs.
+ *
+ * Scenario file format (line based, '#' starts a comment):
+ *
+ *   scenario <name>          start a new scenario
+ *   content  <path>          content root            (default: content/)
+ *   runs     <n>             independent simulations (default: 1)
+ *   ticks    <n>             ticks per simulation    (default: 60)
+ *   seed     <n>             base seed for per-run variation (default: 1)
+ *   action_chance <p>        probability [0,1] that each scripted action
+ *                            is submitted in a given run (default: 1)
+ *   action <tick>[-<tick>] <kind> [args]
+ *        kind: move <x> <y> | look <yaw> <pitch> | fire <slot> | reload <slot>
+ *
+ * Runs are deterministic: run i of a scenario always sees the same
+ * action subset, so results do not depend on the worker count.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct batch_action {
+    uint64_t     tick;
+    ax_action_v1 action;   /* tick field filled at submission */
+};
+
+struct batch_scenario {
+    std::string               name;
+    std::string               content_path;
+    uint32_t                  runs;
+    uint32_t                  ticks;
+    uint64_t                  seed;
+    double                    action_chance;
+    std::vector<batch_action> script;   /* sorted by tick */
+};
+
+/* sum/min/max of a per-run integer outcome */
+struct batch_metric {
+    int64_t sum;
+    int32_t min;
+    int32_t max;
+    uint32_t samples;
+
+    void add(int32_t v);
+    void merge(const batch_metric& other);
+    double mean() const { return samples ? (double)sum / (double)samples : 0.0; }
+};
+
+struct batch_stats {
+    uint32_t     runs_completed;
+    uint32_t     runs_failed;
+    uint64_t     ticks_simulated;
+
+    batch_metric damage;          /* DAMAGE_DEALT value total per run */
+    batch_metric destroys;        /* TARGET_DESTROY count per run     */
+    batch_metric fire_blocked;    /* FIRE_BLOCKED count per run       */
+    batch_metric reloads_done;    /* RELOAD_DONE count per run        */
+    batch_metric ammo_in_mag;     /* final magazine                   */
+    batch_metric ammo_reserve;    /* final reserve                    */
+
+    void merge(const batch_stats& other);
+};
+
+/* Parses a scenario file; on failure prints the offending line and returns false. */
+bool batch_parse_file(const char* path, std::vector<batch_scenario>* out);
+
+/*
+ * Runs every scenario on n_threads workers (0 = all cores).
+ * out_stats receives one entry per scenario. Returns wall-clock seconds.
+ */
+double batch_run(const std::vector<batch_scenario>& scenarios,
+                 uint32_t n_threads,
+                 std::vector<batch_stats>* out_stats);
+
+/* CLI entry point: argv = { <scenario-file>, [--threads N] } */
+int batch_main(int argc, char** argv);
@@ -0,0 +1,203 @@
+/*
+ * controller_bench.cpp — Character controller throughput benchmark
+ *
+ * See controller_bench.h.
+ */
+
+#include "controller_bench.h"
+#include "shell_common.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+/* ticks before timing starts: caches filled and spawn heights settled */
+static const uint32_t WARMUP_TICKS = 4;
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/* Stands `count` targets in a grid over the level, on the first surface below. */
+static bool spawn_actors(ax_core* core, const mesh_data& level, uint32_t count,
+                         std::vector<uint32_t>* ids) {
+    float lo[2] = { INFINITY, INFINITY }, hi[2] = { -INFINITY, -INFINITY };
+    float bottom = INFINITY, top = -INFINITY;
+    for (size_t i = 0; i < level.vertices.size(); i += 3) {
+        lo[0]  = std::fmin(lo[0], level.vertices[i]);
+        hi[0]  = std::fmax(hi[0], level.vertices[i]);
+        lo[1]  = std::fmin(lo[1], level.vertices[i + 2]);
+        hi[1]  = std::fmax(hi[1], level.vertices[i + 2]);
+        bottom = std::fmin(bottom, level.vertices[i + 1]);
+        top    = std::fmax(top, level.vertices[i + 1]);
+    }
+
+    uint32_t side = (uint32_t)std::ceil(std::sqrt((double)count));
+    std::vector<ax_ray_v1> rays(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ax_ray_v1& r = rays[i];
+        r.ox = lo[0] + (hi[0] - lo[0]) * (((float)(i % side) + 0.5f) / (float)side);
+        r.oy = top + 1.0f;
+        r.oz = lo[1] + (hi[1] - lo[1]) * (((float)(i / side) + 0.5f) / (float)side);
+        r.dy = -1.0f;
+        r.max_t = top - bottom + 2.0f;
+    }
+    std::vector<ax_ray_hit_v1> hits(count);
+    ax_raycast_params_v1 rp = {};
+    rp.version      = 1;
+    rp.size_bytes   = sizeof(rp);
+    rp.packet_width = 8;
+    if (ax_raycast(core, &rp, rays.data(), count, hits.data()) != AX_OK) return false;
+
+    ax_debug_spawn_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.archetype_id = 2000;
+    p.hp           = 50;
+    ids->clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        /* a roof or the open ground; a miss keeps the ray origin */
+        p.px = rays[i].ox;
+        p.py = rays[i].oy - (hits[i].triangle != AX_RAY_NO_HIT ? hits[i].t : 0.0f);
+        p.pz = rays[i].oz;
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &p, &id) != AX_OK) return false;
+        ids->push_back(id);
+    }
+    return true;
+}
+
+/* One MOVE_INTENT per actor; directions change every 16 ticks. */
+static bool submit_moves(ax_core* core, uint64_t tick, const std::vector<uint32_t>& ids,
+                         std::vector<ax_action_v1>* actions) {
+    actions->resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        uint64_t h = splitmix64((tick / 16) * 0x100000000ull + ids[i]);
+        ax_action_v1& a = (*actions)[i];
+        a = ax_action_v1{};
+        a.tick     = tick;
+        a.actor_id = ids[i];
+        a.type     = AX_ACT_MOVE_INTENT;
+        a.u.move.x = (float)(h & 0xFFFF) / 32767.5f - 1.0f;
+        a.u.move.y = (float)((h >> 16) & 0xFFFF) / 32767.5f - 1.0f;
+    }
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = (uint32_t)actions->size();
+    batch.actions    = actions->data();
+    return ax_submit_actions(core, &batch) == AX_OK;
+}
+
+bool controller_bench_run(const controller_bench_params& params, const mesh_data& level,
+                          controller_bench_result* out) {
+    std::memset(out, 0, sizeof(*out));
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_threading_params_v1 tp = {};
+    tp.version      = 1;
+    tp.size_bytes   = sizeof(tp);
+    tp.worker_count = params.workers;
+    std::vector<uint32_t> ids;
+    if (ax_set_threading(core, &tp) != AX_OK || mesh_upload(core, level) != AX_OK ||
+        !spawn_actors(core, level, params.actors, &ids)) {
+        printf("  controller_bench: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+
+    std::vector<ax_action_v1> actions;
+    bool ok = true;
+    uint64_t tick = 0;
+    double seconds = 0.0;
+    for (uint32_t t = 0; t < WARMUP_TICKS + params.ticks && ok; ++t) {
+        ok = submit_moves(core, ++tick, ids, &actions);
+        bench_clock::time_point t0 = bench_clock::now();
+        ok = ok && ax_step_ticks(core, 1) == AX_OK;
+        if (t >= WARMUP_TICKS) {
+            seconds += std::chrono::duration<double>(bench_clock::now() - t0).count();
+        }
+    }
+    ok = ok && ax_get_state_hash(core, &out->state_hash) == AX_OK;
+    if (!ok) printf("  controller_bench: %s\n", ax_get_last_error());
+
+    out->ms_per_tick   = params.ticks ? seconds * 1e3 / (double)params.ticks : 0.0;
+    out->actors_per_ms = out->ms_per_tick > 0.0 ? (double)params.actors / out->ms_per_tick : 0.0;
+    ax_destroy(core);
+    out->ok = ok;
+    return ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static int usage() {
+    printf("usage: axiom_headless controller-bench [--actors N] [--cells N] [--ticks N]"
+           " [--workers W1,W2,..]\n");
+    return 2;
+}
+
+int controller_bench_main(int argc, char** argv) {
+    uint32_t              actors  = 10000;
+    uint32_t              cells   = 512;
+    uint32_t              ticks   = 60;
+    std::vector<uint32_t> workers = { 1, 4 };
+
+    for (int i = 0; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--actors") == 0 && has_value) {
+            actors = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--cells") == 0 && has_value) {
+            cells = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && has_value) {
+            ticks = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && has_value) {
+            workers.clear();
+            for (const char* s = argv[++i]; *s;) {
+                char* end = nullptr;
+                workers.push_back((uint32_t)std::strtoul(s, &end, 10));
+                if (end == s) return usage();
+                s = (*end == ',') ? end + 1 : end;
+            }
+        } else {
+            return usage();
+        }
+    }
+    if (actors == 0 || cells == 0 || ticks == 0 || workers.empty()) return usage();
+
+    mesh_data level;
+    mesh_make_level(cells, 2.0f * (float)cells, 1, &level);
+
+    printf("=== Axiom Controller Bench: %u actors, %u triangles, %u ticks ===\n\n",
+           actors, level.triangle_count(), ticks);
+    printf("  %-8s %12s %14s\n", "workers", "ms/tick", "actors/ms");
+
+    uint64_t first_hash = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        controller_bench_params p = { "content/", actors, ticks, workers[i] };
+        controller_bench_result r;
+        if (!controller_bench_run(p, level, &r)) {
+            printf("  FAILED\n");
+            return 1;
+        }
+        printf("  %-8u %12.3f %14.1f\n", workers[i], r.ms_per_tick, r.actors_per_ms);
+        if (i == 0) {
+            first_hash = r.state_hash;
+        } else if (r.state_hash != first_hash) {
+            printf("  FAILED: state hash %016llx differs from %016llx\n",
+                   (unsigned long long)r.state_hash, (unsigned long long)first_hash);
+            return 1;
+        }
+    }
+    printf("\n  state hash %016llx identical across worker counts\n",
+           (unsigned long long)first_hash);
+    return 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * controller_bench.h — Character controller throughput benchmark
+ *
+ * `axiom_headless controller-bench [--actors N] [--cells N] [--ticks N]
+ *                                  [--workers W1,W2,..]`
+ *
+ * Loads mesh_make_level with N x N cells as the collision mesh, stands
+ * N targets on it in a grid (placed with a batch of downward rays) and
+ * drives every one of them with a seeded MOVE_INTENT each tick, so each
+ * tick moves all actors through the character controller. After a few
+ * warm-up ticks (caches filled, actors settled), reports the stepping
+ * time per tick and actors moved per millisecond for each worker count.
+ *
+ * The final state hash must be the same for every worker count; the run
+ * fails if not.
+ */
+
+#pragma once
+
+#include "mesh_import.h"
+
+#include <cstdint>
+
+struct controller_bench_params {
+    const char* content_path;
+    uint32_t    actors;
+    uint32_t    ticks;              /* timed, after the warm-up */
+    uint32_t    workers;
+};
+
+struct controller_bench_result {
+    bool     ok;
+    double   ms_per_tick;
+    double   actors_per_ms;
+    uint64_t state_hash;
+};
+
+bool controller_bench_run(const controller_bench_params& params, const mesh_data& level,
+                          controller_bench_result* out);
+
+/* CLI entry point: argv = { flags as above } */
+int controller_bench_main(int argc, char** argv);
@@ -0,0 +1,122 @@
+/*
+ * core_api.cpp — The C ABI as a function table (linked or loaded core)
+ *
+ * See core_api.h.
+ */
+
+#include "core_api.h"
+
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <dlfcn.h>
+#endif
+
+const core_api* core_api_linked() {
+    static const core_api api = {
+        "linked",
+        ax_get_abi_version,
+        ax_get_last_error,
+        ax_create,
+        ax_destroy,
+        ax_load_content,
+        ax_get_content_hash,
+        ax_set_threading,
+        ax_submit_actions,
+        ax_step_ticks,
+        ax_get_state_hash,
+        ax_get_snapshot_bytes,
+        ax_save_bytes,
+        ax_load_save_bytes,
+    };
+    return &api;
+}
+
+#if defined(_WIN32)
+static void* open_library(const char* path) { return (void*)LoadLibraryA(path); }
+static std::string load_error(const char* path) {
+    return std::string("cannot load ") + path + ": error " + std::to_string(GetLastError());
+}
+static void* find_symbol(void* lib, const char* name) {
+    return (void*)GetProcAddress((HMODULE)lib, name);
+}
+static void close_library(void* lib) { FreeLibrary((HMODULE)lib); }
+#else
+static void* open_library(const char* path) { return dlopen(path, RTLD_NOW | RTLD_LOCAL); }
+static std::string load_error(const char* path) {
+    const char* e = dlerror();     /* names the path already */
+    return e ? e : std::string("cannot load ") + path;
+}
+static void* find_symbol(void* lib, const char* name) { return dlsym(lib, name); }
+static void close_library(void* lib) { dlclose(lib); }
+#endif
+
+template <class F>
+static bool resolve(void* lib, const char* name, F* out, std::string* error) {
+    void* sym = find_symbol(lib, name);
+    if (!sym) {
+        *error = std::string("missing symbol ") + name;
+        return false;
+    }
+    *out = reinterpret_cast<F>(sym);
+    return true;
+}
+
+const core_api* core_api_load(const char* path, std::string* error) {
+    void* lib = open_library(path);
+    if (!lib) {
+        *error = load_error(path);
+        return nullptr;
+    }
+
+    /* one table per load, kept with the library for the process lifetime */
+    core_api* api = new core_api();
+    api->name = path;
+    bool ok = resolve(lib, "ax_get_abi_version", &api->get_abi_version, error) &&
+              resolve(lib, "ax_get_last_error", &api->get_last_error, error) &&
+              resolve(lib, "ax_create", &api->create, error) &&
+              resolve(lib, "ax_destroy", &api->destroy, error) &&
+              resolve(lib, "ax_load_content", &api->load_content, error) &&
+              resolve(lib, "ax_get_content_hash", &api->get_content_hash, error) &&
+              resolve(lib, "ax_set_threading", &api->set_threading, error) &&
+              resolve(lib, "ax_submit_actions", &api->submit_actions, error) &&
+              resolve(lib, "ax_step_ticks", &api->step_ticks, error) &&
+              resolve(lib, "ax_get_state_hash", &api->get_state_hash, error) &&
+              resolve(lib, "ax_get_snapshot_bytes", &api->get_snapshot_bytes, error) &&
+              resolve(lib, "ax_save_bytes", &api->save_bytes, error) &&
+              resolve(lib, "ax_load_save_bytes", &api->load_save_bytes, error);
+    if (ok && api->get_abi_version().major != AX_ABI_MAJOR) {
+        *error = std::string(path) + ": ABI major " + std::to_string(api->get_abi_version().major) +
+                 ", this shell is " + std::to_string(AX_ABI_MAJOR);
+        ok = false;
+    }
+    if (!ok) {
+        delete api;
+        close_library(lib);
+        return nullptr;
+    }
+    return api;
+}
+
+ax_core* core_api_create_and_load(const core_api* api, const char* content_path) {
+    ax_create_params_v1 params = {};
+    params.version    = 1;
+    params.size_bytes = sizeof(params);
+    params.abi_major  = AX_ABI_MAJOR;
+    params.abi_minor  = AX_ABI_MINOR;
+
+    ax_core* core = nullptr;
+    if (api->create(&params, &core) != AX_OK) {
+        return nullptr;
+    }
+
+    ax_content_load_params_v1 content = {};
+    content.version    = 1;
+    content.size_bytes = sizeof(content);
+    content.root_path  = content_path;
+    if (api->load_content(core, &content) != AX_OK) {
+        api->destroy(core);
+        return nullptr;
+    }
+    return core;
+}
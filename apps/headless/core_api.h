@@ -0,0 +1,49 @@
+/*
+ * core_api.h — The C ABI as a function table (linked or loaded core)
+ *
+ * Shell code that may drive a core from a different build — the
+ * determinism verifier comparing build flavors — calls through a
+ * core_api instead of the ax_* symbols. core_api_linked() is the core
+ * this shell was linked with; core_api_load() opens a shared-library
+ * build (AX_BUILD_SHARED_CORE: libaxiom_core.so / axiom_core.dll) and
+ * resolves the same entry points from it. A core must only ever be
+ * passed to functions of the table that created it.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <string>
+
+struct core_api {
+    const char* name;       /* "linked" or the library path */
+
+    ax_abi_version (*get_abi_version)(void);
+    const char*    (*get_last_error)(void);
+    ax_result      (*create)(const ax_create_params_v1* params, ax_core** out_core);
+    void           (*destroy)(ax_core* core);
+    ax_result      (*load_content)(ax_core* core, const ax_content_load_params_v1* params);
+    ax_result      (*get_content_hash)(ax_core* core, uint64_t* out_hash);
+    ax_result      (*set_threading)(ax_core* core, const ax_threading_params_v1* params);
+    ax_result      (*submit_actions)(ax_core* core, const ax_action_batch_v1* batch);
+    ax_result      (*step_ticks)(ax_core* core, uint32_t n_ticks);
+    ax_result      (*get_state_hash)(ax_core* core, uint64_t* out_hash);
+    ax_result      (*get_snapshot_bytes)(ax_core* core, void* out_buf, uint32_t out_cap_bytes,
+                                         uint32_t* out_size_bytes);
+    ax_result      (*save_bytes)(ax_core* core, void* out_buf, uint32_t out_cap_bytes,
+                                 uint32_t* out_size_bytes);
+    ax_result      (*load_save_bytes)(ax_core* core, const void* save_buf, uint32_t save_size_bytes);
+};
+
+const core_api* core_api_linked();
+
+/*
+ * Opens `path` and resolves every entry point. NULL with *error set if
+ * the library does not load, lacks a symbol or has another ABI major.
+ * Libraries stay loaded for the life of the process.
+ */
+const core_api* core_api_load(const char* path, std::string* error);
+
+/* ax_create + ax_load_content through `api`; NULL (core destroyed) on failure. */
+ax_core* core_api_create_and_load(const core_api* api, const char* content_path);
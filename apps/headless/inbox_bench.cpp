@@ -0,0 +1,190 @@
+/*
+ * inbox_bench.cpp — Action inbox latency microbenchmark
+ *
+ * See inbox_bench.h.
+ */
+
+#include "inbox_bench.h"
+#include "shell_common.h"
+
+#include "ax_abi.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static uint64_t now_ns(bench_clock::time_point origin) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        bench_clock::now() - origin).count();
+}
+
+/* yaw accumulated on actor 1 == number of +1 LOOK actions applied */
+static bool read_applied(ax_core* core, std::vector<uint8_t>& buf, uint32_t* out_applied) {
+    uint32_t size = 0;
+    if (ax_get_snapshot_bytes(core, nullptr, 0, &size) != AX_OK) return false;
+    buf.resize(size);
+    if (ax_get_snapshot_bytes(core, buf.data(), size, &size) != AX_OK) return false;
+
+    parsed_snapshot snap = parse_snapshot(buf.data(), size);
+    if (!snap.header) return false;
+    for (uint32_t i = 0; i < snap.header->entity_count; ++i) {
+        if (snap.entities[i].id == 1) {
+            *out_applied = (uint32_t)snap.entities[i].ry;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool inbox_bench_run(const inbox_bench_params& params, inbox_bench_result* out) {
+    out->ok           = false;
+    out->applied      = 0;
+    out->ticks        = 0;
+    out->full_retries = 0;
+    out->latency_ns.assign(params.actions, 0);
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_inbox_params_v1 ip = {};
+    ip.version    = 1;
+    ip.size_bytes = sizeof(ip);
+    ip.capacity   = 1024;
+    if (ax_enable_action_inbox(core, &ip) != AX_OK) {
+        printf("  inbox_bench: enable failed: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+
+    /* written by the producer before each push, read after application */
+    std::vector<uint64_t> submit_ns(params.actions, 0);
+    std::atomic<bool>     producer_failed(false);
+    uint64_t              full_retries = 0;
+    const bench_clock::time_point origin = bench_clock::now();
+
+    std::thread producer([&] {
+        ax_action_v1 a = {};
+        a.tick        = 0;
+        a.actor_id    = 1;
+        a.type        = AX_ACT_LOOK_INTENT;
+        a.u.look.yaw  = 1.0f;
+
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = 1;
+        batch.actions    = &a;
+
+        for (uint32_t seq = 0; seq < params.actions; ++seq) {
+            submit_ns[seq] = now_ns(origin);
+            ax_result r;
+            while ((r = ax_inbox_submit_actions(core, &batch)) == AX_ERR_QUEUE_FULL) {
+                full_retries++;
+                std::this_thread::yield();
+            }
+            if (r != AX_OK) {
+                producer_failed.store(true);
+                return;
+            }
+            if (params.interval_us) {
+                std::this_thread::sleep_for(std::chrono::microseconds(params.interval_us));
+            }
+        }
+    });
+
+    std::vector<uint8_t> snap_buf;
+    uint32_t applied = 0;
+    bool ok = true;
+    const auto tick_period = params.tick_hz
+        ? std::chrono::nanoseconds(1000000000ull / params.tick_hz)
+        : std::chrono::nanoseconds(0);
+    bench_clock::time_point next_tick = bench_clock::now();
+
+    while (applied < params.actions && !producer_failed.load()) {
+        if (params.tick_hz) {
+            next_tick += tick_period;
+            std::this_thread::sleep_until(next_tick);
+        }
+        if (ax_step_ticks(core, 1) != AX_OK) {
+            ok = false;
+            break;
+        }
+        out->ticks++;
+
+        uint32_t now_applied = 0;
+        if (!read_applied(core, snap_buf, &now_applied) || now_applied > params.actions) {
+            ok = false;
+            break;
+        }
+        uint64_t t = now_ns(origin);
+        for (; applied < now_applied; ++applied) {
+            out->latency_ns[applied] = t - submit_ns[applied];
+        }
+        if (params.tick_hz == 0 && applied == now_applied) {
+            std::this_thread::yield();   /* idle tick: let the producer run */
+        }
+    }
+
+    producer.join();
+    ax_destroy(core);
+
+    out->applied      = applied;
+    out->full_retries = full_retries;
+    out->ok           = ok && !producer_failed.load() && applied == params.actions;
+    return out->ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static double percentile_us(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return (double)sorted[i] / 1000.0;
+}
+
+int inbox_bench_main(int argc, char** argv) {
+    inbox_bench_params params;
+    params.content_path = "content/";
+    params.actions      = 10000;
+    params.interval_us  = 50;
+    params.tick_hz      = 0;
+
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--actions") == 0 && i + 1 < argc) {
+            params.actions = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--interval-us") == 0 && i + 1 < argc) {
+            params.interval_us = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--tick-hz") == 0 && i + 1 < argc) {
+            params.tick_hz = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            printf("usage: axiom_headless inbox-bench [--actions N] [--interval-us U] [--tick-hz H]\n");
+            return 2;
+        }
+    }
+
+    printf("=== Axiom Inbox Latency: %u actions, %u us apart, %s ===\n\n",
+           params.actions, params.interval_us,
+           params.tick_hz ? "paced ticks" : "unpaced ticks");
+
+    inbox_bench_result res;
+    if (!inbox_bench_run(params, &res)) {
+        printf("  FAILED: %u / %u actions applied\n", res.applied, params.actions);
+        return 1;
+    }
+
+    std::vector<uint64_t> sorted = res.latency_ns;
+    std::sort(sorted.begin(), sorted.end());
+
+    printf("  ticks stepped : %llu\n", (unsigned long long)res.ticks);
+    printf("  full retries  : %llu\n", (unsigned long long)res.full_retries);
+    printf("  latency (us)  : median %.1f  p99 %.1f  max %.1f\n",
+           percentile_us(sorted, 0.50), percentile_us(sorted, 0.99),
+           percentile_us(sorted, 1.0));
+    return 0;
+}
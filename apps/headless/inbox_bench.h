@@ -0,0 +1,39 @@
+/*
+ * inbox_bench.h — Action inbox latency microbenchmark
+ *
+ * `axiom_headless inbox-bench [--actions N] [--interval-us U] [--tick-hz H]`
+ *
+ * An input thread submits one LOOK action (yaw +1, tick 0 = "next tick")
+ * every U microseconds through the lock-free action inbox while the main
+ * thread steps the core. After each tick the main thread reads the
+ * player's accumulated yaw to learn how many actions have been applied
+ * and records submit-to-application latency for each of them.
+ *
+ * H = 0 (default) steps as fast as possible; otherwise ticks are paced
+ * at H per second, which puts the tick interval into the latency.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct inbox_bench_params {
+    const char* content_path;
+    uint32_t    actions;
+    uint32_t    interval_us;
+    uint32_t    tick_hz;
+};
+
+struct inbox_bench_result {
+    bool                  ok;
+    uint32_t              applied;       /* actions seen applied, in order */
+    uint64_t              ticks;
+    uint64_t              full_retries;  /* submits that hit AX_ERR_QUEUE_FULL */
+    std::vector<uint64_t> latency_ns;    /* per action, submission order */
+};
+
+bool inbox_bench_run(const inbox_bench_params& params, inbox_bench_result* out);
+
+/* CLI entry point: argv = { [--actions N] [--interval-us U] [--tick-hz H] } */
+int inbox_bench_main(int argc, char** argv);
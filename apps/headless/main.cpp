@@ -6,33 +6,59 @@
  *   - determinism tests
  *   - replay validation
  *   - CI acceptance checks
+ *   - batch simulation (`axiom_headless batch <scenario-file>`)
+ *   - perf regression gate (`axiom_headless --perf`, perf_gate.h)
+ *   - large-world generation (`axiom_headless worldgen`, worldgen.h)
+ *   - input recording and replay (`axiom_headless record / replay`, replay.h)
+ *   - collision raycast throughput (`axiom_headless raycast-bench`, raycast_bench.h)
+ *   - character controller throughput (`axiom_headless controller-bench`, controller_bench.h)
  *
  * Authoritative spec: COMBAT_A1.md v0.4 (acceptance criteria)
  */
 
 #include "ax_abi.h"
-
+#include "shell_common.h"
+#include "alloc_hook.h"
+#include "batch.h"
+#include "inbox_bench.h"
+#include "snapshot_bench.h"
+#include "profile_report.h"
+#include "trace_export.h"
+#include "perf_gate.h"
+#include "worldgen.h"
+#include "replay.h"
+#include "verify.h"
+#include "mesh_import.h"
+#include "raycast_bench.h"
+#include "controller_bench.h"
+#include "weapon_bench.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
-/* ── Result code to string ────────────────────────────────────────── */
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
 
-static const char* result_str(ax_result r) {
-    switch (r) {
-        case AX_OK:                   return "AX_OK";
-        case AX_ERR_INVALID_ARG:      return "AX_ERR_INVALID_ARG";
-        case AX_ERR_BAD_STATE:        return "AX_ERR_BAD_STATE";
-        case AX_ERR_UNSUPPORTED:      return "AX_ERR_UNSUPPORTED";
-        case AX_ERR_BUFFER_TOO_SMALL: return "AX_ERR_BUFFER_TOO_SMALL";
-        case AX_ERR_PARSE_FAILED:     return "AX_ERR_PARSE_FAILED";
-        case AX_ERR_IO:               return "AX_ERR_IO";
-        case AX_ERR_INTERNAL:         return "AX_ERR_INTERNAL";
-        default:                      return "UNKNOWN";
-    }
-}
+/*
+ * The thread-start failure test caps the address space (RLIMIT_AS);
+ * sanitizer runtimes map memory of their own and would fail first.
+ */
+#if defined(__linux__) && !defined(__SANITIZE_THREAD__) && !defined(__SANITIZE_ADDRESS__)
+#define AX_TEST_CAN_CAP_ADDRESS_SPACE 1
+#else
+#define AX_TEST_CAN_CAP_ADDRESS_SPACE 0
+#endif
 
 /* ── Test bookkeeping ─────────────────────────────────────────────── */
 
@@ -59,210 +85,6 @@ static int g_tests_failed = 0;
     CHECK((r) == (expected), "expected %s, got %s",                     \
           result_str(expected), result_str(r))
 
-/* ── Snapshot parsing helpers ─────────────────────────────────────── */
-
-struct parsed_snapshot {
-    const ax_snapshot_header_v1*        header;
-    const ax_snapshot_entity_v1*        entities;    /* array */
-    const ax_snapshot_player_weapon_v1* weapon;      /* NULL if absent */
-    const ax_snapshot_event_v1*         events;      /* array */
-};
-
-static parsed_snapshot parse_snapshot(const void* buf, uint32_t size) {
-    parsed_snapshot snap = {};
-
-    if (!buf || size < sizeof(ax_snapshot_header_v1)) {
-        return snap;
-    }
-
-    const uint8_t* p = (const uint8_t*)buf;
-    uint32_t offset = 0;
-
-    /* header */
-    snap.header = (const ax_snapshot_header_v1*)(p + offset);
-    offset += sizeof(ax_snapshot_header_v1);
-
-    /* entities */
-    uint32_t entities_size = snap.header->entity_count * snap.header->entity_stride_bytes;
-    if (offset + entities_size > size) return snap;
-    snap.entities = (const ax_snapshot_entity_v1*)(p + offset);
-    offset += entities_size;
-
-    /* weapon (optional) */
-    if (snap.header->player_weapon_present) {
-        if (offset + sizeof(ax_snapshot_player_weapon_v1) > size) return snap;
-        snap.weapon = (const ax_snapshot_player_weapon_v1*)(p + offset);
-        offset += sizeof(ax_snapshot_player_weapon_v1);
-    }
-
-    /* events */
-    uint32_t events_size = snap.header->event_count * snap.header->event_stride_bytes;
-    if (offset + events_size > size) return snap;
-    snap.events = (const ax_snapshot_event_v1*)(p + offset);
-
-    return snap;
-}
-
-/* ── Lifecycle helpers ────────────────────────────────────────────── */
-
-static ax_core* create_and_load(const char* content_path) {
-    ax_create_params_v1 params = {};
-    params.version    = 1;
-    params.size_bytes = sizeof(params);
-    params.abi_major  = AX_ABI_MAJOR;
-    params.abi_minor  = AX_ABI_MINOR;
-    params.log_fn     = nullptr;
-    params.log_user   = nullptr;
-
-    ax_core* core = nullptr;
-    ax_result r = ax_create(&params, &core);
-    if (r != AX_OK) {
-        printf("  create_and_load: ax_create failed: %s\n", result_str(r));
-        return nullptr;
-    }
-
-    ax_content_load_params_v1 content = {};
-    content.version    = 1;
-    content.size_bytes = sizeof(content);
-    content.root_path  = content_path;
-
-    r = ax_load_content(core, &content);
-    if (r != AX_OK) {
-        printf("  create_and_load: ax_load_content failed: %s\n", result_str(r));
-        ax_destroy(core);
-        return nullptr;
-    }
-
-    return core;
-}
-
-static std::vector<uint8_t> take_snapshot(ax_core* core) {
-    uint32_t size = 0;
-    ax_result r = ax_get_snapshot_bytes(core, nullptr, 0, &size);
-    if (r != AX_OK || size == 0) {
-        printf("  take_snapshot: size query failed: %s\n", result_str(r));
-        return {};
-    }
-
-    std::vector<uint8_t> buf(size);
-    r = ax_get_snapshot_bytes(core, buf.data(), size, &size);
-    if (r != AX_OK) {
-        printf("  take_snapshot: copy failed: %s\n", result_str(r));
-        return {};
-    }
-
-    return buf;
-}
-
-static void submit_action(ax_core* core, const ax_action_v1& action) {
-    ax_action_batch_v1 batch = {};
-    batch.version    = 1;
-    batch.size_bytes = sizeof(batch);
-    batch.count      = 1;
-    batch.actions    = &action;
-
-    ax_result r = ax_submit_actions(core, &batch);
-    if (r != AX_OK) {
-        printf("  submit_action: failed: %s (%s)\n",
-               result_str(r), ax_get_last_error());
-    }
-}
-
-static std::vector<uint8_t> take_save(ax_core* core) {
-    uint32_t size = 0;
-    ax_result r = ax_save_bytes(core, nullptr, 0, &size);
-    if (r != AX_OK || size == 0) {
-        printf("  take_save: size query failed: %s\n", result_str(r));
-        return {};
-    }
-
-    std::vector<uint8_t> buf(size);
-    r = ax_save_bytes(core, buf.data(), size, &size);
-    if (r != AX_OK) {
-        printf("  take_save: copy failed: %s\n", result_str(r));
-        return {};
-    }
-
-    return buf;
-}
-
-/* ── Snapshot comparison (logic-relevant A1 fields) ──────────────── */
-
-static int compare_snapshots_logic(const char* label,
-                                   const parsed_snapshot& a,
-                                   const parsed_snapshot& b) {
-    int mismatches = 0;
-
-    /* tick */
-    if (a.header->tick != b.header->tick) {
-        printf("  %s: tick mismatch: %llu vs %llu\n", label,
-               (unsigned long long)a.header->tick, (unsigned long long)b.header->tick);
-        mismatches++;
-    }
-
-    /* entity count */
-    if (a.header->entity_count != b.header->entity_count) {
-        printf("  %s: entity_count mismatch: %u vs %u\n", label,
-               a.header->entity_count, b.header->entity_count);
-        mismatches++;
-    }
-
-    uint32_t ent_count = a.header->entity_count < b.header->entity_count
-                       ? a.header->entity_count : b.header->entity_count;
-
-    for (uint32_t i = 0; i < ent_count; ++i) {
-        const auto& ea = a.entities[i];
-        const auto& eb = b.entities[i];
-
-        if (ea.id != eb.id) {
-            printf("  %s: entity[%u] id mismatch: %u vs %u\n", label, i, ea.id, eb.id);
-            mismatches++;
-        }
-        if (ea.hp != eb.hp) {
-            printf("  %s: entity[%u] hp mismatch: %d vs %d\n", label, i, ea.hp, eb.hp);
-            mismatches++;
-        }
-        if (ea.state_flags != eb.state_flags) {
-            printf("  %s: entity[%u] state_flags mismatch: 0x%x vs 0x%x\n", label, i,
-                   ea.state_flags, eb.state_flags);
-            mismatches++;
-        }
-        /* transforms (spatial-tier, but should round-trip identically within same process) */
-        if (ea.px != eb.px || ea.py != eb.py || ea.pz != eb.pz) {
-            printf("  %s: entity[%u] position mismatch\n", label, i);
-            mismatches++;
-        }
-        if (ea.rx != eb.rx || ea.ry != eb.ry || ea.rz != eb.rz || ea.rw != eb.rw) {
-            printf("  %s: entity[%u] rotation mismatch\n", label, i);
-            mismatches++;
-        }
-    }
-
-    /* weapon state */
-    if (a.weapon && b.weapon) {
-        if (a.weapon->ammo_in_mag != b.weapon->ammo_in_mag) {
-            printf("  %s: ammo_in_mag mismatch: %d vs %d\n", label,
-                   a.weapon->ammo_in_mag, b.weapon->ammo_in_mag);
-            mismatches++;
-        }
-        if (a.weapon->ammo_reserve != b.weapon->ammo_reserve) {
-            printf("  %s: ammo_reserve mismatch: %d vs %d\n", label,
-                   a.weapon->ammo_reserve, b.weapon->ammo_reserve);
-            mismatches++;
-        }
-        if (a.weapon->weapon_flags != b.weapon->weapon_flags) {
-            printf("  %s: weapon_flags mismatch: 0x%x vs 0x%x\n", label,
-                   a.weapon->weapon_flags, b.weapon->weapon_flags);
-            mismatches++;
-        }
-    } else if ((a.weapon != nullptr) != (b.weapon != nullptr)) {
-        printf("  %s: weapon presence mismatch\n", label);
-        mismatches++;
-    }
-
-    return mismatches;
-}
-
 /* ══════════════════════════════════════════════════════════════════════
  * Test: basic fire + damage
  * COMBAT_A1 acceptance criteria #1
@@ -1457,11 +1279,4320 @@ static void test_error_paths(void) {
     printf("  done\n");
 }
 
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: concurrent cores
+ * N independent cores on N threads, each running full
+ * create/load/step/save/load/destroy cycles. Verifies that results and
+ * error state never leak between threads (run under AX_ENABLE_TSAN for
+ * the data-race check).
+ * ══════════════════════════════════════════════════════════════════ */
+
+struct concurrent_worker_result {
+    int         failures;
+    std::string first_failure;
+};
+
+static void concurrent_fail(concurrent_worker_result& res, const char* msg) {
+    if (res.failures++ == 0) {
+        res.first_failure = msg;
+    }
+}
+
+static void concurrent_core_worker(uint32_t index, uint32_t cycles,
+                                   concurrent_worker_result* out) {
+    concurrent_worker_result& res = *out;
+    char msg[256];
+
+    for (uint32_t c = 0; c < cycles; ++c) {
+        ax_core* core = create_and_load("content/");
+        if (!core) {
+            concurrent_fail(res, "create_and_load failed");
+            return;
+        }
+
+        /*
+         * Provoke a thread-unique error: a save buffer shorter than the
+         * header reports its own size in the message.
+         */
+        uint8_t junk[16] = {};
+        uint32_t junk_size = 1 + (index % 15);
+        ax_result r = ax_load_save_bytes(core, junk, junk_size);
+        char expected[32];
+        snprintf(expected, sizeof(expected), "(%u <", junk_size);
+        if (r != AX_ERR_INVALID_ARG ||
+            !strstr(ax_get_last_error(), expected) ||
+            !strstr(ax_get_core_last_error(core), expected)) {
+            snprintf(msg, sizeof(msg), "thread %u: error state leaked: '%s' / '%s'",
+                     index, ax_get_last_error(), ax_get_core_last_error(core));
+            concurrent_fail(res, msg);
+        }
+
+        /* empty the magazine, reload, fire again (ticks 1..45) */
+        uint64_t tick = 0;
+        for (uint32_t i = 0; i < 13; ++i) {
+            ax_action_v1 fire = {};
+            fire.tick     = ++tick;
+            fire.actor_id = 1;
+            fire.type     = AX_ACT_FIRE_ONCE;
+            submit_action(core, fire);
+            ax_step_ticks(core, 1);
+        }
+        if (ax_get_last_error()[0] != '\0' || ax_get_core_last_error(core)[0] != '\0') {
+            concurrent_fail(res, "last error not cleared by successful calls");
+        }
+
+        ax_action_v1 reload = {};
+        reload.tick     = ++tick;
+        reload.actor_id = 1;
+        reload.type     = AX_ACT_RELOAD;
+        submit_action(core, reload);
+        ax_step_ticks(core, 1);
+
+        /* save mid-reload, continue on a fresh core */
+        auto save_data = take_save(core);
+        auto at_save   = take_snapshot(core);
+        ax_unload_content(core);
+        ax_destroy(core);
+
+        core = create_and_load("content/");
+        if (!core || save_data.empty() ||
+            ax_load_save_bytes(core, save_data.data(), (uint32_t)save_data.size()) != AX_OK) {
+            concurrent_fail(res, "save/load round trip failed");
+            if (core) ax_destroy(core);
+            return;
+        }
+
+        auto post_load = take_snapshot(core);
+        parsed_snapshot sa = parse_snapshot(at_save.data(), (uint32_t)at_save.size());
+        parsed_snapshot sb = parse_snapshot(post_load.data(), (uint32_t)post_load.size());
+        if (!sa.header || !sb.header || sa.header->tick != sb.header->tick) {
+            concurrent_fail(res, "snapshot mismatch after load");
+        }
+
+        ax_step_ticks(core, 30);
+
+        ax_action_v1 fire = {};
+        fire.tick     = tick + 31;
+        fire.actor_id = 1;
+        fire.type     = AX_ACT_FIRE_ONCE;
+        submit_action(core, fire);
+        ax_step_ticks(core, 1);
+
+        /* 14 shots total: 12 + 1 after reload land, 1 blocked on empty */
+        auto final_buf = take_snapshot(core);
+        parsed_snapshot fs = parse_snapshot(final_buf.data(), (uint32_t)final_buf.size());
+        if (!fs.weapon || fs.weapon->ammo_in_mag != 11 || fs.weapon->ammo_reserve != 36) {
+            snprintf(msg, sizeof(msg), "thread %u cycle %u: unexpected weapon state", index, c);
+            concurrent_fail(res, msg);
+        }
+
+        ax_unload_content(core);
+        ax_destroy(core);
+    }
+}
+
+static void test_concurrent_cores(void) {
+    printf("test_concurrent_cores\n");
+
+    uint32_t n_threads = std::thread::hardware_concurrency();
+    if (n_threads < 4) n_threads = 4;
+    if (n_threads > 16) n_threads = 16;
+    const uint32_t cycles = 20;
+
+    std::vector<concurrent_worker_result> results(n_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+
+    for (uint32_t i = 0; i < n_threads; ++i) {
+        results[i].failures = 0;
+        threads.emplace_back(concurrent_core_worker, i, cycles, &results[i]);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (uint32_t i = 0; i < n_threads; ++i) {
+        CHECK(results[i].failures == 0, "thread %u: %d failures, first: %s",
+              i, results[i].failures, results[i].first_failure.c_str());
+    }
+
+    /* per-core error accessor on the main thread */
+    {
+        ax_core* core = create_and_load("content/");
+        CHECK(core != nullptr, "setup failed");
+        if (core) {
+            ax_result r = ax_step_ticks(core, 0);
+            CHECK_OK(r);
+            CHECK(ax_get_core_last_error(core)[0] == '\0',
+                  "core last error should be empty after success");
+
+            r = ax_get_snapshot_bytes(core, nullptr, 0, nullptr);
+            CHECK_ERR(r, AX_ERR_INVALID_ARG);
+            CHECK(strcmp(ax_get_core_last_error(core), ax_get_last_error()) == 0,
+                  "core and thread last error should match on the calling thread");
+            CHECK(ax_get_core_last_error(nullptr)[0] == '\0',
+                  "NULL core should yield an empty string");
+
+            ax_unload_content(core);
+            ax_destroy(core);
+        }
+    }
+
+    printf("  %u threads x %u cycles\n", n_threads, cycles);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: batch runner
+ * Work-stealing batch results are independent of the worker count and
+ * match the single-core A1 rules.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_batch_runner(void) {
+    printf("test_batch_runner\n");
+
+    std::vector<batch_scenario> scenarios(2);
+
+    /* scenario 0: fixed script, 12 shots + 3 blocked + reload + 2 shots */
+    batch_scenario& fixed = scenarios[0];
+    fixed.name          = "fixed";
+    fixed.content_path  = "content/";
+    fixed.runs          = 40;
+    fixed.ticks         = 50;
+    fixed.seed          = 1;
+    fixed.action_chance = 1.0;
+    for (uint64_t t = 1; t <= 45; ++t) {
+        batch_action ba = {};
+        ba.tick            = t;
+        ba.action.actor_id = 1;
+        ba.action.type     = (t == 14) ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+        if (t <= 16 || t >= 44) fixed.script.push_back(ba);
+    }
+
+    /* scenario 1: Monte Carlo variant of the same script */
+    scenarios[1]               = fixed;
+    scenarios[1].name          = "monte_carlo";
+    scenarios[1].runs          = 57;   /* not a multiple of the task chunk */
+    scenarios[1].seed          = 99;
+    scenarios[1].action_chance = 0.5;
+
+    std::vector<batch_stats> serial, parallel;
+    batch_run(scenarios, 1, &serial);
+    batch_run(scenarios, 3, &parallel);
+
+    CHECK(serial[0].runs_completed == 40, "fixed: expected 40 runs, got %u",
+          serial[0].runs_completed);
+    CHECK(serial[0].runs_failed == 0, "fixed: %u runs failed", serial[0].runs_failed);
+    CHECK(serial[0].damage.min == 140 && serial[0].damage.max == 140,
+          "fixed: damage should be 140 every run, got %d..%d",
+          serial[0].damage.min, serial[0].damage.max);
+    CHECK(serial[0].destroys.sum == 2 * 40, "fixed: expected 2 destroys per run, got %lld total",
+          (long long)serial[0].destroys.sum);
+    CHECK(serial[0].fire_blocked.sum == 3 * 40, "fixed: expected 3 blocked per run, got %lld total",
+          (long long)serial[0].fire_blocked.sum);
+    CHECK(serial[0].ammo_in_mag.min == 10 && serial[0].ammo_reserve.max == 36,
+          "fixed: final ammo should be 10/36, got %d/%d",
+          serial[0].ammo_in_mag.min, serial[0].ammo_reserve.max);
+
+    CHECK(serial[1].runs_completed == 57, "monte_carlo: expected 57 runs, got %u",
+          serial[1].runs_completed);
+    CHECK(serial[1].damage.min < serial[1].damage.max,
+          "monte_carlo: runs should vary (damage %d..%d)",
+          serial[1].damage.min, serial[1].damage.max);
+
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+        const batch_stats& a = serial[s];
+        const batch_stats& b = parallel[s];
+        bool same = a.runs_completed    == b.runs_completed
+                 && a.ticks_simulated   == b.ticks_simulated
+                 && a.damage.sum        == b.damage.sum
+                 && a.damage.min        == b.damage.min
+                 && a.damage.max        == b.damage.max
+                 && a.destroys.sum      == b.destroys.sum
+                 && a.fire_blocked.sum  == b.fire_blocked.sum
+                 && a.reloads_done.sum  == b.reloads_done.sum
+                 && a.ammo_in_mag.sum   == b.ammo_in_mag.sum
+                 && a.ammo_reserve.sum  == b.ammo_reserve.sum;
+        CHECK(same, "%s: 1-worker and 3-worker aggregates differ",
+              scenarios[s].name.c_str());
+    }
+
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: parallel tick determinism
+ * The same script stepped with 1..N sim worker threads must produce the
+ * same state hash every tick and byte-identical snapshots.
+ * min_parallel_items = 1 forces every phase through the job system.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static bool set_threading(ax_core* core, uint32_t workers, uint32_t min_items) {
+    ax_threading_params_v1 tp = {};
+    tp.version            = 1;
+    tp.size_bytes         = sizeof(tp);
+    tp.worker_count       = workers;
+    tp.min_parallel_items = min_items;
+    return ax_set_threading(core, &tp) == AX_OK;
+}
+
+/* one tick of the determinism script: movement and combat interleaved */
+static void parallel_script_tick(uint64_t t, std::vector<ax_action_v1>& acts) {
+    acts.clear();
+    ax_action_v1 a = {};
+    a.tick     = t;
+    a.actor_id = 1;
+
+    a.type = AX_ACT_MOVE_INTENT;
+    a.u.move.x = 0.25f * (float)(t % 5);
+    a.u.move.y = 1.0f - 0.1f * (float)(t % 7);
+    acts.push_back(a);
+
+    if (t % 3 == 0) {
+        a = {};  a.tick = t;  a.actor_id = 1;
+        a.type = AX_ACT_LOOK_INTENT;
+        a.u.look.yaw = 0.05f * (float)t;
+        acts.push_back(a);
+    }
+
+    a = {};  a.tick = t;  a.actor_id = 1;
+    a.type = (t == 15 || t == 40) ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+    acts.push_back(a);
+
+    a = {};  a.tick = t;  a.actor_id = 1;
+    a.type = AX_ACT_MOVE_INTENT;
+    a.u.move.x = -0.5f;
+    acts.push_back(a);
+
+    /* unknown actor: tick-time no-op */
+    a = {};  a.tick = t;  a.actor_id = 999;
+    a.type = AX_ACT_MOVE_INTENT;
+    a.u.move.x = 1.0f;
+    acts.push_back(a);
+}
+
+static void test_parallel_determinism(void) {
+    printf("test_parallel_determinism\n");
+
+    const uint32_t total_ticks = 60;
+    const uint32_t max_workers = 4;
+
+    /* per-worker-count: hash after every tick + final snapshot */
+    std::vector<std::vector<uint64_t>> hashes(max_workers + 1);
+    std::vector<std::vector<uint8_t>>  finals(max_workers + 1);
+
+    for (uint32_t workers = 1; workers <= max_workers; ++workers) {
+        ax_core* core = create_and_load("content/");
+        CHECK(core != nullptr, "workers=%u: core creation failed", workers);
+        if (!core) return;
+
+        CHECK(set_threading(core, workers, 1), "workers=%u: ax_set_threading failed", workers);
+
+        for (uint64_t t = 1; t <= total_ticks; ++t) {
+            std::vector<ax_action_v1> acts;
+            parallel_script_tick(t, acts);
+
+            ax_action_batch_v1 batch = {};
+            batch.version    = 1;
+            batch.size_bytes = sizeof(batch);
+            batch.count      = (uint32_t)acts.size();
+            batch.actions    = acts.data();
+            ax_result r = ax_submit_actions(core, &batch);
+            if (r == AX_OK) r = ax_step_ticks(core, 1);
+            if (r != AX_OK) {
+                CHECK(false, "workers=%u tick %llu: %s (%s)", workers,
+                      (unsigned long long)t, result_str(r), ax_get_last_error());
+                break;
+            }
+
+            uint64_t h = 0;
+            ax_get_state_hash(core, &h);
+            hashes[workers].push_back(h);
+        }
+
+        finals[workers] = take_snapshot(core);
+
+        ax_unload_content(core);
+        ax_destroy(core);
+    }
+
+    for (uint32_t workers = 2; workers <= max_workers; ++workers) {
+        uint32_t first_diff = 0;
+        for (uint32_t t = 0; t < total_ticks; ++t) {
+            if (hashes[workers][t] != hashes[1][t]) {
+                first_diff = t + 1;
+                break;
+            }
+        }
+        CHECK(first_diff == 0, "workers=%u: state hash diverges from 1 worker at tick %u",
+              workers, first_diff);
+        CHECK(finals[workers] == finals[1],
+              "workers=%u: final snapshot bytes differ from 1 worker", workers);
+    }
+
+    /* the state hash must actually track state */
+    CHECK(hashes[1][0] != hashes[1][1], "state hash should change between ticks");
+
+    /* threading params validation */
+    {
+        ax_core* core = create_and_load("content/");
+        CHECK(core != nullptr, "setup failed");
+        if (core) {
+            ax_threading_params_v1 tp = {};
+            tp.version      = 1;
+            tp.size_bytes   = sizeof(tp);
+            tp.worker_count = 1000;
+            CHECK_ERR(ax_set_threading(core, &tp), AX_ERR_INVALID_ARG);
+
+            tp.worker_count = 2;
+            tp.version      = 7;
+            CHECK_ERR(ax_set_threading(core, &tp), AX_ERR_UNSUPPORTED);
+
+            CHECK_ERR(ax_set_threading(core, nullptr), AX_ERR_INVALID_ARG);
+
+            uint64_t h = 0;
+            CHECK_ERR(ax_get_state_hash(core, nullptr), AX_ERR_INVALID_ARG);
+            CHECK_OK(ax_get_state_hash(core, &h));
+
+            ax_unload_content(core);
+            ax_destroy(core);
+        }
+    }
+
+#if AX_TEST_CAN_CAP_ADDRESS_SPACE
+    /*
+     * Worker threads that cannot start: with the address space capped at
+     * its current size no new thread stack can be mapped (a few may still
+     * come from the C library's stack cache). ax_set_threading reports it
+     * and the core keeps stepping, deterministically, on what did start.
+     */
+    {
+        ax_core* core = create_and_load("content/");
+        CHECK(core != nullptr, "setup failed");
+        if (core) {
+            /* warm-up: sizes the scratch and thread table, so the retry only starts threads */
+            CHECK(set_threading(core, 64, 1) && set_threading(core, 1, 1), "warm-up set_threading failed");
+
+            long pages = 0;
+            FILE* statm = fopen("/proc/self/statm", "r");
+            if (statm) {
+                if (fscanf(statm, "%ld", &pages) != 1) pages = 0;
+                fclose(statm);
+            }
+            CHECK(pages > 0, "could not read /proc/self/statm");
+
+            struct rlimit old_as;
+            getrlimit(RLIMIT_AS, &old_as);
+            struct rlimit cap = old_as;
+            cap.rlim_cur = (rlim_t)pages * (rlim_t)sysconf(_SC_PAGESIZE) + ((rlim_t)1 << 20);
+
+            ax_threading_params_v1 tp = {};
+            tp.version            = 1;
+            tp.size_bytes         = sizeof(tp);
+            tp.worker_count       = 64;
+            tp.min_parallel_items = 1;
+            ax_result r = AX_OK;
+            if (pages > 0 && setrlimit(RLIMIT_AS, &cap) == 0) {
+                r = ax_set_threading(core, &tp);
+                setrlimit(RLIMIT_AS, &old_as);
+            }
+            CHECK_ERR(r, AX_ERR_INTERNAL);
+            CHECK(strstr(ax_get_last_error(), "could not start worker threads") != nullptr,
+                  "last error: %s", ax_get_last_error());
+
+            /* every dispatch must still finish, with the 1-worker hashes */
+            for (uint64_t t = 1; t <= total_ticks; ++t) {
+                std::vector<ax_action_v1> acts;
+                parallel_script_tick(t, acts);
+
+                ax_action_batch_v1 batch = {};
+                batch.version    = 1;
+                batch.size_bytes = sizeof(batch);
+                batch.count      = (uint32_t)acts.size();
+                batch.actions    = acts.data();
+                r = ax_submit_actions(core, &batch);
+                if (r == AX_OK) r = ax_step_ticks(core, 1);
+                uint64_t h = 0;
+                ax_get_state_hash(core, &h);
+                if (r != AX_OK || t > hashes[1].size() || h != hashes[1][t - 1]) {
+                    CHECK(false, "after a failed ax_set_threading: tick %llu diverges (%s)",
+                          (unsigned long long)t, result_str(r));
+                    break;
+                }
+            }
+
+            /* and the core can still be re-threaded */
+            CHECK(set_threading(core, 4, 1), "ax_set_threading(4) after a failure: %s",
+                  ax_get_last_error());
+
+            ax_unload_content(core);
+            ax_destroy(core);
+        }
+    }
+#endif
+
+    printf("  done\n");
+}
+
 /* ══════════════════════════════════════════════════════════════════════
  * Main — run all tests
  * ══════════════════════════════════════════════════════════════════ */
 
-int main(void) {
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: asynchronous stepping
+ * An async step matches the synchronous one, and the core rejects
+ * everything but poll/wait/destroy while it is in flight.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_async_stepping(void) {
+    printf("test_async_stepping\n");
+
+    const uint32_t n_ticks = 500000;
+
+    ax_core* sync_core  = create_and_load("content/");
+    ax_core* async_core = create_and_load("content/");
+    CHECK(sync_core && async_core, "core creation failed");
+    if (!sync_core || !async_core) return;
+
+    /* same opening on both: fire, reload, fire */
+    ax_core* cores[2] = { sync_core, async_core };
+    for (ax_core* c : cores) {
+        ax_action_v1 a = {};
+        a.actor_id = 1;
+        a.tick = 1;  a.type = AX_ACT_FIRE_ONCE;  submit_action(c, a);
+        a.tick = 2;  a.type = AX_ACT_RELOAD;     submit_action(c, a);
+        a.tick = 40; a.type = AX_ACT_FIRE_ONCE;  submit_action(c, a);
+    }
+
+    CHECK_OK(ax_step_ticks(sync_core, n_ticks));
+    CHECK_OK(ax_step_ticks_async(async_core, n_ticks));
+
+    /* while in flight: poll works, everything else is rejected */
+    int32_t done = -1;
+    CHECK_OK(ax_step_poll(async_core, &done));
+    CHECK(done == 0 || done == 1, "poll should report 0/1, got %d", done);
+    if (done == 0) {
+        uint32_t need = 0;
+        CHECK_ERR(ax_get_snapshot_bytes(async_core, nullptr, 0, &need), AX_ERR_BAD_STATE);
+        CHECK(strstr(ax_get_last_error(), "in flight") != nullptr,
+              "busy error should mention in-flight step, got '%s'", ax_get_last_error());
+        CHECK_ERR(ax_step_ticks(async_core, 1), AX_ERR_BAD_STATE);
+        CHECK_ERR(ax_step_ticks_async(async_core, 1), AX_ERR_BAD_STATE);
+        CHECK(ax_get_core_last_error(async_core)[0] == '\0',
+              "core error should read empty while in flight");
+    }
+
+    CHECK_OK(ax_step_wait(async_core));
+    CHECK_OK(ax_step_poll(async_core, &done));
+    CHECK(done == 1, "poll should report done after wait, got %d", done);
+
+    /* identical to the synchronous step */
+    uint64_t h_sync = 0, h_async = 0;
+    CHECK_OK(ax_get_state_hash(sync_core, &h_sync));
+    CHECK_OK(ax_get_state_hash(async_core, &h_async));
+    CHECK(h_sync == h_async, "state hash differs: sync %016llx async %016llx",
+          (unsigned long long)h_sync, (unsigned long long)h_async);
+
+    auto snap = take_snapshot(async_core);
+    parsed_snapshot ps = parse_snapshot(snap.data(), (uint32_t)snap.size());
+    CHECK(ps.header && ps.header->tick == n_ticks, "tick should be %u after wait", n_ticks);
+
+    /* wait with nothing in flight is a no-op */
+    CHECK_OK(ax_step_wait(async_core));
+
+    /* lifecycle errors are synchronous; nothing is left in flight */
+    CHECK_OK(ax_unload_content(async_core));
+    CHECK_ERR(ax_step_ticks_async(async_core, 1), AX_ERR_BAD_STATE);
+    CHECK_OK(ax_step_poll(async_core, &done));
+    CHECK(done == 1, "failed async start should leave nothing in flight");
+
+    ax_core* tail_core = create_and_load("content/");
+    CHECK(tail_core != nullptr, "core creation failed");
+    if (tail_core) {
+        /* destroy with a step in flight waits for it */
+        CHECK_OK(ax_step_ticks_async(tail_core, 100000));
+        ax_destroy(tail_core);
+    }
+
+    /* NULL args */
+    CHECK_ERR(ax_step_ticks_async(nullptr, 1), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_step_poll(async_core, nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_step_wait(nullptr), AX_ERR_INVALID_ARG);
+
+    ax_unload_content(sync_core);
+    ax_destroy(sync_core);
+    ax_destroy(async_core);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: action inbox
+ * Inbox submissions follow the ax_submit_actions validation rules, are
+ * applied in submission order after synchronous ones, and can be fed
+ * from an input thread while the owner steps.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static ax_result inbox_submit(ax_core* core, const ax_action_v1* actions, uint32_t count) {
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = count;
+    batch.actions    = actions;
+    return ax_inbox_submit_actions(core, &batch);
+}
+
+static void test_action_inbox(void) {
+    printf("test_action_inbox\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    ax_action_v1 look = {};
+    look.actor_id    = 1;
+    look.type        = AX_ACT_LOOK_INTENT;
+    look.u.look.yaw  = 1.0f;
+
+    /* not enabled yet */
+    CHECK_ERR(inbox_submit(core, &look, 1), AX_ERR_BAD_STATE);
+
+    ax_inbox_params_v1 ip = {};
+    ip.version    = 2;
+    ip.size_bytes = sizeof(ip);
+    CHECK_ERR(ax_enable_action_inbox(core, &ip), AX_ERR_UNSUPPORTED);
+    ip.version    = 1;
+    ip.capacity   = 5;   /* rounds up to 8 */
+    CHECK_OK(ax_enable_action_inbox(core, &ip));
+
+    /* structural validation on the producer; core error untouched */
+    ax_action_v1 bad = look;
+    bad.u.look.yaw = NAN;
+    CHECK_ERR(inbox_submit(core, &bad, 1), AX_ERR_INVALID_ARG);
+    CHECK(strstr(ax_get_last_error(), "non-finite") != nullptr,
+          "inbox error should name the bad field, got '%s'", ax_get_last_error());
+    CHECK(ax_get_core_last_error(core)[0] == '\0', "inbox errors must not touch the core");
+
+    /* whole batch or nothing */
+    ax_action_v1 many[9];
+    for (auto& a : many) a = look;
+    CHECK_ERR(inbox_submit(core, many, 9), AX_ERR_QUEUE_FULL);
+    CHECK_OK(inbox_submit(core, many, 8));
+    CHECK_ERR(inbox_submit(core, &look, 1), AX_ERR_QUEUE_FULL);
+
+    /* tick 0 = the tick that drains it: all 8 applied on tick 1 */
+    CHECK_OK(ax_step_ticks(core, 1));
+    auto snap = take_snapshot(core);
+    parsed_snapshot ps = parse_snapshot(snap.data(), (uint32_t)snap.size());
+    CHECK(ps.header && ps.entities[0].ry == 8.0f, "8 looks should apply on tick 1");
+
+    /* ordering: sync submissions first, then the inbox in order */
+    ax_core* ref = create_and_load("content/");
+    ax_core* rev = create_and_load("content/");
+    CHECK(ref && rev, "core creation failed");
+    if (!ref || !rev) { ax_destroy(core); ax_destroy(ref); ax_destroy(rev); return; }
+    ax_action_v1 look8 = look;
+    look8.tick       = 1;
+    look8.u.look.yaw = 8.0f;   /* match core's tick 1 */
+    submit_action(ref, look8);
+    submit_action(rev, look8);
+    CHECK_OK(ax_step_ticks(ref, 1));
+    CHECK_OK(ax_step_ticks(rev, 1));
+
+    ax_action_v1 fire = {};
+    fire.tick = 2;  fire.actor_id = 1;  fire.type = AX_ACT_FIRE_ONCE;
+    ax_action_v1 reload = fire;
+    reload.type = AX_ACT_RELOAD;
+    ax_action_v1 inbox_acts[2] = { fire, reload };
+    inbox_acts[0].tick = 0;
+
+    CHECK_OK(inbox_submit(core, inbox_acts, 2));   /* FIRE (tick 0), RELOAD */
+    submit_action(core, fire);
+
+    submit_action(ref, fire);
+    submit_action(ref, fire);
+    submit_action(ref, reload);
+
+    submit_action(rev, fire);
+    submit_action(rev, reload);
+    submit_action(rev, fire);
+
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_step_ticks(ref, 1));
+    CHECK_OK(ax_step_ticks(rev, 1));
+
+    auto s_core = take_snapshot(core);
+    auto s_ref  = take_snapshot(ref);
+    auto s_rev  = take_snapshot(rev);
+    CHECK(s_core == s_ref, "inbox actions should apply after sync ones, in submission order");
+    CHECK(s_ref != s_rev, "order check is not order-sensitive");
+
+    ax_destroy(rev);
+
+    /* unload discards undrained actions */
+    CHECK_OK(inbox_submit(core, &look, 1));
+    CHECK_OK(ax_unload_content(core));
+    ax_content_load_params_v1 content = {};
+    content.version    = 1;
+    content.size_bytes = sizeof(content);
+    content.root_path  = "content/";
+    CHECK_OK(ax_load_content(core, &content));
+    CHECK_OK(ax_step_ticks(core, 1));
+    snap = take_snapshot(core);
+    ps = parse_snapshot(snap.data(), (uint32_t)snap.size());
+    CHECK(ps.header && ps.entities[0].ry == 0.0f, "unload should discard the inbox");
+
+    ax_unload_content(ref);
+    ax_destroy(ref);
+    ax_unload_content(core);
+    ax_destroy(core);
+
+    /* input thread feeding a stepping core, every action applied in order */
+    inbox_bench_params bp;
+    bp.content_path = "content/";
+    bp.actions      = 2000;
+    bp.interval_us  = 0;
+    bp.tick_hz      = 0;
+    inbox_bench_result br;
+    CHECK(inbox_bench_run(bp, &br), "inbox bench: %u / %u applied", br.applied, bp.actions);
+
+    CHECK_ERR(ax_enable_action_inbox(nullptr, &ip), AX_ERR_INVALID_ARG);
+    CHECK_ERR(inbox_submit(nullptr, &look, 1), AX_ERR_INVALID_ARG);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: timer service
+ * Reload completion runs on the timing wheel: exact due tick across
+ * wheel cascade boundaries, save 1.1 carries timers, 1.0 saves still
+ * load, and inconsistent timer records are rejected.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* SAVE_FORMAT.md offsets (packed, little-endian) */
+static const uint32_t SAVE_HEADER_SIZE     = 24;
+static const uint32_t SAVE_WORLD_V1_0_SIZE = 64;
+static const uint32_t SAVE_TARGET_SIZE     = 40;
+
+static uint32_t read_u32(const std::vector<uint8_t>& b, uint32_t off) {
+    uint32_t v;
+    memcpy(&v, b.data() + off, 4);
+    return v;
+}
+
+static void write_u32(std::vector<uint8_t>& b, uint32_t off, uint32_t v) {
+    memcpy(b.data() + off, &v, 4);
+}
+
+static void reseal_save(std::vector<uint8_t>& b) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < (uint32_t)b.size(); ++i) {
+        if (i >= 20 && i < 24) continue;   /* checksum32 */
+        sum += b[i];
+    }
+    write_u32(b, 20, sum);
+}
+
+/* Rewrites a 1.1 save as the 1.0 layout (no world extension, no timers). */
+static std::vector<uint8_t> downgrade_save_to_v1_0(const std::vector<uint8_t>& v11) {
+    uint32_t target_count = read_u32(v11, SAVE_HEADER_SIZE + 56);
+    uint32_t targets_at   = read_u32(v11, SAVE_HEADER_SIZE + 60);
+
+    std::vector<uint8_t> out(v11.begin(), v11.begin() + SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE);
+    out.insert(out.end(), v11.begin() + targets_at,
+               v11.begin() + targets_at + target_count * SAVE_TARGET_SIZE);
+
+    uint16_t minor = 0;
+    memcpy(out.data() + 6, &minor, 2);
+    write_u32(out, 8, (uint32_t)out.size());
+    write_u32(out, 16, SAVE_WORLD_V1_0_SIZE);
+    write_u32(out, SAVE_HEADER_SIZE + 60, SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE);
+    reseal_save(out);
+    return out;
+}
+
+static bool has_event(ax_core* core, uint32_t type) {
+    auto buf = take_snapshot(core);
+    parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+    for (uint32_t i = 0; snap.header && i < snap.header->event_count; ++i) {
+        if (snap.events[i].type == type) return true;
+    }
+    return false;
+}
+
+/* steps to `tick` (inclusive) */
+static void step_to(ax_core* core, uint64_t* tick, uint64_t target) {
+    if (target > *tick) {
+        ax_step_ticks(core, (uint32_t)(target - *tick));
+        *tick = target;
+    }
+}
+
+static void test_timer_service(void) {
+    printf("test_timer_service\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    /* reloads straddling level 1/2/3 cascade boundaries (256, 512, 2^16, 2^24) */
+    const uint64_t starts[] = { 10, 240, 500, 65530, 131060, 16777200 };
+    uint64_t tick = 0;
+    bool exact = true;
+    for (uint64_t start : starts) {
+        ax_action_v1 a = {};
+        a.actor_id = 1;
+        a.tick = start - 1;  a.type = AX_ACT_FIRE_ONCE;  submit_action(core, a);
+        a.tick = start;      a.type = AX_ACT_RELOAD;     submit_action(core, a);
+
+        step_to(core, &tick, start + 28);
+        bool early = has_event(core, AX_EVT_RELOAD_DONE);
+        step_to(core, &tick, start + 29);
+        bool done  = has_event(core, AX_EVT_RELOAD_DONE);
+        if (early || !done) {
+            CHECK(false, "reload started at %llu should complete at exactly +29",
+                  (unsigned long long)start);
+            exact = false;
+        }
+    }
+    CHECK(exact, "reload completion tick drifted across cascades");
+    ax_destroy(core);
+
+    /* mid-reload save: 1.1 with timers, 1.0 downgrade, both continue identically */
+    ax_core* ref = create_and_load("content/");
+    CHECK(ref != nullptr, "core creation failed");
+    if (!ref) return;
+
+    ax_action_v1 a = {};
+    a.actor_id = 1;
+    a.tick = 1;  a.type = AX_ACT_FIRE_ONCE;  submit_action(ref, a);
+    a.tick = 2;  a.type = AX_ACT_RELOAD;     submit_action(ref, a);
+    CHECK_OK(ax_step_ticks(ref, 10));
+
+    auto save = take_save(ref);
+    CHECK(save.size() > SAVE_HEADER_SIZE, "save failed");
+    if (save.size() <= SAVE_HEADER_SIZE) { ax_destroy(ref); return; }
+
+    uint16_t minor = 0;
+    memcpy(&minor, save.data() + 6, 2);
+    CHECK(minor >= 1, "saves should carry timers (1.1+), got 1.%u", minor);
+    uint32_t timer_count = read_u32(save, SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE + 8);
+    uint32_t timers_at   = read_u32(save, SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE + 12);
+    CHECK(timer_count == 1, "mid-reload save should hold 1 timer, got %u", timer_count);
+
+    auto v10 = downgrade_save_to_v1_0(save);
+
+    ax_core* from11 = create_and_load("content/");
+    ax_core* from10 = create_and_load("content/");
+    CHECK(from11 && from10, "core creation failed");
+    if (from11 && from10) {
+        CHECK_OK(ax_load_save_bytes(from11, save.data(), (uint32_t)save.size()));
+        CHECK_OK(ax_load_save_bytes(from10, v10.data(), (uint32_t)v10.size()));
+
+        uint64_t ref_tick = 10, t11 = 10, t10 = 10;
+        step_to(ref,    &ref_tick, 30);
+        step_to(from11, &t11, 30);
+        step_to(from10, &t10, 30);
+        CHECK(!has_event(ref, AX_EVT_RELOAD_DONE) && !has_event(from11, AX_EVT_RELOAD_DONE) &&
+              !has_event(from10, AX_EVT_RELOAD_DONE), "reload should not complete before tick 31");
+
+        step_to(ref,    &ref_tick, 31);
+        step_to(from11, &t11, 31);
+        step_to(from10, &t10, 31);
+        CHECK(has_event(ref, AX_EVT_RELOAD_DONE), "uninterrupted reload should complete at 31");
+        CHECK(has_event(from11, AX_EVT_RELOAD_DONE), "1.1 load: reload should complete at 31");
+        CHECK(has_event(from10, AX_EVT_RELOAD_DONE), "1.0 load: reload should complete at 31");
+
+        uint64_t h_ref = 0, h_11 = 1;
+        ax_get_state_hash(ref, &h_ref);
+        ax_get_state_hash(from11, &h_11);
+        CHECK(h_ref == h_11, "1.1 load should continue bit-identically");
+    }
+    if (from11) ax_destroy(from11);
+    if (from10) ax_destroy(from10);
+
+    /* a timer that disagrees with the weapon is rejected, core untouched */
+    if (timer_count == 1) {
+        std::vector<uint8_t> bad = save;
+        uint64_t due = 0;
+        memcpy(&due, bad.data() + timers_at, 8);
+        due += 1;
+        memcpy(bad.data() + timers_at, &due, 8);
+        reseal_save(bad);
+
+        ax_core* c = create_and_load("content/");
+        CHECK(c != nullptr, "core creation failed");
+        if (c) {
+            CHECK_ERR(ax_load_save_bytes(c, bad.data(), (uint32_t)bad.size()), AX_ERR_INVALID_ARG);
+            CHECK(strstr(ax_get_last_error(), "timer") != nullptr,
+                  "error should mention the timer, got '%s'", ax_get_last_error());
+            ax_destroy(c);
+        }
+    }
+
+    /* a timer count whose array end wraps 32 bits is rejected, not read */
+    {
+        std::vector<uint8_t> bad = save;
+        uint64_t wrap_count = ((1ull << 32) - timers_at + 31) / 32;   /* 32-byte records */
+        write_u32(bad, SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE + 8, (uint32_t)wrap_count);
+        reseal_save(bad);
+
+        ax_core* c = create_and_load("content/");
+        CHECK(c != nullptr, "core creation failed");
+        if (c) {
+            CHECK_ERR(ax_load_save_bytes(c, bad.data(), (uint32_t)bad.size()), AX_ERR_INVALID_ARG);
+            CHECK(strstr(ax_get_last_error(), "timer array") != nullptr,
+                  "error should mention the timer array, got '%s'", ax_get_last_error());
+            ax_destroy(c);
+        }
+    }
+
+    ax_destroy(ref);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: zero-allocation steady state
+ * Once a world is warmed up, stepping (with actions, events, reloads),
+ * snapshotting, hashing and save/load must not touch the heap.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_zero_alloc_steady_state(void) {
+    printf("test_zero_alloc_steady_state\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    /* one cycle = 40 ticks: moves/looks every tick, 12 shots, a reload */
+    const uint32_t cycle = 40;
+    ax_action_v1 acts[3];
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.actions    = acts;
+
+    std::vector<uint8_t> snap(64 * 1024);
+    std::vector<uint8_t> save(64 * 1024);
+    uint64_t tick = 0;
+    bool ok = true;
+
+    auto run_cycles = [&](uint32_t n_cycles) {
+        for (uint32_t c = 0; c < n_cycles; ++c) {
+            for (uint32_t k = 0; k < cycle; ++k) {
+                ++tick;
+                uint32_t n = 0;
+                acts[n] = {};  acts[n].tick = tick;  acts[n].actor_id = 1;
+                acts[n].type = AX_ACT_MOVE_INTENT;  acts[n].u.move.x = 0.5f;  ++n;
+                acts[n] = {};  acts[n].tick = tick;  acts[n].actor_id = 1;
+                acts[n].type = AX_ACT_LOOK_INTENT;  acts[n].u.look.yaw = 0.01f;  ++n;
+                if (k < 13 || k == 14) {
+                    acts[n] = {};  acts[n].tick = tick;  acts[n].actor_id = 1;
+                    acts[n].type = k == 14 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;  ++n;
+                }
+                batch.count = n;
+
+                uint32_t size = 0;
+                uint64_t hash = 0;
+                ok &= ax_submit_actions(core, &batch) == AX_OK;
+                ok &= ax_step_ticks(core, 1) == AX_OK;
+                ok &= ax_get_snapshot_bytes(core, snap.data(), (uint32_t)snap.size(), &size) == AX_OK;
+                ok &= ax_get_state_hash(core, &hash) == AX_OK;
+            }
+
+            uint32_t size = 0;
+            ok &= ax_save_bytes(core, save.data(), (uint32_t)save.size(), &size) == AX_OK;
+            ok &= ax_load_save_bytes(core, save.data(), size) == AX_OK;
+        }
+    };
+
+    run_cycles(4);   /* warm-up: arena, queues and timer pool reach steady size */
+
+    uint64_t before = alloc_hook_count();
+    run_cycles(8);
+    uint64_t allocs = alloc_hook_count() - before;
+
+    CHECK(ok, "steady-state calls should succeed (%s)", ax_get_last_error());
+    CHECK(allocs == 0, "steady state should not allocate, saw %llu allocations",
+          (unsigned long long)allocs);
+
+    ax_destroy(core);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: host allocator
+ * With ax_create_params_v1.allocator set, every core allocation goes
+ * through the host callbacks: nothing reaches global new while the
+ * world runs, and everything is handed back by ax_destroy. When the
+ * host runs out, calls return AX_ERR_OUT_OF_MEMORY and change nothing.
+ * ══════════════════════════════════════════════════════════════════ */
+
+struct tracking_allocator {
+    uint64_t allocs;
+    uint64_t frees;
+    int64_t  live_bytes;
+    int64_t  peak_bytes;
+    bool     misaligned;
+    bool     limited;       /* allocations past `budget` return NULL */
+    uint64_t budget;
+};
+
+static void* tracking_alloc(void* user, size_t size, size_t align) {
+    tracking_allocator* t = (tracking_allocator*)user;
+    if (t->limited) {
+        if (t->budget == 0) return nullptr;
+        t->budget--;
+    }
+    /* over-allocate, align by hand and stash the malloc pointer in front */
+    void* p = malloc(size + align + sizeof(void*));
+    if (!p) return nullptr;
+    uintptr_t aligned = ((uintptr_t)p + sizeof(void*) + align - 1) & ~(uintptr_t)(align - 1);
+    ((void**)aligned)[-1] = p;
+    t->allocs++;
+    t->live_bytes += (int64_t)size;
+    if (t->live_bytes > t->peak_bytes) t->peak_bytes = t->live_bytes;
+    return (void*)aligned;
+}
+
+static void tracking_free(void* user, void* ptr, size_t size, size_t align) {
+    tracking_allocator* t = (tracking_allocator*)user;
+    if (((uintptr_t)ptr & (align - 1)) != 0) t->misaligned = true;
+    t->frees++;
+    t->live_bytes -= (int64_t)size;
+    free(((void**)ptr)[-1]);
+}
+
+static void test_host_allocator(void) {
+    printf("test_host_allocator\n");
+
+    tracking_allocator track = {};
+    ax_allocator_v1 host = {};
+    host.version    = 1;
+    host.size_bytes = sizeof(host);
+    host.alloc      = tracking_alloc;
+    host.realloc    = nullptr;      /* core falls back to alloc + copy + free */
+    host.free       = tracking_free;
+    host.user       = &track;
+
+    ax_create_params_v1 params = {};
+    params.version    = 1;
+    params.size_bytes = sizeof(params);
+    params.abi_major  = AX_ABI_MAJOR;
+    params.abi_minor  = AX_ABI_MINOR;
+    params.allocator  = &host;
+
+    ax_core* core = nullptr;
+    CHECK_OK(ax_create(&params, &core));
+    if (!core) return;
+    CHECK(track.allocs > 0, "core storage should come from the host allocator");
+
+    ax_content_load_params_v1 content = {};
+    content.version    = 1;
+    content.size_bytes = sizeof(content);
+    content.root_path  = "content/";
+    CHECK_OK(ax_load_content(core, &content));
+
+    ax_inbox_params_v1 inbox = {};
+    inbox.version    = 1;
+    inbox.size_bytes = sizeof(inbox);
+    inbox.capacity   = 64;
+
+    /* same script on a default-allocator core: results must match */
+    ax_core* ref = create_and_load("content/");
+    CHECK(ref != nullptr, "reference core creation failed");
+    if (!ref) { ax_destroy(core); return; }
+
+    std::vector<uint8_t> snap(64 * 1024);
+    std::vector<uint8_t> save(64 * 1024);
+    bool ok = true;
+
+    uint64_t before = alloc_hook_count();
+    ok &= ax_enable_action_inbox(core, &inbox) == AX_OK;
+    for (uint64_t tick = 1; tick <= 60; ++tick) {
+        ax_action_v1 acts[2] = {};
+        acts[0].tick = tick;  acts[0].actor_id = 1;
+        acts[0].type = AX_ACT_MOVE_INTENT;  acts[0].u.move.x = 0.25f;
+        acts[1].tick = tick;  acts[1].actor_id = 1;
+        acts[1].type = tick == 20 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = 2;
+        batch.actions    = acts;
+        ok &= ax_submit_actions(core, &batch) == AX_OK;
+        ok &= ax_step_ticks(core, 1) == AX_OK;
+
+        uint32_t size = 0;
+        ok &= ax_get_snapshot_bytes(core, snap.data(), (uint32_t)snap.size(), &size) == AX_OK;
+        if (tick % 20 == 0) {
+            ok &= ax_save_bytes(core, save.data(), (uint32_t)save.size(), &size) == AX_OK;
+            ok &= ax_load_save_bytes(core, save.data(), size) == AX_OK;
+        }
+    }
+    uint64_t global = alloc_hook_count() - before;
+
+    CHECK(ok, "calls on a host-allocator core should succeed (%s)", ax_get_last_error());
+    CHECK(global == 0, "core should not use global new, saw %llu allocations",
+          (unsigned long long)global);
+
+    for (uint64_t tick = 1; tick <= 60; ++tick) {
+        ax_action_v1 acts[2] = {};
+        acts[0].tick = tick;  acts[0].actor_id = 1;
+        acts[0].type = AX_ACT_MOVE_INTENT;  acts[0].u.move.x = 0.25f;
+        acts[1].tick = tick;  acts[1].actor_id = 1;
+        acts[1].type = tick == 20 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = 2;
+        batch.actions    = acts;
+        ax_submit_actions(ref, &batch);
+        ax_step_ticks(ref, 1);
+    }
+    uint64_t hash = 0, ref_hash = 0;
+    CHECK_OK(ax_get_state_hash(core, &hash));
+    CHECK_OK(ax_get_state_hash(ref, &ref_hash));
+    CHECK(hash == ref_hash, "allocator must not change the simulation");
+    ax_destroy(ref);
+
+    CHECK(track.peak_bytes > 0, "peak should be recorded");
+    ax_destroy(core);
+    CHECK(track.live_bytes == 0, "ax_destroy should free everything, %lld bytes live",
+          (long long)track.live_bytes);
+    CHECK(track.allocs == track.frees, "allocs %llu != frees %llu",
+          (unsigned long long)track.allocs, (unsigned long long)track.frees);
+    CHECK(!track.misaligned, "blocks should honour the requested alignment");
+
+    /* a pre-0.6 shell: struct ends before `allocator` */
+    {
+        ax_create_params_v1 old = params;
+        old.size_bytes = (uint32_t)offsetof(ax_create_params_v1, allocator);
+        old.allocator  = &host;     /* beyond size_bytes: must be ignored */
+        uint64_t allocs = track.allocs;
+        ax_core* c = nullptr;
+        CHECK_OK(ax_create(&old, &c));
+        CHECK(track.allocs == allocs, "allocator past size_bytes should be ignored");
+        ax_destroy(c);
+    }
+
+    /* malformed allocator structs */
+    {
+        ax_allocator_v1 bad = host;
+        bad.version = 2;
+        params.allocator = &bad;
+        ax_core* c = nullptr;
+        CHECK_ERR(ax_create(&params, &c), AX_ERR_UNSUPPORTED);
+
+        bad = host;
+        bad.free = nullptr;
+        CHECK_ERR(ax_create(&params, &c), AX_ERR_INVALID_ARG);
+
+        bad = host;
+        bad.size_bytes = 8;
+        CHECK_ERR(ax_create(&params, &c), AX_ERR_INVALID_ARG);
+        CHECK(c == nullptr, "no core on failure");
+    }
+
+    /* a host that runs out: every failure is reported and changes nothing */
+    {
+        tracking_allocator lim = {};
+        ax_allocator_v1 limited = host;
+        limited.user = &lim;
+        params.allocator = &limited;
+
+        ax_core* c = nullptr;
+        for (uint64_t budget = 0; budget < 64; ++budget) {
+            lim.limited = true;
+            lim.budget  = budget;
+            ax_result r = ax_create(&params, &c);
+            lim.limited = false;
+            if (r == AX_OK) break;
+            CHECK(r == AX_ERR_OUT_OF_MEMORY && c == nullptr,
+                  "ax_create with %llu allocations: %s", (unsigned long long)budget, result_str(r));
+            CHECK(lim.live_bytes == 0, "a failed ax_create should free what it took");
+        }
+        CHECK(c != nullptr, "ax_create should succeed once memory is there");
+        if (!c) return;
+
+        /*
+         * Runs `call` with 0, 1, 2, ... allocations allowed until it
+         * succeeds; returns how many times it failed. Every failure must
+         * be AX_ERR_OUT_OF_MEMORY and leave `core`'s state hash as it was.
+         */
+        auto until_ok = [&](ax_core* core, const char* what, auto call) {
+            uint64_t before = 0, after = 0;
+            ax_get_state_hash(core, &before);
+            for (uint64_t budget = 0; budget < 64; ++budget) {
+                lim.limited = true;
+                lim.budget  = budget;
+                ax_result r = call();
+                lim.limited = false;
+                if (r == AX_OK) return budget;
+
+                bool reported = std::strstr(ax_get_last_error(), "allocation failed") != nullptr;
+                ax_get_state_hash(core, &after);
+                CHECK(r == AX_ERR_OUT_OF_MEMORY && reported, "%s with %llu allocations: %s (%s)",
+                      what, (unsigned long long)budget, result_str(r), ax_get_last_error());
+                CHECK(after == before, "%s failing with %llu allocations changed the core",
+                      what, (unsigned long long)budget);
+                if (r != AX_ERR_OUT_OF_MEMORY || after != before) break;
+            }
+            CHECK(false, "%s should succeed once memory is there", what);
+            return (uint64_t)0;
+        };
+
+        CHECK(until_ok(c, "ax_load_content", [&] { return ax_load_content(c, &content); }) > 0,
+              "content load should need memory");
+        ax_core* ref = create_and_load("content/");
+        CHECK(ref != nullptr, "reference core creation failed");
+        if (!ref) { ax_destroy(c); return; }
+
+        /* a tick too big for the queue and frame arena: moves, shots and a reload */
+        std::vector<ax_action_v1> acts(4000);
+        auto big_tick = [&](uint64_t tick, uint32_t count) {
+            for (uint32_t i = 0; i < count; ++i) {
+                acts[i] = {};
+                acts[i].tick     = tick;
+                acts[i].actor_id = 1;
+                if (i == count - 1) {
+                    acts[i].type = AX_ACT_RELOAD;
+                } else if (i % 4 == 0) {
+                    acts[i].type = AX_ACT_FIRE_ONCE;
+                } else {
+                    acts[i].type = AX_ACT_MOVE_INTENT;
+                    acts[i].u.move.x = 0.01f;
+                }
+            }
+            ax_action_batch_v1 b = {};
+            b.version    = 1;
+            b.size_bytes = sizeof(b);
+            b.count      = count;
+            b.actions    = acts.data();
+            return b;
+        };
+
+        ax_action_batch_v1 batch = big_tick(1, 1000);
+        CHECK(until_ok(c, "ax_submit_actions", [&] { return ax_submit_actions(c, &batch); }) > 0,
+              "a big batch should need memory");
+        CHECK(until_ok(c, "ax_step_ticks", [&] { return ax_step_ticks(c, 1); }) > 0,
+              "a big tick should need memory");
+        CHECK_OK(ax_submit_actions(ref, &batch));
+        CHECK_OK(ax_step_ticks(ref, 1));
+
+        /* the async step reports through ax_step_wait */
+        batch = big_tick(2, 4000);
+        CHECK_OK(ax_submit_actions(c, &batch));
+        CHECK_OK(ax_submit_actions(ref, &batch));
+        uint64_t before = 0, after = 0;
+        CHECK_OK(ax_get_state_hash(c, &before));
+        lim.limited = true;
+        lim.budget  = 0;
+        CHECK_OK(ax_step_ticks_async(c, 1));
+        CHECK_ERR(ax_step_wait(c), AX_ERR_OUT_OF_MEMORY);
+        CHECK(std::strstr(ax_get_last_error(), "allocation failed") != nullptr,
+              "ax_step_wait should carry the step's error, got '%s'", ax_get_last_error());
+        lim.limited = false;
+        CHECK_OK(ax_get_state_hash(c, &after));
+        CHECK(after == before, "a failed async step should change nothing");
+        CHECK_OK(ax_step_ticks_async(c, 1));
+        CHECK_OK(ax_step_wait(c));
+        CHECK_OK(ax_step_ticks(ref, 1));
+
+        /* between ticks: threading, spawning, arming, despawning */
+        ax_threading_params_v1 threading = {};
+        threading.version      = 1;
+        threading.size_bytes   = sizeof(threading);
+        threading.worker_count = 4;
+        until_ok(c, "ax_set_threading", [&] { return ax_set_threading(c, &threading); });
+        CHECK_OK(ax_set_threading(ref, &threading));
+
+        ax_population_params_v1 pop;
+        worldgen_default_params(&pop);
+        pop.count = 500;
+        uint32_t first = 0;
+        CHECK(until_ok(c, "ax_spawn_population",
+                       [&] { return ax_spawn_population(c, &pop, &first); }) > 0,
+              "a population should need memory");
+        CHECK_OK(ax_spawn_population(ref, &pop, nullptr));
+
+        ax_debug_weapon_params_v1 arm = {};
+        arm.version      = 1;
+        arm.size_bytes   = sizeof(arm);
+        arm.entity_id    = first + 499;
+        arm.weapon_id    = 1000;
+        arm.ammo_in_mag  = 12;
+        arm.ammo_reserve = 24;
+        CHECK(until_ok(c, "ax_debug_give_weapon", [&] { return ax_debug_give_weapon(c, &arm); }) > 0,
+              "arming a new actor should need memory");
+        CHECK_OK(ax_debug_give_weapon(ref, &arm));
+
+        until_ok(c, "ax_debug_despawn_entity", [&] { return ax_debug_despawn_entity(c, first); });
+        CHECK_OK(ax_debug_despawn_entity(ref, first));
+
+        ax_debug_spawn_params_v1 spawn = {};
+        spawn.version    = 1;
+        spawn.size_bytes = sizeof(spawn);
+        spawn.hp         = 30;
+        uint32_t id = 0;
+        until_ok(c, "ax_debug_spawn_target", [&] { return ax_debug_spawn_target(c, &spawn, &id); });
+        CHECK_OK(ax_debug_spawn_target(ref, &spawn, &id));
+
+        CHECK_OK(ax_step_ticks(c, 3));
+        CHECK_OK(ax_step_ticks(ref, 3));
+        uint64_t hash = 0, ref_hash = 0;
+        CHECK_OK(ax_get_state_hash(c, &hash));
+        CHECK_OK(ax_get_state_hash(ref, &ref_hash));
+        CHECK(hash == ref_hash, "failed calls should leave no trace in the simulation");
+
+        /* a second core loads the save (its reload timer pending) */
+        std::vector<uint8_t> save(512 * 1024);
+        uint32_t size = 0;
+        CHECK_OK(ax_save_bytes(c, save.data(), (uint32_t)save.size(), &size));
+
+        ax_core* c2 = nullptr;
+        CHECK_OK(ax_create(&params, &c2));
+        CHECK_OK(ax_load_content(c2, &content));
+        CHECK(until_ok(c2, "ax_load_save_bytes",
+                       [&] { return ax_load_save_bytes(c2, save.data(), size); }) > 0,
+              "loading a bigger world should need memory");
+
+        /* exporting its timers for the first time */
+        uint64_t loaded = 0;
+        lim.limited = true;
+        lim.budget  = 0;
+        CHECK_ERR(ax_get_state_hash(c2, &loaded), AX_ERR_OUT_OF_MEMORY);
+        CHECK_ERR(ax_save_bytes(c2, save.data(), (uint32_t)save.size(), &size), AX_ERR_OUT_OF_MEMORY);
+        lim.limited = false;
+        CHECK_OK(ax_get_state_hash(c2, &loaded));
+        CHECK(loaded == hash, "the loaded world should match the saved one");
+
+        ax_destroy(ref);
+        ax_destroy(c2);
+        ax_destroy(c);
+        CHECK(lim.live_bytes == 0, "failed calls should not leak, %lld bytes live",
+              (long long)lim.live_bytes);
+        CHECK(lim.allocs == lim.frees, "allocs %llu != frees %llu",
+              (unsigned long long)lim.allocs, (unsigned long long)lim.frees);
+    }
+
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: memory statistics
+ * ax_get_memory_stats accounts for every byte held from the core's
+ * allocator, tracks per-subsystem high-water marks, and can be polled
+ * every frame without allocating.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static uint64_t reserved_sum(const ax_memory_stats_v1& m) {
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < m.subsystem_count; ++i) {
+        sum += m.subsystems[i].reserved_bytes;
+    }
+    return sum;
+}
+
+static void test_memory_stats(void) {
+    printf("test_memory_stats\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    ax_memory_stats_v1 m = {};
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.version == 1 && m.size_bytes == sizeof(m), "stats header should be filled");
+    CHECK(m.subsystem_count == AX_MEM_SUBSYSTEM_COUNT, "subsystem_count = %u", m.subsystem_count);
+    CHECK(m.subsystems[AX_MEM_CORE].reserved_bytes > 0, "core object should be counted");
+    CHECK(m.subsystems[AX_MEM_ENTITIES].used_bytes > 0, "loaded entities should be counted");
+    CHECK(m.subsystems[AX_MEM_INBOX].reserved_bytes == 0, "no inbox yet");
+    CHECK(m.total.reserved_bytes == reserved_sum(m),
+          "subsystems should account for every byte (%llu vs %llu)",
+          (unsigned long long)m.total.reserved_bytes, (unsigned long long)reserved_sum(m));
+    CHECK(m.allocation_count > 0, "allocation_count should count ax_create");
+
+    for (uint32_t i = 0; i < m.subsystem_count; ++i) {
+        CHECK(m.subsystems[i].used_bytes <= m.subsystems[i].reserved_bytes,
+              "subsystem %u: used > reserved", i);
+    }
+
+    /* queue 40 future actions: the action queue peaks, then drains */
+    std::vector<ax_action_v1> acts(40);
+    for (uint32_t i = 0; i < acts.size(); ++i) {
+        acts[i] = {};
+        acts[i].tick     = 1 + i;
+        acts[i].actor_id = 1;
+        acts[i].type     = i == 13 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+    }
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = (uint32_t)acts.size();
+    batch.actions    = acts.data();
+    CHECK_OK(ax_submit_actions(core, &batch));
+
+    ax_inbox_params_v1 inbox = {};
+    inbox.version    = 1;
+    inbox.size_bytes = sizeof(inbox);
+    inbox.capacity   = 256;
+    CHECK_OK(ax_enable_action_inbox(core, &inbox));
+
+    CHECK_OK(ax_step_ticks(core, 40));
+    CHECK_OK(ax_get_memory_stats(core, &m));
+
+    const ax_memory_usage_v1& q = m.subsystems[AX_MEM_ACTION_QUEUE];
+    CHECK(q.used_bytes == 0, "queue should be drained, %llu bytes used",
+          (unsigned long long)q.used_bytes);
+    CHECK(q.high_water_bytes >= 40 * sizeof(ax_action_v1),
+          "queue high-water should remember 40 actions, got %llu",
+          (unsigned long long)q.high_water_bytes);
+    CHECK(m.subsystems[AX_MEM_INBOX].reserved_bytes >= 256 * sizeof(ax_action_v1),
+          "inbox ring should be counted");
+    CHECK(m.subsystems[AX_MEM_FRAME].high_water_bytes > 0, "tick events should reach the frame arena");
+    CHECK(m.subsystems[AX_MEM_TIMERS].reserved_bytes > 0, "timer wheel should be counted");
+    CHECK(m.total.reserved_bytes == reserved_sum(m), "accounting should hold after stepping");
+    CHECK(m.total.high_water_bytes >= m.total.reserved_bytes, "peak >= live");
+
+    /* save scratch appears once a save has been taken */
+    std::vector<uint8_t> save(64 * 1024);
+    uint32_t size = 0;
+    CHECK_OK(ax_save_bytes(core, save.data(), (uint32_t)save.size(), &size));
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.total.reserved_bytes == reserved_sum(m), "accounting should hold after a save");
+
+    /* polling is free: no allocations through either allocator */
+    uint64_t global = alloc_hook_count();
+    uint64_t count  = m.allocation_count;
+    for (int i = 0; i < 100; ++i) {
+        ax_get_memory_stats(core, &m);
+    }
+    CHECK(alloc_hook_count() == global, "polling should not use global new");
+    CHECK(m.allocation_count == count, "polling should not use the core allocator");
+
+    /* worker threads add thread-table and scratch bytes */
+    CHECK(set_threading(core, 4, 1), "set_threading failed");
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_JOBS].used_bytes > 0, "job system should be counted");
+    CHECK(m.total.reserved_bytes == reserved_sum(m), "accounting should hold with workers");
+
+    CHECK_ERR(ax_get_memory_stats(core, nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_get_memory_stats(nullptr, &m), AX_ERR_INVALID_ARG);
+
+    ax_destroy(core);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: entity pool
+ * Despawned slots are recycled under a new generation, so stale ids
+ * stay invalid; iteration stays dense; pool state survives save/load
+ * and spawn/despawn churn is deterministic.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static uint32_t spawn_target(ax_core* core, float x, int32_t hp) {
+    ax_debug_spawn_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.archetype_id = 2000;
+    p.hp           = hp;
+    p.px = x;  p.py = 0.0f;  p.pz = -12.0f;
+
+    uint32_t id = 0;
+    if (ax_debug_spawn_target(core, &p, &id) != AX_OK) {
+        return 0;
+    }
+    return id;
+}
+
+static bool snapshot_has_entity(ax_core* core, uint32_t id) {
+    auto buf = take_snapshot(core);
+    parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+    for (uint32_t i = 0; snap.header && i < snap.header->entity_count; ++i) {
+        if (snap.entities[i].id == id) return true;
+    }
+    return false;
+}
+
+static uint32_t snapshot_entity_count(ax_core* core) {
+    auto buf = take_snapshot(core);
+    parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+    return snap.header ? snap.header->entity_count : 0;
+}
+
+/* deterministic spawn/despawn churn driven by a small LCG */
+static void churn_entities(ax_core* core, uint32_t rounds) {
+    uint32_t rng = 12345;
+    std::vector<uint32_t> live;
+    for (uint32_t r = 0; r < rounds; ++r) {
+        rng = rng * 1664525u + 1013904223u;
+        if (live.empty() || (rng >> 16) % 3 != 0) {
+            uint32_t id = spawn_target(core, (float)(r % 7), 20);
+            if (id) live.push_back(id);
+        } else {
+            uint32_t k = (rng >> 8) % (uint32_t)live.size();
+            ax_debug_despawn_entity(core, live[k]);
+            live[k] = live.back();
+            live.pop_back();
+        }
+    }
+}
+
+static void test_entity_pool(void) {
+    printf("test_entity_pool\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    /* content ids keep their values; spawns fill the lowest free slot */
+    CHECK(snapshot_has_entity(core, 1) && snapshot_has_entity(core, 100),
+          "content ids should be unchanged");
+    uint32_t a = spawn_target(core, 1.0f, 20);
+    uint32_t b = spawn_target(core, 2.0f, 20);
+    uint32_t c = spawn_target(core, 3.0f, 20);
+    CHECK(a == 2 && b == 3 && c == 4, "spawns should take slots 2,3,4 at gen 0, got %u,%u,%u", a, b, c);
+    CHECK(snapshot_entity_count(core) == 7, "4 content + 3 spawned entities");
+
+    /* despawn from the middle: iteration stays dense, others survive */
+    CHECK_OK(ax_debug_despawn_entity(core, b));
+    CHECK(snapshot_entity_count(core) == 6, "despawn should remove one entity");
+    CHECK(!snapshot_has_entity(core, b), "despawned id should be gone");
+    CHECK(snapshot_has_entity(core, a) && snapshot_has_entity(core, c), "neighbours should survive");
+
+    /* slot reuse bumps the generation; the stale id stays invalid */
+    uint32_t b2 = spawn_target(core, 4.0f, 20);
+    CHECK((b2 & AX_ENTITY_ID_SLOT_MASK) == (b & AX_ENTITY_ID_SLOT_MASK),
+          "freed slot should be reused");
+    CHECK((b2 >> AX_ENTITY_ID_GEN_SHIFT) == 1, "reused slot should be generation 1, id 0x%08X", b2);
+    CHECK_ERR(ax_debug_despawn_entity(core, b), AX_ERR_INVALID_ARG);
+    CHECK(strstr(ax_get_last_error(), "stale") != nullptr,
+          "error should mention stale ids, got '%s'", ax_get_last_error());
+    CHECK_ERR(ax_debug_despawn_entity(core, 1), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_debug_despawn_entity(core, 0), AX_ERR_INVALID_ARG);
+
+    /* a slot is retired once its generation would wrap */
+    {
+        uint32_t slot = 0;
+        bool ok = true;
+        for (uint32_t gen = 0; gen < 256 && ok; ++gen) {
+            uint32_t id = spawn_target(core, 0.0f, 5);
+            if (gen == 0) slot = id & AX_ENTITY_ID_SLOT_MASK;
+            ok = (id & AX_ENTITY_ID_SLOT_MASK) == slot && (id >> AX_ENTITY_ID_GEN_SHIFT) == gen;
+            ok = ok && ax_debug_despawn_entity(core, id) == AX_OK;
+        }
+        CHECK(ok, "one slot should cycle through generations 0..255");
+        uint32_t next = spawn_target(core, 0.0f, 5);
+        CHECK((next & AX_ENTITY_ID_SLOT_MASK) != slot, "generation-255 slot should be retired");
+        ax_debug_despawn_entity(core, next);
+    }
+
+    /* hits land on spawned targets once the content targets are gone */
+    {
+        CHECK_OK(ax_debug_despawn_entity(core, 100));
+        CHECK_OK(ax_debug_despawn_entity(core, 101));
+        CHECK_OK(ax_debug_despawn_entity(core, 102));
+        ax_debug_despawn_entity(core, c);
+        ax_debug_despawn_entity(core, b2);
+
+        ax_action_v1 fire = {};
+        fire.tick = 1;  fire.actor_id = 1;  fire.type = AX_ACT_FIRE_ONCE;
+        submit_action(core, fire);
+        CHECK_OK(ax_step_ticks(core, 1));
+
+        auto buf = take_snapshot(core);
+        parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+        bool hit_a = false;
+        for (uint32_t i = 0; snap.header && i < snap.header->event_count; ++i) {
+            if (snap.events[i].type == AX_EVT_DAMAGE_DEALT && snap.events[i].b == a) hit_a = true;
+        }
+        CHECK(hit_a, "fire should damage the remaining spawned target");
+    }
+
+    /* bad params */
+    {
+        ax_debug_spawn_params_v1 p = {};
+        p.version    = 1;
+        p.size_bytes = sizeof(p);
+        p.hp         = 0;
+        uint32_t id = 0;
+        CHECK_ERR(ax_debug_spawn_target(core, &p, &id), AX_ERR_INVALID_ARG);
+        p.hp      = 10;
+        p.version = 2;
+        CHECK_ERR(ax_debug_spawn_target(core, &p, &id), AX_ERR_UNSUPPORTED);
+        CHECK_ERR(ax_debug_spawn_target(core, nullptr, &id), AX_ERR_INVALID_ARG);
+    }
+    ax_destroy(core);
+
+    /* determinism and save/load of the pool */
+    ax_core* x = create_and_load("content/");
+    ax_core* y = create_and_load("content/");
+    ax_core* z = create_and_load("content/");
+    CHECK(x && y && z, "core creation failed");
+    if (!x || !y || !z) {
+        ax_destroy(x);  ax_destroy(y);  ax_destroy(z);
+        return;
+    }
+
+    churn_entities(x, 500);
+    churn_entities(y, 500);
+    uint64_t hx = 0, hy = 0, hz = 0;
+    CHECK_OK(ax_get_state_hash(x, &hx));
+    CHECK_OK(ax_get_state_hash(y, &hy));
+    CHECK(hx == hy, "identical churn should give identical state");
+
+    auto save = take_save(x);
+    CHECK_OK(ax_load_save_bytes(z, save.data(), (uint32_t)save.size()));
+    CHECK_OK(ax_get_state_hash(z, &hz));
+    CHECK(hz == hx, "loaded pool should hash like the saved one");
+    CHECK(snapshot_entity_count(z) == snapshot_entity_count(x), "entity count should survive save/load");
+
+    /* the next spawn picks the same slot and generation on both */
+    uint32_t nx = spawn_target(x, 0.0f, 5);
+    uint32_t nz = spawn_target(z, 0.0f, 5);
+    CHECK(nx != 0 && nx == nz, "free list should survive save/load (0x%08X vs 0x%08X)", nx, nz);
+
+    /* a save whose entity id disagrees with its slot generation is rejected */
+    {
+        const uint32_t ext2_at = SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE + 16;
+        uint32_t entities_at = read_u32(save, ext2_at + 4);
+        std::vector<uint8_t> bad = save;
+        write_u32(bad, entities_at, read_u32(bad, entities_at) + (1u << AX_ENTITY_ID_GEN_SHIFT));
+        reseal_save(bad);
+        CHECK_ERR(ax_load_save_bytes(y, bad.data(), (uint32_t)bad.size()), AX_ERR_INVALID_ARG);
+        CHECK(strstr(ax_get_last_error(), "stale or duplicated") != nullptr,
+              "error should name the entity, got '%s'", ax_get_last_error());
+
+        uint64_t hy2 = 0;
+        CHECK_OK(ax_get_state_hash(y, &hy2));
+        CHECK(hy2 == hy, "failed load must not touch the world");
+    }
+
+    ax_destroy(x);
+    ax_destroy(y);
+    ax_destroy(z);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: compact snapshot
+ * The v2 encoding is smaller than v1 and decodes back to it: exact for
+ * ids, archetypes, flags, hp, weapon and events; positions within half
+ * a grid step; rotations close to the normalized source. Malformed
+ * requests and blobs are rejected.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static std::vector<uint8_t> take_compact_snapshot(ax_core* core, float grid) {
+    ax_snapshot_request_v1 req = {};
+    req.version         = 1;
+    req.size_bytes      = sizeof(req);
+    req.flags           = AX_SNAPSHOT_REQ_COMPACT;
+    req.position_grid_m = grid;
+
+    uint32_t size = 0;
+    if (ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size) != AX_OK) return {};
+    std::vector<uint8_t> buf(size);
+    if (ax_get_snapshot_bytes_ex(core, &req, buf.data(), size, &size) != AX_OK) return {};
+    return buf;
+}
+
+static std::vector<uint8_t> decode_compact_snapshot(const std::vector<uint8_t>& v2) {
+    uint32_t size = 0;
+    if (ax_decode_snapshot_v2(v2.data(), (uint32_t)v2.size(), nullptr, 0, &size) != AX_OK) return {};
+    std::vector<uint8_t> buf(size);
+    if (ax_decode_snapshot_v2(v2.data(), (uint32_t)v2.size(), buf.data(), size, &size) != AX_OK) return {};
+    return buf;
+}
+
+static void test_compact_snapshot(void) {
+    printf("test_compact_snapshot\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    for (uint32_t i = 0; i < 40; ++i) {
+        spawn_target(core, (float)i * 1.37f - 20.0f, 20 + (int32_t)i);
+    }
+
+    /* turn the player and fire so the blob carries a rotation and events */
+    ax_action_v1 look = {};
+    look.tick       = 1;
+    look.actor_id   = 1;
+    look.type       = AX_ACT_LOOK_INTENT;
+    look.u.look.yaw = 0.3f;
+    submit_action(core, look);
+    ax_action_v1 fire = {};
+    fire.tick     = 1;
+    fire.actor_id = 1;
+    fire.type     = AX_ACT_FIRE_ONCE;
+    fire.u.fire_once.weapon_slot = 0;
+    submit_action(core, fire);
+    CHECK_OK(ax_step_ticks(core, 1));
+
+    const float grid = 1.0f / 256.0f;
+    auto v1  = take_snapshot(core);
+    auto v2  = take_compact_snapshot(core, grid);
+    auto dec = decode_compact_snapshot(v2);
+    CHECK(!v2.empty() && !dec.empty(), "compact snapshot + decode should succeed: %s", ax_get_last_error());
+    CHECK(v2.size() * 2 < v1.size(), "v2 should be under half of v1 (%zu vs %zu bytes)",
+          v2.size(), v1.size());
+    CHECK(dec.size() == v1.size(), "decoded size should match v1 (%zu vs %zu)", dec.size(), v1.size());
+
+    parsed_snapshot a = parse_snapshot(v1.data(), (uint32_t)v1.size());
+    parsed_snapshot b = parse_snapshot(dec.data(), (uint32_t)dec.size());
+    if (a.header && b.header && dec.size() == v1.size()) {
+        CHECK(b.header->tick == a.header->tick, "tick should round-trip");
+        CHECK(a.header->event_count > 0 && b.header->event_count == a.header->event_count,
+              "events should round-trip (%u)", a.header->event_count);
+        CHECK(std::memcmp(a.events, b.events, a.header->event_count * sizeof(ax_snapshot_event_v1)) == 0,
+              "event records should be exact");
+        CHECK(a.weapon && b.weapon && std::memcmp(a.weapon, b.weapon, sizeof(*a.weapon)) == 0,
+              "weapon record should be exact");
+
+        uint32_t exact = 0;
+        float    pos_err = 0.0f, rot_err = 0.0f;
+        for (uint32_t i = 0; i < a.header->entity_count; ++i) {
+            const ax_snapshot_entity_v1& s = a.entities[i];
+            const ax_snapshot_entity_v1& d = b.entities[i];
+            if (s.id == d.id && s.archetype_id == d.archetype_id &&
+                s.hp == d.hp && s.state_flags == d.state_flags) {
+                exact++;
+            }
+            pos_err = std::fmax(pos_err, std::fabs(s.px - d.px));
+            pos_err = std::fmax(pos_err, std::fabs(s.py - d.py));
+            pos_err = std::fmax(pos_err, std::fabs(s.pz - d.pz));
+
+            float n = std::sqrt(s.rx * s.rx + s.ry * s.ry + s.rz * s.rz + s.rw * s.rw);
+            float dot = (s.rx * d.rx + s.ry * d.ry + s.rz * d.rz + s.rw * d.rw) / n;
+            rot_err = std::fmax(rot_err, 1.0f - std::fabs(dot));
+        }
+        CHECK(exact == a.header->entity_count, "ids/archetypes/hp/flags should be exact (%u / %u)",
+              exact, a.header->entity_count);
+        CHECK(pos_err <= grid * 0.5f + 1e-4f, "position error %f exceeds half a grid step", pos_err);
+        CHECK(rot_err < 1e-5f, "rotation should match the normalized source (1-|dot| = %g)", rot_err);
+    }
+
+    /* the A1 look stub stores raw yaw in ry; v2 returns a unit quaternion */
+    if (b.header) {
+        for (uint32_t i = 0; i < b.header->entity_count; ++i) {
+            const ax_snapshot_entity_v1& d = b.entities[i];
+            if (d.id != 1) continue;
+            float n = d.rx * d.rx + d.ry * d.ry + d.rz * d.rz + d.rw * d.rw;
+            CHECK(std::fabs(n - 1.0f) < 1e-3f, "decoded player rotation should be unit, |q|^2 = %f", n);
+        }
+    }
+
+    /* flags 0 is the v1 blob; default grid; size query; buffer too small */
+    {
+        ax_snapshot_request_v1 req = {};
+        req.version    = 1;
+        req.size_bytes = sizeof(req);
+        uint32_t size = 0;
+        CHECK_OK(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size));
+        CHECK(size == v1.size(), "flags 0 should give the v1 size");
+
+        req.flags = AX_SNAPSHOT_REQ_COMPACT;
+        CHECK_OK(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size));
+        CHECK(size > 0 && size < v1.size(), "default grid should encode compactly (%u)", size);
+
+        std::vector<uint8_t> small(size - 1);
+        uint32_t need = 0;
+        CHECK_ERR(ax_get_snapshot_bytes_ex(core, &req, small.data(), size - 1, &need),
+                  AX_ERR_BUFFER_TOO_SMALL);
+        CHECK(need == size, "required size should be reported on BUFFER_TOO_SMALL");
+
+        req.position_grid_m = -1.0f;
+        CHECK_ERR(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size), AX_ERR_INVALID_ARG);
+        req.position_grid_m = NAN;
+        CHECK_ERR(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size), AX_ERR_INVALID_ARG);
+        req.position_grid_m = 0.0f;
+        req.flags = 0x80;
+        CHECK_ERR(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size), AX_ERR_INVALID_ARG);
+        req.flags = AX_SNAPSHOT_REQ_COMPACT;
+        req.version = 2;
+        CHECK_ERR(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size), AX_ERR_UNSUPPORTED);
+    }
+
+    /* corrupt / truncated blobs are rejected, never read past the end */
+    {
+        uint32_t size = 0;
+        std::vector<uint8_t> out(dec.size() + 64);
+
+        CHECK_ERR(ax_decode_snapshot_v2(v1.data(), (uint32_t)v1.size(), nullptr, 0, &size),
+                  AX_ERR_UNSUPPORTED);
+        CHECK_ERR(ax_decode_snapshot_v2(v2.data(), 8, nullptr, 0, &size), AX_ERR_INVALID_ARG);
+
+        std::vector<uint8_t> cut(v2.begin(), v2.end() - 3);
+        uint32_t cut_size = (uint32_t)cut.size();
+        std::memcpy(cut.data() + 4, &cut_size, 4);
+        CHECK_ERR(ax_decode_snapshot_v2(cut.data(), cut_size, out.data(), (uint32_t)out.size(), &size),
+                  AX_ERR_INVALID_ARG);
+        CHECK(std::strstr(ax_get_last_error(), "truncated") != nullptr,
+              "truncation should be named, got '%s'", ax_get_last_error());
+
+        std::vector<uint8_t> extra(v2);
+        extra.push_back(0);
+        uint32_t extra_size = (uint32_t)extra.size();
+        std::memcpy(extra.data() + 4, &extra_size, 4);
+        CHECK_ERR(ax_decode_snapshot_v2(extra.data(), extra_size, out.data(), (uint32_t)out.size(), &size),
+                  AX_ERR_INVALID_ARG);
+
+        /* an endless varint must not run off the buffer */
+        std::vector<uint8_t> runaway(v2);
+        std::memset(runaway.data() + sizeof(ax_snapshot_header_v2) + sizeof(ax_snapshot_player_weapon_v1),
+                    0xFF, runaway.size() - sizeof(ax_snapshot_header_v2) - sizeof(ax_snapshot_player_weapon_v1));
+        CHECK_ERR(ax_decode_snapshot_v2(runaway.data(), (uint32_t)runaway.size(), out.data(),
+                                        (uint32_t)out.size(), &size), AX_ERR_INVALID_ARG);
+
+        /* a bare header must not ask for gigabytes: counts are checked against the bytes */
+        ax_snapshot_header_v2 hostile = {};
+        hostile.version         = 2;
+        hostile.size_bytes      = sizeof(hostile);
+        hostile.entity_count    = 50000000;
+        hostile.position_grid_m = 1.0f;
+        size = 0;
+        CHECK_ERR(ax_decode_snapshot_v2(&hostile, sizeof(hostile), nullptr, 0, &size), AX_ERR_INVALID_ARG);
+        CHECK(size == 0, "a rejected size query should not report a size (%u)", size);
+
+        std::vector<uint8_t> table(sizeof(hostile) + 4);
+        const uint32_t many_weapons = 100000000;
+        hostile.entity_count = 0;
+        hostile.size_bytes   = (uint32_t)table.size();
+        hostile.flags        = AX_SNAPSHOT_V2_WEAPONS;
+        std::memcpy(table.data(), &hostile, sizeof(hostile));
+        std::memcpy(table.data() + sizeof(hostile), &many_weapons, 4);
+        CHECK_ERR(ax_decode_snapshot_v2(table.data(), (uint32_t)table.size(), nullptr, 0, &size),
+                  AX_ERR_INVALID_ARG);
+        CHECK(size == 0, "a rejected weapon count should not report a size (%u)", size);
+
+        CHECK_ERR(ax_decode_snapshot_v2(v2.data(), (uint32_t)v2.size(), out.data(),
+                                        (uint32_t)dec.size() - 1, &size), AX_ERR_BUFFER_TOO_SMALL);
+        CHECK(size == dec.size(), "decode should report the v1 size on BUFFER_TOO_SMALL");
+    }
+
+    ax_destroy(core);
+
+    /* bench smoke: both encodings agree over several ticks */
+    snapshot_bench_params bp;
+    bp.content_path = "content/";
+    bp.entities     = 200;
+    bp.iterations   = 5;
+    bp.grid_m       = 0.0f;
+    snapshot_bench_result br;
+    CHECK(snapshot_bench_run(bp, &br), "snapshot bench should run");
+    CHECK(br.v2_bytes > 0 && br.v2_bytes < br.v1_bytes, "bench v2 %u should be smaller than v1 %u",
+          br.v2_bytes, br.v1_bytes);
+    CHECK(br.max_position_error <= AX_SNAPSHOT_DEFAULT_GRID_M * 0.5f + 1e-4f,
+          "bench position error %f", br.max_position_error);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: tick profiler
+ * With profiling on, every tick leaves a phase record in the ring
+ * (oldest first, last AX_PROFILE_RING_TICKS ticks) and the heavy entry
+ * points count their calls. Recording allocates nothing per tick and
+ * never changes truth.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_profiler(void) {
+    printf("test_profiler\n");
+
+    ax_core* core  = create_and_load("content/");
+    ax_core* plain = create_and_load("content/");
+    CHECK(core != nullptr && plain != nullptr, "core creation failed");
+    if (!core || !plain) return;
+
+    /* ax_profile_v1 carries the whole ring: keep it off the stack */
+    std::vector<ax_profile_v1> buf(1);
+    ax_profile_v1& prof = buf[0];
+
+    if (ax_get_profile(core, &prof) == AX_ERR_UNSUPPORTED) {
+        CHECK_ERR(ax_set_profiling(core, 1), AX_ERR_UNSUPPORTED);
+        printf("  (profiler compiled out: AX_ENABLE_PROFILER=OFF)\n");
+        ax_destroy(core);
+        ax_destroy(plain);
+        return;
+    }
+    CHECK(prof.version == 1 && prof.size_bytes == sizeof(ax_profile_v1), "profile header should be filled");
+    CHECK(prof.enabled == 0 && prof.tick_count == 0, "profiling should be off by default");
+
+    ax_memory_stats_v1 m = {};
+    m.version    = 1;
+    m.size_bytes = sizeof(m);
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_PROFILER].reserved_bytes == 0, "no ring while off");
+
+    CHECK_OK(ax_set_profiling(core, 1));
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_PROFILER].reserved_bytes >= AX_PROFILE_RING_TICKS * sizeof(ax_profile_tick_v1),
+          "ring should be counted under AX_MEM_PROFILER");
+
+    const uint32_t TICKS = AX_PROFILE_RING_TICKS + 44;
+    uint64_t allocs = 0;
+    for (uint32_t t = 1; t <= TICKS; ++t) {
+        ax_action_v1 acts[2] = {};
+        for (ax_action_v1& a : acts) {
+            a.tick     = t;
+            a.actor_id = 1;
+        }
+        acts[0].type = AX_ACT_LOOK_INTENT;
+        acts[0].u.look.yaw = 0.01f;
+        acts[1].type = (t % 20 == 0) ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = 2;
+        batch.actions    = acts;
+
+        uint64_t before = alloc_hook_count();
+        for (ax_core* c : { core, plain }) {
+            ax_submit_actions(c, &batch);
+            ax_step_ticks(c, 1);
+        }
+        if (t > 64) allocs += alloc_hook_count() - before;
+    }
+    CHECK(allocs == 0, "profiled steady-state ticks should not allocate, saw %llu",
+          (unsigned long long)allocs);
+
+    uint64_t h1 = 0, h2 = 0;
+    CHECK_OK(ax_get_state_hash(core, &h1));
+    CHECK_OK(ax_get_state_hash(plain, &h2));
+    CHECK(h1 == h2, "profiling must not change truth");
+
+    std::vector<uint8_t> snap = take_snapshot(core);
+    ax_snapshot_request_v1 req = {};
+    req.version    = 1;
+    req.size_bytes = sizeof(req);
+    uint32_t size = 0;
+    CHECK_OK(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size));   /* v1 via _ex */
+    req.flags = AX_SNAPSHOT_REQ_COMPACT;
+    CHECK_OK(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size));
+
+    CHECK_OK(ax_get_profile(core, &prof));
+    CHECK(prof.enabled == 1, "profile should report enabled");
+    CHECK(prof.phase_count == AX_PROFILE_PHASE_COUNT && prof.call_count == AX_PROFILE_CALL_COUNT,
+          "phase/call counts should match the enums");
+    CHECK(prof.tick_count == AX_PROFILE_RING_TICKS, "ring should be full, got %u", prof.tick_count);
+
+    bool ordered = true, totals = true, nested = true;
+    for (uint32_t i = 0; i < prof.tick_count; ++i) {
+        const ax_profile_tick_v1& r = prof.ticks[i];
+        ordered &= r.tick == TICKS - AX_PROFILE_RING_TICKS + 1 + i;
+        uint64_t top = 0;
+        for (uint32_t p = 0; p < AX_PROFILE_PHASE_COUNT; ++p) {
+            if (p != AX_PROFILE_PHASE_HIT_RESOLUTION) top += r.phase_ns[p];
+        }
+        totals &= r.total_ns > 0 && top <= r.total_ns;
+        nested &= r.phase_ns[AX_PROFILE_PHASE_HIT_RESOLUTION] <= r.phase_ns[AX_PROFILE_PHASE_COMBAT];
+    }
+    CHECK(ordered, "ring should hold the last %u ticks, oldest first", AX_PROFILE_RING_TICKS);
+    CHECK(totals, "phases should sum to no more than the tick total");
+    CHECK(nested, "hit resolution should be nested in combat");
+
+    CHECK(prof.calls[AX_PROFILE_CALL_STEP_TICKS].count == TICKS, "step calls = %llu",
+          (unsigned long long)prof.calls[AX_PROFILE_CALL_STEP_TICKS].count);
+    CHECK(prof.calls[AX_PROFILE_CALL_SUBMIT_ACTIONS].count == TICKS, "submit calls = %llu",
+          (unsigned long long)prof.calls[AX_PROFILE_CALL_SUBMIT_ACTIONS].count);
+    CHECK(prof.calls[AX_PROFILE_CALL_GET_SNAPSHOT].count == 4,
+          "snapshot calls should count once per call in either encoding, got %llu",
+          (unsigned long long)prof.calls[AX_PROFILE_CALL_GET_SNAPSHOT].count);
+    CHECK(prof.calls[AX_PROFILE_CALL_GET_STATE_HASH].count == 1, "state hash calls");
+    const ax_profile_call_v1& step = prof.calls[AX_PROFILE_CALL_STEP_TICKS];
+    CHECK(step.max_ns > 0 && step.max_ns <= step.total_ns, "call max should be within total");
+
+    /* switching off clears and releases the ring */
+    CHECK_OK(ax_set_profiling(core, 0));
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_get_profile(core, &prof));
+    CHECK(prof.enabled == 0 && prof.tick_count == 0 && prof.calls[AX_PROFILE_CALL_STEP_TICKS].count == 0,
+          "disabled profiler should record nothing");
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_PROFILER].reserved_bytes == 0, "ring should be released");
+
+    CHECK_ERR(ax_get_profile(core, nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_set_profiling(nullptr, 1), AX_ERR_INVALID_ARG);
+
+    ax_destroy(core);
+    ax_destroy(plain);
+
+    /* the shell report covers every tick across ring wrap-arounds */
+    profile_report_params pp;
+    pp.content_path     = "content/";
+    pp.ticks            = 600;
+    pp.entities         = 2000;
+    pp.actions_per_tick = 8;
+    profile_report_result pr;
+    CHECK(profile_report_run(pp, &pr), "profile report should collect %u ticks, got %zu",
+          pp.ticks, pr.ticks.size());
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: trace export
+ * While tracing, ticks, phases, entry points and job chunks land in the
+ * per-thread buffers as complete events that nest by time. Draining
+ * empties the buffers; full buffers drop and count. Tracing never
+ * changes truth, and the shell writes the drain as Chrome JSON.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_trace_export(void) {
+    printf("test_trace_export\n");
+
+    ax_core* core  = create_and_load("content/");
+    ax_core* plain = create_and_load("content/");
+    CHECK(core != nullptr && plain != nullptr, "core creation failed");
+    if (!core || !plain) return;
+
+    ax_trace_params_v1 tp = {};
+    tp.version    = 1;
+    tp.size_bytes = sizeof(tp);
+
+    if (ax_enable_tracing(core, &tp) == AX_ERR_UNSUPPORTED) {
+        uint32_t n = 1;
+        CHECK_ERR(ax_drain_trace(core, nullptr, 0, &n, nullptr), AX_ERR_UNSUPPORTED);
+        CHECK(n == 0, "compiled-out drain should report no events");
+        printf("  (profiler compiled out: AX_ENABLE_PROFILER=OFF)\n");
+        ax_destroy(core);
+        ax_destroy(plain);
+        return;
+    }
+
+    /* off: nothing recorded, no buffers held */
+    CHECK_OK(ax_enable_tracing(core, nullptr));
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_step_ticks(plain, 1));
+    uint32_t pending = 1;
+    CHECK_OK(ax_drain_trace(core, nullptr, 0, &pending, nullptr));
+    CHECK(pending == 0, "tracing off should record nothing, got %u", pending);
+    ax_memory_stats_v1 m = {};
+    m.version    = 1;
+    m.size_bytes = sizeof(m);
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_PROFILER].reserved_bytes == 0, "no trace buffers while off");
+
+    CHECK_OK(ax_enable_tracing(core, &tp));
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_PROFILER].reserved_bytes >=
+              AX_TRACE_DEFAULT_CAPACITY * sizeof(ax_trace_event_v1),
+          "trace buffers should be counted under AX_MEM_PROFILER");
+
+    const uint32_t TICKS = 20;
+    for (uint32_t t = 2; t < 2 + TICKS; ++t) {
+        ax_action_v1 acts[2] = {};
+        for (ax_action_v1& a : acts) {
+            a.tick     = t;
+            a.actor_id = 1;
+        }
+        acts[0].type = AX_ACT_MOVE_INTENT;
+        acts[0].u.move.x = 0.5f;
+        acts[1].type = AX_ACT_FIRE_ONCE;
+
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = 2;
+        batch.actions    = acts;
+        for (ax_core* c : { core, plain }) {
+            ax_submit_actions(c, &batch);
+            ax_step_ticks(c, 1);
+        }
+    }
+
+    uint64_t h1 = 0, h2 = 0;
+    CHECK_OK(ax_get_state_hash(core, &h1));
+    CHECK_OK(ax_get_state_hash(plain, &h2));
+    CHECK(h1 == h2, "tracing must not change truth");
+
+    /* size query, then too small, then the real drain */
+    CHECK_OK(ax_drain_trace(core, nullptr, 0, &pending, nullptr));
+    CHECK(pending > TICKS * 5, "expected tick/phase/call events, got %u", pending);
+    std::vector<ax_trace_event_v1> ev(pending);
+    uint32_t count = 0;
+    CHECK_ERR(ax_drain_trace(core, ev.data(), pending - 1, &count, nullptr), AX_ERR_BUFFER_TOO_SMALL);
+    CHECK(count == pending, "too-small drain should still report the pending count");
+    uint64_t dropped = 1;
+    CHECK_OK(ax_drain_trace(core, ev.data(), pending, &count, &dropped));
+    CHECK(count == pending && dropped == 0, "drain count %u, dropped %llu", count,
+          (unsigned long long)dropped);
+
+    uint32_t ticks = 0, phases = 0, steps = 0, submits = 0, hashes = 0, jobs = 0;
+    bool contained = true, named = true;
+    for (const ax_trace_event_v1& e : ev) {
+        named &= std::strcmp(ax_get_trace_name(e.name), "?") != 0;
+        if (e.name == AX_TRACE_TICK) ticks++;
+        if (e.name >= AX_TRACE_PHASE_BASE && e.name < AX_TRACE_PHASE_BASE + AX_PROFILE_PHASE_COUNT) {
+            phases++;
+            /* every phase sits inside exactly one tick */
+            uint32_t parents = 0;
+            for (const ax_trace_event_v1& t : ev) {
+                if (t.name == AX_TRACE_TICK && t.start_ns <= e.start_ns &&
+                    e.start_ns + e.duration_ns <= t.start_ns + t.duration_ns) {
+                    parents++;
+                }
+            }
+            contained &= parents == 1;
+        }
+        if (e.name == AX_TRACE_CALL_BASE + AX_PROFILE_CALL_STEP_TICKS)     steps++;
+        if (e.name == AX_TRACE_CALL_BASE + AX_PROFILE_CALL_SUBMIT_ACTIONS) submits++;
+        if (e.name == AX_TRACE_CALL_BASE + AX_PROFILE_CALL_GET_STATE_HASH) hashes++;
+        if (e.name == AX_TRACE_JOB_MOVEMENT || e.name == AX_TRACE_JOB_HIT_SCAN) jobs++;
+    }
+    CHECK(named, "every event should have a name");
+    CHECK(ticks == TICKS, "tick events = %u", ticks);
+    CHECK(steps == TICKS && submits == TICKS && hashes == 1, "call events: step %u submit %u hash %u",
+          steps, submits, hashes);
+    CHECK(phases >= TICKS * 5, "phase events = %u", phases);
+    CHECK(contained, "phases should nest inside their tick");
+    CHECK(jobs > 0, "inline job chunks should be traced on thread 0");
+
+    CHECK_OK(ax_drain_trace(core, nullptr, 0, &pending, nullptr));
+    CHECK(pending == 0, "drain should empty the buffers, %u left", pending);
+
+    /* small buffers fill, drop and count */
+    tp.capacity_events = 8;
+    CHECK_OK(ax_enable_tracing(core, &tp));
+    CHECK_OK(ax_step_ticks(core, 4));
+    CHECK_OK(ax_drain_trace(core, nullptr, 0, &pending, nullptr));
+    CHECK(pending == 8, "full buffer should hold its capacity, got %u", pending);
+    CHECK_OK(ax_drain_trace(core, ev.data(), (uint32_t)ev.size(), &count, &dropped));
+    CHECK(dropped > 0, "overflow should be counted as dropped");
+    CHECK_OK(ax_drain_trace(core, ev.data(), (uint32_t)ev.size(), &count, &dropped));
+    CHECK(count == 0 && dropped == 0, "drain should reset the drop counter");
+
+    /* job chunks land on worker tracks when the sim is threaded */
+    ax_debug_spawn_params_v1 sp = {};
+    sp.version      = 1;
+    sp.size_bytes   = sizeof(sp);
+    sp.archetype_id = 2000;
+    sp.hp           = 1000000;
+    uint32_t spawned = 0;
+    for (uint32_t i = 0; i < 4096; ++i) {
+        sp.px = (float)(i % 64) - 32.0f;
+        sp.pz = -12.0f - (float)(i / 64);
+        uint32_t id = 0;
+        spawned += ax_debug_spawn_target(core, &sp, &id) == AX_OK;
+    }
+    CHECK(spawned == 4096, "spawned %u / 4096 targets", spawned);
+    ax_threading_params_v1 thr = {};
+    thr.version            = 1;
+    thr.size_bytes         = sizeof(thr);
+    thr.worker_count       = 4;
+    thr.min_parallel_items = 1;
+    CHECK_OK(ax_set_threading(core, &thr));
+    tp.capacity_events = 0;
+    CHECK_OK(ax_enable_tracing(core, &tp));
+    /* which worker claims a range is up to the scheduler: give them a few ticks */
+    uint32_t max_thread = 0;
+    bool jobs_only = true;
+    for (uint32_t round = 0; round < 32 && max_thread == 0; ++round) {
+        CHECK_OK(ax_step_ticks(core, 4));
+        CHECK_OK(ax_drain_trace(core, nullptr, 0, &pending, nullptr));
+        ev.resize(pending);
+        CHECK_OK(ax_drain_trace(core, ev.data(), pending, &count, nullptr));
+        for (const ax_trace_event_v1& e : ev) {
+            if (e.thread > max_thread) max_thread = e.thread;
+            if (e.thread > 0) {
+                jobs_only &= e.name == AX_TRACE_JOB_MOVEMENT || e.name == AX_TRACE_JOB_HIT_SCAN;
+            }
+        }
+    }
+    CHECK(max_thread < 4, "thread ids should stay below the worker count, got %u", max_thread);
+    if (std::thread::hardware_concurrency() > 1) {
+        CHECK(max_thread > 0, "job chunks should reach worker tracks");
+    }
+    CHECK(jobs_only, "workers should only record job chunks");
+
+    CHECK_ERR(ax_drain_trace(core, ev.data(), 1, nullptr, nullptr), AX_ERR_INVALID_ARG);
+    tp.version = 2;
+    CHECK_ERR(ax_enable_tracing(core, &tp), AX_ERR_UNSUPPORTED);
+    tp.version   = 1;
+    tp.reserved0 = 1;
+    CHECK_ERR(ax_enable_tracing(core, &tp), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_enable_tracing(nullptr, nullptr), AX_ERR_INVALID_ARG);
+    CHECK(std::strcmp(ax_get_trace_name(9999), "?") == 0, "unknown names map to \"?\"");
+
+    ax_destroy(core);
+    ax_destroy(plain);
+
+    /* shell export: threaded workload to Chrome JSON */
+    trace_export_params xp;
+    xp.content_path     = "content/";
+    xp.ticks            = 100;
+    xp.entities         = 2000;
+    xp.actions_per_tick = 8;
+    xp.workers          = 2;
+    xp.capacity_events  = 0;
+    trace_export_result xr;
+    CHECK(trace_export_run(xp, &xr), "trace export should run");
+    CHECK(xr.dropped == 0 && xr.events.size() > xp.ticks * 8, "exported %zu events, %llu dropped",
+          xr.events.size(), (unsigned long long)xr.dropped);
+
+    FILE* f = tmpfile();
+    CHECK(f != nullptr, "tmpfile failed");
+    if (!f) return;
+    CHECK(trace_write_json(f, xr.events.data(), xr.events.size()), "JSON write failed");
+    long size = ftell(f);
+    rewind(f);
+    std::string json((size_t)size, '\0');
+    size_t got = fread(&json[0], 1, (size_t)size, f);
+    fclose(f);
+    CHECK(got == (size_t)size, "JSON read back %zu / %ld", got, size);
+    CHECK(json.compare(0, 17, "{\"displayTimeUnit") == 0 && json.find("\n]}\n") == json.size() - 4,
+          "JSON should be one trace-event object");
+    CHECK(json.find("\"name\":\"tick\",\"ph\":\"X\"") != std::string::npos &&
+          json.find("\"thread_name\"") != std::string::npos,
+          "JSON should carry X events and thread names");
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: perf gate
+ * Baseline files parse (and reject malformed lines), a metric fails
+ * only past its own tolerance, rewritten baselines keep tolerances, and
+ * every gate workload runs. Timing itself is not asserted here.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_perf_gate(void) {
+    printf("test_perf_gate\n");
+
+    FILE* f = tmpfile();
+    CHECK(f != nullptr, "tmpfile failed");
+    if (!f) return;
+    fputs("# comment\n"
+          "metric step  1000  10   # trailing comment\n"
+          "\n"
+          "metric save  5000.5 50\n", f);
+    rewind(f);
+    std::vector<perf_baseline_entry> base;
+    CHECK(perf_parse_baseline(f, "test", &base), "baseline should parse");
+    fclose(f);
+    CHECK(base.size() == 2 && base[0].name == "step" && base[0].median_ns == 1000.0 &&
+          base[0].tolerance_pct == 10.0 && base[1].median_ns == 5000.5,
+          "baseline entries should round-trip");
+
+    for (const char* bad : { "metric step 1000\n", "metric step abc 10\n", "metric step 0 10\n",
+                             "median step 1000 10\n", "metric step 1000 -5\n" }) {
+        f = tmpfile();
+        fputs(bad, f);
+        rewind(f);
+        std::vector<perf_baseline_entry> tmp;
+        CHECK(!perf_parse_baseline(f, "test", &tmp), "malformed line should fail: %s", bad);
+        fclose(f);
+    }
+
+    FILE* sink = tmpfile();
+    std::vector<perf_sample> samples(3);
+    samples[0] = { "step", 1099.0, 0.0, 0.0 };     /* +9.9%: within 10%      */
+    samples[1] = { "save", 7400.0, 0.0, 0.0 };     /* +48%: within 50%       */
+    samples[2] = { "new_metric", 1.0, 0.0, 0.0 };  /* not in baseline: no fail */
+    CHECK(perf_compare(sink, base, samples) == 0, "within tolerance should pass");
+    samples[0].median_ns = 1101.0;
+    CHECK(perf_compare(sink, base, samples) == 1, "step past 10%% should regress");
+    samples[1].median_ns = 7600.0;
+    CHECK(perf_compare(sink, base, samples) == 2, "save past 50%% should regress");
+    fclose(sink);
+
+    f = tmpfile();
+    CHECK(perf_write_baseline(f, samples, base), "baseline write failed");
+    rewind(f);
+    std::vector<perf_baseline_entry> rewritten;
+    CHECK(perf_parse_baseline(f, "rewritten", &rewritten), "rewritten baseline should parse");
+    fclose(f);
+    CHECK(rewritten.size() == 3 && rewritten[0].tolerance_pct == 10.0 &&
+          rewritten[1].tolerance_pct == 50.0 && rewritten[2].tolerance_pct == PERF_DEFAULT_TOLERANCE,
+          "rewrite should keep tolerances and default new metrics");
+
+    perf_gate_params pp;
+    pp.content_path = "content/";
+    pp.entities     = 200;
+    pp.reps         = 1;
+    std::vector<perf_sample> run;
+    CHECK(perf_run_workloads(pp, &run), "perf workloads should run");
+    bool positive = run.size() == 6;
+    for (const perf_sample& s : run) positive &= s.median_ns > 0.0;
+    CHECK(positive, "expected 6 positive metrics, got %zu", run.size());
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: runtime stats
+ * Counters track actions (submitted / applied / stale), ticks, events
+ * by type, fire-blocked reasons and snapshot / save / load volume; the
+ * tick and entry-point histograms agree with their counts while timing
+ * is on and stay empty while it is off. Stats are operational only:
+ * they survive a load, never touch truth, and reset to zero.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static uint64_t hist_bucket_sum(const ax_histogram_v1& h) {
+    uint64_t n = 0;
+    for (uint32_t b = 0; b < AX_STATS_HIST_BUCKETS; ++b) n += h.buckets[b];
+    return n;
+}
+
+static void test_runtime_stats(void) {
+    printf("test_runtime_stats\n");
+
+    ax_core* core  = create_and_load("content/");
+    ax_core* plain = create_and_load("content/");
+    CHECK(core != nullptr && plain != nullptr, "core creation failed");
+    if (!core || !plain) return;
+
+    /* ax_stats_v1 is several KB: keep it off the stack */
+    std::vector<ax_stats_v1> buf(1);
+    ax_stats_v1& st = buf[0];
+    CHECK_OK(ax_get_stats(core, &st));
+    CHECK(st.version == 1 && st.size_bytes == sizeof(ax_stats_v1) &&
+          st.call_count == AX_PROFILE_CALL_COUNT, "stats header should be filled");
+    CHECK(st.ticks == 0 && st.actions_submitted == 0 && st.tick_ns.count == 0,
+          "fresh core should have zero stats");
+    CHECK_OK(ax_set_stats_timing(core, 1));     /* `plain` keeps the default: off */
+
+    /* 14 fires: 12 land, then two blocked on an empty magazine */
+    const uint32_t FIRES = 14;
+    for (uint32_t t = 1; t <= FIRES; ++t) {
+        ax_action_v1 a = {};
+        a.tick     = t;
+        a.actor_id = 1;
+        a.type     = AX_ACT_FIRE_ONCE;
+        submit_action(core, a);
+        submit_action(plain, a);
+        CHECK_OK(ax_step_ticks(core, 1));
+        CHECK_OK(ax_step_ticks(plain, 1));
+    }
+    /* reload, then fire while reloading; one stale action for a past tick */
+    ax_action_v1 r = {};
+    r.tick     = FIRES + 1;
+    r.actor_id = 1;
+    r.type     = AX_ACT_RELOAD;
+    ax_action_v1 f = r;
+    f.tick = FIRES + 2;
+    f.type = AX_ACT_FIRE_ONCE;
+    ax_action_v1 stale = f;
+    stale.tick = 3;
+    for (ax_core* c : { core, plain }) {
+        submit_action(c, r);
+        submit_action(c, f);
+        submit_action(c, stale);
+        CHECK_OK(ax_step_ticks(c, 2));
+    }
+
+    CHECK_OK(ax_get_stats(core, &st));
+    CHECK(st.actions_submitted == FIRES + 3, "submitted = %llu", (unsigned long long)st.actions_submitted);
+    CHECK(st.actions_applied == FIRES + 2, "applied = %llu", (unsigned long long)st.actions_applied);
+    CHECK(st.actions_stale == 1, "stale = %llu", (unsigned long long)st.actions_stale);
+    CHECK(st.ticks == FIRES + 2, "ticks = %llu", (unsigned long long)st.ticks);
+    CHECK(st.events[AX_EVT_DAMAGE_DEALT] == 12, "damage events = %llu",
+          (unsigned long long)st.events[AX_EVT_DAMAGE_DEALT]);
+    CHECK(st.events[AX_EVT_RELOAD_STARTED] == 1, "reload started events");
+    CHECK(st.events[AX_EVT_FIRE_BLOCKED] == 3, "fire blocked events = %llu",
+          (unsigned long long)st.events[AX_EVT_FIRE_BLOCKED]);
+    CHECK(st.fire_blocked[AX_FIRE_BLOCKED_EMPTY_MAG] == 2 &&
+          st.fire_blocked[AX_FIRE_BLOCKED_RELOADING] == 1,
+          "blocked by reason: empty %llu reloading %llu",
+          (unsigned long long)st.fire_blocked[AX_FIRE_BLOCKED_EMPTY_MAG],
+          (unsigned long long)st.fire_blocked[AX_FIRE_BLOCKED_RELOADING]);
+
+    CHECK(st.tick_ns.count == st.ticks && hist_bucket_sum(st.tick_ns) == st.ticks,
+          "tick histogram should hold every tick");
+    CHECK(st.tick_ns.min_ns <= st.tick_ns.max_ns && st.tick_ns.max_ns <= st.tick_ns.total_ns,
+          "tick histogram min/max/total");
+    const ax_histogram_v1& steps = st.calls[AX_PROFILE_CALL_STEP_TICKS];
+    CHECK(steps.count == FIRES + 1 && hist_bucket_sum(steps) == steps.count,
+          "step call histogram count = %llu", (unsigned long long)steps.count);
+    CHECK(st.calls[AX_PROFILE_CALL_SUBMIT_ACTIONS].count == FIRES + 3, "submit call count");
+
+    /* untimed: the same counters, empty histograms */
+    std::vector<ax_stats_v1> plain_buf(1);
+    ax_stats_v1& ps = plain_buf[0];
+    CHECK_OK(ax_get_stats(plain, &ps));
+    CHECK(ps.ticks == st.ticks && ps.actions_applied == st.actions_applied &&
+          std::memcmp(ps.events, st.events, sizeof(ps.events)) == 0,
+          "counters should not depend on timing");
+    bool untimed = ps.tick_ns.count == 0 && hist_bucket_sum(ps.tick_ns) == 0;
+    for (uint32_t c = 0; c < AX_STATS_MAX_CALLS; ++c) untimed &= ps.calls[c].count == 0;
+    CHECK(untimed, "histograms should stay empty while timing is off");
+
+    uint64_t h1 = 0, h2 = 0;
+    CHECK_OK(ax_get_state_hash(core, &h1));
+    CHECK_OK(ax_get_state_hash(plain, &h2));
+    CHECK(h1 == h2, "stats must not change truth");
+
+    /* output volume: only calls that wrote a buffer count */
+    std::vector<uint8_t> snap = take_snapshot(core);
+    ax_snapshot_request_v1 req = {};
+    req.version    = 1;
+    req.size_bytes = sizeof(req);
+    req.flags      = AX_SNAPSHOT_REQ_COMPACT;
+    uint32_t csize = 0;
+    CHECK_OK(ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &csize));
+    std::vector<uint8_t> compact(csize);
+    CHECK_OK(ax_get_snapshot_bytes_ex(core, &req, compact.data(), csize, &csize));
+    std::vector<uint8_t> save = take_save(core);
+    CHECK_OK(ax_load_save_bytes(core, save.data(), (uint32_t)save.size()));
+
+    uint64_t before_ticks = st.ticks;
+    CHECK_OK(ax_get_stats(core, &st));
+    CHECK(st.snapshots == 2 && st.snapshot_bytes == snap.size() + csize,
+          "snapshots %llu, bytes %llu", (unsigned long long)st.snapshots,
+          (unsigned long long)st.snapshot_bytes);
+    CHECK(st.saves == 1 && st.save_bytes == save.size(), "save volume");
+    CHECK(st.loads == 1 && st.load_bytes == save.size(), "load volume");
+    CHECK(st.calls[AX_PROFILE_CALL_SAVE].count == 2 && st.calls[AX_PROFILE_CALL_LOAD].count == 1,
+          "save calls (query + copy) and load calls should be timed");
+    CHECK(st.ticks == before_ticks, "load should not reset stats");
+
+    CHECK_OK(ax_reset_stats(core));
+    CHECK_OK(ax_get_stats(core, &st));
+    CHECK(st.version == 1 && st.ticks == 0 && st.snapshots == 0 && st.tick_ns.count == 0 &&
+          st.calls[AX_PROFILE_CALL_STEP_TICKS].count == 0 && st.events[AX_EVT_DAMAGE_DEALT] == 0,
+          "reset should zero every counter");
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_get_stats(core, &st));
+    CHECK(st.tick_ns.count == 1, "reset should keep timing on");
+    CHECK_OK(ax_set_stats_timing(core, 0));
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_get_stats(core, &st));
+    CHECK(st.ticks == 2 && st.tick_ns.count == 1 && st.calls[AX_PROFILE_CALL_STEP_TICKS].count == 1,
+          "timing off should stop the histograms, not the counters");
+
+    /* every tick is its own sample: one heavy tick in a 100-tick step stands out */
+    {
+        ax_core* spiky = create_and_load("content/");
+        CHECK(spiky != nullptr, "core creation failed");
+        if (spiky) {
+            CHECK_OK(ax_set_stats_timing(spiky, 1));
+            std::vector<ax_action_v1> shots(2000);
+            for (ax_action_v1& a : shots) {
+                a          = {};
+                a.tick     = 50;
+                a.actor_id = 1;
+                a.type     = AX_ACT_FIRE_ONCE;
+            }
+            ax_action_batch_v1 batch = {};
+            batch.version    = 1;
+            batch.size_bytes = sizeof(batch);
+            batch.count      = (uint32_t)shots.size();
+            batch.actions    = shots.data();
+            CHECK_OK(ax_submit_actions(spiky, &batch));
+            CHECK_OK(ax_step_ticks(spiky, 100));
+
+            CHECK_OK(ax_get_stats(spiky, &st));
+            const ax_histogram_v1& ticks = st.tick_ns;
+            uint64_t mean = ticks.count ? ticks.total_ns / ticks.count : 0;
+            CHECK(ticks.count == 100 && hist_bucket_sum(ticks) == 100,
+                  "100-tick step: %llu tick samples", (unsigned long long)ticks.count);
+            CHECK(ticks.max_ns > 4 * mean && ticks.min_ns < mean,
+                  "the heavy tick should stand out: min %llu mean %llu max %llu",
+                  (unsigned long long)ticks.min_ns, (unsigned long long)mean,
+                  (unsigned long long)ticks.max_ns);
+            const ax_histogram_v1& steps = st.calls[AX_PROFILE_CALL_STEP_TICKS];
+            CHECK(steps.count == 1 && steps.total_ns >= ticks.total_ns,
+                  "the step call spans its ticks");
+            ax_destroy(spiky);
+        }
+    }
+
+    /* bucket layout: exact below 4, then four per power of two */
+    bool floors = ax_stats_bucket_floor_ns(0) == 0 && ax_stats_bucket_floor_ns(3) == 3 &&
+                  ax_stats_bucket_floor_ns(4) == 4 && ax_stats_bucket_floor_ns(7) == 7 &&
+                  ax_stats_bucket_floor_ns(8) == 8 && ax_stats_bucket_floor_ns(9) == 10 &&
+                  ax_stats_bucket_floor_ns(AX_STATS_HIST_BUCKETS) == UINT64_MAX;
+    for (uint32_t b = 1; b < AX_STATS_HIST_BUCKETS; ++b) {
+        uint64_t lo = ax_stats_bucket_floor_ns(b - 1), hi = ax_stats_bucket_floor_ns(b);
+        floors &= hi > lo && (b < 5 || (double)(hi - lo) <= 0.25 * (double)hi);
+    }
+    CHECK(floors, "bucket floors should be increasing and within 25%%");
+
+    CHECK_ERR(ax_get_stats(core, nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_reset_stats(nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_set_stats_timing(nullptr, 1), AX_ERR_INVALID_ARG);
+
+    ax_destroy(core);
+    ax_destroy(plain);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: procedural population
+ *
+ * ax_spawn_population is a pure function of its params: equal params
+ * give equal worlds on separate cores, a new seed a different one.
+ * Every layout stays inside its region, the archetype mix follows the
+ * weights, bad params spawn nothing, and the world survives save/load.
+ * The content-side record parses into the same params.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_population(void) {
+    printf("test_population\n");
+
+    ax_population_params_v1 pop;
+    worldgen_default_params(&pop);
+    pop.count = 20000;
+
+    ax_core* a = create_and_load("content/");
+    ax_core* b = create_and_load("content/");
+    CHECK(a != nullptr && b != nullptr, "core creation failed");
+    if (!a || !b) return;
+    uint32_t base = snapshot_entity_count(a);
+
+    /* all-or-nothing errors */
+    ax_population_params_v1 bad = pop;
+    CHECK_ERR(ax_spawn_population(a, nullptr, nullptr), AX_ERR_INVALID_ARG);
+    bad.version = 2;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_UNSUPPORTED);
+    bad = pop;  bad.size_bytes = 8;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.count = 0;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.layout = AX_POP_LAYOUT_COUNT;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.max_x = bad.min_x;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.archetypes[0].weight = 0;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.archetype_count = AX_POP_MAX_ARCHETYPES + 1;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.layout = AX_POP_LAYOUT_CLUSTERS;  bad.cluster_count = 0;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.layout = AX_POP_LAYOUT_RING;  bad.ring_inner_radius_m = 500.0f;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    bad = pop;  bad.count = 1u << 24;
+    CHECK_ERR(ax_spawn_population(a, &bad, nullptr), AX_ERR_INVALID_ARG);
+    CHECK(snapshot_entity_count(a) == base, "failed calls should spawn nothing");
+
+    {
+        ax_create_params_v1 cp = {};
+        cp.version    = 1;
+        cp.size_bytes = sizeof(cp);
+        cp.abi_major  = AX_ABI_MAJOR;
+        cp.abi_minor  = AX_ABI_MINOR;
+        ax_core* fresh = nullptr;
+        CHECK_OK(ax_create(&cp, &fresh));
+        CHECK_ERR(ax_spawn_population(fresh, &pop, nullptr), AX_ERR_BAD_STATE);
+        ax_destroy(fresh);
+    }
+
+    /* determinism: same params, same world; another seed, another world */
+    uint32_t first_a = 0, first_b = 0;
+    CHECK_OK(ax_spawn_population(a, &pop, &first_a));
+    CHECK_OK(ax_spawn_population(b, &pop, &first_b));
+    uint64_t ha = 0, hb = 0;
+    CHECK_OK(ax_get_state_hash(a, &ha));
+    CHECK_OK(ax_get_state_hash(b, &hb));
+    CHECK(ha == hb && first_a == first_b && first_a != 0, "equal params should give equal worlds");
+    CHECK(snapshot_entity_count(a) == base + pop.count, "count mismatch: %u", snapshot_entity_count(a));
+
+    {
+        ax_core* c = create_and_load("content/");
+        ax_population_params_v1 other = pop;
+        other.seed = 2;
+        CHECK_OK(ax_spawn_population(c, &other, nullptr));
+        uint64_t hc = 0;
+        CHECK_OK(ax_get_state_hash(c, &hc));
+        CHECK(hc != ha, "a different seed should give a different world");
+        ax_destroy(c);
+    }
+
+    /* save / load round trip */
+    {
+        auto save = take_save(a);
+        ax_core* c = create_and_load("content/");
+        CHECK_OK(ax_load_save_bytes(c, save.data(), (uint32_t)save.size()));
+        uint64_t hc = 0;
+        CHECK_OK(ax_get_state_hash(c, &hc));
+        CHECK(hc == ha, "population should survive save/load");
+        ax_destroy(c);
+    }
+
+    /* layouts stay in bounds; the mix follows the weights (3:1) */
+    for (uint32_t layout = 0; layout < AX_POP_LAYOUT_COUNT; ++layout) {
+        ax_population_params_v1 lp = pop;
+        lp.layout              = layout;
+        lp.min_x = -100.0f;  lp.max_x = 100.0f;
+        lp.min_z = -300.0f;  lp.max_z = -50.0f;
+        lp.jitter_m            = 0.5f;
+        lp.cluster_count       = 8;
+        lp.cluster_radius_m    = 10.0f;
+        lp.ring_inner_radius_m = 60.0f;
+        lp.archetype_count     = 2;
+        lp.archetypes[0] = { 2000, 3, 50, 0 };
+        lp.archetypes[1] = { 2001, 1, 200, 0 };
+
+        ax_core* c = create_and_load("content/");
+        CHECK_OK(ax_spawn_population(c, &lp, nullptr));
+        std::vector<uint8_t> snap = take_snapshot(c);
+        parsed_snapshot ps = parse_snapshot(snap.data(), (uint32_t)snap.size());
+
+        float slack = layout == AX_POP_LAYOUT_GRID ? lp.jitter_m
+                    : layout == AX_POP_LAYOUT_CLUSTERS ? lp.cluster_radius_m : 1e-3f;
+        bool in_bounds = true, hp_ok = true;
+        uint32_t light = 0;
+        for (uint32_t i = base; i < ps.header->entity_count; ++i) {
+            const ax_snapshot_entity_v1& e = ps.entities[i];
+            in_bounds &= e.px >= lp.min_x - slack && e.px <= lp.max_x + slack &&
+                         e.pz >= lp.min_z - slack && e.pz <= lp.max_z + slack && e.py == 0.0f;
+            if (layout == AX_POP_LAYOUT_RING) {
+                float dx = e.px, dz = e.pz + 175.0f;
+                float r  = std::sqrt(dx * dx + dz * dz);
+                in_bounds &= r >= lp.ring_inner_radius_m - 1e-3f && r <= 100.0f + 1e-3f;
+            }
+            hp_ok &= (e.archetype_id == 2000 && e.hp == 50) || (e.archetype_id == 2001 && e.hp == 200);
+            hp_ok &= (e.state_flags & AX_ENT_FLAG_TARGET) != 0;
+            light += e.archetype_id == 2000;
+        }
+        double share = (double)light / lp.count;
+        CHECK(in_bounds, "layout %s left its region", worldgen_layout_name(layout));
+        CHECK(hp_ok, "layout %s: archetype / hp / flags mismatch", worldgen_layout_name(layout));
+        CHECK(share > 0.73 && share < 0.77, "layout %s: mix share %.3f, expected ~0.75",
+              worldgen_layout_name(layout), share);
+        ax_destroy(c);
+    }
+
+    /* freed slots are taken first, as with ax_debug_spawn_target */
+    {
+        ax_core* c = create_and_load("content/");
+        ax_population_params_v1 small = pop;
+        small.count = 4;
+        uint32_t first = 0, refill = 0;
+        CHECK_OK(ax_spawn_population(c, &small, &first));
+        CHECK_OK(ax_debug_despawn_entity(c, first));
+        CHECK_OK(ax_spawn_population(c, &small, &refill));
+        CHECK(refill == (first | (1u << 24)), "population should reuse the freed slot (0x%08X)", refill);
+        ax_destroy(c);
+    }
+
+    /* the content record and the CLI mix parse into the same params */
+    {
+        const char* record =
+            "{ \"id\": 9000, \"type\": \"population\", \"name\": \"t\",\n"
+            "  \"seed\": 18446744073709551615, \"count\": 1234, \"layout\": \"ring\",\n"
+            "  \"region\": [-10, -20.5, 10, 20.5], \"ring_inner_radius_m\": 2.5,\n"
+            "  \"extra\": { \"x\": [1, true, null] },\n"
+            "  \"archetypes\": [ { \"id\": 2000, \"weight\": 3, \"hp\": 50 },\n"
+            "                  { \"id\": 2001, \"weight\": 1, \"hp\": 200 } ] }";
+        ax_population_params_v1 rp;
+        worldgen_default_params(&rp);
+        std::string err;
+        CHECK(worldgen_parse_population(record, &rp, &err), "record should parse: %s", err.c_str());
+        CHECK(rp.seed == UINT64_MAX && rp.count == 1234 && rp.layout == AX_POP_LAYOUT_RING &&
+              rp.min_z == -20.5f && rp.max_x == 10.0f && rp.ring_inner_radius_m == 2.5f &&
+              rp.archetype_count == 2 && rp.archetypes[1].hp == 200, "record fields mismatch");
+
+        ax_population_params_v1 mp;
+        worldgen_default_params(&mp);
+        CHECK(worldgen_parse_mix("2000:3:50,2001:1:200", &mp) &&
+              std::memcmp(mp.archetypes, rp.archetypes, sizeof(mp.archetypes)) == 0,
+              "--mix should match the record's archetypes");
+        CHECK(!worldgen_parse_mix("2000:3", &mp) && !worldgen_parse_mix("", &mp),
+              "malformed --mix should be rejected");
+
+        CHECK(!worldgen_parse_population("{ \"type\": \"target\" }", &rp, &err), "wrong type accepted");
+        CHECK(!worldgen_parse_population("{ \"type\": \"population\", \"layout\": \"spiral\" }", &rp, &err),
+              "unknown layout accepted");
+        CHECK(!worldgen_parse_population("{ \"type\": \"population\", \"count\": -1 }", &rp, &err),
+              "negative count accepted");
+        CHECK(!worldgen_parse_population("{ \"count\": 5 }", &rp, &err), "untyped record accepted");
+    }
+
+    ax_destroy(a);
+    ax_destroy(b);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: buffered logging
+ *
+ * With a log_fn the core writes binary records and delivers them only
+ * on flush: content load, stale actions, fire blocked, kills, reloads
+ * and save loads each produce one formatted line. min_level filters,
+ * per-tick rate limits and a full ring are counted, writing never
+ * allocates, the background flusher delivers on its own thread, and
+ * ax_destroy delivers what is left.
+ * ══════════════════════════════════════════════════════════════════ */
+
+struct log_capture {
+    std::mutex               lock;
+    std::vector<int>         levels;
+    std::vector<std::string> lines;
+    std::thread::id          last_thread;
+
+    static void fn(void* user, int level, const char* msg) {
+        log_capture* c = (log_capture*)user;
+        std::lock_guard<std::mutex> guard(c->lock);
+        c->levels.push_back(level);
+        c->lines.push_back(msg);
+        c->last_thread = std::this_thread::get_id();
+    }
+    size_t count(const char* needle) {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t n = 0;
+        for (const std::string& l : lines) n += l.find(needle) != std::string::npos;
+        return n;
+    }
+    size_t size() {
+        std::lock_guard<std::mutex> guard(lock);
+        return lines.size();
+    }
+};
+
+static ax_core* create_logging_core(log_capture* cap) {
+    ax_create_params_v1 params = {};
+    params.version    = 1;
+    params.size_bytes = sizeof(params);
+    params.abi_major  = AX_ABI_MAJOR;
+    params.abi_minor  = AX_ABI_MINOR;
+    params.log_fn     = &log_capture::fn;
+    params.log_user   = cap;
+
+    ax_core* core = nullptr;
+    if (ax_create(&params, &core) != AX_OK) return nullptr;
+
+    ax_content_load_params_v1 content = {};
+    content.version    = 1;
+    content.size_bytes = sizeof(content);
+    content.root_path  = "content/";
+    if (ax_load_content(core, &content) != AX_OK) {
+        ax_destroy(core);
+        return nullptr;
+    }
+    return core;
+}
+
+static void submit_fires(ax_core* core, uint64_t tick, uint32_t n) {
+    std::vector<ax_action_v1> fires(n);
+    for (ax_action_v1& a : fires) {
+        a = {};
+        a.tick     = tick;
+        a.actor_id = 1;
+        a.type     = AX_ACT_FIRE_ONCE;
+    }
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = n;
+    batch.actions    = fires.data();
+    CHECK_OK(ax_submit_actions(core, &batch));
+}
+
+static void test_logging(void) {
+    printf("test_logging\n");
+
+    log_capture cap;
+    ax_core* core = create_logging_core(&cap);
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    /* nothing reaches the host until a flush */
+    CHECK(cap.size() == 0, "records should wait for a flush");
+    uint32_t delivered = 0;
+    CHECK_OK(ax_flush_log(core, &delivered));
+    CHECK(delivered == 1 && cap.count("[tick 0] content loaded: 4 entities") == 1,
+          "content load should log once (%u delivered)", delivered);
+    CHECK(cap.levels.size() == 1 && cap.levels[0] == AX_LOG_INFO, "content load is INFO");
+
+    ax_memory_stats_v1 m = {};
+    m.version    = 1;
+    m.size_bytes = sizeof(m);
+    CHECK_OK(ax_get_memory_stats(core, &m));
+    CHECK(m.subsystems[AX_MEM_LOG].reserved_bytes >= AX_LOG_DEFAULT_CAPACITY * 40,
+          "log ring should be counted under AX_MEM_LOG");
+
+    /* 14 fires at INFO: 12 land (two kills), two blocked (DEBUG, filtered) */
+    for (uint64_t t = 1; t <= 14; ++t) {
+        submit_fires(core, t, 1);
+        CHECK_OK(ax_step_ticks(core, 1));
+    }
+    ax_log_stats_v1 ls = {};
+    CHECK_OK(ax_get_log_stats(core, &ls));
+    CHECK(ls.written[AX_LOG_INFO] == 3 && ls.written[AX_LOG_DEBUG] == 0 && ls.pending == 2,
+          "INFO: load + 2 kills written, DEBUG filtered (info %llu, debug %llu, pending %u)",
+          (unsigned long long)ls.written[AX_LOG_INFO], (unsigned long long)ls.written[AX_LOG_DEBUG],
+          ls.pending);
+    CHECK_OK(ax_flush_log(core, &delivered));
+    CHECK(delivered == 2 && cap.count("destroyed by actor 1") == 2, "kills should be logged");
+
+    /* DEBUG with a per-tick limit of 2: five blocked fires in one tick */
+    ax_log_params_v1 lp = {};
+    lp.version    = 1;
+    lp.size_bytes = sizeof(lp);
+    lp.min_level  = AX_LOG_DEBUG;
+    lp.rate_per_tick[AX_LOG_DEBUG] = 2;
+    CHECK_OK(ax_configure_logging(core, &lp));
+    submit_fires(core, 15, 5);
+    uint64_t allocs = alloc_hook_count();
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK(alloc_hook_count() == allocs, "writing records should not allocate");
+    CHECK_OK(ax_get_log_stats(core, &ls));
+    CHECK(ls.written[AX_LOG_DEBUG] == 2 && ls.rate_limited[AX_LOG_DEBUG] == 3,
+          "rate limit: written %llu, limited %llu",
+          (unsigned long long)ls.written[AX_LOG_DEBUG], (unsigned long long)ls.rate_limited[AX_LOG_DEBUG]);
+    submit_fires(core, 16, 1);
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_get_log_stats(core, &ls));
+    CHECK(ls.written[AX_LOG_DEBUG] == 3, "the budget should reset every tick");
+    CHECK_OK(ax_flush_log(core, &delivered));
+    CHECK(delivered == 3 && cap.count("fire blocked: actor 1, slot 0, empty magazine") == 3,
+          "blocked fires should be DEBUG lines");
+
+    /* a 2-record ring: the rest is dropped, never blocks */
+    lp.capacity_records = 2;
+    lp.rate_per_tick[AX_LOG_DEBUG] = 0;
+    CHECK_OK(ax_configure_logging(core, &lp));
+    submit_fires(core, 17, 5);
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_get_log_stats(core, &ls));
+    CHECK(ls.written[AX_LOG_DEBUG] == 2 && ls.dropped_full == 3 && ls.pending == 2,
+          "full ring: written %llu, dropped %llu", (unsigned long long)ls.written[AX_LOG_DEBUG],
+          (unsigned long long)ls.dropped_full);
+
+    /* reconfiguring delivers the old pipeline's records; reload is DEBUG */
+    size_t before = cap.size();
+    CHECK_OK(ax_configure_logging(core, &lp));
+    CHECK(cap.size() == before + 2, "reconfigure should deliver pending records");
+    CHECK_OK(ax_get_log_stats(core, &ls));
+    CHECK(ls.written[AX_LOG_DEBUG] == 0 && ls.pending == 0, "counters restart on reconfigure");
+
+    ax_action_v1 reload = {};
+    reload.tick     = 18;
+    reload.actor_id = 1;
+    reload.type     = AX_ACT_RELOAD;
+    submit_action(core, reload);
+    CHECK_OK(ax_step_ticks(core, 40));
+    CHECK_OK(ax_flush_log(core, nullptr));
+    CHECK(cap.count("reload done: actor 1, slot 0, 12 rounds") == 1, "reload completion should log");
+
+    /* inbox actions for a past tick are dropped as stale (WARN) */
+    ax_inbox_params_v1 ip = {};
+    ip.version    = 1;
+    ip.size_bytes = sizeof(ip);
+    CHECK_OK(ax_enable_action_inbox(core, &ip));
+    ax_action_v1 old = {};
+    old.tick     = 3;
+    old.actor_id = 1;
+    old.type     = AX_ACT_FIRE_ONCE;
+    ax_action_batch_v1 ob = {};
+    ob.version    = 1;
+    ob.size_bytes = sizeof(ob);
+    ob.count      = 1;
+    ob.actions    = &old;
+    CHECK_OK(ax_inbox_submit_actions(core, &ob));
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_flush_log(core, nullptr));
+    CHECK(cap.count("1 action(s) dropped as stale") == 1,
+          "stale inbox action should log a WARN");
+
+    /* save load logs; flushing during an async step is legal */
+    auto save = take_save(core);
+    CHECK_OK(ax_load_save_bytes(core, save.data(), (uint32_t)save.size()));
+    CHECK_OK(ax_step_ticks_async(core, 50));
+    CHECK_OK(ax_flush_log(core, nullptr));
+    CHECK_ERR(ax_configure_logging(core, &lp), AX_ERR_BAD_STATE);
+    CHECK_OK(ax_step_wait(core));
+    CHECK_OK(ax_flush_log(core, nullptr));
+    CHECK(cap.count("save loaded") == 1, "save load should log");
+
+    /* background flusher delivers on its own thread */
+    lp.flush_mode        = AX_LOG_FLUSH_BACKGROUND;
+    lp.flush_interval_ms = 1;
+    lp.capacity_records  = 0;
+    CHECK_OK(ax_configure_logging(core, &lp));
+    uint64_t next = 0;
+    {
+        ax_diagnostics_v1 d = {};
+        d.version    = 1;
+        d.size_bytes = sizeof(d);
+        CHECK_OK(ax_get_diagnostics(core, &d));
+        next = d.current_tick + 1;
+    }
+    submit_fires(core, next, 3);
+    CHECK_OK(ax_step_ticks(core, 1));
+    uint64_t written = 0;
+    for (int i = 0; i < 2000; ++i) {
+        ax_get_log_stats(core, &ls);
+        written = ls.written[AX_LOG_INFO] + ls.written[AX_LOG_DEBUG];
+        if (written > 0 && ls.delivered == written) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(written > 0 && ls.delivered == written, "background flusher should deliver (%llu of %llu)",
+          (unsigned long long)ls.delivered, (unsigned long long)written);
+    {
+        std::lock_guard<std::mutex> guard(cap.lock);
+        CHECK(cap.last_thread != std::this_thread::get_id(), "delivery should be on the flusher thread");
+    }
+
+    /* ax_destroy delivers what is left */
+    ax_log_params_v1 badp = lp;
+    badp.version = 2;
+    CHECK_ERR(ax_configure_logging(core, &badp), AX_ERR_UNSUPPORTED);
+    badp = lp;  badp.min_level = AX_LOG_LEVEL_COUNT;
+    CHECK_ERR(ax_configure_logging(core, &badp), AX_ERR_INVALID_ARG);
+    badp = lp;  badp.capacity_records = AX_LOG_MAX_CAPACITY + 1;
+    CHECK_ERR(ax_configure_logging(core, &badp), AX_ERR_INVALID_ARG);
+    CHECK_OK(ax_configure_logging(core, nullptr));
+    submit_fires(core, next + 1, 1);
+    CHECK_OK(ax_step_ticks(core, 1));
+    CHECK_OK(ax_unload_content(core));
+    before = cap.size();
+    ax_destroy(core);
+    CHECK(cap.size() == before + 1 && cap.count("content unloaded") == 1,
+          "destroy should flush pending records");
+
+    /* without log_fn: no ring, nothing to configure */
+    ax_core* plain = create_and_load("content/");
+    CHECK(plain != nullptr, "core creation failed");
+    if (plain) {
+        CHECK_ERR(ax_configure_logging(plain, nullptr), AX_ERR_BAD_STATE);
+        CHECK_OK(ax_flush_log(plain, &delivered));
+        CHECK(delivered == 0, "nothing to flush without log_fn");
+        CHECK_OK(ax_get_memory_stats(plain, &m));
+        CHECK(m.subsystems[AX_MEM_LOG].reserved_bytes == 0, "no ring without log_fn");
+        CHECK_OK(ax_get_log_stats(plain, &ls));
+        CHECK(ls.version == 1 && ls.pending == 0 && ls.delivered == 0, "zero stats without log_fn");
+        CHECK_ERR(ax_get_log_stats(plain, nullptr), AX_ERR_INVALID_ARG);
+        ax_destroy(plain);
+    }
+    CHECK_ERR(ax_flush_log(nullptr, nullptr), AX_ERR_INVALID_ARG);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: replay recording
+ * Record through replay_recorder, round-trip the binary file and play
+ * it back at full speed to the same state hash
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_replay_recording(void) {
+    printf("test_replay_recording\n");
+
+    /* content hash: same content, same hash; ticks and loads keep it */
+    ax_core* a = create_and_load("content/");
+    ax_core* b = create_and_load("content/");
+    CHECK(a != nullptr && b != nullptr, "core creation failed");
+    if (!a || !b) return;
+    uint64_t ha = 0, hb = 0;
+    CHECK_OK(ax_get_content_hash(a, &ha));
+    CHECK_OK(ax_get_content_hash(b, &hb));
+    CHECK(ha != 0 && ha == hb, "content hash should match across cores");
+    CHECK_ERR(ax_get_content_hash(a, nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_get_content_hash(nullptr, &ha), AX_ERR_INVALID_ARG);
+
+    /* a scripted session with future-tick and same-tick-batched actions */
+    replay_recorder rec;
+    CHECK(rec.begin(a, false, 0), "recorder should start");      /* inputs only */
+    ax_action_v1 acts[3] = {};
+    bool session_ok = true;
+    for (uint32_t t = 0; t < 200; ++t) {
+        uint32_t n = 0;
+        ax_action_v1& m = acts[n++];
+        m = {};
+        m.tick     = rec.tick() + 1;
+        m.actor_id = 1;
+        m.type     = AX_ACT_MOVE_INTENT;
+        m.u.move.x = 0.1f * (float)(t % 7) - 0.3f;
+        m.u.move.y = 0.7f;
+        if (t % 3 == 0) {
+            ax_action_v1& f = acts[n++];
+            f = {};
+            f.tick     = rec.tick() + 1 + t % 4;
+            f.actor_id = 1;
+            f.type     = t % 45 == 0 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+        }
+        if (t % 10 == 0) {
+            ax_action_v1& l = acts[n++];
+            l = {};
+            l.tick         = rec.tick() + 1;
+            l.actor_id     = 1;
+            l.type         = AX_ACT_LOOK_INTENT;
+            l.u.look.yaw   = 0.05f;
+            l.u.look.pitch = -0.01f;
+        }
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = n;
+        batch.actions    = acts;
+        session_ok = session_ok && rec.submit_actions(&batch) == AX_OK;
+        session_ok = session_ok && rec.step_ticks(t % 5 == 4 ? 3 : 1) == AX_OK;
+    }
+    CHECK(session_ok, "scripted session failed: %s", ax_get_last_error());
+
+    /* rejected batches are not recorded */
+    ax_action_v1 bad = {};
+    bad.type = 99;
+    ax_action_batch_v1 bad_batch = {};
+    bad_batch.version    = 1;
+    bad_batch.size_bytes = sizeof(bad_batch);
+    bad_batch.count      = 1;
+    bad_batch.actions    = &bad;
+    CHECK_ERR(rec.submit_actions(&bad_batch), AX_ERR_INVALID_ARG);
+
+    replay_data data;
+    CHECK(rec.finish(&data), "recorder should finish");
+    uint64_t live_hash = 0;
+    CHECK_OK(ax_get_state_hash(a, &live_hash));
+    CHECK(data.final_hash == live_hash && data.end_tick == 280 && data.start_tick == 0,
+          "recording should end at tick 280 with the live hash");
+    CHECK(data.content_hash == ha && data.abi_major == AX_ABI_MAJOR, "header fields");
+    CHECK(data.actions.size() == 200 + 67 + 20, "every accepted action recorded, got %zu",
+          data.actions.size());
+    uint64_t ha_after = 0;
+    CHECK_OK(ax_get_content_hash(a, &ha_after));
+    CHECK(ha_after == ha, "ticks should not change the content hash");
+
+    /* binary round trip, a few bytes per action */
+    std::vector<uint8_t> bytes;
+    replay_encode(data, &bytes);
+    size_t body = bytes.size() - REPLAY_HEADER_BYTES;
+    CHECK(body <= data.actions.size() * 12, "actions should take at most 12 bytes, got %zu for %zu",
+          body, data.actions.size());
+    replay_data back;
+    std::string error;
+    CHECK(replay_decode(bytes.data(), bytes.size(), &back, &error), "decode failed: %s", error.c_str());
+    bool same = back.actions.size() == data.actions.size() && back.end_tick == data.end_tick &&
+                back.final_hash == data.final_hash && back.submit_ticks == data.submit_ticks;
+    for (size_t i = 0; same && i < data.actions.size(); ++i) {
+        same = memcmp(&back.actions[i], &data.actions[i], sizeof(ax_action_v1)) == 0;
+    }
+    CHECK(same, "decoded recording should equal the original");
+
+    /* full-speed playback reproduces the hash */
+    {
+        replay_player player(back);
+        CHECK(player.start(b, &error), "player start failed: %s", error.c_str());
+        CHECK_OK(player.run_to(UINT64_MAX));
+        uint64_t h = 0;
+        CHECK_OK(ax_get_state_hash(b, &h));
+        CHECK(player.done() && h == data.final_hash, "replayed hash should match the recording");
+    }
+
+    /* corrupt files are rejected, not misread */
+    std::vector<uint8_t> broken = bytes;
+    broken[0] = 'X';
+    CHECK(!replay_decode(broken.data(), broken.size(), &back, &error), "bad magic should fail");
+    CHECK(!replay_decode(bytes.data(), bytes.size() - 1, &back, &error), "truncation should fail");
+    broken = bytes;
+    broken.push_back(0);
+    CHECK(!replay_decode(broken.data(), broken.size(), &back, &error), "trailing bytes should fail");
+    broken = bytes;
+    broken[REPLAY_HEADER_BYTES + 1] = 77;      /* first action's type */
+    CHECK(!replay_decode(broken.data(), broken.size(), &back, &error), "unknown action type should fail");
+
+    /* mismatched content or ABI refuses to play */
+    ax_core* c = create_and_load("content/");
+    CHECK(c != nullptr, "core creation failed");
+    if (c) {
+        replay_data other = data;
+        other.content_hash ^= 1;
+        replay_player p1(other);
+        CHECK(!p1.start(c, &error) && error.find("content hash") != std::string::npos,
+              "content mismatch should be refused, got '%s'", error.c_str());
+        other = data;
+        other.abi_major = AX_ABI_MAJOR + 1;
+        replay_player p2(other);
+        CHECK(!p2.start(c, &error), "ABI major mismatch should be refused");
+        ax_destroy(c);
+    }
+
+    /* embedded start state: a recording may begin after a population spawn */
+    ax_destroy(a);
+    ax_destroy(b);
+    a = create_and_load("content/");
+    b = create_and_load("content/");
+    CHECK(a != nullptr && b != nullptr, "core creation failed");
+    if (!a || !b) return;
+    ax_population_params_v1 pop;
+    worldgen_default_params(&pop);
+    pop.count = 500;
+    CHECK_OK(ax_spawn_population(a, &pop, nullptr));
+    CHECK_OK(ax_step_ticks(a, 5));
+    CHECK(rec.begin(a, true), "recorder should start with a start state");
+    ax_action_v1 fire = {};
+    fire.tick     = 6;
+    fire.actor_id = 1;
+    fire.type     = AX_ACT_FIRE_ONCE;
+    ax_action_batch_v1 fb = {};
+    fb.version    = 1;
+    fb.size_bytes = sizeof(fb);
+    fb.count      = 1;
+    fb.actions    = &fire;
+    CHECK_OK(rec.submit_actions(&fb));
+    CHECK_OK(rec.step_ticks(30));
+    CHECK(rec.finish(&data), "recorder should finish");
+    CHECK(data.start_tick == 5 && !data.start_save.empty(), "start state should be embedded at tick 5");
+    replay_encode(data, &bytes);
+    CHECK(replay_decode(bytes.data(), bytes.size(), &back, &error), "decode failed: %s", error.c_str());
+    replay_player p3(back);
+    CHECK(p3.start(b, &error), "player start failed: %s", error.c_str());
+    CHECK_OK(p3.run_to(20));
+    CHECK(p3.tick() == 20 && !p3.done(), "run_to should stop at the requested tick");
+    CHECK_OK(p3.run_to(back.end_tick));
+    uint64_t h = 0;
+    CHECK_OK(ax_get_state_hash(b, &h));
+    CHECK(h == data.final_hash, "replay from an embedded start state should match");
+
+    ax_destroy(a);
+    ax_destroy(b);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: replay seek
+ * Keyframed recordings seek to any tick, backwards or forwards, and
+ * land on the state hash the original run had at that tick
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_replay_seek(void) {
+    printf("test_replay_seek\n");
+
+    ax_core* a = create_and_load("content/");
+    ax_core* b = create_and_load("content/");
+    CHECK(a != nullptr && b != nullptr, "core creation failed");
+    if (!a || !b) return;
+
+    /*
+     * 3000 ticks, keyframes every 250. Some actions target ticks up to
+     * 400 ahead, so they are still queued across keyframes.
+     */
+    const uint64_t probes[] = { 0, 1, 249, 250, 251, 500, 777, 1999, 2750, 2999, 3000 };
+    const size_t   probe_count = sizeof(probes) / sizeof(probes[0]);
+    uint64_t probe_hash[probe_count] = {};
+    replay_recorder rec;
+    CHECK(rec.begin(a, false, 250), "recorder should start");
+    CHECK_OK(ax_get_state_hash(a, &probe_hash[0]));
+    bool session_ok = true;
+    size_t probe = 1;
+    for (uint32_t t = 0; t < 3000; ++t) {
+        ax_action_v1 acts[2] = {};
+        uint32_t n = 0;
+        if (t % 4 == 0) {
+            ax_action_v1& m = acts[n++];
+            m.tick     = rec.tick() + 1;
+            m.actor_id = 1;
+            m.type     = AX_ACT_MOVE_INTENT;
+            m.u.move.x = (float)(t % 9) * 0.2f - 0.8f;
+            m.u.move.y = 0.5f;
+        }
+        if (t % 7 == 0) {
+            ax_action_v1& f = acts[n++];
+            f.tick     = rec.tick() + 1 + (t % 5 == 0 ? 400 : 0);
+            f.actor_id = 1;
+            f.type     = t % 91 == 0 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+        }
+        if (n > 0) {
+            ax_action_batch_v1 batch = {};
+            batch.version    = 1;
+            batch.size_bytes = sizeof(batch);
+            batch.count      = n;
+            batch.actions    = acts;
+            session_ok = session_ok && rec.submit_actions(&batch) == AX_OK;
+        }
+        session_ok = session_ok && rec.step_ticks(1) == AX_OK;
+        if (probe < probe_count && rec.tick() == probes[probe]) {
+            session_ok = session_ok && ax_get_state_hash(a, &probe_hash[probe++]) == AX_OK;
+        }
+    }
+    CHECK(session_ok && probe == probe_count, "scripted session failed: %s", ax_get_last_error());
+
+    replay_data data;
+    CHECK(rec.finish(&data), "recorder should finish");
+    CHECK(data.keyframes.size() == 13 && data.keyframes[0].tick == 0 && data.keyframes[12].tick == 3000,
+          "expected keyframes at 0, 250, ..., 3000, got %zu", data.keyframes.size());
+
+    std::vector<uint8_t> bytes;
+    replay_encode(data, &bytes);
+    replay_data back;
+    std::string error;
+    CHECK(replay_decode(bytes.data(), bytes.size(), &back, &error), "decode failed: %s", error.c_str());
+    bool same_index = back.keyframes.size() == data.keyframes.size();
+    for (size_t i = 0; same_index && i < data.keyframes.size(); ++i) {
+        same_index = back.keyframes[i].tick == data.keyframes[i].tick &&
+                     back.keyframes[i].first_action == data.keyframes[i].first_action &&
+                     back.keyframes[i].pending_first == data.keyframes[i].pending_first;
+    }
+    CHECK(same_index && back.keyframe_bytes == data.keyframe_bytes, "keyframes should round-trip");
+
+    /* a seek index that disagrees with the body is rejected */
+    std::vector<uint8_t> broken = bytes;
+    broken[broken.size() - 1] ^= 1;        /* last entry's pending_first */
+    CHECK(!replay_decode(broken.data(), broken.size(), &back, &error), "bad index should fail");
+    CHECK(replay_decode(bytes.data(), bytes.size(), &back, &error), "decode failed: %s", error.c_str());
+
+    /* seek around from the end, backwards and forwards */
+    replay_player player(back);
+    CHECK(player.start(b, &error), "player start failed: %s", error.c_str());
+    CHECK_OK(player.run_to(back.end_tick));
+    const size_t order[] = { 5, 0, 10, 3, 4, 2, 7, 6, 1, 9, 8, 10, 0 };
+    bool seeks_ok = true;
+    for (size_t i : order) {
+        uint64_t h = 0;
+        ax_result r = player.seek(probes[i]);
+        seeks_ok = seeks_ok && r == AX_OK && player.tick() == probes[i] &&
+                   ax_get_state_hash(b, &h) == AX_OK && h == probe_hash[i];
+        if (!seeks_ok) {
+            printf("    seek to %llu: %s\n", (unsigned long long)probes[i], result_str(r));
+            break;
+        }
+    }
+    CHECK(seeks_ok, "every seek should land on the recorded hash");
+    CHECK_OK(player.seek(UINT64_MAX));
+    CHECK(player.done(), "seek past the end should clamp to the end");
+
+    /* without keyframes a fresh-content recording only seeks forward */
+    ax_destroy(a);
+    a = create_and_load("content/");
+    ax_core* c = create_and_load("content/");
+    CHECK(a != nullptr && c != nullptr, "core creation failed");
+    if (!a || !c) return;
+    CHECK(rec.begin(a, false, 0), "recorder should start");
+    CHECK_OK(rec.step_ticks(100));
+    CHECK(rec.finish(&data), "recorder should finish");
+    CHECK(data.keyframes.empty(), "interval 0 should record no keyframes");
+    replay_player p2(data);
+    CHECK(p2.start(c, &error), "player start failed: %s", error.c_str());
+    CHECK_OK(p2.seek(60));
+    CHECK_ERR(p2.seek(30), AX_ERR_BAD_STATE);
+    CHECK(p2.tick() == 60, "failed seek should leave the core where it was");
+
+    /* version 1 files (no seek index) still read */
+    replay_encode(data, &bytes);
+    bytes[4] = 1;
+    bytes.resize(bytes.size() - 4);
+    CHECK(replay_decode(bytes.data(), bytes.size(), &back, &error), "v1 decode failed: %s", error.c_str());
+    CHECK(back.end_tick == 100 && back.keyframes.empty(), "v1 fields");
+
+    ax_destroy(a);
+    ax_destroy(b);
+    ax_destroy(c);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: determinism verifier
+ * Lanes with different worker counts (and the shared-library core, when
+ * built) agree on every checkpoint; an injected fault is bisected to
+ * the exact tick it first changes the state
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void test_determinism_verifier(void) {
+    printf("test_determinism_verifier\n");
+
+    ax_core* a = create_and_load("content/");
+    CHECK(a != nullptr, "core creation failed");
+    if (!a) return;
+
+    replay_recorder rec;
+    CHECK(rec.begin(a, false, 200), "recorder should start");
+    bool session_ok = true;
+    for (uint32_t t = 0; t < 600; ++t) {
+        ax_action_v1 act = {};
+        act.tick     = rec.tick() + 1 + (t % 11 == 0 ? 90 : 0);
+        act.actor_id = 1;
+        if (t % 3 == 0) {
+            act.type     = AX_ACT_MOVE_INTENT;
+            act.u.move.x = (float)(t % 7) * 0.25f - 0.75f;
+            act.u.move.y = 0.5f;
+        } else {
+            act.type = t % 83 == 0 ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+        }
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = 1;
+        batch.actions    = &act;
+        session_ok = session_ok && rec.submit_actions(&batch) == AX_OK && rec.step_ticks(1) == AX_OK;
+    }
+    CHECK(session_ok, "scripted session failed: %s", ax_get_last_error());
+    replay_data data;
+    CHECK(rec.finish(&data), "recorder should finish");
+    ax_destroy(a);
+
+    /* restore() puts back the queued actions a lane's own save lacks */
+    ax_core* b = create_and_load("content/");
+    CHECK(b != nullptr, "core creation failed");
+    if (!b) return;
+    replay_player player(data);
+    std::string start_error;
+    CHECK(player.start(b, &start_error), "player start failed: %s", start_error.c_str());
+    CHECK_OK(player.run_to(250));
+    std::vector<uint8_t> save = take_save(b);
+    uint64_t h_run = 0, h_restored = 0;
+    CHECK_OK(player.run_to(420));
+    CHECK_OK(ax_get_state_hash(b, &h_run));
+    CHECK_OK(player.restore(save.data(), (uint32_t)save.size(), 250));
+    CHECK(player.tick() == 250, "restore should rewind the player");
+    CHECK_OK(player.run_to(420));
+    CHECK_OK(ax_get_state_hash(b, &h_restored));
+    CHECK(h_run == h_restored, "a restored lane should replay the same ticks");
+    CHECK_ERR(player.restore(save.data(), (uint32_t)save.size(), 601), AX_ERR_INVALID_ARG);
+    ax_destroy(b);
+
+    std::vector<verify_lane> lanes = {
+        { core_api_linked(), 1, VERIFY_NO_FAULT },
+        { core_api_linked(), 4, VERIFY_NO_FAULT },
+    };
+#ifdef AX_SHARED_CORE_PATH
+    std::string error;
+    const core_api* shared = core_api_load(AX_SHARED_CORE_PATH, &error);
+    CHECK(shared != nullptr, "shared core should load: %s", error.c_str());
+    if (shared) {
+        lanes.push_back({ shared, 2, VERIFY_NO_FAULT });
+    }
+#else
+    std::string error;
+#endif
+    CHECK(core_api_load("no/such/libaxiom_core.so", &error) == nullptr && !error.empty(),
+          "a missing library should fail to load");
+
+    verify_params params = { "content/", 50, nullptr };
+    verify_result res;
+    CHECK(verify_replay(data, lanes, params, &res, &error), "verify failed: %s", error.c_str());
+    CHECK(!res.diverged && res.checkpoints == 13, "lanes should agree on 13 checkpoints");
+    CHECK(res.final_hash == data.final_hash, "lanes should end on the recorded hash");
+
+    /* a fault inside a checkpoint interval and one just before a checkpoint */
+    const uint64_t faults[] = { 317, 299 };
+    for (uint64_t f : faults) {
+        std::vector<verify_lane> faulty = lanes;
+        faulty.back().fault_tick = f;
+        CHECK(verify_replay(data, faulty, params, &res, &error), "verify failed: %s", error.c_str());
+        CHECK(res.diverged && res.lane == faulty.size() - 1 && res.first_tick == f + 1,
+              "fault at %llu should diverge at %llu, got %llu", (unsigned long long)f,
+              (unsigned long long)(f + 1), (unsigned long long)res.first_tick);
+        CHECK(res.hash_ref != res.hash_lane && res.field_mismatches > 0,
+              "the divergent snapshots should differ field by field");
+    }
+
+    /* per-tick checkpoints need no bisection */
+    params.stride = 1;
+    lanes[1].fault_tick = 5;
+    CHECK(verify_replay(data, lanes, params, &res, &error), "verify failed: %s", error.c_str());
+    CHECK(res.diverged && res.lane == 1 && res.first_tick == 6 && res.checkpoints == 7,
+          "stride 1 should stop at the first divergent tick");
+
+    lanes.resize(1);
+    CHECK(!verify_replay(data, lanes, params, &res, &error), "one lane should be rejected");
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: deterministic RNG
+ * Philox4x32-10 known answers, batch draws equal single draws, basic
+ * statistical quality, and the world seed in the state hash and saves
+ * ══════════════════════════════════════════════════════════════════ */
+
+static ax_rng_request_v1 rng_request(uint32_t system_id, uint64_t tick, uint32_t first_draw,
+                                     uint32_t draws, const uint32_t* ids, uint32_t count) {
+    ax_rng_request_v1 req = {};
+    req.version          = 1;
+    req.size_bytes       = sizeof(req);
+    req.system_id        = system_id;
+    req.first_draw       = first_draw;
+    req.tick             = tick;
+    req.draws_per_entity = draws;
+    req.entity_count     = count;
+    req.entity_ids       = ids;
+    return req;
+}
+
+static void test_rng(void) {
+    printf("test_rng\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    uint64_t seed = 1;
+    CHECK_OK(ax_get_rng_seed(core, &seed));
+    CHECK(seed == 0, "the world seed should start at 0");
+
+    /*
+     * Random123 known-answer vectors: the counter is { entity, block <<
+     * 16 | system, tick lo, tick hi } and the key is the seed.
+     */
+    struct kat { uint64_t seed; uint32_t entity, system, block; uint64_t tick; uint32_t words[4]; };
+    const kat kats[] = {
+        { 0, 0, 0, 0, 0, { 0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8 } },
+        { ~0ull, ~0u, 0xFFFF, 0xFFFF, ~0ull, { 0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD } },
+        { 0x299F31D0A4093822ull, 0x243F6A88, 0x08D3, 0x85A3, 0x0370734413198A2Eull,
+          { 0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1 } },
+    };
+    for (const kat& k : kats) {
+        uint32_t words[4] = {};
+        ax_rng_request_v1 req = rng_request(k.system, k.tick, k.block * 4, 4, &k.entity, 1);
+        CHECK_OK(ax_set_rng_seed(core, k.seed));
+        CHECK_OK(ax_rng_generate(core, &req, words));
+        CHECK(memcmp(words, k.words, sizeof(words)) == 0,
+              "Philox4x32-10 mismatch: %08X %08X %08X %08X", words[0], words[1], words[2], words[3]);
+    }
+
+    /* batch draws are the single draws, whatever the batch size or offset */
+    CHECK_OK(ax_set_rng_seed(core, 0xA5A5F00Dull));
+    const uint32_t N = 4096, D = 256;
+    std::vector<uint32_t> ids(N);
+    for (uint32_t i = 0; i < N; ++i) {
+        ids[i] = 0x00010000u + i * 3;       /* entity-id-like, not contiguous */
+    }
+    std::vector<uint32_t> words((size_t)N * D);
+    ax_rng_request_v1 req = rng_request(7, 1234, 0, D, ids.data(), N);
+    CHECK_OK(ax_rng_generate(core, &req, words.data()));
+    bool same = true;
+    const uint32_t probes[][3] = { { 0, 0, 1 }, { 17, 3, 6 }, { 4095, 250, 6 }, { 1000, 1, 255 } };
+    for (const auto& pr : probes) {
+        uint32_t one[256];
+        ax_rng_request_v1 single = rng_request(7, 1234, pr[1], pr[2], &ids[pr[0]], 1);
+        same = same && ax_rng_generate(core, &single, one) == AX_OK &&
+               memcmp(one, &words[(size_t)pr[0] * D + pr[1]], pr[2] * sizeof(uint32_t)) == 0;
+    }
+    std::vector<uint32_t> split((size_t)13 * 4);
+    ax_rng_request_v1 part = rng_request(7, 1234, 0, 4, &ids[100], 13);
+    same = same && ax_rng_generate(core, &part, split.data()) == AX_OK;
+    for (uint32_t i = 0; same && i < 13; ++i) {
+        same = memcmp(&split[i * 4], &words[(size_t)(100 + i) * D], 4 * sizeof(uint32_t)) == 0;
+    }
+    CHECK(same, "batched and single draws should agree");
+
+    /*
+     * 1M words: byte histogram (chi-square, 255 dof), per-bit balance,
+     * and the correlation of neighbouring entities' first draws. The
+     * inputs are fixed, so the bounds are checks, not flaky samples.
+     */
+    uint32_t hist[256] = {};
+    uint32_t bits[32]  = {};
+    for (uint32_t w : words) {
+        hist[w >> 24]++;
+        for (int b = 0; b < 32; ++b) bits[b] += (w >> b) & 1u;
+    }
+    double expected = (double)words.size() / 256.0, chi2 = 0.0;
+    for (uint32_t h : hist) chi2 += (h - expected) * (h - expected) / expected;
+    CHECK(chi2 > 180.0 && chi2 < 340.0, "byte chi-square %.1f outside [180, 340]", chi2);
+    bool balanced = true;
+    for (uint32_t b : bits) {
+        double f = (double)b / (double)words.size();
+        balanced = balanced && f > 0.498 && f < 0.502;
+    }
+    CHECK(balanced, "every bit should be set about half the time");
+    double sx = 0, sy = 0, sxy = 0, sxx = 0, syy = 0;
+    for (uint32_t i = 0; i + 1 < N; ++i) {
+        double x = words[(size_t)i * D] / 4294967296.0, y = words[(size_t)(i + 1) * D] / 4294967296.0;
+        sx += x; sy += y; sxy += x * y; sxx += x * x; syy += y * y;
+    }
+    double n = N - 1;
+    double corr = (sxy - sx * sy / n) / std::sqrt((sxx - sx * sx / n) * (syy - sy * sy / n));
+    CHECK(std::fabs(corr) < 0.05, "neighbouring entities correlate (%.4f)", corr);
+
+    /* every input moves the output: seed, system, tick, entity, draw */
+    uint32_t base = words[0], w = 0;
+    uint32_t other_id = ids[0] + 1;
+    ax_rng_request_v1 r1 = rng_request(8, 1234, 0, 1, &ids[0], 1);
+    ax_rng_request_v1 r2 = rng_request(7, 1235, 0, 1, &ids[0], 1);
+    ax_rng_request_v1 r3 = rng_request(7, 1234, 0, 1, &other_id, 1);
+    ax_rng_request_v1 r4 = rng_request(7, 1234, 4, 1, &ids[0], 1);
+    bool moved = true;
+    for (const ax_rng_request_v1* r : { &r1, &r2, &r3, &r4 }) {
+        moved = moved && ax_rng_generate(core, r, &w) == AX_OK && w != base;
+    }
+    CHECK_OK(ax_set_rng_seed(core, 0xA5A5F00Eull));
+    ax_rng_request_v1 r0 = rng_request(7, 1234, 0, 1, &ids[0], 1);
+    moved = moved && ax_rng_generate(core, &r0, &w) == AX_OK && w != base;
+    CHECK(moved, "changing any part of the counter or key should change the draw");
+
+    /* invalid requests */
+    ax_rng_request_v1 bad = rng_request(AX_RNG_MAX_SYSTEMS, 0, 0, 1, ids.data(), 1);
+    CHECK_ERR(ax_rng_generate(core, &bad, &w), AX_ERR_INVALID_ARG);
+    bad = rng_request(AX_RNG_SYSTEM_USER, 0, AX_RNG_MAX_DRAWS - 1, 2, ids.data(), 1);
+    CHECK_ERR(ax_rng_generate(core, &bad, &w), AX_ERR_INVALID_ARG);
+    bad = rng_request(AX_RNG_SYSTEM_USER, 0, 0, 1, nullptr, 1);
+    CHECK_ERR(ax_rng_generate(core, &bad, &w), AX_ERR_INVALID_ARG);
+    bad = rng_request(AX_RNG_SYSTEM_USER, 0, 0, 1, ids.data(), 1);
+    bad.version = 2;
+    CHECK_ERR(ax_rng_generate(core, &bad, &w), AX_ERR_UNSUPPORTED);
+    CHECK_ERR(ax_get_rng_seed(core, nullptr), AX_ERR_INVALID_ARG);
+
+    /* the seed is world state: hashed, saved and restored */
+    uint64_t h42 = 0, h7 = 0;
+    CHECK_OK(ax_set_rng_seed(core, 42));
+    CHECK_OK(ax_get_state_hash(core, &h42));
+    std::vector<uint8_t> save = take_save(core);
+    CHECK_OK(ax_set_rng_seed(core, 7));
+    CHECK_OK(ax_get_state_hash(core, &h7));
+    CHECK(h7 != h42, "the state hash should cover the world seed");
+    CHECK_OK(ax_load_save_bytes(core, save.data(), (uint32_t)save.size()));
+    CHECK_OK(ax_get_rng_seed(core, &seed));
+    CHECK_OK(ax_get_state_hash(core, &h7));
+    CHECK(seed == 42 && h7 == h42, "a save should restore the world seed");
+
+    /* saves from before 1.3 have no seed and load with 0 */
+    uint16_t minor = 2;
+    memcpy(save.data() + 6, &minor, 2);
+    reseal_save(save);
+    CHECK_OK(ax_load_save_bytes(core, save.data(), (uint32_t)save.size()));
+    CHECK_OK(ax_get_rng_seed(core, &seed));
+    CHECK(seed == 0, "a 1.2 save should load with seed 0");
+
+    ax_destroy(core);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: static collision
+ * OBJ import, mesh validation, BVH closest hits against brute force,
+ * identical hits across packet widths and build threading, the mesh in
+ * the content hash, and shots blocked by level geometry
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* the firing range (meshes/range.obj): a floor and a wall before target 100 */
+static const char* const RANGE_OBJ =
+    "# floor\n"
+    "v -20 0  10\nv  20 0  10\nv  20 0 -30\nv -20 0 -30\n"
+    "f 1 2 3 4\n"
+    "# wall\n"
+    "v -1 0 -4.75\nv 1 0 -4.75\nv 1 3 -4.75\nv -1 3 -4.75\n"
+    "v -1 0 -5.25\nv 1 0 -5.25\nv 1 3 -5.25\nv -1 3 -5.25\n"
+    "f 5 6 7 8\nf 10 9 12 11\nf 9 5 8 12\nf 6 10 11 7\nf 8 7 11 12\nf 9 10 6 5\n";
+
+static ax_ray_hit_v1 brute_force_hit(const mesh_data& mesh, const ax_ray_v1& r) {
+    ax_ray_hit_v1 best = {};
+    best.t        = r.max_t;
+    best.triangle = AX_RAY_NO_HIT;
+    for (uint32_t i = 0; i < mesh.triangle_count(); ++i) {
+        const float* a = &mesh.vertices[mesh.indices[i * 3 + 0] * 3];
+        const float* b = &mesh.vertices[mesh.indices[i * 3 + 1] * 3];
+        const float* c = &mesh.vertices[mesh.indices[i * 3 + 2] * 3];
+        float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        float px  = r.dy * e2[2] - r.dz * e2[1];
+        float py  = r.dz * e2[0] - r.dx * e2[2];
+        float pz  = r.dx * e2[1] - r.dy * e2[0];
+        float det = e1[0] * px + e1[1] * py + e1[2] * pz;
+        if (det == 0.0f) continue;
+        float inv = 1.0f / det;
+        float sx = r.ox - a[0], sy = r.oy - a[1], sz = r.oz - a[2];
+        float u  = (sx * px + sy * py + sz * pz) * inv;
+        float qx = sy * e1[2] - sz * e1[1];
+        float qy = sz * e1[0] - sx * e1[2];
+        float qz = sx * e1[1] - sy * e1[0];
+        float v  = (r.dx * qx + r.dy * qy + r.dz * qz) * inv;
+        float t  = (e2[0] * qx + e2[1] * qy + e2[2] * qz) * inv;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t <= best.t &&
+            (t < best.t || i < best.triangle)) {
+            best.t        = t;
+            best.triangle = i;
+        }
+    }
+    return best;
+}
+
+static ax_result raycast(ax_core* core, uint32_t width, uint32_t flags,
+                         const std::vector<ax_ray_v1>& rays, std::vector<ax_ray_hit_v1>* hits) {
+    ax_raycast_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.packet_width = width;
+    p.flags        = flags;
+    hits->assign(rays.size(), ax_ray_hit_v1{});
+    return ax_raycast(core, &p, rays.data(), (uint32_t)rays.size(), hits->data());
+}
+
+static ax_collision_info_v1 collision_info(ax_core* core) {
+    ax_collision_info_v1 info = {};
+    info.version    = 1;
+    info.size_bytes = sizeof(info);
+    if (ax_get_collision_info(core, &info) != AX_OK) {
+        info.triangle_count = UINT32_MAX;
+    }
+    return info;
+}
+
+static bool shot_hits(ax_core* core, uint64_t tick) {
+    ax_action_v1 fire = {};
+    fire.tick     = tick;
+    fire.actor_id = 1;
+    fire.type     = AX_ACT_FIRE_ONCE;
+    submit_action(core, fire);
+    ax_step_ticks(core, 1);
+    return has_event(core, AX_EVT_DAMAGE_DEALT);
+}
+
+static void test_collision(void) {
+    printf("test_collision\n");
+
+    /* ── OBJ import ───────────────────────────────────────────────── */
+    mesh_data range;
+    std::string error;
+    CHECK(mesh_parse_obj(RANGE_OBJ, &range, &error), "range mesh: %s", error.c_str());
+    CHECK(range.vertex_count() == 12 && range.triangle_count() == 14,
+          "range mesh: %u vertices, %u triangles", range.vertex_count(), range.triangle_count());
+
+    mesh_data quad;
+    CHECK(mesh_parse_obj("v 0 0 0\nv 1 0 0\nv 1 0 1\nv 0 0 1\nvn 0 1 0\nvt 0 0\n"
+                         "g ground\nf 1/1/1 2//1 -2/1 -1\n", &quad, &error),
+          "quad: %s", error.c_str());
+    const uint32_t fan[6] = { 0, 1, 2, 0, 2, 3 };
+    CHECK(quad.indices.size() == 6 && memcmp(quad.indices.data(), fan, sizeof(fan)) == 0,
+          "a quad with a/t/n and negative indices should fan into (0 1 2) (0 2 3)");
+
+    mesh_data bad;
+    CHECK(!mesh_parse_obj("v 0 0 0\nv 1 0 0\n\nf 1 2 3\n", &bad, &error) &&
+          error == "line 4: bad face index", "out-of-range index: '%s'", error.c_str());
+    CHECK(!mesh_parse_obj("v 0 0\n", &bad, &error) && error == "line 1: bad vertex",
+          "short vertex: '%s'", error.c_str());
+    CHECK(!mesh_parse_obj("v 0 0 0\nv 1 0 0\nf 1 2\n", &bad, &error),
+          "a two-vertex face should be rejected");
+
+    /* ── Validation ───────────────────────────────────────────────── */
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+
+    uint64_t content_hash = 0, with_mesh = 0, after = 0;
+    CHECK_OK(ax_get_content_hash(core, &content_hash));
+    CHECK(collision_info(core).triangle_count == 0, "no mesh until one is loaded");
+
+    ax_collision_mesh_v1 m = {};
+    m.version        = 1;
+    m.size_bytes     = sizeof(m);
+    m.vertex_count   = range.vertex_count();
+    m.triangle_count = range.triangle_count();
+    m.vertices       = range.vertices.data();
+    m.indices        = range.indices.data();
+    CHECK_ERR(ax_load_collision_mesh(core, nullptr), AX_ERR_INVALID_ARG);
+    m.version = 2;
+    CHECK_ERR(ax_load_collision_mesh(core, &m), AX_ERR_UNSUPPORTED);
+    m.version = 1;
+    CHECK_OK(ax_load_collision_mesh(core, &m));
+
+    ax_collision_info_v1 info = collision_info(core);
+    CHECK(info.triangle_count == 14 && info.node_count >= 3 && info.leaf_count >= 2 &&
+          info.depth >= 2 && info.memory_bytes > 0,
+          "range info: %u triangles, %u nodes, %u leaves, depth %u", info.triangle_count,
+          info.node_count, info.leaf_count, info.depth);
+    CHECK_OK(ax_get_content_hash(core, &with_mesh));
+    CHECK(with_mesh != content_hash, "the content hash should cover the collision mesh");
+
+    /* a bad mesh is rejected and the previous one kept */
+    std::vector<uint32_t> bad_indices = range.indices;
+    bad_indices[5] = range.vertex_count();
+    m.indices = bad_indices.data();
+    CHECK_ERR(ax_load_collision_mesh(core, &m), AX_ERR_INVALID_ARG);
+    std::vector<float> bad_vertices = range.vertices;
+    bad_vertices[4] = NAN;
+    m.indices  = range.indices.data();
+    m.vertices = bad_vertices.data();
+    CHECK_ERR(ax_load_collision_mesh(core, &m), AX_ERR_INVALID_ARG);
+    m.vertices = range.vertices.data();
+    CHECK(collision_info(core).mesh_hash == info.mesh_hash, "a rejected mesh should keep the old one");
+
+    /* ── Queries ──────────────────────────────────────────────────── */
+    std::vector<ax_ray_v1> rays(3);
+    rays[0] = { 3.0f, 5.0f, 3.0f, 0.0f, -1.0f, 0.0f, 100.0f };    /* down onto the floor */
+    rays[1] = { 0.0f, 1.6f, 0.0f, 0.0f, 0.0f, -10.0f, 1.0f };     /* into the wall       */
+    rays[2] = { 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 100.0f };     /* up, into the sky    */
+    std::vector<ax_ray_hit_v1> hits;
+    CHECK_OK(raycast(core, 1, 0, rays, &hits));
+    CHECK(hits[0].triangle < 2 && hits[0].t == 5.0f && hits[0].ny == 1.0f,
+          "floor: triangle %u, t %f, n.y %f", hits[0].triangle, hits[0].t, hits[0].ny);
+    CHECK(hits[1].triangle >= 2 && hits[1].triangle < 4 && std::fabs(hits[1].t - 0.475f) < 1e-6f &&
+          hits[1].nz == 1.0f, "wall: triangle %u, t %f", hits[1].triangle, hits[1].t);
+    CHECK(hits[2].triangle == AX_RAY_NO_HIT && hits[2].t == 100.0f, "sky ray should miss");
+
+    ax_raycast_params_v1 rp = {};
+    rp.version    = 1;
+    rp.size_bytes = sizeof(rp);
+    rp.packet_width = 3;
+    CHECK_ERR(ax_raycast(core, &rp, rays.data(), 3, hits.data()), AX_ERR_INVALID_ARG);
+    rp.packet_width = 4;
+    rp.flags        = 0x8;
+    CHECK_ERR(ax_raycast(core, &rp, rays.data(), 3, hits.data()), AX_ERR_INVALID_ARG);
+    rp.flags = 0;
+    CHECK_ERR(ax_raycast(core, &rp, nullptr, 3, hits.data()), AX_ERR_INVALID_ARG);
+    rays[2].max_t = -1.0f;
+    CHECK_ERR(ax_raycast(core, &rp, rays.data(), 3, hits.data()), AX_ERR_INVALID_ARG);
+    rays[2].max_t = 100.0f;
+    rays[2].dx = INFINITY;
+    CHECK_ERR(ax_raycast(core, &rp, rays.data(), 3, hits.data()), AX_ERR_INVALID_ARG);
+    rays[2].dx = 0.0f;
+
+    /* ── Shots blocked by geometry ────────────────────────────────── */
+    uint64_t tick = 0;
+    CHECK(!shot_hits(core, ++tick), "the wall should block the shot at target 100");
+    for (uint32_t i = 0; i < 25; ++i) {
+        ax_action_v1 move = {};
+        move.tick     = ++tick;
+        move.actor_id = 1;
+        move.type     = AX_ACT_MOVE_INTENT;
+        move.u.move.x = 1.0f;
+        submit_action(core, move);
+        ax_step_ticks(core, 1);
+    }
+    CHECK(shot_hits(core, ++tick), "2.5 m to the side the shot should clear the wall");
+
+    /* a tick's moves apply before its shots, even ones submitted after them (D127) */
+    for (float side : { -1.0f, 1.0f }) {
+        ax_action_v1 fire = {};
+        fire.tick     = ++tick;
+        fire.actor_id = 1;
+        fire.type     = AX_ACT_FIRE_ONCE;
+        submit_action(core, fire);
+        for (uint32_t i = 0; i < 25; ++i) {
+            ax_action_v1 move = {};
+            move.tick     = tick;
+            move.actor_id = 1;
+            move.type     = AX_ACT_MOVE_INTENT;
+            move.u.move.x = side;
+            submit_action(core, move);
+        }
+        ax_step_ticks(core, 1);
+        CHECK(has_event(core, AX_EVT_DAMAGE_DEALT) == (side > 0.0f),
+              "a shot should see its tick's moves (moving %s)", side > 0.0f ? "out" : "back");
+    }
+
+    /* ── BVH against brute force on a generated level ─────────────── */
+    mesh_data level;
+    mesh_make_level(96, 192.0f, 7, &level);
+    CHECK(level.triangle_count() == 2 * 96 * 96 + 12 * (96 * 96 / 64),
+          "level: %u triangles", level.triangle_count());
+    CHECK_OK(mesh_upload(core, level));
+    info = collision_info(core);
+    CHECK(info.triangle_count == level.triangle_count() && info.depth <= 64,
+          "level info: %u triangles, depth %u", info.triangle_count, info.depth);
+
+    std::vector<ax_ray_v1> random_rays, camera_rays;
+    raycast_bench_random_rays(level, 4096, 3, &random_rays);
+    raycast_bench_camera_rays(level, 4096, &camera_rays);
+
+    std::vector<ax_ray_hit_v1> ref;
+    CHECK_OK(raycast(core, 1, 0, random_rays, &ref));
+    bool matches = true;
+    uint32_t n_hits = 0;
+    for (size_t i = 0; i < random_rays.size(); ++i) {
+        ax_ray_hit_v1 b = brute_force_hit(level, random_rays[i]);
+        matches = matches && b.triangle == ref[i].triangle && b.t == ref[i].t;
+        n_hits += b.triangle != AX_RAY_NO_HIT;
+    }
+    CHECK(matches, "closest hits should match a brute-force search");
+    CHECK(n_hits > 400 && n_hits < 4000, "random rays should hit sometimes (%u of 4096)", n_hits);
+
+    /* every packet width finds the same closest hits; any-hit agrees on hit or miss */
+    for (const std::vector<ax_ray_v1>* set : { &random_rays, &camera_rays }) {
+        std::vector<ax_ray_hit_v1> one, packet;
+        CHECK_OK(raycast(core, 1, 0, *set, &one));
+        bool same = true, same_any = true;
+        for (uint32_t width : { 4u, 8u, 0u }) {
+            CHECK_OK(raycast(core, width, 0, *set, &packet));
+            same = same && memcmp(packet.data(), one.data(), one.size() * sizeof(one[0])) == 0;
+        }
+        for (uint32_t width : { 1u, 4u, 8u }) {
+            CHECK_OK(raycast(core, width, AX_RAYCAST_ANY_HIT, *set, &packet));
+            for (size_t i = 0; i < one.size(); ++i) {
+                same_any = same_any && (packet[i].triangle == AX_RAY_NO_HIT) ==
+                                       (one[i].triangle == AX_RAY_NO_HIT) &&
+                           packet[i].t >= one[i].t;
+            }
+        }
+        CHECK(same, "packet widths should give bit-identical closest hits");
+        CHECK(same_any, "any-hit rays should agree with closest-hit rays on hit or miss");
+    }
+
+    /* the tree does not depend on how many workers built it */
+    CHECK(set_threading(core, 4, 1), "set_threading(4) failed");
+    CHECK_OK(mesh_upload(core, level));
+    ax_collision_info_v1 threaded = collision_info(core);
+    std::vector<ax_ray_hit_v1> threaded_hits;
+    CHECK_OK(raycast(core, 8, 0, random_rays, &threaded_hits));
+    CHECK(threaded.node_count == info.node_count && threaded.leaf_count == info.leaf_count &&
+          threaded.depth == info.depth && threaded.mesh_hash == info.mesh_hash,
+          "threaded build should match: %u/%u nodes", threaded.node_count, info.node_count);
+    CHECK(memcmp(threaded_hits.data(), ref.data(), ref.size() * sizeof(ref[0])) == 0,
+          "threaded build should give identical hits");
+
+    ax_memory_stats_v1 mem = {};
+    CHECK_OK(ax_get_memory_stats(core, &mem));
+    CHECK(mem.subsystems[AX_MEM_COLLISION].used_bytes >= info.memory_bytes,
+          "collision memory %llu < %llu", (unsigned long long)mem.subsystems[AX_MEM_COLLISION].used_bytes,
+          (unsigned long long)info.memory_bytes);
+
+    /* removing the mesh restores the content hash; unloading content drops it */
+    m.triangle_count = 0;
+    CHECK_OK(ax_load_collision_mesh(core, &m));
+    CHECK_OK(ax_get_content_hash(core, &after));
+    CHECK(after == content_hash, "removing the mesh should restore the content hash");
+    CHECK_OK(mesh_upload(core, range));
+    ax_unload_content(core);
+    CHECK_ERR(ax_load_collision_mesh(core, &m), AX_ERR_BAD_STATE);
+    CHECK_OK(raycast(core, 8, 0, rays, &hits));
+    CHECK(hits[0].triangle == AX_RAY_NO_HIT, "unloading content should drop the mesh");
+
+    ax_destroy(core);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: character controller
+ * MOVE_INTENT through the capsule controller on a collision mesh: walls
+ * stop and slide, low ledges are stepped onto and high ones are not,
+ * gentle ramps are walked and steep ones are not, actors settle onto
+ * the floor; targets can be driven, dead ones cannot; results do not
+ * depend on workers, save/load or the per-actor caches
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void add_box(mesh_data* mesh, float x0, float y0, float z0, float x1, float y1, float z1) {
+    static const uint32_t FACES[12][3] = {
+        { 0, 1, 2 }, { 0, 2, 3 }, { 4, 6, 5 }, { 4, 7, 6 },
+        { 0, 5, 1 }, { 0, 4, 5 }, { 1, 6, 2 }, { 1, 5, 6 },
+        { 2, 7, 3 }, { 2, 6, 7 }, { 3, 4, 0 }, { 3, 7, 4 },
+    };
+    uint32_t base = mesh->vertex_count();
+    mesh->vertices.insert(mesh->vertices.end(), {
+        x0, y0, z0,  x1, y0, z0,  x1, y0, z1,  x0, y0, z1,
+        x0, y1, z0,  x1, y1, z0,  x1, y1, z1,  x0, y1, z1 });
+    for (const auto& f : FACES) {
+        mesh->indices.insert(mesh->indices.end(), { base + f[0], base + f[1], base + f[2] });
+    }
+}
+
+/* a ramp rising along +x from (x0, 0) to (x1, y1), z0..z1 */
+static void add_ramp(mesh_data* mesh, float x0, float x1, float y1, float z0, float z1) {
+    uint32_t base = mesh->vertex_count();
+    mesh->vertices.insert(mesh->vertices.end(), {
+        x0, 0.0f, z0,  x0, 0.0f, z1,  x1, y1, z1,  x1, y1, z0 });
+    mesh->indices.insert(mesh->indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+}
+
+static uint32_t spawn_actor(ax_core* core, float x, float y, float z) {
+    ax_debug_spawn_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.archetype_id = 2000;
+    p.hp           = 50;
+    p.px = x;  p.py = y;  p.pz = z;
+
+    uint32_t id = 0;
+    return ax_debug_spawn_target(core, &p, &id) == AX_OK ? id : 0;
+}
+
+static ax_snapshot_entity_v1 entity_state(ax_core* core, uint32_t id) {
+    auto buf = take_snapshot(core);
+    parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+    for (uint32_t i = 0; snap.header && i < snap.header->entity_count; ++i) {
+        if (snap.entities[i].id == id) return snap.entities[i];
+    }
+    ax_snapshot_entity_v1 none = {};
+    return none;
+}
+
+/* every actor walks (x, y) for `ticks` ticks */
+static void walk(ax_core* core, uint64_t* tick, const std::vector<uint32_t>& actors,
+                 float x, float y, uint32_t ticks) {
+    for (uint32_t t = 0; t < ticks; ++t) {
+        ++*tick;
+        for (uint32_t id : actors) {
+            ax_action_v1 move = {};
+            move.tick     = *tick;
+            move.actor_id = id;
+            move.type     = AX_ACT_MOVE_INTENT;
+            move.u.move.x = x;
+            move.u.move.y = y;
+            submit_action(core, move);
+        }
+        ax_step_ticks(core, 1);
+    }
+}
+
+/* seeded random walks, a different direction per actor and tick */
+static void wander(ax_core* core, uint64_t* tick, const std::vector<uint32_t>& actors, uint32_t ticks) {
+    for (uint32_t t = 0; t < ticks; ++t) {
+        ++*tick;
+        for (uint32_t id : actors) {
+            uint32_t h = (uint32_t)(*tick / 8) * 2654435761u ^ id * 40503u;
+            h ^= h >> 15;
+            h *= 2246822519u;
+            ax_action_v1 move = {};
+            move.tick     = *tick;
+            move.actor_id = id;
+            move.type     = AX_ACT_MOVE_INTENT;
+            move.u.move.x = (float)(h & 0xFF) / 127.5f - 1.0f;
+            move.u.move.y = (float)(h >> 24) / 127.5f - 1.0f;
+            submit_action(core, move);
+        }
+        ax_step_ticks(core, 1);
+    }
+}
+
+static void test_character(void) {
+    printf("test_character\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+    uint64_t tick = 0;
+
+    /* without a mesh: the flat-plane stub, now for targets as well */
+    for (uint32_t i = 0; i < 5; ++i) {
+        CHECK(shot_hits(core, ++tick), "shot %u should hit target 100", i);
+    }
+    CHECK(entity_state(core, 100).state_flags & AX_ENT_FLAG_DEAD, "target 100 should be dead");
+    uint32_t lifted = spawn_actor(core, 30.0f, 2.0f, 0.0f);
+    walk(core, &tick, { 1, lifted }, 1.0f, 0.0f, 10);
+    ax_snapshot_entity_v1 p = entity_state(core, 1), l = entity_state(core, lifted);
+    CHECK(std::fabs(p.px - 1.0f) < 1e-5f && p.py == 0.0f, "player: (%f, %f)", p.px, p.py);
+    CHECK(std::fabs(l.px - 31.0f) < 1e-4f && l.py == 0.0f, "target: (%f, %f)", l.px, l.py);
+
+    /* the course: a floor with a wall, two ledges, two ramps */
+    mesh_data course;
+    std::string error;
+    CHECK(mesh_parse_obj("v -60 0 60\nv 60 0 60\nv 60 0 -60\nv -60 0 -60\nf 1 2 3 4\n",
+                         &course, &error), "floor: %s", error.c_str());
+    add_box(&course, 2.0f, 0.0f, -20.0f, 3.0f, 3.0f, -4.0f);      /* wall         */
+    add_box(&course, 2.0f, 0.0f, 10.0f, 6.0f, 0.3f, 14.0f);       /* 0.3 m ledge  */
+    add_box(&course, 2.0f, 0.0f, 20.0f, 6.0f, 0.5f, 24.0f);       /* 0.5 m ledge  */
+    add_ramp(&course, 2.0f, 12.0f, 2.0f, 30.0f, 34.0f);           /* 11 degrees   */
+    add_ramp(&course, 2.0f, 3.0f, 3.0f, 40.0f, 44.0f);            /* 72 degrees   */
+    CHECK_OK(mesh_upload(core, course));
+
+    uint32_t wall   = spawn_actor(core, 0.0f, 0.0f, -16.0f);
+    uint32_t low    = spawn_actor(core, 0.0f, 0.0f, 12.0f);
+    uint32_t high   = spawn_actor(core, 0.0f, 0.0f, 22.0f);
+    uint32_t gentle = spawn_actor(core, 0.0f, 0.0f, 32.0f);
+    uint32_t steep  = spawn_actor(core, 0.0f, 0.0f, 42.0f);
+    uint32_t faller = spawn_actor(core, 20.0f, 3.0f, 0.0f);
+    CHECK(wall && low && high && gentle && steep && faller, "spawns failed");
+    const float STOP = 2.0f - AX_CHARACTER_RADIUS_M;
+
+    ax_snapshot_entity_v1 dead = entity_state(core, 100);
+    walk(core, &tick, { wall, 100 }, 1.0f, 1.0f, 40);
+    ax_snapshot_entity_v1 w = entity_state(core, wall), still = entity_state(core, 100);
+    CHECK(w.px < STOP && w.px > STOP - 0.05f && std::fabs(w.py) < 0.02f,
+          "the wall should stop the actor at x %f, got (%f, %f)", STOP, w.px, w.py);
+    CHECK(w.pz > -16.0f + 2.5f, "the actor should slide along the wall, z %f", w.pz);
+    CHECK(still.px == dead.px && still.py == dead.py && still.pz == dead.pz,
+          "a dead target should not move");
+
+    walk(core, &tick, { low, high, gentle, steep }, 1.0f, 0.0f, 40);
+    ax_snapshot_entity_v1 lo = entity_state(core, low), hi = entity_state(core, high);
+    ax_snapshot_entity_v1 ge = entity_state(core, gentle), st = entity_state(core, steep);
+    CHECK(lo.px > 3.5f && std::fabs(lo.py - 0.3f) < 0.02f,
+          "a 0.3 m ledge should be stepped onto: (%f, %f)", lo.px, lo.py);
+    CHECK(hi.px < STOP && hi.px > STOP - 0.05f && std::fabs(hi.py) < 0.02f,
+          "a 0.5 m ledge should block: (%f, %f)", hi.px, hi.py);
+    CHECK(ge.px > 3.5f && std::fabs(ge.py - (ge.px - 2.0f) * 0.2f) < 0.05f,
+          "a gentle ramp should be walked up: (%f, %f)", ge.px, ge.py);
+    CHECK(st.px < 2.0f && st.py < 0.1f, "a steep ramp should not be climbed: (%f, %f)",
+          st.px, st.py);
+
+    walk(core, &tick, { faller }, 0.0f, 0.0f, 10);
+    ax_snapshot_entity_v1 f = entity_state(core, faller);
+    CHECK(f.px == 20.0f && std::fabs(f.py) < 0.02f, "the actor should settle onto the floor: %f", f.py);
+
+    /* walking back off the ledge comes down onto the floor */
+    walk(core, &tick, { low }, -1.0f, 0.0f, 40);
+    lo = entity_state(core, low);
+    CHECK(lo.px < 0.0f && std::fabs(lo.py) < 0.02f, "off the ledge: (%f, %f)", lo.px, lo.py);
+    ax_destroy(core);
+
+    /* ── many actors on a generated level ─────────────────────────── */
+    mesh_data level;
+    mesh_make_level(64, 128.0f, 3, &level);
+    std::vector<uint8_t> save;
+    std::vector<uint32_t> actors;
+    uint64_t hashes[2] = {};
+    for (uint32_t run = 0; run < 2; ++run) {
+        ax_core* c = create_and_load("content/");
+        CHECK(c && set_threading(c, run == 0 ? 1 : 4, 1), "core setup failed");
+        if (!c) return;
+        CHECK_OK(mesh_upload(c, level));
+        actors.clear();
+        for (uint32_t i = 0; i < 256; ++i) {
+            actors.push_back(spawn_actor(c, -60.0f + (float)(i % 16) * 8.0f, 8.0f,
+                                         -60.0f + (float)(i / 16) * 8.0f));
+        }
+        uint64_t t = 0;
+        wander(c, &t, actors, 60);
+
+        /* steady state: movement with every cache in place allocates nothing */
+        ax_memory_stats_v1 m = {};
+        CHECK_OK(ax_get_memory_stats(c, &m));
+        uint64_t before = m.allocation_count;
+        wander(c, &t, actors, 20);
+        CHECK_OK(ax_get_memory_stats(c, &m));
+        CHECK(m.allocation_count == before, "moving actors should not allocate (%llu)",
+              (unsigned long long)(m.allocation_count - before));
+
+        if (run == 0) {
+            uint32_t size = 0;
+            save.resize(1 << 20);
+            CHECK_OK(ax_save_bytes(c, save.data(), (uint32_t)save.size(), &size));
+            save.resize(size);
+        }
+        wander(c, &t, actors, 40);
+        CHECK_OK(ax_get_state_hash(c, &hashes[run]));
+        ax_destroy(c);
+    }
+    CHECK(hashes[0] == hashes[1], "1 and 4 workers should agree: %016llx vs %016llx",
+          (unsigned long long)hashes[0], (unsigned long long)hashes[1]);
+
+    /* a loaded save continues identically with cold caches */
+    ax_core* loaded = create_and_load("content/");
+    CHECK(loaded != nullptr, "core creation failed");
+    if (!loaded) return;
+    CHECK_OK(mesh_upload(loaded, level));
+    CHECK_OK(ax_load_save_bytes(loaded, save.data(), (uint32_t)save.size()));
+    uint64_t t = 80, hash = 0;
+    wander(loaded, &t, actors, 40);
+    CHECK_OK(ax_get_state_hash(loaded, &hash));
+    CHECK(hash == hashes[0], "a loaded save should continue identically: %016llx vs %016llx",
+          (unsigned long long)hash, (unsigned long long)hashes[0]);
+    ax_destroy(loaded);
+    printf("  done\n");
+}
+
+/* ══════════════════════════════════════════════════════════════════════
+ * Test: weapon table
+ * Weapons belong to (actor, slot): armed targets fire and reload on
+ * their own magazines and timers; an empty slot or a dead actor does
+ * nothing and a shooter never hits itself; despawning drops an actor's
+ * weapons and reloads; the snapshot table (v1 and compact) lists every
+ * weapon; saves carry the table mid-reload and reject a bad one; results
+ * do not depend on workers, and combat does not allocate
+ * ══════════════════════════════════════════════════════════════════ */
+
+static ax_result give_weapon(ax_core* core, uint32_t id, uint32_t slot, int32_t mag, int32_t reserve) {
+    ax_debug_weapon_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.entity_id    = id;
+    p.weapon_slot  = slot;
+    p.weapon_id    = 1000;
+    p.ammo_in_mag  = mag;
+    p.ammo_reserve = reserve;
+    return ax_debug_give_weapon(core, &p);
+}
+
+static std::vector<uint8_t> take_weapon_snapshot(ax_core* core, bool compact) {
+    ax_snapshot_request_v1 req = {};
+    req.version    = 1;
+    req.size_bytes = sizeof(req);
+    req.flags      = AX_SNAPSHOT_REQ_WEAPONS | (compact ? AX_SNAPSHOT_REQ_COMPACT : 0);
+
+    uint32_t size = 0;
+    if (ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size) != AX_OK) return {};
+    std::vector<uint8_t> buf(size);
+    if (ax_get_snapshot_bytes_ex(core, &req, buf.data(), size, &size) != AX_OK) return {};
+    return compact ? decode_compact_snapshot(buf) : buf;
+}
+
+/* the table row of (owner, slot); weapon_flags = UINT32_MAX if unarmed */
+static ax_snapshot_player_weapon_v1 weapon_state(ax_core* core, uint32_t owner, uint32_t slot) {
+    auto buf = take_weapon_snapshot(core, false);
+    parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+    for (uint32_t i = 0; snap.weapons && i < snap.weapon_count; ++i) {
+        if (snap.weapons[i].player_id == owner && snap.weapons[i].weapon_slot == slot) {
+            return snap.weapons[i];
+        }
+    }
+    ax_snapshot_player_weapon_v1 none = {};
+    none.weapon_flags = UINT32_MAX;
+    return none;
+}
+
+static void submit_weapon_action(ax_core* core, uint64_t tick, uint32_t actor, uint32_t slot,
+                                 uint32_t type) {
+    ax_action_v1 a = {};
+    a.tick     = tick;
+    a.actor_id = actor;
+    a.type     = type;
+    if (type == AX_ACT_RELOAD) {
+        a.u.reload.weapon_slot = slot;
+    } else {
+        a.u.fire_once.weapon_slot = slot;
+    }
+    submit_action(core, a);
+}
+
+/* the first event of `type` raised by `actor` this tick, type 0 if none */
+static ax_snapshot_event_v1 actor_event(ax_core* core, uint32_t type, uint32_t actor) {
+    auto buf = take_snapshot(core);
+    parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+    for (uint32_t i = 0; snap.header && i < snap.header->event_count; ++i) {
+        if (snap.events[i].type == type && snap.events[i].a == actor) return snap.events[i];
+    }
+    ax_snapshot_event_v1 none = {};
+    return none;
+}
+
+static uint64_t state_hash(ax_core* core) {
+    uint64_t h = 0;
+    ax_get_state_hash(core, &h);
+    return h;
+}
+
+static void test_weapons(void) {
+    printf("test_weapons\n");
+
+    ax_core* core = create_and_load("content/");
+    CHECK(core != nullptr, "core creation failed");
+    if (!core) return;
+    uint64_t tick = 0;
+
+    /* content arms the player only; the table is opt-in */
+    {
+        auto buf = take_weapon_snapshot(core, false);
+        parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+        CHECK(snap.header && (snap.header->flags & AX_SNAPSHOT_FLAG_WEAPONS) && snap.weapon_count == 1,
+              "the content table should hold one weapon");
+        CHECK(snap.weapons && snap.weapon && memcmp(snap.weapons, snap.weapon, sizeof(*snap.weapon)) == 0,
+              "the table's player row should match the player_weapon record");
+        auto plain = take_snapshot(core);
+        parsed_snapshot p = parse_snapshot(plain.data(), (uint32_t)plain.size());
+        CHECK(p.header && p.header->flags == 0 && !p.weapons, "a plain snapshot should carry no table");
+    }
+
+    /* ax_debug_give_weapon validation */
+    uint32_t a = spawn_actor(core, 3.0f, 0.0f, -5.0f);
+    uint32_t b = spawn_actor(core, -3.0f, 0.0f, -5.0f);
+    CHECK(a != 0 && b != 0, "spawning actors failed");
+    ax_debug_weapon_params_v1 bad = {};
+    bad.version    = 2;
+    bad.size_bytes = sizeof(bad);
+    bad.entity_id  = a;
+    CHECK_ERR(ax_debug_give_weapon(core, nullptr), AX_ERR_INVALID_ARG);
+    CHECK_ERR(ax_debug_give_weapon(core, &bad), AX_ERR_UNSUPPORTED);
+    bad.version    = 1;
+    bad.size_bytes = 8;
+    CHECK_ERR(ax_debug_give_weapon(core, &bad), AX_ERR_INVALID_ARG);
+    CHECK_ERR(give_weapon(core, 0x7777, 0, 12, 0), AX_ERR_INVALID_ARG);
+    CHECK_ERR(give_weapon(core, a, AX_WEAPON_SLOTS, 12, 0), AX_ERR_INVALID_ARG);
+    CHECK_ERR(give_weapon(core, a, 0, 13, 0), AX_ERR_INVALID_ARG);
+    CHECK_ERR(give_weapon(core, a, 0, 12, -1), AX_ERR_INVALID_ARG);
+
+    /* an armed target fires from its own magazine; empty slots do nothing */
+    CHECK_OK(give_weapon(core, a, 0, 2, 10));
+    CHECK_OK(give_weapon(core, a, 3, 12, 0));
+    submit_weapon_action(core, ++tick, a, 0, AX_ACT_FIRE_ONCE);
+    submit_weapon_action(core, tick, a, 1, AX_ACT_FIRE_ONCE);
+    submit_weapon_action(core, tick, b, 0, AX_ACT_FIRE_ONCE);
+    submit_weapon_action(core, tick, b, 0, AX_ACT_RELOAD);
+    ax_step_ticks(core, 1);
+    ax_snapshot_event_v1 hit = actor_event(core, AX_EVT_DAMAGE_DEALT, a);
+    CHECK(hit.type == AX_EVT_DAMAGE_DEALT && hit.b == 100, "actor %u should hit target 100", a);
+    CHECK(actor_event(core, AX_EVT_DAMAGE_DEALT, b).type == 0 &&
+          actor_event(core, AX_EVT_RELOAD_STARTED, b).type == 0, "an unarmed actor should do nothing");
+    CHECK(weapon_state(core, a, 0).ammo_in_mag == 1 && weapon_state(core, a, 3).ammo_in_mag == 12 &&
+          weapon_state(core, 1, 0).ammo_in_mag == 12, "only the fired weapon should lose ammo");
+
+    /* a shooter never hits itself */
+    CHECK_OK(give_weapon(core, 100, 0, 12, 0));
+    submit_weapon_action(core, ++tick, 100, 0, AX_ACT_FIRE_ONCE);
+    ax_step_ticks(core, 1);
+    CHECK(actor_event(core, AX_EVT_DAMAGE_DEALT, 100).b == 101, "target 100 should hit 101, not itself");
+
+    /* per-weapon reloads: slot 0 reloads while slot 3 keeps firing */
+    submit_weapon_action(core, ++tick, a, 0, AX_ACT_RELOAD);
+    ax_step_ticks(core, 1);
+    uint64_t reload_start = tick;
+    CHECK(weapon_state(core, a, 0).weapon_flags & AX_WPN_FLAG_RELOADING, "slot 0 should be reloading");
+    submit_weapon_action(core, ++tick, a, 0, AX_ACT_FIRE_ONCE);
+    submit_weapon_action(core, tick, a, 3, AX_ACT_FIRE_ONCE);
+    ax_step_ticks(core, 1);
+    CHECK(actor_event(core, AX_EVT_FIRE_BLOCKED, a).value == AX_FIRE_BLOCKED_RELOADING,
+          "slot 0 should be blocked by its reload");
+    CHECK(actor_event(core, AX_EVT_DAMAGE_DEALT, a).type == AX_EVT_DAMAGE_DEALT,
+          "slot 3 should fire during slot 0's reload");
+    step_to(core, &tick, reload_start + 29);
+    ax_snapshot_event_v1 done = actor_event(core, AX_EVT_RELOAD_DONE, a);
+    CHECK(done.type == AX_EVT_RELOAD_DONE && done.b == 0 && done.value == 10,
+          "slot 0 should reload 10 rounds at +29 (got slot %u, %d)", done.b, done.value);
+    ax_snapshot_player_weapon_v1 w0 = weapon_state(core, a, 0);
+    CHECK(w0.ammo_in_mag == 11 && w0.ammo_reserve == 0 && w0.weapon_flags == 0,
+          "slot 0 should hold 11 rounds, reserve 0 (%d, %d)", w0.ammo_in_mag, w0.ammo_reserve);
+
+    /* despawning drops the weapons and their pending reloads */
+    CHECK_OK(give_weapon(core, b, 1, 0, 5));
+    submit_weapon_action(core, ++tick, b, 1, AX_ACT_RELOAD);
+    ax_step_ticks(core, 1);
+    reload_start = tick;
+    CHECK_OK(ax_debug_despawn_entity(core, b));
+    CHECK(weapon_state(core, b, 1).weapon_flags == UINT32_MAX, "despawned actor should have no weapons");
+    step_to(core, &tick, reload_start + 29);
+    CHECK(actor_event(core, AX_EVT_RELOAD_DONE, b).type == 0, "a despawned actor's reload should not fire");
+    uint32_t b2 = spawn_actor(core, -3.0f, 0.0f, -5.0f);
+    CHECK(weapon_state(core, b2, 1).weapon_flags == UINT32_MAX, "a reused slot should start unarmed");
+
+    /* giving replaces a weapon and cancels its reload */
+    CHECK_OK(give_weapon(core, b2, 2, 0, 5));
+    submit_weapon_action(core, ++tick, b2, 2, AX_ACT_RELOAD);
+    ax_step_ticks(core, 1);
+    reload_start = tick;
+    CHECK_OK(give_weapon(core, b2, 2, 7, 3));
+    step_to(core, &tick, reload_start + 29);
+    w0 = weapon_state(core, b2, 2);
+    CHECK(actor_event(core, AX_EVT_RELOAD_DONE, b2).type == 0 && w0.ammo_in_mag == 7 &&
+          w0.weapon_flags == 0, "a replaced weapon's reload should be cancelled");
+
+    /* a dead actor cannot fire */
+    for (uint32_t i = 0; i < 12 && !(entity_state(core, 100).state_flags & AX_ENT_FLAG_DEAD); ++i) {
+        submit_weapon_action(core, ++tick, 1, 0, AX_ACT_FIRE_ONCE);
+        ax_step_ticks(core, 1);
+    }
+    CHECK(entity_state(core, 100).state_flags & AX_ENT_FLAG_DEAD, "target 100 should be dead");
+    int32_t mag = weapon_state(core, 100, 0).ammo_in_mag;
+    submit_weapon_action(core, ++tick, 100, 0, AX_ACT_FIRE_ONCE);
+    ax_step_ticks(core, 1);
+    CHECK(actor_event(core, AX_EVT_DAMAGE_DEALT, 100).type == 0 &&
+          weapon_state(core, 100, 0).ammo_in_mag == mag, "a dead actor should not fire");
+
+    /* the compact table decodes to the v1 table */
+    {
+        CHECK_OK(give_weapon(core, a, 1, 0, 30));
+        submit_weapon_action(core, ++tick, a, 1, AX_ACT_RELOAD);
+        ax_step_ticks(core, 1);
+        auto v1 = take_weapon_snapshot(core, false);
+        auto v2 = take_weapon_snapshot(core, true);
+        parsed_snapshot s1 = parse_snapshot(v1.data(), (uint32_t)v1.size());
+        parsed_snapshot s2 = parse_snapshot(v2.data(), (uint32_t)v2.size());
+        CHECK(s1.weapons && s2.weapons && s1.weapon_count == 6 && s2.weapon_count == s1.weapon_count &&
+              memcmp(s1.weapons, s2.weapons, s1.weapon_count * sizeof(*s1.weapons)) == 0,
+              "compact and v1 weapon tables should match (%u, %u rows)", s1.weapon_count, s2.weapon_count);
+        CHECK(v1.size() == v2.size() && s2.header->flags == AX_SNAPSHOT_FLAG_WEAPONS,
+              "the decoded blob should have the v1 size and flags");
+    }
+
+    /* saves carry the table mid-reload (on a quiet tick: events are hashed) */
+    step_to(core, &tick, tick + 1);
+    std::vector<uint8_t> save = take_save(core);
+    uint64_t saved_hash = state_hash(core);
+    ax_core* loaded = create_and_load("content/");
+    CHECK(loaded != nullptr, "core creation failed");
+    if (!loaded) { ax_destroy(core); return; }
+    CHECK_OK(ax_load_save_bytes(loaded, save.data(), (uint32_t)save.size()));
+    CHECK(state_hash(loaded) == saved_hash, "a loaded save should restore the weapon table");
+    uint64_t t2 = tick;
+    step_to(core, &tick, tick + 30);
+    step_to(loaded, &t2, t2 + 30);
+    CHECK(state_hash(loaded) == state_hash(core), "a loaded save should finish its reloads identically");
+    CHECK(weapon_state(loaded, a, 1).ammo_in_mag == 12, "actor %u slot 1 should have reloaded", a);
+
+    /* a bad table is rejected without touching state */
+    {
+        uint32_t ext4_at = SAVE_HEADER_SIZE + SAVE_WORLD_V1_0_SIZE + 16 + 16 + 8;
+        uint32_t count   = read_u32(save, ext4_at);
+        uint32_t rows_at = read_u32(save, ext4_at + 4);
+        CHECK(count == 6, "the save should hold 6 weapons, got %u", count);
+        uint64_t before = state_hash(loaded);
+
+        std::vector<uint8_t> dup = save;
+        write_u32(dup, rows_at + 24, read_u32(save, rows_at));        /* row 1 owner = row 0's */
+        write_u32(dup, rows_at + 24 + 4, read_u32(save, rows_at + 4));
+        reseal_save(dup);
+        CHECK_ERR(ax_load_save_bytes(loaded, dup.data(), (uint32_t)dup.size()), AX_ERR_INVALID_ARG);
+
+        std::vector<uint8_t> stale = save;
+        write_u32(stale, rows_at, read_u32(save, rows_at) + (1u << AX_ENTITY_ID_GEN_SHIFT));
+        reseal_save(stale);
+        CHECK_ERR(ax_load_save_bytes(loaded, stale.data(), (uint32_t)stale.size()), AX_ERR_INVALID_ARG);
+        CHECK(state_hash(loaded) == before, "a rejected save should not change state");
+
+        /* as a 1.3 save, only the player's weapon remains */
+        std::vector<uint8_t> v13 = save;
+        uint16_t minor = 3;
+        memcpy(v13.data() + 6, &minor, 2);
+        reseal_save(v13);
+        CHECK_ERR(ax_load_save_bytes(loaded, v13.data(), (uint32_t)v13.size()), AX_ERR_INVALID_ARG);
+        auto buf = take_weapon_snapshot(loaded, false);
+        parsed_snapshot snap = parse_snapshot(buf.data(), (uint32_t)buf.size());
+        CHECK(snap.weapon_count == 6, "a rejected 1.3 save should keep the table");
+    }
+    ax_destroy(loaded);
+    ax_destroy(core);
+
+    /* many armed actors: same hash for 1 and 4 workers, no allocation in combat */
+    const uint32_t n_actors = 2000;
+    uint64_t hashes[2] = { 0, 0 };
+    for (uint32_t run = 0; run < 2; ++run) {
+        ax_core* c = create_and_load("content/");
+        CHECK(c != nullptr, "core creation failed");
+        if (!c) return;
+        CHECK(set_threading(c, run == 0 ? 1 : 4, 1), "set_threading failed");
+        std::vector<uint32_t> actors;
+        for (uint32_t i = 0; i < n_actors; ++i) {
+            uint32_t id = spawn_actor(c, (float)(i % 64), 0.0f, -20.0f - (float)(i / 64));
+            give_weapon(c, id, i % AX_WEAPON_SLOTS, 12, 1000);
+            actors.push_back(id);
+        }
+
+        ax_memory_stats_v1 m = {};
+        m.version    = 1;
+        m.size_bytes = sizeof(m);
+        uint64_t t = 0, before = 0;
+        for (uint32_t k = 0; k < 120; ++k) {
+            if (k == 60) {
+                CHECK_OK(ax_get_memory_stats(c, &m));
+                before = m.allocation_count;
+            }
+            ++t;
+            for (uint32_t i = (uint32_t)(t * 37 % 50); i < n_actors; i += 50) {
+                uint32_t slot = i % AX_WEAPON_SLOTS;
+                submit_weapon_action(c, t, actors[i], slot, AX_ACT_FIRE_ONCE);
+                if ((i + t) % 3 == 0) submit_weapon_action(c, t, actors[i], slot, AX_ACT_RELOAD);
+            }
+            ax_step_ticks(c, 1);
+        }
+        CHECK_OK(ax_get_memory_stats(c, &m));
+        CHECK(m.allocation_count == before, "armed combat should not allocate (%llu)",
+              (unsigned long long)(m.allocation_count - before));
+        hashes[run] = state_hash(c);
+        ax_destroy(c);
+    }
+    CHECK(hashes[0] == hashes[1], "1 and 4 workers should agree: %016llx vs %016llx",
+          (unsigned long long)hashes[0], (unsigned long long)hashes[1]);
+    printf("  done\n");
+}
+
+int main(int argc, char** argv) {
+    /* shell modes */
+    if (argc >= 2 && strcmp(argv[1], "batch") == 0) {
+        return batch_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "inbox-bench") == 0) {
+        return inbox_bench_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "snapshot-bench") == 0) {
+        return snapshot_bench_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "profile") == 0) {
+        return profile_report_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "trace") == 0) {
+        return trace_export_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "worldgen") == 0) {
+        return worldgen_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "record") == 0) {
+        return replay_record_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "replay") == 0) {
+        return replay_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "verify") == 0) {
+        return verify_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "raycast-bench") == 0) {
+        return raycast_bench_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "controller-bench") == 0) {
+        return controller_bench_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "weapon-bench") == 0) {
+        return weapon_bench_main(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--perf") == 0) {
+        return perf_gate_main(argc - 2, argv + 2);
+    }
+
     printf("=== Axiom Headless Shell (A1 Tests) ===\n\n");
 
     test_basic_fire_and_damage();
@@ -1469,6 +5600,30 @@ int main(void) {
     test_deterministic_replay();
     test_save_load_continuity();
     test_error_paths();
+    test_concurrent_cores();
+    test_batch_runner();
+    test_parallel_determinism();
+    test_async_stepping();
+    test_action_inbox();
+    test_timer_service();
+    test_zero_alloc_steady_state();
+    test_host_allocator();
+    test_memory_stats();
+    test_entity_pool();
+    test_compact_snapshot();
+    test_profiler();
+    test_trace_export();
+    test_perf_gate();
+    test_runtime_stats();
+    test_population();
+    test_logging();
+    test_replay_recording();
+    test_replay_seek();
+    test_determinism_verifier();
+    test_rng();
+    test_collision();
+    test_character();
+    test_weapons();
 
     printf("\n=== Results: %d passed, %d failed, %d total ===\n",
            g_tests_passed, g_tests_failed, g_tests_run);
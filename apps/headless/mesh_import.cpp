@@ -0,0 +1,186 @@
+/*
+ * mesh_import.cpp — Collision meshes for ax_load_collision_mesh
+ *
+ * See mesh_import.h.
+ */
+
+#include "mesh_import.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/* ── OBJ ──────────────────────────────────────────────────────────── */
+
+static bool fail(std::string* error, uint32_t line, const char* what) {
+    *error = "line " + std::to_string(line) + ": " + what;
+    return false;
+}
+
+/* One face corner: the position index before any '/'. */
+static bool parse_corner(const char** p, uint32_t vertex_count, uint32_t* out) {
+    char* end = nullptr;
+    long  v   = std::strtol(*p, &end, 10);
+    if (end == *p) return false;
+    while (*end && *end != ' ' && *end != '\t' && *end != '\r' && *end != '\n') ++end;
+    *p = end;
+
+    /* 1-based, or negative relative to the vertices read so far */
+    long index = v > 0 ? v - 1 : (long)vertex_count + v;
+    if (v == 0 || index < 0 || index >= (long)vertex_count) return false;
+    *out = (uint32_t)index;
+    return true;
+}
+
+bool mesh_parse_obj(const char* text, mesh_data* out, std::string* error) {
+    out->vertices.clear();
+    out->indices.clear();
+
+    std::vector<uint32_t> face;
+    uint32_t line = 0;
+    for (const char* p = text; *p;) {
+        const char* eol = std::strchr(p, '\n');
+        if (!eol) eol = p + std::strlen(p);
+        ++line;
+        std::string s(p, eol);
+        p = *eol ? eol + 1 : eol;
+
+        const char* c = s.c_str();
+        while (*c == ' ' || *c == '\t') ++c;
+        if (c[0] == 'v' && (c[1] == ' ' || c[1] == '\t')) {
+            float xyz[3];
+            char* end = nullptr;
+            c += 2;
+            for (int k = 0; k < 3; ++k) {
+                xyz[k] = std::strtof(c, &end);
+                if (end == c || !std::isfinite(xyz[k])) return fail(error, line, "bad vertex");
+                c = end;
+            }
+            out->vertices.insert(out->vertices.end(), xyz, xyz + 3);
+        } else if (c[0] == 'f' && (c[1] == ' ' || c[1] == '\t')) {
+            face.clear();
+            c += 2;
+            for (;;) {
+                while (*c == ' ' || *c == '\t' || *c == '\r') ++c;
+                if (!*c) break;
+                uint32_t index;
+                if (!parse_corner(&c, out->vertex_count(), &index)) {
+                    return fail(error, line, "bad face index");
+                }
+                face.push_back(index);
+            }
+            if (face.size() < 3) return fail(error, line, "face with fewer than 3 vertices");
+            for (size_t k = 1; k + 1 < face.size(); ++k) {
+                out->indices.push_back(face[0]);
+                out->indices.push_back(face[k]);
+                out->indices.push_back(face[k + 1]);
+            }
+        }
+    }
+    return true;
+}
+
+bool mesh_load_obj(const char* path, mesh_data* out, std::string* error) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        *error = std::string("cannot read ") + path;
+        return false;
+    }
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    bool read_ok = !ferror(f);
+    fclose(f);
+    if (!read_ok) {
+        *error = std::string("cannot read ") + path;
+        return false;
+    }
+    return mesh_parse_obj(text.c_str(), out, error);
+}
+
+/* ── Synthetic level ──────────────────────────────────────────────── */
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/* [0, 1) from (seed, index) */
+static float unit(uint64_t seed, uint64_t index) {
+    return (float)(splitmix64(seed ^ splitmix64(index)) >> 40) * (1.0f / 16777216.0f);
+}
+
+/* smooth 0..1..0 bump per unit of u; no libm, so every platform agrees */
+static float wave(float u) {
+    float f = u - std::floor(u);
+    return 4.0f * f * (1.0f - f);
+}
+
+void mesh_make_level(uint32_t cells, float size_m, uint64_t seed, mesh_data* out) {
+    out->vertices.clear();
+    out->indices.clear();
+    if (cells == 0) return;
+
+    /* heightfield: a few metres of smooth hills plus per-vertex noise */
+    const uint32_t side = cells + 1;
+    const float    step = size_m / (float)cells;
+    const float    half = size_m * 0.5f;
+    out->vertices.reserve((size_t)side * side * 3);
+    for (uint32_t z = 0; z < side; ++z) {
+        for (uint32_t x = 0; x < side; ++x) {
+            float px = -half + (float)x * step;
+            float pz = -half + (float)z * step;
+            float h  = 4.0f * wave(px * (1.0f / 120.0f)) * wave(pz * (1.0f / 90.0f)) +
+                       0.25f * unit(seed, (uint64_t)z * side + x);
+            out->vertices.insert(out->vertices.end(), { px, h, pz });
+        }
+    }
+    out->indices.reserve((size_t)cells * cells * 6);
+    for (uint32_t z = 0; z < cells; ++z) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            uint32_t i = z * side + x;
+            out->indices.insert(out->indices.end(), { i, i + side, i + 1, i + 1, i + side, i + side + 1 });
+        }
+    }
+
+    /* buildings: axis-aligned boxes standing on the terrain */
+    static const uint32_t BOX_FACES[12][3] = {                 /* wound outwards */
+        { 0, 1, 2 }, { 0, 2, 3 }, { 4, 6, 5 }, { 4, 7, 6 },     /* bottom, top    */
+        { 0, 5, 1 }, { 0, 4, 5 }, { 1, 6, 2 }, { 1, 5, 6 },
+        { 2, 7, 3 }, { 2, 6, 7 }, { 3, 4, 0 }, { 3, 7, 4 },
+    };
+    const uint32_t boxes = cells * cells / 64;
+    for (uint32_t b = 0; b < boxes; ++b) {
+        uint64_t k  = 0x100000000ull + (uint64_t)b * 8;
+        float cx = -half + unit(seed, k + 0) * size_m;
+        float cz = -half + unit(seed, k + 1) * size_m;
+        float hx = step * (1.0f + 3.0f * unit(seed, k + 2));
+        float hz = step * (1.0f + 3.0f * unit(seed, k + 3));
+        float y0 = -3.0f;
+        float y1 = 3.0f + 12.0f * unit(seed, k + 4);
+        uint32_t base = out->vertex_count();
+        const float corners[8][3] = {
+            { cx - hx, y0, cz - hz }, { cx + hx, y0, cz - hz }, { cx + hx, y0, cz + hz }, { cx - hx, y0, cz + hz },
+            { cx - hx, y1, cz - hz }, { cx + hx, y1, cz - hz }, { cx + hx, y1, cz + hz }, { cx - hx, y1, cz + hz },
+        };
+        for (const auto& c : corners) out->vertices.insert(out->vertices.end(), c, c + 3);
+        for (const auto& f : BOX_FACES) {
+            out->indices.insert(out->indices.end(), { base + f[0], base + f[1], base + f[2] });
+        }
+    }
+}
+
+ax_result mesh_upload(ax_core* core, const mesh_data& mesh) {
+    ax_collision_mesh_v1 m = {};
+    m.version        = 1;
+    m.size_bytes     = sizeof(m);
+    m.vertex_count   = mesh.vertex_count();
+    m.triangle_count = mesh.triangle_count();
+    m.vertices       = mesh.vertices.data();
+    m.indices        = mesh.indices.data();
+    return ax_load_collision_mesh(core, &m);
+}
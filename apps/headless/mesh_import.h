@@ -0,0 +1,44 @@
+/*
+ * mesh_import.h — Collision meshes for ax_load_collision_mesh
+ *
+ * Level geometry is content the shell reads and hands to Core (Core
+ * does not read files, see CONTENT_DATABASE.md). Meshes come from
+ * Wavefront OBJ files or from a seeded synthetic level used by the
+ * raycast benchmark and tests.
+ *
+ * OBJ support is the subset collision needs: `v x y z` and
+ * `f a b c ...` with 1-based or negative (relative) indices, in any of
+ * the `a`, `a/t`, `a//n`, `a/t/n` forms. Polygons are fanned into
+ * triangles. Normals, texture coordinates, groups, materials and
+ * everything else are ignored.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct mesh_data {
+    std::vector<float>    vertices;     /* xyz per vertex */
+    std::vector<uint32_t> indices;      /* 3 per triangle */
+
+    uint32_t vertex_count() const   { return (uint32_t)(vertices.size() / 3); }
+    uint32_t triangle_count() const { return (uint32_t)(indices.size() / 3); }
+};
+
+/* False with *error set ("line N: ...") on malformed input. */
+bool mesh_parse_obj(const char* text, mesh_data* out, std::string* error);
+bool mesh_load_obj(const char* path, mesh_data* out, std::string* error);
+
+/*
+ * Synthetic level over [-size_m/2, size_m/2]^2: a rolling heightfield of
+ * cells x cells quads plus one box building per 64 cells, all derived
+ * from `seed`. 2 * cells^2 + 12 * boxes triangles.
+ */
+void mesh_make_level(uint32_t cells, float size_m, uint64_t seed, mesh_data* out);
+
+/* ax_load_collision_mesh over `mesh` (an empty mesh removes it). */
+ax_result mesh_upload(ax_core* core, const mesh_data& mesh);
@@ -0,0 +1,331 @@
+/*
+ * perf_gate.cpp — Local performance regression gate
+ *
+ * See perf_gate.h.
+ */
+
+#include "perf_gate.h"
+#include "shell_common.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+/* operations timed per rep */
+static const uint32_t TICKS_PER_REP     = 1000;
+static const uint32_t SNAPSHOTS_PER_REP = 20;
+static const uint32_t SAVES_PER_REP     = 10;
+
+/* ── Workloads ────────────────────────────────────────────────────── */
+
+/* One untimed rep, then `reps` timed ones; records ns per op. */
+static bool measure(const char* name, uint32_t reps, uint32_t ops,
+                    const std::function<bool()>& op, std::vector<perf_sample>* out) {
+    std::vector<double> per_op;
+    for (uint32_t r = 0; r <= reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < ops; ++i) {
+            if (!op()) {
+                printf("  perf: %s failed: %s\n", name, ax_get_last_error());
+                return false;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (r == 0) continue;   /* warmup */
+        per_op.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double)ops);
+    }
+
+    std::sort(per_op.begin(), per_op.end());
+    perf_sample s;
+    s.name      = name;
+    s.median_ns = per_op[per_op.size() / 2];
+    s.min_ns    = per_op.front();
+    s.max_ns    = per_op.back();
+    out->push_back(s);
+    return true;
+}
+
+/* Submits the action mix for the next tick (*tick + 1), then steps. */
+static bool step_with(ax_core* core, uint64_t* tick, std::vector<ax_action_v1>& actions, bool fire) {
+    ++*tick;
+    uint32_t n = (uint32_t)actions.size();
+    for (uint32_t i = 0; i < n; ++i) {
+        ax_action_v1& a = actions[i];
+        a = {};
+        a.tick     = *tick;
+        a.actor_id = 1;
+        if (fire) {
+            a.type = (i % 32 == 31) ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+        } else if (i % 2 == 0) {
+            a.type = AX_ACT_LOOK_INTENT;
+            a.u.look.yaw = 0.001f;
+        } else {
+            a.type = AX_ACT_MOVE_INTENT;
+            a.u.move.x = 0.1f;
+        }
+    }
+
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = n;
+    batch.actions    = actions.data();
+    return ax_submit_actions(core, &batch) == AX_OK && ax_step_ticks(core, 1) == AX_OK;
+}
+
+bool perf_run_workloads(const perf_gate_params& params, std::vector<perf_sample>* out) {
+    out->clear();
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_debug_spawn_params_v1 sp = {};
+    sp.version      = 1;
+    sp.size_bytes   = sizeof(sp);
+    sp.archetype_id = 2000;
+    sp.hp           = 1000000;     /* outlive the run, so the world keeps its shape */
+    for (uint32_t i = 4; i < params.entities; ++i) {
+        sp.px = (float)(i % 256) - 128.0f;
+        sp.pz = -12.0f - (float)(i / 256);
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &sp, &id) != AX_OK) {
+            printf("  perf: spawn failed: %s\n", ax_get_last_error());
+            ax_destroy(core);
+            return false;
+        }
+    }
+
+    std::vector<ax_action_v1> moves(16);
+    std::vector<ax_action_v1> fires(256);
+
+    /* idle tick: later reads see no leftover events from the fire burst */
+    uint64_t tick = 0;
+    auto idle = [&] { ++tick; return ax_step_ticks(core, 1) == AX_OK; };
+
+    std::vector<uint8_t> snap(take_snapshot(core).size() * 2 + 4096);
+    std::vector<uint8_t> save = take_save(core);
+    save.resize(save.size() * 2 + 4096);
+    uint32_t save_size = 0;
+
+    ax_snapshot_request_v1 req = {};
+    req.version    = 1;
+    req.size_bytes = sizeof(req);
+    req.flags      = AX_SNAPSHOT_REQ_COMPACT;
+
+    bool ok =
+        measure("step", params.reps, TICKS_PER_REP,
+                [&] { return step_with(core, &tick, moves, false); }, out) &&
+        measure("fire", params.reps, TICKS_PER_REP,
+                [&] { return step_with(core, &tick, fires, true); }, out) &&
+        idle() &&
+        measure("snapshot", params.reps, SNAPSHOTS_PER_REP, [&] {
+            uint32_t size = 0;
+            return ax_get_snapshot_bytes(core, snap.data(), (uint32_t)snap.size(), &size) == AX_OK;
+        }, out) &&
+        measure("snapshot_compact", params.reps, SNAPSHOTS_PER_REP, [&] {
+            uint32_t size = 0;
+            return ax_get_snapshot_bytes_ex(core, &req, snap.data(), (uint32_t)snap.size(), &size) == AX_OK;
+        }, out) &&
+        measure("save", params.reps, SAVES_PER_REP, [&] {
+            return ax_save_bytes(core, save.data(), (uint32_t)save.size(), &save_size) == AX_OK;
+        }, out) &&
+        measure("load", params.reps, SAVES_PER_REP, [&] {
+            return ax_load_save_bytes(core, save.data(), save_size) == AX_OK;
+        }, out);
+
+    ax_destroy(core);
+    return ok;
+}
+
+/* ── Baseline file ────────────────────────────────────────────────── */
+
+bool perf_parse_baseline(FILE* f, const char* label, std::vector<perf_baseline_entry>* out) {
+    out->clear();
+    char line[512];
+    uint32_t line_no = 0;
+
+    while (std::fgets(line, sizeof(line), f)) {
+        line_no++;
+
+        char* hash = std::strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char* tok[5] = {};
+        int n = 0;
+        for (char* t = std::strtok(line, " \t\r\n"); t && n < 5; t = std::strtok(nullptr, " \t\r\n")) {
+            tok[n++] = t;
+        }
+        if (n == 0) continue;
+
+        perf_baseline_entry e;
+        char* end1 = nullptr;
+        char* end2 = nullptr;
+        if (std::strcmp(tok[0], "metric") == 0 && n == 4) {
+            e.name          = tok[1];
+            e.median_ns     = std::strtod(tok[2], &end1);
+            e.tolerance_pct = std::strtod(tok[3], &end2);
+        }
+        if (!end1 || *end1 || !end2 || *end2 || !(e.median_ns > 0.0) || !(e.tolerance_pct >= 0.0)) {
+            printf("perf: %s:%u: expected 'metric <name> <median_ns> <tolerance_pct>'\n",
+                   label, line_no);
+            return false;
+        }
+        out->push_back(e);
+    }
+    return true;
+}
+
+static const perf_baseline_entry* find_entry(const std::vector<perf_baseline_entry>& baseline,
+                                             const std::string& name) {
+    for (const perf_baseline_entry& e : baseline) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+uint32_t perf_compare(FILE* report, const std::vector<perf_baseline_entry>& baseline,
+                      const std::vector<perf_sample>& samples) {
+    uint32_t regressions = 0;
+    fprintf(report, "  %-18s %12s %12s %8s %6s  %s\n",
+            "metric", "median (ns)", "base (ns)", "delta", "tol", "result");
+
+    for (const perf_sample& s : samples) {
+        const perf_baseline_entry* e = find_entry(baseline, s.name);
+        if (!e) {
+            fprintf(report, "  %-18s %12.0f %12s %8s %6s  new (not in baseline)\n",
+                    s.name.c_str(), s.median_ns, "-", "-", "-");
+            continue;
+        }
+        double delta = 100.0 * (s.median_ns - e->median_ns) / e->median_ns;
+        bool   slow  = s.median_ns > e->median_ns * (1.0 + e->tolerance_pct / 100.0);
+        if (slow) regressions++;
+        fprintf(report, "  %-18s %12.0f %12.0f %+7.1f%% %5.0f%%  %s\n",
+                s.name.c_str(), s.median_ns, e->median_ns, delta, e->tolerance_pct,
+                slow ? "REGRESSION" : "ok");
+    }
+    return regressions;
+}
+
+bool perf_write_baseline(FILE* f, const std::vector<perf_sample>& samples,
+                         const std::vector<perf_baseline_entry>& previous) {
+    fprintf(f, "# Axiom perf gate baseline: `axiom_headless --perf` (see apps/headless/perf_gate.h)\n");
+    fprintf(f, "#\n");
+    fprintf(f, "# metric <name> <median_ns_per_op> <tolerance_pct>\n");
+    fprintf(f, "#\n");
+    fprintf(f, "# Machine-specific; refresh with --update-baseline on the gating machine.\n\n");
+    for (const perf_sample& s : samples) {
+        const perf_baseline_entry* e = find_entry(previous, s.name);
+        fprintf(f, "metric %-18s %12.0f %5.0f\n", s.name.c_str(), s.median_ns,
+                e ? e->tolerance_pct : PERF_DEFAULT_TOLERANCE);
+    }
+    return !ferror(f);
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+int perf_gate_main(int argc, char** argv) {
+    perf_gate_params params;
+    params.content_path = "content/";
+    params.entities     = 10000;
+    params.reps         = 15;
+    const char* baseline_path = PERF_DEFAULT_BASELINE;
+    bool update = false;
+
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            params.reps = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--entities") == 0 && i + 1 < argc) {
+            params.entities = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--update-baseline") == 0) {
+            update = true;
+        } else {
+            printf("usage: axiom_headless --perf [--baseline FILE] [--reps N] [--entities N]"
+                   " [--update-baseline]\n");
+            return 2;
+        }
+    }
+    if (params.reps == 0) params.reps = 1;
+
+    std::vector<perf_baseline_entry> baseline;
+    FILE* f = std::fopen(baseline_path, "r");
+    if (f) {
+        bool parsed = perf_parse_baseline(f, baseline_path, &baseline);
+        std::fclose(f);
+        if (!parsed) return 1;
+    } else if (!update) {
+        printf("perf: cannot open baseline '%s' (create it with --update-baseline)\n", baseline_path);
+        return 1;
+    }
+
+    printf("=== Axiom Perf Gate: %u entities, %u reps, baseline %s ===\n\n",
+           params.entities, params.reps, baseline_path);
+
+    std::vector<perf_sample> samples;
+    if (!perf_run_workloads(params, &samples)) {
+        printf("  FAILED: workload error\n");
+        return 1;
+    }
+
+    /*
+     * A regression has to reproduce: re-run and keep each metric's best
+     * median, so one noisy pass (another process, a frequency dip) does
+     * not fail the gate.
+     */
+    FILE* quiet = std::tmpfile();
+    for (uint32_t attempt = 1; !update && attempt < PERF_MAX_ATTEMPTS && quiet; ++attempt) {
+        std::rewind(quiet);
+        if (perf_compare(quiet, baseline, samples) == 0) break;
+
+        std::vector<perf_sample> retry;
+        if (!perf_run_workloads(params, &retry)) {
+            printf("  FAILED: workload error\n");
+            std::fclose(quiet);
+            return 1;
+        }
+        for (size_t i = 0; i < samples.size() && i < retry.size(); ++i) {
+            if (retry[i].median_ns < samples[i].median_ns) samples[i] = retry[i];
+        }
+        printf("  (regression on pass %u, re-measuring)\n", attempt);
+    }
+    if (quiet) std::fclose(quiet);
+
+    if (update) {
+        /* a baseline should be typical, not lucky: median of the passes */
+        std::vector<std::vector<perf_sample>> passes(1, samples);
+        for (uint32_t attempt = 1; attempt < PERF_MAX_ATTEMPTS; ++attempt) {
+            passes.emplace_back();
+            if (!perf_run_workloads(params, &passes.back())) {
+                printf("  FAILED: workload error\n");
+                return 1;
+            }
+        }
+        for (size_t i = 0; i < samples.size(); ++i) {
+            std::vector<double> medians;
+            for (const auto& p : passes) medians.push_back(p[i].median_ns);
+            std::sort(medians.begin(), medians.end());
+            samples[i].median_ns = medians[medians.size() / 2];
+        }
+
+        f = std::fopen(baseline_path, "w");
+        bool written = f && perf_write_baseline(f, samples, baseline);
+        written = f && std::fclose(f) == 0 && written;
+        if (!written) {
+            printf("  FAILED: cannot write %s\n", baseline_path);
+            return 1;
+        }
+        for (const perf_sample& s : samples) {
+            printf("  %-18s %12.0f ns\n", s.name.c_str(), s.median_ns);
+        }
+        printf("\n  baseline updated: %s\n", baseline_path);
+        return 0;
+    }
+
+    uint32_t regressions = perf_compare(stdout, baseline, samples);
+    printf("\n=== Perf: %u regression(s) in %zu metrics ===\n", regressions, samples.size());
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * perf_gate.h — Local performance regression gate
+ *
+ * `axiom_headless --perf [--baseline FILE] [--reps N] [--entities N]
+ *                        [--update-baseline]`
+ *
+ * Runs a fixed set of workloads against one synthetic world (A1 content
+ * topped up with debug-spawned targets) and compares each metric's
+ * median against a checked-in baseline:
+ *
+ *   step        ax_submit_actions + ax_step_ticks, 16 LOOK/MOVE per tick
+ *   fire        same, 256 FIRE/RELOAD per tick (hit resolution heavy)
+ *   snapshot    ax_get_snapshot_bytes (v1)
+ *   snapshot_compact  ax_get_snapshot_bytes_ex, AX_SNAPSHOT_REQ_COMPACT
+ *   save        ax_save_bytes
+ *   load        ax_load_save_bytes
+ *
+ * Every metric is ns per operation. One rep times a fixed batch of
+ * operations; the metric is the median over reps, which shrugs off a
+ * descheduled rep. A metric over tolerance is re-measured (up to
+ * PERF_MAX_ATTEMPTS passes, best median kept), so only regressions
+ * that reproduce fail the gate. Exit code: 0 pass, 1 regression or
+ * failure, 2 usage.
+ *
+ * Baseline file format (line based, '#' starts a comment):
+ *
+ *   metric <name> <median_ns> <tolerance_pct>
+ *
+ * A metric regresses when its median exceeds median_ns * (1 + pct/100).
+ * Metrics missing from the baseline are reported but do not fail.
+ * --update-baseline rewrites the file with the measured medians,
+ * keeping existing tolerances. Baselines are machine-specific: refresh
+ * them on the machine that runs the gate.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define PERF_DEFAULT_BASELINE  "apps/headless/perf_baseline.txt"
+#define PERF_DEFAULT_TOLERANCE 25.0
+#define PERF_MAX_ATTEMPTS      3
+
+struct perf_gate_params {
+    const char* content_path;
+    uint32_t    entities;
+    uint32_t    reps;
+};
+
+struct perf_sample {
+    std::string name;
+    double      median_ns;      /* per operation */
+    double      min_ns;
+    double      max_ns;
+};
+
+struct perf_baseline_entry {
+    std::string name;
+    double      median_ns;
+    double      tolerance_pct;
+};
+
+/* Runs every workload; false if any ABI call failed. */
+bool perf_run_workloads(const perf_gate_params& params, std::vector<perf_sample>* out);
+
+/* Parses a baseline stream; `label` prefixes error messages. */
+bool perf_parse_baseline(FILE* f, const char* label, std::vector<perf_baseline_entry>* out);
+
+/* Prints one line per metric; returns the number of regressions. */
+uint32_t perf_compare(FILE* report, const std::vector<perf_baseline_entry>& baseline,
+                      const std::vector<perf_sample>& samples);
+
+/* Writes samples in baseline format, tolerances taken from `previous`. */
+bool perf_write_baseline(FILE* f, const std::vector<perf_sample>& samples,
+                         const std::vector<perf_baseline_entry>& previous);
+
+/* CLI entry point: argv = { [--baseline FILE] [--reps N] [--entities N] [--update-baseline] } */
+int perf_gate_main(int argc, char** argv);
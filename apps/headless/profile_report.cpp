@@ -0,0 +1,171 @@
+/*
+ * profile_report.cpp — Per-phase tick profile of a synthetic workload
+ *
+ * See profile_report.h.
+ */
+
+#include "profile_report.h"
+#include "shell_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const char* const PHASE_NAMES[AX_PROFILE_PHASE_COUNT] = {
+    "inbox", "gather", "movement", "combat", "  hit resolution", "timers"
+};
+
+static const char* const CALL_NAMES[AX_PROFILE_CALL_COUNT] = {
+    "submit_actions", "step_ticks", "get_snapshot", "save", "load", "get_state_hash"
+};
+
+/* Appends ring records newer than *last_tick. */
+static bool collect(ax_core* core, ax_profile_v1* prof, uint64_t* last_tick,
+                    profile_report_result* out) {
+    if (ax_get_profile(core, prof) != AX_OK) return false;
+    for (uint32_t i = 0; i < prof->tick_count; ++i) {
+        if (prof->ticks[i].tick > *last_tick) {
+            out->ticks.push_back(prof->ticks[i]);
+            *last_tick = prof->ticks[i].tick;
+        }
+    }
+    std::memcpy(out->calls, prof->calls, sizeof(out->calls));
+    return true;
+}
+
+bool profile_report_run(const profile_report_params& params, profile_report_result* out) {
+    out->ok = false;
+    out->ticks.clear();
+    std::memset(out->calls, 0, sizeof(out->calls));
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_debug_spawn_params_v1 sp = {};
+    sp.version      = 1;
+    sp.size_bytes   = sizeof(sp);
+    sp.archetype_id = 2000;
+    sp.hp           = 1000000;     /* outlive the run, so FIRE keeps scanning the same set */
+    for (uint32_t i = 4; i < params.entities; ++i) {
+        sp.px = (float)(i % 256) - 128.0f;
+        sp.pz = -12.0f - (float)(i / 256);
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &sp, &id) != AX_OK) {
+            printf("  profile: spawn failed: %s\n", ax_get_last_error());
+            ax_destroy(core);
+            return false;
+        }
+    }
+
+    if (ax_set_profiling(core, 1) != AX_OK) {
+        printf("  profile: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+
+    /* ax_profile_v1 carries the whole ring: keep it off the stack */
+    std::vector<ax_profile_v1> prof(1);
+    std::vector<ax_action_v1>  actions(params.actions_per_tick);
+    uint64_t last_tick = 0;
+    bool ok = true;
+
+    for (uint32_t t = 1; t <= params.ticks && ok; ++t) {
+        for (uint32_t i = 0; i < params.actions_per_tick; ++i) {
+            ax_action_v1& a = actions[i];
+            a = {};
+            a.tick     = t;
+            a.actor_id = 1;
+            switch (i % 4) {
+                case 0:  a.type = AX_ACT_LOOK_INTENT; a.u.look.yaw = 0.001f;            break;
+                case 1:  a.type = AX_ACT_MOVE_INTENT; a.u.move.x = 0.1f;                break;
+                case 2:  a.type = AX_ACT_FIRE_ONCE;   a.u.fire_once.weapon_slot = 0;    break;
+                default: a.type = (i % 32 == 3) ? AX_ACT_RELOAD : AX_ACT_FIRE_ONCE;
+                         a.u.reload.weapon_slot = 0;
+                         break;
+            }
+        }
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = params.actions_per_tick;
+        batch.actions    = actions.data();
+
+        ok = ax_submit_actions(core, &batch) == AX_OK && ax_step_ticks(core, 1) == AX_OK;
+        if (ok && (t % AX_PROFILE_RING_TICKS == 0 || t == params.ticks)) {
+            ok = collect(core, prof.data(), &last_tick, out);
+        }
+    }
+
+    ax_destroy(core);
+    out->ok = ok && out->ticks.size() == params.ticks;
+    return out->ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static double percentile_us(std::vector<uint64_t>& v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (double)(v.size() - 1) + 0.5);
+    return (double)v[i] / 1000.0;
+}
+
+int profile_report_main(int argc, char** argv) {
+    profile_report_params params;
+    params.content_path     = "content/";
+    params.ticks            = 1000;
+    params.entities         = 10000;
+    params.actions_per_tick = 16;
+
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            params.ticks = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--entities") == 0 && i + 1 < argc) {
+            params.entities = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--actions") == 0 && i + 1 < argc) {
+            params.actions_per_tick = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            printf("usage: axiom_headless profile [--ticks N] [--entities N] [--actions D]\n");
+            return 2;
+        }
+    }
+
+    printf("=== Axiom Tick Profile: %u ticks, %u entities, %u actions/tick ===\n\n",
+           params.ticks, params.entities, params.actions_per_tick);
+
+    profile_report_result res;
+    if (!profile_report_run(params, &res)) {
+        printf("  FAILED: %zu / %u ticks profiled\n", res.ticks.size(), params.ticks);
+        return 1;
+    }
+
+    std::vector<uint64_t> samples;
+    uint64_t tick_total = 0;
+    for (const ax_profile_tick_v1& t : res.ticks) tick_total += t.total_ns;
+
+    printf("  %-18s %10s %10s %10s %7s\n", "phase", "mean (us)", "p99 (us)", "max (us)", "share");
+    for (uint32_t p = 0; p <= AX_PROFILE_PHASE_COUNT; ++p) {
+        samples.clear();
+        uint64_t sum = 0;
+        for (const ax_profile_tick_v1& t : res.ticks) {
+            uint64_t ns = p < AX_PROFILE_PHASE_COUNT ? t.phase_ns[p] : t.total_ns;
+            samples.push_back(ns);
+            sum += ns;
+        }
+        double mean = samples.empty() ? 0.0 : (double)sum / (double)samples.size() / 1000.0;
+        printf("  %-18s %10.2f %10.2f %10.2f %6.1f%%\n",
+               p < AX_PROFILE_PHASE_COUNT ? PHASE_NAMES[p] : "tick total",
+               mean, percentile_us(samples, 0.99), percentile_us(samples, 1.0),
+               tick_total ? 100.0 * (double)sum / (double)tick_total : 0.0);
+    }
+
+    printf("\n  %-18s %10s %10s %10s\n", "entry point", "calls", "mean (us)", "max (us)");
+    for (uint32_t c = 0; c < AX_PROFILE_CALL_COUNT; ++c) {
+        const ax_profile_call_v1& call = res.calls[c];
+        if (call.count == 0) continue;
+        printf("  %-18s %10llu %10.2f %10.2f\n", CALL_NAMES[c], (unsigned long long)call.count,
+               (double)call.total_ns / (double)call.count / 1000.0, (double)call.max_ns / 1000.0);
+    }
+    return 0;
+}
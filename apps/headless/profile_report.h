@@ -0,0 +1,37 @@
+/*
+ * profile_report.h — Per-phase tick profile of a synthetic workload
+ *
+ * `axiom_headless profile [--ticks N] [--entities N] [--actions D]`
+ *
+ * Tops the A1 world up to N entities with debug-spawned targets, turns
+ * on the core profiler (ax_set_profiling) and steps with D player
+ * actions per tick (LOOK / MOVE / FIRE mix). The per-tick ring is read
+ * back every AX_PROFILE_RING_TICKS ticks so no record is lost, then the
+ * report shows, per tick phase, mean / p99 / max time and share of the
+ * tick, and per entry point, calls and mean / max time.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+#include <vector>
+
+struct profile_report_params {
+    const char* content_path;
+    uint32_t    ticks;
+    uint32_t    entities;
+    uint32_t    actions_per_tick;
+};
+
+struct profile_report_result {
+    bool                            ok;
+    std::vector<ax_profile_tick_v1> ticks;      /* every profiled tick, in order */
+    ax_profile_call_v1              calls[AX_PROFILE_MAX_CALLS];
+};
+
+bool profile_report_run(const profile_report_params& params, profile_report_result* out);
+
+/* CLI entry point: argv = { [--ticks N] [--entities N] [--actions D] } */
+int profile_report_main(int argc, char** argv);
@@ -0,0 +1,265 @@
+/*
+ * raycast_bench.cpp — Collision BVH build and raycast throughput benchmark
+ *
+ * See raycast_bench.h.
+ */
+
+#include "raycast_bench.h"
+#include "shell_common.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static const uint32_t WIDTHS[3] = { 1, 4, 8 };
+
+/* traces keep going until at least this long, for a stable rate */
+static const double MIN_TRACE_SECONDS = 0.2;
+
+struct mesh_bounds {
+    float min[3], max[3];
+};
+
+static mesh_bounds bounds_of(const mesh_data& mesh) {
+    mesh_bounds b = { { INFINITY, INFINITY, INFINITY }, { -INFINITY, -INFINITY, -INFINITY } };
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        float v = mesh.vertices[i];
+        b.min[i % 3] = std::fmin(b.min[i % 3], v);
+        b.max[i % 3] = std::fmax(b.max[i % 3], v);
+    }
+    if (mesh.vertices.empty()) {
+        for (int a = 0; a < 3; ++a) b.min[a] = b.max[a] = 0.0f;
+    }
+    return b;
+}
+
+void raycast_bench_camera_rays(const mesh_data& mesh, uint32_t count, std::vector<ax_ray_v1>* out) {
+    mesh_bounds b = bounds_of(mesh);
+    float cx = (b.min[0] + b.max[0]) * 0.5f;
+    float extent = std::fmax(b.max[0] - b.min[0], b.max[2] - b.min[2]);
+
+    /* above one edge, looking across the level and down */
+    float eye[3] = { cx, b.max[1] + extent * 0.1f, b.max[2] };
+    float fwd[3] = { 0.0f, -0.35f, -1.0f };
+
+    uint32_t tiles_x = 64;
+    uint32_t tiles   = (count + 7) / 8;
+    uint32_t tiles_y = (tiles + tiles_x - 1) / tiles_x;
+    uint32_t w = tiles_x * 4, h = tiles_y * 2;
+    out->clear();
+    out->reserve((size_t)tiles_x * tiles_y * 8);
+    for (uint32_t ty = 0; ty < tiles_y; ++ty) {
+        for (uint32_t tx = 0; tx < tiles_x; ++tx) {
+            for (uint32_t k = 0; k < 8; ++k) {
+                uint32_t px = tx * 4 + (k & 3), py = ty * 2 + (k >> 2);
+                float u = ((float)px + 0.5f) / (float)w * 2.0f - 1.0f;
+                float v = ((float)py + 0.5f) / (float)h * 2.0f - 1.0f;
+                ax_ray_v1 r = {};
+                r.ox = eye[0];  r.oy = eye[1];  r.oz = eye[2];
+                r.dx = fwd[0] + u * 0.8f;
+                r.dy = fwd[1] - v * 0.45f;
+                r.dz = fwd[2];
+                r.max_t = extent * 4.0f;
+                out->push_back(r);
+            }
+        }
+    }
+    out->resize(count);
+}
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+void raycast_bench_random_rays(const mesh_data& mesh, uint32_t count, uint64_t seed,
+                               std::vector<ax_ray_v1>* out) {
+    mesh_bounds b = bounds_of(mesh);
+    float extent = std::fmax(b.max[0] - b.min[0], b.max[2] - b.min[2]);
+    uint64_t s = splitmix64(seed);
+    auto next = [&s]() {
+        s = splitmix64(s);
+        return (float)(s >> 40) * (1.0f / 16777216.0f);
+    };
+    out->resize(count);
+    for (ax_ray_v1& r : *out) {
+        r.ox = b.min[0] + next() * (b.max[0] - b.min[0]);
+        r.oy = b.min[1] + next() * (b.max[1] - b.min[1]) + 1.0f;
+        r.oz = b.min[2] + next() * (b.max[2] - b.min[2]);
+        r.dx = next() * 2.0f - 1.0f;
+        r.dy = next() * 2.0f - 1.0f;
+        r.dz = next() * 2.0f - 1.0f;
+        r.max_t = extent;
+    }
+}
+
+/* Traces `rays` at `width` until MIN_TRACE_SECONDS; returns Mrays/s. */
+static double trace_rate(ax_core* core, const std::vector<ax_ray_v1>& rays, uint32_t width,
+                         std::vector<ax_ray_hit_v1>* hits, bool* ok) {
+    ax_raycast_params_v1 p = {};
+    p.version      = 1;
+    p.size_bytes   = sizeof(p);
+    p.packet_width = width;
+    hits->resize(rays.size());
+
+    uint64_t traced = 0;
+    bench_clock::time_point t0 = bench_clock::now();
+    double seconds = 0.0;
+    do {
+        if (ax_raycast(core, &p, rays.data(), (uint32_t)rays.size(), hits->data()) != AX_OK) {
+            *ok = false;
+            return 0.0;
+        }
+        traced += rays.size();
+        seconds = std::chrono::duration<double>(bench_clock::now() - t0).count();
+    } while (seconds < MIN_TRACE_SECONDS);
+    return seconds > 0.0 ? (double)traced / seconds * 1e-6 : 0.0;
+}
+
+static double hit_rate(const std::vector<ax_ray_hit_v1>& hits) {
+    size_t n = 0;
+    for (const auto& h : hits) n += h.triangle != AX_RAY_NO_HIT;
+    return hits.empty() ? 0.0 : (double)n / (double)hits.size();
+}
+
+bool raycast_bench_run(const raycast_bench_params& params, const mesh_data& mesh,
+                       raycast_bench_result* out) {
+    std::memset(out, 0, sizeof(*out));
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_threading_params_v1 tp = {};
+    tp.version      = 1;
+    tp.size_bytes   = sizeof(tp);
+    tp.worker_count = params.workers;
+    ax_collision_info_v1 info = {};
+    info.version    = 1;
+    info.size_bytes = sizeof(info);
+    if (ax_set_threading(core, &tp) != AX_OK || mesh_upload(core, mesh) != AX_OK ||
+        ax_get_collision_info(core, &info) != AX_OK) {
+        printf("  raycast_bench: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+    out->build_ms = info.build_ms;
+    out->nodes    = info.node_count;
+    out->leaves   = info.leaf_count;
+    out->depth    = info.depth;
+
+    std::vector<ax_ray_v1> coherent, incoherent;
+    raycast_bench_camera_rays(mesh, params.rays, &coherent);
+    raycast_bench_random_rays(mesh, params.rays, 1, &incoherent);
+
+    bool ok = true;
+    out->widths_agree = true;
+    std::vector<ax_ray_hit_v1> ref[2], hits;
+    for (uint32_t w = 0; w < 3 && ok; ++w) {
+        out->coherent_mrays[w]   = trace_rate(core, coherent, WIDTHS[w], &hits, &ok);
+        if (w == 0) ref[0] = hits;
+        out->widths_agree = out->widths_agree && hits.size() == ref[0].size() &&
+            std::memcmp(hits.data(), ref[0].data(), hits.size() * sizeof(ax_ray_hit_v1)) == 0;
+
+        out->incoherent_mrays[w] = trace_rate(core, incoherent, WIDTHS[w], &hits, &ok);
+        if (w == 0) ref[1] = hits;
+        out->widths_agree = out->widths_agree && hits.size() == ref[1].size() &&
+            std::memcmp(hits.data(), ref[1].data(), hits.size() * sizeof(ax_ray_hit_v1)) == 0;
+    }
+    if (!ok) printf("  raycast_bench: %s\n", ax_get_last_error());
+    out->coherent_hit_rate   = hit_rate(ref[0]);
+    out->incoherent_hit_rate = hit_rate(ref[1]);
+
+    ax_destroy(core);
+    out->ok = ok && out->widths_agree;
+    return out->ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static int usage() {
+    printf("usage: axiom_headless raycast-bench [--mesh FILE.obj] [--cells N] [--rays N]"
+           " [--workers W1,W2,..]\n");
+    return 2;
+}
+
+int raycast_bench_main(int argc, char** argv) {
+    const char*           mesh_path = nullptr;
+    uint32_t              cells     = 512;
+    uint32_t              rays      = 1u << 18;
+    std::vector<uint32_t> workers   = { 1, 4 };
+
+    for (int i = 0; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--mesh") == 0 && has_value) {
+            mesh_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--cells") == 0 && has_value) {
+            cells = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--rays") == 0 && has_value) {
+            rays = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && has_value) {
+            workers.clear();
+            for (const char* s = argv[++i]; *s;) {
+                char* end = nullptr;
+                workers.push_back((uint32_t)std::strtoul(s, &end, 10));
+                if (end == s) return usage();
+                s = (*end == ',') ? end + 1 : end;
+            }
+        } else {
+            return usage();
+        }
+    }
+    if (rays == 0 || workers.empty()) return usage();
+
+    mesh_data mesh;
+    if (mesh_path) {
+        std::string error;
+        if (!mesh_load_obj(mesh_path, &mesh, &error)) {
+            printf("  FAILED: %s: %s\n", mesh_path, error.c_str());
+            return 1;
+        }
+    } else {
+        mesh_make_level(cells, 2.0f * (float)cells, 1, &mesh);
+    }
+
+    printf("=== Axiom Raycast Bench: %u triangles, %u rays per set ===\n\n",
+           mesh.triangle_count(), rays);
+
+    raycast_bench_result first = {};
+    bool same_tree = true;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        raycast_bench_params p = { "content/", rays, workers[i] };
+        raycast_bench_result r;
+        if (!raycast_bench_run(p, mesh, &r)) {
+            printf("  FAILED%s\n", r.widths_agree ? "" : ": packet widths disagree");
+            return 1;
+        }
+        printf("  build     %2u workers %9.1f ms   nodes %u, leaves %u, depth %u\n",
+               workers[i], r.build_ms, r.nodes, r.leaves, r.depth);
+        if (i == 0) {
+            first = r;
+        } else {
+            same_tree = same_tree && r.nodes == first.nodes && r.leaves == first.leaves &&
+                        r.depth == first.depth;
+        }
+    }
+    if (!same_tree) {
+        printf("  FAILED: builds differ between worker counts\n");
+        return 1;
+    }
+
+    printf("\n  %-11s %12s %12s %12s %8s\n", "rays", "width 1", "width 4", "width 8", "hits");
+    printf("  %-11s %7.2f Mr/s %7.2f Mr/s %7.2f Mr/s %7.1f%%\n", "coherent",
+           first.coherent_mrays[0], first.coherent_mrays[1], first.coherent_mrays[2],
+           first.coherent_hit_rate * 100.0);
+    printf("  %-11s %7.2f Mr/s %7.2f Mr/s %7.2f Mr/s %7.1f%%\n", "incoherent",
+           first.incoherent_mrays[0], first.incoherent_mrays[1], first.incoherent_mrays[2],
+           first.incoherent_hit_rate * 100.0);
+    printf("\n  closest hits identical across packet widths\n");
+    return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * raycast_bench.h — Collision BVH build and raycast throughput benchmark
+ *
+ * `axiom_headless raycast-bench [--mesh FILE.obj] [--cells N] [--rays N]
+ *                              [--workers W1,W2,..]`
+ *
+ * Loads a mesh (an OBJ file, or mesh_make_level with N x N cells) into
+ * one core per worker count and reports the BVH build time, node, leaf
+ * and depth figures, and whether every build produced the same tree.
+ * Then traces two ray sets at packet widths 1, 4 and 8 on the calling
+ * thread and reports rays/sec:
+ *
+ *   coherent    a pinhole camera over the level, one 4x2 pixel tile per
+ *               8 consecutive rays (what a packet is built for)
+ *   incoherent  seeded random origins and directions
+ *
+ * Closest hits must be identical across widths; the run fails if not.
+ */
+
+#pragma once
+
+#include "mesh_import.h"
+
+#include <cstdint>
+
+struct raycast_bench_params {
+    const char* content_path;
+    uint32_t    rays;               /* per ray set */
+    uint32_t    workers;            /* build threading */
+};
+
+struct raycast_bench_result {
+    bool     ok;
+    double   build_ms;
+    uint32_t nodes, leaves, depth;
+    double   coherent_mrays[3];     /* widths 1, 4, 8 */
+    double   incoherent_mrays[3];
+    double   coherent_hit_rate;
+    double   incoherent_hit_rate;
+    bool     widths_agree;
+};
+
+/* Camera rays in 4x2 tiles over the level's bounds, `count` rounded to tiles. */
+void raycast_bench_camera_rays(const mesh_data& mesh, uint32_t count, std::vector<ax_ray_v1>* out);
+
+/* Seeded rays from inside the level's bounds in random directions. */
+void raycast_bench_random_rays(const mesh_data& mesh, uint32_t count, uint64_t seed,
+                               std::vector<ax_ray_v1>* out);
+
+bool raycast_bench_run(const raycast_bench_params& params, const mesh_data& mesh,
+                       raycast_bench_result* out);
+
+/* CLI entry point: argv = { flags as above } */
+int raycast_bench_main(int argc, char** argv);
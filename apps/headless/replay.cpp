@@ -0,0 +1,911 @@
+/*
+ * replay.cpp — Binary input recordings and max-speed replay
+ *
+ * See replay.h.
+ */
+
+#include "replay.h"
+#include "shell_common.h"
+#include "worldgen.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/* ── Encoding ─────────────────────────────────────────────────────── */
+
+namespace {
+
+struct byte_writer {
+    std::vector<uint8_t>* out;
+
+    void u8(uint8_t v) { out->push_back(v); }
+    void u16(uint16_t v) {
+        u8((uint8_t)v);
+        u8((uint8_t)(v >> 8));
+    }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) u8((uint8_t)(v >> (8 * i)));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) u8((uint8_t)(v >> (8 * i)));
+    }
+    void f32(float v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        u32(bits);
+    }
+    void varint(uint64_t v) {
+        while (v >= 0x80) {
+            u8((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        u8((uint8_t)v);
+    }
+    void zigzag(int64_t v) { varint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); }
+    void bytes(const void* p, size_t n) {
+        const uint8_t* b = (const uint8_t*)p;
+        out->insert(out->end(), b, b + n);
+    }
+};
+
+/* Every read checks bounds; after a failed read ok stays false. */
+struct byte_reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool           ok;
+
+    bool take(size_t n) {
+        if (!ok || (size_t)(end - p) < n) {
+            ok = false;
+            return false;
+        }
+        return true;
+    }
+    uint8_t u8() {
+        if (!take(1)) return 0;
+        return *p++;
+    }
+    uint16_t u16() {
+        if (!take(2)) return 0;
+        uint16_t v = (uint16_t)(p[0] | (p[1] << 8));
+        p += 2;
+        return v;
+    }
+    uint32_t u32() {
+        if (!take(4)) return 0;
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+        p += 4;
+        return v;
+    }
+    uint64_t u64() {
+        if (!take(8)) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= (uint64_t)p[i] << (8 * i);
+        p += 8;
+        return v;
+    }
+    float f32() {
+        uint32_t bits = u32();
+        float v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t b = u8();
+            if (!ok) return 0;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;     /* more than 10 bytes */
+        return 0;
+    }
+    int64_t zigzag() {
+        uint64_t v = varint();
+        return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+    }
+};
+
+} // namespace
+
+static void encode_action(byte_writer& w, const ax_action_v1& a, uint64_t submit_tick) {
+    w.u8((uint8_t)a.type);
+    w.varint(a.actor_id);
+    w.zigzag((int64_t)(a.tick - submit_tick));
+    switch (a.type) {
+        case AX_ACT_MOVE_INTENT:
+            w.f32(a.u.move.x);
+            w.f32(a.u.move.y);
+            break;
+        case AX_ACT_LOOK_INTENT:
+            w.f32(a.u.look.yaw);
+            w.f32(a.u.look.pitch);
+            break;
+        case AX_ACT_FIRE_ONCE:
+            w.varint(a.u.fire_once.weapon_slot);
+            break;
+        case AX_ACT_RELOAD:
+            w.varint(a.u.reload.weapon_slot);
+            break;
+        case AX_ACT_SPRINT_HELD:
+            w.u8(a.u.sprint_held.held);
+            break;
+        default:    /* AX_ACT_CROUCH_TOGGLE; the core rejects anything else */
+            w.u8(a.u.crouch_toggle.unused);
+            break;
+    }
+}
+
+static bool decode_action(byte_reader& r, uint64_t submit_tick, ax_action_v1* a) {
+    *a = {};
+    a->type     = r.u8();
+    a->actor_id = (uint32_t)r.varint();
+    a->tick     = submit_tick + (uint64_t)r.zigzag();
+    switch (a->type) {
+        case AX_ACT_MOVE_INTENT:
+            a->u.move.x = r.f32();
+            a->u.move.y = r.f32();
+            break;
+        case AX_ACT_LOOK_INTENT:
+            a->u.look.yaw   = r.f32();
+            a->u.look.pitch = r.f32();
+            break;
+        case AX_ACT_FIRE_ONCE:
+            a->u.fire_once.weapon_slot = (uint32_t)r.varint();
+            break;
+        case AX_ACT_RELOAD:
+            a->u.reload.weapon_slot = (uint32_t)r.varint();
+            break;
+        case AX_ACT_SPRINT_HELD:
+            a->u.sprint_held.held = r.u8();
+            break;
+        case AX_ACT_CROUCH_TOGGLE:
+            a->u.crouch_toggle.unused = r.u8();
+            break;
+        default:
+            return false;
+    }
+    return r.ok;
+}
+
+#define REPLAY_TAG_KEYFRAME    0xFF
+#define REPLAY_INDEX_ENTRY_BYTES 28
+
+/* Earliest action at or after `from` still queued after `tick` ticks. */
+static uint32_t first_pending(const std::vector<ax_action_v1>& actions, uint32_t from,
+                              uint32_t end, uint64_t tick) {
+    while (from < end && actions[from].tick <= tick) {
+        from++;
+    }
+    return from;
+}
+
+void replay_encode(const replay_data& r, std::vector<uint8_t>* out) {
+    /* body: actions with the keyframes spliced in where they were taken */
+    std::vector<uint8_t> body;
+    std::vector<uint64_t> blob_offsets;
+    byte_writer bw = { &body };
+    uint64_t prev = r.start_tick;
+    size_t   k    = 0;
+    for (size_t i = 0; i <= r.actions.size(); ++i) {
+        for (; k < r.keyframes.size() && r.keyframes[k].first_action == i; ++k) {
+            const replay_keyframe& kf = r.keyframes[k];
+            bw.varint(kf.tick - prev);
+            bw.u8(REPLAY_TAG_KEYFRAME);
+            bw.u32(kf.size);
+            blob_offsets.push_back(body.size());
+            bw.bytes(&r.keyframe_bytes[kf.offset], kf.size);
+            prev = kf.tick;
+        }
+        if (i == r.actions.size()) {
+            break;
+        }
+        bw.varint(r.submit_ticks[i] - prev);
+        encode_action(bw, r.actions[i], r.submit_ticks[i]);
+        prev = r.submit_ticks[i];
+    }
+
+    out->clear();
+    out->reserve(REPLAY_HEADER_BYTES + r.start_save.size() + body.size() + 4 +
+                 r.keyframes.size() * REPLAY_INDEX_ENTRY_BYTES);
+    byte_writer w = { out };
+    w.bytes(REPLAY_MAGIC, 4);
+    w.u16(REPLAY_FORMAT_VERSION);
+    w.u16(0);
+    w.u16(r.abi_major);
+    w.u16(r.abi_minor);
+    w.u32((uint32_t)r.start_save.size());
+    w.u64(r.content_hash);
+    w.u64(r.start_tick);
+    w.u64(r.end_tick);
+    w.u64(r.final_hash);
+    w.u32((uint32_t)r.actions.size());
+    w.u32((uint32_t)body.size());
+    w.bytes(r.start_save.data(), r.start_save.size());
+    uint64_t body_offset = out->size();
+    w.bytes(body.data(), body.size());
+
+    /* seek index */
+    w.u32((uint32_t)r.keyframes.size());
+    for (size_t i = 0; i < r.keyframes.size(); ++i) {
+        const replay_keyframe& kf = r.keyframes[i];
+        w.u64(kf.tick);
+        w.u64(body_offset + blob_offsets[i]);
+        w.u32(kf.size);
+        w.u32(kf.first_action);
+        w.u32(kf.pending_first);
+    }
+}
+
+bool replay_decode(const uint8_t* bytes, size_t size, replay_data* out, std::string* error) {
+    byte_reader r = { bytes, bytes + size, true };
+    if (size < REPLAY_HEADER_BYTES || std::memcmp(bytes, REPLAY_MAGIC, 4) != 0) {
+        *error = "not a replay file (bad magic or short header)";
+        return false;
+    }
+    r.p += 4;
+    uint16_t version = r.u16();
+    r.u16();    /* flags */
+    if (version < 1 || version > REPLAY_FORMAT_VERSION) {
+        *error = "unsupported replay format version " + std::to_string(version);
+        return false;
+    }
+
+    *out = {};
+    out->abi_major    = r.u16();
+    out->abi_minor    = r.u16();
+    uint32_t save_size = r.u32();
+    out->content_hash = r.u64();
+    out->start_tick   = r.u64();
+    out->end_tick     = r.u64();
+    out->final_hash   = r.u64();
+    uint32_t count     = r.u32();
+    uint32_t body_size = r.u32();
+
+    /* v1 ends with the body; v2 adds the seek index after it */
+    size_t rest = (size_t)(r.end - r.p);
+    size_t need = (size_t)save_size + body_size;
+    if (version == 1 ? rest != need : rest < need + 4) {
+        *error = "replay size does not match its header (truncated or trailing bytes)";
+        return false;
+    }
+    if (out->end_tick < out->start_tick) {
+        *error = "replay ends before it starts";
+        return false;
+    }
+    out->start_save.assign(r.p, r.p + save_size);
+    r.p += save_size;
+
+    /* an action takes at least 4 bytes, which bounds the reservation */
+    if (count > body_size / 4) {
+        *error = "replay action count does not fit its body";
+        return false;
+    }
+    out->actions.resize(count);
+    out->submit_ticks.resize(count);
+    std::vector<uint64_t> blob_offsets;
+    const uint8_t* body_end = r.p + body_size;
+    byte_reader body = { r.p, body_end, true };
+    uint64_t tick     = out->start_tick;
+    uint32_t n        = 0;
+    uint32_t pending  = 0;
+    while (body.ok && body.p < body_end) {
+        tick += body.varint();
+        if (tick > out->end_tick) {
+            body.ok = false;
+        } else if (body.p < body_end && *body.p == REPLAY_TAG_KEYFRAME) {
+            body.p++;
+            uint32_t blob = body.u32();
+            if (!body.take(blob) || version == 1) {
+                body.ok = false;
+                break;
+            }
+            pending = first_pending(out->actions, pending, n, tick);
+            blob_offsets.push_back((uint64_t)(body.p - bytes));
+            out->keyframes.push_back({ tick, n, pending, out->keyframe_bytes.size(), blob });
+            out->keyframe_bytes.insert(out->keyframe_bytes.end(), body.p, body.p + blob);
+            body.p += blob;
+        } else if (n < count && decode_action(body, tick, &out->actions[n])) {
+            out->submit_ticks[n++] = tick;
+        } else {
+            body.ok = false;
+        }
+    }
+    if (!body.ok || n != count) {
+        *error = "replay body is malformed at action " + std::to_string(n);
+        return false;
+    }
+    r.p = body_end;
+    if (version == 1) {
+        return true;
+    }
+
+    uint32_t keyframes = r.u32();
+    if ((size_t)(r.end - r.p) != (size_t)keyframes * REPLAY_INDEX_ENTRY_BYTES ||
+        keyframes != out->keyframes.size()) {
+        *error = "replay seek index does not match its body";
+        return false;
+    }
+    for (uint32_t i = 0; i < keyframes; ++i) {
+        const replay_keyframe& kf = out->keyframes[i];
+        uint64_t kf_tick   = r.u64();
+        uint64_t kf_offset = r.u64();
+        uint32_t kf_size   = r.u32();
+        uint32_t kf_first  = r.u32();
+        uint32_t kf_pend   = r.u32();
+        if (kf_tick != kf.tick || kf_offset != blob_offsets[i] || kf_size != kf.size ||
+            kf_first != kf.first_action || kf_pend != kf.pending_first) {
+            *error = "replay seek index entry " + std::to_string(i) + " does not match its body";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool replay_write_file(const char* path, const replay_data& r) {
+    std::vector<uint8_t> bytes;
+    replay_encode(r, &bytes);
+    FILE* f = fopen(path, "wb");
+    bool written = f && fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    written = f && fclose(f) == 0 && written;
+    return written;
+}
+
+bool replay_read_file(const char* path, replay_data* out, std::string* error) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        *error = std::string("cannot open ") + path;
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        bytes.insert(bytes.end(), buf, buf + n);
+    }
+    bool read_ok = !ferror(f);
+    fclose(f);
+    if (!read_ok) {
+        *error = std::string("cannot read ") + path;
+        return false;
+    }
+    return replay_decode(bytes.data(), bytes.size(), out, error);
+}
+
+/* ── Recording ────────────────────────────────────────────────────── */
+
+static bool current_tick(ax_core* core, uint64_t* out_tick) {
+    std::vector<uint8_t> snap = take_snapshot(core);
+    if (snap.empty()) {
+        return false;
+    }
+    *out_tick = parse_snapshot(snap.data(), (uint32_t)snap.size()).header->tick;
+    return true;
+}
+
+bool replay_recorder::begin(ax_core* core, bool embed_start_state, uint32_t keyframe_interval) {
+    data_          = {};
+    core_          = core;
+    interval_      = keyframe_interval;
+    pending_first_ = 0;
+    data_.abi_major = AX_ABI_MAJOR;
+    data_.abi_minor = AX_ABI_MINOR;
+    if (ax_get_content_hash(core, &data_.content_hash) != AX_OK || !current_tick(core, &tick_)) {
+        core_ = nullptr;
+        return false;
+    }
+    data_.start_tick = tick_;
+    next_keyframe_   = tick_ + interval_;
+    if (embed_start_state) {
+        data_.start_save = take_save(core);
+        if (data_.start_save.empty()) {
+            core_ = nullptr;
+            return false;
+        }
+    } else if (interval_ > 0 && !add_keyframe()) {
+        /* the start keyframe lets seek return to a fresh-content start */
+        core_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool replay_recorder::add_keyframe() {
+    std::vector<uint8_t> save = take_save(core_);
+    if (save.empty()) {
+        return false;
+    }
+    uint32_t n = (uint32_t)data_.actions.size();
+    pending_first_ = first_pending(data_.actions, pending_first_, n, tick_);
+    data_.keyframes.push_back({ tick_, n, pending_first_, data_.keyframe_bytes.size(),
+                                (uint32_t)save.size() });
+    data_.keyframe_bytes.insert(data_.keyframe_bytes.end(), save.begin(), save.end());
+    return true;
+}
+
+ax_result replay_recorder::submit_actions(const ax_action_batch_v1* batch) {
+    ax_result r = ax_submit_actions(core_, batch);
+    if (r == AX_OK) {
+        data_.actions.insert(data_.actions.end(), batch->actions, batch->actions + batch->count);
+        data_.submit_ticks.insert(data_.submit_ticks.end(), batch->count, tick_);
+    }
+    return r;
+}
+
+ax_result replay_recorder::step_ticks(uint32_t n_ticks) {
+    if (interval_ == 0) {
+        ax_result r = ax_step_ticks(core_, n_ticks);
+        if (r == AX_OK) {
+            tick_ += n_ticks;
+        }
+        return r;
+    }
+
+    /* split at keyframe ticks; stepping in pieces gives the same world */
+    while (n_ticks > 0) {
+        uint64_t gap = next_keyframe_ - tick_;
+        uint32_t n   = gap < n_ticks ? (uint32_t)gap : n_ticks;
+        ax_result r = ax_step_ticks(core_, n);
+        if (r != AX_OK) {
+            return r;
+        }
+        tick_   += n;
+        n_ticks -= n;
+        if (tick_ == next_keyframe_) {
+            if (!add_keyframe()) {
+                return AX_ERR_INTERNAL;
+            }
+            next_keyframe_ += interval_;
+        }
+    }
+    return AX_OK;
+}
+
+bool replay_recorder::finish(replay_data* out) {
+    if (!core_ || ax_get_state_hash(core_, &data_.final_hash) != AX_OK) {
+        return false;
+    }
+    data_.end_tick = tick_;
+    *out = data_;
+    return true;
+}
+
+/* ── Playback ─────────────────────────────────────────────────────── */
+
+/* current_tick through a core_api: the player may drive a loaded core */
+static bool api_tick(const core_api* api, ax_core* core, uint64_t* out_tick) {
+    uint32_t size = 0;
+    api->get_snapshot_bytes(core, nullptr, 0, &size);
+    std::vector<uint8_t> snap(size);
+    if (size == 0 || api->get_snapshot_bytes(core, snap.data(), size, &size) != AX_OK) {
+        return false;
+    }
+    *out_tick = parse_snapshot(snap.data(), size).header->tick;
+    return true;
+}
+
+bool replay_player::start(ax_core* core, std::string* error) {
+    if (r_.abi_major != AX_ABI_MAJOR) {
+        *error = "recorded with ABI major " + std::to_string(r_.abi_major) +
+                 ", this shell is " + std::to_string(AX_ABI_MAJOR);
+        return false;
+    }
+    uint64_t content_hash = 0;
+    if (api_->get_content_hash(core, &content_hash) != AX_OK) {
+        *error = api_->get_last_error();
+        return false;
+    }
+    if (content_hash != r_.content_hash) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "content hash 0x%016llX, recording expects 0x%016llX",
+                 (unsigned long long)content_hash, (unsigned long long)r_.content_hash);
+        *error = msg;
+        return false;
+    }
+    if (!r_.start_save.empty() &&
+        api_->load_save_bytes(core, r_.start_save.data(), (uint32_t)r_.start_save.size()) != AX_OK) {
+        *error = std::string("start state: ") + api_->get_last_error();
+        return false;
+    }
+    uint64_t tick = 0;
+    if (!api_tick(api_, core, &tick) || tick != r_.start_tick) {
+        *error = "core is not at the recording's start tick " + std::to_string(r_.start_tick);
+        return false;
+    }
+    core_ = core;
+    tick_ = r_.start_tick;
+    next_ = 0;
+    return true;
+}
+
+ax_result replay_player::run_to(uint64_t tick) {
+    if (tick > r_.end_tick) {
+        tick = r_.end_tick;
+    }
+    while (tick_ < tick) {
+        /* this tick's submissions in one batch: queue order is unchanged */
+        size_t first = next_;
+        while (next_ < r_.actions.size() && r_.submit_ticks[next_] == tick_) {
+            next_++;
+        }
+        if (next_ > first) {
+            ax_action_batch_v1 batch = {};
+            batch.version    = 1;
+            batch.size_bytes = sizeof(batch);
+            batch.count      = (uint32_t)(next_ - first);
+            batch.actions    = &r_.actions[first];
+            ax_result r = api_->submit_actions(core_, &batch);
+            if (r != AX_OK) {
+                return r;
+            }
+        }
+
+        /* then everything up to the next submission in one step */
+        uint64_t stop = next_ < r_.actions.size() && r_.submit_ticks[next_] < tick
+                      ? r_.submit_ticks[next_] : tick;
+        uint64_t n = stop - tick_;
+        if (n > UINT32_MAX) {
+            n = UINT32_MAX;
+        }
+        ax_result r = api_->step_ticks(core_, (uint32_t)n);
+        if (r != AX_OK) {
+            return r;
+        }
+        tick_ += n;
+    }
+    return AX_OK;
+}
+
+ax_result replay_player::seek(uint64_t tick) {
+    tick = tick < r_.start_tick ? r_.start_tick : tick > r_.end_tick ? r_.end_tick : tick;
+
+    /*
+     * Latest keyframe strictly before the target, so at least one tick
+     * is simulated after the load and the target tick's events exist;
+     * the start keyframe also serves a seek to the start itself.
+     */
+    const replay_keyframe* kf = nullptr;
+    size_t lo = 0, hi = r_.keyframes.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (r_.keyframes[mid].tick < tick) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo > 0) {
+        kf = &r_.keyframes[lo - 1];
+    } else if (!r_.keyframes.empty() && r_.keyframes[0].tick == r_.start_tick) {
+        kf = &r_.keyframes[0];
+    }
+
+    /* already between that keyframe and the target: just run forward */
+    uint64_t base = kf ? kf->tick : r_.start_tick;
+    if (tick_ >= base && tick_ <= tick) {
+        return run_to(tick);
+    }
+
+    if (kf) {
+        ax_result r = api_->load_save_bytes(core_, &r_.keyframe_bytes[kf->offset], kf->size);
+        if (r != AX_OK) {
+            return r;
+        }
+        tick_ = kf->tick;
+        next_ = kf->first_action;
+        r = requeue_pending(kf->pending_first);
+        if (r != AX_OK) {
+            return r;
+        }
+    } else if (!r_.start_save.empty()) {
+        ax_result r = api_->load_save_bytes(core_, r_.start_save.data(), (uint32_t)r_.start_save.size());
+        if (r != AX_OK) {
+            return r;
+        }
+        tick_ = r_.start_tick;
+        next_ = 0;
+    } else {
+        return AX_ERR_BAD_STATE;
+    }
+    return run_to(tick);
+}
+
+ax_result replay_player::restore(const void* save, uint32_t size, uint64_t tick) {
+    if (tick < r_.start_tick || tick > r_.end_tick) {
+        return AX_ERR_INVALID_ARG;
+    }
+    ax_result r = api_->load_save_bytes(core_, save, size);
+    if (r != AX_OK) {
+        return r;
+    }
+    tick_ = tick;
+    next_ = (size_t)(std::lower_bound(r_.submit_ticks.begin(), r_.submit_ticks.end(), tick) -
+                     r_.submit_ticks.begin());
+
+    /* nothing before the latest keyframe's pending_first is still queued */
+    uint32_t from = 0;
+    for (const replay_keyframe& kf : r_.keyframes) {
+        if (kf.tick > tick) {
+            break;
+        }
+        from = kf.pending_first;
+    }
+    return requeue_pending(from);
+}
+
+/* Saves do not carry the action queue: put back what was pending at tick_. */
+ax_result replay_player::requeue_pending(size_t from) {
+    requeue_.clear();
+    for (size_t i = from; i < next_; ++i) {
+        if (r_.actions[i].tick > tick_) {
+            requeue_.push_back(r_.actions[i]);
+        }
+    }
+    if (requeue_.empty()) {
+        return AX_OK;
+    }
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = (uint32_t)requeue_.size();
+    batch.actions    = requeue_.data();
+    return api_->submit_actions(core_, &batch);
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/* splitmix64: the synthetic session is a pure function of the seed */
+static uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static float random_unit(uint64_t* state) {
+    return (float)(next_random(state) >> 40) * (2.0f / 16777216.0f) - 1.0f;     /* [-1, 1) */
+}
+
+/* A player wandering, turning, firing and reloading at random. */
+static ax_action_v1 random_action(uint64_t* rng, uint64_t tick) {
+    ax_action_v1 a = {};
+    a.tick     = tick;
+    a.actor_id = 1;
+    uint32_t roll = (uint32_t)(next_random(rng) % 16);
+    if (roll < 6) {
+        a.type     = AX_ACT_MOVE_INTENT;
+        a.u.move.x = random_unit(rng);
+        a.u.move.y = random_unit(rng);
+    } else if (roll < 9) {
+        a.type         = AX_ACT_LOOK_INTENT;
+        a.u.look.yaw   = random_unit(rng) * 0.1f;
+        a.u.look.pitch = random_unit(rng) * 0.05f;
+    } else if (roll < 15) {
+        a.type = AX_ACT_FIRE_ONCE;
+    } else {
+        a.type = AX_ACT_RELOAD;
+    }
+    return a;
+}
+
+static int record_usage() {
+    printf("usage: axiom_headless record <file> [--ticks N] [--seed S] [--actions D]"
+           " [--population FILE] [--keyframes N]\n"
+           "  --keyframes: ticks between keyframes (default %u, 0 = none)\n",
+           REPLAY_DEFAULT_KEYFRAME_INTERVAL);
+    return 2;
+}
+
+int replay_record_main(int argc, char** argv) {
+    if (argc < 1) return record_usage();
+    const char* path            = argv[0];
+    uint32_t    ticks           = 3600;
+    uint64_t    seed            = 1;
+    uint32_t    actions         = 2;
+    const char* population_path = nullptr;
+    uint32_t    interval        = REPLAY_DEFAULT_KEYFRAME_INTERVAL;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--ticks") == 0 && has_value) {
+            ticks = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--actions") == 0 && has_value) {
+            actions = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--population") == 0 && has_value) {
+            population_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--keyframes") == 0 && has_value) {
+            interval = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            return record_usage();
+        }
+    }
+
+    printf("=== Axiom Record: %u ticks, up to %u actions/tick, seed %llu ===\n\n",
+           ticks, actions, (unsigned long long)seed);
+
+    ax_core* core = create_and_load("content/");
+    if (!core) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        return 1;
+    }
+    if (population_path) {
+        ax_population_params_v1 pop;
+        worldgen_default_params(&pop);
+        std::string text, error;
+        FILE* f = fopen(population_path, "rb");
+        if (f) {
+            char buf[4096];
+            size_t n;
+            while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+            fclose(f);
+        }
+        if (!f || !worldgen_parse_population(text.c_str(), &pop, &error) ||
+            ax_spawn_population(core, &pop, nullptr) != AX_OK) {
+            printf("  FAILED: %s: %s\n", population_path,
+                   error.empty() ? ax_get_last_error() : error.c_str());
+            ax_destroy(core);
+            return 1;
+        }
+    }
+
+    replay_recorder rec;
+    if (!rec.begin(core, population_path != nullptr, interval)) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return 1;
+    }
+
+    uint64_t rng = seed;
+    std::vector<ax_action_v1> buf;
+    for (uint32_t t = 0; t < ticks; ++t) {
+        buf.clear();
+        uint32_t n = actions ? (uint32_t)(next_random(&rng) % (actions + 1)) : 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            buf.push_back(random_action(&rng, rec.tick() + 1));
+        }
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = (uint32_t)buf.size();
+        batch.actions    = buf.data();
+        if ((n > 0 && rec.submit_actions(&batch) != AX_OK) || rec.step_ticks(1) != AX_OK) {
+            printf("  FAILED: %s\n", ax_get_last_error());
+            ax_destroy(core);
+            return 1;
+        }
+    }
+
+    replay_data data;
+    bool ok = rec.finish(&data) && replay_write_file(path, data);
+    ax_destroy(core);
+    if (!ok) {
+        printf("  FAILED: cannot write %s\n", path);
+        return 1;
+    }
+
+    std::vector<uint8_t> bytes;
+    replay_encode(data, &bytes);
+    replay_data inputs_only = data;
+    inputs_only.keyframes.clear();
+    std::vector<uint8_t> input_bytes;
+    replay_encode(inputs_only, &input_bytes);
+    size_t action_bytes = input_bytes.size() - REPLAY_HEADER_BYTES - data.start_save.size() - 4;
+    printf("  actions    %zu (%.1f bytes each)\n", data.actions.size(),
+           data.actions.empty() ? 0.0 : (double)action_bytes / data.actions.size());
+    printf("  keyframes  %zu every %u ticks (%.1f KB)\n", data.keyframes.size(), interval,
+           data.keyframe_bytes.size() / 1024.0);
+    printf("  state hash 0x%016llX\n", (unsigned long long)data.final_hash);
+    printf("  replay     %zu bytes -> %s\n", bytes.size(), path);
+    return 0;
+}
+
+static int replay_usage() {
+    printf("usage: axiom_headless replay <file> [--workers W] [--seek TICK]\n");
+    return 2;
+}
+
+int replay_main(int argc, char** argv) {
+    if (argc < 1) return replay_usage();
+    const char* path    = argv[0];
+    uint32_t    workers = 1;
+    bool        seek    = false;
+    uint64_t    seek_to = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seek") == 0 && i + 1 < argc) {
+            seek    = true;
+            seek_to = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            return replay_usage();
+        }
+    }
+
+    replay_data data;
+    std::string error;
+    if (!replay_read_file(path, &data, &error)) {
+        printf("  FAILED: %s\n", error.c_str());
+        return 1;
+    }
+    printf("=== Axiom Replay: %s ===\n\n", path);
+    printf("  recorded   ABI %u.%u, ticks %llu..%llu, %zu actions, %zu keyframes%s\n",
+           data.abi_major, data.abi_minor, (unsigned long long)data.start_tick,
+           (unsigned long long)data.end_tick, data.actions.size(), data.keyframes.size(),
+           data.start_save.empty() ? "" : ", embedded start state");
+    if (data.abi_minor != AX_ABI_MINOR) {
+        printf("  note       this shell is ABI %u.%u\n", AX_ABI_MAJOR, AX_ABI_MINOR);
+    }
+
+    ax_core* core = create_and_load("content/");
+    if (!core) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        return 1;
+    }
+    ax_threading_params_v1 tp = {};
+    tp.version      = 1;
+    tp.size_bytes   = sizeof(tp);
+    tp.worker_count = workers;
+    replay_player player(data);
+    if (ax_set_threading(core, &tp) != AX_OK) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return 1;
+    }
+    if (!player.start(core, &error)) {
+        printf("  FAILED: %s\n", error.c_str());
+        ax_destroy(core);
+        return 1;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    if (player.run_to(data.end_tick) != AX_OK) {
+        printf("  FAILED at tick %llu: %s\n", (unsigned long long)player.tick(), ax_get_last_error());
+        ax_destroy(core);
+        return 1;
+    }
+    double s = seconds_since(t0);
+
+    uint64_t hash = 0;
+    ax_get_state_hash(core, &hash);
+
+    uint64_t ticks = data.end_tick - data.start_tick;
+    printf("  replayed   %llu ticks in %.1f ms (%.0f ticks/s, %u workers)\n",
+           (unsigned long long)ticks, s * 1e3, s > 0.0 ? ticks / s : 0.0, workers);
+    printf("  state hash 0x%016llX (%s)\n", (unsigned long long)hash,
+           hash == data.final_hash ? "matches recording" : "MISMATCH");
+    bool ok = hash == data.final_hash;
+
+    /* back from the end to the seek tick, then forward again to the end */
+    if (seek) {
+        t0 = std::chrono::steady_clock::now();
+        ax_result r = player.seek(seek_to);
+        s = seconds_since(t0);
+        uint64_t seek_hash = 0;
+        ax_get_state_hash(core, &seek_hash);
+        if (r != AX_OK) {
+            printf("  FAILED: seek to %llu: %s\n", (unsigned long long)seek_to,
+                   r == AX_ERR_BAD_STATE ? "no keyframe before it" : ax_get_last_error());
+            ok = false;
+        } else {
+            printf("  seek       tick %llu in %.2f ms, state hash 0x%016llX\n",
+                   (unsigned long long)player.tick(), s * 1e3, (unsigned long long)seek_hash);
+            r = player.seek(data.end_tick);
+            ax_get_state_hash(core, &hash);
+            bool again = r == AX_OK && hash == data.final_hash;
+            printf("  reseek     end tick %s\n", again ? "matches recording" : "MISMATCH");
+            ok = ok && again;
+        }
+    }
+    ax_destroy(core);
+    return ok ? 0 : 1;
+}
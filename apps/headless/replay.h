@@ -0,0 +1,207 @@
+/*
+ * replay.h — Binary input recordings and max-speed replay
+ *
+ * `axiom_headless record <file> [--ticks N] [--seed S] [--actions D]
+ *                        [--population FILE] [--keyframes N]`
+ * `axiom_headless replay <file> [--workers W] [--seek TICK]`
+ *
+ * A replay_recorder sits between a shell and the core: every batch the
+ * shell passes through it goes to ax_submit_actions and, if accepted,
+ * into the recording, tagged with the tick the core was at when it was
+ * submitted. A replay_player feeds the same batches back at the same
+ * points and steps the gaps between them in single ax_step_ticks calls,
+ * so playback runs as fast as the sim does. `record` writes a seeded
+ * synthetic session; `replay` plays a file back, reports ticks/sec and
+ * checks the final state hash against the one recorded.
+ *
+ * Every keyframe_interval ticks the recorder also embeds a keyframe: a
+ * save of the world between two ticks. replay_player::seek loads the
+ * nearest keyframe before the target tick with ax_load_save_bytes,
+ * resubmits the actions still queued at that point (saves do not carry
+ * the action queue) and simulates forward, so a seek costs one load
+ * plus at most one interval of ticks however long the recording is.
+ *
+ * File layout (little-endian, no padding):
+ *
+ *    0  char[4]  magic "AXRP"
+ *    4  u16      format version (2; 1 = no keyframes, still read)
+ *    6  u16      flags (0)
+ *    8  u16      ABI major of the recording shell
+ *   10  u16      ABI minor
+ *   12  u32      start_save_bytes (0 = start from freshly loaded content)
+ *   16  u64      content hash (ax_get_content_hash)
+ *   24  u64      start tick
+ *   32  u64      end tick
+ *   40  u64      state hash at the end tick
+ *   48  u32      action count
+ *   52  u32      body bytes
+ *   56  start save blob (start_save_bytes), then the body, then the
+ *       seek index.
+ *
+ *   body, in recording order:
+ *       varint   tick - previous entry's tick (the first counts from
+ *                the start tick); for an action the tick the core was
+ *                at when it was submitted
+ *       u8       action type, or 0xFF for a keyframe
+ *     action:
+ *       varint   actor id
+ *       zigzag   target tick - submit tick
+ *       payload  MOVE / LOOK: 2 x f32 (bit-exact); FIRE / RELOAD:
+ *                varint slot; SPRINT / CROUCH: u8
+ *     keyframe:
+ *       u32      save size, then the save blob
+ *
+ *   seek index (v2):
+ *       u32      keyframe count, then per keyframe (28 bytes):
+ *       u64      tick
+ *       u64      file offset of the save blob
+ *       u32      save size
+ *       u32      actions recorded before the keyframe
+ *       u32      first of those still queued (target tick > keyframe tick)
+ *
+ * A typical A1 action takes 4-12 bytes instead of sizeof(ax_action_v1).
+ * Only ax_submit_actions is tapped; inbox submissions are not recorded.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+#include "core_api.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define REPLAY_MAGIC          "AXRP"
+#define REPLAY_FORMAT_VERSION 2
+#define REPLAY_HEADER_BYTES   56
+#define REPLAY_DEFAULT_KEYFRAME_INTERVAL 600    /* ticks; 10 s at 60 Hz */
+
+struct replay_keyframe {
+    uint64_t tick;
+    uint32_t first_action;      /* actions submitted before the keyframe */
+    uint32_t pending_first;     /* earliest of those with target tick > tick */
+    uint64_t offset;            /* save blob in replay_data::keyframe_bytes */
+    uint32_t size;
+};
+
+struct replay_data {
+    uint16_t abi_major;
+    uint16_t abi_minor;
+    uint64_t content_hash;
+    uint64_t start_tick;
+    uint64_t end_tick;
+    uint64_t final_hash;
+    std::vector<uint8_t>      start_save;       /* empty = fresh content */
+    std::vector<uint64_t>     submit_ticks;     /* per action, non-decreasing */
+    std::vector<ax_action_v1> actions;          /* submission order */
+    std::vector<replay_keyframe> keyframes;     /* ascending tick */
+    std::vector<uint8_t>         keyframe_bytes;
+};
+
+void replay_encode(const replay_data& r, std::vector<uint8_t>* out);
+
+/*
+ * False with *error set on bad magic/version, truncation, trailing
+ * bytes, or a seek index that disagrees with the body.
+ */
+bool replay_decode(const uint8_t* bytes, size_t size, replay_data* out, std::string* error);
+
+bool replay_write_file(const char* path, const replay_data& r);
+bool replay_read_file(const char* path, replay_data* out, std::string* error);
+
+/* ── Recording ────────────────────────────────────────────────────── */
+
+class replay_recorder {
+public:
+    /*
+     * Starts recording at the core's current tick (content loaded).
+     * With embed_start_state the current world is saved into the
+     * recording, so it may start after a save load or a population
+     * spawn; without it, playback starts from freshly loaded content.
+     * keyframe_interval 0 records no keyframes (and the file cannot be
+     * seeked backwards).
+     */
+    bool begin(ax_core* core, bool embed_start_state,
+               uint32_t keyframe_interval = REPLAY_DEFAULT_KEYFRAME_INTERVAL);
+
+    /* ax_submit_actions, recording the batch if it is accepted. */
+    ax_result submit_actions(const ax_action_batch_v1* batch);
+
+    /* ax_step_ticks, keeping track of the tick; adds due keyframes. */
+    ax_result step_ticks(uint32_t n_ticks);
+
+    /* Stamps the end tick and state hash into the recording so far. */
+    bool finish(replay_data* out);
+
+    uint64_t tick() const { return tick_; }
+
+private:
+    bool add_keyframe();
+
+    ax_core*    core_ = nullptr;
+    uint64_t    tick_ = 0;
+    uint32_t    interval_ = 0;
+    uint64_t    next_keyframe_ = 0;
+    uint32_t    pending_first_ = 0;
+    replay_data data_ = {};
+};
+
+/* ── Playback ─────────────────────────────────────────────────────── */
+
+class replay_player {
+public:
+    /* `api` is the table the cores passed to start() were created with. */
+    explicit replay_player(const replay_data& r, const core_api* api = core_api_linked())
+        : r_(r), api_(api) {}
+
+    /*
+     * Puts a core with content loaded into the recording's start state.
+     * False with *error set if the content hash or ABI major differs,
+     * or the start save does not load.
+     */
+    bool start(ax_core* core, std::string* error);
+
+    /*
+     * Submits and steps until the core is at `tick` (clamped to the end
+     * tick). Actions recorded at `tick` itself are submitted by the next
+     * call, so every action with a smaller submit tick has been.
+     */
+    ax_result run_to(uint64_t tick);
+
+    /*
+     * Moves to `tick` (clamped to [start, end]) in either direction:
+     * from the latest keyframe before it, or by running forward when
+     * the core is already past that keyframe. Loading a keyframe drops
+     * whatever the core had queued. AX_ERR_BAD_STATE when seeking back
+     * past the last keyframe (or without any) and there is no start
+     * state to reload.
+     */
+    ax_result seek(uint64_t tick);
+
+    /*
+     * Loads a save the caller took of this player's core at `tick` (in
+     * [start, end]) and resubmits the actions queued at that point, so
+     * playback continues exactly as it did from there. AX_ERR_INVALID_ARG
+     * if `tick` is outside the recording.
+     */
+    ax_result restore(const void* save, uint32_t size, uint64_t tick);
+
+    uint64_t tick() const { return tick_; }
+    bool     done() const { return tick_ >= r_.end_tick; }
+
+private:
+    ax_result requeue_pending(size_t from);
+
+    const replay_data& r_;
+    const core_api* api_;
+    ax_core* core_ = nullptr;
+    uint64_t tick_ = 0;
+    size_t   next_ = 0;     /* first action not yet submitted */
+    std::vector<ax_action_v1> requeue_;     /* seek / restore scratch */
+};
+
+/* CLI entry points: argv = { file, flags as above } */
+int replay_record_main(int argc, char** argv);
+int replay_main(int argc, char** argv);
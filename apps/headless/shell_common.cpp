@@ -0,0 +1,237 @@
+/*
+ * shell_common.cpp — Axiom Headless Shell shared helpers
+ *
+ * Lifecycle, snapshot, and save helpers used by the test suite and
+ * by the non-test shell modes (batch, ...).
+ */
+
+#include "shell_common.h"
+
+#include <cstdio>
+#include <cstring>
+
+/* ── Result code to string ────────────────────────────────────────── */
+
+const char* result_str(ax_result r) {
+    switch (r) {
+        case AX_OK:                   return "AX_OK";
+        case AX_ERR_INVALID_ARG:      return "AX_ERR_INVALID_ARG";
+        case AX_ERR_BAD_STATE:        return "AX_ERR_BAD_STATE";
+        case AX_ERR_UNSUPPORTED:      return "AX_ERR_UNSUPPORTED";
+        case AX_ERR_BUFFER_TOO_SMALL: return "AX_ERR_BUFFER_TOO_SMALL";
+        case AX_ERR_PARSE_FAILED:     return "AX_ERR_PARSE_FAILED";
+        case AX_ERR_IO:               return "AX_ERR_IO";
+        case AX_ERR_INTERNAL:         return "AX_ERR_INTERNAL";
+        case AX_ERR_QUEUE_FULL:       return "AX_ERR_QUEUE_FULL";
+        case AX_ERR_OUT_OF_MEMORY:    return "AX_ERR_OUT_OF_MEMORY";
+        default:                      return "UNKNOWN";
+    }
+}
+
+/* ── Snapshot parsing helpers ─────────────────────────────────────── */
+
+parsed_snapshot parse_snapshot(const void* buf, uint32_t size) {
+    parsed_snapshot snap = {};
+
+    if (!buf || size < sizeof(ax_snapshot_header_v1)) {
+        return snap;
+    }
+
+    const uint8_t* p = (const uint8_t*)buf;
+    uint32_t offset = 0;
+
+    /* header */
+    snap.header = (const ax_snapshot_header_v1*)(p + offset);
+    offset += sizeof(ax_snapshot_header_v1);
+
+    /* entities */
+    uint32_t entities_size = snap.header->entity_count * snap.header->entity_stride_bytes;
+    if (offset + entities_size > size) return snap;
+    snap.entities = (const ax_snapshot_entity_v1*)(p + offset);
+    offset += entities_size;
+
+    /* weapon (optional) */
+    if (snap.header->player_weapon_present) {
+        if (offset + sizeof(ax_snapshot_player_weapon_v1) > size) return snap;
+        snap.weapon = (const ax_snapshot_player_weapon_v1*)(p + offset);
+        offset += sizeof(ax_snapshot_player_weapon_v1);
+    }
+
+    /* events */
+    uint32_t events_size = snap.header->event_count * snap.header->event_stride_bytes;
+    if (offset + events_size > size) return snap;
+    snap.events = (const ax_snapshot_event_v1*)(p + offset);
+    offset += events_size;
+
+    /* weapon table (AX_SNAPSHOT_REQ_WEAPONS) */
+    if (snap.header->flags & AX_SNAPSHOT_FLAG_WEAPONS) {
+        if (offset + sizeof(ax_snapshot_weapon_table_v1) > size) return snap;
+        const ax_snapshot_weapon_table_v1* table = (const ax_snapshot_weapon_table_v1*)(p + offset);
+        offset += sizeof(ax_snapshot_weapon_table_v1);
+        if (offset + (uint64_t)table->weapon_count * sizeof(ax_snapshot_player_weapon_v1) > size) return snap;
+        snap.weapon_count = table->weapon_count;
+        snap.weapons      = (const ax_snapshot_player_weapon_v1*)(p + offset);
+    }
+
+    return snap;
+}
+
+/* ── Lifecycle helpers ────────────────────────────────────────────── */
+
+ax_core* create_and_load(const char* content_path) {
+    ax_create_params_v1 params = {};
+    params.version    = 1;
+    params.size_bytes = sizeof(params);
+    params.abi_major  = AX_ABI_MAJOR;
+    params.abi_minor  = AX_ABI_MINOR;
+    params.log_fn     = nullptr;
+    params.log_user   = nullptr;
+
+    ax_core* core = nullptr;
+    ax_result r = ax_create(&params, &core);
+    if (r != AX_OK) {
+        printf("  create_and_load: ax_create failed: %s\n", result_str(r));
+        return nullptr;
+    }
+
+    ax_content_load_params_v1 content = {};
+    content.version    = 1;
+    content.size_bytes = sizeof(content);
+    content.root_path  = content_path;
+
+    r = ax_load_content(core, &content);
+    if (r != AX_OK) {
+        printf("  create_and_load: ax_load_content failed: %s\n", result_str(r));
+        ax_destroy(core);
+        return nullptr;
+    }
+
+    return core;
+}
+
+std::vector<uint8_t> take_snapshot(ax_core* core) {
+    uint32_t size = 0;
+    ax_result r = ax_get_snapshot_bytes(core, nullptr, 0, &size);
+    if (r != AX_OK || size == 0) {
+        printf("  take_snapshot: size query failed: %s\n", result_str(r));
+        return {};
+    }
+
+    std::vector<uint8_t> buf(size);
+    r = ax_get_snapshot_bytes(core, buf.data(), size, &size);
+    if (r != AX_OK) {
+        printf("  take_snapshot: copy failed: %s\n", result_str(r));
+        return {};
+    }
+
+    return buf;
+}
+
+void submit_action(ax_core* core, const ax_action_v1& action) {
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = 1;
+    batch.actions    = &action;
+
+    ax_result r = ax_submit_actions(core, &batch);
+    if (r != AX_OK) {
+        printf("  submit_action: failed: %s (%s)\n",
+               result_str(r), ax_get_last_error());
+    }
+}
+
+std::vector<uint8_t> take_save(ax_core* core) {
+    uint32_t size = 0;
+    ax_result r = ax_save_bytes(core, nullptr, 0, &size);
+    if (r != AX_OK || size == 0) {
+        printf("  take_save: size query failed: %s\n", result_str(r));
+        return {};
+    }
+
+    std::vector<uint8_t> buf(size);
+    r = ax_save_bytes(core, buf.data(), size, &size);
+    if (r != AX_OK) {
+        printf("  take_save: copy failed: %s\n", result_str(r));
+        return {};
+    }
+
+    return buf;
+}
+
+/* ── Snapshot comparison (logic-relevant A1 fields) ──────────────── */
+
+int compare_snapshots_logic(const char* label,
+                                   const parsed_snapshot& a,
+                                   const parsed_snapshot& b) {
+    int mismatches = 0;
+
+    /* tick */
+    if (a.header->tick != b.header->tick) {
+        printf("  %s: tick mismatch: %llu vs %llu\n", label,
+               (unsigned long long)a.header->tick, (unsigned long long)b.header->tick);
+        mismatches++;
+    }
+
+    /* entity count */
+    if (a.header->entity_count != b.header->entity_count) {
+        printf("  %s: entity_count mismatch: %u vs %u\n", label,
+               a.header->entity_count, b.header->entity_count);
+        mismatches++;
+    }
+
+    uint32_t ent_count = a.header->entity_count < b.header->entity_count
+                       ? a.header->entity_count : b.header->entity_count;
+
+    for (uint32_t i = 0; i < ent_count; ++i) {
+        const auto& ea = a.entities[i];
+        const auto& eb = b.entities[i];
+
+        if (ea.id != eb.id) {
+            printf("  %s: entity[%u] id mismatch: %u vs %u\n", label, i, ea.id, eb.id);
+            mismatches++;
+        }
+        if (ea.hp != eb.hp) {
+            printf("  %s: entity[%u] hp mismatch: %d vs %d\n", label, i, ea.hp, eb.hp);
+            mismatches++;
+        }
+        if (ea.state_flags != eb.state_flags) {
+            printf("  %s: entity[%u] state_flags mismatch: 0x%x vs 0x%x\n", label, i,
+                   ea.state_flags, eb.state_flags);
+            mismatches++;
+        }
+        /* transforms (spatial-tier, but should round-trip identically within same process) */
+        if (ea.px != eb.px || ea.py != eb.py || ea.pz != eb.pz) {
+            printf("  %s: entity[%u] position mismatch\n", label, i);
+            mismatches++;
+        }
+        if (ea.rx != eb.rx || ea.ry != eb.ry || ea.rz != eb.rz || ea.rw != eb.rw) {
+            printf("  %s: entity[%u] rotation mismatch\n", label, i);
+            mismatches++;
+        }
+    }
+
+    /* weapon state */
+    if (a.weapon && b.weapon) {
+        if (a.weapon->ammo_in_mag != b.weapon->ammo_in_mag) {
+            printf("  %s: ammo_in_mag mismatch: %d vs %d\n", label,
+                   a.weapon->ammo_in_mag, b.weapon->ammo_in_mag);
+            mismatches++;
+        }
+        if (a.weapon->ammo_reserve != b.weapon->ammo_reserve) {
+            printf("  %s: ammo_reserve mismatch: %d vs %d\n", label,
+                   a.weapon->ammo_reserve, b.weapon->ammo_reserve);
+            mismatches++;
+        }
+        if (a.weapon->weapon_flags != b.weapon->weapon_flags) {
+            printf("  %s: weapon_flags mismatch: 0x%x vs 0x%x\n", label,
+                   a.weapon->weapon_flags, b.weapon->weapon_flags);
+            mismatches++;
+        }
+    } else if ((a.weapon != nullptr) != (b.weapon != nullptr)) {
+        printf("  %s: weapon presence mismatch\n", label);
+        mismatches++;
+    }
+
+    return mismatches;
+}
@@ -0,0 +1,44 @@
+/*
+ * shell_common.h — Axiom Headless Shell shared helpers
+ *
+ * Helpers shared by the A1 test suite (main.cpp) and the non-test
+ * shell modes. Everything here goes through the C ABI only.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+#include <vector>
+
+/* ── Result code to string ────────────────────────────────────────── */
+
+const char* result_str(ax_result r);
+
+/* ── Snapshot parsing helpers ─────────────────────────────────────── */
+
+struct parsed_snapshot {
+    const ax_snapshot_header_v1*        header;
+    const ax_snapshot_entity_v1*        entities;    /* array */
+    const ax_snapshot_player_weapon_v1* weapon;      /* NULL if absent */
+    const ax_snapshot_event_v1*         events;      /* array */
+    uint32_t                            weapon_count;
+    const ax_snapshot_player_weapon_v1* weapons;     /* table, NULL if absent */
+};
+
+parsed_snapshot parse_snapshot(const void* buf, uint32_t size);
+
+/* ── Lifecycle helpers ────────────────────────────────────────────── */
+
+ax_core*             create_and_load(const char* content_path);
+std::vector<uint8_t> take_snapshot(ax_core* core);
+void                 submit_action(ax_core* core, const ax_action_v1& action);
+std::vector<uint8_t> take_save(ax_core* core);
+
+/* ── Snapshot comparison (logic-relevant A1 fields) ──────────────── */
+
+/* Prints each mismatch prefixed with label; returns the mismatch count. */
+int compare_snapshots_logic(const char* label,
+                            const parsed_snapshot& a,
+                            const parsed_snapshot& b);
@@ -0,0 +1,191 @@
+/*
+ * snapshot_bench.cpp — Compact snapshot size/speed benchmark
+ *
+ * See snapshot_bench.h.
+ */
+
+#include "snapshot_bench.h"
+#include "shell_common.h"
+
+#include "ax_abi.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double elapsed_ns(bench_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        bench_clock::now() - start).count();
+}
+
+/* largest component difference, with q and -q treated as equal */
+static float rotation_error(const ax_snapshot_entity_v1& src, const ax_snapshot_entity_v1& dec) {
+    float n = std::sqrt(src.rx * src.rx + src.ry * src.ry + src.rz * src.rz + src.rw * src.rw);
+    float s[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    if (n > 1e-6f) {
+        s[0] = src.rx / n;  s[1] = src.ry / n;  s[2] = src.rz / n;  s[3] = src.rw / n;
+    }
+    const float d[4] = { dec.rx, dec.ry, dec.rz, dec.rw };
+    float same = 0.0f, flipped = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        same    = std::fmax(same,    std::fabs(s[i] - d[i]));
+        flipped = std::fmax(flipped, std::fabs(s[i] + d[i]));
+    }
+    return std::fmin(same, flipped);
+}
+
+bool snapshot_bench_run(const snapshot_bench_params& params, snapshot_bench_result* out) {
+    std::memset(out, 0, sizeof(*out));
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    for (uint32_t i = 0; i < params.entities; ++i) {
+        ax_debug_spawn_params_v1 p = {};
+        p.version      = 1;
+        p.size_bytes   = sizeof(p);
+        p.archetype_id = 2000;
+        p.hp           = 100;
+        p.px = (float)(i % 64) * 3.1713f - 100.0f;
+        p.py = (float)(i % 7) * 0.3719f;
+        p.pz = -12.0f - (float)(i / 64) * 2.7183f;
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &p, &id) != AX_OK) {
+            printf("  snapshot_bench: spawn failed: %s\n", ax_get_last_error());
+            ax_destroy(core);
+            return false;
+        }
+    }
+
+    ax_snapshot_request_v1 req = {};
+    req.version         = 1;
+    req.size_bytes      = sizeof(req);
+    req.flags           = AX_SNAPSHOT_REQ_COMPACT;
+    req.position_grid_m = params.grid_m;
+
+    std::vector<uint8_t> v1, v2, decoded;
+    double v1_ns = 0.0, v2_ns = 0.0, dec_ns = 0.0;
+    bool   ok = true;
+
+    for (uint32_t it = 0; it < params.iterations && ok; ++it) {
+        uint64_t tick = it + 1;
+
+        ax_action_v1 look = {};
+        look.tick        = tick;
+        look.actor_id    = 1;
+        look.type        = AX_ACT_LOOK_INTENT;
+        look.u.look.yaw  = 0.01f;
+        submit_action(core, look);
+
+        ax_action_v1 fire = {};
+        fire.tick     = tick;
+        fire.actor_id = 1;
+        fire.type     = AX_ACT_FIRE_ONCE;
+        fire.u.fire_once.weapon_slot = 0;
+        submit_action(core, fire);
+
+        if (ax_step_ticks(core, 1) != AX_OK) {
+            ok = false;
+            break;
+        }
+
+        /* size queries are part of what a host pays per snapshot */
+        uint32_t size = 0;
+        bench_clock::time_point t0 = bench_clock::now();
+        ok = ok && ax_get_snapshot_bytes(core, nullptr, 0, &size) == AX_OK;
+        v1.resize(size);
+        ok = ok && ax_get_snapshot_bytes(core, v1.data(), size, &size) == AX_OK;
+        v1_ns += elapsed_ns(t0);
+
+        t0 = bench_clock::now();
+        ok = ok && ax_get_snapshot_bytes_ex(core, &req, nullptr, 0, &size) == AX_OK;
+        v2.resize(size);
+        ok = ok && ax_get_snapshot_bytes_ex(core, &req, v2.data(), size, &size) == AX_OK;
+        v2_ns += elapsed_ns(t0);
+
+        t0 = bench_clock::now();
+        ok = ok && ax_decode_snapshot_v2(v2.data(), (uint32_t)v2.size(), nullptr, 0, &size) == AX_OK;
+        decoded.resize(size);
+        ok = ok && ax_decode_snapshot_v2(v2.data(), (uint32_t)v2.size(),
+                                         decoded.data(), size, &size) == AX_OK;
+        dec_ns += elapsed_ns(t0);
+        if (!ok) {
+            printf("  snapshot_bench: %s\n", ax_get_last_error());
+            break;
+        }
+
+        parsed_snapshot a = parse_snapshot(v1.data(), (uint32_t)v1.size());
+        parsed_snapshot b = parse_snapshot(decoded.data(), (uint32_t)decoded.size());
+        if (!a.header || !b.header || a.header->entity_count != b.header->entity_count) {
+            ok = false;
+            break;
+        }
+        for (uint32_t i = 0; i < a.header->entity_count; ++i) {
+            const ax_snapshot_entity_v1& s = a.entities[i];
+            const ax_snapshot_entity_v1& d = b.entities[i];
+            float pe = std::fmax(std::fabs(s.px - d.px),
+                       std::fmax(std::fabs(s.py - d.py), std::fabs(s.pz - d.pz)));
+            out->max_position_error = std::fmax(out->max_position_error, pe);
+            out->max_rotation_error = std::fmax(out->max_rotation_error, rotation_error(s, d));
+        }
+    }
+
+    ax_destroy(core);
+
+    if (ok && params.iterations > 0) {
+        out->v1_bytes     = (uint32_t)v1.size();
+        out->v2_bytes     = (uint32_t)v2.size();
+        out->v1_encode_ns = v1_ns / params.iterations;
+        out->v2_encode_ns = v2_ns / params.iterations;
+        out->v2_decode_ns = dec_ns / params.iterations;
+    }
+    out->ok = ok;
+    return ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+int snapshot_bench_main(int argc, char** argv) {
+    snapshot_bench_params params;
+    params.content_path = "content/";
+    params.entities     = 1000;
+    params.iterations   = 200;
+    params.grid_m       = 0.0f;
+
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--entities") == 0 && i + 1 < argc) {
+            params.entities = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            params.iterations = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            params.grid_m = std::strtof(argv[++i], nullptr);
+        } else {
+            printf("usage: axiom_headless snapshot-bench [--entities N] [--iterations K] [--grid G]\n");
+            return 2;
+        }
+    }
+
+    printf("=== Axiom Snapshot Encoding: %u spawned targets, %u snapshots, grid %g m ===\n\n",
+           params.entities, params.iterations,
+           params.grid_m > 0.0f ? params.grid_m : AX_SNAPSHOT_DEFAULT_GRID_M);
+
+    snapshot_bench_result res;
+    if (!snapshot_bench_run(params, &res)) {
+        printf("  FAILED\n");
+        return 1;
+    }
+
+    printf("  v1 bytes        : %u\n", res.v1_bytes);
+    printf("  v2 bytes        : %u  (%.1f%% of v1)\n", res.v2_bytes,
+           res.v1_bytes ? 100.0 * res.v2_bytes / res.v1_bytes : 0.0);
+    printf("  encode (us)     : v1 %.1f  v2 %.1f\n", res.v1_encode_ns / 1000.0, res.v2_encode_ns / 1000.0);
+    printf("  decode v2 (us)  : %.1f\n", res.v2_decode_ns / 1000.0);
+    printf("  max error       : position %.6f m  rotation %.6f\n",
+           res.max_position_error, res.max_rotation_error);
+    return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * snapshot_bench.h — Compact snapshot size/speed benchmark
+ *
+ * `axiom_headless snapshot-bench [--entities N] [--iterations K] [--grid G]`
+ *
+ * Spawns N debug targets spread over a few hundred metres, steps the
+ * core with a LOOK + FIRE each tick (so the blob carries a rotated
+ * player and events), and takes K snapshots in both encodings. Reports
+ * v1 and v2 sizes, encode time per snapshot for each, decode time for
+ * v2 -> v1, and the worst position/rotation error after the round trip.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+struct snapshot_bench_params {
+    const char* content_path;
+    uint32_t    entities;
+    uint32_t    iterations;
+    float       grid_m;         /* 0 = AX_SNAPSHOT_DEFAULT_GRID_M */
+};
+
+struct snapshot_bench_result {
+    bool     ok;
+    uint32_t v1_bytes;          /* last snapshot */
+    uint32_t v2_bytes;
+    double   v1_encode_ns;      /* mean per snapshot */
+    double   v2_encode_ns;
+    double   v2_decode_ns;
+    float    max_position_error;
+    float    max_rotation_error;    /* per component, vs normalized source */
+};
+
+bool snapshot_bench_run(const snapshot_bench_params& params, snapshot_bench_result* out);
+
+/* CLI entry point: argv = { [--entities N] [--iterations K] [--grid G] } */
+int snapshot_bench_main(int argc, char** argv);
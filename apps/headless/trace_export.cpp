@@ -0,0 +1,194 @@
+/*
+ * trace_export.cpp — Chrome / Perfetto timeline of a synthetic workload
+ *
+ * See trace_export.h.
+ */
+
+#include "trace_export.h"
+#include "shell_common.h"
+
+#include <cstdlib>
+#include <cstring>
+
+/* Buffers are drained this often, well before the default capacity fills. */
+static const uint32_t DRAIN_EVERY_TICKS = 64;
+
+static bool drain(ax_core* core, trace_export_result* out) {
+    uint32_t pending = 0;
+    if (ax_drain_trace(core, nullptr, 0, &pending, nullptr) != AX_OK) return false;
+
+    size_t base = out->events.size();
+    out->events.resize(base + pending);
+    uint32_t count   = 0;
+    uint64_t dropped = 0;
+    if (ax_drain_trace(core, out->events.data() + base, pending, &count, &dropped) != AX_OK) {
+        return false;
+    }
+    out->dropped += dropped;
+    return true;
+}
+
+bool trace_export_run(const trace_export_params& params, trace_export_result* out) {
+    out->ok      = false;
+    out->dropped = 0;
+    out->events.clear();
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_threading_params_v1 tp = {};
+    tp.version      = 1;
+    tp.size_bytes   = sizeof(tp);
+    tp.worker_count = params.workers;
+    if (ax_set_threading(core, &tp) != AX_OK) {
+        printf("  trace: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+
+    ax_debug_spawn_params_v1 sp = {};
+    sp.version      = 1;
+    sp.size_bytes   = sizeof(sp);
+    sp.archetype_id = 2000;
+    sp.hp           = 1000000;
+    for (uint32_t i = 4; i < params.entities; ++i) {
+        sp.px = (float)(i % 256) - 128.0f;
+        sp.pz = -12.0f - (float)(i / 256);
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &sp, &id) != AX_OK) {
+            printf("  trace: spawn failed: %s\n", ax_get_last_error());
+            ax_destroy(core);
+            return false;
+        }
+    }
+
+    ax_trace_params_v1 trp = {};
+    trp.version         = 1;
+    trp.size_bytes      = sizeof(trp);
+    trp.capacity_events = params.capacity_events;
+    if (ax_enable_tracing(core, &trp) != AX_OK) {
+        printf("  trace: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+
+    std::vector<ax_action_v1> actions(params.actions_per_tick);
+    bool ok = true;
+
+    for (uint32_t t = 1; t <= params.ticks && ok; ++t) {
+        for (uint32_t i = 0; i < params.actions_per_tick; ++i) {
+            ax_action_v1& a = actions[i];
+            a = {};
+            a.tick     = t;
+            a.actor_id = 1;
+            switch (i % 3) {
+                case 0:  a.type = AX_ACT_LOOK_INTENT; a.u.look.yaw = 0.001f;            break;
+                case 1:  a.type = AX_ACT_MOVE_INTENT; a.u.move.x = 0.1f;                break;
+                default: a.type = AX_ACT_FIRE_ONCE;   a.u.fire_once.weapon_slot = 0;    break;
+            }
+        }
+        ax_action_batch_v1 batch = {};
+        batch.version    = 1;
+        batch.size_bytes = sizeof(batch);
+        batch.count      = params.actions_per_tick;
+        batch.actions    = actions.data();
+
+        ok = ax_submit_actions(core, &batch) == AX_OK && ax_step_ticks(core, 1) == AX_OK;
+        if (ok && (t % DRAIN_EVERY_TICKS == 0 || t == params.ticks)) {
+            ok = drain(core, out);
+        }
+    }
+
+    ax_destroy(core);
+    out->ok = ok;
+    return ok;
+}
+
+/* ── JSON ─────────────────────────────────────────────────────────── */
+
+bool trace_write_json(FILE* f, const ax_trace_event_v1* events, size_t count) {
+    uint32_t max_thread = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (events[i].thread > max_thread) max_thread = events[i].thread;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+               "\"args\":{\"name\":\"axiom_core\"}}");
+    for (uint32_t t = 0; t <= max_thread; ++t) {
+        char name[32];
+        if (t == 0) snprintf(name, sizeof(name), "sim");
+        else        snprintf(name, sizeof(name), "sim worker %u", t);
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                   "\"args\":{\"name\":\"%s\"}}", t, name);
+    }
+
+    /* ts / dur are µs; three decimals keep full ns resolution */
+    for (size_t i = 0; i < count; ++i) {
+        const ax_trace_event_v1& e = events[i];
+        fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                   "\"ts\":%llu.%03llu,\"dur\":%llu.%03llu,\"args\":{\"arg\":%llu}}",
+                ax_get_trace_name(e.name), e.thread,
+                (unsigned long long)(e.start_ns / 1000), (unsigned long long)(e.start_ns % 1000),
+                (unsigned long long)(e.duration_ns / 1000), (unsigned long long)(e.duration_ns % 1000),
+                (unsigned long long)e.arg);
+    }
+    fprintf(f, "\n]}\n");
+    return !ferror(f);
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+int trace_export_main(int argc, char** argv) {
+    trace_export_params params;
+    params.content_path     = "content/";
+    params.ticks            = 200;
+    params.entities         = 10000;
+    params.actions_per_tick = 16;
+    params.workers          = 4;
+    params.capacity_events  = 0;
+    const char* out_path    = "trace.json";
+
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            params.ticks = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--entities") == 0 && i + 1 < argc) {
+            params.entities = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--actions") == 0 && i + 1 < argc) {
+            params.actions_per_tick = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            params.workers = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            printf("usage: axiom_headless trace [--ticks N] [--entities N] [--actions D]"
+                   " [--workers W] [--out FILE]\n");
+            return 2;
+        }
+    }
+
+    printf("=== Axiom Trace: %u ticks, %u entities, %u actions/tick, %u workers ===\n\n",
+           params.ticks, params.entities, params.actions_per_tick, params.workers);
+
+    trace_export_result res;
+    if (!trace_export_run(params, &res)) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        return 1;
+    }
+
+    FILE* f = fopen(out_path, "w");
+    if (!f) {
+        printf("  FAILED: cannot open %s\n", out_path);
+        return 1;
+    }
+    bool written = trace_write_json(f, res.events.data(), res.events.size());
+    written = fclose(f) == 0 && written;
+    if (!written) {
+        printf("  FAILED: write error on %s\n", out_path);
+        return 1;
+    }
+
+    printf("  %zu events (%llu dropped) -> %s\n", res.events.size(),
+           (unsigned long long)res.dropped, out_path);
+    return 0;
+}
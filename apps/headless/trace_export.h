@@ -0,0 +1,44 @@
+/*
+ * trace_export.h — Chrome / Perfetto timeline of a synthetic workload
+ *
+ * `axiom_headless trace [--ticks N] [--entities N] [--actions D]
+ *                       [--workers W] [--out FILE]`
+ *
+ * Builds the same workload as `profile` (A1 world topped up to N
+ * entities, D player actions per tick), runs it on W sim workers with
+ * ax_enable_tracing on, drains the trace between steps and writes it as
+ * Chrome trace-event JSON (default trace.json). Open the file in
+ * ui.perfetto.dev or chrome://tracing: one track per sim thread, with
+ * ticks, phases, entry points and job chunks nested by time.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+struct trace_export_params {
+    const char* content_path;
+    uint32_t    ticks;
+    uint32_t    entities;
+    uint32_t    actions_per_tick;
+    uint32_t    workers;
+    uint32_t    capacity_events;    /* per thread; 0 = default */
+};
+
+struct trace_export_result {
+    bool                           ok;
+    std::vector<ax_trace_event_v1> events;      /* every drained event */
+    uint64_t                       dropped;
+};
+
+bool trace_export_run(const trace_export_params& params, trace_export_result* out);
+
+/* Chrome trace-event JSON ("X" events in µs, plus thread names). */
+bool trace_write_json(FILE* f, const ax_trace_event_v1* events, size_t count);
+
+/* CLI entry point: argv = { [--ticks N] [--entities N] [--actions D] [--workers W] [--out FILE] } */
+int trace_export_main(int argc, char** argv);
@@ -0,0 +1,436 @@
+/*
+ * verify.cpp — Parallel determinism verifier with divergence bisection
+ *
+ * See verify.h.
+ */
+
+#include "verify.h"
+#include "shell_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+/* ── Lanes ────────────────────────────────────────────────────────── */
+
+namespace {
+
+/* One core playing the recording through its own core_api. */
+struct lane_state {
+    const verify_lane*             spec   = nullptr;
+    const replay_data*             r      = nullptr;
+    ax_core*                       core   = nullptr;
+    std::unique_ptr<replay_player> player;
+    bool                           fault_applied = false;
+    std::string                    error;
+
+    ~lane_state() { close(); }
+
+    void close() {
+        player.reset();
+        if (core) {
+            spec->api->destroy(core);
+            core = nullptr;
+        }
+    }
+
+    /* Fresh core at the recording's start tick. */
+    bool open(const char* content_path) {
+        close();
+        const core_api* api = spec->api;
+        core = core_api_create_and_load(api, content_path);
+        if (!core) {
+            error = std::string("create/load: ") + api->get_last_error();
+            return false;
+        }
+        ax_threading_params_v1 tp = {};
+        tp.version      = 1;
+        tp.size_bytes   = sizeof(tp);
+        tp.worker_count = spec->workers;
+        if (api->set_threading(core, &tp) != AX_OK) {
+            error = api->get_last_error();
+            return false;
+        }
+        player.reset(new replay_player(*r, api));
+        fault_applied = false;
+        return player->start(core, &error);
+    }
+
+    /* run_to, submitting the injected fault on the way past its tick. */
+    bool advance(uint64_t tick) {
+        uint64_t f = spec->fault_tick;
+        if (!fault_applied && f >= player->tick() && f < tick) {
+            if (player->run_to(f) != AX_OK) {
+                return fail("run_to");
+            }
+            ax_action_v1 a = {};
+            a.tick         = f + 1;
+            a.actor_id     = 1;
+            a.type         = AX_ACT_LOOK_INTENT;
+            a.u.look.yaw   = 0.25f;
+            ax_action_batch_v1 batch = {};
+            batch.version    = 1;
+            batch.size_bytes = sizeof(batch);
+            batch.count      = 1;
+            batch.actions    = &a;
+            if (spec->api->submit_actions(core, &batch) != AX_OK) {
+                return fail("fault");
+            }
+            fault_applied = true;
+        }
+        return player->run_to(tick) == AX_OK || fail("run_to");
+    }
+
+    bool hash(uint64_t* out) {
+        return spec->api->get_state_hash(core, out) == AX_OK || fail("get_state_hash");
+    }
+
+    /* save_bytes / get_snapshot_bytes: size query, then the copy */
+    bool copy_out(ax_result (*fn)(ax_core*, void*, uint32_t, uint32_t*),
+                  std::vector<uint8_t>* out, const char* what) {
+        uint32_t size = 0;
+        fn(core, nullptr, 0, &size);
+        out->resize(size);
+        return (size > 0 && fn(core, out->data(), size, &size) == AX_OK) || fail(what);
+    }
+
+    /* Back to a save this lane took at `tick`; the fault is redone if it was later. */
+    bool restore(const std::vector<uint8_t>& save, uint64_t tick) {
+        if (player->restore(save.data(), (uint32_t)save.size(), tick) != AX_OK) {
+            return fail("restore");
+        }
+        fault_applied = spec->fault_tick < tick;
+        return true;
+    }
+
+    bool fail(const char* what) {
+        error = std::string(what) + ": " + spec->api->get_last_error();
+        return false;
+    }
+};
+
+/* Per-lane checkpoint hashes, published to the other lanes as they land. */
+struct lane_progress {
+    std::vector<uint64_t> hashes;
+    std::atomic<size_t>   published{0};
+};
+
+/* Advances every lane to `tick` on its own thread; false if any fails. */
+bool advance_all(lane_state* const* lanes, size_t n, uint64_t tick) {
+    std::vector<std::thread> threads;
+    std::vector<char> ok(n, 0);
+    for (size_t k = 0; k < n; ++k) {
+        threads.emplace_back([&, k] { ok[k] = lanes[k]->advance(tick); });
+    }
+    bool all = true;
+    for (size_t k = 0; k < n; ++k) {
+        threads[k].join();
+        all = all && ok[k];
+    }
+    return all;
+}
+
+const std::string& first_error(lane_state* const* lanes, size_t n) {
+    for (size_t k = 0; k < n; ++k) {
+        if (!lanes[k]->error.empty()) {
+            return lanes[k]->error;
+        }
+    }
+    static const std::string none = "lane failed";
+    return none;
+}
+
+} /* namespace */
+
+/* ── Verification ─────────────────────────────────────────────────── */
+
+bool verify_replay(const replay_data& r, const std::vector<verify_lane>& lanes,
+                   const verify_params& params, verify_result* out, std::string* error) {
+    *out = {};
+    size_t n_lanes = lanes.size();
+    if (n_lanes < 2 || params.stride == 0) {
+        *error = "need at least two lanes and a stride >= 1";
+        return false;
+    }
+
+    std::vector<uint64_t> ticks;        /* checkpoint 0 is the start tick */
+    for (uint64_t t = r.start_tick;; t += params.stride) {
+        if (t >= r.end_tick) {
+            ticks.push_back(r.end_tick);
+            break;
+        }
+        ticks.push_back(t);
+    }
+    size_t n_ticks = ticks.size();
+
+    std::vector<lane_state> state(n_lanes);
+    for (size_t k = 0; k < n_lanes; ++k) {
+        state[k].spec = &lanes[k];
+        state[k].r    = &r;
+        if (!state[k].open(params.content_path)) {
+            *error = "lane " + std::to_string(k) + ": " + state[k].error;
+            return false;
+        }
+    }
+
+    /*
+     * Phase 1: every lane plays the whole recording on its own thread.
+     * After publishing a checkpoint a lane compares it with whatever
+     * the others have published for it and stops everyone on a
+     * mismatch; the pass after the join decides.
+     */
+    std::vector<lane_progress> progress(n_lanes);
+    for (lane_progress& p : progress) {
+        p.hashes.resize(n_ticks);
+    }
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k < n_lanes; ++k) {
+        threads.emplace_back([&, k] {
+            lane_state& lane = state[k];
+            for (size_t i = 0; i < n_ticks && !stop.load(); ++i) {
+                uint64_t h = 0;
+                if (!lane.advance(ticks[i]) || !lane.hash(&h)) {
+                    stop = true;
+                    return;
+                }
+                progress[k].hashes[i] = h;
+                progress[k].published = i + 1;
+                for (size_t b = 0; b < n_lanes; ++b) {
+                    if ((k == 0) != (b == 0) && progress[b].published.load() > i &&
+                        progress[b].hashes[i] != h) {
+                        stop = true;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    for (size_t k = 0; k < n_lanes; ++k) {
+        if (!state[k].error.empty()) {
+            *error = "lane " + std::to_string(k) + " at tick " +
+                     std::to_string(state[k].player->tick()) + ": " + state[k].error;
+            return false;
+        }
+    }
+
+    size_t   first = n_ticks;
+    uint32_t lane  = 0;
+    for (size_t b = 1; b < n_lanes; ++b) {
+        size_t m = progress[0].published.load();
+        if (progress[b].published.load() < m) {
+            m = progress[b].published.load();
+        }
+        for (size_t i = 0; i < m && i < first; ++i) {
+            if (progress[0].hashes[i] != progress[b].hashes[i]) {
+                first = i;
+                lane  = (uint32_t)b;
+                break;
+            }
+        }
+    }
+    out->checkpoints = first < n_ticks ? first + 1 : n_ticks;
+    if (first == n_ticks) {
+        out->final_hash = progress[0].hashes[n_ticks - 1];
+        return true;
+    }
+
+    /*
+     * Phase 2: bisect lane 0 against `lane` between the last agreeing
+     * checkpoint and the first disagreeing one, on fresh cores and the
+     * lanes' own saves. Invariant: both lanes are at lo, and agree there.
+     */
+    for (size_t k = 0; k < n_lanes; ++k) {
+        if (k != 0 && k != lane) {
+            state[k].close();
+        }
+    }
+    lane_state* pair[2] = { &state[0], &state[lane] };
+    uint64_t hi = ticks[first];
+    bool ok = pair[0]->open(params.content_path) && pair[1]->open(params.content_path);
+    if (ok && first > 0) {
+        uint64_t lo = ticks[first - 1];
+        std::vector<uint8_t> saves[2];
+        ok = advance_all(pair, 2, lo) &&
+                  pair[0]->copy_out(pair[0]->spec->api->save_bytes, &saves[0], "save_bytes") &&
+                  pair[1]->copy_out(pair[1]->spec->api->save_bytes, &saves[1], "save_bytes");
+        while (ok && hi - lo > 1) {
+            uint64_t mid = lo + (hi - lo) / 2;
+            uint64_t ha = 0, hb = 0;
+            ok = advance_all(pair, 2, mid) && pair[0]->hash(&ha) && pair[1]->hash(&hb);
+            if (!ok) {
+                break;
+            }
+            if (ha == hb) {
+                lo = mid;
+                ok = pair[0]->copy_out(pair[0]->spec->api->save_bytes, &saves[0], "save_bytes") &&
+                     pair[1]->copy_out(pair[1]->spec->api->save_bytes, &saves[1], "save_bytes");
+            } else {
+                hi = mid;
+                ok = pair[0]->restore(saves[0], lo) && pair[1]->restore(saves[1], lo);
+            }
+        }
+        ok = ok && advance_all(pair, 2, hi);
+    }
+    if (!ok) {
+        *error = "bisecting: " + first_error(pair, 2);
+        return false;
+    }
+
+    /* the first divergent tick: hashes, field diff, optional dump */
+    std::vector<uint8_t> snaps[2];
+    if (!pair[0]->hash(&out->hash_ref) || !pair[1]->hash(&out->hash_lane) ||
+        !pair[0]->copy_out(pair[0]->spec->api->get_snapshot_bytes, &snaps[0], "snapshot") ||
+        !pair[1]->copy_out(pair[1]->spec->api->get_snapshot_bytes, &snaps[1], "snapshot")) {
+        *error = "snapshot: " + first_error(pair, 2);
+        return false;
+    }
+    out->diverged   = true;
+    out->lane       = lane;
+    out->first_tick = hi;
+
+    char label[64];
+    snprintf(label, sizeof(label), "tick %llu lane 0 vs %u", (unsigned long long)hi, lane);
+    out->field_mismatches = compare_snapshots_logic(
+        label, parse_snapshot(snaps[0].data(), (uint32_t)snaps[0].size()),
+        parse_snapshot(snaps[1].data(), (uint32_t)snaps[1].size()));
+
+    if (params.dump_prefix) {
+        uint32_t ids[2] = { 0, lane };
+        for (int s = 0; s < 2; ++s) {
+            std::string path = std::string(params.dump_prefix) + ".lane" +
+                               std::to_string(ids[s]) + ".snap";
+            FILE* f = fopen(path.c_str(), "wb");
+            if (!f || fwrite(snaps[s].data(), 1, snaps[s].size(), f) != snaps[s].size()) {
+                if (f) fclose(f);
+                *error = "cannot write " + path;
+                return false;
+            }
+            fclose(f);
+        }
+    }
+    return true;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static int verify_usage() {
+    printf("usage: axiom_headless verify <replay> [--lanes K] [--workers W1,W2,..]"
+           " [--lib PATH]... [--stride N] [--fault LANE:TICK] [--dump PREFIX]\n"
+           "  --lanes:   lanes on the linked core (default 2)\n"
+           "  --workers: worker counts, assigned to lanes in turn (default 1,4)\n"
+           "  --lib:     one more lane on a shared-library core\n"
+           "  --stride:  ticks between hash checkpoints (default 60)\n");
+    return 2;
+}
+
+int verify_main(int argc, char** argv) {
+    if (argc < 1) return verify_usage();
+    const char*              path   = argv[0];
+    uint32_t                 linked = 2;
+    std::vector<uint32_t>    workers;
+    std::vector<const char*> libs;
+    verify_params            params = { "content/", 60, nullptr };
+    uint32_t                 fault_lane = 0;
+    uint64_t                 fault_tick = VERIFY_NO_FAULT;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--lanes") == 0 && has_value) {
+            linked = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && has_value) {
+            for (char* p = argv[++i]; *p;) {
+                workers.push_back((uint32_t)std::strtoul(p, &p, 10));
+                if (*p == ',') p++;
+                else if (*p) return verify_usage();
+            }
+        } else if (std::strcmp(argv[i], "--lib") == 0 && has_value) {
+            libs.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--stride") == 0 && has_value) {
+            params.stride = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--fault") == 0 && has_value) {
+            char* p = argv[++i];
+            fault_lane = (uint32_t)std::strtoul(p, &p, 10);
+            if (*p != ':') return verify_usage();
+            fault_tick = std::strtoull(p + 1, nullptr, 10);
+        } else if (std::strcmp(argv[i], "--dump") == 0 && has_value) {
+            params.dump_prefix = argv[++i];
+        } else {
+            return verify_usage();
+        }
+    }
+    if (workers.empty()) {
+        workers = { 1, 4 };
+    }
+
+    replay_data data;
+    std::string error;
+    if (!replay_read_file(path, &data, &error)) {
+        printf("  FAILED: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<verify_lane> lanes;
+    for (uint32_t k = 0; k < linked; ++k) {
+        lanes.push_back({ core_api_linked(), 0, VERIFY_NO_FAULT });
+    }
+    for (const char* lib : libs) {
+        const core_api* api = core_api_load(lib, &error);
+        if (!api) {
+            printf("  FAILED: %s\n", error.c_str());
+            return 1;
+        }
+        lanes.push_back({ api, 0, VERIFY_NO_FAULT });
+    }
+    for (size_t k = 0; k < lanes.size(); ++k) {
+        lanes[k].workers = workers[k % workers.size()];
+    }
+    if (fault_tick != VERIFY_NO_FAULT) {
+        if (fault_lane >= lanes.size()) return verify_usage();
+        lanes[fault_lane].fault_tick = fault_tick;
+    }
+
+    printf("=== Axiom Verify: %s ===\n\n", path);
+    printf("  recording  ticks %llu..%llu, %zu actions, checkpoint every %u ticks\n",
+           (unsigned long long)data.start_tick, (unsigned long long)data.end_tick,
+           data.actions.size(), params.stride);
+    for (size_t k = 0; k < lanes.size(); ++k) {
+        printf("  lane %-5zu %s, %u workers", k, lanes[k].api->name, lanes[k].workers);
+        if (lanes[k].fault_tick != VERIFY_NO_FAULT) {
+            printf(", fault at tick %llu", (unsigned long long)lanes[k].fault_tick);
+        }
+        printf("\n");
+    }
+
+    verify_result res;
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = verify_replay(data, lanes, params, &res, &error);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (!ok) {
+        printf("  FAILED: %s\n", error.c_str());
+        return 1;
+    }
+
+    printf("  compared   %llu checkpoints in %.1f ms\n", (unsigned long long)res.checkpoints,
+           s * 1e3);
+    if (res.diverged) {
+        printf("  DIVERGED   lane %u from lane 0 at tick %llu: 0x%016llX vs 0x%016llX,"
+               " %d logic field(s) differ\n",
+               res.lane, (unsigned long long)res.first_tick, (unsigned long long)res.hash_ref,
+               (unsigned long long)res.hash_lane, res.field_mismatches);
+        if (params.dump_prefix) {
+            printf("  snapshots  %s.lane0.snap, %s.lane%u.snap\n", params.dump_prefix,
+                   params.dump_prefix, res.lane);
+        }
+        return 1;
+    }
+    printf("  agree      all %zu lanes, state hash 0x%016llX (%s)\n", lanes.size(),
+           (unsigned long long)res.final_hash,
+           res.final_hash == data.final_hash ? "matches recording" : "MISMATCH with recording");
+    return res.final_hash == data.final_hash ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+/*
+ * verify.h — Parallel determinism verifier with divergence bisection
+ *
+ * `axiom_headless verify <replay> [--lanes K] [--workers W1,W2,..]
+ *                        [--lib PATH]... [--stride N] [--fault LANE:TICK]
+ *                        [--dump PREFIX]`
+ *
+ * Plays one recording on several independent cores at once, one thread
+ * per lane, and compares their state hashes every `stride` ticks. A
+ * lane is a core plus its worker count, created either from the core
+ * this shell links or from a shared-library build (--lib, see
+ * core_api.h), so thread counts and build flavors are checked against
+ * each other in a single run. Lanes stop as soon as any two disagree.
+ *
+ * On a mismatch the first disagreeing lane is bisected against lane 0:
+ * both are replayed to the last checkpoint that still agreed, saved,
+ * and the interval halved by stepping to the midpoint and comparing,
+ * restoring the lanes' own saves whenever the midpoint already
+ * differs. The recording's keyframes are not used — they hold the
+ * recorder's world, which would paper over a divergence that is
+ * already in the lanes. The result is the first tick whose state
+ * differs; both snapshots of that tick are compared field by field
+ * (compare_snapshots_logic) and, with --dump, written to
+ * PREFIX.lane<N>.snap.
+ *
+ * --fault injects a divergence for testing the verifier itself: the
+ * lane submits one extra LOOK_INTENT at TICK for TICK + 1, so the
+ * expected first divergent tick is TICK + 1.
+ */
+
+#pragma once
+
+#include "core_api.h"
+#include "replay.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define VERIFY_NO_FAULT UINT64_MAX
+
+struct verify_lane {
+    const core_api* api;            /* core_api_linked() or core_api_load() */
+    uint32_t        workers;        /* ax_set_threading worker count */
+    uint64_t        fault_tick;     /* VERIFY_NO_FAULT = none */
+};
+
+struct verify_params {
+    const char* content_path;
+    uint32_t    stride;             /* ticks between hash checkpoints, >= 1 */
+    const char* dump_prefix;        /* NULL = do not write snapshots */
+};
+
+struct verify_result {
+    uint64_t checkpoints;           /* compared across all lanes */
+    bool     diverged;
+    uint32_t lane;                  /* first lane disagreeing with lane 0 */
+    uint64_t first_tick;            /* first tick whose state hash differs */
+    uint64_t hash_ref, hash_lane;   /* lane 0 and `lane` at first_tick */
+    int      field_mismatches;      /* compare_snapshots_logic at first_tick */
+    uint64_t final_hash;            /* lane 0 at the end tick (if no divergence) */
+};
+
+/*
+ * Runs the verification. False with *error set if a lane cannot be set
+ * up or fails to play (content, threading, ABI errors); a divergence is
+ * reported through *out, not as a failure.
+ */
+bool verify_replay(const replay_data& r, const std::vector<verify_lane>& lanes,
+                   const verify_params& params, verify_result* out, std::string* error);
+
+/* CLI entry point: argv = { file, flags as above } */
+int verify_main(int argc, char** argv);
@@ -0,0 +1,190 @@
+/*
+ * weapon_bench.cpp — Weapon table combat throughput benchmark
+ *
+ * See weapon_bench.h.
+ */
+
+#include "weapon_bench.h"
+#include "shell_common.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static const int32_t ACTOR_HP      = 1 << 30;
+static const int32_t AMMO_RESERVE  = 1 << 30;
+static const int32_t MAGAZINE      = 12;
+
+/* Spawns and arms `count` targets in a row; ids in spawn order. */
+static bool arm_actors(ax_core* core, uint32_t count, std::vector<uint32_t>* ids) {
+    ax_debug_spawn_params_v1 sp = {};
+    sp.version      = 1;
+    sp.size_bytes   = sizeof(sp);
+    sp.archetype_id = 2000;
+    sp.hp           = ACTOR_HP;
+
+    ax_debug_weapon_params_v1 wp = {};
+    wp.version      = 1;
+    wp.size_bytes   = sizeof(wp);
+    wp.weapon_slot  = 0;
+    wp.weapon_id    = 1000;
+    wp.ammo_in_mag  = MAGAZINE;
+    wp.ammo_reserve = AMMO_RESERVE;
+
+    ids->clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        sp.px = (float)(i % 128) * 2.0f;
+        sp.pz = -20.0f - (float)(i / 128) * 2.0f;
+        uint32_t id = 0;
+        if (ax_debug_spawn_target(core, &sp, &id) != AX_OK) return false;
+        wp.entity_id = id;
+        if (ax_debug_give_weapon(core, &wp) != AX_OK) return false;
+        ids->push_back(id);
+    }
+    return true;
+}
+
+/* FIRE_ONCE then RELOAD for `acting` actors, a window that moves every tick. */
+static bool submit_combat(ax_core* core, uint64_t tick, uint32_t acting,
+                          const std::vector<uint32_t>& ids, std::vector<ax_action_v1>* actions) {
+    actions->resize((size_t)acting * 2);
+    size_t start = (size_t)(tick * 7919u % ids.size());
+    for (uint32_t i = 0; i < acting; ++i) {
+        ax_action_v1& fire = (*actions)[(size_t)i * 2];
+        fire = ax_action_v1{};
+        fire.tick     = tick;
+        fire.actor_id = ids[(start + i) % ids.size()];
+        fire.type     = AX_ACT_FIRE_ONCE;
+
+        ax_action_v1& reload = (*actions)[(size_t)i * 2 + 1];
+        reload      = fire;
+        reload.type = AX_ACT_RELOAD;
+    }
+    if (actions->empty()) return true;
+
+    ax_action_batch_v1 batch = {};
+    batch.version    = 1;
+    batch.size_bytes = sizeof(batch);
+    batch.count      = (uint32_t)actions->size();
+    batch.actions    = actions->data();
+    return ax_submit_actions(core, &batch) == AX_OK;
+}
+
+bool weapon_bench_run(const weapon_bench_params& params, weapon_bench_result* out) {
+    out->ok = false;
+    out->us_per_tick.assign(params.acting.size(), 0.0);
+    out->state_hash = 0;
+
+    ax_core* core = create_and_load(params.content_path);
+    if (!core) return false;
+
+    ax_threading_params_v1 tp = {};
+    tp.version      = 1;
+    tp.size_bytes   = sizeof(tp);
+    tp.worker_count = params.workers;
+    std::vector<uint32_t> ids;
+    if (ax_set_threading(core, &tp) != AX_OK || !arm_actors(core, params.actors, &ids)) {
+        printf("  weapon_bench: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return false;
+    }
+
+    std::vector<ax_action_v1> actions;
+    bool ok = true;
+    uint64_t tick = 0;
+    for (size_t run = 0; run < params.acting.size() && ok; ++run) {
+        uint32_t acting = params.acting[run] < params.actors ? params.acting[run] : params.actors;
+        double seconds = 0.0;
+        for (uint32_t t = 0; t < params.ticks && ok; ++t) {
+            ok = submit_combat(core, ++tick, acting, ids, &actions);
+            bench_clock::time_point t0 = bench_clock::now();
+            ok = ok && ax_step_ticks(core, 1) == AX_OK;
+            seconds += std::chrono::duration<double>(bench_clock::now() - t0).count();
+        }
+        out->us_per_tick[run] = seconds * 1e6 / (double)params.ticks;
+    }
+    ok = ok && ax_get_state_hash(core, &out->state_hash) == AX_OK;
+    if (!ok) printf("  weapon_bench: %s\n", ax_get_last_error());
+
+    ax_destroy(core);
+    out->ok = ok;
+    return ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static int usage() {
+    printf("usage: axiom_headless weapon-bench [--actors N] [--acting N1,N2,..] [--ticks N]"
+           " [--workers W1,W2,..]\n");
+    return 2;
+}
+
+static bool parse_list(const char* s, std::vector<uint32_t>* out) {
+    out->clear();
+    while (*s) {
+        char* end = nullptr;
+        out->push_back((uint32_t)std::strtoul(s, &end, 10));
+        if (end == s) return false;
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return !out->empty();
+}
+
+int weapon_bench_main(int argc, char** argv) {
+    uint32_t              actors  = 10000;
+    std::vector<uint32_t> acting  = { 0, 100, 1000, 10000 };
+    uint32_t              ticks   = 100;
+    std::vector<uint32_t> workers = { 1, 4 };
+
+    for (int i = 0; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--actors") == 0 && has_value) {
+            actors = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--acting") == 0 && has_value) {
+            if (!parse_list(argv[++i], &acting)) return usage();
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && has_value) {
+            ticks = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && has_value) {
+            if (!parse_list(argv[++i], &workers)) return usage();
+        } else {
+            return usage();
+        }
+    }
+    if (actors == 0 || ticks == 0) return usage();
+
+    printf("=== Axiom Weapon Bench: %u armed actors, %u ticks per acting count ===\n\n",
+           actors, ticks);
+    printf("  %-8s %8s %12s %14s\n", "workers", "acting", "us/tick", "ns/action");
+
+    uint64_t first_hash = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        weapon_bench_params p = { "content/", actors, acting, ticks, workers[i] };
+        weapon_bench_result r;
+        if (!weapon_bench_run(p, &r)) {
+            printf("  FAILED\n");
+            return 1;
+        }
+        for (size_t a = 0; a < acting.size(); ++a) {
+            uint32_t n = acting[a] < actors ? acting[a] : actors;
+            if (n > 0) {
+                printf("  %-8u %8u %12.1f %14.1f\n", workers[i], n, r.us_per_tick[a],
+                       r.us_per_tick[a] * 1e3 / (2.0 * n));
+            } else {
+                printf("  %-8u %8u %12.1f %14s\n", workers[i], n, r.us_per_tick[a], "-");
+            }
+        }
+        if (i == 0) {
+            first_hash = r.state_hash;
+        } else if (r.state_hash != first_hash) {
+            printf("  FAILED: state hash %016llx differs from %016llx\n",
+                   (unsigned long long)r.state_hash, (unsigned long long)first_hash);
+            return 1;
+        }
+    }
+    printf("\n  state hash %016llx identical across worker counts\n",
+           (unsigned long long)first_hash);
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * weapon_bench.h — Weapon table combat throughput benchmark
+ *
+ * `axiom_headless weapon-bench [--actors N] [--acting N1,N2,..] [--ticks N]
+ *                              [--workers W1,W2,..]`
+ *
+ * Spawns N targets and arms each with a slot-0 weapon (ax_debug_give_weapon),
+ * then for each acting count steps ticks in which that many actors, a
+ * different window of them each tick, submit FIRE_ONCE followed by
+ * RELOAD. Shots hit the first living target other than the shooter, and
+ * reloads run through the timer wheel, so a tick exercises the weapon
+ * lookups, hit resolution, events and reload timers. Targets have enough
+ * hp and ammo that nobody dies or runs dry during a run.
+ *
+ * Reports the stepping time per tick and per action for each acting
+ * count, starting with 0 (armed actors that do nothing). Per-tick cost
+ * should follow the acting count, not N. The final state hash must be
+ * the same for every worker count; the run fails if not.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct weapon_bench_params {
+    const char*           content_path;
+    uint32_t              actors;
+    std::vector<uint32_t> acting;       /* actors acting per tick, one run each */
+    uint32_t              ticks;        /* per acting count */
+    uint32_t              workers;
+};
+
+struct weapon_bench_result {
+    bool                ok;
+    std::vector<double> us_per_tick;    /* per acting count */
+    uint64_t            state_hash;
+};
+
+bool weapon_bench_run(const weapon_bench_params& params, weapon_bench_result* out);
+
+/* CLI entry point: argv = { flags as above } */
+int weapon_bench_main(int argc, char** argv);
@@ -0,0 +1,93 @@
+/*
+ * work_pool.cpp — Work-stealing task pool (headless shell)
+ */
+
+#include "work_pool.h"
+
+#include <thread>
+
+work_pool::work_pool(uint32_t n_workers)
+    : n_workers_(n_workers), steals_(0) {
+    if (n_workers_ == 0) {
+        n_workers_ = std::thread::hardware_concurrency();
+    }
+    if (n_workers_ == 0) {
+        n_workers_ = 1;
+    }
+
+    queues_.reserve(n_workers_);
+    for (uint32_t i = 0; i < n_workers_; ++i) {
+        queues_.push_back(std::make_unique<worker_queue>());
+    }
+}
+
+bool work_pool::pop_local(uint32_t worker, uint32_t* out_task) {
+    worker_queue& q = *queues_[worker];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.tasks.empty()) {
+        return false;
+    }
+    *out_task = q.tasks.back();
+    q.tasks.pop_back();
+    return true;
+}
+
+bool work_pool::steal(uint32_t thief, uint32_t* out_task) {
+    /* visit victims in a fixed rotation starting after the thief */
+    for (uint32_t k = 1; k < n_workers_; ++k) {
+        worker_queue& q = *queues_[(thief + k) % n_workers_];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            *out_task = q.tasks.front();
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void work_pool::worker_loop(uint32_t worker,
+                            const std::function<void(uint32_t, uint32_t)>& fn) {
+    uint64_t stolen = 0;
+    uint32_t task   = 0;
+
+    for (;;) {
+        if (pop_local(worker, &task)) {
+            fn(task, worker);
+            continue;
+        }
+        /*
+         * No new tasks are ever pushed during run(), so once every deque
+         * is empty this worker is done.
+         */
+        if (!steal(worker, &task)) {
+            break;
+        }
+        stolen++;
+        fn(task, worker);
+    }
+
+    std::lock_guard<std::mutex> guard(steals_lock_);
+    steals_ += stolen;
+}
+
+void work_pool::run(uint32_t n_tasks,
+                    const std::function<void(uint32_t, uint32_t)>& fn) {
+    steals_ = 0;
+
+    for (uint32_t t = 0; t < n_tasks; ++t) {
+        queues_[t % n_workers_]->tasks.push_back(t);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers_ - 1);
+    for (uint32_t w = 1; w < n_workers_; ++w) {
+        threads.emplace_back([this, w, &fn] { worker_loop(w, fn); });
+    }
+
+    worker_loop(0, fn);
+
+    for (auto& t : threads) {
+        t.join();
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * work_pool.h — Work-stealing task pool (headless shell)
+ *
+ * Runs independent tasks (e.g. whole simulations) across worker threads.
+ * Each worker owns a deque: it pops its own work from the back and, when
+ * empty, steals from the front of another worker's deque. Tasks are
+ * identified by index; the pool never inspects them.
+ *
+ * Shell-side only: Core stays single-threaded per instance (D113), so
+ * parallelism here is across independent ax_core instances.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class work_pool {
+public:
+    /* n_workers == 0 picks std::thread::hardware_concurrency() */
+    explicit work_pool(uint32_t n_workers);
+
+    uint32_t worker_count() const { return n_workers_; }
+
+    /*
+     * Runs fn(task_index, worker_index) for every task in [0, n_tasks)
+     * and blocks until all tasks finished. The calling thread acts as
+     * worker 0. Tasks are dealt round-robin up front; load imbalance is
+     * absorbed by stealing.
+     */
+    void run(uint32_t n_tasks,
+             const std::function<void(uint32_t task, uint32_t worker)>& fn);
+
+    /* tasks executed by a worker other than the one they were dealt to */
+    uint64_t steal_count() const { return steals_; }
+
+private:
+    struct worker_queue {
+        std::mutex           lock;
+        std::deque<uint32_t> tasks;
+    };
+
+    bool pop_local(uint32_t worker, uint32_t* out_task);
+    bool steal(uint32_t thief, uint32_t* out_task);
+    void worker_loop(uint32_t worker,
+                     const std::function<void(uint32_t, uint32_t)>& fn);
+
+    uint32_t n_workers_;
+    uint64_t steals_;
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::mutex steals_lock_;
+};
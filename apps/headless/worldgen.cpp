@@ -0,0 +1,454 @@
+/*
+ * worldgen.cpp — Synthetic large-world generator for load and soak tests
+ *
+ * See worldgen.h.
+ */
+
+#include "worldgen.h"
+#include "shell_common.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const char* const LAYOUT_NAMES[AX_POP_LAYOUT_COUNT] = {
+    "uniform", "grid", "clusters", "ring",
+};
+
+bool worldgen_parse_layout(const char* name, uint32_t* out_layout) {
+    for (uint32_t i = 0; i < AX_POP_LAYOUT_COUNT; ++i) {
+        if (std::strcmp(name, LAYOUT_NAMES[i]) == 0) {
+            *out_layout = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* worldgen_layout_name(uint32_t layout) {
+    return layout < AX_POP_LAYOUT_COUNT ? LAYOUT_NAMES[layout] : "?";
+}
+
+void worldgen_default_params(ax_population_params_v1* out) {
+    *out = {};
+    out->version          = 1;
+    out->size_bytes       = sizeof(*out);
+    out->seed             = 1;
+    out->count            = 100000;
+    out->layout           = AX_POP_LAYOUT_UNIFORM;
+    out->min_x            = -500.0f;
+    out->min_z            = -500.0f;
+    out->max_x            = 500.0f;
+    out->max_z            = 500.0f;
+    out->cluster_count    = 16;
+    out->cluster_radius_m = 20.0f;
+    out->archetype_count  = 1;
+    out->archetypes[0].archetype_id = 2000;
+    out->archetypes[0].weight       = 1;
+    out->archetypes[0].hp           = 50;
+}
+
+/* ── Population record (JSON subset) ──────────────────────────────── */
+
+/*
+ * Just enough JSON for one flat record: objects, arrays, strings
+ * without escapes beyond \" and \\, numbers, true/false/null. Unknown
+ * keys are skipped so records can carry extra metadata.
+ */
+struct json_cursor {
+    const char*  p;
+    std::string* error;
+
+    bool fail(const char* what) {
+        if (error->empty()) *error = what;
+        return false;
+    }
+    void ws() {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') ++p;
+    }
+    bool eat(char c) {
+        ws();
+        if (*p != c) return false;
+        ++p;
+        return true;
+    }
+    bool expect(char c) {
+        if (eat(c)) return true;
+        char msg[48];
+        snprintf(msg, sizeof(msg), "expected '%c'", c);
+        return fail(msg);
+    }
+
+    bool string(std::string* out) {
+        if (!expect('"')) return false;
+        out->clear();
+        while (*p && *p != '"') {
+            if (*p == '\\' && (p[1] == '"' || p[1] == '\\')) ++p;
+            out->push_back(*p++);
+        }
+        if (*p != '"') return fail("unterminated string");
+        ++p;
+        return true;
+    }
+
+    /* the raw token; callers convert it with the width they need */
+    bool number(std::string* out) {
+        ws();
+        out->clear();
+        while ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E') {
+            out->push_back(*p++);
+        }
+        return out->empty() ? fail("expected a number") : true;
+    }
+
+    bool skip_value() {
+        ws();
+        std::string tok;
+        if (*p == '"') return string(&tok);
+        if (*p == '{' || *p == '[') {
+            char close = *p == '{' ? '}' : ']';
+            ++p;
+            if (eat(close)) return true;
+            do {
+                if (close == '}' && !(string(&tok) && expect(':'))) return false;
+                if (!skip_value()) return false;
+            } while (eat(','));
+            return expect(close);
+        }
+        for (const char* word : { "true", "false", "null" }) {
+            size_t n = std::strlen(word);
+            if (std::strncmp(p, word, n) == 0) {
+                p += n;
+                return true;
+            }
+        }
+        return number(&tok);
+    }
+};
+
+static bool to_u64(const std::string& tok, uint64_t* out) {
+    char* end = nullptr;
+    if (tok.empty() || tok[0] == '-') return false;
+    *out = std::strtoull(tok.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+static bool to_u32(const std::string& tok, uint32_t* out) {
+    uint64_t v = 0;
+    if (!to_u64(tok, &v) || v > UINT32_MAX) return false;
+    *out = (uint32_t)v;
+    return true;
+}
+
+static bool to_float(const std::string& tok, float* out) {
+    char* end = nullptr;
+    double v = std::strtod(tok.c_str(), &end);
+    if (*end != '\0' || !std::isfinite(v)) return false;
+    *out = (float)v;
+    return true;
+}
+
+static bool parse_archetype(json_cursor* c, ax_population_archetype_v1* out) {
+    *out = {};
+    bool have_id = false;
+    if (!c->expect('{')) return false;
+    if (c->eat('}')) return c->fail("archetype needs an \"id\"");
+    std::string key, tok;
+    do {
+        if (!c->string(&key) || !c->expect(':')) return false;
+        if (key == "id") {
+            if (!c->number(&tok) || !to_u32(tok, &out->archetype_id)) return c->fail("bad archetype id");
+            have_id = true;
+        } else if (key == "weight") {
+            if (!c->number(&tok) || !to_u32(tok, &out->weight)) return c->fail("bad archetype weight");
+        } else if (key == "hp") {
+            uint32_t hp = 0;
+            if (!c->number(&tok) || !to_u32(tok, &hp) || hp > INT32_MAX) return c->fail("bad archetype hp");
+            out->hp = (int32_t)hp;
+        } else if (!c->skip_value()) {
+            return false;
+        }
+    } while (c->eat(','));
+    if (!c->expect('}')) return false;
+    return have_id ? true : c->fail("archetype needs an \"id\"");
+}
+
+bool worldgen_parse_population(const char* json, ax_population_params_v1* out, std::string* error) {
+    error->clear();
+    json_cursor c = { json, error };
+    std::string key, tok;
+
+    if (!c.expect('{')) return false;
+    bool typed = false;
+    if (!c.eat('}')) {
+        do {
+            if (!c.string(&key) || !c.expect(':')) return false;
+            bool ok = true;
+            if (key == "type") {
+                ok = c.string(&tok);
+                if (ok && tok != "population") return c.fail("\"type\" must be \"population\"");
+                typed = ok;
+            } else if (key == "seed") {
+                ok = c.number(&tok) && to_u64(tok, &out->seed);
+            } else if (key == "count") {
+                ok = c.number(&tok) && to_u32(tok, &out->count);
+            } else if (key == "layout") {
+                ok = c.string(&tok) && worldgen_parse_layout(tok.c_str(), &out->layout);
+            } else if (key == "region") {
+                float* dst[4] = { &out->min_x, &out->min_z, &out->max_x, &out->max_z };
+                ok = c.expect('[');
+                for (int i = 0; i < 4 && ok; ++i) {
+                    ok = (i == 0 || c.expect(',')) && c.number(&tok) && to_float(tok, dst[i]);
+                }
+                ok = ok && c.expect(']');
+            } else if (key == "jitter_m") {
+                ok = c.number(&tok) && to_float(tok, &out->jitter_m);
+            } else if (key == "cluster_count") {
+                ok = c.number(&tok) && to_u32(tok, &out->cluster_count);
+            } else if (key == "cluster_radius_m") {
+                ok = c.number(&tok) && to_float(tok, &out->cluster_radius_m);
+            } else if (key == "ring_inner_radius_m") {
+                ok = c.number(&tok) && to_float(tok, &out->ring_inner_radius_m);
+            } else if (key == "archetypes") {
+                ok = c.expect('[');
+                out->archetype_count = 0;
+                if (ok && !c.eat(']')) {
+                    do {
+                        if (out->archetype_count == AX_POP_MAX_ARCHETYPES) {
+                            return c.fail("too many archetypes");
+                        }
+                        ok = parse_archetype(&c, &out->archetypes[out->archetype_count++]);
+                    } while (ok && c.eat(','));
+                    ok = ok && c.expect(']');
+                }
+            } else {
+                ok = c.skip_value();
+            }
+            if (!ok) {
+                char msg[96];
+                snprintf(msg, sizeof(msg), "bad value for \"%s\"", key.c_str());
+                return c.fail(msg);
+            }
+        } while (c.eat(','));
+        if (!c.expect('}')) return false;
+    }
+    c.ws();
+    if (*c.p != '\0') return c.fail("trailing characters after the record");
+    return typed ? true : c.fail("missing \"type\": \"population\"");
+}
+
+bool worldgen_parse_mix(const char* spec, ax_population_params_v1* out) {
+    uint32_t n = 0;
+    const char* p = spec;
+    while (*p) {
+        if (n == AX_POP_MAX_ARCHETYPES) return false;
+        char* end = nullptr;
+        unsigned long id = std::strtoul(p, &end, 10);
+        if (end == p || *end != ':') return false;
+        p = end + 1;
+        unsigned long weight = std::strtoul(p, &end, 10);
+        if (end == p || *end != ':') return false;
+        p = end + 1;
+        long hp = std::strtol(p, &end, 10);
+        if (end == p || (*end != ',' && *end != '\0')) return false;
+        p = *end == ',' ? end + 1 : end;
+        if (id > UINT32_MAX || weight > UINT32_MAX || hp <= 0 || hp > INT32_MAX) return false;
+
+        out->archetypes[n] = {};
+        out->archetypes[n].archetype_id = (uint32_t)id;
+        out->archetypes[n].weight       = (uint32_t)weight;
+        out->archetypes[n].hp           = (int32_t)hp;
+        n++;
+    }
+    if (n == 0) return false;
+    out->archetype_count = n;
+    return true;
+}
+
+static bool parse_region(const char* spec, ax_population_params_v1* out) {
+    float v[4];
+    const char* p = spec;
+    for (int i = 0; i < 4; ++i) {
+        char* end = nullptr;
+        v[i] = std::strtof(p, &end);
+        if (end == p || *end != (i < 3 ? ',' : '\0')) return false;
+        p = end + 1;
+    }
+    out->min_x = v[0];
+    out->min_z = v[1];
+    out->max_x = v[2];
+    out->max_z = v[3];
+    return true;
+}
+
+static bool read_file(const char* path, std::string* out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    out->clear();
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out->append(buf, n);
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+/* ── CLI ──────────────────────────────────────────────────────────── */
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static int usage() {
+    printf("usage: axiom_headless worldgen [--population FILE] [--count N] [--layout L]"
+           " [--seed S] [--region X0,Z0,X1,Z1] [--mix ID:WEIGHT:HP,...] [--ticks N]"
+           " [--workers W] [--save FILE]\n"
+           "  layouts: uniform grid clusters ring\n");
+    return 2;
+}
+
+int worldgen_main(int argc, char** argv) {
+    ax_population_params_v1 pop;
+    worldgen_default_params(&pop);
+    uint32_t    ticks     = 0;
+    uint32_t    workers   = 1;
+    const char* save_path = nullptr;
+
+    /* the record first, so flags override it wherever they appear */
+    for (int i = 0; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--population") == 0) {
+            std::string text, error;
+            if (!read_file(argv[i + 1], &text)) {
+                printf("  FAILED: cannot read %s\n", argv[i + 1]);
+                return 1;
+            }
+            if (!worldgen_parse_population(text.c_str(), &pop, &error)) {
+                printf("  FAILED: %s: %s\n", argv[i + 1], error.c_str());
+                return 1;
+            }
+        }
+    }
+
+    for (int i = 0; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--population") == 0 && has_value) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--count") == 0 && has_value) {
+            pop.count = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--layout") == 0 && has_value) {
+            if (!worldgen_parse_layout(argv[++i], &pop.layout)) return usage();
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+            pop.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--region") == 0 && has_value) {
+            if (!parse_region(argv[++i], &pop)) return usage();
+        } else if (std::strcmp(argv[i], "--mix") == 0 && has_value) {
+            if (!worldgen_parse_mix(argv[++i], &pop)) return usage();
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && has_value) {
+            ticks = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && has_value) {
+            workers = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--save") == 0 && has_value) {
+            save_path = argv[++i];
+        } else {
+            return usage();
+        }
+    }
+
+    printf("=== Axiom Worldgen: %u targets, layout %s, seed %llu ===\n\n",
+           pop.count, worldgen_layout_name(pop.layout), (unsigned long long)pop.seed);
+
+    ax_core* core = create_and_load("content/");
+    if (!core) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        return 1;
+    }
+    ax_threading_params_v1 tp = {};
+    tp.version      = 1;
+    tp.size_bytes   = sizeof(tp);
+    tp.worker_count = workers;
+    if (ax_set_threading(core, &tp) != AX_OK) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return 1;
+    }
+
+    std::vector<uint8_t> before = take_snapshot(core);
+    uint32_t base = parse_snapshot(before.data(), (uint32_t)before.size()).header->entity_count;
+
+    auto     t0    = std::chrono::steady_clock::now();
+    uint32_t first = 0;
+    if (ax_spawn_population(core, &pop, &first) != AX_OK) {
+        printf("  FAILED: %s\n", ax_get_last_error());
+        ax_destroy(core);
+        return 1;
+    }
+    double gen_s = seconds_since(t0);
+    printf("  generate   %.1f ms  (%.2f M targets/s), first id 0x%08X\n",
+           gen_s * 1e3, gen_s > 0.0 ? pop.count / gen_s * 1e-6 : 0.0, first);
+
+    /* the population follows the content entities in dense (snapshot) order */
+    std::vector<uint8_t> snap = take_snapshot(core);
+    parsed_snapshot ps = parse_snapshot(snap.data(), (uint32_t)snap.size());
+    uint32_t per_archetype[AX_POP_MAX_ARCHETYPES] = {};
+    float lo_x = INFINITY, lo_z = INFINITY, hi_x = -INFINITY, hi_z = -INFINITY;
+    for (uint32_t i = base; i < ps.header->entity_count; ++i) {
+        const ax_snapshot_entity_v1& e = ps.entities[i];
+        for (uint32_t a = 0; a < pop.archetype_count; ++a) {
+            if (pop.archetypes[a].archetype_id == e.archetype_id) {
+                per_archetype[a]++;
+                break;
+            }
+        }
+        lo_x = e.px < lo_x ? e.px : lo_x;
+        hi_x = e.px > hi_x ? e.px : hi_x;
+        lo_z = e.pz < lo_z ? e.pz : lo_z;
+        hi_z = e.pz > hi_z ? e.pz : hi_z;
+    }
+    printf("  bounds     x [%.1f, %.1f]  z [%.1f, %.1f]\n", lo_x, hi_x, lo_z, hi_z);
+    for (uint32_t a = 0; a < pop.archetype_count; ++a) {
+        printf("  archetype  %-6u %9u  (%5.1f%%, hp %d)\n", pop.archetypes[a].archetype_id,
+               per_archetype[a], 100.0 * per_archetype[a] / pop.count, pop.archetypes[a].hp);
+    }
+
+    ax_memory_stats_v1 mem = {};
+    mem.version    = 1;
+    mem.size_bytes = sizeof(mem);
+    if (ax_get_memory_stats(core, &mem) == AX_OK) {
+        printf("  entities   %u live, %.1f MB reserved\n", ps.header->entity_count,
+               mem.subsystems[AX_MEM_ENTITIES].reserved_bytes / (1024.0 * 1024.0));
+    }
+
+    if (ticks > 0) {
+        t0 = std::chrono::steady_clock::now();
+        if (ax_step_ticks(core, ticks) != AX_OK) {
+            printf("  FAILED: %s\n", ax_get_last_error());
+            ax_destroy(core);
+            return 1;
+        }
+        double step_s = seconds_since(t0);
+        printf("  step       %u ticks, %.3f ms/tick (%u workers)\n", ticks, step_s * 1e3 / ticks, workers);
+    }
+
+    uint64_t hash = 0;
+    ax_get_state_hash(core, &hash);
+    printf("  state hash 0x%016llX\n", (unsigned long long)hash);
+
+    if (save_path) {
+        std::vector<uint8_t> save = take_save(core);
+        FILE* f = fopen(save_path, "wb");
+        bool written = f && fwrite(save.data(), 1, save.size(), f) == save.size();
+        written = f && fclose(f) == 0 && written;
+        if (!written) {
+            printf("  FAILED: cannot write %s\n", save_path);
+            ax_destroy(core);
+            return 1;
+        }
+        printf("  save       %zu bytes -> %s\n", save.size(), save_path);
+    }
+
+    ax_destroy(core);
+    return 0;
+}
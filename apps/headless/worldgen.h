@@ -0,0 +1,46 @@
+/*
+ * worldgen.h — Synthetic large-world generator for load and soak tests
+ *
+ * `axiom_headless worldgen [--population FILE] [--count N] [--layout L]
+ *                          [--seed S] [--region X0,Z0,X1,Z1]
+ *                          [--mix ID:WEIGHT:HP,...] [--ticks N]
+ *                          [--workers W] [--save FILE]`
+ *
+ * Loads the A1 world, spawns a procedural population on top of it with
+ * ax_spawn_population and reports generation time, the per-archetype
+ * mix, the spatial bounds, entity memory and the state hash. With
+ * --ticks the world is then stepped (player idle) and the mean tick
+ * time reported; --save writes the resulting world for soak runs.
+ *
+ * --population reads a content "population" record (JSON, see
+ * CONTENT_DATABASE.md, examples in apps/headless/populations/); the
+ * other flags override fields of the record. Layouts: uniform, grid,
+ * clusters, ring. The same flags always produce the same world.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <string>
+
+/* Defaults for the fields a record or the flags may leave out. */
+void worldgen_default_params(ax_population_params_v1* out);
+
+/*
+ * Parses a population record over `out` (fields it names replace the
+ * defaults already in `out`). False with *error set on malformed JSON,
+ * wrong "type", unknown layouts or out-of-range numbers; range checks
+ * beyond that are left to ax_spawn_population.
+ */
+bool worldgen_parse_population(const char* json, ax_population_params_v1* out, std::string* error);
+
+/* "2000:3:50,2001:1:200" -> archetypes[] (id:weight:hp). */
+bool worldgen_parse_mix(const char* spec, ax_population_params_v1* out);
+
+/* "uniform" / "grid" / "clusters" / "ring"; false if unknown. */
+bool worldgen_parse_layout(const char* name, uint32_t* out_layout);
+const char* worldgen_layout_name(uint32_t layout);
+
+/* CLI entry point: argv = { flags as above } */
+int worldgen_main(int argc, char** argv);
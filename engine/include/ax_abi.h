@@ -45,7 +45,7 @@ extern "C" {
 /* ── ABI version (D108) ───────────────────────────────────────────── */
 
 #define AX_ABI_MAJOR 0
-#define AX_ABI_MINOR 1
+#define AX_ABI_MINOR 21
 
 typedef struct ax_abi_version {
     uint16_t major;
@@ -64,21 +64,83 @@ typedef enum ax_result {
     AX_ERR_BUFFER_TOO_SMALL = 4,
     AX_ERR_PARSE_FAILED     = 5,
     AX_ERR_IO               = 6,
-    AX_ERR_INTERNAL         = 7
+    AX_ERR_INTERNAL         = 7,
+    AX_ERR_QUEUE_FULL       = 8,    /* ABI 0.5: action inbox has no room */
+    AX_ERR_OUT_OF_MEMORY    = 9     /* ABI 0.20: an allocation failed   */
 } ax_result;
 
 /* ── Last error (diagnostics only) ────────────────────────────────── */
 
+/*
+ * Thread-local: returns the last error raised by a Core call made on the
+ * calling thread. Valid until the next Core call on that thread.
+ */
 AX_API const char* ax_get_last_error(void);
 
+/* ── Threading (ABI 0.2) ──────────────────────────────────────────── *
+ *                                                                      *
+ *   - Independent ax_core instances may be driven from different       *
+ *     threads concurrently; they share no mutable state.               *
+ *   - A single ax_core instance is still driven from one thread at a   *
+ *     time (ax_step_ticks is not re-entrant).                          *
+ *   - Within a tick, a core may run independent per-entity work on     *
+ *     its own worker threads (ax_set_threading, ABI 0.3). Results are  *
+ *     bit-identical for every worker count.                            *
+ *   - ax_step_ticks_async (ABI 0.4) runs a step on a core-owned        *
+ *     thread; see "Asynchronous stepping" for what is legal meanwhile. *
+ *   - One input thread may submit through the action inbox (ABI 0.5)  *
+ *     while the owner thread drives the core.                          *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
 /* ── Opaque core handle ───────────────────────────────────────────── */
 
 typedef struct ax_core ax_core;
 
 /* ── Log callback ─────────────────────────────────────────────────── */
 
+/* level is an ax_log_level; see "Logging" (ABI 0.14) for delivery. */
 typedef void (*ax_log_fn)(void* user, int level, const char* msg);
 
+/* ── Host allocator (ABI 0.6) ─────────────────────────────────────── *
+ *                                                                      *
+ *   When supplied at ax_create, every allocation the core makes for a  *
+ *   core instance (the instance itself, entity/action/event storage,   *
+ *   timers, arenas, the action inbox) goes through these callbacks.    *
+ *   Thread stacks/state for worker and async threads are created by    *
+ *   the C++ runtime and are not routed through them.                   *
+ *                                                                      *
+ *   - alloc:   size > 0; align is a power of two. NULL = out of memory.*
+ *   - realloc: optional (NULL = alloc + copy + free). Contents up to   *
+ *              min(old_size, new_size) must be preserved.              *
+ *   - free:    ptr is non-NULL; size/align match the allocation.       *
+ *   Callbacks may be invoked from the core's worker/async threads, but *
+ *   never concurrently for the same core.                              *
+ *                                                                      *
+ *   When a callback returns NULL, the call that needed the memory      *
+ *   returns AX_ERR_OUT_OF_MEMORY (ABI 0.20) and leaves the core as it  *
+ *   was. A step fails per tick: the ticks before the failing one stay  *
+ *   applied and the failing tick never ran (ax_step_wait reports it    *
+ *   for an asynchronous step).                                         *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef void* (*ax_alloc_fn)(void* user, size_t size, size_t align);
+typedef void* (*ax_realloc_fn)(void* user, void* ptr, size_t old_size,
+                               size_t new_size, size_t align);
+typedef void  (*ax_free_fn)(void* user, void* ptr, size_t size, size_t align);
+
+typedef struct ax_allocator_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_allocator_v1)          */
+
+    ax_alloc_fn   alloc;        /* required                         */
+    ax_realloc_fn realloc;      /* optional                         */
+    ax_free_fn    free;         /* required                         */
+    void*         user;         /* passed to every callback         */
+} ax_allocator_v1;
+
 /* ── Core creation parameters ─────────────────────────────────────── */
 
 typedef struct ax_create_params_v1 {
@@ -91,6 +153,13 @@ typedef struct ax_create_params_v1 {
 
     ax_log_fn log_fn;       /* optional (NULL = no logging) */
     void*     log_user;     /* optional (passed to log_fn)  */
+
+    /*
+     * ABI 0.6 extension. Shells built against earlier headers pass the
+     * smaller size_bytes and get the default (global new/delete).
+     * Copied at ax_create; the callbacks must outlive the core.
+     */
+    const ax_allocator_v1* allocator;   /* optional (NULL = default) */
 } ax_create_params_v1;
 
 /* ── Core lifecycle ───────────────────────────────────────────────── */
@@ -98,6 +167,13 @@ typedef struct ax_create_params_v1 {
 AX_API ax_result ax_create(const ax_create_params_v1* params, ax_core** out_core);
 AX_API void      ax_destroy(ax_core* core);
 
+/*
+ * Last error raised by a call on this core (ABI 0.2), independent of the
+ * calling thread. Returns "" for NULL or when the last call succeeded.
+ * Valid until the next call on this core.
+ */
+AX_API const char* ax_get_core_last_error(const ax_core* core);
+
 /* ── Content loading ──────────────────────────────────────────────── */
 
 typedef struct ax_content_load_params_v1 {
@@ -111,6 +187,14 @@ typedef struct ax_content_load_params_v1 {
 AX_API ax_result ax_load_content(ax_core* core, const ax_content_load_params_v1* params);
 AX_API ax_result ax_unload_content(ax_core* core);
 
+/*
+ * Hash of the loaded content records (ABI 0.15), so a replay or tool
+ * can check it runs against the content it was made with. Unlike the
+ * state hash it is stable across builds; ticks and save loads do not
+ * change it. AX_ERR_BAD_STATE until content is loaded.
+ */
+AX_API ax_result ax_get_content_hash(ax_core* core, uint64_t* out_hash);
+
 /* ── Save / Load (SAVE_FORMAT.md is source of truth) ──────────────── */
 
 AX_API ax_result ax_save_bytes(
@@ -141,7 +225,7 @@ typedef enum ax_action_type_v1 {
 
 typedef struct ax_action_v1 {
     uint64_t tick;              /* target tick (absolute index)     */
-    uint32_t actor_id;          /* stable entity id (player in A1)  */
+    uint32_t actor_id;          /* stable entity id (see below)     */
     uint32_t type;              /* ax_action_type_v1                */
     union {
         struct { float x; float y; }           move;           /* 2D input vector      */
@@ -166,10 +250,98 @@ typedef struct ax_action_batch_v1 {
 
 AX_API ax_result ax_submit_actions(ax_core* core, const ax_action_batch_v1* batch);
 
+/* ── Action inbox (ABI 0.5) ───────────────────────────────────────── *
+ *                                                                      *
+ *   A bounded lock-free single-producer queue through which one input  *
+ *   thread submits actions while the owner thread steps the core.      *
+ *                                                                      *
+ *   - ax_enable_action_inbox: owner thread, before the producer       *
+ *     starts. Re-enabling replaces the inbox and drops its contents.   *
+ *   - ax_inbox_submit_actions: producer thread only. Legal at any      *
+ *     time after enable, including during ax_step_ticks_async, until   *
+ *     the owner calls ax_enable_action_inbox again or ax_destroy.      *
+ *   - Structural validation matches ax_submit_actions and runs on the  *
+ *     producer thread; errors are reported via that thread's           *
+ *     ax_get_last_error only. Tick-time validation is unchanged.       *
+ *   - A batch is queued whole or not at all (AX_ERR_QUEUE_FULL).       *
+ *   - The inbox is drained at the start of every tick, in submission   *
+ *     order, after actions from ax_submit_actions. An action with      *
+ *     tick == 0 applies on the tick that drains it.                    *
+ *   - ax_unload_content discards undrained inbox actions.              *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef struct ax_inbox_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_inbox_params_v1)       */
+
+    uint32_t capacity;          /* actions, rounded up to a power of
+                                   two; 0 = 4096, max 1048576       */
+    uint32_t pad0;
+} ax_inbox_params_v1;
+
+AX_API ax_result ax_enable_action_inbox(ax_core* core, const ax_inbox_params_v1* params);
+AX_API ax_result ax_inbox_submit_actions(ax_core* core, const ax_action_batch_v1* batch);
+
 /* ── Simulation stepping ──────────────────────────────────────────── */
 
 AX_API ax_result ax_step_ticks(ax_core* core, uint32_t n_ticks);
 
+/* ── Asynchronous stepping (ABI 0.4) ──────────────────────────────── *
+ *                                                                      *
+ *   ax_step_ticks_async starts n_ticks of stepping on a thread owned   *
+ *   by the core and returns immediately, so a shell can render the     *
+ *   previous snapshot while the next ticks run. Results are identical  *
+ *   to ax_step_ticks(core, n_ticks).                                   *
+ *                                                                      *
+ *   While a step is in flight, only these calls are legal on the core: *
+ *     ax_step_poll, ax_step_wait, ax_destroy (waits for the step),     *
+ *     plus the core-independent ax_get_abi_version/ax_get_last_error.  *
+ *   Every other call returns AX_ERR_BAD_STATE without touching the     *
+ *   core (reported via ax_get_last_error only), and                    *
+ *   ax_get_core_last_error returns "".                                 *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+/* Lifecycle errors are reported synchronously. n_ticks == 0 is a no-op. */
+AX_API ax_result ax_step_ticks_async(ax_core* core, uint32_t n_ticks);
+
+/* *out_done = 1 when no step is in flight, else 0. Never blocks. */
+AX_API ax_result ax_step_poll(ax_core* core, int32_t* out_done);
+
+/*
+ * Blocks until no step is in flight and returns the result of the last
+ * async step (AX_OK if there was none). On failure the step's error is
+ * copied to the calling thread's ax_get_last_error.
+ */
+AX_API ax_result ax_step_wait(ax_core* core);
+
+/* ── Sim threading (ABI 0.3) ──────────────────────────────────────── */
+
+typedef struct ax_threading_params_v1 {
+    uint16_t version;               /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;            /* sizeof(ax_threading_params_v1)   */
+
+    uint32_t worker_count;          /* sim threads incl. caller; 0/1 = single-threaded (max 64) */
+    uint32_t min_parallel_items;    /* items per phase below which work runs inline (0 = default) */
+} ax_threading_params_v1;
+
+/*
+ * Not legal from inside ax_step_ticks. Default: single-threaded.
+ * AX_ERR_INTERNAL: a worker thread could not be started; the core
+ * keeps stepping correctly on the workers that did start.
+ */
+AX_API ax_result ax_set_threading(ax_core* core, const ax_threading_params_v1* params);
+
+/*
+ * 64-bit hash of truth state (tick, entities, weapon state, and the
+ * current tick's events). Equal hashes across runs/worker counts are
+ * the determinism check; the value itself is not stable across builds.
+ */
+AX_API ax_result ax_get_state_hash(ax_core* core, uint64_t* out_hash);
+
 /* ── Snapshot access (D109: copy-out only in v1) ──────────────────── */
 
 AX_API ax_result ax_get_snapshot_bytes(
@@ -185,6 +357,11 @@ AX_API ax_result ax_get_snapshot_bytes(
  *   [ ax_snapshot_entity_v1[]     ]  entity_count entries              *
  *   [ ax_snapshot_player_weapon_v1]  if player_weapon_present == 1     *
  *   [ ax_snapshot_event_v1[]      ]  event_count entries               *
+ *   [ ax_snapshot_weapon_table_v1 ]  with AX_SNAPSHOT_FLAG_WEAPONS     *
+ *   [ ax_snapshot_player_weapon_v1[] ]  weapon_count entries           *
+ *                                                                      *
+ *   The weapon table (ABI 0.19, AX_SNAPSHOT_REQ_WEAPONS) lists every   *
+ *   armed actor's weapons in table order; player_id is the owner.      *
  *                                                                      *
  * ──────────────────────────────────────────────────────────────────── */
 
@@ -201,12 +378,14 @@ typedef struct ax_snapshot_header_v1 {
     uint32_t event_count;
     uint32_t event_stride_bytes;    /* = sizeof(ax_snapshot_event_v1)         */
 
-    uint32_t flags;                 /* reserved                     */
+    uint32_t flags;                 /* AX_SNAPSHOT_FLAG_*           */
     uint32_t player_weapon_present; /* 0 or 1                       */
 } ax_snapshot_header_v1;
 
+#define AX_SNAPSHOT_FLAG_WEAPONS (1u << 0)  /* weapon table after the events */
+
 typedef struct ax_snapshot_entity_v1 {
-    uint32_t id;
+    uint32_t id;                /* stable handle, see AX_ENTITY_ID_* */
     uint32_t archetype_id;      /* content record id (0 if N/A) */
 
     float    px, py, pz;
@@ -221,9 +400,17 @@ typedef struct ax_snapshot_entity_v1 {
 #define AX_ENT_FLAG_TARGET    (1u << 1)
 #define AX_ENT_FLAG_DEAD      (1u << 2)
 
+/*
+ * Entity ids (ABI 0.8): low 24 bits = slot, high 8 bits = generation.
+ * A despawned entity's slot is reused under a new generation, so an id
+ * never names a different entity later. 0 is never a valid id.
+ */
+#define AX_ENTITY_ID_SLOT_MASK 0x00FFFFFFu
+#define AX_ENTITY_ID_GEN_SHIFT 24
+
 typedef struct ax_snapshot_player_weapon_v1 {
     uint32_t player_id;
-    uint32_t weapon_slot;       /* 0 in A1                      */
+    uint32_t weapon_slot;       /* < AX_WEAPON_SLOTS            */
 
     int32_t  ammo_in_mag;
     int32_t  ammo_reserve;
@@ -280,6 +467,715 @@ typedef struct ax_diagnostics_v1 {
 
 AX_API ax_result ax_get_diagnostics(ax_core* core, ax_diagnostics_v1* out_diag);
 
+/* ── Memory statistics (ABI 0.7) ──────────────────────────────────── *
+ *                                                                      *
+ *   Where a core's heap goes, by subsystem. Byte counts cover memory   *
+ *   taken through the core's allocator (host callbacks or default);    *
+ *   thread stacks are not included. Cheap enough to poll every frame:  *
+ *   no allocation, no locks, O(subsystems).                            *
+ *                                                                      *
+ *   reserved   = bytes held from the allocator right now               *
+ *   used       = bytes currently holding live data (<= reserved)       *
+ *   high_water = peak `used` since ax_create, sampled at the end of    *
+ *                every tick, on submit and on each query               *
+ *                                                                      *
+ *   The core keeps no snapshot cache or resident content tables:       *
+ *   snapshots and saves are written into the caller's buffer, and      *
+ *   content is expanded into entities at load.                         *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef enum ax_memory_subsystem {
+    AX_MEM_CORE         = 0,    /* the instance itself (fixed-size state)    */
+    AX_MEM_ENTITIES     = 1,    /* entity pool + weapon table                */
+    AX_MEM_ACTION_QUEUE = 2,    /* submitted actions not yet consumed        */
+    AX_MEM_INBOX        = 3,    /* action inbox ring (0 until enabled)       */
+    AX_MEM_FRAME        = 4,    /* per-tick arena: events + tick scratch     */
+    AX_MEM_TIMERS       = 5,
+    AX_MEM_SAVE_SCRATCH = 6,    /* save / state hash staging                 */
+    AX_MEM_JOBS         = 7,    /* job system + per-worker scratch           */
+    AX_MEM_PROFILER     = 8,    /* profile ring + trace buffers (0 if off)   */
+    AX_MEM_LOG          = 9,    /* log record ring (0 without log_fn)        */
+    AX_MEM_COLLISION    = 10,   /* static collision BVH (ABI 0.17)           */
+    AX_MEM_SUBSYSTEM_COUNT = 11
+} ax_memory_subsystem;
+
+#define AX_MEM_MAX_SUBSYSTEMS 16    /* room for later subsystems */
+
+typedef struct ax_memory_usage_v1 {
+    uint64_t reserved_bytes;
+    uint64_t used_bytes;
+    uint64_t high_water_bytes;
+} ax_memory_usage_v1;
+
+typedef struct ax_memory_stats_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_memory_stats_v1)       */
+
+    uint32_t subsystem_count;   /* valid entries in subsystems[]    */
+    uint32_t pad0;
+
+    /* indexed by ax_memory_subsystem */
+    ax_memory_usage_v1 subsystems[AX_MEM_MAX_SUBSYSTEMS];
+
+    /*
+     * Whole core. total.reserved_bytes is the allocator's live byte
+     * count and equals the sum of subsystem reserved bytes;
+     * total.high_water_bytes is the allocator's peak live bytes.
+     */
+    ax_memory_usage_v1 total;
+    uint64_t           allocation_count;    /* allocator calls since ax_create */
+} ax_memory_stats_v1;
+
+/* Fills *out_stats, header included (like ax_get_diagnostics). */
+AX_API ax_result ax_get_memory_stats(ax_core* core, ax_memory_stats_v1* out_stats);
+
+/* ── Debug entity spawning (ABI 0.8) ──────────────────────────────── *
+ *                                                                      *
+ *   Spawns/despawns between ticks, for tools and stress tests until    *
+ *   content-driven spawning exists. Effects are immediate; saves and   *
+ *   the state hash include the result. The player cannot be despawned.*
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef struct ax_debug_spawn_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_debug_spawn_params_v1) */
+
+    uint32_t archetype_id;      /* content record id (0 if N/A)     */
+    int32_t  hp;                /* > 0                              */
+
+    float    px, py, pz;
+    uint32_t pad0;
+} ax_debug_spawn_params_v1;
+
+/* Spawns a target (AX_ENT_FLAG_TARGET); *out_entity_id gets its id. */
+AX_API ax_result ax_debug_spawn_target(ax_core* core, const ax_debug_spawn_params_v1* params,
+                                       uint32_t* out_entity_id);
+
+/* INVALID_ARG for unknown or stale ids. */
+AX_API ax_result ax_debug_despawn_entity(ax_core* core, uint32_t entity_id);
+
+/* ── Compact snapshots (ABI 0.9) ──────────────────────────────────── *
+ *                                                                      *
+ *   Opt-in quantized encoding for bandwidth-bound hosts (network,      *
+ *   replay). Ids, archetypes, flags, hp, the weapon record and events  *
+ *   are lossless; positions snap to position_grid_m; rotations are     *
+ *   normalized and packed smallest-three (max component error ~1e-3).  *
+ *   A non-unit source rotation (the A1 look stub) comes back unit.     *
+ *                                                                      *
+ *   [ ax_snapshot_header_v2        ]                                   *
+ *   [ ax_snapshot_player_weapon_v1 ]  if flags & AX_SNAPSHOT_V2_WEAPON *
+ *   [ u32 weapon_count ]  if flags & AX_SNAPSHOT_V2_WEAPONS            *
+ *   [ entity record ]  entity_count times, in v1 order:                *
+ *       u8      state_flags bits 0..6; bit 7 = hp present              *
+ *       varint  zigzag(id - previous id)     (previous starts at 0)    *
+ *       varint  archetype_id                                           *
+ *       varint  zigzag(round(p / grid))      x3, px py pz              *
+ *       u32     rotation: 2-bit dropped index, 3 x 10-bit components   *
+ *       varint  zigzag(hp)                   if hp present             *
+ *   [ event record ]   event_count times:                              *
+ *       varint  type, a, b;  varint zigzag(value)                      *
+ *   [ weapon record ]  weapon_count times, in table order:             *
+ *       varint  zigzag(owner - previous owner)  (previous starts at 0) *
+ *       varint  weapon_slot, weapon_flags                              *
+ *       varint  zigzag(ammo_in_mag), zigzag(ammo_reserve)              *
+ *       u32     reload_progress bits                                   *
+ *                                                                      *
+ *   varint = unsigned LEB128; fixed-width fields are little-endian.    *
+ *   ax_decode_snapshot_v2 expands a blob back into the v1 layout.      *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+#define AX_SNAPSHOT_REQ_COMPACT     (1u << 0)
+#define AX_SNAPSHOT_REQ_WEAPONS     (1u << 1)   /* append the weapon table (ABI 0.19) */
+#define AX_SNAPSHOT_DEFAULT_GRID_M  (1.0f / 1024.0f)
+
+typedef struct ax_snapshot_request_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_snapshot_request_v1)   */
+
+    uint32_t flags;             /* AX_SNAPSHOT_REQ_*; 0 = v1 blob   */
+    float    position_grid_m;   /* > 0, finite; 0 = default grid    */
+} ax_snapshot_request_v1;
+
+typedef struct ax_snapshot_header_v2 {
+    uint16_t version;           /* = 2                          */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* total blob size in bytes     */
+
+    uint64_t tick;
+
+    uint32_t entity_count;
+    uint32_t event_count;
+
+    float    position_grid_m;   /* quantization step used       */
+    uint32_t flags;             /* AX_SNAPSHOT_V2_*             */
+} ax_snapshot_header_v2;
+
+#define AX_SNAPSHOT_V2_WEAPON  (1u << 0)
+#define AX_SNAPSHOT_V2_WEAPONS (1u << 1)   /* weapon table (ABI 0.19) */
+
+/* Like ax_get_snapshot_bytes, in the encoding the request selects. */
+AX_API ax_result ax_get_snapshot_bytes_ex(
+    ax_core*                      core,
+    const ax_snapshot_request_v1* request,
+    void*                         out_buf,          /* NULL = query required size    */
+    uint32_t                      out_cap_bytes,
+    uint32_t*                     out_size_bytes    /* always written: required size */
+);
+
+/*
+ * Expands a compact blob into the v1 layout. Core-independent: errors
+ * are reported via ax_get_last_error only. out_buf NULL = query the v1
+ * size; *out_size_bytes is written once the v2 header is valid.
+ */
+AX_API ax_result ax_decode_snapshot_v2(
+    const void* v2_buf,
+    uint32_t    v2_size_bytes,
+    void*       out_buf,
+    uint32_t    out_cap_bytes,
+    uint32_t*   out_size_bytes
+);
+
+/* ── Profiling (ABI 0.10) ─────────────────────────────────────────── *
+ *                                                                      *
+ *   Wall-clock time per tick phase for the last AX_PROFILE_RING_TICKS  *
+ *   ticks, plus count / total / max per heavy entry point. Off by      *
+ *   default; ax_set_profiling switches it on (and clears it). Builds   *
+ *   configured without AX_ENABLE_PROFILER return AX_ERR_UNSUPPORTED.   *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef enum ax_profile_phase {
+    AX_PROFILE_PHASE_INBOX          = 0,    /* draining the action inbox          */
+    AX_PROFILE_PHASE_GATHER         = 1,    /* selecting this tick's actions      */
+    AX_PROFILE_PHASE_MOVEMENT       = 2,
+    AX_PROFILE_PHASE_COMBAT         = 3,    /* includes HIT_RESOLUTION            */
+    AX_PROFILE_PHASE_HIT_RESOLUTION = 4,    /* target scans inside COMBAT         */
+    AX_PROFILE_PHASE_TIMERS         = 5,
+    AX_PROFILE_PHASE_COUNT          = 6
+} ax_profile_phase;
+
+typedef enum ax_profile_call {
+    AX_PROFILE_CALL_SUBMIT_ACTIONS  = 0,
+    AX_PROFILE_CALL_STEP_TICKS      = 1,    /* sync and async steps               */
+    AX_PROFILE_CALL_GET_SNAPSHOT    = 2,    /* both encodings                     */
+    AX_PROFILE_CALL_SAVE            = 3,
+    AX_PROFILE_CALL_LOAD            = 4,
+    AX_PROFILE_CALL_GET_STATE_HASH  = 5,
+    AX_PROFILE_CALL_COUNT           = 6
+} ax_profile_call;
+
+#define AX_PROFILE_MAX_PHASES  8
+#define AX_PROFILE_MAX_CALLS   16
+#define AX_PROFILE_RING_TICKS  256
+
+typedef struct ax_profile_tick_v1 {
+    uint64_t tick;
+    uint64_t total_ns;                          /* whole tick, phases + overhead  */
+    uint64_t phase_ns[AX_PROFILE_MAX_PHASES];   /* indexed by ax_profile_phase    */
+} ax_profile_tick_v1;
+
+typedef struct ax_profile_call_v1 {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} ax_profile_call_v1;
+
+typedef struct ax_profile_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_profile_v1)            */
+
+    uint32_t enabled;           /* 0 or 1                           */
+    uint32_t phase_count;       /* valid entries in phase_ns[]      */
+    uint32_t call_count;        /* valid entries in calls[]         */
+    uint32_t tick_count;        /* valid entries in ticks[]         */
+
+    ax_profile_call_v1 calls[AX_PROFILE_MAX_CALLS];    /* indexed by ax_profile_call */
+    ax_profile_tick_v1 ticks[AX_PROFILE_RING_TICKS];   /* oldest first */
+} ax_profile_v1;
+
+/* Switches recording on/off; either way all records are cleared. */
+AX_API ax_result ax_set_profiling(ax_core* core, int32_t enabled);
+
+/* Fills *out_profile, header included (like ax_get_diagnostics). */
+AX_API ax_result ax_get_profile(ax_core* core, ax_profile_v1* out_profile);
+
+/* ── Tracing (ABI 0.11) ───────────────────────────────────────────── *
+ *                                                                      *
+ *   Timeline capture for Chrome / Perfetto. While tracing, every tick, *
+ *   tick phase, profiled entry point and parallel job chunk is         *
+ *   recorded as one complete event (start + duration) into a fixed     *
+ *   per-thread buffer. Events that do not fit are dropped and counted; *
+ *   ticks never allocate. Drain between steps. Builds configured       *
+ *   without AX_ENABLE_PROFILER return AX_ERR_UNSUPPORTED.              *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+/* ax_trace_event_v1.name values; ax_get_trace_name maps them to text. */
+#define AX_TRACE_TICK           0u      /* arg = tick number                    */
+#define AX_TRACE_PHASE_BASE     16u     /* + ax_profile_phase                   */
+#define AX_TRACE_CALL_BASE      32u     /* + ax_profile_call                    */
+#define AX_TRACE_JOB_MOVEMENT   48u     /* movement chunk; arg = actors         */
+#define AX_TRACE_JOB_HIT_SCAN   49u     /* hit-scan chunk; arg = entities       */
+
+#define AX_TRACE_DEFAULT_CAPACITY 65536
+
+typedef struct ax_trace_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_trace_params_v1)       */
+
+    uint32_t capacity_events;   /* per thread; 0 = default          */
+    uint32_t reserved0;         /* must be 0                        */
+} ax_trace_params_v1;
+
+typedef struct ax_trace_event_v1 {
+    uint64_t start_ns;          /* since tracing was enabled        */
+    uint64_t duration_ns;
+    uint32_t name;              /* AX_TRACE_*                       */
+    uint32_t thread;            /* 0 = driving thread, 1.. = workers */
+    uint64_t arg;
+} ax_trace_event_v1;
+
+/*
+ * Starts a fresh trace (params) or stops and discards it (NULL).
+ * Buffers are held only while tracing; AX_ERR_OUT_OF_MEMORY leaves
+ * tracing off.
+ */
+AX_API ax_result ax_enable_tracing(ax_core* core, const ax_trace_params_v1* params);
+
+/*
+ * Moves every buffered event into out_events (grouped by thread, in
+ * order within a thread) and empties the buffers. out_events NULL =
+ * query the pending count. *out_dropped (optional) gets the events lost
+ * to full buffers since the last drain.
+ */
+AX_API ax_result ax_drain_trace(
+    ax_core*           core,
+    ax_trace_event_v1* out_events,      /* NULL = query pending count        */
+    uint32_t           out_cap_events,
+    uint32_t*          out_count,       /* always written: pending count     */
+    uint64_t*          out_dropped      /* nullable                          */
+);
+
+/* Static display name for an AX_TRACE_* value ("?" if unknown). */
+AX_API const char* ax_get_trace_name(uint32_t name);
+
+/* ── Runtime statistics (ABI 0.12) ────────────────────────────────── *
+ *                                                                      *
+ *   Monotonic operational counters plus latency histograms for ticks   *
+ *   and the heavy entry points, independent of AX_ENABLE_PROFILER.     *
+ *   Counters are always on (plain adds; no allocation, no locks).      *
+ *   The histograms stay empty until ax_set_stats_timing turns timing   *
+ *   on (ABI 0.21): two cycle-counter reads per timed call plus one     *
+ *   per tick, shared with the profiler. Everything runs from ax_create *
+ *   or the last ax_reset_stats.                                        *
+ *                                                                      *
+ *   Histograms are log-linear (HDR style): four buckets per power of   *
+ *   two, so any bucket's bounds are within 25% of each other.          *
+ *   Bucket b covers [ax_stats_bucket_floor_ns(b),                      *
+ *   ax_stats_bucket_floor_ns(b + 1)); the last bucket is open-ended.   *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+#define AX_STATS_HIST_BUCKETS   128     /* last bucket: >= 2^33 ns (~8.6 s)     */
+#define AX_STATS_MAX_CALLS      8       /* >= AX_PROFILE_CALL_COUNT             */
+#define AX_STATS_MAX_EVENT_TYPES 8      /* indexed by ax_event_type_v1          */
+#define AX_STATS_MAX_BLOCK_REASONS 4    /* indexed by AX_FIRE_BLOCKED_*         */
+
+typedef struct ax_histogram_v1 {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t min_ns;                            /* 0 while count == 0       */
+    uint64_t max_ns;
+    uint64_t buckets[AX_STATS_HIST_BUCKETS];
+} ax_histogram_v1;
+
+typedef struct ax_stats_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_stats_v1)              */
+
+    uint32_t call_count;        /* valid entries in calls[]         */
+    uint32_t pad0;
+
+    /* actions */
+    uint64_t actions_submitted;     /* queued via ax_submit_actions or the inbox   */
+    uint64_t actions_applied;       /* reached their tick                          */
+    uint64_t actions_stale;         /* dropped: tick already past when gathered    */
+
+    /* ticks and events */
+    uint64_t ticks;
+    uint64_t events[AX_STATS_MAX_EVENT_TYPES];          /* by ax_event_type_v1  */
+    uint64_t fire_blocked[AX_STATS_MAX_BLOCK_REASONS];  /* by AX_FIRE_BLOCKED_* */
+
+    /* output produced / input consumed (successful calls with a buffer) */
+    uint64_t snapshots;
+    uint64_t snapshot_bytes;            /* both encodings   */
+    uint64_t saves;
+    uint64_t save_bytes;
+    uint64_t loads;
+    uint64_t load_bytes;
+
+    ax_histogram_v1 tick_ns;                        /* per simulated tick           */
+    ax_histogram_v1 calls[AX_STATS_MAX_CALLS];      /* indexed by ax_profile_call   */
+} ax_stats_v1;
+
+/* Fills *out_stats, header included (like ax_get_diagnostics). */
+AX_API ax_result ax_get_stats(ax_core* core, ax_stats_v1* out_stats);
+
+/* Zeroes every counter and histogram. Timing stays as it was. */
+AX_API ax_result ax_reset_stats(ax_core* core);
+
+/* Starts (enabled != 0) or stops filling the histograms (ABI 0.21). */
+AX_API ax_result ax_set_stats_timing(ax_core* core, int32_t enabled);
+
+/* Lower bound of histogram bucket b in ns (UINT64_MAX past the last). */
+AX_API uint64_t ax_stats_bucket_floor_ns(uint32_t bucket);
+
+/* ── Procedural population (ABI 0.13) ─────────────────────────────── *
+ *                                                                      *
+ *   Spawns `count` targets on the ground plane in one call, for load   *
+ *   and soak testing at 10k-1M entities. This is the runtime form of   *
+ *   the content "population" record (CONTENT_DATABASE.md). Placement   *
+ *   is a pure function of the params: the same seed gives the same     *
+ *   positions, archetypes and ids on every machine (integer RNG, only  *
+ *   correctly rounded float ops: add/mul/div/sqrt, no sin/cos). All-   *
+ *   or-nothing: on error nothing is spawned. Same lifecycle rules as   *
+ *   ax_debug_spawn_target.                                             *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef enum ax_population_layout {
+    AX_POP_LAYOUT_UNIFORM  = 0,     /* uniform over the region                          */
+    AX_POP_LAYOUT_GRID     = 1,     /* square lattice over the region, +-jitter_m       */
+    AX_POP_LAYOUT_CLUSTERS = 2,     /* uniform discs of cluster_radius_m round centres  */
+    AX_POP_LAYOUT_RING     = 3,     /* annulus: ring_inner_radius_m out to the largest  */
+                                    /* circle inside the region                         */
+    AX_POP_LAYOUT_COUNT    = 4
+} ax_population_layout;
+
+#define AX_POP_MAX_ARCHETYPES 8
+
+typedef struct ax_population_archetype_v1 {
+    uint32_t archetype_id;      /* content record id                */
+    uint32_t weight;            /* relative share; > 0              */
+    int32_t  hp;                /* > 0                              */
+    uint32_t reserved0;         /* must be 0                        */
+} ax_population_archetype_v1;
+
+typedef struct ax_population_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_population_params_v1)  */
+
+    uint64_t seed;
+    uint32_t count;             /* targets to spawn                 */
+    uint32_t layout;            /* ax_population_layout             */
+
+    float    min_x, min_z;      /* region on the ground plane (y=0) */
+    float    max_x, max_z;      /* max > min                        */
+
+    float    jitter_m;          /* GRID                             */
+    uint32_t cluster_count;     /* CLUSTERS; > 0                    */
+    float    cluster_radius_m;  /* CLUSTERS                         */
+    float    ring_inner_radius_m; /* RING; below the outer radius   */
+
+    uint32_t archetype_count;   /* 1..AX_POP_MAX_ARCHETYPES         */
+    uint32_t reserved0;         /* must be 0                        */
+    ax_population_archetype_v1 archetypes[AX_POP_MAX_ARCHETYPES];
+} ax_population_params_v1;
+
+/*
+ * Appends the population to the dense (snapshot) order; *out_first_id
+ * (nullable) gets the first new id. New entities take free slots
+ * lowest-first, exactly as repeated ax_debug_spawn_target calls would,
+ * so their ids are not contiguous when earlier slots were free.
+ * INVALID_ARG if count exceeds the free entity slots.
+ */
+AX_API ax_result ax_spawn_population(ax_core* core, const ax_population_params_v1* params,
+                                     uint32_t* out_first_id);
+
+/* ── Logging (ABI 0.14) ───────────────────────────────────────────── *
+ *                                                                      *
+ *   With a log_fn at ax_create, the core logs as fixed-size binary     *
+ *   records (level, tick, code, args) pushed into a lock-free ring.    *
+ *   Writing a record never formats, allocates, locks or calls the      *
+ *   host, so logging on the tick path cannot stall a tick. Gameplay    *
+ *   records (kills, blocked fires, reloads, a per-tick count of stale  *
+ *   actions) are written from the tick's events once its phases end.   *
+ *   Records are formatted and handed to log_fn only when flushed: by   *
+ *   ax_flush_log or a core-owned background flusher                    *
+ *   (AX_LOG_FLUSH_BACKGROUND), and once more by ax_destroy.            *
+ *                                                                      *
+ *   A record is not written when its level is above min_level, when    *
+ *   its level has used up rate_per_tick records this tick (counted as  *
+ *   rate_limited), or when the ring is full (counted as dropped_full). *
+ *   log_fn is never called concurrently with itself, but the           *
+ *   background flusher calls it from its own thread.                   *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+typedef enum ax_log_level {
+    AX_LOG_ERROR = 0,
+    AX_LOG_WARN  = 1,           /* per-tick count of stale actions    */
+    AX_LOG_INFO  = 2,           /* content / save loaded, kills       */
+    AX_LOG_DEBUG = 3,           /* per-action detail (fire blocked)   */
+    AX_LOG_LEVEL_COUNT = 4
+} ax_log_level;
+
+typedef enum ax_log_flush_mode {
+    AX_LOG_FLUSH_MANUAL     = 0,    /* ax_flush_log only                     */
+    AX_LOG_FLUSH_BACKGROUND = 1     /* plus a flusher every flush_interval_ms */
+} ax_log_flush_mode;
+
+#define AX_LOG_DEFAULT_CAPACITY    4096
+#define AX_LOG_MAX_CAPACITY        (1u << 20)
+#define AX_LOG_DEFAULT_INTERVAL_MS 10
+
+typedef struct ax_log_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_log_params_v1)         */
+
+    uint32_t capacity_records;  /* 0 = default; <= AX_LOG_MAX_CAPACITY */
+    uint32_t min_level;         /* ax_log_level; higher = not written */
+    uint32_t rate_per_tick[AX_LOG_LEVEL_COUNT];  /* 0 = unlimited   */
+    uint32_t flush_mode;        /* ax_log_flush_mode                */
+    uint32_t flush_interval_ms; /* BACKGROUND; 0 = default          */
+} ax_log_params_v1;
+
+typedef struct ax_log_stats_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_log_stats_v1)          */
+
+    uint32_t pending;           /* written, not yet delivered       */
+    uint32_t pad0;
+
+    /* since the last ax_configure_logging (or ax_create) */
+    uint64_t written[AX_LOG_LEVEL_COUNT];
+    uint64_t rate_limited[AX_LOG_LEVEL_COUNT];
+    uint64_t dropped_full;
+    uint64_t delivered;
+} ax_log_stats_v1;
+
+/*
+ * Replaces the pipeline settings (NULL = defaults: INFO and above,
+ * WARN/INFO 64 and DEBUG 256 records per tick, manual flush). Pending
+ * records are delivered first and the counters restart. BAD_STATE if
+ * the core was created without log_fn.
+ */
+AX_API ax_result ax_configure_logging(ax_core* core, const ax_log_params_v1* params);
+
+/*
+ * Formats and delivers every pending record to log_fn on the calling
+ * thread; *out_delivered (nullable) gets the count. Legal while an
+ * async step is in flight (the step keeps writing meanwhile).
+ */
+AX_API ax_result ax_flush_log(ax_core* core, uint32_t* out_delivered);
+
+AX_API ax_result ax_get_log_stats(ax_core* core, ax_log_stats_v1* out_stats);
+
+/* ── Deterministic RNG (ABI 0.16) ─────────────────────────────────── *
+ *                                                                      *
+ *   Core's random numbers are counter-based (Philox4x32-10): each      *
+ *   32-bit draw is a pure function of (world seed, system id, entity   *
+ *   id, tick, draw index). Nothing advances when a draw is taken, so   *
+ *   outcomes cannot depend on which worker, batch or order produced    *
+ *   them, and any entity's draws can be recomputed in isolation. The   *
+ *   world seed is part of the world: it is saved (save 1.3), restored  *
+ *   by ax_load_save_bytes and covered by the state hash. It starts at  *
+ *   0 and keeps its value across content reloads.                      *
+ *                                                                      *
+ *   ax_rng_generate exposes the same function to shells and tools, so  *
+ *   they can reproduce or audit a system's draws.                      *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+#define AX_RNG_MAX_SYSTEMS 0x10000u     /* system ids are 16-bit              */
+#define AX_RNG_SYSTEM_USER 0x8000u      /* first id free for shells and tools */
+#define AX_RNG_MAX_DRAWS   0x40000u     /* per (system, entity, tick)         */
+
+typedef struct ax_rng_request_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_rng_request_v1)        */
+
+    uint32_t system_id;         /* < AX_RNG_MAX_SYSTEMS             */
+    uint32_t first_draw;        /* draw index of out[0] per entity  */
+    uint64_t tick;
+    uint32_t draws_per_entity;  /* first_draw + draws <= MAX_DRAWS  */
+    uint32_t entity_count;
+    const uint32_t* entity_ids; /* any ids; need not exist          */
+} ax_rng_request_v1;
+
+AX_API ax_result ax_set_rng_seed(ax_core* core, uint64_t seed);
+AX_API ax_result ax_get_rng_seed(ax_core* core, uint64_t* out_seed);
+
+/*
+ * Writes entity_count * draws_per_entity words, entity-major:
+ * out_words[i * draws_per_entity + k] is draw first_draw + k of
+ * entity_ids[i] under the current world seed.
+ */
+AX_API ax_result ax_rng_generate(ax_core* core, const ax_rng_request_v1* request,
+                                 uint32_t* out_words);
+
+/* ── Static collision (ABI 0.17) ──────────────────────────────────── *
+ *                                                                      *
+ *   One static triangle mesh per core (level geometry), built into a   *
+ *   SAH bounding volume hierarchy on the core's workers. The mesh is   *
+ *   content: it is not saved, ax_unload_content drops it, and it is    *
+ *   folded into ax_get_content_hash so that replays recorded on other  *
+ *   geometry are caught. With a mesh loaded, a shot whose line from    *
+ *   the shooter's eye to its target is blocked deals no damage.        *
+ *                                                                      *
+ *   ax_raycast traces rays against the mesh for tools and debugging,   *
+ *   alone or in packets of 4 or 8 that share one traversal (faster for *
+ *   rays that start near each other and point the same way). Closest   *
+ *   hits are identical for every packet width.                         *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+#define AX_COLLISION_MAX_TRIANGLES (1u << 24)
+
+typedef struct ax_collision_mesh_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_collision_mesh_v1)     */
+
+    uint32_t vertex_count;
+    uint32_t triangle_count;    /* 0 = remove the mesh              */
+    const float*    vertices;   /* xyz per vertex, finite           */
+    const uint32_t* indices;    /* 3 per triangle, < vertex_count   */
+} ax_collision_mesh_v1;
+
+typedef struct ax_collision_info_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_collision_info_v1)     */
+
+    uint32_t triangle_count;    /* 0 = no mesh                      */
+    uint32_t node_count;
+    uint32_t leaf_count;
+    uint32_t depth;             /* levels, root = 1                 */
+    uint64_t mesh_hash;         /* of the triangles as given        */
+    uint64_t memory_bytes;      /* nodes + triangles                */
+    double   build_ms;          /* last ax_load_collision_mesh      */
+} ax_collision_info_v1;
+
+/*
+ * Replaces the collision mesh (copied; the arrays may be freed after the
+ * call). Requires loaded content; on error the previous mesh is kept.
+ */
+AX_API ax_result ax_load_collision_mesh(ax_core* core, const ax_collision_mesh_v1* mesh);
+AX_API ax_result ax_get_collision_info(ax_core* core, ax_collision_info_v1* out_info);
+
+/* origin + t * dir for t in [0, max_t]; dir need not be unit length */
+typedef struct ax_ray_v1 {
+    float ox, oy, oz;
+    float dx, dy, dz;
+    float max_t;
+} ax_ray_v1;
+
+#define AX_RAY_NO_HIT UINT32_MAX
+
+typedef struct ax_ray_hit_v1 {
+    float    t;                 /* max_t on a miss                  */
+    uint32_t triangle;          /* mesh triangle, AX_RAY_NO_HIT     */
+    float    nx, ny, nz;        /* unit normal, (v1-v0) x (v2-v0)   */
+} ax_ray_hit_v1;
+
+/* ax_raycast_params_v1.flags */
+#define AX_RAYCAST_ANY_HIT 0x1u   /* stop at the first hit found (occlusion) */
+
+typedef struct ax_raycast_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_raycast_params_v1)     */
+
+    uint32_t packet_width;      /* 1, 4 or 8 (0 = 8)                */
+    uint32_t flags;             /* AX_RAYCAST_*                     */
+} ax_raycast_params_v1;
+
+/*
+ * Traces ray_count rays into out_hits[ray_count]. Without a mesh every
+ * ray misses. With AX_RAYCAST_ANY_HIT a hit is some hit within max_t,
+ * not necessarily the closest.
+ */
+AX_API ax_result ax_raycast(ax_core* core, const ax_raycast_params_v1* params,
+                            const ax_ray_v1* rays, uint32_t ray_count, ax_ray_hit_v1* out_hits);
+
+/* ── Character controller (ABI 0.18) ──────────────────────────────── *
+ *                                                                      *
+ *   MOVE_INTENT and LOOK_INTENT drive any living actor: the player or  *
+ *   a target (targets only move when a host sends them intents).       *
+ *   Without a collision mesh, movement stays on the flat ground plane  *
+ *   y = 0.                                                             *
+ *                                                                      *
+ *   With a mesh, each moving actor is a vertical capsule standing on   *
+ *   its position. The tick's MOVE_INTENTs are summed into one          *
+ *   displacement, which Core resolves against the mesh: the capsule    *
+ *   slides along what it hits, steps up ledges up to                   *
+ *   AX_CHARACTER_STEP_M, walks slopes up to                            *
+ *   AX_CHARACTER_MAX_SLOPE_DEG, and then settles onto the ground,      *
+ *   falling at most AX_CHARACTER_FALL_M per move. Actors do not        *
+ *   collide with each other.                                           *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+#define AX_CHARACTER_RADIUS_M      0.4f    /* capsule radius             */
+#define AX_CHARACTER_HEIGHT_M      1.8f    /* feet to top of the capsule */
+#define AX_CHARACTER_STEP_M        0.35f   /* highest ledge stepped onto */
+#define AX_CHARACTER_MAX_SLOPE_DEG 50      /* steepest walkable ground   */
+#define AX_CHARACTER_FALL_M        0.4f    /* settle distance per move   */
+
+/* ── Weapon table (ABI 0.19) ──────────────────────────────────────── *
+ *                                                                      *
+ *   Weapons belong to actors: each living actor (the player or a       *
+ *   target) holds up to AX_WEAPON_SLOTS weapons, one per slot.         *
+ *   FIRE_ONCE and RELOAD use the actor's weapon in the action's slot;  *
+ *   an actor with no weapon there does nothing. A shot never hits its  *
+ *   own shooter. Content arms the player with weapon 1000 in slot 0,   *
+ *   which is the snapshot's player_weapon record.                      *
+ *                                                                      *
+ *   Despawning an actor drops its weapons and cancels their reloads.   *
+ *   Saves carry the whole table from save format 1.4.                  *
+ *                                                                      *
+ * ──────────────────────────────────────────────────────────────────── */
+
+#define AX_WEAPON_SLOTS 4
+
+typedef struct ax_snapshot_weapon_table_v1 {
+    uint32_t weapon_count;
+    uint32_t weapon_stride_bytes;   /* = sizeof(ax_snapshot_player_weapon_v1) */
+} ax_snapshot_weapon_table_v1;
+
+typedef struct ax_debug_weapon_params_v1 {
+    uint16_t version;           /* = 1                              */
+    uint16_t reserved;
+    uint32_t size_bytes;        /* sizeof(ax_debug_weapon_params_v1) */
+
+    uint32_t entity_id;         /* a living player or target        */
+    uint32_t weapon_slot;       /* < AX_WEAPON_SLOTS                */
+    uint32_t weapon_id;         /* content weapon record            */
+    int32_t  ammo_in_mag;       /* 0 .. magazine size               */
+    int32_t  ammo_reserve;      /* >= 0                             */
+    uint32_t pad0;
+} ax_debug_weapon_params_v1;
+
+/*
+ * Arms an actor between ticks. A weapon already in that slot is
+ * replaced, and its reload is cancelled without a RELOAD_DONE.
+ */
+AX_API ax_result ax_debug_give_weapon(ax_core* core, const ax_debug_weapon_params_v1* params);
+
 /* ── End of header ────────────────────────────────────────────────── */
 
 #ifdef __cplusplus
@@ -12,25 +12,47 @@
  */
 
 #include "ax_abi.h"
-
+#include "core/ax_alloc.h"
+#include "core/ax_frame_arena.h"
+#include "core/ax_jobs.h"
+#include "core/ax_log.h"
+#include "core/ax_profiler.h"
+#include "core/ax_rng.h"
+#include "core/ax_snapshot_v2.h"
+#include "core/ax_spsc.h"
+#include "core/ax_stats.h"
+#include "physics/ax_bvh.h"
+#include "physics/ax_character.h"
+#include "sim/ax_entity_pool.h"
+#include "sim/ax_population.h"
+#include "sim/ax_timer_wheel.h"
+#include "sim/ax_weapon_table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
 #include <cstdarg>
 #include <cstddef>
+#include <mutex>
+#include <system_error>
+#include <thread>
 #include <vector>
 #include <cmath>
 
-/* ── Last error (global, since ax_get_last_error takes void) ──────── */
+/* ── Last error (thread-local, since ax_get_last_error takes void) ── */
 
-static char g_last_error[256] = "";
+/*
+ * Thread-local so two threads driving two independent cores never
+ * clobber each other's diagnostics. Each core also keeps a copy of the
+ * last error raised by a call on it (see ax_get_core_last_error).
+ */
 
-static void set_last_error(const char* fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(g_last_error, sizeof(g_last_error), fmt, args);
-    va_end(args);
-}
+#define AX_LAST_ERROR_LEN 256
+
+static thread_local char t_last_error[AX_LAST_ERROR_LEN] = "";
 
 /* ── Lifecycle state ──────────────────────────────────────────────── */
 
@@ -43,7 +65,7 @@ enum ax_lifecycle {
 /* ── Internal entity (truth state) ────────────────────────────────── */
 
 struct ax_entity_internal {
-    uint32_t id;
+    uint32_t id;                /* generational handle (ax_entity_pool.h) */
     uint32_t archetype_id;
 
     float px, py, pz;
@@ -53,48 +75,229 @@ struct ax_entity_internal {
     uint32_t state_flags;       /* AX_ENT_FLAG_*                 */
 };
 
-/* ── Internal weapon state (truth) ────────────────────────────────── */
+/* ── Action queue ─────────────────────────────────────────────────── */
 
-struct ax_weapon_internal {
-    uint32_t player_id;
-    uint32_t weapon_slot;
+/* Kinds of the queued actions, kept with the queue for reserve_tick. */
+struct ax_queue_mix {
+    uint32_t moves   = 0;       /* MOVE / LOOK                   */
+    uint32_t reloads = 0;
 
-    int32_t  ammo_in_mag;
-    int32_t  ammo_reserve;
+    void add(uint32_t type) {
+        moves   += type == AX_ACT_MOVE_INTENT || type == AX_ACT_LOOK_INTENT;
+        reloads += type == AX_ACT_RELOAD;
+    }
+};
+
+/* ── Tick scratch (reused across ticks, never shrunk) ─────────────── */
+
+struct ax_action_ref {
+    uint32_t actor_id;
+    uint32_t action_index;      /* into ax_core::tick_actions    */
+};
+
+/* items per phase below which work runs inline (ax_threading_params_v1) */
+static const uint32_t AX_DEFAULT_PARALLEL_GRAIN = 1024;
 
-    bool     reloading;
-    uint32_t reload_ticks_remaining;
+/* per-worker scratch for parallel phases; own cache line per worker */
+struct alignas(64) ax_worker_scratch {
+    uint32_t hit_index;                         /* hit resolution reduction */
 };
 
 /* ── The real ax_core struct ──────────────────────────────────────── */
 
 struct ax_core {
+    /*
+     * Every heap allocation made for this core goes through `alloc`
+     * (the host's ax_allocator_v1, or global new), so it is declared
+     * first and outlives all the containers below.
+     */
+    ax_alloc_state alloc;
+
+    explicit ax_core(const ax_alloc_state& a)
+        : alloc(a),
+          lifecycle(AX_LIFECYCLE_CREATED), log_fn(nullptr), log_user(nullptr), log(nullptr),
+          tick(0), content_hash(0), rng_seed(0),
+          entities(&alloc),
+          weapons(&alloc),
+          timers(&alloc),
+          fired_timers(ax_allocator<ax_timer_payload>(&alloc)),
+          timer_records(ax_allocator<ax_timer_record>(&alloc)),
+          slot_marks(ax_allocator<uint8_t>(&alloc)),
+          weapon_marks(ax_allocator<uint32_t>(&alloc)),
+          collision(&alloc), collision_build_ms(0.0),
+          character_slots(ax_allocator<uint32_t>(&alloc)),
+          character_caches(ax_allocator<ax_character_cache>(&alloc)),
+          action_queue(ax_allocator<ax_action_v1>(&alloc)),
+          inbox(nullptr),
+          frame(&alloc),
+          jobs(&alloc), parallel_grain(0),
+          worker_scratch(ax_allocator<ax_worker_scratch>(&alloc)),
+          profiler(&alloc),
+          async_in_flight(false), async_quit(false), async_ticks(0), async_result(AX_OK) {
+        last_error[0] = '\0';
+        std::memset(mem_high_water, 0, sizeof(mem_high_water));
+    }
+
     ax_lifecycle lifecycle;
 
     /* logging */
     ax_log_fn log_fn;
     void*     log_user;
+    ax_log*   log;          /* record ring, on `alloc`; NULL without log_fn */
+
+    /* last error raised by a call on this core (see ax_get_core_last_error) */
+    char last_error[AX_LAST_ERROR_LEN];
 
     /* simulation */
     uint64_t tick;
+    uint64_t content_hash;  /* as loaded, without the collision mesh; 0 while unloaded */
+    uint64_t rng_seed;      /* world seed of the Philox streams (core/ax_rng.h) */
+
+    /* entities (truth): dense, iterated in pool order */
+    ax_entity_pool<ax_entity_internal> entities;
+
+    /* weapons (truth): every armed actor's, by (actor, weapon slot) */
+    ax_weapon_table weapons;
+
+    /* gameplay timers keyed by absolute tick (reload completion, ...) */
+    ax_timer_wheel                timers;
+    ax_vector<ax_timer_payload>   fired_timers;    /* phase_timers scratch */
+    ax_vector<ax_timer_record>    timer_records;   /* save/hash scratch    */
+    ax_vector<uint8_t>            slot_marks;      /* load scratch         */
+    ax_vector<uint32_t>           weapon_marks;    /* load scratch         */
 
-    /* entities (truth) */
-    std::vector<ax_entity_internal> entities;
+    /* static collision mesh (content, not saved; ax_load_collision_mesh) */
+    ax_bvh collision;
+    double collision_build_ms;
 
-    /* player weapon (truth, A1: single weapon slot 0) */
-    ax_weapon_internal weapon;
+    /* character controller broadphase caches, by entity slot (phase_movement) */
+    ax_vector<uint32_t>           character_slots;    /* slot -> cache, UINT32_MAX = none */
+    ax_vector<ax_character_cache> character_caches;
 
     /* pending actions for upcoming ticks */
-    std::vector<ax_action_v1> action_queue;
+    ax_vector<ax_action_v1> action_queue;
+    ax_queue_mix            queued_mix;     /* of action_queue */
 
-    /* events emitted during the current tick */
-    std::vector<ax_snapshot_event_v1> events;
+    /* input-thread action inbox (NULL until ax_enable_action_inbox) */
+    ax_spsc_ring<ax_action_v1>* inbox;     /* on `alloc` */
+
+    /*
+     * Per-tick transient data lives in the frame arena, reset at tick
+     * start. Events stay readable (snapshot/hash) until the next tick.
+     */
+    ax_frame_arena frame;
+
+    /* events emitted during the current tick (frame arena) */
+    ax_frame_array<ax_snapshot_event_v1> events;
+
+    /* tick phases (see Simulation stepping) */
+    ax_job_system                  jobs;
+    uint32_t                       parallel_grain;
+    ax_vector<ax_worker_scratch>   worker_scratch;    /* one per worker */
+    ax_frame_array<ax_action_v1>   tick_actions;      /* this tick, submission order */
+    ax_frame_array<ax_action_ref>  move_refs;         /* MOVE/LOOK grouped by actor  */
+    ax_frame_array<uint32_t>       move_runs;         /* actor run starts + end      */
+
+    /* per-phase tick timings (ax_set_profiling / ax_get_profile) */
+    ax_profiler profiler;
+
+    /* always-on counters and latency histograms (ax_get_stats) */
+    ax_stats stats;
+
+    /* asynchronous stepping (ax_step_ticks_async) */
+    std::thread             async_thread;       /* started on first async step   */
+    std::mutex              async_lock;
+    std::condition_variable async_wake;
+    std::condition_variable async_done;
+    std::atomic<bool>       async_in_flight;    /* release: truth visible after   */
+    bool                    async_quit;         /* guarded by async_lock          */
+    uint32_t                async_ticks;        /* pending request (async_lock)   */
+    ax_result               async_result;       /* last async step (async_lock)   */
+
+    /* peak used bytes per ax_memory_subsystem (see sample_memory) */
+    uint64_t mem_high_water[AX_MEM_SUBSYSTEM_COUNT];
 };
 
+/* ── Error helpers ────────────────────────────────────────────────── */
+
+static void set_last_error(ax_core* core, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(t_last_error, sizeof(t_last_error), fmt, args);
+    va_end(args);
+
+    /* mirror into the core so ax_get_core_last_error works cross-thread */
+    if (core) {
+        snprintf(core->last_error, sizeof(core->last_error), "%s", t_last_error);
+    }
+}
+
+static void clear_last_error(ax_core* core) {
+    t_last_error[0] = '\0';
+    if (core) {
+        core->last_error[0] = '\0';
+    }
+}
+
+/*
+ * While an async step is in flight the worker thread owns the core's
+ * truth and last_error, so every other call is rejected up front and
+ * reports through the caller's thread-local error only.
+ */
+static bool step_in_flight(const ax_core* core) {
+    return core->async_in_flight.load(std::memory_order_acquire);
+}
+
+static bool reject_if_stepping(ax_core* core, const char* fn) {
+    if (core && step_in_flight(core)) {
+        set_last_error(nullptr, "%s: async step in flight (call ax_step_wait first)", fn);
+        return true;
+    }
+    return false;
+}
+
+/* Writes a log record if a pipeline exists and wants the level. */
+static void log_event(ax_core* core, uint32_t level, uint32_t code,
+                      uint64_t a0 = 0, uint64_t a1 = 0, uint64_t a2 = 0) {
+    if (core->log && core->log->wants(level)) {
+        core->log->write(level, code, core->tick, a0, a1, a2);
+    }
+}
+
+static void stop_async_thread(ax_core* core) {
+    if (!core->async_thread.joinable()) {
+        return;
+    }
+    {
+        /* an in-flight step finishes before the worker sees async_quit */
+        std::lock_guard<std::mutex> guard(core->async_lock);
+        core->async_quit = true;
+    }
+    core->async_wake.notify_one();
+    core->async_thread.join();
+}
+
+/* owner thread, no step in flight: the caller is the inbox consumer */
+static void discard_inbox(ax_core* core) {
+    if (!core->inbox) {
+        return;
+    }
+    ax_action_v1 a;
+    while (core->inbox->try_pop(&a)) {
+    }
+}
+
 /* ── Last error ───────────────────────────────────────────────────── */
 
 const char* ax_get_last_error(void) {
-    return g_last_error;
+    return t_last_error;
+}
+
+const char* ax_get_core_last_error(const ax_core* core) {
+    if (!core || step_in_flight(core)) {
+        return "";
+    }
+    return core->last_error;
 }
 
 /* ── ABI version ──────────────────────────────────────────────────── */
@@ -111,79 +314,194 @@ ax_abi_version ax_get_abi_version(void) {
 ax_result ax_create(const ax_create_params_v1* params, ax_core** out_core) {
     /* null checks */
     if (!params || !out_core) {
-        set_last_error("ax_create: params and out_core must not be NULL");
+        set_last_error(nullptr, "ax_create: params and out_core must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
 
     /* struct version check */
     if (params->version != 1) {
-        set_last_error("ax_create: unknown params version %u", params->version);
+        set_last_error(nullptr, "ax_create: unknown params version %u", params->version);
         return AX_ERR_UNSUPPORTED;
     }
 
-    /* struct size check (forward compat: allow larger, reject smaller) */
-    if (params->size_bytes < sizeof(ax_create_params_v1)) {
-        set_last_error("ax_create: size_bytes %u < expected %u",
-                       params->size_bytes,
-                       (unsigned)sizeof(ax_create_params_v1));
+    /*
+     * struct size check (forward compat: allow larger, reject smaller).
+     * Shells built before ABI 0.6 pass a struct without `allocator`.
+     */
+    const uint32_t min_size = (uint32_t)offsetof(ax_create_params_v1, allocator);
+    if (params->size_bytes < min_size) {
+        set_last_error(nullptr, "ax_create: size_bytes %u < expected %u",
+                       params->size_bytes, min_size);
         return AX_ERR_INVALID_ARG;
     }
 
     /* ABI major compatibility */
     if (params->abi_major != AX_ABI_MAJOR) {
-        set_last_error("ax_create: ABI major mismatch (shell=%u, core=%u)",
+        set_last_error(nullptr, "ax_create: ABI major mismatch (shell=%u, core=%u)",
                        params->abi_major, AX_ABI_MAJOR);
         return AX_ERR_UNSUPPORTED;
     }
 
+    /* host allocator (optional) */
+    ax_alloc_state alloc = ax_alloc_state::defaults();
+    const ax_allocator_v1* host = nullptr;
+    if (params->size_bytes >= offsetof(ax_create_params_v1, allocator) + sizeof(host)) {
+        host = params->allocator;
+    }
+    if (host) {
+        if (host->version != 1) {
+            set_last_error(nullptr, "ax_create: unknown allocator version %u", host->version);
+            return AX_ERR_UNSUPPORTED;
+        }
+        if (host->size_bytes < sizeof(ax_allocator_v1)) {
+            set_last_error(nullptr, "ax_create: allocator size_bytes %u < expected %u",
+                           host->size_bytes, (unsigned)sizeof(ax_allocator_v1));
+            return AX_ERR_INVALID_ARG;
+        }
+        if (!host->alloc || !host->free) {
+            set_last_error(nullptr, "ax_create: allocator alloc and free must not be NULL");
+            return AX_ERR_INVALID_ARG;
+        }
+        alloc.alloc_fn   = host->alloc;
+        alloc.realloc_fn = host->realloc;
+        alloc.free_fn    = host->free;
+        alloc.user       = host->user;
+    }
+
     /* allocate and initialize */
-    ax_core* core = new (std::nothrow) ax_core();
+    ax_core* core = nullptr;
+    try {
+        core = ax_new<ax_core>(&alloc, alloc);
+    } catch (const std::bad_alloc&) {
+        core = nullptr;     /* a member's allocation failed */
+    }
     if (!core) {
-        set_last_error("ax_create: allocation failed");
-        return AX_ERR_INTERNAL;
+        set_last_error(nullptr, "ax_create: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+
+    /* single-threaded until ax_set_threading */
+    core->parallel_grain = AX_DEFAULT_PARALLEL_GRAIN;
+    try {
+        core->worker_scratch.resize(1);
+    } catch (const std::bad_alloc&) {
+        ax_alloc_state a = core->alloc;
+        ax_delete(&a, core);
+        set_last_error(nullptr, "ax_create: allocation failed (worker scratch)");
+        return AX_ERR_OUT_OF_MEMORY;
     }
 
-    core->lifecycle = AX_LIFECYCLE_CREATED;
     core->log_fn    = params->log_fn;
     core->log_user  = params->log_user;
-    core->tick      = 0;
 
-    /* zero-initialize weapon state */
-    std::memset(&core->weapon, 0, sizeof(core->weapon));
+    if (core->log_fn) {
+        ax_log_params_v1 lp;
+        ax_log::default_params(&lp);
+        try {
+            core->log = ax_new<ax_log>(&core->alloc, &core->alloc, core->log_fn, core->log_user, lp);
+        } catch (const std::bad_alloc&) {
+            core->log = nullptr;
+        }
+        if (!core->log) {
+            ax_alloc_state a = core->alloc;
+            ax_delete(&a, core);
+            set_last_error(nullptr, "ax_create: allocation failed (log ring)");
+            return AX_ERR_OUT_OF_MEMORY;
+        }
+    }
 
     *out_core = core;
-    g_last_error[0] = '\0';    /* clear last error on success */
+    clear_last_error(core);     /* clear last error on success */
     return AX_OK;
 }
 
 void ax_destroy(ax_core* core) {
     if (!core) return;
-    delete core;
+    stop_async_thread(core);
+
+    /* the core's own storage is on its allocator, so free through a copy */
+    ax_alloc_state alloc = core->alloc;
+    ax_delete(&alloc, core->log);       /* delivers pending records */
+    ax_delete(&alloc, core->inbox);
+    ax_delete(&alloc, core);
+}
+
+/* ── Hashing ──────────────────────────────────────────────────────── */
+
+/* FNV-1a, 64-bit */
+static uint64_t fnv1a_bytes(uint64_t h, const void* data, size_t size) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+template <class T>
+static uint64_t fnv1a_value(uint64_t h, const T& v) {
+    return fnv1a_bytes(h, &v, sizeof(v));
 }
 
 /* ── Content loading ──────────────────────────────────────────────── */
 
+/* A1 placeholder content: the player carries weapon 1000 in slot 0 */
+static const uint32_t CONTENT_PLAYER_ID = 1;
+static const uint32_t CONTENT_WEAPON_ID = 1000;    /* matches CONTENT_DATABASE example */
+static const int32_t  MAGAZINE_SIZE     = 12;      /* TODO: use content magazine_size */
+static const int32_t  CONTENT_RESERVE   = 48;      /* 4 extra mags */
+static const uint32_t RELOAD_DURATION   = 30;      /* TODO: use content reload_duration_ticks */
+
+/*
+ * Hash of what the loader produced: the content entities (as authored,
+ * before any tick) and the weapon records. Field by field, so it is
+ * stable across builds, unlike the state hash's event bytes.
+ */
+static uint64_t hash_loaded_content(const ax_core* core) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (const auto& e : core->entities) {
+        h = fnv1a_value(h, e.id);
+        h = fnv1a_value(h, e.archetype_id);
+        h = fnv1a_value(h, e.px);  h = fnv1a_value(h, e.py);  h = fnv1a_value(h, e.pz);
+        h = fnv1a_value(h, e.rx);  h = fnv1a_value(h, e.ry);
+        h = fnv1a_value(h, e.rz);  h = fnv1a_value(h, e.rw);
+        h = fnv1a_value(h, e.hp);
+        h = fnv1a_value(h, e.state_flags);
+    }
+    const ax_weapon_table& w = core->weapons;
+    for (uint32_t row = 0; row < w.size(); ++row) {
+        h = fnv1a_value(h, w.owner(row));
+        h = fnv1a_value(h, w.slot(row));
+        h = fnv1a_value(h, w.ammo_in_mag(row));
+        h = fnv1a_value(h, w.ammo_reserve(row));
+    }
+    return h;
+}
+
 ax_result ax_load_content(ax_core* core, const ax_content_load_params_v1* params) {
+    if (reject_if_stepping(core, "ax_load_content")) {
+        return AX_ERR_BAD_STATE;
+    }
     if (!core || !params) {
-        set_last_error("ax_load_content: core and params must not be NULL");
+        set_last_error(core, "ax_load_content: core and params must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
 
     /* lifecycle check: must be in CREATED state */
     if (core->lifecycle != AX_LIFECYCLE_CREATED) {
-        set_last_error("ax_load_content: content already loaded (unload first)");
+        set_last_error(core, "ax_load_content: content already loaded (unload first)");
         return AX_ERR_BAD_STATE;
     }
 
     /* struct version check */
     if (params->version != 1) {
-        set_last_error("ax_load_content: unknown params version %u", params->version);
+        set_last_error(core, "ax_load_content: unknown params version %u", params->version);
         return AX_ERR_UNSUPPORTED;
     }
 
     /* struct size check */
     if (params->size_bytes < sizeof(ax_content_load_params_v1)) {
-        set_last_error("ax_load_content: size_bytes %u < expected %u",
+        set_last_error(core, "ax_load_content: size_bytes %u < expected %u",
                        params->size_bytes,
                        (unsigned)sizeof(ax_content_load_params_v1));
         return AX_ERR_INVALID_ARG;
@@ -191,7 +509,7 @@ ax_result ax_load_content(ax_core* core, const ax_content_load_params_v1* params
 
     /* root_path check */
     if (!params->root_path || params->root_path[0] == '\0') {
-        set_last_error("ax_load_content: root_path must not be NULL or empty");
+        set_last_error(core, "ax_load_content: root_path must not be NULL or empty");
         return AX_ERR_INVALID_ARG;
     }
 
@@ -207,21 +525,31 @@ ax_result ax_load_content(ax_core* core, const ax_content_load_params_v1* params
      * snapshot pipeline and headless shell have data to work with.
      */
 
+    /* allocate first (ids 1 and 100..102), so that a failure changes nothing */
+    try {
+        core->entities.reserve_rebuild(103, 4);
+        core->weapons.reserve(1, ax_entity_slot(CONTENT_PLAYER_ID) + 1);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_load_content: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+
     /* clear any stale state */
     core->entities.clear();
     core->action_queue.clear();
+    core->queued_mix = {};
     core->events.clear();
     core->tick = 0;
 
     /* placeholder player entity (id=1) */
     ax_entity_internal player = {};
-    player.id          = 1;
+    player.id          = CONTENT_PLAYER_ID;
     player.archetype_id = 0;       /* no content record for player in A1 */
     player.px = 0.0f;  player.py = 0.0f;  player.pz = 0.0f;
     player.rx = 0.0f;  player.ry = 0.0f;  player.rz = 0.0f;  player.rw = 1.0f;
     player.hp          = -1;       /* not applicable for player */
     player.state_flags = AX_ENT_FLAG_PLAYER;
-    core->entities.push_back(player);
+    core->entities.insert(player);
 
     /* placeholder target entities (ids=100,101,102) */
     const uint32_t TARGET_ARCHETYPE = 2000;  /* matches CONTENT_DATABASE example */
@@ -242,37 +570,70 @@ ax_result ax_load_content(ax_core* core, const ax_content_load_params_v1* params
         target.rx = 0.0f;  target.ry = 0.0f;  target.rz = 0.0f;  target.rw = 1.0f;
         target.hp           = TARGET_HP;
         target.state_flags  = AX_ENT_FLAG_TARGET;
-        core->entities.push_back(target);
+        core->entities.insert(target);
     }
 
+    /* content ids are fixed; slots between them are free for spawning */
+    core->entities.rebuild_free_list();
+
     /* placeholder weapon state (matches CONTENT_DATABASE weapon 1000) */
-    core->weapon.player_id              = 1;
-    core->weapon.weapon_slot            = 0;
-    core->weapon.ammo_in_mag            = 12;    /* magazine_size    */
-    core->weapon.ammo_reserve           = 48;    /* 4 extra mags     */
-    core->weapon.reloading              = false;
-    core->weapon.reload_ticks_remaining = 0;
-
-    core->lifecycle = AX_LIFECYCLE_CONTENT_LOADED;
-    g_last_error[0] = '\0';
+    core->weapons.clear();
+    core->weapons.add(CONTENT_PLAYER_ID, 0, CONTENT_WEAPON_ID, MAGAZINE_SIZE, CONTENT_RESERVE);
+    core->timers.reset(0);
+
+    core->content_hash = hash_loaded_content(core);
+    core->lifecycle    = AX_LIFECYCLE_CONTENT_LOADED;
+    log_event(core, AX_LOG_INFO, AX_LOGC_CONTENT_LOADED, core->entities.size());
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_get_content_hash(ax_core* core, uint64_t* out_hash) {
+    if (reject_if_stepping(core, "ax_get_content_hash")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_hash) {
+        set_last_error(core, "ax_get_content_hash: core and out_hash must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_get_content_hash: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+    *out_hash = core->content_hash;
+    if (!core->collision.empty()) {
+        *out_hash = fnv1a_value(*out_hash, core->collision.hash());
+    }
+    clear_last_error(core);
     return AX_OK;
 }
 
 ax_result ax_unload_content(ax_core* core) {
+    if (reject_if_stepping(core, "ax_unload_content")) {
+        return AX_ERR_BAD_STATE;
+    }
     if (!core) {
-        set_last_error("ax_unload_content: core must not be NULL");
+        set_last_error(core, "ax_unload_content: core must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
 
     /* idempotent: unloading when nothing is loaded is fine */
     core->entities.clear();
     core->action_queue.clear();
+    core->queued_mix = {};
+    discard_inbox(core);
     core->events.clear();
     core->tick = 0;
-    std::memset(&core->weapon, 0, sizeof(core->weapon));
-
-    core->lifecycle = AX_LIFECYCLE_CREATED;
-    g_last_error[0] = '\0';
+    core->weapons.clear();
+    core->timers.reset(0);
+    core->collision.clear();
+    core->character_slots.clear();
+    core->character_caches.clear();
+
+    core->content_hash = 0;
+    core->lifecycle    = AX_LIFECYCLE_CREATED;
+    log_event(core, AX_LOG_INFO, AX_LOGC_CONTENT_UNLOADED);
+    clear_last_error(core);
     return AX_OK;
 }
 
@@ -282,29 +643,106 @@ static bool is_finite(float f) {
     return std::isfinite(f);
 }
 
-/* ── Action submission ────────────────────────────────────────────── */
+/* ── Memory accounting ────────────────────────────────────────────── */
 
-ax_result ax_submit_actions(ax_core* core, const ax_action_batch_v1* batch) {
-    if (!core || !batch) {
-        set_last_error("ax_submit_actions: core and batch must not be NULL");
-        return AX_ERR_INVALID_ARG;
+template <class V>
+static void vector_usage(const V& v, ax_memory_usage_v1* u) {
+    u->reserved_bytes += v.capacity() * sizeof(typename V::value_type);
+    u->used_bytes     += v.size() * sizeof(typename V::value_type);
+}
+
+/*
+ * Reserved/used bytes per subsystem, and folds `used` into the
+ * high-water marks. Reserved must account for every allocation made
+ * through core->alloc (test_memory_stats checks the sum).
+ */
+static void sample_memory(ax_core* core, ax_memory_usage_v1 usage[AX_MEM_SUBSYSTEM_COUNT]) {
+    std::memset(usage, 0, sizeof(ax_memory_usage_v1) * AX_MEM_SUBSYSTEM_COUNT);
+
+    usage[AX_MEM_CORE].reserved_bytes = sizeof(ax_core);
+    usage[AX_MEM_CORE].used_bytes     = sizeof(ax_core);
+
+    usage[AX_MEM_ENTITIES].reserved_bytes = core->entities.reserved_bytes();
+    usage[AX_MEM_ENTITIES].used_bytes     = core->entities.used_bytes();
+    usage[AX_MEM_ENTITIES].reserved_bytes += core->weapons.reserved_bytes();
+    usage[AX_MEM_ENTITIES].used_bytes     += core->weapons.used_bytes();
+    vector_usage(core->action_queue, &usage[AX_MEM_ACTION_QUEUE]);
+
+    if (core->inbox) {
+        ax_memory_usage_v1& u = usage[AX_MEM_INBOX];
+        u.reserved_bytes = sizeof(*core->inbox) + core->inbox->slot_bytes();
+        u.used_bytes     = sizeof(*core->inbox)
+                         + (uint64_t)core->inbox->size_approx() * sizeof(ax_action_v1);
     }
 
-    /* lifecycle check: must have content loaded */
-    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
-        set_last_error("ax_submit_actions: content not loaded");
-        return AX_ERR_BAD_STATE;
+    usage[AX_MEM_FRAME].reserved_bytes = core->frame.reserved_bytes();
+    usage[AX_MEM_FRAME].used_bytes     = core->frame.used_bytes();
+
+    usage[AX_MEM_TIMERS].reserved_bytes = core->timers.reserved_bytes();
+    usage[AX_MEM_TIMERS].used_bytes     = core->timers.used_bytes();
+    vector_usage(core->fired_timers, &usage[AX_MEM_TIMERS]);
+
+    vector_usage(core->timer_records, &usage[AX_MEM_SAVE_SCRATCH]);
+    vector_usage(core->slot_marks, &usage[AX_MEM_SAVE_SCRATCH]);
+    vector_usage(core->weapon_marks, &usage[AX_MEM_SAVE_SCRATCH]);
+
+    usage[AX_MEM_JOBS].reserved_bytes = core->jobs.reserved_bytes();
+    usage[AX_MEM_JOBS].used_bytes     = core->jobs.used_bytes();
+    vector_usage(core->worker_scratch, &usage[AX_MEM_JOBS]);
+
+    usage[AX_MEM_PROFILER].reserved_bytes = core->profiler.reserved_bytes();
+    usage[AX_MEM_PROFILER].used_bytes     = core->profiler.used_bytes();
+
+    if (core->log) {
+        usage[AX_MEM_LOG].reserved_bytes = core->log->reserved_bytes();
+        usage[AX_MEM_LOG].used_bytes     = core->log->used_bytes();
+    }
+
+    usage[AX_MEM_COLLISION].reserved_bytes = core->collision.reserved_bytes();
+    usage[AX_MEM_COLLISION].used_bytes     = core->collision.used_bytes();
+    usage[AX_MEM_COLLISION].reserved_bytes +=
+        core->character_slots.capacity() * sizeof(uint32_t) +
+        core->character_caches.capacity() * sizeof(ax_character_cache);
+    usage[AX_MEM_COLLISION].used_bytes +=
+        core->character_slots.size() * sizeof(uint32_t) +
+        core->character_caches.size() * sizeof(ax_character_cache);
+
+    for (uint32_t i = 0; i < AX_MEM_SUBSYSTEM_COUNT; ++i) {
+        if (usage[i].used_bytes > core->mem_high_water[i]) {
+            core->mem_high_water[i] = usage[i].used_bytes;
+        }
+        usage[i].high_water_bytes = core->mem_high_water[i];
+    }
+
+    /* the arena tracks its own per-tick peak across resets */
+    uint64_t frame_peak = core->frame.high_water_bytes();
+    if (frame_peak > core->mem_high_water[AX_MEM_FRAME]) {
+        core->mem_high_water[AX_MEM_FRAME]   = frame_peak;
+        usage[AX_MEM_FRAME].high_water_bytes = frame_peak;
     }
+}
+
+/* ── Action submission ────────────────────────────────────────────── */
+
+/*
+ * Structural (submission-time) validation shared by ax_submit_actions
+ * and the inbox. err_core is NULL on the input thread so errors reach
+ * only that thread's ax_get_last_error. *out_mix gets the batch's kinds
+ * (empty unless AX_OK).
+ */
+static ax_result validate_action_batch(ax_core* err_core, const char* fn,
+                                       const ax_action_batch_v1* batch, ax_queue_mix* out_mix) {
+    *out_mix = {};
 
     /* struct version check */
     if (batch->version != 1) {
-        set_last_error("ax_submit_actions: unknown batch version %u", batch->version);
+        set_last_error(err_core, "%s: unknown batch version %u", fn, batch->version);
         return AX_ERR_UNSUPPORTED;
     }
 
     /* struct size check */
     if (batch->size_bytes < sizeof(ax_action_batch_v1)) {
-        set_last_error("ax_submit_actions: size_bytes %u < expected %u",
+        set_last_error(err_core, "%s: size_bytes %u < expected %u", fn,
                        batch->size_bytes,
                        (unsigned)sizeof(ax_action_batch_v1));
         return AX_ERR_INVALID_ARG;
@@ -317,782 +755,3071 @@ ax_result ax_submit_actions(ax_core* core, const ax_action_batch_v1* batch) {
 
     /* actions pointer check */
     if (!batch->actions) {
-        set_last_error("ax_submit_actions: count=%u but actions is NULL",
-                       batch->count);
+        set_last_error(err_core, "%s: count=%u but actions is NULL", fn, batch->count);
         return AX_ERR_INVALID_ARG;
     }
 
     /* per-action structural validation */
+    ax_queue_mix mix;
     for (uint32_t i = 0; i < batch->count; ++i) {
         const ax_action_v1* a = &batch->actions[i];
+        mix.add(a->type);
 
         /* type must be known */
         if (a->type < AX_ACT_MOVE_INTENT || a->type > AX_ACT_CROUCH_TOGGLE) {
-            set_last_error("ax_submit_actions: action[%u] unknown type %u", i, a->type);
+            set_last_error(err_core, "%s: action[%u] unknown type %u", fn, i, a->type);
             return AX_ERR_INVALID_ARG;
         }
 
         /* float fields must be finite */
         if (a->type == AX_ACT_MOVE_INTENT) {
             if (!is_finite(a->u.move.x) || !is_finite(a->u.move.y)) {
-                set_last_error("ax_submit_actions: action[%u] MOVE has non-finite values", i);
+                set_last_error(err_core, "%s: action[%u] MOVE has non-finite values", fn, i);
                 return AX_ERR_INVALID_ARG;
             }
         }
         if (a->type == AX_ACT_LOOK_INTENT) {
             if (!is_finite(a->u.look.yaw) || !is_finite(a->u.look.pitch)) {
-                set_last_error("ax_submit_actions: action[%u] LOOK has non-finite values", i);
+                set_last_error(err_core, "%s: action[%u] LOOK has non-finite values", fn, i);
                 return AX_ERR_INVALID_ARG;
             }
         }
-
-        /* queue the action */
-        core->action_queue.push_back(*a);
     }
 
+    *out_mix = mix;
     return AX_OK;
 }
 
-/* ── Simulation stepping ──────────────────────────────────────────── */
-
-ax_result ax_step_ticks(ax_core* core, uint32_t n_ticks) {
-    if (!core) {
-        set_last_error("ax_step_ticks: core must not be NULL");
+ax_result ax_submit_actions(ax_core* core, const ax_action_batch_v1* batch) {
+    if (reject_if_stepping(core, "ax_submit_actions")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !batch) {
+        set_last_error(core, "ax_submit_actions: core and batch must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
+    AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_SUBMIT_ACTIONS);
 
     /* lifecycle check: must have content loaded */
     if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
-        set_last_error("ax_step_ticks: content not loaded");
+        set_last_error(core, "ax_submit_actions: content not loaded");
         return AX_ERR_BAD_STATE;
     }
 
-    /* stepping 0 ticks is a no-op */
-    if (n_ticks == 0) {
-        return AX_OK;
+    ax_queue_mix mix;
+    ax_result r = validate_action_batch(core, "ax_submit_actions", batch, &mix);
+    if (r != AX_OK) {
+        return r;
     }
 
-    for (uint32_t step = 0; step < n_ticks; ++step) {
-        core->tick++;
-        core->events.clear();
-
-        /*
-         * Process actions for this tick, in submission order.
-         * COMBAT_A1 tick ordering:
-         *   1) process actions in batch order
-         *   2) advance timers (reload countdown)
-         */
-        for (size_t i = 0; i < core->action_queue.size(); ) {
-            const ax_action_v1& a = core->action_queue[i];
-
-            if (a.tick != core->tick) {
-                ++i;
-                continue;
-            }
-
-            /* ── MOVE_INTENT ── */
-            if (a.type == AX_ACT_MOVE_INTENT) {
-                for (auto& e : core->entities) {
-                    if (e.id == a.actor_id && (e.state_flags & AX_ENT_FLAG_PLAYER)) {
-                        /*
-                         * TODO: Full A1 movement (COMBAT_A1 Movement Rules)
-                         *   - normalize/clamp magnitude to 1.0
-                         *   - rotate input by player yaw
-                         *   - multiply by walk_speed_m_per_tick
-                         *   - clamp y=0 (flat ground plane)
-                         *
-                         * Stub: apply input directly to XZ at fixed speed.
-                         */
-                        const float WALK_SPEED = 0.1f;  /* placeholder m/tick */
-                        float mx = a.u.move.x;
-                        float my = a.u.move.y;
-
-                        /* clamp magnitude to 1.0 */
-                        float mag = std::sqrt(mx * mx + my * my);
-                        if (mag > 1.0f) {
-                            mx /= mag;
-                            my /= mag;
-                        }
-
-                        e.px += mx * WALK_SPEED;
-                        e.pz += my * WALK_SPEED;
-                        e.py = 0.0f;  /* clamp to ground (COMBAT_A1) */
-                        break;
-                    }
-                }
-            }
-
-            /* ── LOOK_INTENT ── */
-            else if (a.type == AX_ACT_LOOK_INTENT) {
-                /*
-                 * TODO: Full A1 look (COMBAT_A1 Controls)
-                 *   - apply delta yaw/pitch to truth orientation
-                 *   - update quaternion properly
-                 *   - clamp pitch to prevent gimbal lock
-                 *
-                 * Stub: store yaw in quaternion Y component (placeholder).
-                 * This is NOT a correct quaternion — just enough for
-                 * the snapshot to show a non-zero rotation.
-                 */
-                for (auto& e : core->entities) {
-                    if (e.id == a.actor_id && (e.state_flags & AX_ENT_FLAG_PLAYER)) {
-                        e.ry += a.u.look.yaw;
-                        break;
-                    }
-                }
-            }
-
-            /* ── FIRE_ONCE ── */
-            else if (a.type == AX_ACT_FIRE_ONCE) {
-                /* check blocked conditions (COMBAT_A1 Fire Rules) */
-                if (core->weapon.reloading) {
-                    ax_snapshot_event_v1 evt = {};
-                    evt.type  = AX_EVT_FIRE_BLOCKED;
-                    evt.a     = a.actor_id;
-                    evt.b     = a.u.fire_once.weapon_slot;
-                    evt.value = AX_FIRE_BLOCKED_RELOADING;
-                    core->events.push_back(evt);
-                }
-                else if (core->weapon.ammo_in_mag <= 0) {
-                    ax_snapshot_event_v1 evt = {};
-                    evt.type  = AX_EVT_FIRE_BLOCKED;
-                    evt.a     = a.actor_id;
-                    evt.b     = a.u.fire_once.weapon_slot;
-                    evt.value = AX_FIRE_BLOCKED_EMPTY_MAG;
-                    core->events.push_back(evt);
-                }
-                else {
-                    core->weapon.ammo_in_mag--;
-
-                    /*
-                     * TODO: Full A1 hitscan (COMBAT_A1 Hitscan Rules)
-                     *   - compute ray from player truth pose + eye offset
-                     *   - ray-sphere intersection against each living target
-                     *   - select closest hit within max_range_m
-                     *
-                     * Stub: hit the first living target (if any).
-                     */
-                    const int32_t DAMAGE = 10;  /* placeholder damage_per_hit */
-
-                    for (auto& e : core->entities) {
-                        if ((e.state_flags & AX_ENT_FLAG_TARGET) &&
-                            !(e.state_flags & AX_ENT_FLAG_DEAD)) {
-
-                            e.hp -= DAMAGE;
-
-                            ax_snapshot_event_v1 dmg = {};
-                            dmg.type  = AX_EVT_DAMAGE_DEALT;
-                            dmg.a     = a.actor_id;
-                            dmg.b     = e.id;
-                            dmg.value = DAMAGE;
-                            core->events.push_back(dmg);
-
-                            if (e.hp <= 0) {
-                                e.state_flags |= AX_ENT_FLAG_DEAD;
-
-                                ax_snapshot_event_v1 dest = {};
-                                dest.type  = AX_EVT_TARGET_DESTROY;
-                                dest.a     = a.actor_id;
-                                dest.b     = e.id;
-                                dest.value = 0;
-                                core->events.push_back(dest);
-                            }
-                            break;  /* one hit per shot */
-                        }
-                    }
-                }
-            }
-
-            /* ── RELOAD ── */
-            else if (a.type == AX_ACT_RELOAD) {
-                /* COMBAT_A1 Reload Rules */
-                if (!core->weapon.reloading &&
-                    core->weapon.ammo_in_mag < 12 &&  /* TODO: use content magazine_size */
-                    core->weapon.ammo_reserve > 0) {
-
-                    core->weapon.reloading              = true;
-                    core->weapon.reload_ticks_remaining  = 30;  /* TODO: use content reload_duration_ticks */
-
-                    ax_snapshot_event_v1 evt = {};
-                    evt.type  = AX_EVT_RELOAD_STARTED;
-                    evt.a     = a.actor_id;
-                    evt.b     = a.u.reload.weapon_slot;
-                    evt.value = 0;
-                    core->events.push_back(evt);
-                }
-            }
-
-            /* ── SPRINT / CROUCH (optional, no-op for now) ── */
-            /* else if (a.type == AX_ACT_SPRINT_HELD) { } */
-            /* else if (a.type == AX_ACT_CROUCH_TOGGLE) { } */
+    /* queue the batch (validated whole, so it is queued whole or not at all) */
+    try {
+        core->action_queue.insert(core->action_queue.end(),
+                                  batch->actions, batch->actions + batch->count);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_submit_actions: allocation failed (%u actions)", batch->count);
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    core->queued_mix.moves   += mix.moves;
+    core->queued_mix.reloads += mix.reloads;
+    core->stats.data().actions_submitted += batch->count;
 
-            /* remove processed action from queue */
-            core->action_queue.erase(core->action_queue.begin() + i);
-            /* don't increment i — next element shifted into this slot */
-        }
+    ax_memory_usage_v1 usage[AX_MEM_SUBSYSTEM_COUNT];
+    sample_memory(core, usage);     /* the queue peaks between steps */
+    return AX_OK;
+}
 
-        /*
-         * Advance timers (COMBAT_A1 tick ordering step 2).
-         * This runs AFTER all actions are processed.
-         * Implication: RELOAD then FIRE_ONCE in same tick →
-         *   FIRE sees reloading==true and is blocked.
-         */
-        if (core->weapon.reloading) {
-            if (core->weapon.reload_ticks_remaining > 0) {
-                core->weapon.reload_ticks_remaining--;
-            }
-            if (core->weapon.reload_ticks_remaining == 0) {
-                /* COMBAT_A1 reload completion */
-                int32_t magazine_size = 12;  /* TODO: use content value */
-                int32_t needed  = magazine_size - core->weapon.ammo_in_mag;
-                int32_t to_load = needed < core->weapon.ammo_reserve
-                                    ? needed : core->weapon.ammo_reserve;
+/* ── Action inbox ─────────────────────────────────────────────────── */
 
-                core->weapon.ammo_in_mag  += to_load;
-                core->weapon.ammo_reserve -= to_load;
-                core->weapon.reloading     = false;
+#define AX_INBOX_DEFAULT_CAPACITY 4096u
+#define AX_INBOX_MAX_CAPACITY     (1u << 20)
 
-                ax_snapshot_event_v1 evt = {};
-                evt.type  = AX_EVT_RELOAD_DONE;
-                evt.a     = core->weapon.player_id;
-                evt.b     = core->weapon.weapon_slot;
-                evt.value = to_load;
-                core->events.push_back(evt);
-            }
-        }
+ax_result ax_enable_action_inbox(ax_core* core, const ax_inbox_params_v1* params) {
+    if (reject_if_stepping(core, "ax_enable_action_inbox")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !params) {
+        set_last_error(core, "ax_enable_action_inbox: core and params must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (params->version != 1) {
+        set_last_error(core, "ax_enable_action_inbox: unknown params version %u", params->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (params->size_bytes < sizeof(ax_inbox_params_v1)) {
+        set_last_error(core, "ax_enable_action_inbox: size_bytes %u < expected %u",
+                       params->size_bytes, (unsigned)sizeof(ax_inbox_params_v1));
+        return AX_ERR_INVALID_ARG;
     }
 
-    /* transition to RUNNING after first tick */
-    if (core->lifecycle == AX_LIFECYCLE_CONTENT_LOADED) {
-        core->lifecycle = AX_LIFECYCLE_RUNNING;
+    uint32_t capacity = params->capacity ? params->capacity : AX_INBOX_DEFAULT_CAPACITY;
+    if (capacity > AX_INBOX_MAX_CAPACITY) {
+        set_last_error(core, "ax_enable_action_inbox: capacity %u > max %u",
+                       capacity, AX_INBOX_MAX_CAPACITY);
+        return AX_ERR_INVALID_ARG;
     }
 
-    g_last_error[0] = '\0';
+    /* replaces (and drops) any previous inbox */
+    ax_spsc_ring<ax_action_v1>* inbox = nullptr;
+    try {
+        inbox = ax_new<ax_spsc_ring<ax_action_v1>>(&core->alloc, &core->alloc, capacity);
+    } catch (const std::bad_alloc&) {
+        inbox = nullptr;
+    }
+    if (!inbox) {
+        set_last_error(core, "ax_enable_action_inbox: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    ax_delete(&core->alloc, core->inbox);
+    core->inbox = inbox;
+    clear_last_error(core);
     return AX_OK;
 }
 
-/* ── Snapshots ────────────────────────────────────────────────────── */
-
-ax_result ax_get_snapshot_bytes(
-    ax_core*  core,
-    void*     out_buf,
-    uint32_t  out_cap_bytes,
-    uint32_t* out_size_bytes)
-{
-    if (!core) {
-        set_last_error("ax_get_snapshot_bytes: core must not be NULL");
+/*
+ * Producer (input) thread. Reads only core->inbox, which the owner set
+ * before starting the producer, and never writes core->last_error.
+ */
+ax_result ax_inbox_submit_actions(ax_core* core, const ax_action_batch_v1* batch) {
+    if (!core || !batch) {
+        set_last_error(nullptr, "ax_inbox_submit_actions: core and batch must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
-    if (!out_size_bytes) {
-        set_last_error("ax_get_snapshot_bytes: out_size_bytes must not be NULL");
-        return AX_ERR_INVALID_ARG;
+    if (!core->inbox) {
+        set_last_error(nullptr, "ax_inbox_submit_actions: inbox not enabled");
+        return AX_ERR_BAD_STATE;
     }
 
-    /* lifecycle check: must have content loaded */
-    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
-        set_last_error("ax_get_snapshot_bytes: content not loaded");
-        return AX_ERR_BAD_STATE;
+    ax_queue_mix mix;     /* counted again as the step drains them */
+    ax_result r = validate_action_batch(nullptr, "ax_inbox_submit_actions", batch, &mix);
+    if (r != AX_OK) {
+        return r;
+    }
+    if (batch->count == 0) {
+        return AX_OK;
     }
 
-    /* determine if player weapon state is present */
-    uint32_t has_weapon = 0;
-    for (const auto& e : core->entities) {
-        if (e.state_flags & AX_ENT_FLAG_PLAYER) {
-            has_weapon = 1;
+    if (!core->inbox->try_push(batch->actions, batch->count)) {
+        set_last_error(nullptr, "ax_inbox_submit_actions: inbox full (%u actions, capacity %u)",
+                       batch->count, core->inbox->capacity());
+        return AX_ERR_QUEUE_FULL;
+    }
+
+    t_last_error[0] = '\0';
+    return AX_OK;
+}
+
+/*
+ * Before tick `tick`: move inbox actions to the queue, stamping tick 0
+ * as `tick`. The queue grows before each pop, so a bad_alloc leaves
+ * every action either still in the inbox or queued.
+ */
+static void drain_inbox(ax_core* core, uint64_t tick) {
+    if (!core->inbox) {
+        return;
+    }
+    ax_action_v1 a;
+    for (;;) {
+        ax_reserve_more(core->action_queue, 1);
+        if (!core->inbox->try_pop(&a)) {
             break;
         }
+        if (a.tick == 0) {
+            a.tick = tick;
+        }
+        core->action_queue.push_back(a);
+        core->queued_mix.add(a.type);
+        core->stats.data().actions_submitted++;
     }
+}
 
-    /* compute total blob size */
-    uint32_t entity_count = (uint32_t)core->entities.size();
-    uint32_t event_count  = (uint32_t)core->events.size();
-
-    uint32_t total = (uint32_t)sizeof(ax_snapshot_header_v1)
-                   + entity_count * (uint32_t)sizeof(ax_snapshot_entity_v1)
-                   + has_weapon   * (uint32_t)sizeof(ax_snapshot_player_weapon_v1)
-                   + event_count  * (uint32_t)sizeof(ax_snapshot_event_v1);
+/* ── Simulation stepping ──────────────────────────────────────────── */
 
-    /* always write required size (buffer-too-small rule) */
-    *out_size_bytes = total;
+/*
+ * Tick phases (COMBAT_A1 tick ordering, split so the job system can run
+ * independent per-entity work in parallel):
+ *
+ *   0) gather   — pull this tick's actions out of the queue, submission order
+ *   1) movement — MOVE/LOOK per actor, in submission order   [parallel: actors]
+ *   2) combat   — FIRE/RELOAD in submission order; hit resolution scans
+ *                 targets                                    [parallel: reduction]
+ *   3) timers   — timer-wheel expiries (reload completion), schedule order
+ *
+ * All of a tick's moves apply before any of its shots, whatever their
+ * submission order: a shot's line of sight against a collision mesh
+ * sees the poses after every move of its tick. Parallel phases write
+ * only their own items or per-worker scratch, so results are
+ * bit-identical for any worker count.
+ *
+ * Before phase 0 the inbox is drained and everything the tick can
+ * allocate is reserved (reserve_tick); the phases themselves never
+ * allocate, so out of memory stops a step between ticks.
+ */
 
-    /* size-query path: out_buf is NULL */
-    if (!out_buf) {
-        return AX_OK;
+/* Phase 0: move this tick's actions into tick_actions (O(queue), no shifting). */
+static void gather_tick_actions(ax_core* core) {
+    core->tick_actions.clear();
+
+    size_t keep = 0;
+    ax_queue_mix kept;
+    for (size_t i = 0; i < core->action_queue.size(); ++i) {
+        const ax_action_v1& a = core->action_queue[i];
+        if (a.tick == core->tick) {
+            core->tick_actions.push_back(a);
+        } else if (a.tick > core->tick) {
+            core->action_queue[keep++] = a;
+            kept.add(a.type);
+        } else {
+            /* a.tick < tick: stale, can never apply — dropped */
+            core->stats.data().actions_stale++;
+        }
     }
+    core->action_queue.resize(keep);
+    core->queued_mix = kept;
+    core->stats.data().actions_applied += core->tick_actions.size();
+}
 
-    /* buffer too small */
-    if (out_cap_bytes < total) {
-        set_last_error("ax_get_snapshot_bytes: buffer too small (%u < %u)",
-                       out_cap_bytes, total);
-        return AX_ERR_BUFFER_TOO_SMALL;
+/* A living actor that intents drive: the player or a target. */
+static ax_entity_internal* find_actor(ax_core* core, uint32_t id) {
+    ax_entity_internal* e = core->entities.find(id);
+    if (e && !(e->state_flags & AX_ENT_FLAG_DEAD) &&
+        (e->state_flags & (AX_ENT_FLAG_PLAYER | AX_ENT_FLAG_TARGET))) {
+        return e;
     }
+    return nullptr;
+}
 
-    /* ── Build the blob ───────────────────────────────────────────── */
+/* A MOVE_INTENT's displacement this tick. */
+static void move_displacement(const ax_action_v1& a, float* dx, float* dz) {
+    /*
+     * TODO: Full A1 movement (COMBAT_A1 Movement Rules)
+     *   - rotate input by player yaw
+     *   - multiply by walk_speed_m_per_tick
+     *
+     * Stub: apply input directly to XZ at fixed speed.
+     */
+    const float WALK_SPEED = 0.1f;  /* placeholder m/tick */
+    float mx = a.u.move.x;
+    float my = a.u.move.y;
+
+    /* clamp magnitude to 1.0 */
+    float mag = std::sqrt(mx * mx + my * my);
+    if (mag > 1.0f) {
+        mx /= mag;
+        my /= mag;
+    }
+    *dx = mx * WALK_SPEED;
+    *dz = my * WALK_SPEED;
+}
 
-    uint8_t* dst = (uint8_t*)out_buf;
-    uint32_t offset = 0;
+/* Without a collision mesh: straight onto the flat ground plane. */
+static void apply_move_intent(ax_entity_internal& e, const ax_action_v1& a) {
+    float dx, dz;
+    move_displacement(a, &dx, &dz);
+    e.px += dx;
+    e.pz += dz;
+    e.py = 0.0f;  /* clamp to ground (COMBAT_A1) */
+}
 
-    /* header */
-    ax_snapshot_header_v1 hdr = {};
-    hdr.version              = 1;
-    hdr.reserved             = 0;
-    hdr.size_bytes           = total;
-    hdr.tick                 = core->tick;
-    hdr.entity_count         = entity_count;
-    hdr.entity_stride_bytes  = (uint32_t)sizeof(ax_snapshot_entity_v1);
-    hdr.event_count          = event_count;
-    hdr.event_stride_bytes   = (uint32_t)sizeof(ax_snapshot_event_v1);
-    hdr.flags                = 0;
-    hdr.player_weapon_present = has_weapon;
+static void apply_look_intent(ax_entity_internal& e, const ax_action_v1& a) {
+    /*
+     * TODO: Full A1 look (COMBAT_A1 Controls)
+     *   - apply delta yaw/pitch to truth orientation
+     *   - update quaternion properly
+     *   - clamp pitch to prevent gimbal lock
+     *
+     * Stub: store yaw in quaternion Y component (placeholder).
+     * This is NOT a correct quaternion — just enough for
+     * the snapshot to show a non-zero rotation.
+     */
+    e.ry += a.u.look.yaw;
+}
 
-    std::memcpy(dst + offset, &hdr, sizeof(hdr));
-    offset += (uint32_t)sizeof(hdr);
+/*
+ * Phase 1: movement integration, one range item per acting actor. With
+ * a collision mesh, an actor's MOVE_INTENTs are summed and resolved by
+ * one character controller move (physics/ax_character.h).
+ */
+static void phase_movement(ax_core* core) {
+    core->move_refs.clear();
+    for (uint32_t i = 0; i < (uint32_t)core->tick_actions.size(); ++i) {
+        uint32_t type = core->tick_actions[i].type;
+        if (type == AX_ACT_MOVE_INTENT || type == AX_ACT_LOOK_INTENT) {
+            core->move_refs.push_back({ core->tick_actions[i].actor_id, i });
+        }
+    }
+    if (core->move_refs.empty()) {
+        return;
+    }
 
-    /* entities */
-    for (uint32_t i = 0; i < entity_count; ++i) {
-        const ax_entity_internal& src = core->entities[i];
+    /* group by actor; keys are unique so the order is fully determined */
+    std::sort(core->move_refs.begin(), core->move_refs.end(),
+              [](const ax_action_ref& x, const ax_action_ref& y) {
+                  return x.actor_id != y.actor_id ? x.actor_id < y.actor_id
+                                                  : x.action_index < y.action_index;
+              });
+
+    core->move_runs.clear();
+    for (uint32_t i = 0; i < (uint32_t)core->move_refs.size(); ++i) {
+        if (i == 0 || core->move_refs[i].actor_id != core->move_refs[i - 1].actor_id) {
+            core->move_runs.push_back(i);
+        }
+    }
+    uint32_t n_actors = (uint32_t)core->move_runs.size();
+    core->move_runs.push_back((uint32_t)core->move_refs.size());
+
+    /* controller caches for first-time movers, here on the owning thread */
+    const bool walls = !core->collision.empty();
+    if (walls) {
+        for (uint32_t r = 0; r < n_actors; ++r) {
+            const ax_entity_internal* e = find_actor(core, core->move_refs[core->move_runs[r]].actor_id);
+            if (!e) continue;
+            uint32_t slot = ax_entity_slot(e->id);
+            if (slot >= core->character_slots.size()) {
+                core->character_slots.resize(slot + 1, UINT32_MAX);
+            }
+            if (core->character_slots[slot] == UINT32_MAX) {
+                core->character_slots[slot] = (uint32_t)core->character_caches.size();
+                core->character_caches.push_back(ax_character_cache{});
+            }
+        }
+    }
 
-        ax_snapshot_entity_v1 ent = {};
-        ent.id           = src.id;
-        ent.archetype_id = src.archetype_id;
-        ent.px = src.px;  ent.py = src.py;  ent.pz = src.pz;
-        ent.rx = src.rx;  ent.ry = src.ry;  ent.rz = src.rz;  ent.rw = src.rw;
-        ent.hp           = src.hp;
-        ent.state_flags  = src.state_flags;
+    auto body = [core, walls](uint32_t begin, uint32_t end, uint32_t worker) {
+        AX_TRACE_JOB(&core->profiler, worker, AX_TRACE_JOB_MOVEMENT, end - begin);
+        (void)worker;
+        for (uint32_t r = begin; r < end; ++r) {
+            uint32_t first = core->move_runs[r];
+            uint32_t last  = core->move_runs[r + 1];
+
+            /* tick-time validation: unknown, dead or non-actor entity is a no-op */
+            ax_entity_internal* e = find_actor(core, core->move_refs[first].actor_id);
+            if (!e) continue;
+
+            float dx = 0.0f, dz = 0.0f;
+            bool  moved = false;
+            for (uint32_t k = first; k < last; ++k) {
+                const ax_action_v1& a = core->tick_actions[core->move_refs[k].action_index];
+                if (a.type == AX_ACT_LOOK_INTENT) {
+                    apply_look_intent(*e, a);
+                } else if (walls) {
+                    float mx, mz;
+                    move_displacement(a, &mx, &mz);
+                    dx += mx;
+                    dz += mz;
+                    moved = true;
+                } else {
+                    apply_move_intent(*e, a);
+                }
+            }
+            if (moved) {
+                ax_character_cache* cache =
+                    &core->character_caches[core->character_slots[ax_entity_slot(e->id)]];
+                ax_character_result m = ax_character_move(core->collision, cache, e->id,
+                                                          e->px, e->py, e->pz, dx, dz);
+                e->px = m.px;
+                e->py = m.py;
+                e->pz = m.pz;
+            }
+        }
+    };
+    core->jobs.parallel_for(n_actors, core->parallel_grain, body);
+}
 
-        std::memcpy(dst + offset, &ent, sizeof(ent));
-        offset += (uint32_t)sizeof(ent);
+/*
+ * Hit resolution: index of the first living target in entity order, or
+ * UINT32_MAX. Parallel min-index reduction over entity ranges; runs on
+ * a tick's first shot only (see shot_target).
+ *
+ * TODO: Full A1 hitscan (COMBAT_A1 Hitscan Rules)
+ *   - compute ray from player truth pose + eye offset
+ *   - ray-sphere intersection against each living target
+ *   - select closest hit within max_range_m
+ */
+static uint32_t resolve_hit_target(ax_core* core) {
+    AX_PROFILE_PHASE(&core->profiler, AX_PROFILE_PHASE_HIT_RESOLUTION);
+    const uint32_t NONE = UINT32_MAX;
+
+    uint32_t n_workers = core->jobs.worker_count();
+    for (uint32_t w = 0; w < n_workers; ++w) {
+        core->worker_scratch[w].hit_index = NONE;
     }
 
-    /* player weapon state (if present) */
-    if (has_weapon) {
-        ax_snapshot_player_weapon_v1 wpn = {};
-        wpn.player_id    = core->weapon.player_id;
-        wpn.weapon_slot  = core->weapon.weapon_slot;
-        wpn.ammo_in_mag  = core->weapon.ammo_in_mag;
-        wpn.ammo_reserve = core->weapon.ammo_reserve;
-
-        wpn.weapon_flags = 0;
-        if (core->weapon.reloading) {
-            wpn.weapon_flags |= AX_WPN_FLAG_RELOADING;
-        }
-
-        /*
-         * reload_progress: 0.0 .. 1.0 for presentation.
-         * Internally tracked as integer ticks remaining (D111).
-         * Convert for the snapshot.
-         */
-        if (core->weapon.reloading && core->weapon.reload_ticks_remaining > 0) {
-            uint32_t total_ticks = 30;  /* TODO: use content reload_duration_ticks */
-            wpn.reload_progress = 1.0f - ((float)core->weapon.reload_ticks_remaining
-                                          / (float)total_ticks);
-        } else {
-            wpn.reload_progress = 0.0f;
+    auto body = [core](uint32_t begin, uint32_t end, uint32_t worker) {
+        AX_TRACE_JOB(&core->profiler, worker, AX_TRACE_JOB_HIT_SCAN, end - begin);
+        for (uint32_t i = begin; i < end; ++i) {
+            const ax_entity_internal& e = core->entities[i];
+            if ((e.state_flags & AX_ENT_FLAG_TARGET) &&
+                !(e.state_flags & AX_ENT_FLAG_DEAD)) {
+                if (i < core->worker_scratch[worker].hit_index) {
+                    core->worker_scratch[worker].hit_index = i;
+                }
+                break;  /* ranges are ascending: first hit in range wins */
+            }
         }
+    };
+    core->jobs.parallel_for((uint32_t)core->entities.size(), core->parallel_grain, body);
 
-        std::memcpy(dst + offset, &wpn, sizeof(wpn));
-        offset += (uint32_t)sizeof(wpn);
+    uint32_t best = NONE;
+    for (uint32_t w = 0; w < n_workers; ++w) {
+        if (core->worker_scratch[w].hit_index < best) {
+            best = core->worker_scratch[w].hit_index;
+        }
     }
+    return best;
+}
 
-    /* events */
-    for (uint32_t i = 0; i < event_count; ++i) {
-        std::memcpy(dst + offset, &core->events[i], sizeof(ax_snapshot_event_v1));
-        offset += (uint32_t)sizeof(ax_snapshot_event_v1);
+/*
+ * Line of sight of a shot: blocked if the collision mesh crosses the
+ * segment from the shooter's eye to the target. The heights stand in
+ * for content until COMBAT_A1's eye offset and hit spheres land.
+ */
+static bool shot_blocked(ax_core* core, uint32_t shooter_id, const ax_entity_internal& target) {
+    if (core->collision.empty()) {
+        return false;
     }
+    const ax_entity_internal* shooter = find_actor(core, shooter_id);
+    if (!shooter) {
+        return false;
+    }
+    const float EYE_HEIGHT    = 1.6f;  /* placeholder eye offset         */
+    const float TARGET_CENTRE = 1.0f;  /* placeholder hit sphere centre  */
+    ax_bvh_ray ray;
+    ray.ox = shooter->px;
+    ray.oy = shooter->py + EYE_HEIGHT;
+    ray.oz = shooter->pz;
+    ray.dx = target.px - ray.ox;
+    ray.dy = target.py + TARGET_CENTRE - ray.oy;
+    ray.dz = target.pz - ray.oz;
+    ray.max_t = 1.0f;
+    return core->collision.occluded(ray);
+}
 
-    g_last_error[0] = '\0';
-    return AX_OK;
+static bool living_target(const ax_entity_internal& e) {
+    return (e.state_flags & AX_ENT_FLAG_TARGET) && !(e.state_flags & AX_ENT_FLAG_DEAD);
 }
 
-/* ── Save / Load (SAVE_FORMAT.md v0.3) ───────────────────────────── */
+/* First living target at or after entity index `from` that is not `skip_id`. */
+static uint32_t next_target(const ax_core* core, uint32_t from, uint32_t skip_id) {
+    uint32_t n = (uint32_t)core->entities.size();
+    for (uint32_t i = from; i < n; ++i) {
+        const ax_entity_internal& e = core->entities[i];
+        if (living_target(e) && e.id != skip_id) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
 
 /*
- * On-disk save structures (internal to Core).
- * All multi-byte values are little-endian (native on x86).
- * Layout: [ SaveHeaderV1 ][ A1WorldV1 ][ TargetsV1[] ]
+ * Entity index a shot by `shooter_id` hits: the first living target
+ * other than the shooter, or UINT32_MAX. `*first` caches the first
+ * living target for the rest of the tick (UNRESOLVED before its first
+ * shot). Targets only die during combat, so the cursor only moves
+ * forward and a tick's shots share one scan instead of one each.
  */
+static const uint32_t UNRESOLVED = UINT32_MAX - 1;
 
-static const uint32_t AX_SAVE_MAGIC = 0x56535841;  /* 'AXSV' */
+static uint32_t shot_target(ax_core* core, uint32_t* first, uint32_t shooter_id) {
+    if (*first == UNRESOLVED) {
+        *first = resolve_hit_target(core);
+    } else if (*first != UINT32_MAX && !living_target(core->entities[*first])) {
+        *first = next_target(core, *first + 1, 0);
+    }
+    if (*first == UINT32_MAX || core->entities[*first].id != shooter_id) {
+        return *first;
+    }
+    return next_target(core, *first + 1, shooter_id);
+}
 
-#pragma pack(push, 1)
+/*
+ * The last weapon lookup of a combat phase. A tick's combat actions come
+ * in runs from one actor and slot (a burst of shots). Within the phase
+ * only the actor's death can change the answer, and only another
+ * actor's shot can kill it, which ends the run: so a run costs one
+ * table and one pool lookup instead of one each per action.
+ */
+struct ax_weapon_cursor {
+    uint32_t actor_id = 0;
+    uint32_t slot     = UINT32_MAX;
+    uint32_t row      = ax_weapon_table::NONE;  /* NONE also for a dead actor */
+};
 
-struct ax_save_header_v1 {
-    uint32_t magic;              /* 0x56535841 */
-    uint16_t version_major;      /* = 1        */
-    uint16_t version_minor;      /* = 0        */
-    uint32_t total_size_bytes;
+/* Row of the weapon a living actor holds in `slot`, or NONE. */
+static uint32_t actor_weapon(ax_core* core, ax_weapon_cursor* c, uint32_t actor_id, uint32_t slot) {
+    if (actor_id != c->actor_id || slot != c->slot) {
+        c->actor_id = actor_id;
+        c->slot     = slot;
+        c->row      = core->weapons.find(actor_id, slot);
+        if (c->row != ax_weapon_table::NONE) {
+            const ax_entity_internal* actor = find_actor(core, actor_id);
+            if (!actor || (actor->state_flags & AX_ENT_FLAG_DEAD)) {
+                c->row = ax_weapon_table::NONE;
+            }
+        }
+    }
+    return c->row;
+}
 
-    uint32_t world_chunk_offset;
-    uint32_t world_chunk_size_bytes;
+/*
+ * Phase 2: combat actions, strictly in submission order. FIRE_ONCE and
+ * RELOAD act on the actor's weapon in the action's slot; an actor with
+ * no weapon there (or a dead one) does nothing. Cost scales with the
+ * combat actions of the tick, not with armed actors.
+ */
+static void phase_combat(ax_core* core) {
+    ax_weapon_table& weapons = core->weapons;
+    uint32_t first_target = UNRESOLVED;
+    ax_weapon_cursor cursor;
+    ax_event_tally tally;
+
+    for (const ax_action_v1& a : core->tick_actions) {
+
+        /* ── FIRE_ONCE ── */
+        if (a.type == AX_ACT_FIRE_ONCE) {
+            uint32_t w = actor_weapon(core, &cursor, a.actor_id, a.u.fire_once.weapon_slot);
+            if (w == ax_weapon_table::NONE) {
+                continue;
+            }
 
-    uint32_t checksum32;
-};
+            /* check blocked conditions (COMBAT_A1 Fire Rules) */
+            if (weapons.reloading(w)) {
+                ax_snapshot_event_v1 evt = {};
+                evt.type  = AX_EVT_FIRE_BLOCKED;
+                evt.a     = a.actor_id;
+                evt.b     = a.u.fire_once.weapon_slot;
+                evt.value = AX_FIRE_BLOCKED_RELOADING;
+                core->events.push_back(evt);
+                tally.events[AX_EVT_FIRE_BLOCKED]++;
+                tally.fire_blocked[AX_FIRE_BLOCKED_RELOADING]++;
+            }
+            else if (weapons.ammo_in_mag(w) <= 0) {
+                ax_snapshot_event_v1 evt = {};
+                evt.type  = AX_EVT_FIRE_BLOCKED;
+                evt.a     = a.actor_id;
+                evt.b     = a.u.fire_once.weapon_slot;
+                evt.value = AX_FIRE_BLOCKED_EMPTY_MAG;
+                core->events.push_back(evt);
+                tally.events[AX_EVT_FIRE_BLOCKED]++;
+                tally.fire_blocked[AX_FIRE_BLOCKED_EMPTY_MAG]++;
+            }
+            else {
+                weapons.ammo_in_mag(w)--;
+
+                /* Stub: hit the first living target (if any), never the shooter. */
+                const int32_t DAMAGE = 10;  /* placeholder damage_per_hit */
+
+                uint32_t hit = shot_target(core, &first_target, a.actor_id);
+                if (hit != UINT32_MAX && !shot_blocked(core, a.actor_id, core->entities[hit])) {
+                    ax_entity_internal& e = core->entities[hit];
+                    e.hp -= DAMAGE;
+
+                    ax_snapshot_event_v1 dmg = {};
+                    dmg.type  = AX_EVT_DAMAGE_DEALT;
+                    dmg.a     = a.actor_id;
+                    dmg.b     = e.id;
+                    dmg.value = DAMAGE;
+                    core->events.push_back(dmg);
+                    tally.events[AX_EVT_DAMAGE_DEALT]++;
+
+                    if (e.hp <= 0) {
+                        e.state_flags |= AX_ENT_FLAG_DEAD;
+
+                        ax_snapshot_event_v1 dest = {};
+                        dest.type  = AX_EVT_TARGET_DESTROY;
+                        dest.a     = a.actor_id;
+                        dest.b     = e.id;
+                        dest.value = 0;
+                        core->events.push_back(dest);
+                        tally.events[AX_EVT_TARGET_DESTROY]++;
+                    }
+                }
+            }
+        }
 
-struct ax_save_a1_world_v1 {
-    uint64_t tick;
+        /* ── RELOAD ── */
+        else if (a.type == AX_ACT_RELOAD) {
+            uint32_t w = actor_weapon(core, &cursor, a.actor_id, a.u.reload.weapon_slot);
 
-    /* content references */
-    uint32_t weapon_id_slot0;
-    uint32_t target_def_id;
+            /* COMBAT_A1 Reload Rules */
+            if (w != ax_weapon_table::NONE &&
+                !weapons.reloading(w) &&
+                weapons.ammo_in_mag(w) < MAGAZINE_SIZE &&
+                weapons.ammo_reserve(w) > 0) {
 
-    /* player truth */
-    float px, py, pz;
-    float rx, ry, rz, rw;       /* quaternion */
+                /*
+                 * The countdown used to start at the duration and tick down
+                 * in this tick's timer phase, so completion lands on
+                 * tick + duration - 1.
+                 */
+                ax_timer_payload timer = { AX_TIMER_RELOAD_DONE, weapons.owner(w), weapons.slot(w) };
+                weapons.reload_due_tick(w) = core->tick + RELOAD_DURATION - 1;
+                weapons.reload_timer(w)    = core->timers.schedule(weapons.reload_due_tick(w), timer);
 
-    /* weapon truth (A1) */
-    int32_t  ammo_in_mag;
-    int32_t  ammo_reserve;
-    uint32_t reload_ticks_remaining; /* 0 if not reloading */
+                ax_snapshot_event_v1 evt = {};
+                evt.type  = AX_EVT_RELOAD_STARTED;
+                evt.a     = a.actor_id;
+                evt.b     = a.u.reload.weapon_slot;
+                evt.value = 0;
+                core->events.push_back(evt);
+                tally.events[AX_EVT_RELOAD_STARTED]++;
+            }
+        }
 
-    /* target list */
-    uint32_t target_count;
-    uint32_t targets_offset_bytes;   /* absolute offset from start of blob */
-};
+        /* ── SPRINT / CROUCH (optional, no-op for now) ── */
+        /* MOVE / LOOK were applied in phase 1 */
+    }
+    core->stats.add_events(tally);
+}
 
-struct ax_save_target_v1 {
-    uint32_t entity_id;
+static uint32_t reload_ticks_remaining(const ax_core* core, uint32_t row) {
+    const ax_weapon_table& w = core->weapons;
+    return w.reloading(row) ? (uint32_t)(w.reload_due_tick(row) - core->tick) : 0;
+}
 
-    float px, py, pz;
-    float rx, ry, rz, rw;
+/* COMBAT_A1 reload completion */
+static void complete_reload(ax_core* core, uint32_t row) {
+    ax_weapon_table& w = core->weapons;
+    int32_t needed  = MAGAZINE_SIZE - w.ammo_in_mag(row);
+    int32_t to_load = needed < w.ammo_reserve(row)
+                        ? needed : w.ammo_reserve(row);
+
+    w.ammo_in_mag(row)     += to_load;
+    w.ammo_reserve(row)    -= to_load;
+    w.reload_due_tick(row)  = 0;
+    w.reload_timer(row)     = 0;
+
+    ax_snapshot_event_v1 evt = {};
+    evt.type  = AX_EVT_RELOAD_DONE;
+    evt.a     = w.owner(row);
+    evt.b     = w.slot(row);
+    evt.value = to_load;
+    core->events.push_back(evt);
+}
 
-    int32_t  hp;
-    uint32_t flags;              /* bit0 = destroyed */
+/*
+ * Phase 3: fire timers due this tick (COMBAT_A1 tick ordering step 2).
+ * This runs AFTER all actions are processed.
+ * Implication: RELOAD then FIRE_ONCE in same tick →
+ *   FIRE sees reloading==true and is blocked.
+ *
+ * Cost scales with expiring timers; same-tick timers fire in the order
+ * they were scheduled.
+ */
+static void phase_timers(ax_core* core) {
+    core->fired_timers.clear();
+    core->timers.advance(core->tick, &core->fired_timers);
+
+    ax_event_tally tally;
+    for (const ax_timer_payload& t : core->fired_timers) {
+        switch (t.kind) {
+            case AX_TIMER_RELOAD_DONE: {
+                uint32_t row = core->weapons.find(t.owner_id, t.slot);
+                if (row != ax_weapon_table::NONE && core->weapons.reloading(row)) {
+                    complete_reload(core, row);
+                    tally.events[AX_EVT_RELOAD_DONE]++;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    core->stats.add_events(tally);
+}
+
+/* Upper bounds on what one tick can allocate (see reserve_tick). */
+struct ax_tick_bounds {
+    uint32_t actions;
+    uint32_t moves;         /* MOVE / LOOK             */
+    uint32_t reloads;       /* timers it can schedule  */
+    size_t   events;
+    uint32_t mover_slots;   /* entity slots of movers  */
 };
 
-#pragma pack(pop)
+static size_t tick_frame_bytes(const ax_tick_bounds& b) {
+    return ax_frame_array<ax_action_v1>::worst_case_bytes(b.actions) +
+           ax_frame_array<ax_action_ref>::worst_case_bytes(b.moves) +
+           ax_frame_array<uint32_t>::worst_case_bytes(b.moves ? b.moves + 1 : 0) +
+           ax_frame_array<ax_snapshot_event_v1>::worst_case_bytes((uint32_t)b.events);
+}
+
+static bool tick_has_room(const ax_core* core, const ax_tick_bounds& b) {
+    size_t fired = (size_t)core->timers.live_count() + b.reloads;
+    if (!core->frame.has_room(tick_frame_bytes(b)) || !core->timers.has_room(b.reloads) ||
+        fired > core->fired_timers.capacity()) {
+        return false;
+    }
+    return b.moves == 0 || core->collision.empty() ||
+           (b.mover_slots <= core->character_slots.capacity() &&
+            core->character_caches.size() + b.moves <= core->character_caches.capacity());
+}
 
 /*
- * Simple additive checksum over save bytes.
- * SAVE_FORMAT.md v0.3: compute over save_bytes[0..total-1]
- * with the checksum32 field itself treated as zero.
+ * Allocates everything tick `tick` can need before it changes truth, so
+ * a bad_alloc leaves the core as the previous tick left it. Bounds come
+ * from the tick's queued actions: a shot emits at most two events, a
+ * reload one, and each live timer can complete one reload.
+ *
+ * The queue bound takes every queued action as this tick's, by the
+ * kinds counted as they were queued. When the queue holds only this
+ * tick's actions it is at most a little over the exact one, so it is
+ * what gets reserved once the exact one no longer fits, and a steady
+ * stream of ticks that size skips the exact pass.
  */
-static uint32_t compute_save_checksum(const uint8_t* data, uint32_t size) {
-    uint32_t sum = 0;
-    /* offset of checksum32 within header */
-    const uint32_t cksum_offset = offsetof(ax_save_header_v1, checksum32);
-    for (uint32_t i = 0; i < size; ++i) {
-        if (i >= cksum_offset && i < cksum_offset + 4) continue; /* skip checksum field */
-        sum += data[i];
+static void reserve_tick(ax_core* core, uint64_t tick) {
+    uint32_t queued      = (uint32_t)core->action_queue.size();
+    uint32_t live_timers = core->timers.live_count();
+
+    const ax_queue_mix&  mix   = core->queued_mix;
+    const ax_tick_bounds whole = { queued, mix.moves, mix.reloads,
+                                   2 * (size_t)(queued - mix.moves) + live_timers,
+                                   core->entities.slot_count() };
+    if (tick_has_room(core, whole)) {
+        return;
+    }
+
+    ax_tick_bounds b = { 0, 0, 0, live_timers, 0 };
+    for (const ax_action_v1& a : core->action_queue) {
+        if (a.tick != tick) {
+            continue;
+        }
+        b.actions++;
+        if (a.type == AX_ACT_MOVE_INTENT || a.type == AX_ACT_LOOK_INTENT) {
+            b.moves++;
+            uint32_t slot = ax_entity_slot(a.actor_id);
+            if (slot >= b.mover_slots) {
+                b.mover_slots = slot + 1;
+            }
+        } else if (a.type == AX_ACT_FIRE_ONCE) {
+            b.events += 2;
+        } else if (a.type == AX_ACT_RELOAD) {
+            b.events += 1;
+            b.reloads++;
+        }
+    }
+    if (tick_has_room(core, b)) {
+        return;
+    }
+    if (b.actions == queued) {
+        b = whole;
+    }
+
+    core->frame.reserve(tick_frame_bytes(b));
+
+    core->timers.reserve(b.reloads);
+    size_t fired = (size_t)live_timers + b.reloads;
+    if (fired > core->fired_timers.capacity()) {
+        ax_reserve_more(core->fired_timers, fired - core->fired_timers.size());
+    }
+
+    if (b.moves > 0 && !core->collision.empty()) {
+        if (b.mover_slots > core->character_slots.size()) {
+            ax_reserve_more(core->character_slots, b.mover_slots - core->character_slots.size());
+        }
+        ax_reserve_more(core->character_caches, b.moves);
     }
-    return sum;
 }
 
-ax_result ax_save_bytes(
-    ax_core*  core,
-    void*     out_buf,
-    uint32_t  out_cap_bytes,
-    uint32_t* out_size_bytes)
-{
+static ax_result step_ticks_impl(ax_core* core, uint32_t n_ticks) {
     if (!core) {
-        set_last_error("ax_save_bytes: core must not be NULL");
-        return AX_ERR_INVALID_ARG;
-    }
-    if (!out_size_bytes) {
-        set_last_error("ax_save_bytes: out_size_bytes must not be NULL");
+        set_last_error(core, "ax_step_ticks: core must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
+    ax_stats_call_scope call_timer(&core->profiler, &core->stats, AX_PROFILE_CALL_STEP_TICKS);
 
     /* lifecycle check: must have content loaded */
     if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
-        set_last_error("ax_save_bytes: content not loaded");
+        set_last_error(core, "ax_step_ticks: content not loaded");
         return AX_ERR_BAD_STATE;
     }
 
-    /* count targets */
-    uint32_t target_count = 0;
-    for (const auto& e : core->entities) {
-        if (e.state_flags & AX_ENT_FLAG_TARGET) {
-            target_count++;
-        }
+    /* stepping 0 ticks is a no-op */
+    if (n_ticks == 0) {
+        return AX_OK;
     }
 
-    /* compute total blob size */
-    uint32_t total = (uint32_t)sizeof(ax_save_header_v1)
-                   + (uint32_t)sizeof(ax_save_a1_world_v1)
-                   + target_count * (uint32_t)sizeof(ax_save_target_v1);
+    /* a tick that cannot get its memory does not run; earlier ones stay */
+    uint32_t ran = 0;
+    ax_result result = AX_OK;
+    bool     timed      = call_timer.timed();
+    uint64_t tick_start = call_timer.start();
+    for (; ran < n_ticks; ++ran) {
+        uint64_t tick = core->tick + 1;
+#if AX_PROFILER
+        bool profiling = core->profiler.active();
+        if (profiling) core->profiler.begin_tick(tick);
+#endif
+        try {
+            AX_PROFILE_PHASE(&core->profiler, AX_PROFILE_PHASE_INBOX);
+            drain_inbox(core, tick);
+            reserve_tick(core, tick);
+        } catch (const std::bad_alloc&) {
+            set_last_error(core, "ax_step_ticks: allocation failed before tick %llu",
+                           (unsigned long long)tick);
+            result = AX_ERR_OUT_OF_MEMORY;
+            break;
+        }
+        core->tick = tick;
+
+        /* new frame: last tick's events and scratch are dropped */
+        core->frame.reset();
+        core->events.reset(&core->frame);
+        core->tick_actions.reset(&core->frame);
+        core->move_refs.reset(&core->frame);
+        core->move_runs.reset(&core->frame);
+
+        {
+            AX_PROFILE_PHASE(&core->profiler, AX_PROFILE_PHASE_GATHER);
+            gather_tick_actions(core);
+        }
+        {
+            AX_PROFILE_PHASE(&core->profiler, AX_PROFILE_PHASE_MOVEMENT);
+            phase_movement(core);
+        }
+        {
+            AX_PROFILE_PHASE(&core->profiler, AX_PROFILE_PHASE_COMBAT);
+            phase_combat(core);
+        }
+        {
+            AX_PROFILE_PHASE(&core->profiler, AX_PROFILE_PHASE_TIMERS);
+            phase_timers(core);
+        }
+        if (core->log) {
+            core->log->end_tick(core->tick, core->events.data(), core->events.size(),
+                                core->stats.data().actions_stale);
+        }
 
-    /* always write required size (buffer-too-small rule) */
-    *out_size_bytes = total;
+        /* end of tick: events and scratch are at their peak */
+        ax_memory_usage_v1 usage[AX_MEM_SUBSYSTEM_COUNT];
+        sample_memory(core, usage);
+#if AX_PROFILER
+        if (profiling) core->profiler.end_tick();
+#endif
 
-    /* size-query path */
-    if (!out_buf) {
-        return AX_OK;
-    }
+        core->stats.data().ticks++;
 
-    /* buffer too small */
-    if (out_cap_bytes < total) {
-        set_last_error("ax_save_bytes: buffer too small (%u < %u)",
-                       out_cap_bytes, total);
-        return AX_ERR_BUFFER_TOO_SMALL;
+        /* one clock read per tick: it ends this tick and starts the next */
+        if (timed) {
+            uint64_t tick_end = ax_clock_now_ns();
+            if (core->stats.timing()) {
+                ax_histogram_record(&core->stats.data().tick_ns, tick_end - tick_start);
+            }
+            tick_start = tick_end;
+        }
+    }
+    if (result == AX_OK && timed) {
+        call_timer.end_at(tick_start);     /* the last tick's end closes the call */
     }
 
-    uint8_t* dst = (uint8_t*)out_buf;
-
-    /* ── A1WorldV1 ────────────────────────────────────────────────── */
+    if (ran > 0) {
+        /* transition to RUNNING after first tick */
+        if (core->lifecycle == AX_LIFECYCLE_CONTENT_LOADED) {
+            core->lifecycle = AX_LIFECYCLE_RUNNING;
+        }
+    }
+    if (result != AX_OK) {
+        return result;
+    }
 
-    uint32_t world_offset = (uint32_t)sizeof(ax_save_header_v1);
-    uint32_t targets_offset = world_offset + (uint32_t)sizeof(ax_save_a1_world_v1);
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    ax_save_a1_world_v1 world = {};
-    world.tick = core->tick;
+ax_result ax_step_ticks(ax_core* core, uint32_t n_ticks) {
+    if (reject_if_stepping(core, "ax_step_ticks")) {
+        return AX_ERR_BAD_STATE;
+    }
+    return step_ticks_impl(core, n_ticks);
+}
 
-    /* content references (hardcoded A1 values matching content loading) */
-    world.weapon_id_slot0  = 1000;
-    world.target_def_id    = 2000;
+/* ── Asynchronous stepping ────────────────────────────────────────── */
 
-    /* find player entity */
-    for (const auto& e : core->entities) {
-        if (e.state_flags & AX_ENT_FLAG_PLAYER) {
-            world.px = e.px;  world.py = e.py;  world.pz = e.pz;
-            world.rx = e.rx;  world.ry = e.ry;  world.rz = e.rz;  world.rw = e.rw;
-            break;
+static void async_step_main(ax_core* core) {
+    std::unique_lock<std::mutex> guard(core->async_lock);
+    for (;;) {
+        core->async_wake.wait(guard, [core] {
+            return core->async_quit || core->async_ticks > 0;
+        });
+        if (core->async_quit) {
+            return;
         }
-    }
 
-    /* weapon state */
-    world.ammo_in_mag            = core->weapon.ammo_in_mag;
-    world.ammo_reserve           = core->weapon.ammo_reserve;
-    world.reload_ticks_remaining = core->weapon.reload_ticks_remaining;
+        uint32_t n = core->async_ticks;
+        core->async_ticks = 0;
 
-    world.target_count         = target_count;
-    world.targets_offset_bytes = targets_offset;
+        guard.unlock();
+        ax_result r = step_ticks_impl(core, n);
+        guard.lock();
 
-    std::memcpy(dst + world_offset, &world, sizeof(world));
+        core->async_result = r;
+        core->async_in_flight.store(false, std::memory_order_release);
+        core->async_done.notify_all();
+    }
+}
 
-    /* ── TargetsV1[] ──────────────────────────────────────────────── */
+ax_result ax_step_ticks_async(ax_core* core, uint32_t n_ticks) {
+    if (reject_if_stepping(core, "ax_step_ticks_async")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_step_ticks_async: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* lifecycle check up front, so the common errors are synchronous */
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_step_ticks_async: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+
+    /* clear before publishing: the worker owns last_error from here on */
+    clear_last_error(core);
+
+    if (n_ticks == 0) {
+        return AX_OK;
+    }
+
+    if (!core->async_thread.joinable()) {
+        try {
+            core->async_thread = std::thread(async_step_main, core);
+        } catch (const std::bad_alloc&) {
+            set_last_error(core, "ax_step_ticks_async: allocation failed (step thread)");
+            return AX_ERR_OUT_OF_MEMORY;
+        } catch (const std::system_error&) {
+            set_last_error(core, "ax_step_ticks_async: could not start the step thread");
+            return AX_ERR_INTERNAL;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(core->async_lock);
+        core->async_ticks  = n_ticks;
+        core->async_result = AX_OK;
+        core->async_in_flight.store(true, std::memory_order_release);
+    }
+    core->async_wake.notify_one();
+    return AX_OK;
+}
+
+ax_result ax_step_poll(ax_core* core, int32_t* out_done) {
+    if (!core || !out_done) {
+        set_last_error(nullptr, "ax_step_poll: core and out_done must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    *out_done = step_in_flight(core) ? 0 : 1;
+    return AX_OK;
+}
+
+ax_result ax_step_wait(ax_core* core) {
+    if (!core) {
+        set_last_error(nullptr, "ax_step_wait: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    ax_result r;
+    {
+        std::unique_lock<std::mutex> guard(core->async_lock);
+        core->async_done.wait(guard, [core] { return !step_in_flight(core); });
+        r = core->async_result;
+        core->async_result = AX_OK;   /* consumed */
+    }
+
+    /* surface the worker's error on the calling thread */
+    if (r != AX_OK) {
+        snprintf(t_last_error, sizeof(t_last_error), "%s", core->last_error);
+    } else {
+        t_last_error[0] = '\0';
+    }
+    return r;
+}
+
+/* ── Threading ────────────────────────────────────────────────────── */
+
+ax_result ax_set_threading(ax_core* core, const ax_threading_params_v1* params) {
+    if (reject_if_stepping(core, "ax_set_threading")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !params) {
+        set_last_error(core, "ax_set_threading: core and params must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* struct version check */
+    if (params->version != 1) {
+        set_last_error(core, "ax_set_threading: unknown params version %u", params->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+
+    /* struct size check */
+    if (params->size_bytes < sizeof(ax_threading_params_v1)) {
+        set_last_error(core, "ax_set_threading: size_bytes %u < expected %u",
+                       params->size_bytes,
+                       (unsigned)sizeof(ax_threading_params_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+
+    if (params->worker_count > AX_JOBS_MAX_WORKERS) {
+        set_last_error(core, "ax_set_threading: worker_count %u > max %u",
+                       params->worker_count, (unsigned)AX_JOBS_MAX_WORKERS);
+        return AX_ERR_INVALID_ARG;
+    }
+
+    uint32_t workers = params->worker_count ? params->worker_count : 1;
+    ax_result result = AX_OK;
+    try {
+        core->worker_scratch.resize(workers);   /* spare scratch is harmless */
+        core->jobs.set_worker_count(workers);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_set_threading: allocation failed (%u workers)", workers);
+        result = AX_ERR_OUT_OF_MEMORY;
+    } catch (const std::system_error&) {
+        set_last_error(core, "ax_set_threading: could not start worker threads (%u of %u running)",
+                       core->jobs.worker_count(), workers);
+        result = AX_ERR_INTERNAL;
+    }
+#if AX_PROFILER
+    /* for the workers actually running, which a failure above may have cut */
+    core->profiler.ensure_trace_threads(core->jobs.worker_count());   /* stops tracing on failure */
+#endif
+    if (result != AX_OK) {
+        return result;
+    }
+    core->parallel_grain = params->min_parallel_items ? params->min_parallel_items
+                                                      : AX_DEFAULT_PARALLEL_GRAIN;
+
+    clear_last_error(core);
+    return AX_OK;
+}
+
+/* ── State hash ───────────────────────────────────────────────────── */
+
+ax_result ax_get_state_hash(ax_core* core, uint64_t* out_hash) {
+    if (reject_if_stepping(core, "ax_get_state_hash")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_hash) {
+        set_last_error(core, "ax_get_state_hash: core and out_hash must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_GET_STATE_HASH);
+
+    /* lifecycle check: must have content loaded */
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_get_state_hash: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+
+    /* field by field: struct padding never reaches the hash */
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = fnv1a_value(h, core->tick);
+    h = fnv1a_value(h, core->rng_seed);
 
-    uint32_t t_offset = targets_offset;
     for (const auto& e : core->entities) {
-        if (!(e.state_flags & AX_ENT_FLAG_TARGET)) continue;
+        h = fnv1a_value(h, e.id);
+        h = fnv1a_value(h, e.archetype_id);
+        h = fnv1a_value(h, e.px);  h = fnv1a_value(h, e.py);  h = fnv1a_value(h, e.pz);
+        h = fnv1a_value(h, e.rx);  h = fnv1a_value(h, e.ry);
+        h = fnv1a_value(h, e.rz);  h = fnv1a_value(h, e.rw);
+        h = fnv1a_value(h, e.hp);
+        h = fnv1a_value(h, e.state_flags);
+    }
 
-        ax_save_target_v1 tgt = {};
-        tgt.entity_id = e.id;
-        tgt.px = e.px;  tgt.py = e.py;  tgt.pz = e.pz;
-        tgt.rx = e.rx;  tgt.ry = e.ry;  tgt.rz = e.rz;  tgt.rw = e.rw;
-        tgt.hp = e.hp;
-        tgt.flags = (e.state_flags & AX_ENT_FLAG_DEAD) ? 1u : 0u;
+    /* slot generations decide future ids */
+    h = fnv1a_value(h, core->entities.slot_count());
+    for (uint32_t s = 0; s < core->entities.slot_count(); ++s) {
+        h = fnv1a_value(h, core->entities.generation(s));
+    }
 
-        std::memcpy(dst + t_offset, &tgt, sizeof(tgt));
-        t_offset += (uint32_t)sizeof(tgt);
+    const ax_weapon_table& w = core->weapons;
+    h = fnv1a_value(h, w.size());
+    for (uint32_t row = 0; row < w.size(); ++row) {
+        h = fnv1a_value(h, w.owner(row));
+        h = fnv1a_value(h, w.slot(row));
+        h = fnv1a_value(h, w.weapon_id(row));
+        h = fnv1a_value(h, w.ammo_in_mag(row));
+        h = fnv1a_value(h, w.ammo_reserve(row));
+        h = fnv1a_value(h, (uint8_t)(w.reloading(row) ? 1 : 0));
+        h = fnv1a_value(h, reload_ticks_remaining(core, row));
+    }
+
+    try {
+        core->timers.export_records(&core->timer_records);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_get_state_hash: allocation failed (%u timers)",
+                       core->timers.live_count());
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    h = fnv1a_value(h, core->timers.next_seq());
+    for (const auto& t : core->timer_records) {
+        h = fnv1a_value(h, t.due_tick);
+        h = fnv1a_value(h, t.seq);
+        h = fnv1a_value(h, t.payload.kind);
+        h = fnv1a_value(h, t.payload.owner_id);
+        h = fnv1a_value(h, t.payload.slot);
+    }
+
+    for (const auto& evt : core->events) {
+        h = fnv1a_bytes(h, &evt, sizeof(evt));   /* 4 x 32-bit, no padding */
+    }
+
+    *out_hash = h;
+    clear_last_error(core);
+    return AX_OK;
+}
+
+/* ── Snapshots ────────────────────────────────────────────────────── */
+
+/* Snapshot records are shared by the v1 and compact encodings. */
+
+/* Row of the player's slot-0 weapon (the player_weapon record), or NONE. */
+static uint32_t snapshot_player_weapon(const ax_core* core) {
+    for (const auto& e : core->entities) {
+        if (e.state_flags & AX_ENT_FLAG_PLAYER) {
+            return core->weapons.find(e.id, 0);
+        }
+    }
+    return ax_weapon_table::NONE;
+}
+
+static ax_snapshot_entity_v1 snapshot_entity(const ax_entity_internal& src) {
+    ax_snapshot_entity_v1 ent = {};
+    ent.id           = src.id;
+    ent.archetype_id = src.archetype_id;
+    ent.px = src.px;  ent.py = src.py;  ent.pz = src.pz;
+    ent.rx = src.rx;  ent.ry = src.ry;  ent.rz = src.rz;  ent.rw = src.rw;
+    ent.hp           = src.hp;
+    ent.state_flags  = src.state_flags;
+    return ent;
+}
+
+static ax_snapshot_player_weapon_v1 snapshot_weapon(const ax_core* core, uint32_t row) {
+    const ax_weapon_table& w = core->weapons;
+    ax_snapshot_player_weapon_v1 wpn = {};
+    wpn.player_id    = w.owner(row);
+    wpn.weapon_slot  = w.slot(row);
+    wpn.ammo_in_mag  = w.ammo_in_mag(row);
+    wpn.ammo_reserve = w.ammo_reserve(row);
+
+    wpn.weapon_flags = 0;
+    if (w.reloading(row)) {
+        wpn.weapon_flags |= AX_WPN_FLAG_RELOADING;
+    }
+
+    /*
+     * reload_progress: 0.0 .. 1.0 for presentation.
+     * Internally tracked as an integer due tick (D111).
+     * Convert for the snapshot.
+     */
+    uint32_t remaining = reload_ticks_remaining(core, row);
+    if (remaining > 0) {
+        wpn.reload_progress = 1.0f - ((float)remaining / (float)RELOAD_DURATION);
+    } else {
+        wpn.reload_progress = 0.0f;
+    }
+    return wpn;
+}
+
+/*
+ * Writes a v1 blob, with the weapon table trailer if `with_table`.
+ * `fn` names the entry point in errors.
+ */
+static ax_result write_snapshot_v1(ax_core* core, const char* fn, bool with_table,
+                                   void* out_buf, uint32_t out_cap_bytes, uint32_t* out_size_bytes) {
+    /* lifecycle check: must have content loaded */
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "%s: content not loaded", fn);
+        return AX_ERR_BAD_STATE;
+    }
+
+    /* determine if player weapon state is present */
+    uint32_t player_weapon = snapshot_player_weapon(core);
+    uint32_t has_weapon    = player_weapon != ax_weapon_table::NONE ? 1 : 0;
+
+    /* compute total blob size */
+    uint32_t entity_count = (uint32_t)core->entities.size();
+    uint32_t event_count  = (uint32_t)core->events.size();
+    uint32_t weapon_count = with_table ? core->weapons.size() : 0;
+
+    uint32_t total = (uint32_t)sizeof(ax_snapshot_header_v1)
+                   + entity_count * (uint32_t)sizeof(ax_snapshot_entity_v1)
+                   + has_weapon   * (uint32_t)sizeof(ax_snapshot_player_weapon_v1)
+                   + event_count  * (uint32_t)sizeof(ax_snapshot_event_v1)
+                   + (with_table ? (uint32_t)sizeof(ax_snapshot_weapon_table_v1) : 0)
+                   + weapon_count * (uint32_t)sizeof(ax_snapshot_player_weapon_v1);
+
+    /* always write required size (buffer-too-small rule) */
+    *out_size_bytes = total;
+
+    /* size-query path: out_buf is NULL */
+    if (!out_buf) {
+        return AX_OK;
+    }
+
+    /* buffer too small */
+    if (out_cap_bytes < total) {
+        set_last_error(core, "%s: buffer too small (%u < %u)", fn, out_cap_bytes, total);
+        return AX_ERR_BUFFER_TOO_SMALL;
+    }
+
+    /* ── Build the blob ───────────────────────────────────────────── */
+
+    uint8_t* dst = (uint8_t*)out_buf;
+    uint32_t offset = 0;
+
+    /* header */
+    ax_snapshot_header_v1 hdr = {};
+    hdr.version              = 1;
+    hdr.reserved             = 0;
+    hdr.size_bytes           = total;
+    hdr.tick                 = core->tick;
+    hdr.entity_count         = entity_count;
+    hdr.entity_stride_bytes  = (uint32_t)sizeof(ax_snapshot_entity_v1);
+    hdr.event_count          = event_count;
+    hdr.event_stride_bytes   = (uint32_t)sizeof(ax_snapshot_event_v1);
+    hdr.flags                = with_table ? AX_SNAPSHOT_FLAG_WEAPONS : 0;
+    hdr.player_weapon_present = has_weapon;
+
+    std::memcpy(dst + offset, &hdr, sizeof(hdr));
+    offset += (uint32_t)sizeof(hdr);
+
+    /* entities */
+    for (uint32_t i = 0; i < entity_count; ++i) {
+        ax_snapshot_entity_v1 ent = snapshot_entity(core->entities[i]);
+        std::memcpy(dst + offset, &ent, sizeof(ent));
+        offset += (uint32_t)sizeof(ent);
+    }
+
+    /* player weapon state (if present) */
+    if (has_weapon) {
+        ax_snapshot_player_weapon_v1 wpn = snapshot_weapon(core, player_weapon);
+        std::memcpy(dst + offset, &wpn, sizeof(wpn));
+        offset += (uint32_t)sizeof(wpn);
+    }
+
+    /* events */
+    if (event_count > 0) {
+        std::memcpy(dst + offset, core->events.data(), event_count * sizeof(ax_snapshot_event_v1));
+        offset += event_count * (uint32_t)sizeof(ax_snapshot_event_v1);
+    }
+
+    /* weapon table (requested) */
+    if (with_table) {
+        ax_snapshot_weapon_table_v1 table = {};
+        table.weapon_count        = weapon_count;
+        table.weapon_stride_bytes = (uint32_t)sizeof(ax_snapshot_player_weapon_v1);
+        std::memcpy(dst + offset, &table, sizeof(table));
+        offset += (uint32_t)sizeof(table);
+
+        for (uint32_t row = 0; row < weapon_count; ++row) {
+            ax_snapshot_player_weapon_v1 wpn = snapshot_weapon(core, row);
+            std::memcpy(dst + offset, &wpn, sizeof(wpn));
+            offset += (uint32_t)sizeof(wpn);
+        }
+    }
+
+    core->stats.data().snapshots++;
+    core->stats.data().snapshot_bytes += total;
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_get_snapshot_bytes(
+    ax_core*  core,
+    void*     out_buf,
+    uint32_t  out_cap_bytes,
+    uint32_t* out_size_bytes)
+{
+    if (reject_if_stepping(core, "ax_get_snapshot_bytes")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_get_snapshot_bytes: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_GET_SNAPSHOT);
+    if (!out_size_bytes) {
+        set_last_error(core, "ax_get_snapshot_bytes: out_size_bytes must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    return write_snapshot_v1(core, "ax_get_snapshot_bytes", false, out_buf, out_cap_bytes, out_size_bytes);
+}
+
+/* ── Compact snapshots (ABI 0.9) ─────────────────────────────────── */
+
+/* Runs one v2 encoding pass; dst NULL measures. */
+static uint32_t encode_snapshot_v2(const ax_core* core, uint8_t* dst, float grid,
+                                   uint32_t player_weapon, bool with_table) {
+    ax_snapshot_v2_writer w(dst, grid);
+    bool has_weapon = player_weapon != ax_weapon_table::NONE;
+    if (has_weapon) {
+        w.weapon(snapshot_weapon(core, player_weapon));
+    }
+    if (with_table) {
+        w.weapon_count(core->weapons.size());
+    }
+    for (const auto& e : core->entities) {
+        w.entity(snapshot_entity(e));
+    }
+    for (const auto& ev : core->events) {
+        w.event(ev);
+    }
+    if (with_table) {
+        for (uint32_t row = 0; row < core->weapons.size(); ++row) {
+            w.table_weapon(snapshot_weapon(core, row));
+        }
+    }
+    return w.finish(core->tick, (uint32_t)core->entities.size(),
+                    (uint32_t)core->events.size(), has_weapon, with_table);
+}
+
+ax_result ax_get_snapshot_bytes_ex(
+    ax_core*                      core,
+    const ax_snapshot_request_v1* request,
+    void*                         out_buf,
+    uint32_t                      out_cap_bytes,
+    uint32_t*                     out_size_bytes)
+{
+    if (reject_if_stepping(core, "ax_get_snapshot_bytes_ex")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (!request || !out_size_bytes) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: request and out_size_bytes must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (request->version != 1 || request->size_bytes < sizeof(ax_snapshot_request_v1)) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: unsupported request version %u / size %u",
+                       (unsigned)request->version, (unsigned)request->size_bytes);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (request->flags & ~(AX_SNAPSHOT_REQ_COMPACT | AX_SNAPSHOT_REQ_WEAPONS)) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: unknown flags 0x%x", (unsigned)request->flags);
+        return AX_ERR_INVALID_ARG;
+    }
+    bool with_table = (request->flags & AX_SNAPSHOT_REQ_WEAPONS) != 0;
+    if (!(request->flags & AX_SNAPSHOT_REQ_COMPACT)) {
+        if (!with_table) {
+            return ax_get_snapshot_bytes(core, out_buf, out_cap_bytes, out_size_bytes);
+        }
+        AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_GET_SNAPSHOT);
+        return write_snapshot_v1(core, "ax_get_snapshot_bytes_ex", true,
+                                 out_buf, out_cap_bytes, out_size_bytes);
+    }
+    AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_GET_SNAPSHOT);
+
+    float grid = request->position_grid_m;
+    if (grid == 0.0f) {
+        grid = AX_SNAPSHOT_DEFAULT_GRID_M;
+    }
+    if (!(grid > 0.0f) || !std::isfinite(grid)) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: position_grid_m must be finite and > 0");
+        return AX_ERR_INVALID_ARG;
     }
 
-    /* ── SaveHeaderV1 (written last so checksum covers everything) ── */
+    /* lifecycle check: must have content loaded */
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+
+    /* varints make the size data-dependent: measure, then write */
+    uint32_t player_weapon = snapshot_player_weapon(core);
+    uint32_t total = encode_snapshot_v2(core, nullptr, grid, player_weapon, with_table);
+    *out_size_bytes = total;
+
+    if (!out_buf) {
+        return AX_OK;
+    }
+    if (out_cap_bytes < total) {
+        set_last_error(core, "ax_get_snapshot_bytes_ex: buffer too small (%u < %u)",
+                       out_cap_bytes, total);
+        return AX_ERR_BUFFER_TOO_SMALL;
+    }
+
+    encode_snapshot_v2(core, (uint8_t*)out_buf, grid, player_weapon, with_table);
+    core->stats.data().snapshots++;
+    core->stats.data().snapshot_bytes += total;
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_decode_snapshot_v2(
+    const void* v2_buf,
+    uint32_t    v2_size_bytes,
+    void*       out_buf,
+    uint32_t    out_cap_bytes,
+    uint32_t*   out_size_bytes)
+{
+    if (!v2_buf || !out_size_bytes) {
+        set_last_error(nullptr, "ax_decode_snapshot_v2: v2_buf and out_size_bytes must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    const char* error = nullptr;
+    ax_result r = ax_snapshot_v2_decode((const uint8_t*)v2_buf, v2_size_bytes,
+                                        (uint8_t*)out_buf, out_cap_bytes, out_size_bytes, &error);
+    if (r != AX_OK) {
+        set_last_error(nullptr, "ax_decode_snapshot_v2: %s", error);
+        return r;
+    }
+    clear_last_error(nullptr);
+    return AX_OK;
+}
+
+/* ── Save / Load (SAVE_FORMAT.md v0.3) ───────────────────────────── */
+
+/*
+ * On-disk save structures (internal to Core).
+ * All multi-byte values are little-endian (native on x86).
+ * Layout (1.4): [ SaveHeaderV1 ][ A1WorldV1 + ExtV1_1 .. ExtV1_4 ]
+ *               [ TargetsV1[] ][ TimersV1[] ][ EntitiesV1[] ]
+ *               [ slot generations (u16[]) ][ WeaponsV1[] ]
+ * 1.0 saves have no world extension and no timers; reload state is
+ * rebuilt from reload_ticks_remaining. 1.0/1.1 saves patch the player
+ * and targets of the loaded content; 1.2 saves replace the entity pool.
+ * Saves before 1.3 predate the RNG and load with world seed 0. Saves
+ * before 1.4 hold only the player's weapon, in the world record.
+ */
+
+static const uint32_t AX_SAVE_MAGIC         = 0x56535841;  /* 'AXSV' */
+static const uint16_t AX_SAVE_VERSION_MINOR = 4;
+
+#pragma pack(push, 1)
+
+struct ax_save_header_v1 {
+    uint32_t magic;              /* 0x56535841 */
+    uint16_t version_major;      /* = 1        */
+    uint16_t version_minor;      /* = 0        */
+    uint32_t total_size_bytes;
+
+    uint32_t world_chunk_offset;
+    uint32_t world_chunk_size_bytes;
+
+    uint32_t checksum32;
+};
+
+struct ax_save_a1_world_v1 {
+    uint64_t tick;
+
+    /* content references */
+    uint32_t weapon_id_slot0;
+    uint32_t target_def_id;
+
+    /* player truth */
+    float px, py, pz;
+    float rx, ry, rz, rw;       /* quaternion */
+
+    /* weapon truth (A1) */
+    int32_t  ammo_in_mag;
+    int32_t  ammo_reserve;
+    uint32_t reload_ticks_remaining; /* 0 if not reloading */
+
+    /* target list */
+    uint32_t target_count;
+    uint32_t targets_offset_bytes;   /* absolute offset from start of blob */
+};
+
+struct ax_save_target_v1 {
+    uint32_t entity_id;
+
+    float px, py, pz;
+    float rx, ry, rz, rw;
+
+    int32_t  hp;
+    uint32_t flags;              /* bit0 = destroyed */
+};
+
+/* save 1.1: appended to the world chunk */
+struct ax_save_a1_world_ext_v1_1 {
+    uint64_t timer_next_seq;
+    uint32_t timer_count;
+    uint32_t timers_offset_bytes;    /* absolute offset from start of blob */
+};
+
+struct ax_save_timer_v1 {
+    uint64_t due_tick;
+    uint64_t seq;
+    uint32_t kind;               /* ax_timer_kind */
+    uint32_t owner_id;
+    uint32_t slot;
+    uint32_t reserved;
+};
+
+/* save 1.2: appended after the 1.1 extension */
+struct ax_save_a1_world_ext_v1_2 {
+    uint32_t entity_count;           /* live entities, in pool (iteration) order */
+    uint32_t entities_offset_bytes;  /* absolute offset from start of blob */
+    uint32_t slot_count;             /* entity pool slots                  */
+    uint32_t slots_offset_bytes;     /* u16 generation per slot            */
+};
+
+/* save 1.3: appended after the 1.2 extension */
+struct ax_save_a1_world_ext_v1_3 {
+    uint64_t rng_seed;
+};
+
+/* save 1.4: appended after the 1.3 extension */
+struct ax_save_a1_world_ext_v1_4 {
+    uint32_t weapon_count;           /* weapon table rows, in table order  */
+    uint32_t weapons_offset_bytes;   /* absolute offset from start of blob */
+};
+
+struct ax_save_weapon_v1 {
+    uint32_t owner_id;           /* a saved entity */
+    uint32_t slot;               /* < AX_WEAPON_SLOTS */
+    uint32_t weapon_id;
+    int32_t  ammo_in_mag;
+    int32_t  ammo_reserve;
+    uint32_t reload_ticks_remaining; /* 0 if not reloading */
+};
+
+struct ax_save_entity_v1 {
+    uint32_t entity_id;
+    uint32_t archetype_id;
+
+    float px, py, pz;
+    float rx, ry, rz, rw;
+
+    int32_t  hp;
+    uint32_t state_flags;        /* AX_ENT_FLAG_* */
+};
+
+#pragma pack(pop)
+
+/*
+ * Simple additive checksum over save bytes.
+ * SAVE_FORMAT.md v0.3: compute over save_bytes[0..total-1]
+ * with the checksum32 field itself treated as zero.
+ */
+static uint32_t compute_save_checksum(const uint8_t* data, uint32_t size) {
+    uint32_t sum = 0;
+    /* offset of checksum32 within header */
+    const uint32_t cksum_offset = offsetof(ax_save_header_v1, checksum32);
+    for (uint32_t i = 0; i < size; ++i) {
+        if (i >= cksum_offset && i < cksum_offset + 4) continue; /* skip checksum field */
+        sum += data[i];
+    }
+    return sum;
+}
+
+ax_result ax_save_bytes(
+    ax_core*  core,
+    void*     out_buf,
+    uint32_t  out_cap_bytes,
+    uint32_t* out_size_bytes)
+{
+    if (reject_if_stepping(core, "ax_save_bytes")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_save_bytes: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_SAVE);
+    if (!out_size_bytes) {
+        set_last_error(core, "ax_save_bytes: out_size_bytes must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* lifecycle check: must have content loaded */
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_save_bytes: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+
+    /* count targets */
+    uint32_t target_count = 0;
+    for (const auto& e : core->entities) {
+        if (e.state_flags & AX_ENT_FLAG_TARGET) {
+            target_count++;
+        }
+    }
+
+    try {
+        core->timers.export_records(&core->timer_records);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_save_bytes: allocation failed (%u timers)",
+                       core->timers.live_count());
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    uint32_t timer_count = (uint32_t)core->timer_records.size();
+
+    uint32_t entity_count = core->entities.size();
+    uint32_t slot_count   = core->entities.slot_count();
+    uint32_t weapon_count = core->weapons.size();
+
+    /* compute total blob size */
+    uint32_t world_size = (uint32_t)sizeof(ax_save_a1_world_v1)
+                        + (uint32_t)sizeof(ax_save_a1_world_ext_v1_1)
+                        + (uint32_t)sizeof(ax_save_a1_world_ext_v1_2)
+                        + (uint32_t)sizeof(ax_save_a1_world_ext_v1_3)
+                        + (uint32_t)sizeof(ax_save_a1_world_ext_v1_4);
+    uint32_t total = (uint32_t)sizeof(ax_save_header_v1)
+                   + world_size
+                   + target_count * (uint32_t)sizeof(ax_save_target_v1)
+                   + timer_count * (uint32_t)sizeof(ax_save_timer_v1)
+                   + entity_count * (uint32_t)sizeof(ax_save_entity_v1)
+                   + slot_count * (uint32_t)sizeof(uint16_t)
+                   + weapon_count * (uint32_t)sizeof(ax_save_weapon_v1);
+
+    /* always write required size (buffer-too-small rule) */
+    *out_size_bytes = total;
+
+    /* size-query path */
+    if (!out_buf) {
+        return AX_OK;
+    }
+
+    /* buffer too small */
+    if (out_cap_bytes < total) {
+        set_last_error(core, "ax_save_bytes: buffer too small (%u < %u)",
+                       out_cap_bytes, total);
+        return AX_ERR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t* dst = (uint8_t*)out_buf;
+
+    /* ── A1WorldV1 ────────────────────────────────────────────────── */
+
+    uint32_t world_offset   = (uint32_t)sizeof(ax_save_header_v1);
+    uint32_t targets_offset = world_offset + world_size;
+    uint32_t timers_offset  = targets_offset
+                            + target_count * (uint32_t)sizeof(ax_save_target_v1);
+    uint32_t entities_offset = timers_offset
+                             + timer_count * (uint32_t)sizeof(ax_save_timer_v1);
+    uint32_t slots_offset    = entities_offset
+                             + entity_count * (uint32_t)sizeof(ax_save_entity_v1);
+    uint32_t weapons_offset  = slots_offset
+                             + slot_count * (uint32_t)sizeof(uint16_t);
+
+    ax_save_a1_world_v1 world = {};
+    world.tick = core->tick;
+
+    /* content references (hardcoded A1 values matching content loading) */
+    world.target_def_id    = 2000;
+
+    /* find player entity */
+    for (const auto& e : core->entities) {
+        if (e.state_flags & AX_ENT_FLAG_PLAYER) {
+            world.px = e.px;  world.py = e.py;  world.pz = e.pz;
+            world.rx = e.rx;  world.ry = e.ry;  world.rz = e.rz;  world.rw = e.rw;
+            break;
+        }
+    }
+
+    /* the player's weapon (pre-1.4 readers); the table follows in WeaponsV1[] */
+    uint32_t player_weapon = snapshot_player_weapon(core);
+    if (player_weapon != ax_weapon_table::NONE) {
+        world.weapon_id_slot0        = core->weapons.weapon_id(player_weapon);
+        world.ammo_in_mag            = core->weapons.ammo_in_mag(player_weapon);
+        world.ammo_reserve           = core->weapons.ammo_reserve(player_weapon);
+        world.reload_ticks_remaining = reload_ticks_remaining(core, player_weapon);
+    }
+
+    world.target_count         = target_count;
+    world.targets_offset_bytes = targets_offset;
+
+    std::memcpy(dst + world_offset, &world, sizeof(world));
+
+    ax_save_a1_world_ext_v1_1 ext = {};
+    ext.timer_next_seq      = core->timers.next_seq();
+    ext.timer_count         = timer_count;
+    ext.timers_offset_bytes = timers_offset;
+    std::memcpy(dst + world_offset + sizeof(world), &ext, sizeof(ext));
+
+    ax_save_a1_world_ext_v1_2 ext2 = {};
+    ext2.entity_count          = entity_count;
+    ext2.entities_offset_bytes = entities_offset;
+    ext2.slot_count            = slot_count;
+    ext2.slots_offset_bytes    = slots_offset;
+    std::memcpy(dst + world_offset + sizeof(world) + sizeof(ext), &ext2, sizeof(ext2));
+
+    ax_save_a1_world_ext_v1_3 ext3 = {};
+    ext3.rng_seed = core->rng_seed;
+    std::memcpy(dst + world_offset + sizeof(world) + sizeof(ext) + sizeof(ext2), &ext3, sizeof(ext3));
+
+    ax_save_a1_world_ext_v1_4 ext4 = {};
+    ext4.weapon_count         = weapon_count;
+    ext4.weapons_offset_bytes = weapons_offset;
+    std::memcpy(dst + world_offset + sizeof(world) + sizeof(ext) + sizeof(ext2) + sizeof(ext3),
+                &ext4, sizeof(ext4));
+
+    /* ── TargetsV1[] ──────────────────────────────────────────────── */
+
+    uint32_t t_offset = targets_offset;
+    for (const auto& e : core->entities) {
+        if (!(e.state_flags & AX_ENT_FLAG_TARGET)) continue;
+
+        ax_save_target_v1 tgt = {};
+        tgt.entity_id = e.id;
+        tgt.px = e.px;  tgt.py = e.py;  tgt.pz = e.pz;
+        tgt.rx = e.rx;  tgt.ry = e.ry;  tgt.rz = e.rz;  tgt.rw = e.rw;
+        tgt.hp = e.hp;
+        tgt.flags = (e.state_flags & AX_ENT_FLAG_DEAD) ? 1u : 0u;
+
+        std::memcpy(dst + t_offset, &tgt, sizeof(tgt));
+        t_offset += (uint32_t)sizeof(tgt);
+    }
+
+    /* ── TimersV1[] (1.1, schedule order) ─────────────────────────── */
+
+    uint32_t tm_offset = timers_offset;
+    for (const auto& t : core->timer_records) {
+        ax_save_timer_v1 rec = {};
+        rec.due_tick = t.due_tick;
+        rec.seq      = t.seq;
+        rec.kind     = t.payload.kind;
+        rec.owner_id = t.payload.owner_id;
+        rec.slot     = t.payload.slot;
+
+        std::memcpy(dst + tm_offset, &rec, sizeof(rec));
+        tm_offset += (uint32_t)sizeof(rec);
+    }
+
+    /* ── EntitiesV1[] + slot generations (1.2, pool order) ────────── */
+
+    uint32_t e_offset = entities_offset;
+    for (const auto& e : core->entities) {
+        ax_save_entity_v1 rec = {};
+        rec.entity_id    = e.id;
+        rec.archetype_id = e.archetype_id;
+        rec.px = e.px;  rec.py = e.py;  rec.pz = e.pz;
+        rec.rx = e.rx;  rec.ry = e.ry;  rec.rz = e.rz;  rec.rw = e.rw;
+        rec.hp          = e.hp;
+        rec.state_flags = e.state_flags;
+
+        std::memcpy(dst + e_offset, &rec, sizeof(rec));
+        e_offset += (uint32_t)sizeof(rec);
+    }
+    for (uint32_t s = 0; s < slot_count; ++s) {
+        uint16_t gen = (uint16_t)core->entities.generation(s);
+        std::memcpy(dst + slots_offset + s * sizeof(gen), &gen, sizeof(gen));
+    }
+
+    /* ── WeaponsV1[] (1.4, table order) ───────────────────────────── */
+
+    for (uint32_t row = 0; row < weapon_count; ++row) {
+        ax_save_weapon_v1 rec = {};
+        rec.owner_id               = core->weapons.owner(row);
+        rec.slot                   = core->weapons.slot(row);
+        rec.weapon_id              = core->weapons.weapon_id(row);
+        rec.ammo_in_mag            = core->weapons.ammo_in_mag(row);
+        rec.ammo_reserve           = core->weapons.ammo_reserve(row);
+        rec.reload_ticks_remaining = reload_ticks_remaining(core, row);
+        std::memcpy(dst + weapons_offset + row * sizeof(rec), &rec, sizeof(rec));
+    }
+
+    /* ── SaveHeaderV1 (written last so checksum covers everything) ── */
+
+    ax_save_header_v1 hdr = {};
+    hdr.magic              = AX_SAVE_MAGIC;
+    hdr.version_major      = 1;
+    hdr.version_minor      = AX_SAVE_VERSION_MINOR;
+    hdr.total_size_bytes   = total;
+    hdr.world_chunk_offset = world_offset;
+    hdr.world_chunk_size_bytes = world_size;
+    hdr.checksum32         = 0;  /* zeroed for checksum computation */
+
+    std::memcpy(dst, &hdr, sizeof(hdr));
+
+    /* compute checksum over entire blob with checksum field as zero */
+    hdr.checksum32 = compute_save_checksum(dst, total);
+    std::memcpy(dst, &hdr, sizeof(hdr));
+
+    core->stats.data().saves++;
+    core->stats.data().save_bytes += total;
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_load_save_bytes(
+    ax_core*    core,
+    const void* save_buf,
+    uint32_t    save_size_bytes)
+{
+    if (reject_if_stepping(core, "ax_load_save_bytes")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_load_save_bytes: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    AX_STATS_CALL(&core->profiler, &core->stats, AX_PROFILE_CALL_LOAD);
+    if (!save_buf) {
+        set_last_error(core, "ax_load_save_bytes: save_buf must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (save_size_bytes == 0) {
+        set_last_error(core, "ax_load_save_bytes: save_size_bytes must be > 0");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* lifecycle check: content must be loaded first (SAVE_FORMAT dependency rule) */
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_load_save_bytes: content must be loaded before loading a save");
+        return AX_ERR_BAD_STATE;
+    }
+
+    const uint8_t* src = (const uint8_t*)save_buf;
+
+    /* ── Validate header ─────────────────────────────────────────── */
+
+    if (save_size_bytes < sizeof(ax_save_header_v1)) {
+        set_last_error(core, "ax_load_save_bytes: buffer too small for header (%u < %u)",
+                       save_size_bytes, (unsigned)sizeof(ax_save_header_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+
+    ax_save_header_v1 hdr;
+    std::memcpy(&hdr, src, sizeof(hdr));
+
+    if (hdr.magic != AX_SAVE_MAGIC) {
+        set_last_error(core, "ax_load_save_bytes: bad magic (expected 0x%08X, got 0x%08X)",
+                       AX_SAVE_MAGIC, hdr.magic);
+        return AX_ERR_INVALID_ARG;
+    }
+
+    if (hdr.version_major != 1) {
+        set_last_error(core, "ax_load_save_bytes: unsupported save version %u.%u",
+                       hdr.version_major, hdr.version_minor);
+        return AX_ERR_UNSUPPORTED;
+    }
+
+    if (hdr.total_size_bytes != save_size_bytes) {
+        set_last_error(core, "ax_load_save_bytes: total_size_bytes mismatch (%u in header vs %u provided)",
+                       hdr.total_size_bytes, save_size_bytes);
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* verify checksum */
+    uint32_t expected_cksum = compute_save_checksum(src, save_size_bytes);
+    if (hdr.checksum32 != expected_cksum) {
+        set_last_error(core, "ax_load_save_bytes: checksum mismatch (expected %u, got %u)",
+                       expected_cksum, hdr.checksum32);
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* ── Validate world chunk ────────────────────────────────────── */
+
+    if (hdr.world_chunk_offset + hdr.world_chunk_size_bytes > save_size_bytes) {
+        set_last_error(core, "ax_load_save_bytes: world chunk extends past end of buffer");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    if (hdr.world_chunk_size_bytes < sizeof(ax_save_a1_world_v1)) {
+        set_last_error(core, "ax_load_save_bytes: world chunk too small");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    ax_save_a1_world_v1 world;
+    std::memcpy(&world, src + hdr.world_chunk_offset, sizeof(world));
+
+    /* validate target array bounds */
+    uint32_t targets_end = world.targets_offset_bytes
+                         + world.target_count * (uint32_t)sizeof(ax_save_target_v1);
+    if (targets_end > save_size_bytes) {
+        set_last_error(core, "ax_load_save_bytes: target array extends past end of buffer");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    /* ── Validate timers (1.1; 1.0 rebuilds reload from the world) ── */
+
+    /* 1.4 saves carry the weapon table; their timers are matched to it below */
+    const bool has_weapons = hdr.version_minor >= 4;
+
+    ax_save_a1_world_ext_v1_1 ext = {};
+    if (hdr.version_minor >= 1) {
+        if (hdr.world_chunk_size_bytes < sizeof(ax_save_a1_world_v1) + sizeof(ext)) {
+            set_last_error(core, "ax_load_save_bytes: world chunk too small for save 1.%u",
+                           hdr.version_minor);
+            return AX_ERR_INVALID_ARG;
+        }
+        std::memcpy(&ext, src + hdr.world_chunk_offset + sizeof(world), sizeof(ext));
+
+        uint64_t timers_end = (uint64_t)ext.timers_offset_bytes
+                            + (uint64_t)ext.timer_count * sizeof(ax_save_timer_v1);
+        if (ext.timers_offset_bytes > save_size_bytes || timers_end > save_size_bytes) {
+            set_last_error(core, "ax_load_save_bytes: timer array extends past end of buffer");
+            return AX_ERR_INVALID_ARG;
+        }
+
+        uint32_t reload_timers = 0;
+        for (uint32_t i = 0; i < ext.timer_count; ++i) {
+            ax_save_timer_v1 rec;
+            std::memcpy(&rec, src + ext.timers_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            if (rec.due_tick <= world.tick) {
+                set_last_error(core, "ax_load_save_bytes: timer %u due at tick %llu, not after save tick",
+                               i, (unsigned long long)rec.due_tick);
+                return AX_ERR_INVALID_ARG;
+            }
+            if (rec.kind != AX_TIMER_RELOAD_DONE) {
+                set_last_error(core, "ax_load_save_bytes: timer %u has unknown kind %u", i, rec.kind);
+                return AX_ERR_INVALID_ARG;
+            }
+            if (!has_weapons &&
+                (rec.owner_id != CONTENT_PLAYER_ID || rec.slot != 0 ||
+                 rec.due_tick - world.tick != world.reload_ticks_remaining)) {
+                set_last_error(core, "ax_load_save_bytes: reload timer %u does not match weapon state", i);
+                return AX_ERR_INVALID_ARG;
+            }
+            reload_timers++;
+        }
+        if (!has_weapons && reload_timers != (world.reload_ticks_remaining > 0 ? 1u : 0u)) {
+            set_last_error(core, "ax_load_save_bytes: %u reload timers for reload_ticks_remaining %u",
+                           reload_timers, world.reload_ticks_remaining);
+            return AX_ERR_INVALID_ARG;
+        }
+    }
+
+    /* ── Validate entity pool (1.2; older saves patch content) ───── */
+
+    ax_save_a1_world_ext_v1_2 ext2 = {};
+    const bool has_pool = hdr.version_minor >= 2;
+    if (has_pool) {
+        if (hdr.world_chunk_size_bytes < sizeof(world) + sizeof(ext) + sizeof(ext2)) {
+            set_last_error(core, "ax_load_save_bytes: world chunk too small for save 1.%u",
+                           hdr.version_minor);
+            return AX_ERR_INVALID_ARG;
+        }
+        std::memcpy(&ext2, src + hdr.world_chunk_offset + sizeof(world) + sizeof(ext), sizeof(ext2));
+
+        if (ext2.slot_count > AX_ENTITY_MAX_SLOTS) {
+            set_last_error(core, "ax_load_save_bytes: %u entity slots > max %u",
+                           ext2.slot_count, AX_ENTITY_MAX_SLOTS);
+            return AX_ERR_INVALID_ARG;
+        }
+        uint64_t entities_end = (uint64_t)ext2.entities_offset_bytes
+                              + (uint64_t)ext2.entity_count * sizeof(ax_save_entity_v1);
+        uint64_t slots_end    = (uint64_t)ext2.slots_offset_bytes
+                              + (uint64_t)ext2.slot_count * sizeof(uint16_t);
+        if (entities_end > save_size_bytes || slots_end > save_size_bytes) {
+            set_last_error(core, "ax_load_save_bytes: entity pool extends past end of buffer");
+            return AX_ERR_INVALID_ARG;
+        }
+
+        for (uint32_t slot = 0; slot < ext2.slot_count; ++slot) {
+            uint16_t gen;
+            std::memcpy(&gen, src + ext2.slots_offset_bytes + slot * sizeof(gen), sizeof(gen));
+            if (gen > AX_ENTITY_RETIRED || (slot == 0 && gen != AX_ENTITY_RETIRED)) {
+                set_last_error(core, "ax_load_save_bytes: bad generation %u for entity slot %u",
+                               gen, slot);
+                return AX_ERR_INVALID_ARG;
+            }
+        }
+
+        /* every entity names a distinct slot at that slot's generation */
+        try {
+            core->slot_marks.assign(ext2.slot_count, 0);
+        } catch (const std::bad_alloc&) {
+            set_last_error(core, "ax_load_save_bytes: allocation failed (%u entity slots)",
+                           ext2.slot_count);
+            return AX_ERR_OUT_OF_MEMORY;
+        }
+        uint32_t players = 0;
+        for (uint32_t i = 0; i < ext2.entity_count; ++i) {
+            ax_save_entity_v1 rec;
+            std::memcpy(&rec, src + ext2.entities_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            uint32_t slot = ax_entity_slot(rec.entity_id);
+            if (slot == 0 || slot >= ext2.slot_count) {
+                set_last_error(core, "ax_load_save_bytes: entity %u id 0x%08X names no slot",
+                               i, rec.entity_id);
+                return AX_ERR_INVALID_ARG;
+            }
+            uint16_t gen;
+            std::memcpy(&gen, src + ext2.slots_offset_bytes + slot * sizeof(gen), sizeof(gen));
+            if (ax_entity_generation(rec.entity_id) != gen || core->slot_marks[slot]) {
+                set_last_error(core, "ax_load_save_bytes: entity %u id 0x%08X is stale or duplicated",
+                               i, rec.entity_id);
+                return AX_ERR_INVALID_ARG;
+            }
+            core->slot_marks[slot] = 1;
+
+            if (rec.state_flags & AX_ENT_FLAG_PLAYER) {
+                if (!has_weapons && rec.entity_id != CONTENT_PLAYER_ID) {
+                    set_last_error(core, "ax_load_save_bytes: player id %u does not match weapon owner %u",
+                                   rec.entity_id, CONTENT_PLAYER_ID);
+                    return AX_ERR_INVALID_ARG;
+                }
+                players++;
+            }
+        }
+        if (players != 1) {
+            set_last_error(core, "ax_load_save_bytes: save has %u players, expected 1", players);
+            return AX_ERR_INVALID_ARG;
+        }
+    }
+
+    /* ── World seed (1.3; older saves predate the RNG) ───────────── */
+
+    ax_save_a1_world_ext_v1_3 ext3 = {};
+    if (hdr.version_minor >= 3) {
+        if (hdr.world_chunk_size_bytes < sizeof(world) + sizeof(ext) + sizeof(ext2) + sizeof(ext3)) {
+            set_last_error(core, "ax_load_save_bytes: world chunk too small for save 1.%u",
+                           hdr.version_minor);
+            return AX_ERR_INVALID_ARG;
+        }
+        std::memcpy(&ext3, src + hdr.world_chunk_offset + sizeof(world) + sizeof(ext) + sizeof(ext2),
+                    sizeof(ext3));
+    }
+
+    /* ── Validate weapon table (1.4; older saves arm the content player) ── */
+
+    ax_save_a1_world_ext_v1_4 ext4 = {};
+    if (has_weapons) {
+        uint32_t ext_offset = (uint32_t)(sizeof(world) + sizeof(ext) + sizeof(ext2) + sizeof(ext3));
+        if (hdr.world_chunk_size_bytes < ext_offset + sizeof(ext4)) {
+            set_last_error(core, "ax_load_save_bytes: world chunk too small for save 1.%u",
+                           hdr.version_minor);
+            return AX_ERR_INVALID_ARG;
+        }
+        std::memcpy(&ext4, src + hdr.world_chunk_offset + ext_offset, sizeof(ext4));
+
+        uint64_t weapons_end = (uint64_t)ext4.weapons_offset_bytes
+                             + (uint64_t)ext4.weapon_count * sizeof(ax_save_weapon_v1);
+        if (weapons_end > save_size_bytes) {
+            set_last_error(core, "ax_load_save_bytes: weapon array extends past end of buffer");
+            return AX_ERR_INVALID_ARG;
+        }
+
+        /* saved weapon index by (owner slot, weapon slot); a matching timer claims it */
+        const uint32_t FREE = UINT32_MAX;
+        try {
+            core->weapon_marks.assign((size_t)ext2.slot_count * AX_WEAPON_SLOTS, FREE);
+        } catch (const std::bad_alloc&) {
+            set_last_error(core, "ax_load_save_bytes: allocation failed (%u entity slots)",
+                           ext2.slot_count);
+            return AX_ERR_OUT_OF_MEMORY;
+        }
+        uint32_t reloading = 0;
+        for (uint32_t i = 0; i < ext4.weapon_count; ++i) {
+            ax_save_weapon_v1 rec;
+            std::memcpy(&rec, src + ext4.weapons_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            uint32_t slot = ax_entity_slot(rec.owner_id);
+            uint16_t gen  = 0;
+            if (slot < ext2.slot_count) {
+                std::memcpy(&gen, src + ext2.slots_offset_bytes + slot * sizeof(gen), sizeof(gen));
+            }
+            if (slot >= ext2.slot_count || !core->slot_marks[slot] ||
+                ax_entity_generation(rec.owner_id) != gen) {
+                set_last_error(core, "ax_load_save_bytes: weapon %u owner 0x%08X is not a saved entity",
+                               i, rec.owner_id);
+                return AX_ERR_INVALID_ARG;
+            }
+            if (rec.slot >= AX_WEAPON_SLOTS ||
+                core->weapon_marks[(size_t)slot * AX_WEAPON_SLOTS + rec.slot] != FREE) {
+                set_last_error(core, "ax_load_save_bytes: weapon %u slot %u is out of range or duplicated",
+                               i, rec.slot);
+                return AX_ERR_INVALID_ARG;
+            }
+            core->weapon_marks[(size_t)slot * AX_WEAPON_SLOTS + rec.slot] = i;
+            if (rec.reload_ticks_remaining > 0) {
+                reloading++;
+            }
+        }
+
+        /* one reload timer per reloading weapon, due when it says */
+        for (uint32_t i = 0; i < ext.timer_count; ++i) {
+            ax_save_timer_v1 rec;
+            std::memcpy(&rec, src + ext.timers_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            uint32_t slot = ax_entity_slot(rec.owner_id);
+            uint32_t w    = (slot < ext2.slot_count && rec.slot < AX_WEAPON_SLOTS)
+                          ? core->weapon_marks[(size_t)slot * AX_WEAPON_SLOTS + rec.slot] : FREE;
+            ax_save_weapon_v1 wpn = {};
+            if (w != FREE) {
+                std::memcpy(&wpn, src + ext4.weapons_offset_bytes + w * sizeof(wpn), sizeof(wpn));
+            }
+            if (w == FREE || wpn.owner_id != rec.owner_id || wpn.reload_ticks_remaining == 0 ||
+                rec.due_tick - world.tick != wpn.reload_ticks_remaining) {
+                set_last_error(core, "ax_load_save_bytes: reload timer %u does not match weapon state", i);
+                return AX_ERR_INVALID_ARG;
+            }
+            core->weapon_marks[(size_t)slot * AX_WEAPON_SLOTS + rec.slot] = FREE;
+        }
+        if (ext.timer_count != reloading) {
+            set_last_error(core, "ax_load_save_bytes: %u reload timers for %u reloading weapons",
+                           ext.timer_count, reloading);
+            return AX_ERR_INVALID_ARG;
+        }
+    }
+
+    /* ── Validate target data (before mutating state) ────────────── */
+
+    /*
+     * Records are read in place (unaligned, so via memcpy) rather than
+     * copied into a temporary array; loading does not allocate.
+     * Verify all saved target entity_ids exist in current world.
+     * Non-destructive: if validation fails, we haven't touched core state.
+     * 1.2 saves carry the whole pool, so their target array is not used.
+     */
+    for (uint32_t i = 0; !has_pool && i < world.target_count; ++i) {
+        ax_save_target_v1 st;
+        std::memcpy(&st, src + world.targets_offset_bytes + i * sizeof(st), sizeof(st));
+
+        if (!core->entities.find(st.entity_id)) {
+            set_last_error(core, "ax_load_save_bytes: saved target entity_id %u not found in world",
+                           st.entity_id);
+            return AX_ERR_INVALID_ARG;
+        }
+    }
+
+    /* ── Allocate what applying needs, so that it cannot fail half-way ── */
+
+    try {
+        if (has_pool) {
+            core->entities.reserve_rebuild(ext2.slot_count, ext2.entity_count);
+        }
+        if (has_weapons) {
+            core->weapons.reserve(ext4.weapon_count, ext2.slot_count);
+        } else {
+            core->weapons.reserve(1, ax_entity_slot(CONTENT_PLAYER_ID) + 1);
+        }
+        core->timers.reserve(ext.timer_count + 1);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_load_save_bytes: allocation failed (%u entities, %u weapons)",
+                       has_pool ? ext2.entity_count : core->entities.size(),
+                       has_weapons ? ext4.weapon_count : 1u);
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+
+    /* ── All validation passed — apply state (no more early returns) ── */
+
+    core->tick     = world.tick;
+    core->rng_seed = ext3.rng_seed;
+
+    if (has_pool) {
+        /* replace the pool: generations first, then entities in saved order */
+        core->entities.reset_slots(ext2.slot_count);
+        for (uint32_t slot = 0; slot < ext2.slot_count; ++slot) {
+            uint16_t gen;
+            std::memcpy(&gen, src + ext2.slots_offset_bytes + slot * sizeof(gen), sizeof(gen));
+            core->entities.set_generation(slot, gen);
+        }
+        for (uint32_t i = 0; i < ext2.entity_count; ++i) {
+            ax_save_entity_v1 rec;
+            std::memcpy(&rec, src + ext2.entities_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            ax_entity_internal e = {};
+            e.id           = rec.entity_id;
+            e.archetype_id = rec.archetype_id;
+            e.px = rec.px;  e.py = rec.py;  e.pz = rec.pz;
+            e.rx = rec.rx;  e.ry = rec.ry;  e.rz = rec.rz;  e.rw = rec.rw;
+            e.hp          = rec.hp;
+            e.state_flags = rec.state_flags;
+            core->entities.insert(e);   /* validated above */
+        }
+        core->entities.rebuild_free_list();
+    } else {
+        /* restore player transform */
+        for (auto& e : core->entities) {
+            if (e.state_flags & AX_ENT_FLAG_PLAYER) {
+                e.px = world.px;  e.py = world.py;  e.pz = world.pz;
+                e.rx = world.rx;  e.ry = world.ry;  e.rz = world.rz;  e.rw = world.rw;
+                break;
+            }
+        }
+    }
+
+    /* restore weapons: the saved table, or the content player's weapon */
+    core->weapons.clear();
+    if (has_weapons) {
+        for (uint32_t i = 0; i < ext4.weapon_count; ++i) {
+            ax_save_weapon_v1 rec;
+            std::memcpy(&rec, src + ext4.weapons_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            uint32_t row = core->weapons.add(rec.owner_id, rec.slot, rec.weapon_id,
+                                             rec.ammo_in_mag, rec.ammo_reserve);
+            if (rec.reload_ticks_remaining > 0) {
+                core->weapons.reload_due_tick(row) = world.tick + rec.reload_ticks_remaining;
+            }
+        }
+    } else {
+        uint32_t row = core->weapons.add(CONTENT_PLAYER_ID, 0, world.weapon_id_slot0,
+                                         world.ammo_in_mag, world.ammo_reserve);
+        if (world.reload_ticks_remaining > 0) {
+            core->weapons.reload_due_tick(row) = world.tick + world.reload_ticks_remaining;
+        }
+    }
+
+    /* restore timers (validated above: the only kind is the reload timer) */
+    core->timers.reset(world.tick);
+    if (hdr.version_minor >= 1) {
+        for (uint32_t i = 0; i < ext.timer_count; ++i) {
+            ax_save_timer_v1 rec;
+            std::memcpy(&rec, src + ext.timers_offset_bytes + i * sizeof(rec), sizeof(rec));
+
+            ax_timer_record t = { rec.due_tick, rec.seq, { rec.kind, rec.owner_id, rec.slot } };
+            uint32_t row = core->weapons.find(rec.owner_id, rec.slot);
+            core->weapons.reload_timer(row) = core->timers.restore(t);
+        }
+        if (ext.timer_next_seq > core->timers.next_seq()) {
+            core->timers.set_next_seq(ext.timer_next_seq);
+        }
+    } else if (core->weapons.reloading(0)) {
+        /* 1.0: row 0 is the content player's weapon, added above */
+        ax_timer_payload t = { AX_TIMER_RELOAD_DONE, CONTENT_PLAYER_ID, 0 };
+        core->weapons.reload_timer(0) = core->timers.schedule(core->weapons.reload_due_tick(0), t);
+    }
+
+    /* restore target states (1.0/1.1) */
+    for (uint32_t i = 0; !has_pool && i < world.target_count; ++i) {
+        ax_save_target_v1 st;
+        std::memcpy(&st, src + world.targets_offset_bytes + i * sizeof(st), sizeof(st));
+
+        ax_entity_internal* e = core->entities.find(st.entity_id);
+        e->px = st.px;  e->py = st.py;  e->pz = st.pz;
+        e->rx = st.rx;  e->ry = st.ry;  e->rz = st.rz;  e->rw = st.rw;
+        e->hp = st.hp;
+        if (st.flags & 1u) {
+            e->state_flags |= AX_ENT_FLAG_DEAD;
+        } else {
+            e->state_flags &= ~AX_ENT_FLAG_DEAD;
+        }
+    }
+
+    /* clear pending actions and events (fresh state after load) */
+    core->action_queue.clear();
+    core->queued_mix = {};
+    core->events.clear();
+
+    core->stats.data().loads++;
+    core->stats.data().load_bytes += save_size_bytes;
+    log_event(core, AX_LOG_INFO, AX_LOGC_SAVE_LOADED, save_size_bytes, core->entities.size());
+    clear_last_error(core);
+    return AX_OK;
+}
+
+/* ── Diagnostics ──────────────────────────────────────────────────── */
+
+ax_result ax_get_diagnostics(ax_core* core, ax_diagnostics_v1* out_diag) {
+    if (reject_if_stepping(core, "ax_get_diagnostics")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_get_diagnostics: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (!out_diag) {
+        set_last_error(core, "ax_get_diagnostics: out_diag must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    std::memset(out_diag, 0, sizeof(ax_diagnostics_v1));
+
+    out_diag->version       = 1;
+    out_diag->reserved      = 0;
+    out_diag->size_bytes    = (uint32_t)sizeof(ax_diagnostics_v1);
+
+    out_diag->abi_major     = AX_ABI_MAJOR;
+    out_diag->abi_minor     = AX_ABI_MINOR;
+
+    out_diag->current_tick  = core->tick;
+
+    out_diag->feature_flags = 0;  /* none defined in v1 */
+
+    /*
+     * Build hash: injected at compile time via -DAX_BUILD_HASH="..."
+     * Falls back to "unknown" if not defined.
+     */
+#ifdef AX_BUILD_HASH
+    snprintf(out_diag->build_hash, AX_BUILD_HASH_LEN, "%s", AX_BUILD_HASH);
+#else
+    snprintf(out_diag->build_hash, AX_BUILD_HASH_LEN, "unknown");
+#endif
+
+    snprintf(out_diag->version_string, AX_VERSION_STRING_LEN, "Axiom Core 0.1.0-dev");
+
+    clear_last_error(core);
+    return AX_OK;
+}
+
+/* ── Memory statistics ────────────────────────────────────────────── */
+
+ax_result ax_get_memory_stats(ax_core* core, ax_memory_stats_v1* out_stats) {
+    if (reject_if_stepping(core, "ax_get_memory_stats")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_get_memory_stats: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (!out_stats) {
+        set_last_error(core, "ax_get_memory_stats: out_stats must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    std::memset(out_stats, 0, sizeof(ax_memory_stats_v1));
+
+    out_stats->version         = 1;
+    out_stats->reserved        = 0;
+    out_stats->size_bytes      = (uint32_t)sizeof(ax_memory_stats_v1);
+    out_stats->subsystem_count = AX_MEM_SUBSYSTEM_COUNT;
+
+    sample_memory(core, out_stats->subsystems);
+
+    for (uint32_t i = 0; i < AX_MEM_SUBSYSTEM_COUNT; ++i) {
+        out_stats->total.used_bytes += out_stats->subsystems[i].used_bytes;
+    }
+    out_stats->total.reserved_bytes   = core->alloc.live_bytes;
+    out_stats->total.high_water_bytes = core->alloc.peak_bytes;
+    out_stats->allocation_count       = core->alloc.alloc_count;
+
+    clear_last_error(core);
+    return AX_OK;
+}
+
+/* ── Profiling ────────────────────────────────────────────────────── */
+
+ax_result ax_set_profiling(ax_core* core, int32_t enabled) {
+    if (reject_if_stepping(core, "ax_set_profiling")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_set_profiling: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+#if AX_PROFILER
+    try {
+        core->profiler.set_enabled(enabled != 0);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_set_profiling: allocation failed (tick ring)");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+
+    ax_memory_usage_v1 usage[AX_MEM_SUBSYSTEM_COUNT];
+    sample_memory(core, usage);     /* the ring appears or disappears */
+    clear_last_error(core);
+    return AX_OK;
+#else
+    (void)enabled;
+    set_last_error(core, "ax_set_profiling: built without AX_ENABLE_PROFILER");
+    return AX_ERR_UNSUPPORTED;
+#endif
+}
+
+ax_result ax_get_profile(ax_core* core, ax_profile_v1* out_profile) {
+    if (reject_if_stepping(core, "ax_get_profile")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_profile) {
+        set_last_error(core, "ax_get_profile: core and out_profile must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+#if AX_PROFILER
+    std::memset(out_profile, 0, sizeof(ax_profile_v1));
+    out_profile->version    = 1;
+    out_profile->reserved   = 0;
+    out_profile->size_bytes = (uint32_t)sizeof(ax_profile_v1);
+    core->profiler.copy_out(out_profile);
+
+    clear_last_error(core);
+    return AX_OK;
+#else
+    set_last_error(core, "ax_get_profile: built without AX_ENABLE_PROFILER");
+    return AX_ERR_UNSUPPORTED;
+#endif
+}
+
+/* ── Runtime statistics ───────────────────────────────────────────── */
+
+ax_result ax_get_stats(ax_core* core, ax_stats_v1* out_stats) {
+    if (reject_if_stepping(core, "ax_get_stats")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_stats) {
+        set_last_error(core, "ax_get_stats: core and out_stats must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    std::memcpy(out_stats, &core->stats.data(), sizeof(ax_stats_v1));
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_reset_stats(ax_core* core) {
+    if (reject_if_stepping(core, "ax_reset_stats")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_reset_stats: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    core->stats.reset();
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_set_stats_timing(ax_core* core, int32_t enabled) {
+    if (reject_if_stepping(core, "ax_set_stats_timing")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_set_stats_timing: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    core->stats.set_timing(enabled != 0);
+    clear_last_error(core);
+    return AX_OK;
+}
+
+uint64_t ax_stats_bucket_floor_ns(uint32_t bucket) {
+    if (bucket < 4) return bucket;
+    if (bucket >= AX_STATS_HIST_BUCKETS) return UINT64_MAX;
+    uint32_t e   = bucket / 4 + 1;      /* inverse of ax_stats_bucket */
+    uint64_t sub = bucket % 4;
+    return (1ull << e) + (sub << (e - 2));
+}
+
+/* ── Tracing ──────────────────────────────────────────────────────── */
+
+ax_result ax_enable_tracing(ax_core* core, const ax_trace_params_v1* params) {
+    if (reject_if_stepping(core, "ax_enable_tracing")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_enable_tracing: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+#if AX_PROFILER
+    if (!params) {
+        core->profiler.stop_tracing();
+
+        ax_memory_usage_v1 usage[AX_MEM_SUBSYSTEM_COUNT];
+        sample_memory(core, usage);
+        clear_last_error(core);
+        return AX_OK;
+    }
+
+    /* struct version check */
+    if (params->version != 1) {
+        set_last_error(core, "ax_enable_tracing: unknown params version %u", params->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+
+    /* struct size check */
+    if (params->size_bytes < sizeof(ax_trace_params_v1)) {
+        set_last_error(core, "ax_enable_tracing: size_bytes %u < expected %u",
+                       params->size_bytes,
+                       (unsigned)sizeof(ax_trace_params_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+
+    if (params->reserved0 != 0) {
+        set_last_error(core, "ax_enable_tracing: reserved0 must be 0");
+        return AX_ERR_INVALID_ARG;
+    }
+
+    uint32_t capacity = params->capacity_events ? params->capacity_events
+                                                : AX_TRACE_DEFAULT_CAPACITY;
+    if (!core->profiler.start_tracing(capacity, core->jobs.worker_count())) {
+        set_last_error(core, "ax_enable_tracing: allocation failed (%u events x %u threads)",
+                       capacity, core->jobs.worker_count());
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+
+    ax_memory_usage_v1 usage[AX_MEM_SUBSYSTEM_COUNT];
+    sample_memory(core, usage);     /* the buffers appear */
+    clear_last_error(core);
+    return AX_OK;
+#else
+    (void)params;
+    set_last_error(core, "ax_enable_tracing: built without AX_ENABLE_PROFILER");
+    return AX_ERR_UNSUPPORTED;
+#endif
+}
+
+ax_result ax_drain_trace(ax_core* core, ax_trace_event_v1* out_events, uint32_t out_cap_events,
+                         uint32_t* out_count, uint64_t* out_dropped) {
+    if (reject_if_stepping(core, "ax_drain_trace")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_count) {
+        set_last_error(core, "ax_drain_trace: core and out_count must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+#if AX_PROFILER
+    uint32_t pending = core->profiler.trace_pending();
+    *out_count = pending;
+    if (!out_events) {
+        clear_last_error(core);
+        return AX_OK;
+    }
+    if (out_cap_events < pending) {
+        set_last_error(core, "ax_drain_trace: buffer holds %u events, %u pending",
+                       out_cap_events, pending);
+        return AX_ERR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t dropped = core->profiler.drain_trace(out_events);
+    if (out_dropped) *out_dropped = dropped;
+
+    clear_last_error(core);
+    return AX_OK;
+#else
+    (void)out_events;
+    (void)out_cap_events;
+    (void)out_dropped;
+    *out_count = 0;
+    set_last_error(core, "ax_drain_trace: built without AX_ENABLE_PROFILER");
+    return AX_ERR_UNSUPPORTED;
+#endif
+}
+
+const char* ax_get_trace_name(uint32_t name) {
+    static const char* const PHASES[AX_PROFILE_PHASE_COUNT] = {
+        "inbox", "gather", "movement", "combat", "hit_resolution", "timers",
+    };
+    static const char* const CALLS[AX_PROFILE_CALL_COUNT] = {
+        "ax_submit_actions", "ax_step_ticks", "ax_get_snapshot", "ax_save", "ax_load",
+        "ax_get_state_hash",
+    };
+
+    if (name == AX_TRACE_TICK) return "tick";
+    if (name >= AX_TRACE_PHASE_BASE && name < AX_TRACE_PHASE_BASE + AX_PROFILE_PHASE_COUNT) {
+        return PHASES[name - AX_TRACE_PHASE_BASE];
+    }
+    if (name >= AX_TRACE_CALL_BASE && name < AX_TRACE_CALL_BASE + AX_PROFILE_CALL_COUNT) {
+        return CALLS[name - AX_TRACE_CALL_BASE];
+    }
+    if (name == AX_TRACE_JOB_MOVEMENT) return "job:movement";
+    if (name == AX_TRACE_JOB_HIT_SCAN) return "job:hit_scan";
+    return "?";
+}
+
+/* ── Debug entity spawning ────────────────────────────────────────── */
 
-    ax_save_header_v1 hdr = {};
-    hdr.magic              = AX_SAVE_MAGIC;
-    hdr.version_major      = 1;
-    hdr.version_minor      = 0;
-    hdr.total_size_bytes   = total;
-    hdr.world_chunk_offset = world_offset;
-    hdr.world_chunk_size_bytes = (uint32_t)sizeof(ax_save_a1_world_v1);
-    hdr.checksum32         = 0;  /* zeroed for checksum computation */
+ax_result ax_debug_spawn_target(ax_core* core, const ax_debug_spawn_params_v1* params,
+                                uint32_t* out_entity_id) {
+    if (reject_if_stepping(core, "ax_debug_spawn_target")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !params || !out_entity_id) {
+        set_last_error(core, "ax_debug_spawn_target: core, params and out_entity_id must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_debug_spawn_target: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+    if (params->version != 1) {
+        set_last_error(core, "ax_debug_spawn_target: unknown params version %u", params->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (params->size_bytes < sizeof(ax_debug_spawn_params_v1)) {
+        set_last_error(core, "ax_debug_spawn_target: size_bytes %u < expected %u",
+                       params->size_bytes, (unsigned)sizeof(ax_debug_spawn_params_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+    if (params->hp <= 0 || !is_finite(params->px) || !is_finite(params->py) || !is_finite(params->pz)) {
+        set_last_error(core, "ax_debug_spawn_target: hp must be > 0 and position finite");
+        return AX_ERR_INVALID_ARG;
+    }
 
-    std::memcpy(dst, &hdr, sizeof(hdr));
+    ax_entity_internal target = {};
+    target.archetype_id = params->archetype_id;
+    target.px = params->px;  target.py = params->py;  target.pz = params->pz;
+    target.rx = 0.0f;  target.ry = 0.0f;  target.rz = 0.0f;  target.rw = 1.0f;
+    target.hp          = params->hp;
+    target.state_flags = AX_ENT_FLAG_TARGET;
 
-    /* compute checksum over entire blob with checksum field as zero */
-    hdr.checksum32 = compute_save_checksum(dst, total);
-    std::memcpy(dst, &hdr, sizeof(hdr));
+    if (core->entities.spawn_capacity() == 0) {
+        set_last_error(core, "ax_debug_spawn_target: no free entity slots");
+        return AX_ERR_INTERNAL;
+    }
+    try {
+        core->entities.reserve_spawns(1);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_debug_spawn_target: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    uint32_t id = core->entities.spawn(target);
 
-    g_last_error[0] = '\0';
+    *out_entity_id = id;
+    clear_last_error(core);
     return AX_OK;
 }
 
-ax_result ax_load_save_bytes(
-    ax_core*    core,
-    const void* save_buf,
-    uint32_t    save_size_bytes)
-{
+ax_result ax_debug_despawn_entity(ax_core* core, uint32_t entity_id) {
+    if (reject_if_stepping(core, "ax_debug_despawn_entity")) {
+        return AX_ERR_BAD_STATE;
+    }
     if (!core) {
-        set_last_error("ax_load_save_bytes: core must not be NULL");
+        set_last_error(core, "ax_debug_despawn_entity: core must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
-    if (!save_buf) {
-        set_last_error("ax_load_save_bytes: save_buf must not be NULL");
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_debug_despawn_entity: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+
+    const ax_entity_internal* e = core->entities.find(entity_id);
+    if (!e) {
+        set_last_error(core, "ax_debug_despawn_entity: unknown or stale entity id 0x%08X", entity_id);
         return AX_ERR_INVALID_ARG;
     }
-    if (save_size_bytes == 0) {
-        set_last_error("ax_load_save_bytes: save_size_bytes must be > 0");
+    if (e->state_flags & AX_ENT_FLAG_PLAYER) {
+        set_last_error(core, "ax_debug_despawn_entity: the player cannot be despawned");
         return AX_ERR_INVALID_ARG;
     }
 
-    /* lifecycle check: content must be loaded first (SAVE_FORMAT dependency rule) */
-    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
-        set_last_error("ax_load_save_bytes: content must be loaded before loading a save");
-        return AX_ERR_BAD_STATE;
+    /* first, as the only step that can fail */
+    try {
+        core->entities.despawn(entity_id);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_debug_despawn_entity: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
     }
 
-    const uint8_t* src = (const uint8_t*)save_buf;
+    /* its weapons go with it; a pending reload never fires */
+    for (uint32_t slot = 0; slot < AX_WEAPON_SLOTS; ++slot) {
+        uint32_t row = core->weapons.find(entity_id, slot);
+        if (row != ax_weapon_table::NONE) {
+            core->timers.cancel(core->weapons.reload_timer(row));
+            core->weapons.remove(row);
+        }
+    }
 
-    /* ── Validate header ─────────────────────────────────────────── */
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    if (save_size_bytes < sizeof(ax_save_header_v1)) {
-        set_last_error("ax_load_save_bytes: buffer too small for header (%u < %u)",
-                       save_size_bytes, (unsigned)sizeof(ax_save_header_v1));
+/* ── Weapon table ─────────────────────────────────────────────────── */
+
+ax_result ax_debug_give_weapon(ax_core* core, const ax_debug_weapon_params_v1* params) {
+    if (reject_if_stepping(core, "ax_debug_give_weapon")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !params) {
+        set_last_error(core, "ax_debug_give_weapon: core and params must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_debug_give_weapon: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+    if (params->version != 1) {
+        set_last_error(core, "ax_debug_give_weapon: unknown params version %u", params->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (params->size_bytes < sizeof(ax_debug_weapon_params_v1)) {
+        set_last_error(core, "ax_debug_give_weapon: size_bytes %u < expected %u",
+                       params->size_bytes, (unsigned)sizeof(ax_debug_weapon_params_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+    if (!find_actor(core, params->entity_id)) {
+        set_last_error(core, "ax_debug_give_weapon: 0x%08X is not a living player or target",
+                       params->entity_id);
+        return AX_ERR_INVALID_ARG;
+    }
+    if (params->weapon_slot >= AX_WEAPON_SLOTS || params->ammo_in_mag < 0 ||
+        params->ammo_in_mag > MAGAZINE_SIZE || params->ammo_reserve < 0) {
+        set_last_error(core, "ax_debug_give_weapon: slot must be < %u, ammo_in_mag 0..%d, ammo_reserve >= 0",
+                       AX_WEAPON_SLOTS, MAGAZINE_SIZE);
         return AX_ERR_INVALID_ARG;
     }
 
-    ax_save_header_v1 hdr;
-    std::memcpy(&hdr, src, sizeof(hdr));
+    try {
+        core->weapons.reserve(1, ax_entity_slot(params->entity_id) + 1);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_debug_give_weapon: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
 
-    if (hdr.magic != AX_SAVE_MAGIC) {
-        set_last_error("ax_load_save_bytes: bad magic (expected 0x%08X, got 0x%08X)",
-                       AX_SAVE_MAGIC, hdr.magic);
-        return AX_ERR_INVALID_ARG;
+    uint32_t row = core->weapons.find(params->entity_id, params->weapon_slot);
+    if (row != ax_weapon_table::NONE) {
+        core->timers.cancel(core->weapons.reload_timer(row));
+        core->weapons.remove(row);
     }
+    core->weapons.add(params->entity_id, params->weapon_slot, params->weapon_id,
+                      params->ammo_in_mag, params->ammo_reserve);
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    if (hdr.version_major != 1) {
-        set_last_error("ax_load_save_bytes: unsupported save version %u.%u",
-                       hdr.version_major, hdr.version_minor);
+/* ── Procedural population ────────────────────────────────────────── */
+
+ax_result ax_spawn_population(ax_core* core, const ax_population_params_v1* params,
+                              uint32_t* out_first_id) {
+    if (reject_if_stepping(core, "ax_spawn_population")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !params) {
+        set_last_error(core, "ax_spawn_population: core and params must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_spawn_population: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+    if (params->version != 1) {
+        set_last_error(core, "ax_spawn_population: unknown params version %u", params->version);
         return AX_ERR_UNSUPPORTED;
     }
-
-    if (hdr.total_size_bytes != save_size_bytes) {
-        set_last_error("ax_load_save_bytes: total_size_bytes mismatch (%u in header vs %u provided)",
-                       hdr.total_size_bytes, save_size_bytes);
+    if (params->size_bytes < sizeof(ax_population_params_v1)) {
+        set_last_error(core, "ax_spawn_population: size_bytes %u < expected %u",
+                       params->size_bytes, (unsigned)sizeof(ax_population_params_v1));
         return AX_ERR_INVALID_ARG;
     }
-
-    /* verify checksum */
-    uint32_t expected_cksum = compute_save_checksum(src, save_size_bytes);
-    if (hdr.checksum32 != expected_cksum) {
-        set_last_error("ax_load_save_bytes: checksum mismatch (expected %u, got %u)",
-                       expected_cksum, hdr.checksum32);
+    if (const char* problem = ax_population_validate(*params)) {
+        set_last_error(core, "ax_spawn_population: %s", problem);
         return AX_ERR_INVALID_ARG;
     }
-
-    /* ── Validate world chunk ────────────────────────────────────── */
-
-    if (hdr.world_chunk_offset + hdr.world_chunk_size_bytes > save_size_bytes) {
-        set_last_error("ax_load_save_bytes: world chunk extends past end of buffer");
+    if (params->count > core->entities.spawn_capacity()) {
+        set_last_error(core, "ax_spawn_population: %u targets but only %u free entity slots",
+                       params->count, core->entities.spawn_capacity());
         return AX_ERR_INVALID_ARG;
     }
 
-    if (hdr.world_chunk_size_bytes < sizeof(ax_save_a1_world_v1)) {
-        set_last_error("ax_load_save_bytes: world chunk too small");
-        return AX_ERR_INVALID_ARG;
+    /* reserve first, so the spawn loop below cannot fail half-way */
+    try {
+        core->entities.reserve_spawns(params->count);
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_spawn_population: allocation failed (%u targets)", params->count);
+        return AX_ERR_OUT_OF_MEMORY;
     }
 
-    ax_save_a1_world_v1 world;
-    std::memcpy(&world, src + hdr.world_chunk_offset, sizeof(world));
+    ax_population_generator gen(*params);
+    ax_entity_internal target = {};
+    target.rw          = 1.0f;
+    target.state_flags = AX_ENT_FLAG_TARGET;
+
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < params->count; ++i) {
+        ax_population_placement pl = gen.at(i);
+        target.archetype_id = pl.archetype_id;
+        target.px = pl.px;
+        target.pz = pl.pz;
+        target.hp = pl.hp;
+        uint32_t id = core->entities.spawn(target);
+        if (i == 0) {
+            first = id;
+        }
+    }
 
-    /* validate target array bounds */
-    uint32_t targets_end = world.targets_offset_bytes
-                         + world.target_count * (uint32_t)sizeof(ax_save_target_v1);
-    if (targets_end > save_size_bytes) {
-        set_last_error("ax_load_save_bytes: target array extends past end of buffer");
-        return AX_ERR_INVALID_ARG;
+    if (out_first_id) {
+        *out_first_id = first;
     }
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    /* ── Read target data (validate before mutating state) ───────── */
+/* ── Logging ──────────────────────────────────────────────────────── */
 
-    std::vector<ax_save_target_v1> saved_targets(world.target_count);
-    if (world.target_count > 0) {
-        std::memcpy(saved_targets.data(),
-                    src + world.targets_offset_bytes,
-                    world.target_count * sizeof(ax_save_target_v1));
+ax_result ax_configure_logging(ax_core* core, const ax_log_params_v1* params) {
+    if (reject_if_stepping(core, "ax_configure_logging")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core) {
+        set_last_error(core, "ax_configure_logging: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (!core->log_fn) {
+        set_last_error(core, "ax_configure_logging: core was created without log_fn");
+        return AX_ERR_BAD_STATE;
     }
 
-    /*
-     * Verify all saved target entity_ids exist in current world.
-     * Non-destructive: if validation fails, we haven't touched core state.
-     */
-    for (uint32_t i = 0; i < world.target_count; ++i) {
-        bool found = false;
-        for (const auto& e : core->entities) {
-            if (e.id == saved_targets[i].entity_id) {
-                found = true;
-                break;
-            }
+    ax_log_params_v1 lp;
+    ax_log::default_params(&lp);
+    if (params) {
+        if (params->version != 1) {
+            set_last_error(core, "ax_configure_logging: unknown params version %u", params->version);
+            return AX_ERR_UNSUPPORTED;
+        }
+        if (params->size_bytes < sizeof(ax_log_params_v1)) {
+            set_last_error(core, "ax_configure_logging: size_bytes %u < expected %u",
+                           params->size_bytes, (unsigned)sizeof(ax_log_params_v1));
+            return AX_ERR_INVALID_ARG;
         }
-        if (!found) {
-            set_last_error("ax_load_save_bytes: saved target entity_id %u not found in world",
-                           saved_targets[i].entity_id);
+        if (params->capacity_records > AX_LOG_MAX_CAPACITY || params->min_level >= AX_LOG_LEVEL_COUNT ||
+            params->flush_mode > AX_LOG_FLUSH_BACKGROUND) {
+            set_last_error(core, "ax_configure_logging: capacity_records <= %u, min_level and flush_mode "
+                                 "must be known values", AX_LOG_MAX_CAPACITY);
             return AX_ERR_INVALID_ARG;
         }
+        std::memcpy(&lp, params, sizeof(lp));
     }
 
-    /* ── All validation passed — apply state (no more early returns) ── */
-
-    core->tick = world.tick;
-
-    /* restore player transform */
-    for (auto& e : core->entities) {
-        if (e.state_flags & AX_ENT_FLAG_PLAYER) {
-            e.px = world.px;  e.py = world.py;  e.pz = world.pz;
-            e.rx = world.rx;  e.ry = world.ry;  e.rz = world.rz;  e.rw = world.rw;
-            break;
-        }
+    ax_log* log = nullptr;
+    try {
+        log = ax_new<ax_log>(&core->alloc, &core->alloc, core->log_fn, core->log_user, lp);
+    } catch (const std::bad_alloc&) {
+        log = nullptr;
+    }
+    if (!log) {
+        set_last_error(core, "ax_configure_logging: allocation failed");
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    if (lp.flush_mode == AX_LOG_FLUSH_BACKGROUND && !log->start_flusher()) {
+        ax_delete(&core->alloc, log);
+        set_last_error(core, "ax_configure_logging: could not start the flusher thread");
+        return AX_ERR_INTERNAL;
     }
 
-    /* restore weapon state */
-    core->weapon.ammo_in_mag            = world.ammo_in_mag;
-    core->weapon.ammo_reserve           = world.ammo_reserve;
-    core->weapon.reload_ticks_remaining = world.reload_ticks_remaining;
-    core->weapon.reloading              = (world.reload_ticks_remaining > 0);
+    /* the old pipeline delivers its pending records on the way out */
+    log->set_stale_baseline(core->stats.data().actions_stale);
+    ax_delete(&core->alloc, core->log);
+    core->log = log;
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    /* restore target states */
-    for (uint32_t i = 0; i < world.target_count; ++i) {
-        const ax_save_target_v1& st = saved_targets[i];
-        for (auto& e : core->entities) {
-            if (e.id == st.entity_id) {
-                e.px = st.px;  e.py = st.py;  e.pz = st.pz;
-                e.rx = st.rx;  e.ry = st.ry;  e.rz = st.rz;  e.rw = st.rw;
-                e.hp = st.hp;
-                if (st.flags & 1u) {
-                    e.state_flags |= AX_ENT_FLAG_DEAD;
-                } else {
-                    e.state_flags &= ~AX_ENT_FLAG_DEAD;
-                }
-                break;
-            }
-        }
+/*
+ * Consumer side only, so it may run while an async step writes records.
+ * Like the inbox, errors go to the calling thread only.
+ */
+ax_result ax_flush_log(ax_core* core, uint32_t* out_delivered) {
+    if (!core) {
+        set_last_error(nullptr, "ax_flush_log: core must not be NULL");
+        return AX_ERR_INVALID_ARG;
     }
+    uint32_t n = core->log ? core->log->flush() : 0;
+    if (out_delivered) {
+        *out_delivered = n;
+    }
+    t_last_error[0] = '\0';
+    return AX_OK;
+}
 
-    /* clear pending actions and events (fresh state after load) */
-    core->action_queue.clear();
-    core->events.clear();
-
-    g_last_error[0] = '\0';
+ax_result ax_get_log_stats(ax_core* core, ax_log_stats_v1* out_stats) {
+    if (reject_if_stepping(core, "ax_get_log_stats")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_stats) {
+        set_last_error(core, "ax_get_log_stats: core and out_stats must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (core->log) {
+        core->log->stats(out_stats);
+    } else {
+        std::memset(out_stats, 0, sizeof(*out_stats));
+        out_stats->version    = 1;
+        out_stats->size_bytes = sizeof(*out_stats);
+    }
+    clear_last_error(core);
     return AX_OK;
 }
 
-/* ── Diagnostics ──────────────────────────────────────────────────── */
+/* ── Deterministic RNG ────────────────────────────────────────────── */
 
-ax_result ax_get_diagnostics(ax_core* core, ax_diagnostics_v1* out_diag) {
+ax_result ax_set_rng_seed(ax_core* core, uint64_t seed) {
+    if (reject_if_stepping(core, "ax_set_rng_seed")) {
+        return AX_ERR_BAD_STATE;
+    }
     if (!core) {
-        set_last_error("ax_get_diagnostics: core must not be NULL");
+        set_last_error(core, "ax_set_rng_seed: core must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
-    if (!out_diag) {
-        set_last_error("ax_get_diagnostics: out_diag must not be NULL");
+    core->rng_seed = seed;
+    clear_last_error(core);
+    return AX_OK;
+}
+
+ax_result ax_get_rng_seed(ax_core* core, uint64_t* out_seed) {
+    if (reject_if_stepping(core, "ax_get_rng_seed")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_seed) {
+        set_last_error(core, "ax_get_rng_seed: core and out_seed must not be NULL");
         return AX_ERR_INVALID_ARG;
     }
+    *out_seed = core->rng_seed;
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    std::memset(out_diag, 0, sizeof(ax_diagnostics_v1));
+ax_result ax_rng_generate(ax_core* core, const ax_rng_request_v1* request, uint32_t* out_words) {
+    if (reject_if_stepping(core, "ax_rng_generate")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !request) {
+        set_last_error(core, "ax_rng_generate: core and request must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (request->version != 1) {
+        set_last_error(core, "ax_rng_generate: unknown request version %u", request->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (request->size_bytes < sizeof(ax_rng_request_v1)) {
+        set_last_error(core, "ax_rng_generate: size_bytes %u < expected %u",
+                       request->size_bytes, (unsigned)sizeof(ax_rng_request_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+    if (request->system_id >= AX_RNG_MAX_SYSTEMS) {
+        set_last_error(core, "ax_rng_generate: system_id %u >= %u",
+                       request->system_id, AX_RNG_MAX_SYSTEMS);
+        return AX_ERR_INVALID_ARG;
+    }
+    if (request->first_draw > AX_RNG_MAX_DRAWS ||
+        request->draws_per_entity > AX_RNG_MAX_DRAWS - request->first_draw) {
+        set_last_error(core, "ax_rng_generate: draws %u..%u past the %u per entity and tick",
+                       request->first_draw, request->first_draw + request->draws_per_entity,
+                       AX_RNG_MAX_DRAWS);
+        return AX_ERR_INVALID_ARG;
+    }
+    uint64_t words = (uint64_t)request->entity_count * request->draws_per_entity;
+    if (words > 0 && (!request->entity_ids || !out_words)) {
+        set_last_error(core, "ax_rng_generate: entity_ids and out_words must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
 
-    out_diag->version       = 1;
-    out_diag->reserved      = 0;
-    out_diag->size_bytes    = (uint32_t)sizeof(ax_diagnostics_v1);
+    ax_rng_stream s = { core->rng_seed, request->system_id, request->tick };
+    ax_rng_fill(s, request->entity_ids, request->entity_count, request->first_draw,
+                request->draws_per_entity, out_words);
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    out_diag->abi_major     = AX_ABI_MAJOR;
-    out_diag->abi_minor     = AX_ABI_MINOR;
+/* ── Static collision ─────────────────────────────────────────────── */
 
-    out_diag->current_tick  = core->tick;
+ax_result ax_load_collision_mesh(ax_core* core, const ax_collision_mesh_v1* mesh) {
+    if (reject_if_stepping(core, "ax_load_collision_mesh")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !mesh) {
+        set_last_error(core, "ax_load_collision_mesh: core and mesh must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (core->lifecycle < AX_LIFECYCLE_CONTENT_LOADED) {
+        set_last_error(core, "ax_load_collision_mesh: content not loaded");
+        return AX_ERR_BAD_STATE;
+    }
+    if (mesh->version != 1) {
+        set_last_error(core, "ax_load_collision_mesh: unknown mesh version %u", mesh->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (mesh->size_bytes < sizeof(ax_collision_mesh_v1)) {
+        set_last_error(core, "ax_load_collision_mesh: size_bytes %u < expected %u",
+                       mesh->size_bytes, (unsigned)sizeof(ax_collision_mesh_v1));
+        return AX_ERR_INVALID_ARG;
+    }
 
-    out_diag->feature_flags = 0;  /* none defined in v1 */
+    /* the build keeps the previous mesh until it has succeeded */
+    uint64_t start = ax_clock_now_ns();
+    try {
+        if (const char* problem = core->collision.build(mesh->vertices, mesh->vertex_count,
+                                                        mesh->indices, mesh->triangle_count,
+                                                        &core->jobs)) {
+            set_last_error(core, "ax_load_collision_mesh: %s", problem);
+            return AX_ERR_INVALID_ARG;
+        }
+    } catch (const std::bad_alloc&) {
+        set_last_error(core, "ax_load_collision_mesh: allocation failed (%u triangles)",
+                       mesh->triangle_count);
+        return AX_ERR_OUT_OF_MEMORY;
+    }
+    core->collision_build_ms = (double)(ax_clock_now_ns() - start) / 1e6;
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    /*
-     * Build hash: injected at compile time via -DAX_BUILD_HASH="..."
-     * Falls back to "unknown" if not defined.
-     */
-#ifdef AX_BUILD_HASH
-    snprintf(out_diag->build_hash, AX_BUILD_HASH_LEN, "%s", AX_BUILD_HASH);
-#else
-    snprintf(out_diag->build_hash, AX_BUILD_HASH_LEN, "unknown");
-#endif
+ax_result ax_get_collision_info(ax_core* core, ax_collision_info_v1* out_info) {
+    if (reject_if_stepping(core, "ax_get_collision_info")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !out_info) {
+        set_last_error(core, "ax_get_collision_info: core and out_info must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (out_info->version != 1) {
+        set_last_error(core, "ax_get_collision_info: unknown info version %u", out_info->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (out_info->size_bytes < sizeof(ax_collision_info_v1)) {
+        set_last_error(core, "ax_get_collision_info: size_bytes %u < expected %u",
+                       out_info->size_bytes, (unsigned)sizeof(ax_collision_info_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+    const ax_bvh& bvh = core->collision;
+    out_info->triangle_count = bvh.triangle_count();
+    out_info->node_count     = bvh.node_count();
+    out_info->leaf_count     = bvh.leaf_count();
+    out_info->depth          = bvh.depth();
+    out_info->mesh_hash      = bvh.hash();
+    out_info->memory_bytes   = bvh.used_bytes();
+    out_info->build_ms       = bvh.empty() ? 0.0 : core->collision_build_ms;
+    clear_last_error(core);
+    return AX_OK;
+}
 
-    snprintf(out_diag->version_string, AX_VERSION_STRING_LEN, "Axiom Core 0.1.0-dev");
+ax_result ax_raycast(ax_core* core, const ax_raycast_params_v1* params,
+                     const ax_ray_v1* rays, uint32_t ray_count, ax_ray_hit_v1* out_hits) {
+    if (reject_if_stepping(core, "ax_raycast")) {
+        return AX_ERR_BAD_STATE;
+    }
+    if (!core || !params) {
+        set_last_error(core, "ax_raycast: core and params must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    if (params->version != 1) {
+        set_last_error(core, "ax_raycast: unknown params version %u", params->version);
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (params->size_bytes < sizeof(ax_raycast_params_v1)) {
+        set_last_error(core, "ax_raycast: size_bytes %u < expected %u",
+                       params->size_bytes, (unsigned)sizeof(ax_raycast_params_v1));
+        return AX_ERR_INVALID_ARG;
+    }
+    uint32_t width = params->packet_width ? params->packet_width : 8;
+    if (width != 1 && width != 4 && width != 8) {
+        set_last_error(core, "ax_raycast: packet_width %u (expected 1, 4 or 8)", params->packet_width);
+        return AX_ERR_INVALID_ARG;
+    }
+    if (params->flags & ~AX_RAYCAST_ANY_HIT) {
+        set_last_error(core, "ax_raycast: unknown flags 0x%x", params->flags);
+        return AX_ERR_INVALID_ARG;
+    }
+    if (ray_count > 0 && (!rays || !out_hits)) {
+        set_last_error(core, "ax_raycast: rays and out_hits must not be NULL");
+        return AX_ERR_INVALID_ARG;
+    }
+    for (uint32_t i = 0; i < ray_count; ++i) {
+        const ax_ray_v1& r = rays[i];
+        if (!is_finite(r.ox) || !is_finite(r.oy) || !is_finite(r.oz) || !is_finite(r.dx) ||
+            !is_finite(r.dy) || !is_finite(r.dz) || !is_finite(r.max_t) || r.max_t < 0.0f) {
+            set_last_error(core, "ax_raycast: ray %u is not finite with max_t >= 0", i);
+            return AX_ERR_INVALID_ARG;
+        }
+    }
 
-    g_last_error[0] = '\0';
+    /* ax_ray_v1 has ax_bvh_ray's layout; hits pass through a chunk on the stack */
+    static_assert(sizeof(ax_ray_v1) == sizeof(ax_bvh_ray), "ray layouts differ");
+    static_assert(sizeof(ax_ray_hit_v1) >= sizeof(ax_bvh_hit), "hit does not fit");
+    const ax_bvh& bvh = core->collision;
+    const ax_bvh_ray* in = reinterpret_cast<const ax_bvh_ray*>(rays);
+    const uint32_t CHUNK = 256;
+    ax_bvh_hit hits[CHUNK];
+    for (uint32_t first = 0; first < ray_count; first += CHUNK) {
+        uint32_t n = ray_count - first < CHUNK ? ray_count - first : CHUNK;
+        bvh.raycast(in + first, n, width, (params->flags & AX_RAYCAST_ANY_HIT) != 0, hits);
+        for (uint32_t i = 0; i < n; ++i) {
+            ax_ray_hit_v1& out = out_hits[first + i];
+            out.t        = hits[i].t;
+            out.triangle = AX_RAY_NO_HIT;
+            out.nx = out.ny = out.nz = 0.0f;
+            if (hits[i].triangle != AX_BVH_NO_HIT) {
+                const ax_bvh_triangle& tr = bvh.triangle(hits[i].triangle);
+                float nx = tr.e1[1] * tr.e2[2] - tr.e1[2] * tr.e2[1];
+                float ny = tr.e1[2] * tr.e2[0] - tr.e1[0] * tr.e2[2];
+                float nz = tr.e1[0] * tr.e2[1] - tr.e1[1] * tr.e2[0];
+                float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+                out.triangle = tr.id;
+                if (len > 0.0f) {
+                    out.nx = nx / len;
+                    out.ny = ny / len;
+                    out.nz = nz / len;
+                }
+            }
+        }
+    }
+    clear_last_error(core);
     return AX_OK;
-}
\ No newline at end of file
+}
@@ -0,0 +1,25 @@
+/*
+ * ax_alloc.cpp — Default (global new/delete) allocation callbacks
+ */
+
+#include "ax_alloc.h"
+
+static void* default_alloc(void*, size_t size, size_t align) {
+    return ::operator new(size, std::align_val_t(align), std::nothrow);
+}
+
+static void default_free(void*, void* ptr, size_t, size_t align) {
+    ::operator delete(ptr, std::align_val_t(align));
+}
+
+ax_alloc_state ax_alloc_state::defaults() {
+    ax_alloc_state s;
+    s.alloc_fn   = default_alloc;
+    s.realloc_fn = nullptr;
+    s.free_fn    = default_free;
+    s.user       = nullptr;
+    s.live_bytes  = 0;
+    s.peak_bytes  = 0;
+    s.alloc_count = 0;
+    return s;
+}
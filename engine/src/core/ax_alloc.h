@@ -0,0 +1,148 @@
+/*
+ * ax_alloc.h — Core-internal allocation through host callbacks
+ *
+ * Each ax_core owns one ax_alloc_state (the host's ax_allocator_v1, or
+ * the global-new default) and hands a pointer to it to everything that
+ * allocates on its behalf. STL containers use ax_allocator<T>, which
+ * has no default constructor on purpose: a container that forgot its
+ * allocator does not compile instead of silently using global new.
+ *
+ * The state also counts live bytes for ax_get_memory_stats. Only the
+ * thread that currently owns the core allocates, so the counters are
+ * plain integers.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+struct ax_alloc_state {
+    ax_alloc_fn   alloc_fn;
+    ax_realloc_fn realloc_fn;   /* may be NULL */
+    ax_free_fn    free_fn;
+    void*         user;
+
+    /* statistics (mutable: allocation goes through const pointers) */
+    mutable uint64_t live_bytes;
+    mutable uint64_t peak_bytes;
+    mutable uint64_t alloc_count;
+
+    /* Global operator new/delete (aligned forms). */
+    static ax_alloc_state defaults();
+
+    void* allocate(size_t size, size_t align) const {
+        if (!size) size = 1;
+        void* p = alloc_fn(user, size, align);
+        if (p) note_alloc(size);
+        return p;
+    }
+
+    void deallocate(void* p, size_t size, size_t align) const {
+        if (!p) return;
+        if (!size) size = 1;
+        free_fn(user, p, size, align);
+        live_bytes -= size;
+    }
+
+    /* Contents up to min(old, new) survive; NULL on failure (p untouched). */
+    void* reallocate(void* p, size_t old_size, size_t new_size, size_t align) const {
+        if (!p) return allocate(new_size, align);
+        if (realloc_fn) {
+            if (!old_size) old_size = 1;
+            if (!new_size) new_size = 1;
+            void* q = realloc_fn(user, p, old_size, new_size, align);
+            if (q) {
+                live_bytes -= old_size;
+                note_alloc(new_size);
+            }
+            return q;
+        }
+
+        void* q = allocate(new_size, align);
+        if (!q) return nullptr;
+        std::memcpy(q, p, old_size < new_size ? old_size : new_size);
+        deallocate(p, old_size, align);
+        return q;
+    }
+
+private:
+    void note_alloc(size_t size) const {
+        live_bytes += size;
+        alloc_count++;
+        if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+    }
+};
+
+template <class T>
+struct ax_allocator {
+    typedef T value_type;
+
+    const ax_alloc_state* state;
+
+    explicit ax_allocator(const ax_alloc_state* s) : state(s) {}
+    template <class U>
+    ax_allocator(const ax_allocator<U>& other) : state(other.state) {}
+
+    T* allocate(size_t n) {
+        void* p = state->allocate(n * sizeof(T), alignof(T));
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) {
+        state->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <class U>
+    bool operator==(const ax_allocator<U>& other) const { return state == other.state; }
+    template <class U>
+    bool operator!=(const ax_allocator<U>& other) const { return state != other.state; }
+};
+
+template <class T>
+using ax_vector = std::vector<T, ax_allocator<T>>;
+
+/*
+ * Room for `extra` more elements without reallocating, grown by
+ * doubling so that repeated calls stay amortized. May throw bad_alloc;
+ * `v` is unchanged if it does.
+ */
+template <class T>
+void ax_reserve_more(ax_vector<T>& v, size_t extra) {
+    size_t need = v.size() + extra;
+    if (need > v.capacity()) {
+        size_t doubled = v.capacity() * 2;
+        v.reserve(need > doubled ? need : doubled);
+    }
+}
+
+/*
+ * Single objects on a core's allocator. NULL when the storage itself
+ * can't be had; if T's constructor throws, the storage is returned
+ * before the exception propagates.
+ */
+template <class T, class... Args>
+T* ax_new(const ax_alloc_state* a, Args&&... args) {
+    void* p = a->allocate(sizeof(T), alignof(T));
+    if (!p) return nullptr;
+    try {
+        return new (p) T(std::forward<Args>(args)...);
+    } catch (...) {
+        a->deallocate(p, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+template <class T>
+void ax_delete(const ax_alloc_state* a, T* obj) {
+    if (!obj) return;
+    obj->~T();
+    a->deallocate(obj, sizeof(T), alignof(T));
+}
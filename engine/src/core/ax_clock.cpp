@@ -0,0 +1,33 @@
+/*
+ * ax_clock.cpp — Cycle counter calibration
+ */
+
+#include "ax_clock.h"
+
+#if AX_CLOCK_TSC
+
+/*
+ * Both clocks are read across a ~200 us spin. A preemption inside it
+ * stretches both sides alike, so only the read latency (tens of ns)
+ * is error: well under 0.1%, far finer than a histogram bucket.
+ */
+static ax_clock_scale calibrate() {
+    const uint64_t span_ns = 200000;
+
+    uint64_t ns0 = ax_clock_steady_ns();
+    uint64_t c0  = __rdtsc();
+    uint64_t ns1, c1;
+    do {
+        ns1 = ax_clock_steady_ns();
+        c1  = __rdtsc();
+    } while (ns1 - ns0 < span_ns);
+
+    ax_clock_scale s;
+    s.origin       = c0;
+    s.ns_per_cycle = c1 > c0 ? (double)(ns1 - ns0) / (double)(c1 - c0) : 1.0;
+    return s;
+}
+
+const ax_clock_scale g_ax_clock = calibrate();
+
+#endif
@@ -0,0 +1,213 @@
+/*
+ * ax_frame_arena.h — Per-tick linear arena for transient tick data
+ *
+ * Everything allocated from the arena lives until the next reset(),
+ * which the core calls at the start of each tick (and when truth is
+ * replaced by unload/load). Allocation is a pointer bump; there is no
+ * per-allocation free.
+ *
+ * Memory is only requested from the heap while the arena is still
+ * growing: when a tick overflows the current block, a further block is
+ * chained in, and the next reset() folds all blocks into one block
+ * sized to the high-water mark. Once warmed up, ticks allocate nothing.
+ * reserve() lets the core get a tick's memory before the tick starts,
+ * so that running out of memory cannot stop a tick half-way.
+ *
+ * ax_frame_array<T> is a growable array over the arena for trivially
+ * copyable T. Growing copies into a fresh arena range (the old range
+ * is reclaimed at reset), so reserve-by-doubling keeps it amortized.
+ */
+
+#pragma once
+
+#include "ax_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+class ax_frame_arena {
+public:
+    explicit ax_frame_arena(const ax_alloc_state* alloc, size_t initial_bytes = 64 * 1024)
+        : alloc_(alloc), blocks_(ax_allocator<block>(alloc)),
+          block_(0), offset_(0), used_(0), high_water_(0), initial_(initial_bytes),
+          reserve_(0) {}
+
+    ~ax_frame_arena() {
+        for (const block& b : blocks_) alloc_->deallocate(b.data, b.size, BLOCK_ALIGN);
+    }
+
+    ax_frame_arena(const ax_frame_arena&)            = delete;
+    ax_frame_arena& operator=(const ax_frame_arena&) = delete;
+
+    void* alloc(size_t bytes, size_t align) {
+        for (;;) {
+            if (block_ < blocks_.size()) {
+                size_t aligned = (offset_ + align - 1) & ~(align - 1);
+                if (aligned + bytes <= blocks_[block_].size) {
+                    offset_ = aligned + bytes;
+                    used_  += bytes;
+                    return blocks_[block_].data + aligned;
+                }
+                block_++;
+                offset_ = 0;
+                continue;
+            }
+            /* out of blocks: chain a new one (warm-up only) */
+            size_t size = initial_;
+            while (size < bytes + align) size *= 2;
+            add_block(size);
+        }
+    }
+
+    /*
+     * Makes the first `bytes` allocated after the next reset() (padding
+     * included) come from blocks already held. May throw bad_alloc;
+     * what was allocated since the last reset stays valid either way.
+     */
+    void reserve(size_t bytes) {
+        reserve_ = bytes;
+        if (has_room(bytes)) {
+            return;     /* allocation runs into the last block at worst */
+        }
+        size_t size = initial_;
+        while (size < bytes) size *= 2;
+        add_block(size);
+    }
+
+    /* Whether reserve(bytes) would find the blocks already held. */
+    bool has_room(size_t bytes) const {
+        return bytes == 0 || (!blocks_.empty() && blocks_.back().size >= bytes);
+    }
+
+    /* Invalidates everything allocated since the last reset. Never throws. */
+    void reset() {
+        if (used_ > high_water_) high_water_ = used_;
+        if (blocks_.size() > 1) {
+            /* fold a multi-block tick into one block with headroom */
+            size_t size = initial_;
+            while (size < high_water_ * 2 || size < reserve_) size *= 2;
+
+            /* contents are dead; realloc lets the host grow in place */
+            void* p = alloc_->reallocate(blocks_[0].data, blocks_[0].size, size, BLOCK_ALIGN);
+            if (p) {
+                for (size_t i = 1; i < blocks_.size(); ++i) {
+                    alloc_->deallocate(blocks_[i].data, blocks_[i].size, BLOCK_ALIGN);
+                }
+                blocks_.resize(1);
+                blocks_[0].data = static_cast<uint8_t*>(p);
+                blocks_[0].size = size;
+            }
+            /* else the chain stays as it is; the next reset tries again */
+        }
+        block_   = 0;
+        offset_  = 0;
+        used_    = 0;
+        reserve_ = 0;
+    }
+
+    /* heap held: blocks plus the block list itself */
+    size_t reserved_bytes() const {
+        size_t total = blocks_.capacity() * sizeof(block);
+        for (const auto& b : blocks_) total += b.size;
+        return total;
+    }
+    size_t used_bytes() const { return used_; }
+    size_t high_water_bytes() const { return used_ > high_water_ ? used_ : high_water_; }
+
+private:
+    static constexpr size_t BLOCK_ALIGN = 64;
+
+    struct block {
+        uint8_t* data;
+        size_t   size;
+    };
+
+    void add_block(size_t size) {
+        ax_reserve_more(blocks_, 1);    /* the push_back below cannot throw */
+        void* p = alloc_->allocate(size, BLOCK_ALIGN);
+        if (!p) throw std::bad_alloc();
+        blocks_.push_back({ static_cast<uint8_t*>(p), size });
+    }
+
+    const ax_alloc_state* alloc_;
+    ax_vector<block>      blocks_;
+    size_t                block_;
+    size_t                offset_;
+    size_t                used_;         /* bytes handed out this tick */
+    size_t                high_water_;
+    size_t                initial_;
+    size_t                reserve_;      /* from reserve(), for the next reset */
+};
+
+template <class T>
+class ax_frame_array {
+    static_assert(std::is_trivially_copyable<T>::value, "ax_frame_array needs trivially copyable T");
+
+public:
+    ax_frame_array() : arena_(nullptr), data_(nullptr), size_(0), cap_(0) {}
+
+    /* Drops the contents; call after the arena was reset. */
+    void reset(ax_frame_arena* arena) {
+        arena_ = arena;
+        data_  = nullptr;
+        size_  = 0;
+        cap_   = 0;
+    }
+
+    void clear() { size_ = 0; }
+
+    void push_back(const T& v) {
+        if (size_ == cap_) grow(size_ + 1);
+        data_[size_++] = v;
+    }
+
+    void append(const T* items, uint32_t n) {
+        if (size_ + n > cap_) grow(size_ + n);
+        if (n) std::memcpy(data_ + size_, items, n * sizeof(T));
+        size_ += n;
+    }
+
+    /*
+     * Arena bytes that pushing `n` items into an empty array can take at
+     * worst: every capacity it grows through, plus alignment padding.
+     */
+    static size_t worst_case_bytes(uint32_t n) {
+        if (n == 0) return 0;
+        size_t bytes = 0;
+        for (size_t cap = 16; ; cap *= 2) {
+            bytes += cap * sizeof(T) + alignof(T) - 1;
+            if (cap >= n) return bytes;
+        }
+    }
+
+    uint32_t size() const  { return size_; }
+    bool     empty() const { return size_ == 0; }
+
+    T*       data()       { return data_; }
+    const T* data() const { return data_; }
+    T*       begin()       { return data_; }
+    T*       end()         { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const   { return data_ + size_; }
+
+    T&       operator[](uint32_t i)       { return data_[i]; }
+    const T& operator[](uint32_t i) const { return data_[i]; }
+
+private:
+    void grow(uint32_t min_cap) {
+        uint32_t cap = cap_ ? cap_ * 2 : 16;
+        while (cap < min_cap) cap *= 2;
+        T* data = static_cast<T*>(arena_->alloc(cap * sizeof(T), alignof(T)));
+        if (size_) std::memcpy(data, data_, size_ * sizeof(T));
+        data_ = data;
+        cap_  = cap;
+    }
+
+    ax_frame_arena* arena_;
+    T*              data_;
+    uint32_t        size_;
+    uint32_t        cap_;
+};
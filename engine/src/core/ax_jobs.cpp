@@ -0,0 +1,118 @@
+/*
+ * ax_jobs.cpp — Core-internal job system for tick phases
+ */
+
+#include "ax_jobs.h"
+
+ax_job_system::ax_job_system(const ax_alloc_state* alloc)
+    : n_workers_(1),
+      threads_(ax_allocator<std::thread>(alloc)),
+      generation_(0),
+      active_(0),
+      quit_(false),
+      fn_(nullptr),
+      ctx_(nullptr),
+      count_(0),
+      chunk_(1),
+      next_(0) {
+}
+
+ax_job_system::~ax_job_system() {
+    stop_workers();
+}
+
+void ax_job_system::stop_workers() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        quit_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+    threads_.clear();
+    quit_ = false;
+}
+
+void ax_job_system::set_worker_count(uint32_t n) {
+    if (n < 1) n = 1;
+    if (n > AX_JOBS_MAX_WORKERS) n = AX_JOBS_MAX_WORKERS;
+    if (n == n_workers_) return;
+
+    /* before stopping anything: a bad_alloc leaves the pool as it was */
+    threads_.reserve(n - 1);
+
+    stop_workers();
+    n_workers_ = n;
+
+    try {
+        for (uint32_t w = 1; w < n; ++w) {
+            /* helpers start at the current generation so they never replay an old job */
+            threads_.emplace_back(&ax_job_system::worker_main, this, w, generation_);
+        }
+    } catch (...) {
+        /* run with the helpers that did start: dispatch waits for exactly these */
+        n_workers_ = (uint32_t)threads_.size() + 1;
+        throw;
+    }
+}
+
+void ax_job_system::run_ranges(uint32_t worker) {
+    for (;;) {
+        uint32_t begin = next_.fetch_add(chunk_, std::memory_order_relaxed);
+        if (begin >= count_) break;
+        uint32_t end = begin + chunk_;
+        if (end > count_) end = count_;
+        fn_(ctx_, begin, end, worker);
+    }
+}
+
+void ax_job_system::worker_main(uint32_t worker, uint64_t seen) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> guard(lock_);
+            wake_.wait(guard, [&] { return quit_ || generation_ != seen; });
+            if (quit_) return;
+            seen = generation_;
+        }
+
+        run_ranges(worker);
+
+        std::lock_guard<std::mutex> guard(lock_);
+        if (--active_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+void ax_job_system::parallel_for(uint32_t count, uint32_t grain,
+                                 ax_job_range_fn fn, void* ctx) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    if (n_workers_ == 1 || count <= grain) {
+        fn(ctx, 0, count, 0);
+        return;
+    }
+
+    /* ~4 ranges per worker for balance, never below grain */
+    uint32_t chunk = count / (n_workers_ * 4);
+    if (chunk < grain) chunk = grain;
+
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        fn_     = fn;
+        ctx_    = ctx;
+        count_  = count;
+        chunk_  = chunk;
+        next_.store(0, std::memory_order_relaxed);
+        active_ = n_workers_ - 1;
+        generation_++;
+    }
+    wake_.notify_all();
+
+    run_ranges(0);
+
+    std::unique_lock<std::mutex> guard(lock_);
+    done_.wait(guard, [&] { return active_ == 0; });
+}
@@ -0,0 +1,93 @@
+/*
+ * ax_jobs.h — Core-internal job system for tick phases
+ *
+ * A small fork/join pool owned by one ax_core. Tick phases split their
+ * per-entity work into index ranges with parallel_for; the calling
+ * (sim) thread participates as worker 0 and returns only when every
+ * range has run.
+ *
+ * Determinism rule: a range callback may only write to
+ *   - the items in its own [begin, end) range, or
+ *   - per-worker scratch indexed by the `worker` argument,
+ * and per-worker results must be merged in an order that does not
+ * depend on which worker ran which range (e.g. sorted by entity id).
+ * Under that rule results are bit-identical for any worker count.
+ *
+ * Dispatch does not allocate.
+ */
+
+#pragma once
+
+#include "ax_alloc.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+typedef void (*ax_job_range_fn)(void* ctx, uint32_t begin, uint32_t end, uint32_t worker);
+
+#define AX_JOBS_MAX_WORKERS 64
+
+class ax_job_system {
+public:
+    explicit ax_job_system(const ax_alloc_state* alloc);
+    ~ax_job_system();
+
+    ax_job_system(const ax_job_system&)            = delete;
+    ax_job_system& operator=(const ax_job_system&) = delete;
+
+    /*
+     * Total worker count including the calling thread (1 = inline).
+     * Must not be called from inside parallel_for. May throw bad_alloc
+     * before any worker is touched, or bad_alloc / std::system_error
+     * while starting helpers; the pool then keeps the helpers that did
+     * start (worker_count() says how many), which is still correct.
+     */
+    void     set_worker_count(uint32_t n);
+    uint32_t worker_count() const { return n_workers_; }
+
+    /* heap held by the thread table (thread stacks are not counted) */
+    size_t reserved_bytes() const { return threads_.capacity() * sizeof(std::thread); }
+    size_t used_bytes() const     { return threads_.size() * sizeof(std::thread); }
+
+    /*
+     * Runs fn over [0, count) split into ranges of at least `grain`
+     * items. Runs inline on the caller when there is one worker or
+     * count <= grain.
+     */
+    void parallel_for(uint32_t count, uint32_t grain, ax_job_range_fn fn, void* ctx);
+
+    template <class F>
+    void parallel_for(uint32_t count, uint32_t grain, F& body) {
+        parallel_for(count, grain, &trampoline<F>, &body);
+    }
+
+private:
+    template <class F>
+    static void trampoline(void* ctx, uint32_t begin, uint32_t end, uint32_t worker) {
+        (*static_cast<F*>(ctx))(begin, end, worker);
+    }
+
+    void stop_workers();
+    void worker_main(uint32_t worker, uint64_t seen);
+    void run_ranges(uint32_t worker);
+
+    uint32_t                 n_workers_;
+    ax_vector<std::thread>   threads_;
+
+    std::mutex              lock_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    uint64_t                generation_;   /* bumped per dispatch (guarded by lock_) */
+    uint32_t                active_;       /* helpers still inside a dispatch        */
+    bool                    quit_;
+
+    /* current job (published under lock_, read by helpers after wake) */
+    ax_job_range_fn       fn_;
+    void*                 ctx_;
+    uint32_t              count_;
+    uint32_t              chunk_;
+    std::atomic<uint32_t> next_;
+};
@@ -0,0 +1,189 @@
+/*
+ * ax_log.cpp — Buffered structured logging (ax_configure_logging)
+ */
+
+#include "ax_log.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+void ax_log::default_params(ax_log_params_v1* out) {
+    std::memset(out, 0, sizeof(*out));
+    out->version          = 1;
+    out->size_bytes       = sizeof(*out);
+    out->capacity_records = AX_LOG_DEFAULT_CAPACITY;
+    out->min_level        = AX_LOG_INFO;
+    out->rate_per_tick[AX_LOG_ERROR] = 0;
+    out->rate_per_tick[AX_LOG_WARN]  = 64;
+    out->rate_per_tick[AX_LOG_INFO]  = 64;
+    out->rate_per_tick[AX_LOG_DEBUG] = 256;
+    out->flush_mode        = AX_LOG_FLUSH_MANUAL;
+    out->flush_interval_ms = AX_LOG_DEFAULT_INTERVAL_MS;
+}
+
+ax_log::ax_log(const ax_alloc_state* alloc, ax_log_fn fn, void* user, const ax_log_params_v1& params)
+    : ring_(alloc, params.capacity_records ? params.capacity_records : AX_LOG_DEFAULT_CAPACITY),
+      fn_(fn), user_(user), min_level_(params.min_level),
+      interval_ms_(params.flush_interval_ms ? params.flush_interval_ms : AX_LOG_DEFAULT_INTERVAL_MS),
+      stale_seen_(0), dropped_full_(0), delivered_(0), quit_(false) {
+    for (uint32_t l = 0; l < AX_LOG_LEVEL_COUNT; ++l) {
+        rate_[l]         = params.rate_per_tick[l];
+        this_tick_[l]    = 0;
+        written_[l]      = 0;
+        rate_limited_[l] = 0;
+    }
+}
+
+ax_log::~ax_log() {
+    if (flusher_.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(wake_lock_);
+            quit_ = true;
+        }
+        wake_.notify_one();
+        flusher_.join();
+    }
+    flush();
+}
+
+bool ax_log::start_flusher() {
+    try {
+        flusher_ = std::thread(&ax_log::flusher_main, this);
+    } catch (const std::system_error&) {
+        return false;
+    }
+    return true;
+}
+
+void ax_log::flusher_main() {
+    std::unique_lock<std::mutex> guard(wake_lock_);
+    while (!quit_) {
+        wake_.wait_for(guard, std::chrono::milliseconds(interval_ms_), [this] { return quit_; });
+        if (quit_) {
+            break;
+        }
+        guard.unlock();
+        flush();
+        guard.lock();
+    }
+}
+
+/* ── Writer ───────────────────────────────────────────────────────── */
+
+void ax_log::write(uint32_t level, uint32_t code, uint64_t tick, uint64_t a0, uint64_t a1, uint64_t a2) {
+    if (rate_[level] != 0 && this_tick_[level] >= rate_[level]) {
+        rate_limited_[level]++;
+        return;
+    }
+    this_tick_[level]++;
+
+    ax_log_record rec;
+    rec.tick    = tick;
+    rec.code    = code;
+    rec.level   = level;
+    rec.args[0] = a0;
+    rec.args[1] = a1;
+    rec.args[2] = a2;
+    if (!ring_.try_push(&rec, 1)) {
+        dropped_full_++;
+        return;
+    }
+    written_[level]++;
+}
+
+void ax_log::end_tick(uint64_t tick, const ax_snapshot_event_v1* events, uint32_t n, uint64_t stale_total) {
+    /* stale_total can fall (stats reset); that tick reports nothing */
+    if (stale_total > stale_seen_ && wants(AX_LOG_WARN)) {
+        write(AX_LOG_WARN, AX_LOGC_ACTIONS_STALE, tick, stale_total - stale_seen_);
+    }
+    stale_seen_ = stale_total;
+    for (uint32_t i = 0; i < n; ++i) {
+        const ax_snapshot_event_v1& e = events[i];
+        uint32_t level, code;
+        switch (e.type) {
+            case AX_EVT_FIRE_BLOCKED:   level = AX_LOG_DEBUG; code = AX_LOGC_FIRE_BLOCKED;     break;
+            case AX_EVT_TARGET_DESTROY: level = AX_LOG_INFO;  code = AX_LOGC_TARGET_DESTROYED; break;
+            case AX_EVT_RELOAD_DONE:    level = AX_LOG_DEBUG; code = AX_LOGC_RELOAD_DONE;      break;
+            default: continue;
+        }
+        if (wants(level)) {
+            write(level, code, tick, e.a, e.b, (uint64_t)(int64_t)e.value);
+        }
+    }
+
+    /* records written between ticks (loads) count against the next tick */
+    for (uint32_t l = 0; l < AX_LOG_LEVEL_COUNT; ++l) {
+        this_tick_[l] = 0;
+    }
+}
+
+/* ── Flush ────────────────────────────────────────────────────────── */
+
+uint32_t ax_log::flush() {
+    std::lock_guard<std::mutex> guard(flush_lock_);
+    uint32_t n = 0;
+    ax_log_record rec;
+    char msg[256];
+    while (ring_.try_pop(&rec)) {
+        ax_log_format(rec, msg, sizeof(msg));
+        fn_(user_, (int)rec.level, msg);
+        n++;
+    }
+    delivered_.fetch_add(n, std::memory_order_relaxed);
+    return n;
+}
+
+void ax_log::stats(ax_log_stats_v1* out) const {
+    std::memset(out, 0, sizeof(*out));
+    out->version    = 1;
+    out->size_bytes = sizeof(*out);
+    out->pending    = ring_.size_approx();
+    for (uint32_t l = 0; l < AX_LOG_LEVEL_COUNT; ++l) {
+        out->written[l]      = written_[l];
+        out->rate_limited[l] = rate_limited_[l];
+    }
+    out->dropped_full = dropped_full_;
+    out->delivered    = delivered_.load(std::memory_order_relaxed);
+}
+
+/* ── Formatting ───────────────────────────────────────────────────── */
+
+void ax_log_format(const ax_log_record& rec, char* buf, size_t cap) {
+    unsigned long long a0 = rec.args[0], a1 = rec.args[1], a2 = rec.args[2];
+    int n = snprintf(buf, cap, "[tick %llu] ", (unsigned long long)rec.tick);
+    if (n < 0 || (size_t)n >= cap) {
+        return;
+    }
+    buf += n;
+    cap -= (size_t)n;
+
+    switch (rec.code) {
+        case AX_LOGC_CONTENT_LOADED:
+            snprintf(buf, cap, "content loaded: %llu entities", a0);
+            break;
+        case AX_LOGC_CONTENT_UNLOADED:
+            snprintf(buf, cap, "content unloaded");
+            break;
+        case AX_LOGC_SAVE_LOADED:
+            snprintf(buf, cap, "save loaded: %llu bytes, %llu entities", a0, a1);
+            break;
+        case AX_LOGC_ACTIONS_STALE:
+            snprintf(buf, cap, "%llu action(s) dropped as stale", a0);
+            break;
+        case AX_LOGC_FIRE_BLOCKED:
+            snprintf(buf, cap, "fire blocked: actor %llu, slot %llu, %s", a0, a1,
+                     a2 == AX_FIRE_BLOCKED_RELOADING ? "reloading" : "empty magazine");
+            break;
+        case AX_LOGC_TARGET_DESTROYED:
+            snprintf(buf, cap, "target 0x%08llX destroyed by actor %llu", a1, a0);
+            break;
+        case AX_LOGC_RELOAD_DONE:
+            snprintf(buf, cap, "reload done: actor %llu, slot %llu, %llu rounds", a0, a1, a2);
+            break;
+        default:
+            snprintf(buf, cap, "code %u (%llu, %llu, %llu)", rec.code, a0, a1, a2);
+            break;
+    }
+}
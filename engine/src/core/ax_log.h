@@ -0,0 +1,120 @@
+/*
+ * ax_log.h — Buffered structured logging (ax_configure_logging)
+ *
+ * The thread driving the core is the only writer: a record is a level
+ * check, a per-tick rate check and one push into an SPSC ring
+ * (ax_spsc.h), with no formatting, allocation or locking. Flushers
+ * (ax_flush_log on any thread, or the background thread) take the
+ * consumer side under flush_lock_, which the writer never touches, so
+ * a slow log_fn delays only the next flush.
+ *
+ * Producer-side counters are plain fields: they are read only by
+ * ax_get_log_stats, which is never concurrent with a tick.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+#include "ax_alloc.h"
+#include "ax_spsc.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/* What a record says; args per code are listed beside it. */
+enum ax_log_code : uint32_t {
+    AX_LOGC_CONTENT_LOADED   = 0,   /* entities                        */
+    AX_LOGC_CONTENT_UNLOADED = 1,   /* -                               */
+    AX_LOGC_SAVE_LOADED      = 2,   /* bytes, entities                 */
+    AX_LOGC_ACTIONS_STALE    = 3,   /* actions dropped this tick       */
+    AX_LOGC_FIRE_BLOCKED     = 4,   /* actor, slot, ax_fire_blocked_reason */
+    AX_LOGC_TARGET_DESTROYED = 5,   /* actor, target                   */
+    AX_LOGC_RELOAD_DONE      = 6,   /* actor, slot, rounds loaded      */
+    AX_LOGC_COUNT
+};
+
+struct ax_log_record {
+    uint64_t tick;
+    uint32_t code;              /* ax_log_code  */
+    uint32_t level;             /* ax_log_level */
+    uint64_t args[3];
+};
+
+/* Formats "[tick N] message" into buf (always terminated). */
+void ax_log_format(const ax_log_record& rec, char* buf, size_t cap);
+
+class ax_log {
+public:
+    static void default_params(ax_log_params_v1* out);
+
+    /* params must be valid; may throw bad_alloc (the ring) */
+    ax_log(const ax_alloc_state* alloc, ax_log_fn fn, void* user, const ax_log_params_v1& params);
+
+    /* stops the flusher, then delivers what is left */
+    ~ax_log();
+
+    ax_log(const ax_log&)            = delete;
+    ax_log& operator=(const ax_log&) = delete;
+
+    /* Starts the background flusher (BACKGROUND mode). False if the thread could not start. */
+    bool start_flusher();
+
+    /* ── Writer (thread driving the core) ── */
+
+    bool wants(uint32_t level) const { return level <= min_level_; }
+    /* Stale-action total the next end_tick counts from. */
+    void set_stale_baseline(uint64_t stale_total) { stale_seen_ = stale_total; }
+    void write(uint32_t level, uint32_t code, uint64_t tick,
+               uint64_t a0 = 0, uint64_t a1 = 0, uint64_t a2 = 0);
+
+    /*
+     * Turns a finished tick's events (fire blocked, kills, reloads) and
+     * any new stale actions (from the running stale_total) into records,
+     * then restarts the per-tick budgets. Out of line on purpose: the
+     * tick loop carries one untaken call, not a write per event.
+     */
+    void end_tick(uint64_t tick, const ax_snapshot_event_v1* events, uint32_t n, uint64_t stale_total);
+
+    /* ── Flushers (any thread) ── */
+
+    uint32_t flush();
+
+    /* ── Queries (not concurrent with the writer) ── */
+
+    void   stats(ax_log_stats_v1* out) const;
+    size_t reserved_bytes() const { return sizeof(*this) + ring_.slot_bytes(); }
+    size_t used_bytes() const {
+        return sizeof(*this) + (size_t)ring_.size_approx() * sizeof(ax_log_record);
+    }
+
+private:
+    void flusher_main();
+
+    ax_spsc_ring<ax_log_record> ring_;
+    ax_log_fn fn_;
+    void*     user_;
+    uint32_t  min_level_;
+    uint32_t  rate_[AX_LOG_LEVEL_COUNT];
+    uint32_t  interval_ms_;
+
+    /* writer side */
+    uint32_t  this_tick_[AX_LOG_LEVEL_COUNT];
+    uint64_t  stale_seen_;
+    uint64_t  written_[AX_LOG_LEVEL_COUNT];
+    uint64_t  rate_limited_[AX_LOG_LEVEL_COUNT];
+    uint64_t  dropped_full_;
+
+    /* flusher side */
+    std::mutex            flush_lock_;
+    std::atomic<uint64_t> delivered_;
+
+    /* background flusher */
+    std::thread             flusher_;
+    std::mutex              wake_lock_;
+    std::condition_variable wake_;
+    bool                    quit_;      /* guarded by wake_lock_ */
+};
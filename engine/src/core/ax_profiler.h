@@ -0,0 +1,307 @@
+/*
+ * ax_profiler.h — Per-phase tick profiler and trace recorder
+ *
+ * Scoped timers around the tick phases and the heavy ABI entry points.
+ * Each tick's phase times go into one record of a fixed ring (the ring
+ * is allocated when profiling is switched on, so ticks stay
+ * allocation-free); entry points accumulate count / total / max.
+ *
+ * The same scopes feed the trace recorder (ax_enable_tracing): every
+ * scope becomes one complete event (start + duration) in a per-thread
+ * buffer, plus one event per job chunk from the parallel phases.
+ *
+ * Two switches:
+ *   - AX_PROFILER (CMake AX_ENABLE_PROFILER, default on) compiles the
+ *     scopes in. With it off, AX_PROFILE_* / AX_TRACE_* expand to nothing.
+ *   - ax_set_profiling / ax_enable_tracing turn recording on at runtime.
+ *     While both are off, a scope costs one predictable branch and no
+ *     clock reads.
+ *
+ * Threading: profile scopes run only on the thread driving the core.
+ * Trace buffer w is written only by job worker w (0 = driving thread),
+ * so no buffer is shared while a tick runs; the job system's join and
+ * the async-step hand-off order those writes before any drain. Nothing
+ * here takes a lock or needs an atomic.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+#include "ax_alloc.h"
+#include "ax_clock.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifndef AX_PROFILER
+#define AX_PROFILER 1
+#endif
+
+class ax_profiler {
+public:
+    explicit ax_profiler(const ax_alloc_state* alloc)
+        : alloc_(alloc), ring_(ax_allocator<ax_profile_tick_v1>(alloc)),
+          traces_(ax_allocator<trace_buffer>(alloc)),
+          trace_capacity_(0), trace_origin_(0), enabled_(false), tracing_(false) {
+        reset();
+    }
+
+    ~ax_profiler() { stop_tracing(); }
+
+    ax_profiler(const ax_profiler&)            = delete;
+    ax_profiler& operator=(const ax_profiler&) = delete;
+
+    bool enabled() const { return enabled_; }
+    bool tracing() const { return tracing_; }
+    bool active() const  { return enabled_ || tracing_; }
+
+    /*
+     * Clears all records; the ring is held only while enabled. May throw
+     * bad_alloc (the ring), before anything is cleared.
+     */
+    void set_enabled(bool on) {
+        if (on) {
+            ring_.resize(AX_PROFILE_RING_TICKS);
+        }
+        reset();
+        if (!on) {
+            ring_.clear();
+            ring_.shrink_to_fit();
+        }
+        enabled_ = on;
+    }
+
+    void begin_tick(uint64_t tick) {
+        std::memset(&current_, 0, sizeof(current_));
+        current_.tick = tick;
+        tick_start_   = ax_clock_now_ns();
+    }
+
+    void end_tick() {
+        uint64_t end = ax_clock_now_ns();
+        if (tracing_) {
+            trace(0, AX_TRACE_TICK, tick_start_, end, current_.tick);
+        }
+        if (!enabled_) return;
+        current_.total_ns = end - tick_start_;
+        ring_[head_] = current_;
+        head_ = (head_ + 1) % AX_PROFILE_RING_TICKS;
+        if (count_ < AX_PROFILE_RING_TICKS) count_++;
+    }
+
+    void add_phase(uint32_t phase, uint64_t ns) { current_.phase_ns[phase] += ns; }
+
+    void add_call(uint32_t call, uint64_t ns) {
+        ax_profile_call_v1& c = calls_[call];
+        c.count++;
+        c.total_ns += ns;
+        if (ns > c.max_ns) c.max_ns = ns;
+    }
+
+    /* One phase (call = false) or entry-point scope on the driving thread. */
+    void record_scope(uint32_t index, bool call, uint64_t start, uint64_t end) {
+        if (enabled_) {
+            if (call) add_call(index, end - start);
+            else      add_phase(index, end - start);
+        }
+        if (tracing_) {
+            trace(0, (call ? AX_TRACE_CALL_BASE : AX_TRACE_PHASE_BASE) + index, start, end, 0);
+        }
+    }
+
+    /* Ring oldest-first into out->ticks; fills counts and call stats. */
+    void copy_out(ax_profile_v1* out) const {
+        out->enabled     = enabled_ ? 1 : 0;
+        out->phase_count = AX_PROFILE_PHASE_COUNT;
+        out->call_count  = AX_PROFILE_CALL_COUNT;
+        out->tick_count  = count_;
+        std::memcpy(out->calls, calls_, sizeof(calls_));
+        uint32_t first = (head_ + AX_PROFILE_RING_TICKS - count_) % AX_PROFILE_RING_TICKS;
+        for (uint32_t i = 0; i < count_; ++i) {
+            out->ticks[i] = ring_[(first + i) % AX_PROFILE_RING_TICKS];
+        }
+    }
+
+    /* ── Tracing ─────────────────────────────────────────────────── */
+
+    /*
+     * Starts a fresh trace with `threads` buffers of `capacity` events.
+     * False (and tracing off) when the buffers cannot be allocated.
+     */
+    bool start_tracing(uint32_t capacity, uint32_t threads) {
+        stop_tracing();
+        trace_capacity_ = capacity;
+        trace_origin_   = ax_clock_now_ns();
+        tracing_        = true;
+        return ensure_trace_threads(threads);
+    }
+
+    void stop_tracing() {
+        for (trace_buffer& b : traces_) {
+            alloc_->deallocate(b.events, (size_t)trace_capacity_ * sizeof(ax_trace_event_v1),
+                               alignof(ax_trace_event_v1));
+        }
+        traces_.clear();
+        traces_.shrink_to_fit();
+        tracing_ = false;
+    }
+
+    /*
+     * Grows to one buffer per job worker (worker count changed). On
+     * allocation failure tracing stops rather than leave a worker
+     * without a buffer.
+     */
+    bool ensure_trace_threads(uint32_t threads) {
+        if (!tracing_) return true;
+        try {
+            traces_.reserve(threads);
+            while (traces_.size() < threads) {
+                void* p = alloc_->allocate((size_t)trace_capacity_ * sizeof(ax_trace_event_v1),
+                                           alignof(ax_trace_event_v1));
+                if (!p) throw std::bad_alloc();
+                traces_.push_back({ static_cast<ax_trace_event_v1*>(p), 0, 0 });
+            }
+        } catch (const std::bad_alloc&) {
+            stop_tracing();
+            return false;
+        }
+        return true;
+    }
+
+    /* Thread `thread` only. A full buffer drops the event and counts it. */
+    void trace(uint32_t thread, uint32_t name, uint64_t start, uint64_t end, uint64_t arg) {
+        trace_buffer& b = traces_[thread];
+        if (b.count == trace_capacity_) {
+            b.dropped++;
+            return;
+        }
+        ax_trace_event_v1& e = b.events[b.count++];
+        e.start_ns    = start - trace_origin_;
+        e.duration_ns = end - start;
+        e.name        = name;
+        e.thread      = thread;
+        e.arg         = arg;
+    }
+
+    uint32_t trace_pending() const {
+        uint32_t n = 0;
+        for (const trace_buffer& b : traces_) n += b.count;
+        return n;
+    }
+
+    /* Copies every buffered event (thread by thread) and empties the buffers. */
+    uint64_t drain_trace(ax_trace_event_v1* out) {
+        uint64_t dropped = 0;
+        for (trace_buffer& b : traces_) {
+            std::memcpy(out, b.events, (size_t)b.count * sizeof(ax_trace_event_v1));
+            out      += b.count;
+            dropped  += b.dropped;
+            b.count   = 0;
+            b.dropped = 0;
+        }
+        return dropped;
+    }
+
+    size_t reserved_bytes() const {
+        return ring_.capacity() * sizeof(ax_profile_tick_v1)
+             + traces_.capacity() * sizeof(trace_buffer)
+             + traces_.size() * (size_t)trace_capacity_ * sizeof(ax_trace_event_v1);
+    }
+    size_t used_bytes() const {
+        return ring_.size() * sizeof(ax_profile_tick_v1)
+             + traces_.size() * sizeof(trace_buffer)
+             + (size_t)trace_pending() * sizeof(ax_trace_event_v1);
+    }
+
+private:
+    struct trace_buffer {
+        ax_trace_event_v1* events;      /* trace_capacity_ entries, on alloc_ */
+        uint32_t           count;
+        uint64_t           dropped;     /* since the last drain */
+    };
+
+    void reset() {
+        std::memset(&current_, 0, sizeof(current_));
+        std::memset(calls_, 0, sizeof(calls_));
+        head_       = 0;
+        count_      = 0;
+        tick_start_ = 0;
+    }
+
+    const ax_alloc_state*         alloc_;
+    ax_vector<ax_profile_tick_v1> ring_;
+    ax_profile_tick_v1            current_;
+    ax_profile_call_v1            calls_[AX_PROFILE_MAX_CALLS];
+    uint32_t                      head_;        /* next ring slot to write */
+    uint32_t                      count_;       /* valid records           */
+    uint64_t                      tick_start_;
+    ax_vector<trace_buffer>       traces_;      /* one per job worker */
+    uint32_t                      trace_capacity_;
+    uint64_t                      trace_origin_;
+    bool                          enabled_;
+    bool                          tracing_;
+};
+
+/*
+ * Adds the scope's duration to a phase (call = false) or an entry point
+ * (true), and traces it on the driving thread.
+ */
+class ax_profile_scope {
+public:
+    ax_profile_scope(ax_profiler* p, uint32_t index, bool call)
+        : p_(p && p->active() ? p : nullptr), index_(index), call_(call),
+          start_(p_ ? ax_clock_now_ns() : 0) {}
+
+    ~ax_profile_scope() {
+        if (p_) p_->record_scope(index_, call_, start_, ax_clock_now_ns());
+    }
+
+    ax_profile_scope(const ax_profile_scope&)            = delete;
+    ax_profile_scope& operator=(const ax_profile_scope&) = delete;
+
+private:
+    ax_profiler* p_;
+    uint32_t     index_;
+    bool         call_;
+    uint64_t     start_;
+};
+
+/* Trace-only scope for a job chunk on worker `thread`; arg = items. */
+class ax_trace_scope {
+public:
+    ax_trace_scope(ax_profiler* p, uint32_t thread, uint32_t name, uint64_t arg)
+        : p_(p->tracing() ? p : nullptr), thread_(thread), name_(name), arg_(arg),
+          start_(p_ ? ax_clock_now_ns() : 0) {}
+
+    ~ax_trace_scope() {
+        if (p_) p_->trace(thread_, name_, start_, ax_clock_now_ns(), arg_);
+    }
+
+    ax_trace_scope(const ax_trace_scope&)            = delete;
+    ax_trace_scope& operator=(const ax_trace_scope&) = delete;
+
+private:
+    ax_profiler* p_;
+    uint32_t     thread_;
+    uint32_t     name_;
+    uint64_t     arg_;
+    uint64_t     start_;
+};
+
+#define AX_PROFILE_CONCAT_(a, b) a##b
+#define AX_PROFILE_CONCAT(a, b)  AX_PROFILE_CONCAT_(a, b)
+
+#if AX_PROFILER
+  /* profiler may be NULL (e.g. an ABI call with a NULL core) */
+  #define AX_PROFILE_PHASE(profiler, phase) \
+      ax_profile_scope AX_PROFILE_CONCAT(ax_profile_scope_, __LINE__)((profiler), (phase), false)
+  #define AX_PROFILE_CALL(profiler, call) \
+      ax_profile_scope AX_PROFILE_CONCAT(ax_profile_scope_, __LINE__)((profiler), (call), true)
+  #define AX_TRACE_JOB(profiler, worker, name, items) \
+      ax_trace_scope AX_PROFILE_CONCAT(ax_trace_scope_, __LINE__)((profiler), (worker), (name), (items))
+#else
+  #define AX_PROFILE_PHASE(profiler, phase)         ((void)0)
+  #define AX_PROFILE_CALL(profiler, call)           ((void)0)
+  #define AX_TRACE_JOB(profiler, worker, name, items) ((void)0)
+#endif
@@ -0,0 +1,67 @@
+/*
+ * ax_rng.h — Counter-based deterministic RNG (Philox4x32-10)
+ *
+ * Every random word is a pure function of (world seed, system id,
+ * entity id, tick, draw index): there is no generator state to advance,
+ * so any entity's draws can be computed on any worker, in any order or
+ * batching, and a save needs to carry only the seed. Philox4x32-10
+ * (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3") maps a
+ * 128-bit counter and a 64-bit key to four 32-bit words:
+ *
+ *   key     = world seed (lo, hi)
+ *   counter = { entity id, draw block << 16 | system id, tick lo, tick hi }
+ *
+ * Draw d of an entity is word d % 4 of block d / 4, so one counter
+ * covers four draws and a (system, entity, tick) has AX_RNG_MAX_DRAWS.
+ * Only 32-bit multiplies, xors and adds: the words are identical on
+ * every platform and compiler.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+
+struct ax_rng_stream {
+    uint64_t seed;
+    uint32_t system_id;     /* < AX_RNG_MAX_SYSTEMS */
+    uint64_t tick;
+};
+
+/* One Philox4x32-10 block: ctr is replaced by the output words. */
+inline void ax_philox4x32_10(uint32_t ctr[4], uint32_t k0, uint32_t k1) {
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = (uint64_t)0xD2511F53u * ctr[0];
+        uint64_t p1 = (uint64_t)0xCD9E8D57u * ctr[2];
+        uint32_t c1 = ctr[1], c3 = ctr[3];
+        ctr[0] = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        ctr[1] = (uint32_t)p1;
+        ctr[2] = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        ctr[3] = (uint32_t)p0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
+
+/* Draw `draw` (< AX_RNG_MAX_DRAWS) of `entity_id` in `s`. */
+inline uint32_t ax_rng_u32(const ax_rng_stream& s, uint32_t entity_id, uint32_t draw) {
+    uint32_t ctr[4] = { entity_id, ((draw >> 2) << 16) | s.system_id,
+                        (uint32_t)s.tick, (uint32_t)(s.tick >> 32) };
+    ax_philox4x32_10(ctr, (uint32_t)s.seed, (uint32_t)(s.seed >> 32));
+    return ctr[draw & 3];
+}
+
+/* [0, 1) from the top 24 bits: exact, no rounding up to 1.0f */
+inline float ax_rng_unit(uint32_t word) {
+    return (float)(word >> 8) * (1.0f / 16777216.0f);
+}
+
+/*
+ * Draws [first_draw, first_draw + draws) for each of `count` entities,
+ * entity-major: out[i * draws + k] == ax_rng_u32(s, entity_ids[i],
+ * first_draw + k). Blocks of entities are generated side by side so
+ * the rounds vectorize. first_draw + draws <= AX_RNG_MAX_DRAWS.
+ */
+void ax_rng_fill(const ax_rng_stream& s, const uint32_t* entity_ids, uint32_t count,
+                 uint32_t first_draw, uint32_t draws, uint32_t* out);
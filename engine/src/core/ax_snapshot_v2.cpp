@@ -0,0 +1,373 @@
+/*
+ * ax_snapshot_v2.cpp — Compact (v2) snapshot encoding
+ */
+
+#include "ax_snapshot_v2.h"
+
+#include <cmath>
+#include <cstring>
+
+/* smallest-three: the three kept components lie in [-1/sqrt2, 1/sqrt2] */
+static const float ROT_RANGE = 0.70710678f;
+static const float ROT_STEPS = 1023.0f;     /* 10 bits */
+
+static const uint8_t ENT_HP_PRESENT = 0x80;
+static const uint8_t ENT_FLAG_MASK  = 0x7F;   /* state_flags bits 0..6 */
+
+/* smallest encoded records: one-byte varints, rotation and progress as u32 */
+static const uint64_t ENT_MIN_BYTES    = 10;  /* bits, id, archetype, x y z, rotation */
+static const uint64_t EVT_MIN_BYTES    = 4;   /* type, a, b, value                    */
+static const uint64_t WEAPON_MIN_BYTES = 9;   /* owner, slot, flags, ammo x2, progress */
+
+/* ── Rotation ─────────────────────────────────────────────────────── */
+
+uint32_t ax_snapshot_v2_pack_rotation(float x, float y, float z, float w) {
+    float c[4] = { x, y, z, w };
+    float n2 = x * x + y * y + z * z + w * w;
+    if (!(n2 > 1e-24f) || !(n2 < 3.0e38f)) {
+        c[0] = 0.0f;  c[1] = 0.0f;  c[2] = 0.0f;  c[3] = 1.0f;   /* identity */
+        n2 = 1.0f;
+    }
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) largest = i;
+    }
+    /* q and -q are the same rotation: make the dropped component positive */
+    float sign  = c[largest] < 0.0f ? -1.0f : 1.0f;
+    float scale = sign / (std::sqrt(n2) * ROT_RANGE);
+
+    uint32_t packed = largest << 30;
+    uint32_t shift  = 20;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float v = c[i] * scale;
+        v = v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+        uint32_t q = (uint32_t)((v * 0.5f + 0.5f) * ROT_STEPS + 0.5f);   /* >= 0: truncation rounds */
+        packed |= q << shift;
+        shift  -= 10;
+    }
+    return packed;
+}
+
+void ax_snapshot_v2_unpack_rotation(uint32_t packed, float* x, float* y, float* z, float* w) {
+    uint32_t largest = packed >> 30;
+    float    c[4];
+    float    sum   = 0.0f;
+    uint32_t shift = 20;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        uint32_t q = (packed >> shift) & 0x3FF;
+        c[i] = ((float)q / ROT_STEPS * 2.0f - 1.0f) * ROT_RANGE;
+        sum += c[i] * c[i];
+        shift -= 10;
+    }
+    c[largest] = sum < 1.0f ? std::sqrt(1.0f - sum) : 0.0f;
+    *x = c[0];  *y = c[1];  *z = c[2];  *w = c[3];
+}
+
+/* ── Writer ───────────────────────────────────────────────────────── */
+
+ax_snapshot_v2_writer::ax_snapshot_v2_writer(uint8_t* dst, float position_grid_m)
+    : dst_(dst), size_((uint32_t)sizeof(ax_snapshot_header_v2)),
+      inv_grid_(1.0 / (double)position_grid_m), grid_(position_grid_m), prev_id_(0),
+      prev_owner_(0) {}
+
+void ax_snapshot_v2_writer::put_u8(uint8_t v) {
+    if (dst_) dst_[size_] = v;
+    size_ += 1;
+}
+
+void ax_snapshot_v2_writer::put_u32(uint32_t v) {
+    if (dst_) std::memcpy(dst_ + size_, &v, 4);
+    size_ += 4;
+}
+
+void ax_snapshot_v2_writer::put_varint(uint64_t v) {
+    while (v >= 0x80) {
+        put_u8((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    put_u8((uint8_t)v);
+}
+
+void ax_snapshot_v2_writer::put_zigzag(int64_t v) {
+    put_varint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+/* round half away from zero, clamped to int32 */
+static int64_t quantize(float p, double inv_grid) {
+    double q = (double)p * inv_grid;
+    if (!(q >= (double)INT32_MIN)) return INT32_MIN;   /* also catches NaN */
+    if (q > (double)INT32_MAX)     return INT32_MAX;
+    return (int64_t)(q < 0.0 ? q - 0.5 : q + 0.5);
+}
+
+void ax_snapshot_v2_writer::weapon(const ax_snapshot_player_weapon_v1& w) {
+    if (dst_) std::memcpy(dst_ + size_, &w, sizeof(w));
+    size_ += (uint32_t)sizeof(w);
+}
+
+void ax_snapshot_v2_writer::weapon_count(uint32_t count) {
+    put_u32(count);
+}
+
+void ax_snapshot_v2_writer::entity(const ax_snapshot_entity_v1& e) {
+    bool has_hp = e.hp != -1;
+    put_u8((uint8_t)((e.state_flags & ENT_FLAG_MASK) | (has_hp ? ENT_HP_PRESENT : 0)));
+    put_zigzag((int64_t)e.id - (int64_t)prev_id_);
+    prev_id_ = e.id;
+    put_varint(e.archetype_id);
+    put_zigzag(quantize(e.px, inv_grid_));
+    put_zigzag(quantize(e.py, inv_grid_));
+    put_zigzag(quantize(e.pz, inv_grid_));
+    put_u32(dst_ ? ax_snapshot_v2_pack_rotation(e.rx, e.ry, e.rz, e.rw) : 0);   /* fixed width */
+    if (has_hp) {
+        put_zigzag(e.hp);
+    }
+}
+
+void ax_snapshot_v2_writer::event(const ax_snapshot_event_v1& e) {
+    put_varint(e.type);
+    put_varint(e.a);
+    put_varint(e.b);
+    put_zigzag(e.value);
+}
+
+void ax_snapshot_v2_writer::table_weapon(const ax_snapshot_player_weapon_v1& w) {
+    uint32_t progress;
+    std::memcpy(&progress, &w.reload_progress, 4);
+    put_zigzag((int64_t)w.player_id - (int64_t)prev_owner_);
+    prev_owner_ = w.player_id;
+    put_varint(w.weapon_slot);
+    put_varint(w.weapon_flags);
+    put_zigzag(w.ammo_in_mag);
+    put_zigzag(w.ammo_reserve);
+    put_u32(progress);
+}
+
+uint32_t ax_snapshot_v2_writer::finish(uint64_t tick, uint32_t entity_count,
+                                       uint32_t event_count, bool has_weapon, bool has_table) {
+    if (dst_) {
+        ax_snapshot_header_v2 hdr = {};
+        hdr.version         = 2;
+        hdr.reserved        = 0;
+        hdr.size_bytes      = size_;
+        hdr.tick            = tick;
+        hdr.entity_count    = entity_count;
+        hdr.event_count     = event_count;
+        hdr.position_grid_m = grid_;
+        hdr.flags           = (has_weapon ? AX_SNAPSHOT_V2_WEAPON : 0)
+                            | (has_table ? AX_SNAPSHOT_V2_WEAPONS : 0);
+        std::memcpy(dst_, &hdr, sizeof(hdr));
+    }
+    return size_;
+}
+
+/* ── Decoder ──────────────────────────────────────────────────────── */
+
+namespace {
+
+struct reader {
+    const uint8_t* src;
+    uint32_t       size;
+    uint32_t       pos;
+    bool           ok;
+
+    uint8_t u8() {
+        if (pos >= size) { ok = false; return 0; }
+        return src[pos++];
+    }
+
+    uint32_t u32() {
+        if (size - pos < 4) { ok = false; pos = size; return 0; }
+        uint32_t v;
+        std::memcpy(&v, src + pos, 4);
+        pos += 4;
+        return v;
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t b = u8();
+            if (!ok) return 0;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;     /* more than 10 bytes */
+        return 0;
+    }
+
+    uint32_t varint32() {
+        uint64_t v = varint();
+        if (v > UINT32_MAX) ok = false;
+        return (uint32_t)v;
+    }
+
+    int64_t zigzag() {
+        uint64_t v = varint();
+        return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+    }
+};
+
+}  // namespace
+
+ax_result ax_snapshot_v2_decode(const uint8_t* src, uint32_t size,
+                                uint8_t* dst, uint32_t cap, uint32_t* out_v1_size,
+                                const char** out_error) {
+    ax_snapshot_header_v2 h2;
+    if (size < sizeof(h2)) {
+        *out_error = "buffer too small for header";
+        return AX_ERR_INVALID_ARG;
+    }
+    std::memcpy(&h2, src, sizeof(h2));
+    if (h2.version != 2) {
+        *out_error = "not a v2 snapshot";
+        return AX_ERR_UNSUPPORTED;
+    }
+    if (h2.size_bytes != size) {
+        *out_error = "size_bytes does not match buffer size";
+        return AX_ERR_INVALID_ARG;
+    }
+    if (!(h2.position_grid_m > 0.0f) || !std::isfinite(h2.position_grid_m)) {
+        *out_error = "bad position grid";
+        return AX_ERR_INVALID_ARG;
+    }
+
+    bool     has_weapon = (h2.flags & AX_SNAPSHOT_V2_WEAPON) != 0;
+    bool     has_table  = (h2.flags & AX_SNAPSHOT_V2_WEAPONS) != 0;
+    uint32_t count_at   = (uint32_t)sizeof(h2) + (has_weapon ? (uint32_t)sizeof(ax_snapshot_player_weapon_v1) : 0);
+
+    /* the table's count sits at a fixed offset, so the v1 size is known up front */
+    uint32_t weapon_count = 0;
+    if (has_table) {
+        if (size < count_at + 4) {
+            *out_error = "truncated weapon count";
+            return AX_ERR_INVALID_ARG;
+        }
+        std::memcpy(&weapon_count, src + count_at, 4);
+    }
+
+    /*
+     * Counts come from the blob: a few header bytes must not be able to
+     * ask for gigabytes. Every record takes at least its minimum size,
+     * so counts the payload cannot hold are rejected before any size is
+     * reported.
+     */
+    uint64_t records_at = (uint64_t)count_at + (has_table ? 4 : 0);
+    uint64_t min_bytes  = (uint64_t)h2.entity_count * ENT_MIN_BYTES
+                        + (uint64_t)h2.event_count * EVT_MIN_BYTES
+                        + (uint64_t)weapon_count * WEAPON_MIN_BYTES;
+    if (records_at + min_bytes > size) {
+        *out_error = "truncated records: entity/event/weapon counts exceed the blob";
+        return AX_ERR_INVALID_ARG;
+    }
+
+    uint64_t total = sizeof(ax_snapshot_header_v1)
+                   + (uint64_t)h2.entity_count * sizeof(ax_snapshot_entity_v1)
+                   + (has_weapon ? sizeof(ax_snapshot_player_weapon_v1) : 0)
+                   + (uint64_t)h2.event_count * sizeof(ax_snapshot_event_v1)
+                   + (has_table ? sizeof(ax_snapshot_weapon_table_v1) : 0)
+                   + (uint64_t)weapon_count * sizeof(ax_snapshot_player_weapon_v1);
+    if (total > UINT32_MAX) {
+        *out_error = "entity/event/weapon counts too large";
+        return AX_ERR_INVALID_ARG;
+    }
+    *out_v1_size = (uint32_t)total;
+    if (!dst) {
+        return AX_OK;
+    }
+    if (cap < total) {
+        *out_error = "buffer too small";
+        return AX_ERR_BUFFER_TOO_SMALL;
+    }
+
+    reader in = { src, size, (uint32_t)sizeof(h2), true };
+
+    ax_snapshot_header_v1 h1 = {};
+    h1.version               = 1;
+    h1.size_bytes            = (uint32_t)total;
+    h1.tick                  = h2.tick;
+    h1.entity_count          = h2.entity_count;
+    h1.entity_stride_bytes   = (uint32_t)sizeof(ax_snapshot_entity_v1);
+    h1.event_count           = h2.event_count;
+    h1.event_stride_bytes    = (uint32_t)sizeof(ax_snapshot_event_v1);
+    h1.flags                 = has_table ? AX_SNAPSHOT_FLAG_WEAPONS : 0;
+    h1.player_weapon_present = has_weapon ? 1 : 0;
+    std::memcpy(dst, &h1, sizeof(h1));
+
+    uint32_t entities_at = (uint32_t)sizeof(h1);
+    uint32_t weapon_at   = entities_at + h2.entity_count * (uint32_t)sizeof(ax_snapshot_entity_v1);
+    uint32_t events_at   = weapon_at + (has_weapon ? (uint32_t)sizeof(ax_snapshot_player_weapon_v1) : 0);
+    uint32_t table_at    = events_at + h2.event_count * (uint32_t)sizeof(ax_snapshot_event_v1);
+
+    /* weapon record is stored verbatim, ahead of the entities */
+    if (has_weapon) {
+        if (size - in.pos < sizeof(ax_snapshot_player_weapon_v1)) {
+            *out_error = "truncated weapon record";
+            return AX_ERR_INVALID_ARG;
+        }
+        std::memcpy(dst + weapon_at, src + in.pos, sizeof(ax_snapshot_player_weapon_v1));
+        in.pos += (uint32_t)sizeof(ax_snapshot_player_weapon_v1);
+    }
+    if (has_table) {
+        in.pos += 4;    /* weapon_count, read above */
+    }
+
+    const double grid = h2.position_grid_m;
+    uint32_t prev_id = 0;
+    for (uint32_t i = 0; i < h2.entity_count && in.ok; ++i) {
+        ax_snapshot_entity_v1 e = {};
+        uint8_t bits = in.u8();
+        e.state_flags = bits & ENT_FLAG_MASK;
+        e.id          = (uint32_t)((int64_t)prev_id + in.zigzag());
+        prev_id       = e.id;
+        e.archetype_id = in.varint32();
+        e.px = (float)((double)in.zigzag() * grid);
+        e.py = (float)((double)in.zigzag() * grid);
+        e.pz = (float)((double)in.zigzag() * grid);
+        ax_snapshot_v2_unpack_rotation(in.u32(), &e.rx, &e.ry, &e.rz, &e.rw);
+        e.hp = (bits & ENT_HP_PRESENT) ? (int32_t)in.zigzag() : -1;
+        std::memcpy(dst + entities_at + i * sizeof(e), &e, sizeof(e));
+    }
+
+    for (uint32_t i = 0; i < h2.event_count && in.ok; ++i) {
+        ax_snapshot_event_v1 e = {};
+        e.type  = in.varint32();
+        e.a     = in.varint32();
+        e.b     = in.varint32();
+        e.value = (int32_t)in.zigzag();
+        std::memcpy(dst + events_at + i * sizeof(e), &e, sizeof(e));
+    }
+
+    if (has_table) {
+        ax_snapshot_weapon_table_v1 t = {};
+        t.weapon_count        = weapon_count;
+        t.weapon_stride_bytes = (uint32_t)sizeof(ax_snapshot_player_weapon_v1);
+        std::memcpy(dst + table_at, &t, sizeof(t));
+    }
+    uint32_t prev_owner = 0;
+    for (uint32_t i = 0; i < weapon_count && in.ok; ++i) {
+        ax_snapshot_player_weapon_v1 w = {};
+        w.player_id    = (uint32_t)((int64_t)prev_owner + in.zigzag());
+        prev_owner     = w.player_id;
+        w.weapon_slot  = in.varint32();
+        w.weapon_flags = in.varint32();
+        w.ammo_in_mag  = (int32_t)in.zigzag();
+        w.ammo_reserve = (int32_t)in.zigzag();
+        uint32_t progress = in.u32();
+        std::memcpy(&w.reload_progress, &progress, 4);
+        std::memcpy(dst + table_at + sizeof(ax_snapshot_weapon_table_v1) + i * sizeof(w), &w, sizeof(w));
+    }
+
+    if (!in.ok) {
+        *out_error = "truncated or malformed record";
+        return AX_ERR_INVALID_ARG;
+    }
+    if (in.pos != size) {
+        *out_error = "trailing bytes after last record";
+        return AX_ERR_INVALID_ARG;
+    }
+    return AX_OK;
+}
@@ -0,0 +1,60 @@
+/*
+ * ax_snapshot_v2.h — Compact (v2) snapshot encoding
+ *
+ * Byte layout is documented with ax_snapshot_header_v2 in ax_abi.h.
+ * Encoding runs twice per snapshot: once with a NULL destination to
+ * size the blob (varints make the size data-dependent), then for real.
+ * Neither pass allocates.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+
+class ax_snapshot_v2_writer {
+public:
+    /* dst NULL = measure only. Space for the header is reserved up front. */
+    ax_snapshot_v2_writer(uint8_t* dst, float position_grid_m);
+
+    /* in blob order: weapon, weapon_count, entities, events, table weapons */
+    void weapon(const ax_snapshot_player_weapon_v1& w);
+    void weapon_count(uint32_t count);
+    void entity(const ax_snapshot_entity_v1& e);
+    void event(const ax_snapshot_event_v1& e);
+    void table_weapon(const ax_snapshot_player_weapon_v1& w);
+
+    /* Writes the header (no-op when measuring); returns the blob size. */
+    uint32_t finish(uint64_t tick, uint32_t entity_count, uint32_t event_count,
+                    bool has_weapon, bool has_table);
+
+    uint32_t size() const { return size_; }
+
+private:
+    void put_u8(uint8_t v);
+    void put_u32(uint32_t v);
+    void put_varint(uint64_t v);
+    void put_zigzag(int64_t v);
+
+    uint8_t* dst_;
+    uint32_t size_;
+    double   inv_grid_;
+    float    grid_;
+    uint32_t prev_id_;
+    uint32_t prev_owner_;
+};
+
+/* Smallest-three quaternion packing (2-bit index + 3 x 10 bits). */
+uint32_t ax_snapshot_v2_pack_rotation(float x, float y, float z, float w);
+void     ax_snapshot_v2_unpack_rotation(uint32_t packed, float* x, float* y, float* z, float* w);
+
+/*
+ * Expands a v2 blob into the v1 layout. dst NULL = size query
+ * (*out_v1_size is written once the header is valid). On failure
+ * *out_error gets a static description; dst contents are then
+ * unspecified.
+ */
+ax_result ax_snapshot_v2_decode(const uint8_t* src, uint32_t size,
+                                uint8_t* dst, uint32_t cap, uint32_t* out_v1_size,
+                                const char** out_error);
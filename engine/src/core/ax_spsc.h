@@ -0,0 +1,87 @@
+/*
+ * ax_spsc.h — Bounded single-producer/single-consumer ring
+ *
+ * Lock-free and wait-free for exactly one producer thread and one
+ * consumer thread. Each side owns one index and keeps a cached copy of
+ * the other, so a push or pop normally touches no shared cache line
+ * except its own slot.
+ *
+ * The consumer role may move between threads (e.g. to the async step
+ * thread) as long as the hand-off itself is a happens-before edge.
+ */
+
+#pragma once
+
+#include "ax_alloc.h"
+
+#include <atomic>
+#include <cstdint>
+
+template <class T>
+class ax_spsc_ring {
+public:
+    /* capacity is rounded up to a power of two (minimum 2) */
+    ax_spsc_ring(const ax_alloc_state* alloc, uint32_t capacity)
+        : slots_(ax_allocator<T>(alloc)),
+          head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+        uint32_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        slots_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    ax_spsc_ring(const ax_spsc_ring&)            = delete;
+    ax_spsc_ring& operator=(const ax_spsc_ring&) = delete;
+
+    uint32_t capacity() const { return mask_ + 1; }
+
+    /* Either side; exact only while the other side is idle. */
+    uint32_t size_approx() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /* heap held by the slot array (not the ring object itself) */
+    size_t slot_bytes() const { return slots_.capacity() * sizeof(T); }
+
+    /* Producer only. Queues all n items or none; false when they don't fit. */
+    bool try_push(const T* items, uint32_t n) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (capacity() - (head - cached_tail_) < n) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (capacity() - (head - cached_tail_) < n) {
+                return false;
+            }
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            slots_[(head + i) & mask_] = items[i];
+        }
+        head_.store(head + n, std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer only. */
+    bool try_pop(T* out) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return false;
+            }
+        }
+        *out = slots_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    ax_vector<T>   slots_;
+    uint32_t       mask_;
+
+    /* producer side */
+    alignas(64) std::atomic<uint32_t> head_;   /* next slot to write */
+    uint32_t                          cached_tail_;
+
+    /* consumer side */
+    alignas(64) std::atomic<uint32_t> tail_;   /* next slot to read  */
+    uint32_t                          cached_head_;
+};
@@ -0,0 +1,130 @@
+/*
+ * ax_stats.h — Always-on runtime counters and latency histograms
+ *
+ * The core keeps one ax_stats_v1 by value and bumps it in place: plain
+ * adds on the thread driving the core, no allocation. Ticks and ABI
+ * calls are never concurrent with a stats query (the async step rejects
+ * other calls while in flight), so nothing here is atomic.
+ *
+ * The histograms are filled only while timing is on (set_timing, off by
+ * default): the counters are plain adds, but a clock read is not free
+ * and a hot loop of small calls would pay for it on every call.
+ * Timestamps come from the cycle counter (ax_clock.h). Each timed entry
+ * point reads it on entry and exit, and an active profiler reuses those
+ * reads for its call record and trace. A step reads it once more per
+ * tick: each tick's end is the next one's start, and the last tick's
+ * end closes the call, so a one-tick step costs the same two reads.
+ *
+ * Histogram buckets are log-linear with SUB_BITS = 2: values below 4
+ * get one bucket each, then each power of two [2^e, 2^(e+1)) is split
+ * into four equal sub-buckets. Bucket of v (e = floor(log2 v), e >= 2):
+ *
+ *   (e - 1) * 4 + ((v >> (e - 2)) & 3)
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+#include "ax_clock.h"
+#include "ax_profiler.h"     /* call records */
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+static_assert(AX_PROFILE_CALL_COUNT <= AX_STATS_MAX_CALLS, "stats call table too small");
+
+inline uint32_t ax_stats_bucket(uint64_t v) {
+    if (v < 4) return (uint32_t)v;
+    uint32_t e = (uint32_t)std::bit_width(v) - 1;
+    uint32_t b = (e - 1) * 4 + (uint32_t)((v >> (e - 2)) & 3);
+    return b < AX_STATS_HIST_BUCKETS ? b : AX_STATS_HIST_BUCKETS - 1;
+}
+
+inline void ax_histogram_record(ax_histogram_v1* h, uint64_t ns) {
+    if (h->count == 0 || ns < h->min_ns) h->min_ns = ns;
+    if (ns > h->max_ns) h->max_ns = ns;
+    h->count++;
+    h->total_ns += ns;
+    h->buckets[ax_stats_bucket(ns)]++;
+}
+
+/*
+ * One phase's events by type and fire-blocked reason, counted where they
+ * are emitted and added to the stats once. Emit sites index with
+ * constants, so a local tally stays in registers: an increment in
+ * memory per event would serialize on its counter.
+ */
+struct ax_event_tally {
+    uint32_t events[AX_STATS_MAX_EVENT_TYPES]         = {};
+    uint32_t fire_blocked[AX_STATS_MAX_BLOCK_REASONS] = {};
+};
+
+class ax_stats {
+public:
+    ax_stats() { reset(); }
+
+    /* Zeroes the counters and histograms; timing stays as it was. */
+    void reset() {
+        std::memset(&s_, 0, sizeof(s_));
+        s_.version    = 1;
+        s_.size_bytes = (uint32_t)sizeof(ax_stats_v1);
+        s_.call_count = AX_PROFILE_CALL_COUNT;
+    }
+
+    bool timing() const      { return timing_; }
+    void set_timing(bool on) { timing_ = on; }
+
+    ax_stats_v1&       data()       { return s_; }
+    const ax_stats_v1& data() const { return s_; }
+
+    void record_call(uint32_t call, uint64_t ns) { ax_histogram_record(&s_.calls[call], ns); }
+
+    void add_events(const ax_event_tally& t) {
+        for (uint32_t i = 0; i < AX_STATS_MAX_EVENT_TYPES; ++i)   s_.events[i]       += t.events[i];
+        for (uint32_t i = 0; i < AX_STATS_MAX_BLOCK_REASONS; ++i) s_.fire_blocked[i] += t.fire_blocked[i];
+    }
+
+private:
+    ax_stats_v1 s_;
+    bool        timing_ = false;
+};
+
+/*
+ * Records the scope's duration into one entry point's histogram while
+ * stats timing is on, and into the profiler's call record and trace
+ * while it is active. With neither, it never reads the clock.
+ */
+class ax_stats_call_scope {
+public:
+    ax_stats_call_scope(ax_profiler* profiler, ax_stats* stats, uint32_t call)
+        : profiler_(AX_PROFILER && profiler->active() ? profiler : nullptr),
+          stats_(stats->timing() ? stats : nullptr), call_(call),
+          start_(timed() ? ax_clock_now_ns() : 0), end_(0) {}
+
+    ~ax_stats_call_scope() {
+        if (!timed()) return;
+        uint64_t end = end_ ? end_ : ax_clock_now_ns();
+        if (stats_)    stats_->record_call(call_, end - start_);
+        if (profiler_) profiler_->record_scope(call_, true, start_, end);
+    }
+
+    /* Lets a caller that already read the clock reuse its reads. */
+    bool     timed() const     { return profiler_ || stats_; }
+    uint64_t start() const     { return start_; }     /* 0 unless timed() */
+    void     end_at(uint64_t t) { end_ = t; }
+
+    ax_stats_call_scope(const ax_stats_call_scope&)            = delete;
+    ax_stats_call_scope& operator=(const ax_stats_call_scope&) = delete;
+
+private:
+    ax_profiler* profiler_;     /* NULL unless profiling or tracing */
+    ax_stats*    stats_;        /* NULL unless stats timing is on */
+    uint32_t     call_;
+    uint64_t     start_;
+    uint64_t     end_;          /* 0 = read the clock on exit */
+};
+
+/* Times an entry point for the stats and, if active, the profiler. */
+#define AX_STATS_CALL(profiler, stats, call) \
+    ax_stats_call_scope AX_PROFILE_CONCAT(ax_stats_scope_, __LINE__)((profiler), (stats), (call))
@@ -0,0 +1,673 @@
+/*
+ * ax_bvh.cpp — Static triangle collision world (SAH bounding volume hierarchy)
+ */
+
+#include "ax_bvh.h"
+#include "core/ax_jobs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/* ── Build ────────────────────────────────────────────────────────── */
+
+/* items per range when a large node's passes are spread over the workers */
+static const uint32_t BUILD_GRAIN = 16384;
+
+static const uint32_t NO_NODE = UINT32_MAX;
+
+struct bvh_prim {
+    float min[3], max[3];
+    float c[3];                 /* centroid */
+};
+
+struct bvh_build_node {
+    float    min[3], max[3];
+    uint32_t left, right;       /* build-array indices, NO_NODE for a leaf */
+    uint32_t start, count;      /* range of the order array                */
+    uint32_t axis;
+};
+
+struct bvh_box {
+    float min[3], max[3];
+
+    void reset() {
+        for (int a = 0; a < 3; ++a) {
+            min[a] = INFINITY;
+            max[a] = -INFINITY;
+        }
+    }
+    void grow(const float lo[3], const float hi[3]) {
+        for (int a = 0; a < 3; ++a) {
+            min[a] = lo[a] < min[a] ? lo[a] : min[a];
+            max[a] = hi[a] > max[a] ? hi[a] : max[a];
+        }
+    }
+    float area() const {
+        float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+        return (x < 0.0f) ? 0.0f : x * y + y * z + z * x;
+    }
+};
+
+/* node bounds and centroid bounds of a range */
+struct bvh_bounds {
+    bvh_box node, centroid;
+
+    void reset() {
+        node.reset();
+        centroid.reset();
+    }
+    void merge(const bvh_bounds& o) {
+        node.grow(o.node.min, o.node.max);
+        centroid.grow(o.centroid.min, o.centroid.max);
+    }
+};
+
+struct bvh_bins {
+    uint32_t count[3][AX_BVH_BINS];
+    bvh_box  box[3][AX_BVH_BINS];
+
+    void reset() {
+        std::memset(count, 0, sizeof(count));
+        for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < AX_BVH_BINS; ++b) box[a][b].reset();
+        }
+    }
+    void merge(const bvh_bins& o) {
+        for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < AX_BVH_BINS; ++b) {
+                count[a][b] += o.count[a][b];
+                box[a][b].grow(o.box[a][b].min, o.box[a][b].max);
+            }
+        }
+    }
+};
+
+/* per-worker partial results of the large-node passes; own cache lines */
+struct alignas(64) bvh_worker_partial {
+    bvh_bounds bounds;
+    bvh_bins   bins;
+};
+
+/* Maps centroids to bins along one axis; partitioning uses the same mapping. */
+struct bvh_binning {
+    float origin[3];
+    float scale[3];             /* 0 on an axis without extent */
+
+    explicit bvh_binning(const bvh_box& centroids) {
+        for (int a = 0; a < 3; ++a) {
+            float extent = centroids.max[a] - centroids.min[a];
+            origin[a] = centroids.min[a];
+            scale[a]  = extent > 0.0f ? (float)AX_BVH_BINS * 0.99999f / extent : 0.0f;
+        }
+    }
+    uint32_t bin(const bvh_prim& p, int axis) const {
+        int b = (int)((p.c[axis] - origin[axis]) * scale[axis]);
+        return (uint32_t)(b < 0 ? 0 : (b >= AX_BVH_BINS ? AX_BVH_BINS - 1 : b));
+    }
+};
+
+static void bounds_range(const bvh_prim* prims, const uint32_t* order, uint32_t begin,
+                         uint32_t end, bvh_bounds* out) {
+    for (uint32_t i = begin; i < end; ++i) {
+        const bvh_prim& p = prims[order[i]];
+        out->node.grow(p.min, p.max);
+        out->centroid.grow(p.c, p.c);
+    }
+}
+
+static void bin_range(const bvh_prim* prims, const uint32_t* order, uint32_t begin,
+                      uint32_t end, const bvh_binning& binning, bvh_bins* out) {
+    for (uint32_t i = begin; i < end; ++i) {
+        const bvh_prim& p = prims[order[i]];
+        for (int a = 0; a < 3; ++a) {
+            uint32_t b = binning.bin(p, a);
+            out->count[a][b]++;
+            out->box[a][b].grow(p.min, p.max);
+        }
+    }
+}
+
+struct bvh_split {
+    bool     leaf;
+    uint32_t axis;
+    uint32_t bin;               /* centroids in bins <= bin go left */
+    bool     median;            /* no usable SAH split: median on `axis` */
+};
+
+/*
+ * SAH with unit traversal and intersection costs: split if
+ * 1 + (nL * AL + nR * AR) / A beats the leaf's n, and always split
+ * above AX_BVH_MAX_LEAF. Ties go to the lower axis, then the lower bin.
+ */
+static bvh_split choose_split(const bvh_bounds& b, const bvh_bins& bins, uint32_t count,
+                              uint32_t depth) {
+    bvh_split s = { count <= AX_BVH_MAX_LEAF && count > 0, 0, 0, false };
+    if (count <= 1) {
+        s.leaf = true;
+        return s;
+    }
+
+    uint32_t widest = 0;
+    for (uint32_t a = 1; a < 3; ++a) {
+        if (b.centroid.max[a] - b.centroid.min[a] >
+            b.centroid.max[widest] - b.centroid.min[widest]) {
+            widest = a;
+        }
+    }
+    if (depth >= AX_BVH_SAH_DEPTH) {
+        if (count <= AX_BVH_MAX_LEAF) return s;
+        s.axis   = widest;
+        s.median = true;
+        return s;
+    }
+
+    float    best_cost = INFINITY;
+    uint32_t best_axis = 0, best_bin = 0;
+    for (uint32_t a = 0; a < 3; ++a) {
+        if (!(b.centroid.max[a] > b.centroid.min[a])) continue;
+
+        float    right_area[AX_BVH_BINS];
+        uint32_t right_count[AX_BVH_BINS];
+        bvh_box  acc;
+        acc.reset();
+        uint32_t n = 0;
+        for (int i = AX_BVH_BINS - 1; i > 0; --i) {
+            n += bins.count[a][i];
+            acc.grow(bins.box[a][i].min, bins.box[a][i].max);
+            right_area[i]  = acc.area();
+            right_count[i] = n;
+        }
+        acc.reset();
+        n = 0;
+        for (uint32_t i = 0; i + 1 < AX_BVH_BINS; ++i) {
+            n += bins.count[a][i];
+            acc.grow(bins.box[a][i].min, bins.box[a][i].max);
+            if (n == 0 || right_count[i + 1] == 0) continue;
+            float cost = (float)n * acc.area() + (float)right_count[i + 1] * right_area[i + 1];
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_axis = a;
+                best_bin  = i;
+            }
+        }
+    }
+
+    if (best_cost == INFINITY) {
+        /* every centroid in one bin: no SAH split exists */
+        if (count > AX_BVH_MAX_LEAF) {
+            s.axis   = widest;
+            s.median = true;
+        }
+        return s;
+    }
+    float area = b.node.area();
+    bool  split_cheaper = area <= 0.0f || 1.0f + best_cost / area < (float)count;
+    if (count > AX_BVH_MAX_LEAF || split_cheaper) {
+        s.leaf = false;
+        s.axis = best_axis;
+        s.bin  = best_bin;
+    }
+    return s;
+}
+
+/* Reorders order[begin, end) by the split; returns the left count (never 0 or all). */
+static uint32_t partition_range(const bvh_prim* prims, uint32_t* order, uint32_t begin,
+                                uint32_t end, const bvh_split& s, const bvh_binning& binning) {
+    if (s.median) {
+        uint32_t mid = begin + (end - begin) / 2;
+        int axis = (int)s.axis;
+        std::nth_element(order + begin, order + mid, order + end,
+                         [prims, axis](uint32_t x, uint32_t y) {
+                             float cx = prims[x].c[axis], cy = prims[y].c[axis];
+                             return cx < cy || (cx == cy && x < y);
+                         });
+        return mid - begin;
+    }
+    uint32_t i = begin, j = end;
+    while (i < j) {
+        if (binning.bin(prims[order[i]], (int)s.axis) <= s.bin) {
+            ++i;
+        } else {
+            std::swap(order[i], order[--j]);
+        }
+    }
+    return i - begin;
+}
+
+struct bvh_build_ctx {
+    const bvh_prim*  prims;
+    uint32_t*        order;
+    bvh_build_node*  nodes;
+};
+
+struct bvh_task {
+    uint32_t node;              /* subtree root, already in the build array */
+    uint32_t depth;
+    uint32_t region;            /* first build-array slot for its descendants */
+    uint32_t used;              /* descendants written */
+};
+
+/* Splits one node serially: the whole range, or the job's subtree. */
+static bvh_split split_node(const bvh_build_ctx& ctx, bvh_build_node& n, uint32_t depth,
+                            const bvh_bounds& bounds, const bvh_bins& bins,
+                            const bvh_binning& binning, uint32_t* left_count) {
+    std::memcpy(n.min, bounds.node.min, sizeof(n.min));
+    std::memcpy(n.max, bounds.node.max, sizeof(n.max));
+    n.left = n.right = NO_NODE;
+    n.axis = 0;
+    bvh_split s = choose_split(bounds, bins, n.count, depth);
+    if (!s.leaf) {
+        *left_count = partition_range(ctx.prims, ctx.order, n.start, n.start + n.count, s, binning);
+        n.axis = s.axis;
+    }
+    return s;
+}
+
+/* Builds the subtree under t.node into the task's region (no allocation). */
+static void build_subtree(const bvh_build_ctx& ctx, bvh_task& t) {
+    struct item { uint32_t node, depth; };
+    item     stack[AX_BVH_MAX_DEPTH + 2];
+    uint32_t sp   = 0;
+    uint32_t next = t.region;
+    stack[sp++] = { t.node, t.depth };
+
+    while (sp > 0) {
+        item it = stack[--sp];
+        bvh_build_node& n = ctx.nodes[it.node];
+
+        bvh_bounds bounds;
+        bounds.reset();
+        bounds_range(ctx.prims, ctx.order, n.start, n.start + n.count, &bounds);
+        bvh_binning binning(bounds.centroid);
+        bvh_bins bins;
+        bins.reset();
+        if (n.count > 1 && it.depth < AX_BVH_SAH_DEPTH) {
+            bin_range(ctx.prims, ctx.order, n.start, n.start + n.count, binning, &bins);
+        }
+
+        uint32_t left_count = 0;
+        bvh_split s = split_node(ctx, n, it.depth, bounds, bins, binning, &left_count);
+        if (s.leaf) continue;
+
+        bvh_build_node& l = ctx.nodes[next];
+        bvh_build_node& r = ctx.nodes[next + 1];
+        l.start = n.start;
+        l.count = left_count;
+        r.start = n.start + left_count;
+        r.count = n.count - left_count;
+        n.left  = next;
+        n.right = next + 1;
+        next += 2;
+        stack[sp++] = { n.right, it.depth + 1 };
+        stack[sp++] = { n.left, it.depth + 1 };
+    }
+    t.used = next - t.region;
+}
+
+/* Moller-Trumbore, double sided; the same expressions for every packet width. */
+static inline bool hit_triangle(const ax_bvh_triangle& tr, float ox, float oy, float oz,
+                                float dx, float dy, float dz, float* t_out) {
+    float px  = dy * tr.e2[2] - dz * tr.e2[1];
+    float py  = dz * tr.e2[0] - dx * tr.e2[2];
+    float pz  = dx * tr.e2[1] - dy * tr.e2[0];
+    float det = tr.e1[0] * px + tr.e1[1] * py + tr.e1[2] * pz;
+    float inv = 1.0f / det;
+    float sx  = ox - tr.v0[0], sy = oy - tr.v0[1], sz = oz - tr.v0[2];
+    float u   = (sx * px + sy * py + sz * pz) * inv;
+    float qx  = sy * tr.e1[2] - sz * tr.e1[1];
+    float qy  = sz * tr.e1[0] - sx * tr.e1[2];
+    float qz  = sx * tr.e1[1] - sy * tr.e1[0];
+    float v   = (dx * qx + dy * qy + dz * qz) * inv;
+    float t   = (tr.e2[0] * qx + tr.e2[1] * qy + tr.e2[2] * qz) * inv;
+    *t_out = t;
+    return (det != 0.0f) & (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (t >= 0.0f);
+}
+
+static uint64_t fnv1a(uint64_t h, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+ax_bvh::ax_bvh(const ax_alloc_state* alloc)
+    : nodes_(ax_allocator<ax_bvh_node>(alloc)),
+      tris_(ax_allocator<ax_bvh_triangle>(alloc)),
+      leaves_(0),
+      depth_(0),
+      hash_(0),
+      generation_(0),
+      alloc_(alloc) {
+}
+
+void ax_bvh::clear() {
+    ax_vector<ax_bvh_node>(ax_allocator<ax_bvh_node>(alloc_)).swap(nodes_);
+    ax_vector<ax_bvh_triangle>(ax_allocator<ax_bvh_triangle>(alloc_)).swap(tris_);
+    leaves_ = 0;
+    depth_  = 0;
+    hash_   = 0;
+    generation_++;
+}
+
+size_t ax_bvh::reserved_bytes() const {
+    return nodes_.capacity() * sizeof(ax_bvh_node) + tris_.capacity() * sizeof(ax_bvh_triangle);
+}
+
+size_t ax_bvh::used_bytes() const {
+    return nodes_.size() * sizeof(ax_bvh_node) + tris_.size() * sizeof(ax_bvh_triangle);
+}
+
+const char* ax_bvh::build(const float* vertices, uint32_t vertex_count,
+                          const uint32_t* indices, uint32_t triangle_count,
+                          ax_job_system* jobs) {
+    if (triangle_count > AX_BVH_MAX_TRIANGLES) {
+        return "triangle_count exceeds AX_BVH_MAX_TRIANGLES";
+    }
+    if (triangle_count > 0 && (!vertices || !indices)) {
+        return "vertices and indices must not be NULL";
+    }
+    for (uint64_t i = 0; i < (uint64_t)vertex_count * 3; ++i) {
+        if (!std::isfinite(vertices[i])) return "vertices must be finite";
+    }
+    for (uint64_t i = 0; i < (uint64_t)triangle_count * 3; ++i) {
+        if (indices[i] >= vertex_count) return "index out of range";
+    }
+    if (triangle_count == 0) {
+        clear();
+        return nullptr;
+    }
+
+    const ax_alloc_state* alloc = alloc_;
+    ax_vector<bvh_prim> prims(triangle_count, bvh_prim(), ax_allocator<bvh_prim>(alloc));
+    ax_vector<uint32_t> order(triangle_count, 0, ax_allocator<uint32_t>(alloc));
+    uint64_t hash = fnv1a(0xCBF29CE484222325ull, &triangle_count, sizeof(triangle_count));
+    for (uint32_t t = 0; t < triangle_count; ++t) {
+        bvh_prim& p = prims[t];
+        const float* v[3];
+        for (int k = 0; k < 3; ++k) {
+            v[k] = vertices + (size_t)indices[t * 3 + k] * 3;
+            hash = fnv1a(hash, v[k], 3 * sizeof(float));
+        }
+        for (int a = 0; a < 3; ++a) {
+            p.min[a] = std::min(v[0][a], std::min(v[1][a], v[2][a]));
+            p.max[a] = std::max(v[0][a], std::max(v[1][a], v[2][a]));
+            p.c[a]   = (p.min[a] + p.max[a]) * 0.5f;    /* bounds centre */
+        }
+        order[t] = t;
+    }
+
+    /*
+     * Top levels: nodes over AX_BVH_TASK_TRIANGLES, split here with the
+     * bounds and binning passes spread over the workers. Smaller nodes
+     * become tasks; their descendants go into per-task regions appended
+     * after the top nodes (at most 2n - 2 for n triangles).
+     */
+    ax_vector<bvh_build_node> nodes{ax_allocator<bvh_build_node>(alloc)};
+    ax_vector<bvh_task>       tasks{ax_allocator<bvh_task>(alloc)};
+    ax_vector<bvh_worker_partial> partials(jobs->worker_count(), bvh_worker_partial(),
+                                           ax_allocator<bvh_worker_partial>(alloc));
+    nodes.reserve(64);
+
+    struct pending { uint32_t node, depth; };
+    ax_vector<pending> work{ax_allocator<pending>(alloc)};
+    bvh_build_node root = {};
+    root.count = triangle_count;
+    nodes.push_back(root);
+    work.push_back({ 0, 0 });
+
+    bvh_build_ctx ctx = { prims.data(), order.data(), nullptr };
+    while (!work.empty()) {
+        pending it = work.back();
+        work.pop_back();
+        if (nodes[it.node].count <= AX_BVH_TASK_TRIANGLES) {
+            tasks.push_back({ it.node, it.depth, 0, 0 });
+            continue;
+        }
+        uint32_t start = nodes[it.node].start, count = nodes[it.node].count;
+
+        for (auto& p : partials) p.bounds.reset();
+        auto bounds_body = [&](uint32_t begin, uint32_t end, uint32_t worker) {
+            bounds_range(ctx.prims, ctx.order, start + begin, start + end, &partials[worker].bounds);
+        };
+        jobs->parallel_for(count, BUILD_GRAIN, bounds_body);
+        bvh_bounds bounds;
+        bounds.reset();
+        for (const auto& p : partials) bounds.merge(p.bounds);   /* min/max: order-free */
+
+        bvh_binning binning(bounds.centroid);
+        for (auto& p : partials) p.bins.reset();
+        auto bin_body = [&](uint32_t begin, uint32_t end, uint32_t worker) {
+            bin_range(ctx.prims, ctx.order, start + begin, start + end, binning, &partials[worker].bins);
+        };
+        jobs->parallel_for(count, BUILD_GRAIN, bin_body);
+        bvh_bins& bins = partials[0].bins;
+        for (size_t w = 1; w < partials.size(); ++w) bins.merge(partials[w].bins);
+
+        ctx.nodes = nodes.data();
+        uint32_t left_count = 0;
+        split_node(ctx, nodes[it.node], it.depth, bounds, bins, binning, &left_count);
+
+        /* more than AX_BVH_MAX_LEAF triangles: always split */
+        bvh_build_node l = {}, r = {};
+        l.start = start;
+        l.count = left_count;
+        r.start = start + left_count;
+        r.count = count - left_count;
+        uint32_t li = (uint32_t)nodes.size();
+        nodes.push_back(l);
+        nodes.push_back(r);
+        nodes[it.node].left  = li;
+        nodes[it.node].right = li + 1;
+        work.push_back({ li + 1, it.depth + 1 });
+        work.push_back({ li, it.depth + 1 });
+    }
+
+    size_t total = nodes.size();
+    for (auto& t : tasks) {
+        t.region = (uint32_t)total;
+        total += 2 * (size_t)nodes[t.node].count - 2;
+    }
+    nodes.resize(total);
+    ctx.nodes = nodes.data();
+    auto task_body = [&](uint32_t begin, uint32_t end, uint32_t) {
+        for (uint32_t i = begin; i < end; ++i) build_subtree(ctx, tasks[i]);
+    };
+    jobs->parallel_for((uint32_t)tasks.size(), 1, task_body);
+
+    /* Flatten depth first: first child next, second child patched in. */
+    size_t used = total;
+    for (const auto& t : tasks) used -= 2 * (size_t)nodes[t.node].count - 2 - t.used;
+    ax_vector<ax_bvh_node> flat{ax_allocator<ax_bvh_node>(alloc)};
+    flat.reserve(used);
+    ax_vector<ax_bvh_triangle> tris(triangle_count, ax_bvh_triangle(),
+                                    ax_allocator<ax_bvh_triangle>(alloc));
+    uint32_t leaves = 0, depth = 0;
+
+    struct visit { uint32_t node, patch, depth; };
+    visit    stack[AX_BVH_MAX_DEPTH + 2];
+    uint32_t sp = 0;
+    stack[sp++] = { 0, NO_NODE, 1 };
+    while (sp > 0) {
+        visit v = stack[--sp];
+        const bvh_build_node& b = nodes[v.node];
+        uint32_t at = (uint32_t)flat.size();
+        if (v.patch != NO_NODE) flat[v.patch].index = at;
+
+        ax_bvh_node out = {};
+        std::memcpy(out.min, b.min, sizeof(out.min));
+        std::memcpy(out.max, b.max, sizeof(out.max));
+        depth = std::max(depth, v.depth);
+        if (b.left == NO_NODE) {
+            out.index = b.start;
+            out.count = (uint16_t)b.count;
+            leaves++;
+            flat.push_back(out);
+            continue;
+        }
+        out.axis = (uint16_t)b.axis;
+        flat.push_back(out);
+        stack[sp++] = { b.right, at, v.depth + 1 };
+        stack[sp++] = { b.left, NO_NODE, v.depth + 1 };
+    }
+
+    for (uint32_t k = 0; k < triangle_count; ++k) {
+        uint32_t t = order[k];
+        ax_bvh_triangle& tr = tris[k];
+        const float* v0 = vertices + (size_t)indices[t * 3 + 0] * 3;
+        const float* v1 = vertices + (size_t)indices[t * 3 + 1] * 3;
+        const float* v2 = vertices + (size_t)indices[t * 3 + 2] * 3;
+        for (int a = 0; a < 3; ++a) {
+            tr.v0[a] = v0[a];
+            tr.e1[a] = v1[a] - v0[a];
+            tr.e2[a] = v2[a] - v0[a];
+        }
+        tr.id = t;
+    }
+
+    nodes_.swap(flat);
+    tris_.swap(tris);
+    leaves_ = leaves;
+    depth_  = depth;
+    hash_   = hash;
+    generation_++;
+    return nullptr;
+}
+
+/* ── Queries ──────────────────────────────────────────────────────── */
+
+static inline float min2(float a, float b) { return a < b ? a : b; }
+static inline float max2(float a, float b) { return a > b ? a : b; }
+
+/* 1/d, with zero components nudged so slab distances stay finite (no 0 * inf) */
+static inline float safe_inverse(float d) {
+    const float TINY = 1e-20f;
+    if (std::fabs(d) < TINY) d = d < 0.0f ? -TINY : TINY;
+    return 1.0f / d;
+}
+
+/*
+ * Boxes are tested against a slightly longer ray than the best hit so
+ * far. A tie (two triangles hit at the same t, across a shared edge)
+ * goes to the lower triangle id, and the box holding that triangle must
+ * not be culled by rounding in the slab test, or the winner would depend
+ * on traversal order, which differs between packet widths.
+ */
+static const float BOX_SLACK = 1.0f + 1.0f / 65536.0f;
+
+template <uint32_t N, bool AnyHit>
+void ax_bvh::trace(const ax_bvh_ray* rays, ax_bvh_hit* out) const {
+    float    ox[N], oy[N], oz[N], dx[N], dy[N], dz[N], ix[N], iy[N], iz[N];
+    float    best[N];           /* triangle cut-off; -1 once an any-hit lane is done */
+    float    reach[N];          /* box cut-off: best, a little long (see BOX_SLACK) */
+    float    hit_t[N];
+    uint32_t hit_id[N], hit_tri[N];
+    for (uint32_t l = 0; l < N; ++l) {
+        const ax_bvh_ray& r = rays[l];
+        ox[l] = r.ox;  oy[l] = r.oy;  oz[l] = r.oz;
+        dx[l] = r.dx;  dy[l] = r.dy;  dz[l] = r.dz;
+        ix[l] = safe_inverse(r.dx);
+        iy[l] = safe_inverse(r.dy);
+        iz[l] = safe_inverse(r.dz);
+        best[l]    = r.max_t;
+        reach[l]   = r.max_t * BOX_SLACK;
+        hit_t[l]   = r.max_t;
+        hit_id[l]  = UINT32_MAX;
+        hit_tri[l] = AX_BVH_NO_HIT;
+    }
+
+    uint32_t stack[AX_BVH_MAX_DEPTH + 1];
+    uint32_t sp   = 0;
+    uint32_t node = 0;
+    uint32_t live = N;
+    const ax_bvh_node* nodes = nodes_.data();
+    while (!nodes_.empty()) {
+        const ax_bvh_node& n = nodes[node];
+        uint32_t any = 0;
+        for (uint32_t l = 0; l < N; ++l) {
+            float tx0 = (n.min[0] - ox[l]) * ix[l], tx1 = (n.max[0] - ox[l]) * ix[l];
+            float ty0 = (n.min[1] - oy[l]) * iy[l], ty1 = (n.max[1] - oy[l]) * iy[l];
+            float tz0 = (n.min[2] - oz[l]) * iz[l], tz1 = (n.max[2] - oz[l]) * iz[l];
+            float tnear = max2(max2(min2(tx0, tx1), min2(ty0, ty1)), max2(min2(tz0, tz1), 0.0f));
+            float tfar  = min2(min2(max2(tx0, tx1), max2(ty0, ty1)), min2(max2(tz0, tz1), reach[l]));
+            any |= (uint32_t)(tnear <= tfar);
+        }
+
+        if (any && n.count == 0) {
+            /* near child first, by the first ray's direction */
+            float d = n.axis == 0 ? dx[0] : (n.axis == 1 ? dy[0] : dz[0]);
+            if (d < 0.0f) {
+                stack[sp++] = node + 1;
+                node = n.index;
+            } else {
+                stack[sp++] = n.index;
+                node = node + 1;
+            }
+            continue;
+        }
+        if (any) {
+            for (uint32_t k = n.index; k < n.index + n.count; ++k) {
+                /* every lane at once (no branches, so it vectorizes), then the updates */
+                const ax_bvh_triangle& tr = tris_[k];
+                float    t[N];
+                uint32_t hit[N];
+                uint32_t hits = 0;
+                for (uint32_t l = 0; l < N; ++l) {
+                    hit[l] = hit_triangle(tr, ox[l], oy[l], oz[l], dx[l], dy[l], dz[l], &t[l]);
+                    hits  |= hit[l];
+                }
+                if (!hits) continue;
+                for (uint32_t l = 0; l < N; ++l) {
+                    if (hit[l] && (t[l] < best[l] || (t[l] == best[l] && tr.id < hit_id[l]))) {
+                        best[l]    = AnyHit ? -1.0f : t[l];
+                        reach[l]   = best[l] * BOX_SLACK;
+                        hit_t[l]   = t[l];
+                        hit_id[l]  = tr.id;
+                        hit_tri[l] = k;
+                        if (AnyHit) live--;
+                    }
+                }
+            }
+            if (AnyHit && live == 0) break;
+        }
+        if (sp == 0) break;
+        node = stack[--sp];
+    }
+
+    for (uint32_t l = 0; l < N; ++l) {
+        out[l].t        = hit_t[l];
+        out[l].triangle = hit_tri[l];
+    }
+}
+
+void ax_bvh::raycast(const ax_bvh_ray* rays, uint32_t count, uint32_t width, bool any_hit,
+                     ax_bvh_hit* out) const {
+    uint32_t i = 0;
+    if (width >= 8) {
+        for (; i + 8 <= count; i += 8) {
+            any_hit ? trace<8, true>(rays + i, out + i) : trace<8, false>(rays + i, out + i);
+        }
+    }
+    if (width >= 4) {
+        for (; i + 4 <= count; i += 4) {
+            any_hit ? trace<4, true>(rays + i, out + i) : trace<4, false>(rays + i, out + i);
+        }
+    }
+    for (; i < count; ++i) {
+        any_hit ? trace<1, true>(rays + i, out + i) : trace<1, false>(rays + i, out + i);
+    }
+}
+
+ax_bvh_hit ax_bvh::raycast(const ax_bvh_ray& ray) const {
+    ax_bvh_hit hit;
+    trace<1, false>(&ray, &hit);
+    return hit;
+}
+
+bool ax_bvh::occluded(const ax_bvh_ray& ray) const {
+    ax_bvh_hit hit;
+    trace<1, true>(&ray, &hit);
+    return hit.triangle != AX_BVH_NO_HIT;
+}
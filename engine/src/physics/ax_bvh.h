@@ -0,0 +1,178 @@
+/*
+ * ax_bvh.h — Static triangle collision world (SAH bounding volume hierarchy)
+ *
+ * The query side of ax_physics_iface (ARCHITECTURE.md): one immutable
+ * triangle mesh per core, built into a binary BVH and traced by rays.
+ *
+ * Build: binned SAH (AX_BVH_BINS bins per axis) over triangle centroids,
+ * leaves of at most AX_BVH_MAX_LEAF triangles. Nodes larger than
+ * AX_BVH_TASK_TRIANGLES are split on the calling thread (their binning
+ * spread over the job system); every smaller subtree is one job. The
+ * split sequence depends only on the mesh, never on the worker count or
+ * which worker built what, so the tree is identical for any threading.
+ * Below depth AX_BVH_SAH_DEPTH nodes fall back to median splits, which
+ * bounds the depth (and the traversal stack) at AX_BVH_MAX_DEPTH.
+ *
+ * Layout: nodes are flattened depth first into one array of 32-byte
+ * nodes (two per cache line); an inner node's first child is the next
+ * node, so only the second child's index is stored. Triangles are
+ * stored in leaf order, pre-transformed for Moller-Trumbore (vertex 0
+ * plus two edges).
+ *
+ * Queries: rays are traced alone or as packets of 4 or 8 that share one
+ * traversal; a packet visits a node if any of its rays does. All widths
+ * run the same float expressions per ray, and ties at equal distance go
+ * to the lower triangle, so closest hits are bit-identical whatever the
+ * width, batching or visiting order.
+ *
+ * Box queries (overlap) visit the triangles whose bounds overlap an
+ * axis-aligned box, in ascending leaf order; the character controller
+ * (ax_character.h) gathers its candidates with them.
+ */
+
+#pragma once
+
+#include "core/ax_alloc.h"
+
+#include <cstdint>
+
+class ax_job_system;
+
+#define AX_BVH_BINS           32
+#define AX_BVH_MAX_LEAF       4
+#define AX_BVH_TASK_TRIANGLES 4096
+#define AX_BVH_SAH_DEPTH      38
+#define AX_BVH_MAX_DEPTH      64
+#define AX_BVH_MAX_TRIANGLES  (1u << 24)
+
+#define AX_BVH_NO_HIT UINT32_MAX
+
+struct ax_bvh_node {
+    float    min[3];
+    uint32_t index;             /* leaf: first triangle; inner: second child */
+    float    max[3];
+    uint16_t count;             /* leaf: triangles (> 0); inner: 0           */
+    uint16_t axis;              /* inner: split axis, orders the children    */
+};
+
+struct ax_bvh_triangle {
+    float    v0[3];
+    float    e1[3];             /* v1 - v0 */
+    float    e2[3];             /* v2 - v0 */
+    uint32_t id;                /* index in the source mesh */
+};
+
+/* origin + t * dir for t in [0, max_t]; dir need not be unit length */
+struct ax_bvh_ray {
+    float ox, oy, oz;
+    float dx, dy, dz;
+    float max_t;
+};
+
+struct ax_bvh_hit {
+    float    t;
+    uint32_t triangle;          /* leaf-order index, AX_BVH_NO_HIT = miss */
+};
+
+class ax_bvh {
+public:
+    explicit ax_bvh(const ax_alloc_state* alloc);
+
+    /* Drops the mesh; every ray misses. */
+    void clear();
+
+    /*
+     * Builds from an indexed mesh (xyz per vertex, three indices per
+     * triangle), replacing the current one. Returns NULL on success,
+     * else a static description of the problem (the old mesh is kept).
+     * Allocates only on the calling thread.
+     */
+    const char* build(const float* vertices, uint32_t vertex_count,
+                      const uint32_t* indices, uint32_t triangle_count,
+                      ax_job_system* jobs);
+
+    bool     empty() const          { return tris_.empty(); }
+    uint32_t triangle_count() const { return (uint32_t)tris_.size(); }
+    uint32_t node_count() const     { return (uint32_t)nodes_.size(); }
+    uint32_t leaf_count() const     { return leaves_; }
+    uint32_t depth() const          { return depth_; }
+    uint64_t hash() const           { return hash_; }   /* of the source mesh, 0 if empty */
+    uint32_t generation() const     { return generation_; } /* bumped by every build / clear */
+
+    const ax_bvh_node*     nodes() const { return nodes_.data(); }
+    const ax_bvh_triangle& triangle(uint32_t i) const { return tris_[i]; }
+
+    /* heap held / bytes backing the tree */
+    size_t reserved_bytes() const;
+    size_t used_bytes() const;
+
+    /*
+     * Traces `count` rays in packets of `width` (1, 4 or 8). any_hit
+     * stops each ray at the first hit found (occlusion: the hit is not
+     * necessarily the closest, and may differ between widths).
+     */
+    void raycast(const ax_bvh_ray* rays, uint32_t count, uint32_t width, bool any_hit,
+                 ax_bvh_hit* out) const;
+
+    /* Closest hit of one ray. */
+    ax_bvh_hit raycast(const ax_bvh_ray& ray) const;
+
+    /* Whether anything lies on the ray within [0, max_t]. */
+    bool occluded(const ax_bvh_ray& ray) const;
+
+    /*
+     * Calls visit(k) for the leaf-order index k of every triangle whose
+     * bounds overlap [min, max] (closed), in ascending k.
+     */
+    template <class F>
+    void overlap(const float min[3], const float max[3], F&& visit) const;
+
+private:
+    template <uint32_t N, bool AnyHit>
+    void trace(const ax_bvh_ray* rays, ax_bvh_hit* out) const;
+
+    ax_vector<ax_bvh_node>     nodes_;
+    ax_vector<ax_bvh_triangle> tris_;
+    uint32_t                   leaves_;
+    uint32_t                   depth_;
+    uint64_t                   hash_;
+    uint32_t                   generation_;
+    const ax_alloc_state*      alloc_;
+};
+
+template <class F>
+void ax_bvh::overlap(const float min[3], const float max[3], F&& visit) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    /* first child first: leaves, and so triangles, come out in ascending order */
+    uint32_t stack[AX_BVH_MAX_DEPTH + 1];
+    uint32_t sp   = 0;
+    uint32_t node = 0;
+    for (;;) {
+        const ax_bvh_node& n = nodes_[node];
+        bool inside = n.min[0] <= max[0] && n.max[0] >= min[0] &&
+                      n.min[1] <= max[1] && n.max[1] >= min[1] &&
+                      n.min[2] <= max[2] && n.max[2] >= min[2];
+        if (inside && n.count == 0) {
+            stack[sp++] = n.index;
+            node = node + 1;
+            continue;
+        }
+        if (inside) {
+            for (uint32_t k = n.index; k < n.index + n.count; ++k) {
+                const ax_bvh_triangle& t = tris_[k];
+                bool hit = true;
+                for (int a = 0; a < 3; ++a) {
+                    float v1 = t.v0[a] + t.e1[a], v2 = t.v0[a] + t.e2[a];
+                    float lo = t.v0[a] < v1 ? (t.v0[a] < v2 ? t.v0[a] : v2) : (v1 < v2 ? v1 : v2);
+                    float hi = t.v0[a] > v1 ? (t.v0[a] > v2 ? t.v0[a] : v2) : (v1 > v2 ? v1 : v2);
+                    hit = hit && lo <= max[a] && hi >= min[a];
+                }
+                if (hit) visit(k);
+            }
+        }
+        if (sp == 0) break;
+        node = stack[--sp];
+    }
+}
@@ -0,0 +1,404 @@
+/*
+ * ax_character.cpp — Capsule character controller against the static BVH
+ *
+ * See ax_character.h. Closest-point routines follow Ericson, "Real-Time
+ * Collision Detection" (5.1.5 point-triangle, 5.1.9 segment-segment).
+ */
+
+#include "physics/ax_character.h"
+
+#include <cmath>
+
+/* cos(AX_CHARACTER_MAX_SLOPE_DEG); a constant so no libm cos is involved */
+static const float WALKABLE_COS = 0.64278761f;
+
+static_assert(AX_CHARACTER_MAX_SLOPE_DEG == 50, "update WALKABLE_COS");
+
+static const float SEG_LO  = AX_CHARACTER_RADIUS_M;                           /* feet to lower centre */
+static const float SEG_HI  = AX_CHARACTER_HEIGHT_M - AX_CHARACTER_RADIUS_M;   /* feet to upper centre */
+static const float REACH   = AX_CHARACTER_RADIUS_M + AX_CHAR_SKIN;   /* contact distance to the axis */
+static const float TOI_TOL = AX_CHAR_SKIN * 0.5f;                    /* contact accepted this close  */
+
+/* conservative advancement steps per triangle before settling for the last safe t */
+static const uint32_t TOI_ITERATIONS = 32;
+
+/*
+ * A contact already within reach blocks only a move into it steeper than
+ * this (as the sine of the angle); closest points on large triangles are
+ * a little noisy, and a floor must not block walking across it.
+ */
+static const float GRAZE = 1e-3f;
+
+/* the ground probe looks this far below the feet */
+static const float PROBE = 2.0f * AX_CHAR_SKIN;
+
+/* ── Vector helpers ───────────────────────────────────────────────── */
+
+struct v3 {
+    float x, y, z;
+};
+
+static inline v3    add(v3 a, v3 b)       { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+static inline v3    sub(v3 a, v3 b)       { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+static inline v3    mul(v3 a, float s)    { return { a.x * s, a.y * s, a.z * s }; }
+static inline float dot(v3 a, v3 b)       { return a.x * b.x + a.y * b.y + a.z * b.z; }
+static inline v3    cross(v3 a, v3 b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+static inline float clamp01(float v)      { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+static inline float min2(float a, float b) { return a < b ? a : b; }
+static inline float max2(float a, float b) { return a > b ? a : b; }
+
+/* ── Closest points ───────────────────────────────────────────────── */
+
+static v3 closest_on_triangle(v3 p, v3 a, v3 b, v3 c) {
+    v3 ab = sub(b, a), ac = sub(c, a), ap = sub(p, a);
+    float d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    v3 bp = sub(p, b);
+    float d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return add(a, mul(ab, d1 / (d1 - d3)));
+
+    v3 cp = sub(p, c);
+    float d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return add(a, mul(ac, d2 / (d2 - d6)));
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return add(b, mul(sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+    }
+    float denom = 1.0f / (va + vb + vc);
+    return add(a, add(mul(ab, vb * denom), mul(ac, vc * denom)));
+}
+
+/* squared distance between segments p1q1 and p2q2, closest points in c1, c2 */
+static float closest_segments(v3 p1, v3 q1, v3 p2, v3 q2, v3* c1, v3* c2) {
+    const float EPS = 1e-12f;
+    v3 d1 = sub(q1, p1), d2 = sub(q2, p2), r = sub(p1, p2);
+    float a = dot(d1, d1), e = dot(d2, d2), f = dot(d2, r);
+    float s, t;
+    if (a <= EPS && e <= EPS) {
+        s = t = 0.0f;
+    } else if (a <= EPS) {
+        s = 0.0f;
+        t = clamp01(f / e);
+    } else {
+        float c = dot(d1, r);
+        if (e <= EPS) {
+            t = 0.0f;
+            s = clamp01(-c / a);
+        } else {
+            float b = dot(d1, d2), denom = a * e - b * b;
+            s = denom != 0.0f ? clamp01((b * f - c * e) / denom) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = clamp01(-c / a);
+            } else if (t > 1.0f) {
+                t = 1.0f;
+                s = clamp01((b - c) / a);
+            }
+        }
+    }
+    *c1 = add(p1, mul(d1, s));
+    *c2 = add(p2, mul(d2, t));
+    v3 d = sub(*c1, *c2);
+    return dot(d, d);
+}
+
+/*
+ * Distance from segment pq to the triangle; closest points in cs (on
+ * the segment) and ct (on the triangle). 0 when the segment pierces it.
+ */
+static float segment_triangle(v3 p, v3 q, v3 a, v3 b, v3 c, v3* cs, v3* ct) {
+    v3 n  = cross(sub(b, a), sub(c, a));
+    v3 pq = sub(q, p);
+    float den = dot(n, pq);
+    if (den != 0.0f) {
+        float t = dot(n, sub(a, p)) / den;
+        if (t >= 0.0f && t <= 1.0f) {
+            v3 x = add(p, mul(pq, t));
+            if (dot(cross(sub(b, a), sub(x, a)), n) >= 0.0f &&
+                dot(cross(sub(c, b), sub(x, b)), n) >= 0.0f &&
+                dot(cross(sub(a, c), sub(x, c)), n) >= 0.0f) {
+                *cs = *ct = x;
+                return 0.0f;
+            }
+        }
+    }
+
+    /* otherwise the closest pair involves a segment end or a triangle edge */
+    v3 tp = closest_on_triangle(p, a, b, c);
+    v3 d  = sub(p, tp);
+    float best = dot(d, d);
+    *cs = p;
+    *ct = tp;
+
+    v3 tq = closest_on_triangle(q, a, b, c);
+    d = sub(q, tq);
+    if (dot(d, d) < best) {
+        best = dot(d, d);
+        *cs = q;
+        *ct = tq;
+    }
+    const v3 edges[3][2] = { { a, b }, { b, c }, { c, a } };
+    for (const auto& edge : edges) {
+        v3 c1, c2;
+        float d2 = closest_segments(p, q, edge[0], edge[1], &c1, &c2);
+        if (d2 < best) {
+            best = d2;
+            *cs = c1;
+            *ct = c2;
+        }
+    }
+    return std::sqrt(best);
+}
+
+/* ── Sweeps ───────────────────────────────────────────────────────── */
+
+struct sweep_hit {
+    float    t;                 /* fraction of the displacement, 1 = none */
+    uint32_t id;                /* source triangle, AX_BVH_NO_HIT = none  */
+    v3       n;                 /* unit contact normal, towards the actor */
+};
+
+struct sweep_context {
+    const ax_bvh*             bvh;
+    const ax_character_cache* cache;    /* NULL: query the BVH per sweep */
+};
+
+static bool triangle_overlaps(const ax_bvh_triangle& t, const float min[3], const float max[3]) {
+    for (int a = 0; a < 3; ++a) {
+        float v1 = t.v0[a] + t.e1[a], v2 = t.v0[a] + t.e2[a];
+        float lo = min2(t.v0[a], min2(v1, v2));
+        float hi = max2(t.v0[a], max2(v1, v2));
+        if (lo > max[a] || hi < min[a]) return false;
+    }
+    return true;
+}
+
+/*
+ * Time of impact of the capsule (axis pq) moving by `delta` with one
+ * triangle: the first t in [0, 1] at which the axis comes within REACH
+ * (+ TOI_TOL). Already within reach counts only when moving closer
+ * (by more than GRAZE).
+ */
+static bool triangle_toi(const ax_bvh_triangle& tr, v3 p, v3 q, v3 delta, float len,
+                         float* t_out, v3* n_out) {
+    v3 a = { tr.v0[0], tr.v0[1], tr.v0[2] };
+    v3 b = add(a, v3{ tr.e1[0], tr.e1[1], tr.e1[2] });
+    v3 c = add(a, v3{ tr.e2[0], tr.e2[1], tr.e2[2] });
+
+    /* plane cull: the axis stays out of reach on one side for the whole move */
+    v3 fn = cross(sub(b, a), sub(c, a));
+    float fl = std::sqrt(dot(fn, fn));
+    if (fl > 0.0f) {
+        fn = mul(fn, 1.0f / fl);
+        float dp = dot(fn, sub(p, a)), dq = dot(fn, sub(q, a)), dd = dot(fn, delta);
+        float lo = min2(min2(dp, dq), min2(dp, dq) + dd);
+        float hi = max2(max2(dp, dq), max2(dp, dq) + dd);
+        if (lo > REACH + TOI_TOL || hi < -(REACH + TOI_TOL)) return false;
+    }
+
+    float t = 0.0f;
+    for (uint32_t it = 0; it < TOI_ITERATIONS; ++it) {
+        v3 off = mul(delta, t);
+        v3 cs, ct;
+        float d = segment_triangle(add(p, off), add(q, off), a, b, c, &cs, &ct);
+        if (d - REACH <= TOI_TOL || it + 1 == TOI_ITERATIONS) {
+            v3 n;
+            if (d > 1e-6f) {
+                n = mul(sub(cs, ct), 1.0f / d);
+            } else {
+                /* axis touches the triangle: its face normal, towards the axis midpoint */
+                n = cross(sub(b, a), sub(c, a));
+                float nl = std::sqrt(dot(n, n));
+                if (nl == 0.0f) return false;
+                n = mul(n, 1.0f / nl);
+                if (dot(n, sub(add(mul(add(p, q), 0.5f), off), a)) < 0.0f) n = mul(n, -1.0f);
+            }
+            if (it == 0 && dot(n, delta) >= -GRAZE * len) return false;
+            *t_out = t;
+            *n_out = n;
+            return true;
+        }
+        t += (d - REACH) / len;
+        if (t > 1.0f) return false;
+    }
+    return false;
+}
+
+/* Earliest contact of the capsule standing at `pos` moving by `delta`. */
+static sweep_hit sweep(const sweep_context& ctx, v3 pos, v3 delta) {
+    sweep_hit best = { 1.0f, AX_BVH_NO_HIT, { 0.0f, 0.0f, 0.0f } };
+    float len = std::sqrt(dot(delta, delta));
+    if (len < 1e-7f) {
+        return best;
+    }
+    v3 p = { pos.x, pos.y + SEG_LO, pos.z };
+    v3 q = { pos.x, pos.y + SEG_HI, pos.z };
+
+    const float pad = REACH + TOI_TOL;
+    float lo[3] = { min2(p.x, p.x + delta.x) - pad, min2(p.y, p.y + delta.y) - pad,
+                    min2(p.z, p.z + delta.z) - pad };
+    float hi[3] = { max2(q.x, q.x + delta.x) + pad, max2(q.y, q.y + delta.y) + pad,
+                    max2(q.z, q.z + delta.z) + pad };
+
+    auto test = [&](uint32_t k) {
+        const ax_bvh_triangle& tr = ctx.bvh->triangle(k);
+        if (!triangle_overlaps(tr, lo, hi)) return;
+        float t;
+        v3    n;
+        if (triangle_toi(tr, p, q, delta, len, &t, &n) &&
+            (t < best.t || (t == best.t && tr.id < best.id))) {
+            best.t  = t;
+            best.id = tr.id;
+            best.n  = n;
+        }
+    };
+    if (ctx.cache) {
+        for (uint32_t i = 0; i < ctx.cache->count; ++i) test(ctx.cache->triangles[i]);
+    } else {
+        /* padded against rounding in node bounds; triangle_overlaps decides */
+        float qlo[3] = { lo[0] - AX_CHAR_SKIN, lo[1] - AX_CHAR_SKIN, lo[2] - AX_CHAR_SKIN };
+        float qhi[3] = { hi[0] + AX_CHAR_SKIN, hi[1] + AX_CHAR_SKIN, hi[2] + AX_CHAR_SKIN };
+        ctx.bvh->overlap(qlo, qhi, test);
+    }
+    return best;
+}
+
+/* ── Moves ────────────────────────────────────────────────────────── */
+
+static float horizontal_dist2(v3 a, v3 b) {
+    float dx = a.x - b.x, dz = a.z - b.z;
+    return dx * dx + dz * dz;
+}
+
+/*
+ * Collide-and-slide of `delta` from `pos`. A grounded actor slides
+ * along steep surfaces horizontally, and may try one step up.
+ */
+static v3 slide(const sweep_context& ctx, v3 pos, v3 delta, bool grounded, bool allow_step) {
+    v3  prev_n = { 0.0f, 0.0f, 0.0f };
+    for (uint32_t i = 0; i < AX_CHAR_SLIDES; ++i) {
+        sweep_hit h = sweep(ctx, pos, delta);
+        if (h.id == AX_BVH_NO_HIT) {
+            return add(pos, delta);
+        }
+        pos = add(pos, mul(delta, h.t));
+        v3 rest = mul(delta, 1.0f - h.t);
+        v3 n    = h.n;
+
+        if (grounded && n.y < WALKABLE_COS) {
+            if (allow_step) {
+                /* step: up, across, back down onto walkable ground */
+                allow_step = false;
+                v3 up = { 0.0f, AX_CHARACTER_STEP_M, 0.0f };
+                sweep_hit hu = sweep(ctx, pos, up);
+                v3 raised = add(pos, mul(up, hu.t));
+                v3 across = slide(ctx, raised, rest, true, false);
+                v3 down   = { 0.0f, -(raised.y - pos.y) - PROBE, 0.0f };
+                sweep_hit hd = sweep(ctx, across, down);
+                v3 flat = slide(ctx, pos, rest, true, false);
+                if (hd.id != AX_BVH_NO_HIT && hd.n.y >= WALKABLE_COS &&
+                    horizontal_dist2(across, pos) > horizontal_dist2(flat, pos) + 1e-6f) {
+                    return add(across, mul(down, hd.t));
+                }
+                return flat;
+            }
+            /* walls are slid along, not climbed */
+            n.y = 0.0f;
+            float nl = std::sqrt(dot(n, n));
+            if (nl < 1e-6f) return pos;
+            n = mul(n, 1.0f / nl);
+        }
+
+        rest = sub(rest, mul(n, dot(rest, n)));
+        if (i > 0 && dot(rest, prev_n) < 0.0f) {
+            /* into the previous surface again: follow the crease */
+            v3 crease = cross(prev_n, n);
+            float cl = std::sqrt(dot(crease, crease));
+            if (cl < 1e-6f) return pos;     /* opposing surfaces: wedged */
+            crease = mul(crease, 1.0f / cl);
+            rest   = mul(crease, dot(rest, crease));
+        }
+        prev_n = n;
+        delta  = rest;
+    }
+    return pos;
+}
+
+/* Slides down by AX_CHARACTER_FALL_M, stopping on walkable ground. */
+static v3 settle(const sweep_context& ctx, v3 pos, bool* grounded) {
+    v3 delta = { 0.0f, -AX_CHARACTER_FALL_M, 0.0f };
+    *grounded = false;
+    for (uint32_t i = 0; i < AX_CHAR_SLIDES; ++i) {
+        sweep_hit h = sweep(ctx, pos, delta);
+        if (h.id == AX_BVH_NO_HIT) {
+            return add(pos, delta);
+        }
+        pos = add(pos, mul(delta, h.t));
+        if (h.n.y >= WALKABLE_COS) {
+            *grounded = true;
+            return pos;
+        }
+        v3 rest = mul(delta, 1.0f - h.t);
+        delta = sub(rest, mul(h.n, dot(rest, h.n)));
+    }
+    return pos;
+}
+
+static bool region_contains(const ax_character_cache& c, const float lo[3], const float hi[3]) {
+    return c.min[0] <= lo[0] && c.min[1] <= lo[1] && c.min[2] <= lo[2] &&
+           c.max[0] >= hi[0] && c.max[1] >= hi[1] && c.max[2] >= hi[2];
+}
+
+ax_character_result ax_character_move(const ax_bvh& bvh, ax_character_cache* cache,
+                                      uint32_t entity_id, float px, float py, float pz,
+                                      float dx, float dz) {
+    /*
+     * Everything this move can sweep through: the capsule, the move, a
+     * step up, and a settle (which may slide sideways down a slope).
+     */
+    const float pad = REACH + TOI_TOL + AX_CHAR_SKIN;
+    float side  = std::fabs(dx) + std::fabs(dz) + AX_CHARACTER_FALL_M + pad;
+    float lo[3] = { px - side, py - AX_CHARACTER_FALL_M - PROBE - pad, pz - side };
+    float hi[3] = { px + side, py + AX_CHARACTER_HEIGHT_M + AX_CHARACTER_STEP_M + pad, pz + side };
+
+    if (cache->entity_id != entity_id || cache->generation != bvh.generation() ||
+        !region_contains(*cache, lo, hi)) {
+        cache->entity_id  = entity_id;
+        cache->generation = bvh.generation();
+        cache->count      = 0;
+        for (int a = 0; a < 3; ++a) {
+            cache->min[a] = lo[a] - AX_CHAR_CACHE_MARGIN;
+            cache->max[a] = hi[a] + AX_CHAR_CACHE_MARGIN;
+        }
+        bvh.overlap(cache->min, cache->max, [cache](uint32_t k) {
+            if (cache->count < AX_CHAR_CACHE_TRIANGLES) cache->triangles[cache->count] = k;
+            cache->count++;
+        });
+    }
+    sweep_context ctx = { &bvh, cache->count <= AX_CHAR_CACHE_TRIANGLES ? cache : nullptr };
+
+    v3 pos = { px, py, pz };
+    sweep_hit probe = sweep(ctx, pos, v3{ 0.0f, -PROBE, 0.0f });
+    bool grounded = probe.id != AX_BVH_NO_HIT && probe.n.y >= WALKABLE_COS;
+
+    pos = slide(ctx, pos, v3{ dx, 0.0f, dz }, grounded, grounded);
+    pos = settle(ctx, pos, &grounded);
+
+    ax_character_result r;
+    r.px = pos.x;
+    r.py = pos.y;
+    r.pz = pos.z;
+    r.grounded = grounded;
+    return r;
+}
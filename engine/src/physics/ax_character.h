@@ -0,0 +1,67 @@
+/*
+ * ax_character.h — Capsule character controller against the static BVH
+ *
+ * The character-controller half of ax_physics_iface (ARCHITECTURE.md):
+ * Core owns each actor's position, and this module moves it through
+ * the collision mesh. An actor is a vertical capsule standing on its
+ * position (the feet), AX_CHARACTER_* in ax_abi.h.
+ *
+ * One move per actor per tick:
+ *   1. ground probe: the actor is grounded if walkable ground (normal
+ *      within AX_CHARACTER_MAX_SLOPE_DEG of up) is just below its feet
+ *   2. collide-and-slide along the horizontal displacement, at most
+ *      AX_CHAR_SLIDES contacts; a grounded actor blocked by a steep
+ *      surface first tries to step up onto it (AX_CHARACTER_STEP_M),
+ *      and steep surfaces are slid along horizontally, never climbed
+ *   3. settle: a slide down by AX_CHARACTER_FALL_M, stopping on the
+ *      first walkable ground (snaps down stairs and slopes; airborne
+ *      actors fall at that fixed speed, A1 has no gravity)
+ *
+ * Sweeps find the capsule's time of impact with each candidate triangle
+ * by conservative advancement on the exact segment-triangle distance,
+ * and keep a skin gap of AX_CHAR_SKIN to every surface. The earliest
+ * contact wins, ties to the lower triangle, so a move depends only on
+ * the actor's position, the displacement and the mesh.
+ *
+ * Broadphase: each moving actor keeps an ax_character_cache with the
+ * triangles around it (an AABB query on the BVH), reused while its
+ * moves stay inside the cached region. Every sweep filters candidates
+ * by its own bounds, so cached and uncached moves test exactly the same
+ * triangles and give identical results; a cache only saves the BVH
+ * walk. A region with more than AX_CHAR_CACHE_TRIANGLES triangles is
+ * not cached and its sweeps query the BVH directly.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+#include "physics/ax_bvh.h"
+
+#include <cstdint>
+
+#define AX_CHAR_SLIDES          4       /* contacts resolved per slide        */
+#define AX_CHAR_SKIN            0.01f   /* gap kept to every surface (m)      */
+#define AX_CHAR_CACHE_MARGIN    1.0f    /* cached region beyond a move (m)    */
+#define AX_CHAR_CACHE_TRIANGLES 56      /* candidates one cache entry holds   */
+
+struct ax_character_cache {
+    uint32_t entity_id;         /* owner, 0 = unused                      */
+    uint32_t generation;        /* ax_bvh::generation() the list is from  */
+    float    min[3], max[3];    /* region the list covers                 */
+    uint32_t count;             /* > AX_CHAR_CACHE_TRIANGLES: not cached  */
+    uint32_t triangles[AX_CHAR_CACHE_TRIANGLES];   /* leaf order, ascending */
+};
+
+struct ax_character_result {
+    float    px, py, pz;
+    bool     grounded;          /* on walkable ground after the move      */
+};
+
+/*
+ * Moves the actor standing at (px, py, pz) by (dx, dz) through `bvh`.
+ * `cache` belongs to this actor (reset when its entity_id differs) and
+ * is only touched by this call; no allocation.
+ */
+ax_character_result ax_character_move(const ax_bvh& bvh, ax_character_cache* cache,
+                                      uint32_t entity_id, float px, float py, float pz,
+                                      float dx, float dz);
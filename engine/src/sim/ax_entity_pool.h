@@ -0,0 +1,257 @@
+/*
+ * ax_entity_pool.h — Generational entity slots over dense storage
+ *
+ * Entity ids are stable 32-bit handles: the low 24 bits name a slot,
+ * the high 8 bits that slot's generation. Despawning bumps the
+ * generation, so an id held by a save, an event or the host never
+ * aliases whatever reuses the slot later. A slot whose generation
+ * would pass 255 is retired instead of recycled. Slot 0 is retired
+ * from the start, so id 0 never names an entity.
+ *
+ * Live entities sit in one dense array, and iteration order is array
+ * order. Despawn swap-removes: the last entity moves into the hole and
+ * its slot is re-pointed, so nothing shifts and iteration stays dense.
+ *
+ * Free slots are reused lowest-first (a min-heap). That makes the
+ * whole pool a function of the slot generations plus the dense order,
+ * which is exactly what save 1.2 stores.
+ */
+
+#pragma once
+
+#include "core/ax_alloc.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+#define AX_ENTITY_SLOT_BITS 24
+#define AX_ENTITY_MAX_SLOTS (1u << AX_ENTITY_SLOT_BITS)
+#define AX_ENTITY_MAX_GEN   255u
+#define AX_ENTITY_RETIRED   (AX_ENTITY_MAX_GEN + 1)     /* slot generation of a retired slot */
+
+inline uint32_t ax_entity_slot(uint32_t id)       { return id & (AX_ENTITY_MAX_SLOTS - 1); }
+inline uint32_t ax_entity_generation(uint32_t id) { return id >> AX_ENTITY_SLOT_BITS; }
+inline uint32_t ax_entity_make_id(uint32_t slot, uint32_t gen) {
+    return (gen << AX_ENTITY_SLOT_BITS) | slot;
+}
+
+/* T must have a `uint32_t id` member; the pool owns it. */
+template <class T>
+class ax_entity_pool {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    explicit ax_entity_pool(const ax_alloc_state* alloc)
+        : dense_(ax_allocator<T>(alloc)),
+          slots_(ax_allocator<slot>(alloc)),
+          free_(ax_allocator<uint32_t>(alloc)) {}
+
+    /* Drops every entity and slot. */
+    void clear() {
+        dense_.clear();
+        slots_.clear();
+        free_.clear();
+    }
+
+    /* ── Spawn / despawn ─────────────────────────────────────────── */
+
+    /* Adds `proto` under a fresh id (returned; 0 when all slots are in use). */
+    uint32_t spawn(const T& proto) {
+        uint32_t s;
+        if (!free_.empty()) {
+            std::pop_heap(free_.begin(), free_.end(), std::greater<uint32_t>());
+            s = free_.back();
+            free_.pop_back();
+        } else {
+            if (slots_.empty()) {
+                slots_.push_back({ NONE, AX_ENTITY_RETIRED });     /* slot 0 */
+            }
+            if (slots_.size() >= AX_ENTITY_MAX_SLOTS) {
+                return 0;
+            }
+            s = (uint32_t)slots_.size();
+            slots_.push_back({ NONE, 0 });
+        }
+        place(s, proto);
+        return dense_.back().id;
+    }
+
+    /*
+     * Swap-removes a live entity. False for unknown or stale ids. May
+     * throw bad_alloc; the pool is unchanged if it does.
+     */
+    bool despawn(uint32_t id) {
+        uint32_t index = index_of(id);
+        if (index == NONE) {
+            return false;
+        }
+        ax_reserve_more(free_, 1);      /* may throw; nothing has changed yet */
+
+        uint32_t last = (uint32_t)dense_.size() - 1;
+        if (index != last) {
+            dense_[index] = dense_[last];
+            slots_[ax_entity_slot(dense_[index].id)].dense = index;
+        }
+        dense_.pop_back();
+
+        slot& sl = slots_[ax_entity_slot(id)];
+        sl.dense = NONE;
+        sl.gen++;
+        if (sl.gen <= AX_ENTITY_MAX_GEN) {
+            free_.push_back(ax_entity_slot(id));
+            std::push_heap(free_.begin(), free_.end(), std::greater<uint32_t>());
+        }
+        return true;
+    }
+
+    /* ── Rebuilding (content load, save restore) ─────────────────── */
+
+    /*
+     * Resets to `count` empty slots at generation 0 (slot 0 retired).
+     * Follow with set_generation / insert, then rebuild_free_list.
+     */
+    void reset_slots(uint32_t count) {
+        clear();
+        slots_.resize(count, slot{ NONE, 0 });
+        if (count > 0) {
+            slots_[0].gen = AX_ENTITY_RETIRED;
+        }
+    }
+
+    void set_generation(uint32_t s, uint32_t gen) { slots_[s].gen = gen; }
+
+    /*
+     * Makes a rebuild allocation-free: reset_slots(slot_count), inserts of
+     * `entity_count` entities below it, then rebuild_free_list. May throw
+     * bad_alloc; the pool is unchanged if it does.
+     */
+    void reserve_rebuild(uint32_t slot_count, uint32_t entity_count) {
+        slots_.reserve(slot_count);
+        dense_.reserve(entity_count);
+        free_.reserve(slot_count);
+    }
+
+    /*
+     * Places `e` under its own e.id (appended to the dense order),
+     * growing the slot table if needed. False if the slot is 0, taken,
+     * or retired.
+     */
+    bool insert(const T& e) {
+        uint32_t s = ax_entity_slot(e.id);
+        if (s == 0) {
+            return false;
+        }
+        if (s >= slots_.size()) {
+            if (slots_.empty()) {
+                slots_.push_back({ NONE, AX_ENTITY_RETIRED });
+            }
+            slots_.resize(s + 1, slot{ NONE, 0 });
+        }
+        if (slots_[s].dense != NONE || slots_[s].gen > AX_ENTITY_MAX_GEN) {
+            return false;
+        }
+        slots_[s].gen = ax_entity_generation(e.id);
+        place(s, e);
+        return true;
+    }
+
+    /* Every empty, non-retired slot becomes reusable. */
+    void rebuild_free_list() {
+        free_.clear();
+        for (uint32_t s = 0; s < (uint32_t)slots_.size(); ++s) {
+            if (slots_[s].dense == NONE && slots_[s].gen <= AX_ENTITY_MAX_GEN) {
+                free_.push_back(s);
+            }
+        }
+        /* ascending order is already a valid min-heap */
+    }
+
+    /* ── Lookup ──────────────────────────────────────────────────── */
+
+    /* Dense index of a live id, NONE if unknown or stale. O(1). */
+    uint32_t index_of(uint32_t id) const {
+        uint32_t s = ax_entity_slot(id);
+        if (s >= slots_.size()) {
+            return NONE;
+        }
+        const slot& sl = slots_[s];
+        if (sl.dense == NONE || sl.gen != ax_entity_generation(id)) {
+            return NONE;
+        }
+        return sl.dense;
+    }
+
+    T* find(uint32_t id) {
+        uint32_t index = index_of(id);
+        return index == NONE ? nullptr : &dense_[index];
+    }
+    const T* find(uint32_t id) const {
+        uint32_t index = index_of(id);
+        return index == NONE ? nullptr : &dense_[index];
+    }
+
+    /* Slot table (save/hash): generation per slot, AX_ENTITY_RETIRED if retired. */
+    uint32_t slot_count() const           { return (uint32_t)slots_.size(); }
+    uint32_t generation(uint32_t s) const { return slots_[s].gen; }
+    uint32_t free_count() const           { return (uint32_t)free_.size(); }
+
+    /* How many spawn() calls would succeed right now. */
+    uint32_t spawn_capacity() const {
+        uint32_t fresh = slots_.empty() ? AX_ENTITY_MAX_SLOTS - 1
+                                        : AX_ENTITY_MAX_SLOTS - (uint32_t)slots_.size();
+        return (uint32_t)free_.size() + fresh;
+    }
+
+    /*
+     * Makes the next `n` spawns allocation-free. May throw bad_alloc;
+     * the pool is unchanged if it does.
+     */
+    void reserve_spawns(uint32_t n) {
+        uint32_t fresh = n > free_.size() ? n - (uint32_t)free_.size() : 0;
+        ax_reserve_more(dense_, n);
+        ax_reserve_more(slots_, fresh + (slots_.empty() ? 1 : 0));
+    }
+
+    /* ── Dense iteration ─────────────────────────────────────────── */
+
+    uint32_t size() const  { return (uint32_t)dense_.size(); }
+    bool     empty() const { return dense_.empty(); }
+
+    T&       operator[](uint32_t i)       { return dense_[i]; }
+    const T& operator[](uint32_t i) const { return dense_[i]; }
+
+    T*       begin()       { return dense_.data(); }
+    T*       end()         { return dense_.data() + dense_.size(); }
+    const T* begin() const { return dense_.data(); }
+    const T* end() const   { return dense_.data() + dense_.size(); }
+
+    /* ── Memory statistics ───────────────────────────────────────── */
+
+    size_t reserved_bytes() const {
+        return dense_.capacity() * sizeof(T)
+             + slots_.capacity() * sizeof(slot)
+             + free_.capacity() * sizeof(uint32_t);
+    }
+    size_t used_bytes() const {
+        return dense_.size() * sizeof(T)
+             + slots_.size() * sizeof(slot)
+             + free_.size() * sizeof(uint32_t);
+    }
+
+private:
+    struct slot {
+        uint32_t dense;     /* index into dense_, NONE when empty     */
+        uint32_t gen;       /* current generation; RETIRED = never reused */
+    };
+
+    void place(uint32_t s, const T& proto) {
+        slots_[s].dense = (uint32_t)dense_.size();
+        dense_.push_back(proto);
+        dense_.back().id = ax_entity_make_id(s, slots_[s].gen);
+    }
+
+    ax_vector<T>        dense_;
+    ax_vector<slot>     slots_;
+    ax_vector<uint32_t> free_;      /* min-heap of reusable slots */
+};
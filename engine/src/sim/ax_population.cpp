@@ -0,0 +1,188 @@
+/*
+ * ax_population.cpp — Seeded target placement for procedural populations
+ */
+
+#include "ax_population.h"
+
+#include <cmath>
+
+static const uint32_t MAX_REJECTION_TRIES = 64;
+
+/* streams: one independent hash sequence per use */
+enum : uint32_t {
+    STREAM_ARCHETYPE = 0,
+    STREAM_X         = 1,
+    STREAM_Z         = 2,
+    STREAM_CENTRE_X  = 3,
+    STREAM_CENTRE_Z  = 4,
+    STREAM_RADIUS    = 5,
+    STREAM_DISC      = 16,      /* + 2 * try */
+};
+
+static bool finite(float v) { return std::isfinite(v); }
+
+const char* ax_population_validate(const ax_population_params_v1& p) {
+    if (p.count == 0) {
+        return "count must be > 0";
+    }
+    if (p.layout >= AX_POP_LAYOUT_COUNT) {
+        return "unknown layout";
+    }
+    if (!finite(p.min_x) || !finite(p.min_z) || !finite(p.max_x) || !finite(p.max_z) ||
+        !(p.max_x > p.min_x) || !(p.max_z > p.min_z)) {
+        return "region must be finite with max > min";
+    }
+    if (p.archetype_count == 0 || p.archetype_count > AX_POP_MAX_ARCHETYPES) {
+        return "archetype_count must be 1..AX_POP_MAX_ARCHETYPES";
+    }
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < p.archetype_count; ++i) {
+        const ax_population_archetype_v1& a = p.archetypes[i];
+        if (a.weight == 0 || a.hp <= 0 || a.reserved0 != 0) {
+            return "archetype weight and hp must be > 0 (reserved0 = 0)";
+        }
+        total += a.weight;
+    }
+    if (total > UINT32_MAX) {
+        return "archetype weights sum past 2^32";
+    }
+    if (p.reserved0 != 0) {
+        return "reserved0 must be 0";
+    }
+
+    switch (p.layout) {
+        case AX_POP_LAYOUT_GRID:
+            if (!finite(p.jitter_m) || p.jitter_m < 0.0f) return "jitter_m must be finite and >= 0";
+            break;
+        case AX_POP_LAYOUT_CLUSTERS:
+            if (p.cluster_count == 0) return "cluster_count must be > 0";
+            if (!finite(p.cluster_radius_m) || p.cluster_radius_m < 0.0f) {
+                return "cluster_radius_m must be finite and >= 0";
+            }
+            break;
+        case AX_POP_LAYOUT_RING: {
+            float outer = 0.5f * std::fmin(p.max_x - p.min_x, p.max_z - p.min_z);
+            if (!finite(p.ring_inner_radius_m) || p.ring_inner_radius_m < 0.0f ||
+                !(p.ring_inner_radius_m < outer)) {
+                return "ring_inner_radius_m must be >= 0 and below the region's inner circle";
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+ax_population_generator::ax_population_generator(const ax_population_params_v1& params)
+    : p_(params), total_weight_(0), grid_cols_(1), grid_step_x_(0.0f), grid_step_z_(0.0f) {
+    for (uint32_t i = 0; i < p_.archetype_count; ++i) {
+        total_weight_ += p_.archetypes[i].weight;
+    }
+
+    if (p_.layout == AX_POP_LAYOUT_GRID) {
+        /* roughly square cells: cols / rows follows the region's aspect */
+        double w = (double)p_.max_x - (double)p_.min_x;
+        double d = (double)p_.max_z - (double)p_.min_z;
+        double cols = std::ceil(std::sqrt((double)p_.count * w / d));
+        grid_cols_ = cols < 1.0 ? 1u : (cols > (double)p_.count ? p_.count : (uint32_t)cols);
+        uint32_t rows = (p_.count + grid_cols_ - 1) / grid_cols_;
+        grid_step_x_ = (float)(w / grid_cols_);
+        grid_step_z_ = (float)(d / rows);
+    }
+}
+
+/* splitmix64 over (seed, index, stream) */
+static uint64_t mix(uint64_t seed, uint64_t index, uint32_t stream) {
+    uint64_t z = seed ^ (index * 0x9E3779B97F4A7C15ull) ^ ((uint64_t)stream * 0xD1B54A32D192ED03ull);
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+float ax_population_generator::uniform(uint64_t index, uint32_t stream) const {
+    return (float)(mix(p_.seed, index, stream) >> 40) * (1.0f / 16777216.0f);
+}
+
+void ax_population_generator::disc(uint64_t index, uint32_t stream, float* x, float* z) const {
+    for (uint32_t t = 0; t < MAX_REJECTION_TRIES; ++t) {
+        float dx = 2.0f * uniform(index, stream + 2 * t) - 1.0f;
+        float dz = 2.0f * uniform(index, stream + 2 * t + 1) - 1.0f;
+        if (dx * dx + dz * dz <= 1.0f) {
+            *x = dx;
+            *z = dz;
+            return;
+        }
+    }
+    *x = 0.0f;      /* (pi/4 acceptance: 64 misses in a row never happens in practice) */
+    *z = 0.0f;
+}
+
+ax_population_placement ax_population_generator::at(uint32_t index) const {
+    ax_population_placement out;
+
+    /* archetype: weighted pick, multiply-shift keeps it unbiased enough and exact */
+    uint64_t h    = mix(p_.seed, index, STREAM_ARCHETYPE);
+    uint32_t pick = (uint32_t)(((h >> 32) * total_weight_) >> 32);
+    uint32_t a    = 0;
+    while (pick >= p_.archetypes[a].weight) {
+        pick -= p_.archetypes[a].weight;
+        a++;
+    }
+    out.archetype_id = p_.archetypes[a].archetype_id;
+    out.hp           = p_.archetypes[a].hp;
+
+    float w  = p_.max_x - p_.min_x;
+    float d  = p_.max_z - p_.min_z;
+    float cx = p_.min_x + 0.5f * w;
+    float cz = p_.min_z + 0.5f * d;
+
+    switch (p_.layout) {
+        case AX_POP_LAYOUT_GRID: {
+            uint32_t col = index % grid_cols_;
+            uint32_t row = index / grid_cols_;
+            out.px = p_.min_x + ((float)col + 0.5f) * grid_step_x_;
+            out.pz = p_.min_z + ((float)row + 0.5f) * grid_step_z_;
+            if (p_.jitter_m > 0.0f) {
+                out.px += p_.jitter_m * (2.0f * uniform(index, STREAM_X) - 1.0f);
+                out.pz += p_.jitter_m * (2.0f * uniform(index, STREAM_Z) - 1.0f);
+            }
+            break;
+        }
+        case AX_POP_LAYOUT_CLUSTERS: {
+            /* members are dealt round-robin, so clusters differ in size by at most one */
+            uint32_t k = index % p_.cluster_count;
+            float dx, dz;
+            disc(index, STREAM_DISC, &dx, &dz);
+            out.px = p_.min_x + uniform(k, STREAM_CENTRE_X) * w + p_.cluster_radius_m * dx;
+            out.pz = p_.min_z + uniform(k, STREAM_CENTRE_Z) * d + p_.cluster_radius_m * dz;
+            break;
+        }
+        case AX_POP_LAYOUT_RING: {
+            /* uniform over the annulus area; sqrt is correctly rounded, so still exact */
+            float outer = 0.5f * std::fmin(w, d);
+            float r2_in = p_.ring_inner_radius_m * p_.ring_inner_radius_m;
+            float r     = std::sqrt(r2_in + uniform(index, STREAM_RADIUS) * (outer * outer - r2_in));
+            float dx, dz;
+            disc(index, STREAM_DISC, &dx, &dz);
+            float len = std::sqrt(dx * dx + dz * dz);
+            if (len > 0.0f) {
+                dx /= len;
+                dz /= len;
+            } else {
+                dx = 1.0f;
+                dz = 0.0f;
+            }
+            out.px = cx + r * dx;
+            out.pz = cz + r * dz;
+            break;
+        }
+        default: {
+            out.px = p_.min_x + uniform(index, STREAM_X) * w;
+            out.pz = p_.min_z + uniform(index, STREAM_Z) * d;
+            break;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,44 @@
+/*
+ * ax_population.h — Seeded target placement for procedural populations
+ *
+ * Turns an ax_population_params_v1 into a stream of placements. Each
+ * placement is a function of (seed, index) alone, through a splitmix64
+ * counter hash, so the stream is identical on every platform and any
+ * index can be generated without the ones before it. Floats come from
+ * the top 24 bits of a hash and only go through IEEE correctly rounded
+ * ops (add/mul/div/sqrt); directions use rejection sampling in the unit
+ * disc instead of sin/cos, whose results vary between libms.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+
+#include <cstdint>
+
+struct ax_population_placement {
+    float    px, pz;
+    uint32_t archetype_id;
+    int32_t  hp;
+};
+
+/* NULL when params are usable, else a static description of the first problem. */
+const char* ax_population_validate(const ax_population_params_v1& params);
+
+class ax_population_generator {
+public:
+    /* params must have passed ax_population_validate */
+    explicit ax_population_generator(const ax_population_params_v1& params);
+
+    ax_population_placement at(uint32_t index) const;
+
+private:
+    float uniform(uint64_t index, uint32_t stream) const;   /* [0, 1) */
+    void  disc(uint64_t index, uint32_t stream, float* x, float* z) const;   /* unit disc */
+
+    const ax_population_params_v1& p_;
+    uint32_t total_weight_;
+    uint32_t grid_cols_;
+    float    grid_step_x_;
+    float    grid_step_z_;
+};
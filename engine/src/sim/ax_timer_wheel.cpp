@@ -0,0 +1,208 @@
+/*
+ * ax_timer_wheel.cpp — Hierarchical timing wheel for gameplay timers
+ */
+
+#include "ax_timer_wheel.h"
+
+#include <algorithm>
+
+ax_timer_wheel::ax_timer_wheel(const ax_alloc_state* alloc)
+    : nodes_(ax_allocator<node>(alloc)),
+      heads_(ax_allocator<uint32_t>(alloc)),
+      fired_(ax_allocator<uint32_t>(alloc)),
+      free_head_(NIL), live_(0), now_(0), next_seq_(0) {
+    heads_.assign(LEVELS * SLOTS + 1, NIL);
+}
+
+void ax_timer_wheel::reset(uint64_t now) {
+    nodes_.clear();
+    heads_.assign(LEVELS * SLOTS + 1, NIL);
+    free_head_ = NIL;
+    live_      = 0;
+    now_       = now;
+    next_seq_  = 0;
+}
+
+size_t ax_timer_wheel::reserved_bytes() const {
+    return nodes_.capacity() * sizeof(node)
+         + heads_.capacity() * sizeof(uint32_t)
+         + fired_.capacity() * sizeof(uint32_t);
+}
+
+size_t ax_timer_wheel::used_bytes() const {
+    return (size_t)live_ * sizeof(node) + heads_.size() * sizeof(uint32_t);
+}
+
+/* ── Buckets ──────────────────────────────────────────────────────── */
+
+void ax_timer_wheel::link(uint32_t index) {
+    node& n = nodes_[index];
+
+    /* lowest level whose window (now_ >> 8*(L+1)) also contains due */
+    uint32_t bucket = OVERFLOW_BUCKET;
+    for (uint32_t level = 0; level < LEVELS; ++level) {
+        uint32_t window_shift = SLOT_BITS * (level + 1);
+        if ((n.due >> window_shift) == (now_ >> window_shift)) {
+            uint32_t slot = (uint32_t)(n.due >> (SLOT_BITS * level)) & (SLOTS - 1);
+            bucket = level * SLOTS + slot;
+            break;
+        }
+    }
+
+    n.bucket = bucket;
+    n.prev   = NIL;
+    n.next   = heads_[bucket];
+    if (n.next != NIL) {
+        nodes_[n.next].prev = index;
+    }
+    heads_[bucket] = index;
+}
+
+void ax_timer_wheel::unlink(uint32_t index) {
+    node& n = nodes_[index];
+    if (n.prev != NIL) {
+        nodes_[n.prev].next = n.next;
+    } else {
+        heads_[n.bucket] = n.next;
+    }
+    if (n.next != NIL) {
+        nodes_[n.next].prev = n.prev;
+    }
+}
+
+void ax_timer_wheel::release(uint32_t index) {
+    node& n = nodes_[index];
+    n.live = false;
+    n.gen++;                    /* invalidates outstanding handles */
+    n.next = free_head_;
+    free_head_ = index;
+    live_--;
+}
+
+/* Re-files every timer in a bucket relative to the current tick. */
+void ax_timer_wheel::cascade(uint32_t bucket) {
+    uint32_t index = heads_[bucket];
+    heads_[bucket] = NIL;
+    while (index != NIL) {
+        uint32_t next = nodes_[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+/* ── Schedule / cancel ────────────────────────────────────────────── */
+
+ax_timer_handle ax_timer_wheel::add(uint64_t due, uint64_t seq,
+                                    const ax_timer_payload& payload) {
+    uint32_t index;
+    if (free_head_ != NIL) {
+        index = free_head_;
+        free_head_ = nodes_[index].next;
+    } else {
+        index = (uint32_t)nodes_.size();
+        nodes_.push_back(node());
+        nodes_[index].gen = 1;
+    }
+
+    node& n   = nodes_[index];
+    n.due     = due > now_ ? due : now_ + 1;
+    n.seq     = seq;
+    n.payload = payload;
+    n.live    = true;
+    live_++;
+
+    link(index);
+    return ((uint64_t)n.gen << 32) | index;
+}
+
+ax_timer_handle ax_timer_wheel::schedule(uint64_t due_tick, const ax_timer_payload& payload) {
+    return add(due_tick, next_seq_++, payload);
+}
+
+ax_timer_handle ax_timer_wheel::restore(const ax_timer_record& record) {
+    if (record.seq >= next_seq_) {
+        next_seq_ = record.seq + 1;
+    }
+    return add(record.due_tick, record.seq, record.payload);
+}
+
+void ax_timer_wheel::reserve(uint32_t n) {
+    /* released nodes are reused first, so only live_ + n must fit */
+    size_t nodes = (size_t)live_ + n;
+    if (nodes > nodes_.capacity()) {
+        ax_reserve_more(nodes_, nodes - nodes_.size());
+    }
+    if (nodes > fired_.capacity()) {
+        ax_reserve_more(fired_, nodes - fired_.size());
+    }
+}
+
+bool ax_timer_wheel::cancel(ax_timer_handle handle) {
+    uint32_t index = (uint32_t)(handle & 0xFFFFFFFFu);
+    uint32_t gen   = (uint32_t)(handle >> 32);
+    if (handle == 0 || index >= nodes_.size()) {
+        return false;
+    }
+    node& n = nodes_[index];
+    if (!n.live || n.gen != gen) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+/* ── Advance ──────────────────────────────────────────────────────── */
+
+void ax_timer_wheel::advance(uint64_t tick, ax_vector<ax_timer_payload>* out) {
+    now_ = tick;
+
+    /* overflow re-files once per 2^32 ticks */
+    if ((tick & 0xFFFFFFFFull) == 0) {
+        cascade(OVERFLOW_BUCKET);
+    }
+
+    /* top-down, so timers cascaded from level L can cascade again below */
+    for (uint32_t level = LEVELS - 1; level >= 1; --level) {
+        uint32_t shift = SLOT_BITS * level;
+        if ((tick & ((1ull << shift) - 1)) == 0) {
+            uint32_t slot = (uint32_t)(tick >> shift) & (SLOTS - 1);
+            cascade(level * SLOTS + slot);
+        }
+    }
+
+    uint32_t bucket = (uint32_t)(tick & (SLOTS - 1));
+    uint32_t index  = heads_[bucket];
+    if (index == NIL) {
+        return;
+    }
+    heads_[bucket] = NIL;
+
+    fired_.clear();
+    while (index != NIL) {
+        fired_.push_back(index);
+        index = nodes_[index].next;
+    }
+    std::sort(fired_.begin(), fired_.end(), [this](uint32_t x, uint32_t y) {
+        return nodes_[x].seq < nodes_[y].seq;
+    });
+
+    for (uint32_t i : fired_) {
+        out->push_back(nodes_[i].payload);
+        release(i);
+    }
+}
+
+/* ── Save / load ──────────────────────────────────────────────────── */
+
+void ax_timer_wheel::export_records(ax_vector<ax_timer_record>* out) const {
+    out->clear();
+    for (const node& n : nodes_) {
+        if (n.live) {
+            out->push_back({ n.due, n.seq, n.payload });
+        }
+    }
+    std::sort(out->begin(), out->end(), [](const ax_timer_record& x, const ax_timer_record& y) {
+        return x.seq < y.seq;
+    });
+}
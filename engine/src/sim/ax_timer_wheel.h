@@ -0,0 +1,127 @@
+/*
+ * ax_timer_wheel.h — Hierarchical timing wheel for gameplay timers
+ *
+ * Timers are keyed by absolute due tick. Four levels of 256 slots cover
+ * the next 2^32 ticks; anything further out waits in an overflow list.
+ * A timer sits at the lowest level whose window (current tick with the
+ * low 8*(L+1) bits ignored) contains its due tick, and moves down a
+ * level when the wheel reaches the start of its slot ("cascade").
+ *
+ * Costs: schedule and cancel are O(1). Advancing one tick touches only
+ * the level-0 slot for that tick, plus one higher-level slot every
+ * 256^L ticks, so per-tick cost scales with expiring timers, not live
+ * ones.
+ *
+ * Firing order: timers due on the same tick fire in the order they were
+ * scheduled (a per-wheel sequence number that is saved with the timer),
+ * independent of slot layout or cascade history.
+ */
+
+#pragma once
+
+#include "core/ax_alloc.h"
+
+#include <cstdint>
+
+/* What a timer does when it fires (dispatched by the sim, not the wheel). */
+enum ax_timer_kind : uint32_t {
+    AX_TIMER_NONE        = 0,
+    AX_TIMER_RELOAD_DONE = 1,   /* owner_id = actor, slot = weapon slot */
+};
+
+struct ax_timer_payload {
+    uint32_t kind;              /* ax_timer_kind */
+    uint32_t owner_id;
+    uint32_t slot;
+};
+
+/* 0 = no timer; otherwise generation << 32 | node index */
+typedef uint64_t ax_timer_handle;
+
+/* A live timer as seen by save/load and the state hash. */
+struct ax_timer_record {
+    uint64_t         due_tick;
+    uint64_t         seq;
+    ax_timer_payload payload;
+};
+
+class ax_timer_wheel {
+public:
+    explicit ax_timer_wheel(const ax_alloc_state* alloc);
+
+    /* Drops every timer; `now` is the last tick already processed. */
+    void     reset(uint64_t now);
+    uint64_t now() const { return now_; }
+    uint32_t live_count() const { return live_; }
+
+    /* memory statistics: heap held / bytes backing live timers + buckets */
+    size_t reserved_bytes() const;
+    size_t used_bytes() const;
+
+    /*
+     * Schedules a timer that fires when the wheel advances to due_tick.
+     * due_tick <= now() is clamped to now() + 1 (the next advance).
+     */
+    ax_timer_handle schedule(uint64_t due_tick, const ax_timer_payload& payload);
+
+    /*
+     * Makes the next `n` schedules (or restores after a reset) and the
+     * next advance allocation-free. May throw bad_alloc; the wheel is
+     * unchanged if it does.
+     */
+    void reserve(uint32_t n);
+
+    /* Whether reserve(n) would allocate nothing. */
+    bool has_room(uint32_t n) const {
+        size_t nodes = (size_t)live_ + n;
+        return nodes <= nodes_.capacity() && nodes <= fired_.capacity();
+    }
+
+    /* O(1). Returns false if the handle is stale or already fired. */
+    bool cancel(ax_timer_handle handle);
+
+    /*
+     * Advances to `tick` (must be now() + 1) and appends the payloads of
+     * timers due at it to `out`, in schedule order. Fired timers are
+     * released before this returns, so handlers may schedule new ones.
+     */
+    void advance(uint64_t tick, ax_vector<ax_timer_payload>* out);
+
+    /* Save/load: every live timer, sorted by seq. */
+    void            export_records(ax_vector<ax_timer_record>* out) const;
+    uint64_t        next_seq() const { return next_seq_; }
+    void            set_next_seq(uint64_t seq) { next_seq_ = seq; }
+    ax_timer_handle restore(const ax_timer_record& record);
+
+private:
+    static constexpr uint32_t LEVELS          = 4;
+    static constexpr uint32_t SLOT_BITS       = 8;
+    static constexpr uint32_t SLOTS           = 1u << SLOT_BITS;
+    static constexpr uint32_t OVERFLOW_BUCKET = LEVELS * SLOTS;
+    static constexpr uint32_t NIL             = UINT32_MAX;
+
+    struct node {
+        uint64_t         due;
+        uint64_t         seq;
+        ax_timer_payload payload;
+        uint32_t         prev;
+        uint32_t         next;      /* bucket list, or free list when !live */
+        uint32_t         bucket;
+        uint32_t         gen;
+        bool             live;
+    };
+
+    ax_timer_handle add(uint64_t due, uint64_t seq, const ax_timer_payload& payload);
+    void            link(uint32_t index);
+    void            unlink(uint32_t index);
+    void            release(uint32_t index);
+    void            cascade(uint32_t bucket);
+
+    ax_vector<node>       nodes_;
+    ax_vector<uint32_t>   heads_;       /* LEVELS * SLOTS + 1 (overflow) */
+    ax_vector<uint32_t>   fired_;       /* advance scratch               */
+    uint32_t              free_head_;
+    uint32_t              live_;
+    uint64_t              now_;
+    uint64_t              next_seq_;
+};
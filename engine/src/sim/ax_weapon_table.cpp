@@ -0,0 +1,115 @@
+/*
+ * ax_weapon_table.cpp — Weapon state keyed by (actor, weapon slot)
+ */
+
+#include "ax_weapon_table.h"
+#include "sim/ax_entity_pool.h"
+
+ax_weapon_table::ax_weapon_table(const ax_alloc_state* alloc)
+    : owner_(ax_allocator<uint32_t>(alloc)),
+      slot_(ax_allocator<uint32_t>(alloc)),
+      weapon_id_(ax_allocator<uint32_t>(alloc)),
+      ammo_in_mag_(ax_allocator<int32_t>(alloc)),
+      ammo_reserve_(ax_allocator<int32_t>(alloc)),
+      reload_due_tick_(ax_allocator<uint64_t>(alloc)),
+      reload_timer_(ax_allocator<ax_timer_handle>(alloc)),
+      index_(ax_allocator<uint32_t>(alloc)) {}
+
+void ax_weapon_table::clear() {
+    owner_.clear();
+    slot_.clear();
+    weapon_id_.clear();
+    ammo_in_mag_.clear();
+    ammo_reserve_.clear();
+    reload_due_tick_.clear();
+    reload_timer_.clear();
+    index_.clear();
+}
+
+size_t ax_weapon_table::reserved_bytes() const {
+    return owner_.capacity() * sizeof(uint32_t)
+         + slot_.capacity() * sizeof(uint32_t)
+         + weapon_id_.capacity() * sizeof(uint32_t)
+         + ammo_in_mag_.capacity() * sizeof(int32_t)
+         + ammo_reserve_.capacity() * sizeof(int32_t)
+         + reload_due_tick_.capacity() * sizeof(uint64_t)
+         + reload_timer_.capacity() * sizeof(ax_timer_handle)
+         + index_.capacity() * sizeof(uint32_t);
+}
+
+size_t ax_weapon_table::used_bytes() const {
+    size_t row = 3 * sizeof(uint32_t) + 2 * sizeof(int32_t) + sizeof(uint64_t) + sizeof(ax_timer_handle);
+    return owner_.size() * row + index_.size() * sizeof(uint32_t);
+}
+
+uint32_t ax_weapon_table::index_of(uint32_t owner_id, uint32_t slot) {
+    return ax_entity_slot(owner_id) * AX_WEAPON_SLOTS + slot;
+}
+
+uint32_t ax_weapon_table::find(uint32_t owner_id, uint32_t slot) const {
+    if (slot >= AX_WEAPON_SLOTS) {
+        return NONE;
+    }
+    uint32_t i = index_of(owner_id, slot);
+    if (i >= index_.size()) {
+        return NONE;
+    }
+    uint32_t row = index_[i];
+    /* the index is by entity slot: a stale generation owns nothing */
+    return (row != NONE && owner_[row] == owner_id) ? row : NONE;
+}
+
+uint32_t ax_weapon_table::add(uint32_t owner_id, uint32_t slot, uint32_t weapon_id,
+                              int32_t ammo_in_mag, int32_t ammo_reserve) {
+    uint32_t i = index_of(owner_id, slot);
+    if (i >= index_.size()) {
+        index_.resize((size_t)(ax_entity_slot(owner_id) + 1) * AX_WEAPON_SLOTS, NONE);
+    }
+
+    uint32_t row = size();
+    owner_.push_back(owner_id);
+    slot_.push_back(slot);
+    weapon_id_.push_back(weapon_id);
+    ammo_in_mag_.push_back(ammo_in_mag);
+    ammo_reserve_.push_back(ammo_reserve);
+    reload_due_tick_.push_back(0);
+    reload_timer_.push_back(0);
+    index_[i] = row;
+    return row;
+}
+
+void ax_weapon_table::reserve(uint32_t rows, uint32_t owner_slots) {
+    ax_reserve_more(owner_, rows);
+    ax_reserve_more(slot_, rows);
+    ax_reserve_more(weapon_id_, rows);
+    ax_reserve_more(ammo_in_mag_, rows);
+    ax_reserve_more(ammo_reserve_, rows);
+    ax_reserve_more(reload_due_tick_, rows);
+    ax_reserve_more(reload_timer_, rows);
+    size_t index = (size_t)owner_slots * AX_WEAPON_SLOTS;
+    if (index > index_.size()) {
+        ax_reserve_more(index_, index - index_.size());
+    }
+}
+
+void ax_weapon_table::remove(uint32_t row) {
+    uint32_t last = size() - 1;
+    index_[index_of(owner_[row], slot_[row])] = NONE;
+    if (row != last) {
+        owner_[row]           = owner_[last];
+        slot_[row]            = slot_[last];
+        weapon_id_[row]       = weapon_id_[last];
+        ammo_in_mag_[row]     = ammo_in_mag_[last];
+        ammo_reserve_[row]    = ammo_reserve_[last];
+        reload_due_tick_[row] = reload_due_tick_[last];
+        reload_timer_[row]    = reload_timer_[last];
+        index_[index_of(owner_[row], slot_[row])] = row;
+    }
+    owner_.pop_back();
+    slot_.pop_back();
+    weapon_id_.pop_back();
+    ammo_in_mag_.pop_back();
+    ammo_reserve_.pop_back();
+    reload_due_tick_.pop_back();
+    reload_timer_.pop_back();
+}
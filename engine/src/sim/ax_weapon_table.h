@@ -0,0 +1,81 @@
+/*
+ * ax_weapon_table.h — Weapon state keyed by (actor, weapon slot)
+ *
+ * Every armed actor's weapons, stored column-wise: one row per (owner,
+ * slot), one array per field the combat phase reads. A row is found in
+ * O(1) through an index by the owner's entity slot and the weapon slot,
+ * so a tick touches only the weapons of actors that act in it.
+ *
+ * Row order is the order rows were added, except that remove() moves the
+ * last row into the hole. It is deterministic and is the order the state
+ * hash, saves and snapshots use.
+ *
+ * add() and remove() may allocate and run between ticks only (content
+ * load, save load, debug API); ticks only read and write columns.
+ */
+
+#pragma once
+
+#include "ax_abi.h"
+#include "core/ax_alloc.h"
+#include "sim/ax_timer_wheel.h"
+
+#include <cstdint>
+
+class ax_weapon_table {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    explicit ax_weapon_table(const ax_alloc_state* alloc);
+
+    void     clear();
+    uint32_t size() const { return (uint32_t)owner_.size(); }
+
+    /* memory statistics: heap held / bytes backing rows + index */
+    size_t reserved_bytes() const;
+    size_t used_bytes() const;
+
+    /* Row of (owner_id, slot), NONE if the owner has no weapon there. */
+    uint32_t find(uint32_t owner_id, uint32_t slot) const;
+
+    /* Adds an idle weapon; (owner_id, slot) must be free, slot < AX_WEAPON_SLOTS. */
+    uint32_t add(uint32_t owner_id, uint32_t slot, uint32_t weapon_id,
+                 int32_t ammo_in_mag, int32_t ammo_reserve);
+
+    /*
+     * Makes the next `rows` adds allocation-free for owners in entity
+     * slots below `owner_slots`. May throw bad_alloc; the table is
+     * unchanged if it does.
+     */
+    void reserve(uint32_t rows, uint32_t owner_slots);
+
+    /* Removes `row`; the caller cancels its reload timer first. */
+    void remove(uint32_t row);
+
+    uint32_t owner(uint32_t row) const     { return owner_[row]; }
+    uint32_t slot(uint32_t row) const      { return slot_[row]; }
+    uint32_t weapon_id(uint32_t row) const { return weapon_id_[row]; }
+
+    int32_t&         ammo_in_mag(uint32_t row)        { return ammo_in_mag_[row]; }
+    int32_t          ammo_in_mag(uint32_t row) const  { return ammo_in_mag_[row]; }
+    int32_t&         ammo_reserve(uint32_t row)       { return ammo_reserve_[row]; }
+    int32_t          ammo_reserve(uint32_t row) const { return ammo_reserve_[row]; }
+
+    /* reloading while reload_due_tick != 0; the timer completes it */
+    uint64_t&        reload_due_tick(uint32_t row)       { return reload_due_tick_[row]; }
+    uint64_t         reload_due_tick(uint32_t row) const { return reload_due_tick_[row]; }
+    bool             reloading(uint32_t row) const       { return reload_due_tick_[row] != 0; }
+    ax_timer_handle& reload_timer(uint32_t row)          { return reload_timer_[row]; }
+
+private:
+    static uint32_t index_of(uint32_t owner_id, uint32_t slot);
+
+    ax_vector<uint32_t>        owner_;
+    ax_vector<uint32_t>        slot_;
+    ax_vector<uint32_t>        weapon_id_;
+    ax_vector<int32_t>         ammo_in_mag_;
+    ax_vector<int32_t>         ammo_reserve_;
+    ax_vector<uint64_t>        reload_due_tick_;
+    ax_vector<ax_timer_handle> reload_timer_;
+    ax_vector<uint32_t>        index_;      /* entity slot * AX_WEAPON_SLOTS + slot -> row */
+};